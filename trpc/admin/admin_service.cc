@@ -23,11 +23,13 @@
 #include "trpc/admin/index_handler.h"
 #include "trpc/admin/js_handler.h"
 #include "trpc/admin/log_level_handler.h"
+#include "trpc/admin/metrics_handler.h"
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
 #include "trpc/admin/prometheus_handler.h"
 #endif
 #include "trpc/admin/reload_config_handler.h"
 #include "trpc/admin/sample.h"
+#include "trpc/admin/startup_handler.h"
 #include "trpc/admin/stats_handler.h"
 #include "trpc/admin/sysvars_handler.h"
 #include "trpc/admin/version_handler.h"
@@ -59,6 +61,8 @@ AdminService::AdminService() {
   RegisterCmd(http::OperationType::POST, "/cmds/watch", std::make_shared<admin::WatchHandler>());
   // Gets the stats
   RegisterCmd(http::OperationType::GET, "/cmds/stats", std::make_shared<admin::StatsHandler>());
+  // Gets the time the startup stages and the plugin initializations take.
+  RegisterCmd(http::OperationType::GET, "/cmds/startup", std::make_shared<admin::StartupHandler>());
   // Gets the vars.
   RegisterCmd(http::OperationType::GET, "/cmds/var", std::make_shared<admin::VarHandler>("/cmds/var"));
   RegisterCmd(http::OperationType::GET, "<regex(/cmds/var/.*)>", std::make_shared<admin::VarHandler>("/cmds/var"));
@@ -119,6 +123,8 @@ AdminService::AdminService() {
   // Prometheus metrics.
   RegisterCmd(http::OperationType::GET, "/metrics", std::make_shared<admin::PrometheusHandler>());
 #endif
+  // Tvars in prometheus/openmetrics text format.
+  RegisterCmd(http::OperationType::GET, "/metrics/tvar", std::make_shared<admin::TvarMetricsHandler>());
 
   RegisterCmd(http::OperationType::POST, "/client_detach", std::make_shared<admin::ClientDetachHandler>());
 
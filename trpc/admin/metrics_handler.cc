@@ -0,0 +1,126 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/metrics_handler.h"
+
+#include <string>
+#include <utility>
+
+#include "json/json.h"
+
+#include "trpc/tvar/common/tvar_group.h"
+#include "trpc/util/time.h"
+
+namespace trpc::admin {
+
+ScrapeStats::ScrapeStats(std::string_view name)
+    : group_(tvar::TrpcVarGroup::FindOrCreate("/trpc/admin/metrics/" + std::string(name))),
+      scrapes_(group_, "scrapes"),
+      scrape_time_us_(group_, "scrape_time_us"),
+      scrape_bytes_(group_, "scrape_bytes"),
+      last_scrape_time_us_(group_, "last_scrape_time_us", 0),
+      last_scrape_text_bytes_(group_, "last_scrape_text_bytes", 0),
+      last_scrape_bytes_(group_, "last_scrape_bytes", 0) {}
+
+void ScrapeStats::Report(uint64_t time_us, uint64_t text_bytes, uint64_t body_bytes) {
+  scrapes_.Increment();
+  scrape_time_us_.Add(time_us);
+  scrape_bytes_.Add(body_bytes);
+  last_scrape_time_us_.SetValue(time_us);
+  last_scrape_text_bytes_.SetValue(text_bytes);
+  last_scrape_bytes_.SetValue(body_bytes);
+}
+
+MetricsTextWriter CreateMetricsTextWriter(const http::HttpRequestPtr& req) {
+  return MetricsTextWriter(MetricsTextWriter::FormatFromAccept(req->GetHeader("Accept")),
+                           MetricsTextWriter::AcceptGzip(req->GetHeader("Accept-Encoding")));
+}
+
+void ReplyMetrics(MetricsTextWriter&& writer, uint64_t begin_us, ScrapeStats* stats, http::HttpResponse* rsp) {
+  bool gzip = writer.IsGzip();
+  auto format = writer.GetFormat();
+  auto body = writer.Finish();
+  stats->Report(trpc::time::GetSteadyMicroSeconds() - begin_us, writer.TextBytes(), body.ByteSize());
+
+  if (gzip) {
+    rsp->SetHeader("Content-Encoding", "gzip");
+  }
+  rsp->SetMimeType(std::string(MetricsTextWriter::ContentType(format)), true);
+  rsp->SetNonContiguousBufferContent(std::move(body));
+  rsp->Done();
+}
+
+namespace {
+
+void WriteTvarValue(const std::string& name, const Json::Value& value, MetricsTextWriter* writer) {
+  if (value.isObject()) {
+    for (auto iter = value.begin(); iter != value.end(); ++iter) {
+      WriteTvarValue(name + "_" + MetricsTextWriter::SanitizeName(iter.name()), *iter, writer);
+    }
+    return;
+  }
+  if (!value.isNumeric() && !value.isBool()) {
+    return;
+  }
+
+  writer->WriteFamily(name, "unknown", "");
+  writer->BeginSample(name);
+  if (value.isBool()) {
+    writer->EndSample(static_cast<int64_t>(value.asBool()));
+  } else if (value.isUInt64()) {
+    writer->EndSample(static_cast<uint64_t>(value.asUInt64()));
+  } else if (value.isInt64()) {
+    writer->EndSample(static_cast<int64_t>(value.asInt64()));
+  } else {
+    writer->EndSample(value.asDouble());
+  }
+}
+
+}  // namespace
+
+void WriteTvarMetrics(std::string_view abs_path, MetricsTextWriter* writer) {
+  tvar::TrpcVarGroup::Visit(abs_path, [writer](std::string_view path, const Json::Value& value) {
+    WriteTvarValue(MetricsTextWriter::SanitizeName(path.substr(1)), value, writer);
+  });
+}
+
+TvarMetricsHandler::TvarMetricsHandler() {
+  description_ = "[GET /metrics/tvar] get tvars in prometheus/openmetrics text format";
+}
+
+trpc::Status TvarMetricsHandler::Handle(const std::string& path, trpc::ServerContextPtr context,
+                                        http::HttpRequestPtr req, http::HttpResponse* reply) {
+  static ScrapeStats stats("tvar");
+
+  auto begin_us = trpc::time::GetSteadyMicroSeconds();
+  std::string abs_path = req->GetQueryParameter("path");
+  if (abs_path.empty()) {
+    abs_path = "/";
+  }
+  if (abs_path[0] != '/' || abs_path.find("//") != std::string::npos) {
+    reply->SetStatus(http::HttpResponse::StatusCode::kBadRequest);
+    reply->SetContent("illegal path:" + abs_path);
+    reply->Done();
+    return kDefaultStatus;
+  }
+  if (abs_path.size() > 1 && abs_path.back() == '/') {
+    abs_path.pop_back();
+  }
+
+  auto writer = CreateMetricsTextWriter(req);
+  WriteTvarMetrics(abs_path, &writer);
+  ReplyMetrics(std::move(writer), begin_us, &stats, reply);
+  return kDefaultStatus;
+}
+
+}  // namespace trpc::admin
@@ -0,0 +1,77 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "trpc/admin/admin_handler.h"
+#include "trpc/admin/metrics_text_writer.h"
+#include "trpc/tvar/basic_ops/reducer.h"
+#include "trpc/tvar/basic_ops/status.h"
+
+namespace trpc::admin {
+
+/// @brief Exports the count, time and bytes of the scrapes of a metrics handler as tvars under
+///        /trpc/admin/metrics/{name}.
+class ScrapeStats {
+ public:
+  explicit ScrapeStats(std::string_view name);
+
+  /// @brief Records a scrape.
+  /// @param time_us time spent to write the metrics.
+  /// @param text_bytes bytes of the text before compression.
+  /// @param body_bytes bytes of the response body.
+  void Report(uint64_t time_us, uint64_t text_bytes, uint64_t body_bytes);
+
+ private:
+  tvar::TrpcVarGroup* group_;
+  tvar::Counter<uint64_t> scrapes_;
+  tvar::Counter<uint64_t> scrape_time_us_;
+  tvar::Counter<uint64_t> scrape_bytes_;
+  tvar::Status<uint64_t> last_scrape_time_us_;
+  tvar::Status<uint64_t> last_scrape_text_bytes_;
+  tvar::Status<uint64_t> last_scrape_bytes_;
+};
+
+/// @brief Creates the writer according to the `Accept` and `Accept-Encoding` headers of the request.
+MetricsTextWriter CreateMetricsTextWriter(const http::HttpRequestPtr& req);
+
+/// @brief Finishes the writer and replies the metrics written, the scrape is recorded into `stats`.
+/// @param begin_us steady time(us) when the scrape begins.
+void ReplyMetrics(MetricsTextWriter&& writer, uint64_t begin_us, ScrapeStats* stats, http::HttpResponse* rsp);
+
+/// @brief Writes the numeric tvars under abs_path as untyped metrics named by their paths, eg:
+///        /trpc/server/service/{name}/handled_requests -> trpc_server_service_{name}_handled_requests.
+///        The members of a tvar whose value is an object are written as separate metrics, booleans as 0/1, other
+///        values(eg: string, array) are skipped.
+void WriteTvarMetrics(std::string_view abs_path, MetricsTextWriter* writer);
+
+/// @brief Handles the request for getting the tvars in Prometheus/OpenMetrics text format. The query parameter `path`
+///        limits the tvars to the ones under it, default is all the tvars.
+class TvarMetricsHandler : public AdminHandlerBase {
+ public:
+  TvarMetricsHandler();
+
+  ~TvarMetricsHandler() override = default;
+
+  void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                     rapidjson::Document::AllocatorType& alloc) override {}
+
+  trpc::Status Handle(const std::string& path, trpc::ServerContextPtr context, http::HttpRequestPtr req,
+                      http::HttpResponse* reply) override;
+};
+
+}  // namespace trpc::admin
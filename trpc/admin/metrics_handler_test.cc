@@ -0,0 +1,72 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/metrics_handler.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/server/server_context.h"
+#include "trpc/tvar/basic_ops/status.h"
+
+namespace trpc::testing {
+
+TEST(TvarMetricsHandlerTest, Handle) {
+  auto* group = tvar::TrpcVarGroup::FindOrCreate("/metrics_handler_test");
+  tvar::Status<int64_t> integer(group, "integer", -3);
+  tvar::Status<double> floating(group, "floating", 1.5);
+  tvar::Status<std::string> text(group, "text", "skipped");
+
+  auto handler = std::make_unique<admin::TvarMetricsHandler>();
+  http::RequestPtr req = std::make_shared<http::Request>();
+  req->AddQueryParameter("path=/metrics_handler_test");
+  http::Response resp;
+  trpc::Status status = handler->Handle("", nullptr, req, &resp);
+  ASSERT_TRUE(status.OK());
+  ASSERT_EQ("text/plain; version=0.0.4; charset=utf-8", resp.GetHeader("Content-Type"));
+
+  std::string content = resp.GetContent();
+  ASSERT_NE(std::string::npos, content.find("# TYPE metrics_handler_test_integer untyped\n"
+                                            "metrics_handler_test_integer -3\n"));
+  ASSERT_NE(std::string::npos, content.find("metrics_handler_test_floating 1.5\n"));
+  ASSERT_EQ(std::string::npos, content.find("text"));
+
+  // The scrape is recorded.
+  ASSERT_TRUE(tvar::TrpcVarGroup::TryGet("/trpc/admin/metrics/tvar/scrapes"));
+  ASSERT_EQ(1, tvar::TrpcVarGroup::TryGet("/trpc/admin/metrics/tvar/scrapes")->asInt());
+}
+
+TEST(TvarMetricsHandlerTest, OpenMetricsAndGzip) {
+  auto handler = std::make_unique<admin::TvarMetricsHandler>();
+  http::RequestPtr req = std::make_shared<http::Request>();
+  req->SetHeader("Accept", "application/openmetrics-text; version=1.0.0");
+  req->SetHeader("Accept-Encoding", "gzip");
+  http::Response resp;
+  ASSERT_TRUE(handler->Handle("", nullptr, req, &resp).OK());
+  ASSERT_EQ("application/openmetrics-text; version=1.0.0; charset=utf-8", resp.GetHeader("Content-Type"));
+  ASSERT_EQ("gzip", resp.GetHeader("Content-Encoding"));
+  ASSERT_NE(0, resp.GetContent().size());
+}
+
+TEST(TvarMetricsHandlerTest, IllegalPath) {
+  auto handler = std::make_unique<admin::TvarMetricsHandler>();
+  http::RequestPtr req = std::make_shared<http::Request>();
+  req->AddQueryParameter("path=relative");
+  http::Response resp;
+  ASSERT_TRUE(handler->Handle("", nullptr, req, &resp).OK());
+  ASSERT_EQ(http::Response::StatusCode::kBadRequest, resp.GetStatus());
+}
+
+}  // namespace trpc::testing
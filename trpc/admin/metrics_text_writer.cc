@@ -0,0 +1,241 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/metrics_text_writer.h"
+
+#include <cmath>
+#include <optional>
+
+#include "fmt/format.h"
+#include "zlib.h"
+
+#include "trpc/util/log/logging.h"
+#include "trpc/util/string/string_helper.h"
+
+namespace trpc::admin {
+
+namespace {
+
+// Text is compressed once this size is pending.
+constexpr std::size_t kDeflateThreshold = 16 * 1024;
+
+std::string FormatDouble(double value) {
+  if (std::isnan(value)) {
+    return "NaN";
+  }
+  if (std::isinf(value)) {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  return fmt::format("{}", value);
+}
+
+}  // namespace
+
+struct MetricsTextWriter::Deflater {
+  z_stream strm;
+};
+
+MetricsTextWriter::MetricsTextWriter(Format format, bool gzip) : format_(format) {
+  if (!gzip) {
+    return;
+  }
+  deflater_ = std::make_unique<Deflater>();
+  auto& strm = deflater_->strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  // 16 + MAX_WBITS: gzip header.
+  int ret = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+  if (ret != Z_OK) {
+    TRPC_FMT_ERROR("deflateInit2 error, ret:{}, metrics are not compressed.", ret);
+    deflater_ = nullptr;
+    return;
+  }
+  pending_.reserve(kDeflateThreshold * 2);
+}
+
+MetricsTextWriter::~MetricsTextWriter() {
+  if (deflater_) {
+    (void)deflateEnd(&deflater_->strm);
+  }
+}
+
+void MetricsTextWriter::WriteFamily(std::string_view name, std::string_view type, std::string_view help) {
+  if (format_ == Format::kOpenMetrics) {
+    if (type == "counter" && EndsWith(name, "_total")) {
+      name.remove_suffix(sizeof("_total") - 1);
+    }
+  } else if (type == "unknown") {
+    type = "untyped";
+  }
+  Append("# TYPE ");
+  Append(name);
+  Append(" ");
+  Append(type);
+  Append("\n");
+  if (!help.empty()) {
+    Append("# HELP ");
+    Append(name);
+    Append(" ");
+    AppendEscaped(help, false);
+    Append("\n");
+  }
+}
+
+std::string_view MetricsTextWriter::CounterSuffix(std::string_view name) const {
+  return (format_ == Format::kOpenMetrics && !EndsWith(name, "_total")) ? "_total" : "";
+}
+
+void MetricsTextWriter::BeginSample(std::string_view name, std::string_view suffix) {
+  Append(name);
+  Append(suffix);
+  has_label_ = false;
+}
+
+void MetricsTextWriter::AddLabel(std::string_view name, std::string_view value) {
+  Append(has_label_ ? "," : "{");
+  has_label_ = true;
+  Append(name);
+  Append("=\"");
+  AppendEscaped(value, true);
+  Append("\"");
+}
+
+void MetricsTextWriter::AddLabel(std::string_view name, double value) { AddLabel(name, FormatDouble(value)); }
+
+void MetricsTextWriter::EndSample(double value) { AppendValue(FormatDouble(value)); }
+
+void MetricsTextWriter::EndSample(int64_t value) { AppendValue(fmt::format_int(value).c_str()); }
+
+void MetricsTextWriter::EndSample(uint64_t value) { AppendValue(fmt::format_int(value).c_str()); }
+
+void MetricsTextWriter::AppendValue(std::string_view value) {
+  Append(has_label_ ? "} " : " ");
+  has_label_ = false;
+  Append(value);
+  Append("\n");
+}
+
+void MetricsTextWriter::AppendEscaped(std::string_view text, bool escape_quote) {
+  std::size_t begin = 0;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    std::string_view escaped;
+    if (text[i] == '\\') {
+      escaped = "\\\\";
+    } else if (text[i] == '\n') {
+      escaped = "\\n";
+    } else if (text[i] == '"' && escape_quote) {
+      escaped = "\\\"";
+    } else {
+      continue;
+    }
+    Append(text.substr(begin, i - begin));
+    Append(escaped);
+    begin = i + 1;
+  }
+  Append(text.substr(begin));
+}
+
+void MetricsTextWriter::Append(std::string_view text) {
+  text_bytes_ += text.size();
+  if (!deflater_) {
+    builder_.Append(text.data(), text.size());
+    return;
+  }
+  pending_.append(text);
+  if (pending_.size() >= kDeflateThreshold) {
+    Deflate(false);
+  }
+}
+
+void MetricsTextWriter::Deflate(bool finish) {
+  auto& strm = deflater_->strm;
+  strm.next_in = reinterpret_cast<Bytef*>(pending_.data());
+  strm.avail_in = pending_.size();
+  int flush = finish ? Z_FINISH : Z_NO_FLUSH;
+  int ret = Z_OK;
+  // Runs deflate(...) until input drained and output still is not full.
+  do {
+    std::size_t available = builder_.SizeAvailable();
+    strm.next_out = reinterpret_cast<Bytef*>(builder_.data());
+    strm.avail_out = available;
+    ret = deflate(&strm, flush);
+    TRPC_ASSERT(ret != Z_STREAM_ERROR);
+    builder_.MarkWritten(available - strm.avail_out);
+  } while (strm.avail_out == 0 || (finish && ret != Z_STREAM_END));
+  TRPC_ASSERT(strm.avail_in == 0);
+  pending_.clear();
+}
+
+NoncontiguousBuffer MetricsTextWriter::Finish() {
+  if (format_ == Format::kOpenMetrics) {
+    Append("# EOF\n");
+  }
+  if (deflater_) {
+    Deflate(true);
+  }
+  return builder_.DestructiveGet();
+}
+
+std::string_view MetricsTextWriter::ContentType(Format format) {
+  if (format == Format::kOpenMetrics) {
+    return "application/openmetrics-text; version=1.0.0; charset=utf-8";
+  }
+  return "text/plain; version=0.0.4; charset=utf-8";
+}
+
+MetricsTextWriter::Format MetricsTextWriter::FormatFromAccept(std::string_view accept) {
+  return accept.find("application/openmetrics-text") != std::string_view::npos ? Format::kOpenMetrics
+                                                                                : Format::kPrometheus;
+}
+
+bool MetricsTextWriter::AcceptGzip(std::string_view accept_encoding) {
+  std::optional<double> gzip_q, any_q;
+  for (auto&& encoding : Split(accept_encoding, ',')) {
+    // eg: "gzip;q=0.5", the quality value defaults to 1, and 0 means "not acceptable".
+    auto params = Split(encoding, ';');
+    if (params.empty()) {
+      continue;
+    }
+    double q = 1;
+    for (std::size_t i = 1; i < params.size(); ++i) {
+      auto param = Trim(params[i]);
+      if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+        q = TryParse<double>(param.substr(2)).value_or(0);
+      }
+    }
+    auto coding = Trim(params[0]);
+    if (coding == "gzip") {
+      gzip_q = q;
+    } else if (coding == "*") {
+      any_q = q;
+    }
+  }
+  // An explicit "gzip" takes precedence over "*".
+  return gzip_q ? *gzip_q > 0 : any_q.value_or(0) > 0;
+}
+
+std::string MetricsTextWriter::SanitizeName(std::string_view name) {
+  std::string sanitized(name);
+  for (std::size_t i = 0; i < sanitized.size(); ++i) {
+    char c = sanitized[i];
+    bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' ||
+                 (i > 0 && c >= '0' && c <= '9');
+    if (!valid) {
+      sanitized[i] = '_';
+    }
+  }
+  return sanitized;
+}
+
+}  // namespace trpc::admin
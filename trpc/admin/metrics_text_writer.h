@@ -0,0 +1,100 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::admin {
+
+/// @brief Writes metrics in text exposition format directly into a non-contiguous buffer, the text is gzip-compressed
+///        on the fly if required. So neither an intermediate tree of the metrics nor the whole text is built.
+class MetricsTextWriter {
+ public:
+  enum class Format {
+    // Prometheus text format 0.0.4.
+    kPrometheus,
+    // OpenMetrics text format 1.0.0.
+    kOpenMetrics,
+  };
+
+  MetricsTextWriter(Format format, bool gzip);
+
+  ~MetricsTextWriter();
+
+  MetricsTextWriter(const MetricsTextWriter&) = delete;
+  MetricsTextWriter& operator=(const MetricsTextWriter&) = delete;
+
+  /// @brief Writes the metadata(`# TYPE` and `# HELP`) of a metric family.
+  /// @param type counter, gauge, summary, histogram or unknown.
+  /// @note The `_total` suffix of a counter is removed from the family name in OpenMetrics format.
+  void WriteFamily(std::string_view name, std::string_view type, std::string_view help);
+
+  /// @brief Suffix of the samples of a counter family, `_total` is required in OpenMetrics format.
+  std::string_view CounterSuffix(std::string_view name) const;
+
+  /// @brief Writes a sample, called as BeginSample, AddLabel(zero or more times) and EndSample.
+  void BeginSample(std::string_view name, std::string_view suffix = "");
+  void AddLabel(std::string_view name, std::string_view value);
+  void AddLabel(std::string_view name, double value);
+  void EndSample(double value);
+  void EndSample(int64_t value);
+  void EndSample(uint64_t value);
+
+  /// @brief Finishes the output, the writer can not be used any more.
+  /// @return The body, compressed if gzip is enabled.
+  NoncontiguousBuffer Finish();
+
+  /// @brief Bytes of the text before compression.
+  std::size_t TextBytes() const { return text_bytes_; }
+
+  Format GetFormat() const { return format_; }
+
+  bool IsGzip() const { return deflater_ != nullptr; }
+
+  /// @brief Content-Type of the format.
+  static std::string_view ContentType(Format format);
+
+  /// @brief Chooses the format from the `Accept` header of the request, OpenMetrics is used only when required.
+  static Format FormatFromAccept(std::string_view accept);
+
+  /// @brief Whether gzip is accepted according to the `Accept-Encoding` header of the request.
+  static bool AcceptGzip(std::string_view accept_encoding);
+
+  /// @brief Replaces the characters not allowed in a metric name with `_`.
+  static std::string SanitizeName(std::string_view name);
+
+ private:
+  struct Deflater;
+
+  void Append(std::string_view text);
+  void AppendEscaped(std::string_view text, bool escape_quote);
+  void AppendValue(std::string_view value);
+  void Deflate(bool finish);
+
+ private:
+  Format format_;
+  bool has_label_{false};
+  std::size_t text_bytes_{0};
+  NoncontiguousBufferBuilder builder_;
+  // Text waiting to be compressed, only used with gzip.
+  std::string pending_;
+  std::unique_ptr<Deflater> deflater_;
+};
+
+}  // namespace trpc::admin
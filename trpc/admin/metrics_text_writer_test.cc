@@ -0,0 +1,170 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/metrics_text_writer.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "zlib.h"
+
+namespace trpc::testing {
+
+using admin::MetricsTextWriter;
+
+namespace {
+
+std::string Gunzip(const NoncontiguousBuffer& compressed) {
+  std::string in = FlattenSlow(compressed);
+  z_stream strm{};
+  EXPECT_EQ(Z_OK, inflateInit2(&strm, MAX_WBITS + 16));
+  strm.next_in = reinterpret_cast<Bytef*>(in.data());
+  strm.avail_in = in.size();
+
+  std::string out;
+  char buffer[4096];
+  int ret = Z_OK;
+  do {
+    strm.next_out = reinterpret_cast<Bytef*>(buffer);
+    strm.avail_out = sizeof(buffer);
+    ret = inflate(&strm, Z_NO_FLUSH);
+    EXPECT_TRUE(ret == Z_OK || ret == Z_STREAM_END);
+    out.append(buffer, sizeof(buffer) - strm.avail_out);
+  } while (ret == Z_OK);
+  inflateEnd(&strm);
+  return out;
+}
+
+void WriteMetrics(MetricsTextWriter* writer) {
+  writer->WriteFamily("requests_total", "counter", "Total requests.");
+  writer->BeginSample("requests_total", writer->CounterSuffix("requests_total"));
+  writer->AddLabel("method", "get");
+  writer->AddLabel("code", "200");
+  writer->EndSample(static_cast<uint64_t>(10));
+
+  writer->WriteFamily("temperature", "gauge", "");
+  writer->BeginSample("temperature");
+  writer->EndSample(-1.5);
+
+  writer->WriteFamily("whatever", "unknown", "");
+  writer->BeginSample("whatever");
+  writer->EndSample(static_cast<int64_t>(-3));
+
+  writer->WriteFamily("latency", "histogram", "");
+  writer->BeginSample("latency", "_bucket");
+  writer->AddLabel("le", std::numeric_limits<double>::infinity());
+  writer->EndSample(static_cast<uint64_t>(2));
+}
+
+}  // namespace
+
+TEST(MetricsTextWriterTest, Prometheus) {
+  MetricsTextWriter writer(MetricsTextWriter::Format::kPrometheus, false);
+  WriteMetrics(&writer);
+  ASSERT_FALSE(writer.IsGzip());
+
+  std::string expected =
+      "# TYPE requests_total counter\n"
+      "# HELP requests_total Total requests.\n"
+      "requests_total{method=\"get\",code=\"200\"} 10\n"
+      "# TYPE temperature gauge\n"
+      "temperature -1.5\n"
+      "# TYPE whatever untyped\n"
+      "whatever -3\n"
+      "# TYPE latency histogram\n"
+      "latency_bucket{le=\"+Inf\"} 2\n";
+  auto body = writer.Finish();
+  ASSERT_EQ(expected, FlattenSlow(body));
+  ASSERT_EQ(expected.size(), writer.TextBytes());
+}
+
+TEST(MetricsTextWriterTest, OpenMetrics) {
+  MetricsTextWriter writer(MetricsTextWriter::Format::kOpenMetrics, false);
+  WriteMetrics(&writer);
+
+  std::string expected =
+      "# TYPE requests counter\n"
+      "# HELP requests Total requests.\n"
+      "requests_total{method=\"get\",code=\"200\"} 10\n"
+      "# TYPE temperature gauge\n"
+      "temperature -1.5\n"
+      "# TYPE whatever unknown\n"
+      "whatever -3\n"
+      "# TYPE latency histogram\n"
+      "latency_bucket{le=\"+Inf\"} 2\n"
+      "# EOF\n";
+  ASSERT_EQ(expected, FlattenSlow(writer.Finish()));
+}
+
+TEST(MetricsTextWriterTest, Escape) {
+  MetricsTextWriter writer(MetricsTextWriter::Format::kPrometheus, false);
+  writer.WriteFamily("m", "gauge", "a \"b\"\\\nc");
+  writer.BeginSample("m");
+  writer.AddLabel("l", "x\"y\\\nz");
+  writer.EndSample(std::nan(""));
+
+  ASSERT_EQ(
+      "# TYPE m gauge\n"
+      "# HELP m a \"b\"\\\\\\nc\n"
+      "m{l=\"x\\\"y\\\\\\nz\"} NaN\n",
+      FlattenSlow(writer.Finish()));
+}
+
+TEST(MetricsTextWriterTest, Gzip) {
+  MetricsTextWriter plain(MetricsTextWriter::Format::kPrometheus, false);
+  MetricsTextWriter gzip(MetricsTextWriter::Format::kPrometheus, true);
+  ASSERT_TRUE(gzip.IsGzip());
+  // Large enough to be compressed piece by piece.
+  for (int i = 0; i < 10000; ++i) {
+    for (auto* writer : {&plain, &gzip}) {
+      writer->WriteFamily("metric_" + std::to_string(i), "gauge", "help");
+      writer->BeginSample("metric_" + std::to_string(i));
+      writer->AddLabel("index", static_cast<double>(i));
+      writer->EndSample(i * 0.5);
+    }
+  }
+
+  std::string text = FlattenSlow(plain.Finish());
+  auto compressed = gzip.Finish();
+  ASSERT_EQ(text.size(), gzip.TextBytes());
+  ASSERT_LT(compressed.ByteSize(), text.size());
+  ASSERT_EQ(text, Gunzip(compressed));
+}
+
+TEST(MetricsTextWriterTest, Negotiation) {
+  ASSERT_EQ(MetricsTextWriter::Format::kPrometheus, MetricsTextWriter::FormatFromAccept(""));
+  ASSERT_EQ(MetricsTextWriter::Format::kPrometheus, MetricsTextWriter::FormatFromAccept("text/plain;version=0.0.4"));
+  ASSERT_EQ(MetricsTextWriter::Format::kOpenMetrics,
+            MetricsTextWriter::FormatFromAccept("application/openmetrics-text;version=1.0.0,text/plain;q=0.5"));
+
+  ASSERT_FALSE(MetricsTextWriter::AcceptGzip(""));
+  ASSERT_FALSE(MetricsTextWriter::AcceptGzip("deflate, br"));
+  ASSERT_TRUE(MetricsTextWriter::AcceptGzip("deflate, gzip;q=0.5"));
+  ASSERT_TRUE(MetricsTextWriter::AcceptGzip("*"));
+  ASSERT_FALSE(MetricsTextWriter::AcceptGzip("gzip;q=0"));
+  ASSERT_FALSE(MetricsTextWriter::AcceptGzip("deflate, gzip; q=0.0, *"));
+  ASSERT_FALSE(MetricsTextWriter::AcceptGzip("*;q=0"));
+  ASSERT_TRUE(MetricsTextWriter::AcceptGzip("gzip;q=0.001"));
+
+  ASSERT_EQ("text/plain; version=0.0.4; charset=utf-8",
+            MetricsTextWriter::ContentType(MetricsTextWriter::Format::kPrometheus));
+}
+
+TEST(MetricsTextWriterTest, SanitizeName) {
+  ASSERT_EQ("trpc_server_service_a_b_1", MetricsTextWriter::SanitizeName("trpc/server/service/a.b-1"));
+  ASSERT_EQ("_a:b", MetricsTextWriter::SanitizeName("9a:b"));
+}
+
+}  // namespace trpc::testing
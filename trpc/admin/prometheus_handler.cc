@@ -14,18 +14,94 @@
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
 #include "trpc/admin/prometheus_handler.h"
 
-#include "prometheus/text_serializer.h"
+#include <utility>
+
+#include "trpc/admin/metrics_handler.h"
+#include "trpc/util/time.h"
 
 namespace trpc::admin {
 
+namespace {
+
+void BeginSample(const ::prometheus::MetricFamily& family, const ::prometheus::ClientMetric& metric,
+                 std::string_view suffix, MetricsTextWriter* writer) {
+  writer->BeginSample(family.name, suffix);
+  for (auto&& label : metric.label) {
+    writer->AddLabel(label.name, label.value);
+  }
+}
+
+std::string_view TypeName(::prometheus::MetricType type) {
+  switch (type) {
+    case ::prometheus::MetricType::Counter:
+      return "counter";
+    case ::prometheus::MetricType::Gauge:
+      return "gauge";
+    case ::prometheus::MetricType::Summary:
+      return "summary";
+    case ::prometheus::MetricType::Histogram:
+      return "histogram";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace
+
+void WriteMetricFamily(const ::prometheus::MetricFamily& family, MetricsTextWriter* writer) {
+  writer->WriteFamily(family.name, TypeName(family.type), family.help);
+  for (auto&& metric : family.metric) {
+    switch (family.type) {
+      case ::prometheus::MetricType::Counter:
+        BeginSample(family, metric, writer->CounterSuffix(family.name), writer);
+        writer->EndSample(metric.counter.value);
+        break;
+      case ::prometheus::MetricType::Gauge:
+        BeginSample(family, metric, "", writer);
+        writer->EndSample(metric.gauge.value);
+        break;
+      case ::prometheus::MetricType::Summary:
+        for (auto&& quantile : metric.summary.quantile) {
+          BeginSample(family, metric, "", writer);
+          writer->AddLabel("quantile", quantile.quantile);
+          writer->EndSample(quantile.value);
+        }
+        BeginSample(family, metric, "_sum", writer);
+        writer->EndSample(metric.summary.sample_sum);
+        BeginSample(family, metric, "_count", writer);
+        writer->EndSample(static_cast<uint64_t>(metric.summary.sample_count));
+        break;
+      case ::prometheus::MetricType::Histogram:
+        for (auto&& bucket : metric.histogram.bucket) {
+          BeginSample(family, metric, "_bucket", writer);
+          writer->AddLabel("le", bucket.upper_bound);
+          writer->EndSample(static_cast<uint64_t>(bucket.cumulative_count));
+        }
+        BeginSample(family, metric, "_sum", writer);
+        writer->EndSample(metric.histogram.sample_sum);
+        BeginSample(family, metric, "_count", writer);
+        writer->EndSample(static_cast<uint64_t>(metric.histogram.sample_count));
+        break;
+      default:
+        BeginSample(family, metric, "", writer);
+        writer->EndSample(metric.untyped.value);
+        break;
+    }
+  }
+}
+
 PrometheusHandler::PrometheusHandler() { description_ = "[GET /metrics] get prometheus metrics"; }
 
-void PrometheusHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
-                                      rapidjson::Document::AllocatorType& alloc) {
-  static std::unique_ptr<::prometheus::Serializer> serializer = std::make_unique<::prometheus::TextSerializer>();
+trpc::Status PrometheusHandler::Handle(const std::string& path, trpc::ServerContextPtr context,
+                                       http::HttpRequestPtr req, http::HttpResponse* reply) {
+  static ScrapeStats stats("prometheus");
 
-  std::string prometheus_str = serializer->Serialize(trpc::prometheus::Collect());
-  result.AddMember(rapidjson::StringRef("trpc-html"), rapidjson::Value(prometheus_str, alloc).Move(), alloc);
+  auto begin_us = trpc::time::GetSteadyMicroSeconds();
+  auto writer = CreateMetricsTextWriter(req);
+  trpc::prometheus::CollectEach(
+      [&writer](const ::prometheus::MetricFamily& family) { WriteMetricFamily(family, &writer); });
+  ReplyMetrics(std::move(writer), begin_us, &stats, reply);
+  return kDefaultStatus;
 }
 
 }  // namespace trpc::admin
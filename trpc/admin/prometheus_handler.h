@@ -15,18 +15,27 @@
 #pragma once
 
 #include "trpc/admin/admin_handler.h"
+#include "trpc/admin/metrics_text_writer.h"
 #include "trpc/util/prometheus.h"
 
 namespace trpc::admin {
 
-/// @brief Handles the request for getting result of Prometheus monitor.
+/// @brief Handles the request for getting the prometheus metrics. The metrics are written family by family into the
+///        response in Prometheus text format, or OpenMetrics text format if required by the `Accept` header, and are
+///        gzip-compressed if accepted by the `Accept-Encoding` header.
 class PrometheusHandler : public AdminHandlerBase {
  public:
   PrometheusHandler();
 
   void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
-                     rapidjson::Document::AllocatorType& alloc) override;
+                     rapidjson::Document::AllocatorType& alloc) override {}
+
+  trpc::Status Handle(const std::string& path, trpc::ServerContextPtr context, http::HttpRequestPtr req,
+                      http::HttpResponse* reply) override;
 };
 
+/// @brief Writes a metric family collected by prometheus.
+void WriteMetricFamily(const ::prometheus::MetricFamily& family, MetricsTextWriter* writer);
+
 }  // namespace trpc::admin
 #endif
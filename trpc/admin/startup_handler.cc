@@ -0,0 +1,42 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/startup_handler.h"
+
+#include "trpc/common/startup_trace.h"
+
+namespace trpc::admin {
+
+void StartupHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                                   rapidjson::Document::AllocatorType& alloc) {
+  auto spans = StartupTrace::GetInstance()->GetSpans();
+  uint64_t base_us = spans.empty() ? 0 : spans.front().begin_us;
+
+  rapidjson::Value steps(rapidjson::kArrayType);
+  for (const auto& span : spans) {
+    rapidjson::Value step(rapidjson::kObjectType);
+    step.AddMember("name", rapidjson::Value(span.name.c_str(), alloc), alloc);
+    step.AddMember("category", rapidjson::Value(span.category.c_str(), alloc), alloc);
+    step.AddMember("begin_us", span.begin_us - base_us, alloc);
+    step.AddMember("cost_us", span.cost_us, alloc);
+    step.AddMember("lane", span.lane, alloc);
+    step.AddMember("ok", span.ok, alloc);
+    steps.PushBack(step, alloc);
+  }
+
+  result.AddMember("errorcode", 0, alloc);
+  result.AddMember("message", "", alloc);
+  result.AddMember("steps", steps, alloc);
+}
+
+}  // namespace trpc::admin
@@ -0,0 +1,31 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "trpc/admin/admin_handler.h"
+
+namespace trpc::admin {
+
+/// @brief Handles the request for getting the time the startup stages and the plugin initializations take.
+class StartupHandler : public AdminHandlerBase {
+ public:
+  StartupHandler() { description_ = "[GET /cmds/startup]    get the time each startup stage and plugin init takes"; }
+  ~StartupHandler() override = default;
+
+  /// @brief Replies the steps recorded in `StartupTrace`, sorted by the begin time(us, relative to the first one).
+  void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                     rapidjson::Document::AllocatorType& alloc) override;
+};
+
+}  // namespace trpc::admin
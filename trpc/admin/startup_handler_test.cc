@@ -0,0 +1,55 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/startup_handler.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "rapidjson/document.h"
+
+#include "trpc/common/startup_trace.h"
+#include "trpc/server/server_context.h"
+
+namespace trpc::testing {
+
+TEST(StartupHandler, Test) {
+  StartupTrace::GetInstance()->Clear();
+  StartupTrace::GetInstance()->Record({"metrics#2", "plugin", 1100, 300, 1, true});
+  StartupTrace::GetInstance()->Record({"TrpcPlugin::RegisterPlugins", "stage", 1000, 500, 0, true});
+
+  auto handler = std::make_unique<admin::StartupHandler>();
+  http::HttpRequestPtr req = std::make_shared<http::HttpRequest>();
+  http::HttpResponse reply;
+  ServerContextPtr context;
+  handler->Handle("", context, req, &reply);
+
+  rapidjson::Document doc;
+  doc.Parse(reply.GetContent().c_str());
+  ASSERT_FALSE(doc.HasParseError());
+  ASSERT_EQ(0, doc["errorcode"].GetInt());
+  const auto& steps = doc["steps"];
+  ASSERT_EQ(2, steps.Size());
+  ASSERT_STREQ("TrpcPlugin::RegisterPlugins", steps[0]["name"].GetString());
+  ASSERT_EQ(0, steps[0]["begin_us"].GetUint64());
+  ASSERT_STREQ("metrics#2", steps[1]["name"].GetString());
+  ASSERT_STREQ("plugin", steps[1]["category"].GetString());
+  ASSERT_EQ(100, steps[1]["begin_us"].GetUint64());
+  ASSERT_EQ(300, steps[1]["cost_us"].GetUint64());
+  ASSERT_EQ(1, steps[1]["lane"].GetUint());
+  ASSERT_TRUE(steps[1]["ok"].GetBool());
+
+  StartupTrace::GetInstance()->Clear();
+}
+
+}  // namespace trpc::testing
@@ -21,6 +21,7 @@
 #include "trpc/admin/web_css_jquery.h"
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/runtime/common/stats/frame_stats.h"
+#include "trpc/runtime/iomodel/reactor/common/write_buffer_budget.h"
 #include "trpc/tvar/common/tvar_group.h"
 #include "trpc/util/log/logging.h"
 #ifdef TRPC_BUILD_INCLUDE_RPCZ
@@ -92,6 +93,26 @@ void PrintStatsData(std::string* html) {
   html->append(std::to_string(FrameStats::GetInstance()->GetServerStats().GetLastMaxDelay()));
   html->append("</td>\n</tr>\n");
 
+  html->append("<tr>\n");
+  html->append("<td>write_buffer_used</td>\n<td>");
+  html->append(std::to_string(WriteBufferBudget::Global()->GetUsed()));
+  html->append("</td>\n</tr>\n");
+
+  html->append("<tr>\n");
+  html->append("<td>write_buffer_budget</td>\n<td>");
+  html->append(std::to_string(WriteBufferBudget::Global()->GetLimit()));
+  html->append("</td>\n</tr>\n");
+
+  html->append("<tr>\n");
+  html->append("<td>write_buffer_rejected_count</td>\n<td>");
+  html->append(std::to_string(WriteBufferBudget::Global()->GetRejectedCount()));
+  html->append("</td>\n</tr>\n");
+
+  html->append("<tr>\n");
+  html->append("<td>read_paused_conn_count</td>\n<td>");
+  html->append(std::to_string(WriteBufferBudget::Global()->GetPausedConnectionCount()));
+  html->append("</td>\n</tr>\n");
+
   html->append("</table>\n");
 }
 }  // namespace
@@ -122,6 +143,11 @@ void StatsHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& res
   stats.AddMember("last_avg_delay", FrameStats::GetInstance()->GetServerStats().GetAvgLastDelay(), alloc);
   stats.AddMember("max_delay", FrameStats::GetInstance()->GetServerStats().GetMaxDelay(), alloc);
   stats.AddMember("last_max_delay", FrameStats::GetInstance()->GetServerStats().GetLastMaxDelay(), alloc);
+  // The bytes used are only accounted when `global.write_buffer_budget` is set.
+  stats.AddMember("write_buffer_used", static_cast<uint64_t>(WriteBufferBudget::Global()->GetUsed()), alloc);
+  stats.AddMember("write_buffer_budget", static_cast<uint64_t>(WriteBufferBudget::Global()->GetLimit()), alloc);
+  stats.AddMember("write_buffer_rejected_count", WriteBufferBudget::Global()->GetRejectedCount(), alloc);
+  stats.AddMember("read_paused_conn_count", WriteBufferBudget::Global()->GetPausedConnectionCount(), alloc);
 
   result.AddMember("stats", stats, alloc);
 }
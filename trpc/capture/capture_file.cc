@@ -0,0 +1,224 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/capture/capture_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::capture {
+
+namespace {
+
+// Header of a record, followed by the protocol, the service and the frame, padded to 8 bytes.
+struct RecordHeader {
+  // size of the whole record, published last, 0 means no more record
+  uint32_t record_size;
+  uint16_t protocol_size;
+  uint16_t service_size;
+  uint64_t timestamp_us;
+  uint32_t frame_size;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(RecordHeader) == 24);
+
+constexpr std::size_t kRecordAlignment = 8;
+
+std::size_t AlignUp(std::size_t size) { return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1); }
+
+}  // namespace
+
+bool CaptureWriter::Open(const std::string& path, std::size_t capacity) {
+  if (IsOpened()) {
+    TRPC_FMT_ERROR("capture file already opened.");
+    return false;
+  }
+  if (capacity <= kCaptureFileHeaderSize) {
+    TRPC_FMT_ERROR("capacity {} of capture file {} is too small.", capacity, path);
+    return false;
+  }
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    TRPC_FMT_ERROR("open capture file {} failed, errno: {}.", path, errno);
+    return false;
+  }
+  if (::ftruncate(fd, capacity) != 0) {
+    TRPC_FMT_ERROR("resize capture file {} to {} failed, errno: {}.", path, capacity, errno);
+    ::close(fd);
+    return false;
+  }
+  void* base = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    TRPC_FMT_ERROR("mmap capture file {} failed, errno: {}.", path, errno);
+    ::close(fd);
+    return false;
+  }
+
+  fd_ = fd;
+  base_ = static_cast<char*>(base);
+  capacity_ = capacity;
+  offset_.store(kCaptureFileHeaderSize, std::memory_order_relaxed);
+  records_.store(0, std::memory_order_relaxed);
+  dropped_.store(0, std::memory_order_relaxed);
+  memcpy(base_, kCaptureFileMagic, sizeof(kCaptureFileMagic));
+  return true;
+}
+
+bool CaptureWriter::Append(uint64_t timestamp_us, std::string_view protocol, std::string_view service,
+                           const NoncontiguousBuffer& frame) {
+  if (!IsOpened()) {
+    return false;
+  }
+
+  protocol = protocol.substr(0, UINT16_MAX);
+  service = service.substr(0, UINT16_MAX);
+  std::size_t size = AlignUp(sizeof(RecordHeader) + protocol.size() + service.size() + frame.ByteSize());
+  if (size > UINT32_MAX) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  std::size_t offset = offset_.fetch_add(size, std::memory_order_relaxed);
+  if (offset + size > capacity_) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  char* record = base_ + offset;
+  RecordHeader header{0, static_cast<uint16_t>(protocol.size()), static_cast<uint16_t>(service.size()), timestamp_us,
+                      static_cast<uint32_t>(frame.ByteSize()), 0};
+  memcpy(record, &header, sizeof(header));
+  char* p = record + sizeof(header);
+  memcpy(p, protocol.data(), protocol.size());
+  p += protocol.size();
+  memcpy(p, service.data(), service.size());
+  p += service.size();
+  for (auto iter = frame.begin(); iter != frame.end(); ++iter) {
+    memcpy(p, iter->data(), iter->size());
+    p += iter->size();
+  }
+
+  __atomic_store_n(reinterpret_cast<uint32_t*>(record), static_cast<uint32_t>(size), __ATOMIC_RELEASE);
+  records_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void CaptureWriter::Close() {
+  if (!IsOpened()) {
+    return;
+  }
+
+  std::size_t used = std::min(offset_.load(std::memory_order_relaxed), capacity_);
+  ::msync(base_, capacity_, MS_SYNC);
+  ::munmap(base_, capacity_);
+  // Keep the zeroed 8 bytes after the last record, which end the records.
+  if (used + kRecordAlignment <= capacity_) {
+    used += kRecordAlignment;
+  }
+  if (::ftruncate(fd_, used) != 0) {
+    TRPC_FMT_WARN("truncate capture file to {} failed, errno: {}.", used, errno);
+  }
+  ::close(fd_);
+
+  fd_ = -1;
+  base_ = nullptr;
+  capacity_ = 0;
+}
+
+bool CaptureReader::Open(const std::string& path) {
+  Close();
+
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    TRPC_FMT_ERROR("open capture file {} failed, errno: {}.", path, errno);
+    return false;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < kCaptureFileHeaderSize) {
+    TRPC_FMT_ERROR("capture file {} is too small.", path);
+    ::close(fd);
+    return false;
+  }
+  void* base = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    TRPC_FMT_ERROR("mmap capture file {} failed, errno: {}.", path, errno);
+    ::close(fd);
+    return false;
+  }
+  if (memcmp(base, kCaptureFileMagic, sizeof(kCaptureFileMagic)) != 0) {
+    TRPC_FMT_ERROR("{} is not a capture file.", path);
+    ::munmap(base, st.st_size);
+    ::close(fd);
+    return false;
+  }
+
+  fd_ = fd;
+  base_ = static_cast<const char*>(base);
+  size_ = st.st_size;
+  offset_ = kCaptureFileHeaderSize;
+  return true;
+}
+
+bool CaptureReader::Next(CaptureRecord* record) {
+  if (base_ == nullptr || offset_ + sizeof(RecordHeader) > size_) {
+    return false;
+  }
+
+  const char* p = base_ + offset_;
+  uint32_t record_size = __atomic_load_n(reinterpret_cast<const uint32_t*>(p), __ATOMIC_ACQUIRE);
+  if (record_size == 0) {
+    return false;
+  }
+
+  RecordHeader header;
+  memcpy(&header, p, sizeof(header));
+  std::size_t payload_size = static_cast<std::size_t>(header.protocol_size) + header.service_size + header.frame_size;
+  if (record_size < sizeof(RecordHeader) + payload_size || offset_ + record_size > size_) {
+    TRPC_FMT_ERROR("broken record at offset {} of capture file.", offset_);
+    return false;
+  }
+
+  p += sizeof(header);
+  record->timestamp_us = header.timestamp_us;
+  record->protocol = std::string_view(p, header.protocol_size);
+  p += header.protocol_size;
+  record->service = std::string_view(p, header.service_size);
+  p += header.service_size;
+  record->frame = std::string_view(p, header.frame_size);
+
+  offset_ += record_size;
+  return true;
+}
+
+void CaptureReader::Close() {
+  if (base_ != nullptr) {
+    ::munmap(const_cast<char*>(base_), size_);
+    ::close(fd_);
+  }
+  fd_ = -1;
+  base_ = nullptr;
+  size_ = 0;
+  offset_ = kCaptureFileHeaderSize;
+}
+
+}  // namespace trpc::capture
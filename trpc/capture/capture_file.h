@@ -0,0 +1,114 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::capture {
+
+/// @brief A request frame in the capture file.
+struct CaptureRecord {
+  /// steady time(us) when the request arrives
+  uint64_t timestamp_us{0};
+
+  /// name of the codec the request is decoded by, eg: "trpc", "http"
+  std::string_view protocol;
+
+  /// name of the service the request is received by
+  std::string_view service;
+
+  /// raw bytes of the request as received, it can be resent as-is
+  std::string_view frame;
+};
+
+/// @brief Magic number at the beginning of the capture file.
+constexpr char kCaptureFileMagic[8] = {'T', 'R', 'P', 'C', 'C', 'A', 'P', '\x01'};
+
+/// @brief Size of the file header, records start right after it.
+constexpr std::size_t kCaptureFileHeaderSize = 64;
+
+/// @brief Appends request frames to a memory-mapped file of fixed capacity. Space is reserved by an atomic add so
+///        appending from multiple threads takes no lock, and the records which do not fit in the file are dropped.
+///        A record is visible to readers(also from other processes) once its size is published, the zeroed tail of
+///        the file ends the records.
+class CaptureWriter {
+ public:
+  CaptureWriter() = default;
+  ~CaptureWriter() { Close(); }
+
+  CaptureWriter(const CaptureWriter&) = delete;
+  CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+  /// @brief Creates(truncates if exists) the file and maps `capacity` bytes of it.
+  bool Open(const std::string& path, std::size_t capacity);
+
+  /// @brief Appends a record.
+  /// @return false if the file is not opened or full.
+  bool Append(uint64_t timestamp_us, std::string_view protocol, std::string_view service,
+              const NoncontiguousBuffer& frame);
+
+  /// @brief Unmaps the file and truncates it to the size of the records.
+  /// @note  Not thread-safe, all the appending must have finished.
+  void Close();
+
+  bool IsOpened() const { return base_ != nullptr; }
+
+  /// @brief Number of the records appended.
+  uint64_t GetRecordCount() const { return records_.load(std::memory_order_relaxed); }
+
+  /// @brief Number of the records dropped as the file is full.
+  uint64_t GetDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  int fd_{-1};
+  char* base_{nullptr};
+  std::size_t capacity_{0};
+  std::atomic<std::size_t> offset_{kCaptureFileHeaderSize};
+  std::atomic<uint64_t> records_{0};
+  std::atomic<uint64_t> dropped_{0};
+};
+
+/// @brief Reads the records of a capture file in order of appending.
+class CaptureReader {
+ public:
+  CaptureReader() = default;
+  ~CaptureReader() { Close(); }
+
+  CaptureReader(const CaptureReader&) = delete;
+  CaptureReader& operator=(const CaptureReader&) = delete;
+
+  bool Open(const std::string& path);
+
+  /// @brief Reads the next record, the views in it are valid until the reader is closed.
+  /// @return false if there is no more record.
+  bool Next(CaptureRecord* record);
+
+  /// @brief Goes back to the first record.
+  void Rewind() { offset_ = kCaptureFileHeaderSize; }
+
+  void Close();
+
+ private:
+  int fd_{-1};
+  const char* base_{nullptr};
+  std::size_t size_{0};
+  std::size_t offset_{kCaptureFileHeaderSize};
+};
+
+}  // namespace trpc::capture
@@ -0,0 +1,150 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/capture/capture_file.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::capture::testing {
+
+class CaptureFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override { path_ = "./capture_file_test." + std::to_string(::getpid()) + ".bin"; }
+
+  void TearDown() override { ::unlink(path_.c_str()); }
+
+  std::string path_;
+};
+
+TEST_F(CaptureFileTest, AppendAndRead) {
+  CaptureWriter writer;
+  ASSERT_TRUE(writer.Open(path_, 4096));
+  ASSERT_TRUE(writer.Append(100, "trpc", "trpc.test.helloworld.Greeter", CreateBufferSlow("hello")));
+  ASSERT_TRUE(writer.Append(200, "http", "", CreateBufferSlow("GET / HTTP/1.1\r\n\r\n")));
+  ASSERT_TRUE(writer.Append(300, "trpc", "trpc.test.helloworld.Greeter", NoncontiguousBuffer()));
+  ASSERT_EQ(3, writer.GetRecordCount());
+
+  // Readable before the writer closes.
+  CaptureReader reader;
+  ASSERT_TRUE(reader.Open(path_));
+  CaptureRecord record;
+  ASSERT_TRUE(reader.Next(&record));
+  ASSERT_EQ(100, record.timestamp_us);
+  ASSERT_EQ("trpc", record.protocol);
+  ASSERT_EQ("trpc.test.helloworld.Greeter", record.service);
+  ASSERT_EQ("hello", record.frame);
+  ASSERT_TRUE(reader.Next(&record));
+  ASSERT_EQ(200, record.timestamp_us);
+  ASSERT_EQ("http", record.protocol);
+  ASSERT_EQ("", record.service);
+  ASSERT_EQ("GET / HTTP/1.1\r\n\r\n", record.frame);
+  ASSERT_TRUE(reader.Next(&record));
+  ASSERT_EQ(300, record.timestamp_us);
+  ASSERT_EQ("", record.frame);
+  ASSERT_FALSE(reader.Next(&record));
+  reader.Close();
+
+  // The file is truncated to the records on close.
+  writer.Close();
+  ASSERT_TRUE(reader.Open(path_));
+  int count = 0;
+  while (reader.Next(&record)) {
+    ++count;
+  }
+  ASSERT_EQ(3, count);
+  reader.Rewind();
+  ASSERT_TRUE(reader.Next(&record));
+  ASSERT_EQ("hello", record.frame);
+}
+
+TEST_F(CaptureFileTest, Full) {
+  CaptureWriter writer;
+  ASSERT_TRUE(writer.Open(path_, 1024));
+
+  std::string frame(100, 'x');
+  int appended = 0;
+  for (int i = 0; i < 20; ++i) {
+    if (writer.Append(i, "trpc", "service", CreateBufferSlow(frame))) {
+      ++appended;
+    }
+  }
+  ASSERT_GT(appended, 0);
+  ASSERT_LT(appended, 20);
+  ASSERT_EQ(appended, writer.GetRecordCount());
+  ASSERT_EQ(20 - appended, writer.GetDroppedCount());
+  writer.Close();
+
+  CaptureReader reader;
+  ASSERT_TRUE(reader.Open(path_));
+  CaptureRecord record;
+  int count = 0;
+  while (reader.Next(&record)) {
+    ASSERT_EQ(frame, record.frame);
+    ++count;
+  }
+  ASSERT_EQ(appended, count);
+}
+
+TEST_F(CaptureFileTest, ConcurrentAppend) {
+  constexpr int kThreads = 4;
+  constexpr int kRecords = 1000;
+
+  CaptureWriter writer;
+  ASSERT_TRUE(writer.Open(path_, 1024 * 1024));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j < kRecords; ++j) {
+        NoncontiguousBufferBuilder builder;
+        builder.Append(std::string(j % 50, 'a' + i));
+        builder.Append(std::to_string(j));
+        writer.Append(j, "trpc", std::to_string(i), builder.DestructiveGet());
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(kThreads * kRecords, writer.GetRecordCount());
+  writer.Close();
+
+  CaptureReader reader;
+  ASSERT_TRUE(reader.Open(path_));
+  CaptureRecord record;
+  int count = 0;
+  while (reader.Next(&record)) {
+    int i = std::stoi(std::string(record.service));
+    int j = record.timestamp_us;
+    ASSERT_EQ(std::string(j % 50, 'a' + i) + std::to_string(j), record.frame);
+    ++count;
+  }
+  ASSERT_EQ(kThreads * kRecords, count);
+}
+
+TEST_F(CaptureFileTest, OpenFailed) {
+  CaptureWriter writer;
+  ASSERT_FALSE(writer.Open(path_, kCaptureFileHeaderSize));
+  ASSERT_FALSE(writer.Open("./not_exist_dir/capture.bin", 4096));
+  ASSERT_FALSE(writer.Append(0, "trpc", "", CreateBufferSlow("hello")));
+
+  CaptureReader reader;
+  ASSERT_FALSE(reader.Open("./not_exist_dir/capture.bin"));
+}
+
+}  // namespace trpc::capture::testing
@@ -0,0 +1,102 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/capture/traffic_capture.h"
+
+#include <utility>
+
+#include "trpc/util/http/request.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc::capture {
+
+namespace {
+
+bool TrpcFrame(const std::any& msg, NoncontiguousBuffer& frame) {
+  const auto* buffer = std::any_cast<NoncontiguousBuffer>(&msg);
+  if (buffer == nullptr) {
+    return false;
+  }
+  // Shares the blocks of the message, no copy.
+  frame = *buffer;
+  return true;
+}
+
+bool HttpFrame(const std::any& msg, NoncontiguousBuffer& frame) {
+  const auto* request = std::any_cast<http::RequestPtr>(&msg);
+  if (request == nullptr || *request == nullptr) {
+    return false;
+  }
+  NoncontiguousBufferBuilder builder;
+  if (!(*request)->SerializeToString(builder)) {
+    return false;
+  }
+  frame = builder.DestructiveGet();
+  return true;
+}
+
+}  // namespace
+
+TrafficCapture::TrafficCapture() {
+  RegisterFrameFunction("trpc", TrpcFrame);
+  RegisterFrameFunction("http", HttpFrame);
+  RegisterFrameFunction("trpc_over_http", HttpFrame);
+}
+
+void TrafficCapture::RegisterFrameFunction(const std::string& protocol, CaptureFrameFunction&& func) {
+  frame_functions_[protocol] = std::move(func);
+}
+
+bool TrafficCapture::Start(const std::string& path, std::size_t max_size) {
+  if (IsStarted()) {
+    return true;
+  }
+  if (!writer_.Open(path, max_size)) {
+    return false;
+  }
+
+  started_.store(true, std::memory_order_release);
+  TRPC_FMT_INFO("start capturing requests to {}, max size: {}.", path, max_size);
+  return true;
+}
+
+void TrafficCapture::Stop() {
+  if (!IsStarted()) {
+    return;
+  }
+
+  started_.store(false, std::memory_order_release);
+  TRPC_FMT_INFO("stop capturing requests, captured: {}, dropped: {}.", writer_.GetRecordCount(),
+                writer_.GetDroppedCount());
+  writer_.Close();
+}
+
+bool TrafficCapture::Capture(uint64_t timestamp_us, const std::string& protocol, const std::string& service,
+                             const std::any& msg) {
+  if (!IsStarted()) {
+    return false;
+  }
+
+  auto it = frame_functions_.find(protocol);
+  if (it == frame_functions_.end()) {
+    return false;
+  }
+
+  NoncontiguousBuffer frame;
+  if (!it->second(msg, frame)) {
+    return false;
+  }
+  return writer_.Append(timestamp_us, protocol, service, frame);
+}
+
+}  // namespace trpc::capture
@@ -0,0 +1,88 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <any>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "trpc/capture/capture_file.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/function.h"
+
+namespace trpc::capture {
+
+/// @brief Converts a request message checked out by the codec(the output of `ServerCodec::ZeroCopyCheck`) back to
+///        the raw bytes received, which can be resent as-is.
+using CaptureFrameFunction = Function<bool(const std::any& msg, NoncontiguousBuffer& frame)>;
+
+/// @brief Samples one out of every `sample_rate` requests, 0 means never.
+class CaptureSampler {
+ public:
+  explicit CaptureSampler(uint32_t sample_rate) : sample_rate_(sample_rate) {}
+
+  bool Sample() {
+    return sample_rate_ != 0 && counter_.fetch_add(1, std::memory_order_relaxed) % sample_rate_ == 0;
+  }
+
+ private:
+  uint32_t sample_rate_;
+  std::atomic<uint64_t> counter_{0};
+};
+
+/// @brief Captures the requests received by the server(sampled by `capture_sample_rate` of the service) to a capture
+///        file, which can be replayed by the replay tool(trpc/tools/replay).
+/// @note  The frames of "trpc", "http" and "trpc_over_http" can be captured by default, the frames of other
+///        protocols are skipped unless `RegisterFrameFunction` is called for the protocol.
+class TrafficCapture {
+ public:
+  static TrafficCapture* GetInstance() {
+    static TrafficCapture instance;
+    return &instance;
+  }
+
+  /// @brief Registers how to get the raw bytes of the request messages of a protocol.
+  /// @note  Not thread-safe, it should be called before `Start`.
+  void RegisterFrameFunction(const std::string& protocol, CaptureFrameFunction&& func);
+
+  /// @brief Starts capturing to `path`, at most `max_size` bytes are captured.
+  bool Start(const std::string& path, std::size_t max_size);
+
+  /// @brief Stops capturing, it should be called after all the services stop.
+  void Stop();
+
+  bool IsStarted() const { return started_.load(std::memory_order_acquire); }
+
+  /// @brief Captures a request message checked out by the codec of `protocol`.
+  /// @return false if not started, the protocol is not supported or the capture file is full.
+  bool Capture(uint64_t timestamp_us, const std::string& protocol, const std::string& service, const std::any& msg);
+
+  /// @brief Number of the requests captured.
+  uint64_t GetCapturedCount() const { return writer_.GetRecordCount(); }
+
+  /// @brief Number of the requests dropped as the capture file is full.
+  uint64_t GetDroppedCount() const { return writer_.GetDroppedCount(); }
+
+ private:
+  TrafficCapture();
+
+ private:
+  std::atomic<bool> started_{false};
+  CaptureWriter writer_;
+  std::unordered_map<std::string, CaptureFrameFunction> frame_functions_;
+};
+
+}  // namespace trpc::capture
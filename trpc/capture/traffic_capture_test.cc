@@ -0,0 +1,84 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/capture/traffic_capture.h"
+
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/http/request.h"
+
+namespace trpc::capture::testing {
+
+TEST(CaptureSamplerTest, Sample) {
+  CaptureSampler never(0);
+  CaptureSampler every_third(3);
+  int sampled = 0;
+  for (int i = 0; i < 9; ++i) {
+    ASSERT_FALSE(never.Sample());
+    sampled += every_third.Sample() ? 1 : 0;
+  }
+  ASSERT_EQ(3, sampled);
+}
+
+TEST(TrafficCaptureTest, Capture) {
+  std::string path = "./traffic_capture_test." + std::to_string(::getpid()) + ".bin";
+  auto* capture = TrafficCapture::GetInstance();
+
+  // Not started.
+  ASSERT_FALSE(capture->Capture(1, "trpc", "service", std::any(CreateBufferSlow("trpc frame"))));
+
+  capture->RegisterFrameFunction("custom", [](const std::any& msg, NoncontiguousBuffer& frame) {
+    frame = CreateBufferSlow(std::any_cast<std::string>(msg));
+    return true;
+  });
+  ASSERT_TRUE(capture->Start(path, 4096));
+  ASSERT_TRUE(capture->IsStarted());
+
+  ASSERT_TRUE(capture->Capture(1, "trpc", "service", std::any(CreateBufferSlow("trpc frame"))));
+  auto request = std::make_shared<http::Request>();
+  request->SetMethod("GET");
+  request->SetUrl("/hello");
+  ASSERT_TRUE(capture->Capture(2, "http", "service", std::any(request)));
+  ASSERT_TRUE(capture->Capture(3, "custom", "service", std::any(std::string("custom frame"))));
+  // Unsupported protocol or unexpected message.
+  ASSERT_FALSE(capture->Capture(4, "grpc", "service", std::any(CreateBufferSlow("grpc frame"))));
+  ASSERT_FALSE(capture->Capture(5, "trpc", "service", std::any(std::string("not a buffer"))));
+  ASSERT_EQ(3, capture->GetCapturedCount());
+
+  capture->Stop();
+  ASSERT_FALSE(capture->IsStarted());
+
+  CaptureReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  CaptureRecord record;
+  ASSERT_TRUE(reader.Next(&record));
+  ASSERT_EQ("trpc", record.protocol);
+  ASSERT_EQ("service", record.service);
+  ASSERT_EQ("trpc frame", record.frame);
+  ASSERT_TRUE(reader.Next(&record));
+  ASSERT_EQ("http", record.protocol);
+  ASSERT_EQ(0, record.frame.find("GET /hello HTTP/1.1\r\n"));
+  ASSERT_TRUE(reader.Next(&record));
+  ASSERT_EQ("custom", record.protocol);
+  ASSERT_EQ("custom frame", record.frame);
+  ASSERT_FALSE(reader.Next(&record));
+
+  ::unlink(path.c_str());
+}
+
+}  // namespace trpc::capture::testing
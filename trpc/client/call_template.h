@@ -0,0 +1,48 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google::protobuf {
+class MethodDescriptor;
+}  // namespace google::protobuf
+
+namespace trpc {
+
+/// @brief The per-method invariants of an rpc call which are resolved once from the service proxy, so that repeated
+///        calls to the same method do not need to resolve them again for every request.
+/// @note It is immutable after being created by `ServiceProxy::PrepareCall`, and can be shared by multiple threads.
+struct CallTemplate {
+  /// The function name of the remote service, eg: /trpc.test.helloworld.Greeter/SayHello
+  std::string func_name;
+
+  /// The caller name, resolved from the option of service proxy
+  std::string caller_name;
+
+  /// The callee name, resolved from the option of service proxy
+  std::string callee_name;
+
+  /// The timeout (ms) of request, resolved from the option of service proxy
+  uint32_t timeout{UINT32_MAX};
+
+  /// Method descriptor used internally within protobuf, may be nullptr
+  const google::protobuf::MethodDescriptor* method_desc{nullptr};
+};
+
+using CallTemplatePtr = std::shared_ptr<const CallTemplate>;
+
+}  // namespace trpc
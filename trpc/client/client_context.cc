@@ -13,7 +13,10 @@
 
 #include "trpc/client/client_context.h"
 
+#include <new>
+
 #include "trpc/codec/trpc/trpc.pb.h"
+#include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
@@ -29,6 +32,26 @@ ClientContext::~ClientContext() {
   }
 }
 
+void* ClientContext::operator new(std::size_t size) {
+  // Subclasses (if any) have a different size and can not be placed in the slots of the pool.
+  if (TRPC_UNLIKELY(size != sizeof(ClientContext))) {
+    return ::operator new(size);
+  }
+  void* ptr = object_pool::detail::New<ClientContext>();
+  if (TRPC_UNLIKELY(ptr == nullptr)) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void ClientContext::operator delete(void* ptr, std::size_t size) {
+  if (TRPC_UNLIKELY(size != sizeof(ClientContext))) {
+    ::operator delete(ptr);
+    return;
+  }
+  object_pool::detail::Delete<ClientContext>(static_cast<ClientContext*>(ptr));
+}
+
 std::string ClientContext::GetTargetMetadata(const std::string& key) const {
   const auto& metadata = GetTargetMetadata();
   auto iter = metadata.find(key);
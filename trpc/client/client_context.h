@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/client/call_template.h"
 #include "trpc/client/service_proxy_option.h"
 #include "trpc/codec/client_codec.h"
 #include "trpc/codec/protocol.h"
@@ -33,6 +34,7 @@
 #include "trpc/naming/common/constants.h"
 #include "trpc/transport/client/retry_info_def.h"
 #include "trpc/transport/common/transport_message_common.h"
+#include "trpc/util/object_pool/object_pool.h"
 #include "trpc/util/object_pool/object_pool_ptr.h"
 #include "trpc/util/ref_ptr.h"
 
@@ -52,6 +54,11 @@ class ClientContext : public RefCounted<ClientContext> {
 
   ~ClientContext();
 
+  /// @brief The memory of client context is allocated from the object pool, so creating a context per call does not
+  ///        go through the system allocator.
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size);
+
   /// @brief Get the request protocol message object.
   /// @note It is only used internally by the framework or used by filter plugins.
   ProtocolPtr& GetRequest() { return req_msg_; }
@@ -164,19 +171,19 @@ class ClientContext : public RefCounted<ClientContext> {
   bool IsIgnoreProxyTimeout() const { return GetStateFlag(kIsIgnoreProxyTimeoutMask); }
 
   /// @brief Get the caller name, it may look like: trpc.${app}.${server}.${service}
-  std::string GetCallerName() const { return req_msg_->GetCallerName(); }
+  const std::string& GetCallerName() const { return req_msg_->GetCallerName(); }
 
   /// @brief Set the caller name, it may look like: trpc.${app}.${server}.${service}
   void SetCallerName(std::string value) { req_msg_->SetCallerName(std::move(value)); }
 
   /// @brief Get the callee name, it may look like: trpc.${app}.${server}.${service}
-  std::string GetCalleeName() const { return req_msg_->GetCalleeName(); }
+  const std::string& GetCalleeName() const { return req_msg_->GetCalleeName(); }
 
   /// @brief Get the callee name, it may look like: trpc.${app}.${server}.${service}
   void SetCalleeName(std::string value) { req_msg_->SetCalleeName(std::move(value)); }
 
   /// @brief Get the function name for requesting remote service.
-  std::string GetFuncName() const { return req_msg_->GetFuncName(); }
+  const std::string& GetFuncName() const { return req_msg_->GetFuncName(); }
 
   /// @brief Set the function name for requesting remote service.
   void SetFuncName(std::string value) { req_msg_->SetFuncName(std::move(value)); }
@@ -748,6 +755,14 @@ class ClientContext : public RefCounted<ClientContext> {
     invoke_info_.method_desc = method_desc;
   }
 
+  /// @brief Set the call template which the context is created from.
+  /// @note It is only used internally by the framework, use `MakeClientContext(proxy, call_template)` instead.
+  /// @private
+  void SetCallTemplate(CallTemplatePtr call_template) { extend_info_.call_template = std::move(call_template); }
+
+  /// @brief Get the call template which the context is created from, nullptr if the context is not created from it.
+  const CallTemplatePtr& GetCallTemplate() const { return extend_info_.call_template; }
+
   /// @brief Set the key of Dispatching request, which is used for
   /// which io thread (separate/merge mode) or which fiber scheduling group (fiber) to handling.
   void SetRequestDispatchKey(uint64_t key) { extend_info_.req_dispatch_key = key; }
@@ -904,6 +919,9 @@ class ClientContext : public RefCounted<ClientContext> {
 
     // Anything defined by user, it is associated with the current request.
     std::any user_data;
+
+    // The per-method invariants which the context is created from, it is nullptr by default.
+    CallTemplatePtr call_template{nullptr};
   };
 
   struct alignas(8) EndpointInfo {
@@ -953,4 +971,19 @@ using ClientContextPtr = RefPtr<ClientContext>;
 template <typename T>
 using is_client_context = std::is_same<T, ClientContext>;
 
+namespace object_pool {
+
+template <>
+struct ObjectPoolTraits<ClientContext> {
+#if defined(TRPC_DISABLED_OBJECTPOOL)
+  static constexpr auto kType = ObjectPoolType::kDisabled;
+#elif defined(TRPC_SHARED_NOTHING_OBJECTPOOL)
+  static constexpr auto kType = ObjectPoolType::kSharedNothing;
+#else
+  static constexpr auto kType = ObjectPoolType::kGlobal;
+#endif
+};
+
+}  // namespace object_pool
+
 }  // namespace trpc
@@ -76,6 +76,22 @@ ClientContextPtr MakeClientContext(const ServiceProxyPtr& proxy) {
   return MakeRefCounted<ClientContext>(proxy->GetClientCodec());
 }
 
+ClientContextPtr MakeClientContext(const ServiceProxyPtr& proxy, const CallTemplatePtr& call_template) {
+  TRPC_ASSERT(call_template && "call_template must be prepared before create a ClientContext obj");
+  ClientContextPtr ctx = MakeClientContext(proxy);
+
+  // The names are shared with the call template rather than copied for every call.
+  ctx->GetRequest()->SetSharedNames(call_template, call_template->caller_name, call_template->callee_name,
+                                    call_template->func_name);
+  ctx->SetTimeout(call_template->timeout);
+  if (call_template->method_desc != nullptr) {
+    ctx->SetProtobufMethodDescriptor(call_template->method_desc);
+  }
+  ctx->SetCallTemplate(call_template);
+
+  return ctx;
+}
+
 ClientContextPtr MakeClientContext(const ServiceProxyPtr& proxy, const ProtocolPtr& req, const ProtocolPtr& rsp) {
   auto ctx = MakeRefCounted<ClientContext>();
   ctx->SetRequest(req);
@@ -26,6 +26,14 @@ namespace trpc {
 /// @return client context
 ClientContextPtr MakeClientContext(const ServiceProxyPtr& proxy);
 
+/// @brief Create client context based on service proxy and the call template prepared by it(for rpc).
+/// @param proxy service proxy
+/// @param call_template which is created by `proxy->PrepareCall(func_name)` or the generated `PrepareXxx()`
+/// @return client context, whose function name, caller/callee name and timeout are set by the call template
+/// @note It is recommended for the methods which are called repeatedly, as the invariants of the call are resolved
+///       only once.
+ClientContextPtr MakeClientContext(const ServiceProxyPtr& proxy, const CallTemplatePtr& call_template);
+
 /// @brief Create client context based on service proxy(for non-rpc).
 /// @param proxy service proxy
 /// @param req/rsp which is created by `std::make_shared<XxxProtocol>()`
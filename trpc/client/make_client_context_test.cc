@@ -107,6 +107,38 @@ TEST_F(MakeClientContextTestFixture, Timeout) {
   ASSERT_TRUE(client_context->GetTimeout() == 0);
 }
 
+// call template case
+TEST_F(MakeClientContextTestFixture, MakeClientContextWithCallTemplate) {
+  TestServiceProxyPtr service_proxy = GetTestServiceProxy();
+  service_proxy->GetMutableServiceProxyOption()->caller_name = "test_caller";
+  service_proxy->GetMutableServiceProxyOption()->callee_name = "test_callee";
+  service_proxy->GetMutableServiceProxyOption()->timeout = 1000;
+
+  CallTemplatePtr call_template = service_proxy->PrepareCall("/trpc.test.helloworld.Greeter/SayHello");
+  ASSERT_TRUE(call_template != nullptr);
+  ASSERT_EQ(call_template->timeout, 1000);
+
+  for (int i = 0; i < 2; ++i) {
+    auto client_context = MakeClientContext(service_proxy, call_template);
+    ASSERT_TRUE(client_context != nullptr);
+    ASSERT_EQ(client_context->GetCallTemplate(), call_template);
+    ASSERT_EQ(client_context->GetFuncName(), "/trpc.test.helloworld.Greeter/SayHello");
+    ASSERT_EQ(client_context->GetCallerName(), "test_caller");
+    ASSERT_EQ(client_context->GetCalleeName(), "test_callee");
+    ASSERT_EQ(client_context->GetTimeout(), 1000);
+
+    client_context->SetTimeout(500);
+    service_proxy->FillClientContext(client_context);
+    ASSERT_EQ(client_context->GetTimeout(), 500);
+    ASSERT_EQ(client_context->GetCallerName(), "test_caller");
+  }
+
+  // The default timeout is used when it is not set in the option of service proxy.
+  service_proxy->GetMutableServiceProxyOption()->timeout = UINT32_MAX;
+  call_template = service_proxy->PrepareCall("/trpc.test.helloworld.Greeter/SayHello");
+  ASSERT_EQ(call_template->timeout, 5000);
+}
+
 // transparent case
 TEST_F(MakeClientContextTestFixture, MakeTransparentClientContext) {
   ServerContextPtr ctx = MakeRefCounted<ServerContext>();
@@ -199,6 +199,8 @@ class cmdgen {
 
   std::string echo(const std::string& message) { return BinaryCmdPacket(__func__, message); }
 
+  std::string hello(int protover) { return BinaryCmdPacket(__func__, std::to_string(protover)); }
+
   std::string ping() { return UnaryCmdPacket(__func__); }
 
   std::string ping(const std::string& message) { return BinaryCmdPacket(__func__, message); }
@@ -928,6 +930,20 @@ class cmdgen {
     return TernaryCmdPacket("CLIENT", "SETNAME", connection_name);
   }
 
+  // Turns on the tracking of the keys for client side caching, the invalidation messages are pushed to the same
+  // connection which requires RESP3(see hello). In broadcasting mode, the keys matching `prefixes` are tracked.
+  std::string client_tracking(bool bcast, const std::vector<std::string>& prefixes = {}) {
+    std::vector<std::string> args{"ON"};
+    if (bcast) {
+      args.emplace_back("BCAST");
+      for (const auto& prefix : prefixes) {
+        args.emplace_back("PREFIX");
+        args.emplace_back(prefix);
+      }
+    }
+    return TernaryCmdPacket("CLIENT", "TRACKING", args);
+  }
+
   std::string client_unblock(int client_id) { return TernaryCmdPacket("CLIENT", "UNBLOCK", std::to_string(client_id)); }
 
   std::string client_unblock(int client_id, const std::string& mode) {
@@ -83,6 +83,7 @@ TEST(CmdgenTest, connection) {
             trpc::redis::cmdgen{}.auth("user_name", "my_redis"));
   EXPECT_EQ("*2\r\n$4\r\nauth\r\n$8\r\nmy_redis\r\n", trpc::redis::cmdgen{}.auth("", "my_redis"));
   EXPECT_EQ("*2\r\n$4\r\necho\r\n$8\r\nmy_redis\r\n", trpc::redis::cmdgen{}.echo("my_redis"));
+  EXPECT_EQ("*2\r\n$5\r\nhello\r\n$1\r\n3\r\n", trpc::redis::cmdgen{}.hello(3));
   EXPECT_EQ("*1\r\n$4\r\nping\r\n", trpc::redis::cmdgen{}.ping());
   EXPECT_EQ("*2\r\n$4\r\nping\r\n$3\r\nabc\r\n", trpc::redis::cmdgen{}.ping("abc"));
   EXPECT_EQ("*1\r\n$4\r\nquit\r\n", trpc::redis::cmdgen{}.quit());
@@ -494,6 +495,10 @@ TEST(CmdgenTest, server) {
             trpc::redis::cmdgen{}.client_setname("myclient"));
   EXPECT_EQ("*3\r\n$6\r\nCLIENT\r\n$7\r\nUNBLOCK\r\n$1\r\n1\r\n",
             trpc::redis::cmdgen{}.client_unblock(1));
+  EXPECT_EQ("*3\r\n$6\r\nCLIENT\r\n$8\r\nTRACKING\r\n$2\r\nON\r\n", trpc::redis::cmdgen{}.client_tracking(false));
+  EXPECT_EQ(
+      "*6\r\n$6\r\nCLIENT\r\n$8\r\nTRACKING\r\n$2\r\nON\r\n$5\r\nBCAST\r\n$6\r\nPREFIX\r\n$5\r\nuser:\r\n",
+      trpc::redis::cmdgen{}.client_tracking(true, {"user:"}));
   EXPECT_EQ("*4\r\n$6\r\nCLIENT\r\n$7\r\nUNBLOCK\r\n$1\r\n1\r\n$5\r\nmykey\r\n",
             trpc::redis::cmdgen{}.client_unblock(1, "mykey"));
   EXPECT_EQ("*1\r\n$7\r\nCOMMAND\r\n", trpc::redis::cmdgen{}.command());
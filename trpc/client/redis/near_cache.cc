@@ -0,0 +1,385 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/redis/near_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <unordered_set>
+#include <utility>
+
+#include "trpc/util/string_helper.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+namespace redis {
+
+namespace {
+
+// Extra memory of an entry beyond its key and value(list node, index node, reply).
+constexpr uint64_t kEntryOverhead = 64;
+
+// Max number of writes waiting for invalidation per shard.
+constexpr std::size_t kMaxPendingWrites = 1024;
+
+// Splits the commands of the request into arguments, a request may carry several commands(pipeline).
+// The command which is not in RESP format is either RESP arrays of bulk strings(eg: generated by cmdgen) or inline
+// commands separated by spaces, one command per line. An empty result means the request can not be parsed.
+std::vector<std::vector<std::string_view>> SplitCommands(const Request& req) {
+  std::vector<std::vector<std::string_view>> commands;
+  if (req.do_RESP_) {
+    auto& argv = commands.emplace_back();
+    argv.reserve(req.params_.size());
+    for (const auto& param : req.params_) {
+      argv.emplace_back(param);
+    }
+    return commands;
+  }
+
+  if (req.params_.empty()) {
+    return commands;
+  }
+
+  std::string_view cmd = req.params_[0];
+  std::size_t pos = 0;
+  if (!cmd.empty() && cmd[0] == '*') {
+    while (pos < cmd.size()) {
+      if (cmd[pos] != '*') {
+        return {};
+      }
+      std::size_t end = cmd.find("\r\n", pos);
+      if (end == std::string_view::npos) {
+        return {};
+      }
+      int64_t count = std::strtoll(cmd.data() + pos + 1, nullptr, 10);
+      pos = end + 2;
+      auto& argv = commands.emplace_back();
+      for (int64_t i = 0; i < count; ++i) {
+        if (pos >= cmd.size() || cmd[pos] != '$') {
+          return {};
+        }
+        end = cmd.find("\r\n", pos);
+        if (end == std::string_view::npos) {
+          return {};
+        }
+        std::size_t len = std::strtoull(cmd.data() + pos + 1, nullptr, 10);
+        if (end + 2 + len > cmd.size()) {
+          return {};
+        }
+        argv.emplace_back(cmd.substr(end + 2, len));
+        pos = end + 2 + len + 2;
+      }
+    }
+    return commands;
+  }
+
+  while (pos < cmd.size()) {
+    std::size_t line_end = std::min(cmd.find('\n', pos), cmd.size());
+    std::vector<std::string_view> argv;
+    while (pos < line_end) {
+      while (pos < line_end && std::isspace(static_cast<unsigned char>(cmd[pos]))) {
+        ++pos;
+      }
+      std::size_t end = pos;
+      while (end < line_end && !std::isspace(static_cast<unsigned char>(cmd[end]))) {
+        ++end;
+      }
+      if (end > pos) {
+        argv.emplace_back(cmd.substr(pos, end - pos));
+      }
+      pos = end;
+    }
+    if (!argv.empty()) {
+      commands.push_back(std::move(argv));
+    }
+    pos = line_end + 1;
+  }
+  return commands;
+}
+
+std::string ToUpper(std::string_view s) {
+  std::string upper(s);
+  std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
+  return upper;
+}
+
+// Commands modifying the key of the first argument
+const std::unordered_set<std::string>& SingleKeyWriteCommands() {
+  static const std::unordered_set<std::string> kCommands = {
+      "SET",    "SETEX",     "PSETEX", "SETNX",    "GETSET",      "GETDEL", "GETEX",    "EXPIRE",
+      "PEXPIRE", "EXPIREAT", "PEXPIREAT", "PERSIST", "INCR",      "INCRBY", "INCRBYFLOAT", "DECR",
+      "DECRBY", "APPEND",    "SETRANGE"};
+  return kCommands;
+}
+
+}  // namespace
+
+NearCache::NearCache(const Options& options) : options_(options) {
+  options_.shards = std::max<uint32_t>(options_.shards, 1);
+  shard_max_bytes_ = std::max<uint64_t>(options_.max_bytes / options_.shards, 1);
+  shards_ = std::make_unique<Shard[]>(options_.shards);
+}
+
+NearCache::Shard& NearCache::GetShard(std::string_view key) {
+  return shards_[std::hash<std::string_view>{}(key) % options_.shards];
+}
+
+bool NearCache::IsTracked(std::string_view key) const {
+  if (options_.mode != Mode::kBroadcast || options_.prefixes.empty()) {
+    return true;
+  }
+  return std::any_of(options_.prefixes.begin(), options_.prefixes.end(),
+                     [key](const std::string& prefix) { return StartsWith(key, prefix); });
+}
+
+bool NearCache::OnRequest(const Request& req, Reply* reply, Ticket* ticket) {
+  ticket->cacheable = false;
+
+  std::vector<std::vector<std::string_view>> commands = SplitCommands(req);
+  // Only a request of a single `GET key` is served from or stored into the cache, the replies of a pipeline are read
+  // as a whole. The writes of all the commands evict their keys anyway.
+  if (commands.size() == 1) {
+    const auto& argv = commands[0];
+    if (argv.size() == 2 && ToUpper(argv[0]) == "GET" && IsTracked(argv[1])) {
+      Shard& shard = GetShard(argv[1]);
+      {
+        std::scoped_lock lock(shard.mutex);
+        auto it = shard.index.find(argv[1]);
+        if (it != shard.index.end()) {
+          shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+          *reply = it->second->value;
+          hits_.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        ticket->epoch = shard.epoch;
+      }
+      ticket->key = std::string(argv[1]);
+      ticket->cacheable = true;
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  }
+
+  for (const auto& argv : commands) {
+    OnCommandWrite(argv);
+  }
+  return false;
+}
+
+void NearCache::OnCommandWrite(const std::vector<std::string_view>& argv) {
+  if (argv.empty()) {
+    return;
+  }
+
+  std::string name = ToUpper(argv[0]);
+  if (name == "FLUSHDB" || name == "FLUSHALL") {
+    Clear();
+  } else if (argv.size() < 2) {
+    return;
+  } else if (SingleKeyWriteCommands().count(name)) {
+    OnWrite(argv[1]);
+  } else if (name == "DEL" || name == "UNLINK") {
+    for (std::size_t i = 1; i < argv.size(); ++i) {
+      OnWrite(argv[i]);
+    }
+  } else if (name == "MSET" || name == "MSETNX") {
+    for (std::size_t i = 1; i < argv.size(); i += 2) {
+      OnWrite(argv[i]);
+    }
+  } else if (name == "RENAME" || name == "RENAMENX") {
+    for (std::size_t i = 1; i < argv.size() && i < 3; ++i) {
+      OnWrite(argv[i]);
+    }
+  }
+}
+
+void NearCache::OnReply(const Ticket& ticket, const Reply& reply) {
+  if (!ticket.cacheable || !(reply.IsString() || reply.IsNil())) {
+    return;
+  }
+
+  uint64_t bytes = ticket.key.size() + kEntryOverhead;
+  if (reply.IsString()) {
+    bytes += reply.GetString().size();
+  }
+  if (bytes > shard_max_bytes_) {
+    return;
+  }
+
+  Shard& shard = GetShard(ticket.key);
+  std::scoped_lock lock(shard.mutex);
+  // Invalidated while the request is in flight, the reply may be stale.
+  if (shard.epoch != ticket.epoch) {
+    return;
+  }
+
+  EraseLocked(shard, ticket.key);
+  shard.lru.push_front(Entry{ticket.key, reply, bytes});
+  shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+  shard.bytes += bytes;
+
+  while (shard.bytes > shard_max_bytes_) {
+    Entry& victim = shard.lru.back();
+    shard.bytes -= victim.bytes;
+    shard.index.erase(victim.key);
+    shard.lru.pop_back();
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void NearCache::OnPush(const Reply& push) {
+  if (!push.IsPush()) {
+    return;
+  }
+
+  const auto& elements = push.GetArray();
+  if (elements.size() < 2 || !(elements[0].IsString() || elements[0].IsStatus()) ||
+      ToUpper(elements[0].GetString()) != "INVALIDATE") {
+    return;
+  }
+
+  // A null key list means all keys are invalidated(eg: FLUSHALL).
+  if (elements[1].IsNil()) {
+    Clear();
+    return;
+  }
+
+  if (elements[1].IsArray() || elements[1].IsSet()) {
+    for (const auto& key : elements[1].GetArray()) {
+      if (key.IsString()) {
+        OnInvalidate(key.GetString());
+      }
+    }
+  }
+}
+
+void NearCache::Invalidate(std::string_view key) {
+  Shard& shard = GetShard(key);
+  std::scoped_lock lock(shard.mutex);
+  ++shard.epoch;
+  EraseLocked(shard, key);
+}
+
+void NearCache::Clear() {
+  for (uint32_t i = 0; i < options_.shards; ++i) {
+    Shard& shard = shards_[i];
+    std::scoped_lock lock(shard.mutex);
+    ++shard.epoch;
+    invalidations_.fetch_add(shard.index.size(), std::memory_order_relaxed);
+    shard.index.clear();
+    shard.lru.clear();
+    shard.bytes = 0;
+    shard.pending_writes.clear();
+  }
+}
+
+NearCache::Stats NearCache::GetStats() const {
+  Stats stats;
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+  stats.evictions = evictions_.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < options_.shards; ++i) {
+    std::scoped_lock lock(shards_[i].mutex);
+    stats.bytes += shards_[i].bytes;
+  }
+  stats.invalidation_lag_count = lag_count_.load(std::memory_order_relaxed);
+  stats.invalidation_lag_sum_us = lag_sum_us_.load(std::memory_order_relaxed);
+  stats.invalidation_lag_max_us = lag_max_us_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+int NearCache::CheckResponse(const ProtocolCheckerFunction& checker, const ConnectionPtr& conn,
+                             NoncontiguousBuffer& in, std::deque<std::any>& out) {
+  const std::size_t begin = out.size();
+  while (true) {
+    int ret = checker(conn, in, out);
+    if (ret == PacketChecker::PACKET_ERR) {
+      return ret;
+    }
+
+    for (auto it = out.begin() + begin; it != out.end();) {
+      auto* reply = std::any_cast<Reply>(&*it);
+      if (reply != nullptr && reply->IsPush()) {
+        OnPush(*reply);
+        it = out.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    // Only push messages are parsed, the reply may follow them.
+    if (out.size() > begin || ret != PacketChecker::PACKET_FULL || in.ByteSize() == 0) {
+      break;
+    }
+  }
+  return out.empty() ? PacketChecker::PACKET_LESS : PacketChecker::PACKET_FULL;
+}
+
+void NearCache::EraseLocked(Shard& shard, std::string_view key) {
+  auto it = shard.index.find(key);
+  if (it == shard.index.end()) {
+    return;
+  }
+  auto entry = it->second;
+  shard.bytes -= entry->bytes;
+  shard.index.erase(it);
+  shard.lru.erase(entry);
+  invalidations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void NearCache::OnWrite(std::string_view key) {
+  Shard& shard = GetShard(key);
+  std::scoped_lock lock(shard.mutex);
+  ++shard.epoch;
+  EraseLocked(shard, key);
+  // The keys never read by this client are not tracked by the server, their writes wait forever, so drop them.
+  if (shard.pending_writes.size() >= kMaxPendingWrites) {
+    shard.pending_writes.clear();
+  }
+  shard.pending_writes.try_emplace(std::string(key), GetSteadyMicroSeconds());
+}
+
+void NearCache::OnInvalidate(std::string_view key) {
+  uint64_t write_us = 0;
+  {
+    Shard& shard = GetShard(key);
+    std::scoped_lock lock(shard.mutex);
+    ++shard.epoch;
+    EraseLocked(shard, key);
+    auto it = shard.pending_writes.find(std::string(key));
+    if (it != shard.pending_writes.end()) {
+      write_us = it->second;
+      shard.pending_writes.erase(it);
+    }
+  }
+  if (write_us != 0) {
+    uint64_t now_us = GetSteadyMicroSeconds();
+    RecordLag(now_us > write_us ? now_us - write_us : 0);
+  }
+}
+
+void NearCache::RecordLag(uint64_t lag_us) {
+  lag_count_.fetch_add(1, std::memory_order_relaxed);
+  lag_sum_us_.fetch_add(lag_us, std::memory_order_relaxed);
+  uint64_t max_us = lag_max_us_.load(std::memory_order_relaxed);
+  while (lag_us > max_us && !lag_max_us_.compare_exchange_weak(max_us, lag_us, std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace redis
+
+}  // namespace trpc
@@ -0,0 +1,163 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <any>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/client/redis/reply.h"
+#include "trpc/client/redis/request.h"
+#include "trpc/runtime/iomodel/reactor/common/connection_handler.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+namespace redis {
+
+/// @brief Client side cache of redis GET replies, kept coherent by the server-assisted client side caching of redis
+///        (RESP3 `CLIENT TRACKING`). The server sends an `invalidate` push message when a tracked key is modified,
+///        the push messages are picked out of the response stream by `CheckResponse` and evict the keys.
+/// @note  Thread-safe. Only the replies of `GET key` are cached, and a reply is only stored if no invalidation hits
+///        its shard while the request is in flight, so a stale value can never be cached.
+class NearCache {
+ public:
+  /// @brief Tracking mode of the connections, see `RedisNearCacheConf::mode`
+  enum class Mode {
+    kDefault,
+    kBroadcast,
+  };
+
+  struct Options {
+    Mode mode = Mode::kDefault;
+
+    /// Key prefixes tracked in broadcast mode, empty means all the keys. The server sends no invalidation of the keys
+    /// out of them, so they are never cached.
+    std::vector<std::string> prefixes;
+
+    /// Memory budget of the cached keys and values, split evenly among the shards
+    uint64_t max_bytes = 64 * 1024 * 1024;
+
+    /// Number of shards, each shard has its own lock and lru list
+    uint32_t shards = 16;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    /// Keys evicted by invalidation(push message, local write or flush)
+    uint64_t invalidations = 0;
+
+    /// Keys evicted by the memory budget
+    uint64_t evictions = 0;
+
+    /// Memory used by the cached keys and values
+    uint64_t bytes = 0;
+
+    /// Lag between a write of this client and the invalidation push message of the key sent by the server
+    uint64_t invalidation_lag_count = 0;
+    uint64_t invalidation_lag_sum_us = 0;
+    uint64_t invalidation_lag_max_us = 0;
+  };
+
+  /// @brief Context of an in-flight request, passed from `OnRequest` to `OnReply`
+  struct Ticket {
+    std::string key;
+    uint64_t epoch = 0;
+    bool cacheable = false;
+  };
+
+  explicit NearCache(const Options& options);
+
+  /// @brief Called before the request is sent.
+  /// @param req the request
+  /// @param[out] reply the cached reply when hit
+  /// @param[out] ticket set when the reply of request can be cached
+  /// @return true: hit, the request need not be sent; false: miss.
+  bool OnRequest(const Request& req, Reply* reply, Ticket* ticket);
+
+  /// @brief Called when the reply of request arrives, stores it if it is still fresh.
+  void OnReply(const Ticket& ticket, const Reply& reply);
+
+  /// @brief Handles a push message of the server, only `invalidate` message is processed.
+  void OnPush(const Reply& push);
+
+  /// @brief Evicts the key.
+  void Invalidate(std::string_view key);
+
+  /// @brief Evicts all keys, called when the tracking state is lost(eg: connection closed).
+  void Clear();
+
+  Stats GetStats() const;
+
+  /// @brief Wraps the response checker, the push messages are consumed by `OnPush` and removed from `out`.
+  int CheckResponse(const ProtocolCheckerFunction& checker, const ConnectionPtr& conn, NoncontiguousBuffer& in,
+                    std::deque<std::any>& out);
+
+ private:
+  struct Entry {
+    std::string key;
+    Reply value;
+    uint64_t bytes = 0;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::list<Entry> lru;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    uint64_t bytes = 0;
+    // Bumped on every invalidation of the shard, the replies requested before are not stored.
+    uint64_t epoch = 0;
+    // Steady time(us) of the writes waiting for the invalidation push message, for lag statistics.
+    std::unordered_map<std::string, uint64_t> pending_writes;
+  };
+
+  Shard& GetShard(std::string_view key);
+  // Whether the invalidation of the key is sent by the server.
+  bool IsTracked(std::string_view key) const;
+  void EraseLocked(Shard& shard, std::string_view key);
+  void OnWrite(std::string_view key);
+  // Evicts the keys written by the command.
+  void OnCommandWrite(const std::vector<std::string_view>& argv);
+  void OnInvalidate(std::string_view key);
+  void RecordLag(uint64_t lag_us);
+
+ private:
+  Options options_;
+  uint64_t shard_max_bytes_;
+  std::unique_ptr<Shard[]> shards_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> invalidations_{0};
+  std::atomic<uint64_t> evictions_{0};
+  std::atomic<uint64_t> lag_count_{0};
+  std::atomic<uint64_t> lag_sum_us_{0};
+  std::atomic<uint64_t> lag_max_us_{0};
+};
+
+using NearCachePtr = std::shared_ptr<NearCache>;
+
+}  // namespace redis
+
+}  // namespace trpc
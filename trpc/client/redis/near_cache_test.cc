@@ -0,0 +1,312 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/redis/near_cache.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/redis/cmdgen.h"
+#include "trpc/client/redis/reader.h"
+#include "trpc/runtime/iomodel/reactor/common/connection.h"
+
+namespace trpc::testing {
+
+using redis::NearCache;
+using redis::Reply;
+using redis::Request;
+
+// A stand-in of redis server with client tracking(default mode) enabled, it speaks RESP3 for one connection.
+class FakeTrackingServer {
+ public:
+  // Handles the command of the connection, returns the bytes of response(including the pending push messages).
+  std::string Handle(const std::string& cmd, const std::string& key, const std::string& value = "") {
+    std::string rsp = std::move(pending_push_);
+    pending_push_.clear();
+    if (cmd == "GET") {
+      tracked_.insert(key);
+      auto it = data_.find(key);
+      rsp += it == data_.end() ? "_\r\n" : Bulk(it->second);
+    } else if (cmd == "SET") {
+      Write(key, value);
+      rsp = std::move(pending_push_) + "+OK\r\n";
+      pending_push_.clear();
+    }
+    return rsp;
+  }
+
+  // Write by another client, the invalidation is sent ahead of the next response of the connection.
+  void Write(const std::string& key, const std::string& value) {
+    data_[key] = value;
+    if (tracked_.erase(key)) {
+      pending_push_ += ">2\r\n" + Bulk("invalidate") + "*1\r\n" + Bulk(key);
+    }
+  }
+
+  void FlushAll() {
+    data_.clear();
+    tracked_.clear();
+    pending_push_ += ">2\r\n" + Bulk("invalidate") + "_\r\n";
+  }
+
+  std::string TakePush() { return std::move(pending_push_); }
+
+ private:
+  static std::string Bulk(const std::string& s) { return "$" + std::to_string(s.size()) + "\r\n" + s + "\r\n"; }
+
+ private:
+  std::map<std::string, std::string> data_;
+  std::set<std::string> tracked_;
+  std::string pending_push_;
+};
+
+class NearCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    checker_ = [](const ConnectionPtr&, NoncontiguousBuffer& in, std::deque<std::any>& out) {
+      redis::Reader reader;
+      reader.GetReply(in, out);
+      if (reader.IsProtocolError()) {
+        return static_cast<int>(PacketChecker::PACKET_ERR);
+      }
+      return out.empty() ? static_cast<int>(PacketChecker::PACKET_LESS) : static_cast<int>(PacketChecker::PACKET_FULL);
+    };
+  }
+
+  // Feeds the bytes to the checker wrapped by near-cache, returns the reply if any.
+  int Receive(NearCache& cache, const std::string& bytes, Reply* reply) {
+    NoncontiguousBufferBuilder builder;
+    builder.Append(bytes.data(), bytes.size());
+    in_.Append(builder.DestructiveGet());
+
+    std::deque<std::any> out;
+    int ret = cache.CheckResponse(checker_, nullptr, in_, out);
+    if (!out.empty()) {
+      *reply = std::any_cast<Reply>(out.front());
+    }
+    return ret;
+  }
+
+  // Sends `GET key` through the near-cache, returns the value.
+  Reply Get(NearCache& cache, const std::string& key) {
+    Request req;
+    req.params_ = {"GET", key};
+
+    Reply reply;
+    NearCache::Ticket ticket;
+    if (cache.OnRequest(req, &reply, &ticket)) {
+      return reply;
+    }
+    EXPECT_EQ(PacketChecker::PACKET_FULL, Receive(cache, server_.Handle("GET", key), &reply));
+    cache.OnReply(ticket, reply);
+    return reply;
+  }
+
+  ProtocolCheckerFunction checker_;
+  NoncontiguousBuffer in_;
+  FakeTrackingServer server_;
+};
+
+TEST_F(NearCacheTest, HitAndInvalidate) {
+  NearCache cache(NearCache::Options{});
+  server_.Write("foo", "bar");
+
+  ASSERT_EQ("bar", Get(cache, "foo").GetString());
+  ASSERT_EQ("bar", Get(cache, "foo").GetString());
+  ASSERT_TRUE(Get(cache, "none").IsNil());
+  ASSERT_TRUE(Get(cache, "none").IsNil());
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(2, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_GT(stats.bytes, 0);
+
+  // The invalidation arrives ahead of the reply of another key.
+  server_.Write("foo", "baz");
+  ASSERT_TRUE(Get(cache, "other").IsNil());
+  ASSERT_EQ(1, cache.GetStats().invalidations);
+  ASSERT_EQ("baz", Get(cache, "foo").GetString());
+  ASSERT_EQ("baz", Get(cache, "foo").GetString());
+}
+
+TEST_F(NearCacheTest, PushOnly) {
+  NearCache cache(NearCache::Options{});
+  server_.Write("foo", "bar");
+  ASSERT_EQ("bar", Get(cache, "foo").GetString());
+
+  // Push message on an idle connection, nothing is delivered.
+  server_.Write("foo", "baz");
+  Reply reply;
+  ASSERT_EQ(PacketChecker::PACKET_LESS, Receive(cache, server_.TakePush(), &reply));
+  ASSERT_TRUE(reply.IsNone());
+  ASSERT_EQ("baz", Get(cache, "foo").GetString());
+
+  // Partial push message is kept in buffer.
+  server_.Write("foo", "qux");
+  std::string push = server_.TakePush();
+  ASSERT_EQ(PacketChecker::PACKET_LESS, Receive(cache, push.substr(0, 10), &reply));
+  ASSERT_EQ(PacketChecker::PACKET_LESS, Receive(cache, push.substr(10), &reply));
+  ASSERT_EQ("qux", Get(cache, "foo").GetString());
+}
+
+TEST_F(NearCacheTest, FlushAll) {
+  NearCache cache(NearCache::Options{});
+  server_.Write("a", "1");
+  server_.Write("b", "2");
+  Get(cache, "a");
+  Get(cache, "b");
+
+  server_.FlushAll();
+  Reply reply;
+  ASSERT_EQ(PacketChecker::PACKET_LESS, Receive(cache, server_.TakePush(), &reply));
+  ASSERT_EQ(0, cache.GetStats().bytes);
+  ASSERT_TRUE(Get(cache, "a").IsNil());
+}
+
+TEST_F(NearCacheTest, InvalidatedInFlight) {
+  NearCache cache(NearCache::Options{});
+  server_.Write("foo", "bar");
+
+  Request req;
+  req.params_ = {"GET", "foo"};
+  Reply reply;
+  NearCache::Ticket ticket;
+  ASSERT_FALSE(cache.OnRequest(req, &reply, &ticket));
+  ASSERT_TRUE(ticket.cacheable);
+  std::string rsp = server_.Handle("GET", "foo");
+
+  // Invalidated before the reply arrives, the reply must not be stored.
+  cache.Invalidate("foo");
+  ASSERT_EQ(PacketChecker::PACKET_FULL, Receive(cache, rsp, &reply));
+  cache.OnReply(ticket, reply);
+  ASSERT_EQ(0, cache.GetStats().bytes);
+}
+
+TEST_F(NearCacheTest, LocalWrite) {
+  NearCache cache(NearCache::Options{});
+  server_.Write("foo", "bar");
+  Get(cache, "foo");
+
+  // Write through the same connection, inline and RESP formats of command.
+  Request req;
+  req.do_RESP_ = false;
+  req.params_ = {"set foo baz"};
+  Reply reply;
+  NearCache::Ticket ticket;
+  ASSERT_FALSE(cache.OnRequest(req, &reply, &ticket));
+  ASSERT_FALSE(ticket.cacheable);
+  ASSERT_EQ(PacketChecker::PACKET_FULL, Receive(cache, server_.Handle("SET", "foo", "baz"), &reply));
+  ASSERT_TRUE(reply.IsStatus());
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(1, stats.invalidations);
+  ASSERT_EQ(1, stats.invalidation_lag_count);
+  ASSERT_GE(stats.invalidation_lag_max_us, 0);
+
+  ASSERT_EQ("baz", Get(cache, "foo").GetString());
+  req.params_ = {redis::cmdgen{}.del(std::vector<std::string>{"foo"})};
+  ASSERT_FALSE(cache.OnRequest(req, &reply, &ticket));
+  ASSERT_EQ(2, cache.GetStats().invalidations);
+
+  req.params_ = {redis::cmdgen{}.get("foo")};
+  ASSERT_FALSE(cache.OnRequest(req, &reply, &ticket));
+  ASSERT_TRUE(ticket.cacheable);
+  ASSERT_EQ("foo", ticket.key);
+}
+
+TEST_F(NearCacheTest, Pipeline) {
+  NearCache cache(NearCache::Options{});
+  server_.Write("foo", "bar");
+  server_.Write("other", "1");
+  Get(cache, "foo");
+  Get(cache, "other");
+  uint64_t hits = cache.GetStats().hits;
+
+  // Several commands in one request are never served from the cache, even if the first one is a cached `GET`.
+  Request req;
+  req.do_RESP_ = false;
+  req.params_ = {redis::cmdgen{}.get("foo") + redis::cmdgen{}.set("other", "2")};
+  Reply reply;
+  NearCache::Ticket ticket;
+  ASSERT_FALSE(cache.OnRequest(req, &reply, &ticket));
+  ASSERT_FALSE(ticket.cacheable);
+  ASSERT_EQ(hits, cache.GetStats().hits);
+  // The keys written by the later commands are evicted.
+  ASSERT_EQ(1, cache.GetStats().invalidations);
+
+  // Inline commands, one per line.
+  req.params_ = {"get foo\r\ndel foo\r\n"};
+  ASSERT_FALSE(cache.OnRequest(req, &reply, &ticket));
+  ASSERT_FALSE(ticket.cacheable);
+  ASSERT_EQ(hits, cache.GetStats().hits);
+  ASSERT_EQ(2, cache.GetStats().invalidations);
+  ASSERT_EQ(0, cache.GetStats().bytes);
+
+  // A single command without key.
+  Get(cache, "foo");
+  req.params_ = {"FLUSHALL"};
+  ASSERT_FALSE(cache.OnRequest(req, &reply, &ticket));
+  ASSERT_EQ(0, cache.GetStats().bytes);
+}
+
+TEST_F(NearCacheTest, BroadcastPrefixes) {
+  NearCache::Options options;
+  options.mode = NearCache::Mode::kBroadcast;
+  options.prefixes = {"user:"};
+  NearCache cache(options);
+  server_.Write("user:1", "a");
+  server_.Write("item:1", "b");
+
+  Get(cache, "user:1");
+  Get(cache, "item:1");
+  // The server sends no invalidation of the keys out of the prefixes, so they are never cached.
+  ASSERT_EQ("a", Get(cache, "user:1").GetString());
+  ASSERT_EQ("b", Get(cache, "item:1").GetString());
+  auto stats = cache.GetStats();
+  ASSERT_EQ(1, stats.hits);
+  // The reads of the untracked keys bypass the cache, they are not counted as misses.
+  ASSERT_EQ(1, stats.misses);
+  ASSERT_EQ(1 * (64 + 6 + 1), stats.bytes);
+}
+
+TEST_F(NearCacheTest, Eviction) {
+  NearCache::Options options;
+  options.shards = 1;
+  options.max_bytes = 3 * (64 + 2 + 8);
+  NearCache cache(options);
+  for (int i = 0; i < 4; ++i) {
+    server_.Write("k" + std::to_string(i), std::string(8, 'a' + i));
+  }
+
+  Get(cache, "k0");
+  Get(cache, "k1");
+  Get(cache, "k2");
+  // k0 becomes the most recently used one, so k1 is evicted.
+  Get(cache, "k0");
+  Get(cache, "k3");
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(1, stats.evictions);
+  ASSERT_EQ(3 * (64 + 2 + 8), stats.bytes);
+
+  Get(cache, "k0");
+  ASSERT_EQ(stats.hits + 1, cache.GetStats().hits);
+  Get(cache, "k1");
+  ASSERT_EQ(stats.misses + 1, cache.GetStats().misses);
+}
+
+}  // namespace trpc::testing
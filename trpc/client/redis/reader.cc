@@ -31,6 +31,7 @@ void Reader::Init() {
     rstack_[i].idx_ = -1;
     rstack_[i].obj_ = nullptr;
     rstack_[i].parent_ = nullptr;
+    rstack_[i].bulk_ = false;
   }
 }
 
@@ -244,6 +245,7 @@ void Reader::MoveToNextTask() {
       cur->obj_ = &(array.back());
       cur->elements_ = -1;
       cur->idx_++;
+      cur->bulk_ = false;
       return;
     }
   }
@@ -268,6 +270,43 @@ int Reader::ProcessInteger(NoncontiguousBuffer& in, NoncontiguousBuffer::const_i
   return Ret::C_ERR;
 }
 
+int Reader::ProcessNullItem(NoncontiguousBuffer& in, NoncontiguousBuffer::const_iterator& cur_itr, size_t& consume_len,
+                            size_t& pos) {
+  NoncontiguousBuffer::const_iterator tmp_itr = cur_itr;
+  size_t tmp_pos = pos;
+  size_t len = 0;
+  if (!TryReadVariableLengthString(in, tmp_itr, tmp_pos, len)) {
+    return Ret::C_ERR;
+  }
+  consume_len += len + 2;
+  rstack_[ridx_].obj_->Set(NilReplyMarker{});
+  pos = tmp_pos;
+  cur_itr = tmp_itr;
+  MoveToNextTask();
+  return Ret::C_OK;
+}
+
+int Reader::ProcessBooleanItem(NoncontiguousBuffer& in, NoncontiguousBuffer::const_iterator& cur_itr,
+                               size_t& consume_len, size_t& pos) {
+  NoncontiguousBuffer::const_iterator tmp_itr = cur_itr;
+  size_t tmp_pos = pos;
+  size_t len = 0;
+  const char* p = ReadInteger(in, tmp_itr, tmp_pos, len);
+  if (p == nullptr) {
+    return Ret::C_ERR;
+  }
+  if (len != 1 || (p[0] != 't' && p[0] != 'f')) {
+    protocol_err_ = true;
+    return Ret::C_ERR;
+  }
+  consume_len += len + 2;
+  rstack_[ridx_].obj_->Set(IntegerReplyMarker{}, p[0] == 't' ? 1 : 0);
+  pos = tmp_pos;
+  cur_itr = tmp_itr;
+  MoveToNextTask();
+  return Ret::C_OK;
+}
+
 int Reader::ProcessLineItem(NoncontiguousBuffer& in, NoncontiguousBuffer::const_iterator& cur_itr, size_t& consume_len,
                             size_t& pos, ReadTask* cur_task) {
   NoncontiguousBuffer::const_iterator tmp_itr = cur_itr;
@@ -335,6 +374,10 @@ int Reader::ProcessMultiBulkItem(NoncontiguousBuffer& in, NoncontiguousBuffer::c
   if (p != nullptr) {
     consume_len += line_len + 2;
     elements = static_cast<int>(ConvertToInteger(p, line_len));
+    // Map of RESP3 contains key and value for each element
+    if (cur->obj_->type_ == Reply::Type::MAP && elements > 0) {
+      elements *= 2;
+    }
     if (elements == -1) {
       cur->obj_->Set(NilReplyMarker{});
       MoveToNextTask();
@@ -350,6 +393,7 @@ int Reader::ProcessMultiBulkItem(NoncontiguousBuffer& in, NoncontiguousBuffer::c
         rstack_[ridx_].elements_ = -1;
         rstack_[ridx_].idx_ = 0;
         rstack_[ridx_].parent_ = cur;
+        rstack_[ridx_].bulk_ = false;
       } else {
         MoveToNextTask();
       }
@@ -373,18 +417,36 @@ int Reader::ProcessItem(NoncontiguousBuffer& in, NoncontiguousBuffer::const_iter
 
   switch (cur_task->obj_->type_) {
     case Reply::Type::ERROR:
+      if (cur_task->bulk_) {
+        ret = ProcessBulkItem(in, tmp_itr, consume_len, tmp_pos);
+      } else {
+        ret = ProcessLineItem(in, tmp_itr, consume_len, tmp_pos, cur_task);
+      }
+      break;
     case Reply::Type::STATUS:
+    case Reply::Type::DOUBLE:
+    case Reply::Type::BIGNUM:
       ret = ProcessLineItem(in, tmp_itr, consume_len, tmp_pos, cur_task);
       break;
     case Reply::Type::INTEGER:
       ret = ProcessInteger(in, tmp_itr, consume_len, tmp_pos, cur_task);
       break;
     case Reply::Type::STRING:
+    case Reply::Type::VERB:
       ret = ProcessBulkItem(in, tmp_itr, consume_len, tmp_pos);
       break;
     case Reply::Type::ARRAY:
+    case Reply::Type::PUSH:
+    case Reply::Type::MAP:
+    case Reply::Type::SET:
       ret = ProcessMultiBulkItem(in, tmp_itr, consume_len, tmp_pos);
       break;
+    case Reply::Type::NIL:
+      ret = ProcessNullItem(in, tmp_itr, consume_len, tmp_pos);
+      break;
+    case Reply::Type::BOOL:
+      ret = ProcessBooleanItem(in, tmp_itr, consume_len, tmp_pos);
+      break;
     case Reply::Type::INVALID:
       protocol_err_ = true;
       ret = Ret::C_ERR;
@@ -445,6 +507,7 @@ bool Reader::GetReply(NoncontiguousBuffer& in, std::deque<std::any>& out, const
     rstack_[0].idx_ = -1;
     rstack_[0].obj_ = &reply_;
     rstack_[0].parent_ = nullptr;
+    rstack_[0].bulk_ = false;
     has_parse_seqno_ = false;
     ridx_ = 0;
     if (pipeline_count > 1) {
@@ -459,6 +522,7 @@ bool Reader::GetReply(NoncontiguousBuffer& in, std::deque<std::any>& out, const
       rstack_[ridx_].elements_ = -1;
       rstack_[ridx_].idx_ = 0;
       rstack_[ridx_].parent_ = cur;
+      rstack_[ridx_].bulk_ = false;
     }
   }
 
@@ -544,6 +608,34 @@ bool Reader::ProcessReplyType(NoncontiguousBuffer& in, NoncontiguousBuffer::cons
     case '*':
       cur_task->obj_->type_ = Reply::Type::ARRAY;
       break;
+    case '>':
+      cur_task->obj_->type_ = Reply::Type::PUSH;
+      break;
+    case '%':
+      cur_task->obj_->type_ = Reply::Type::MAP;
+      break;
+    case '~':
+      cur_task->obj_->type_ = Reply::Type::SET;
+      break;
+    case '_':
+      cur_task->obj_->type_ = Reply::Type::NIL;
+      break;
+    case '#':
+      cur_task->obj_->type_ = Reply::Type::BOOL;
+      break;
+    case ',':
+      cur_task->obj_->type_ = Reply::Type::DOUBLE;
+      break;
+    case '(':
+      cur_task->obj_->type_ = Reply::Type::BIGNUM;
+      break;
+    case '=':
+      cur_task->obj_->type_ = Reply::Type::VERB;
+      break;
+    case '!':
+      cur_task->obj_->type_ = Reply::Type::ERROR;
+      cur_task->bulk_ = true;
+      break;
     default:
       protocol_err_ = true;
       return false;
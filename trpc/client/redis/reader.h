@@ -27,7 +27,7 @@ namespace trpc {
 
 namespace redis {
 
-/// @brief redis reader for parsing and reading redis reply
+/// @brief redis reader for parsing and reading redis reply, both RESP2 and RESP3 are supported
 /// @private For internal use purpose only.
 class Reader {
  protected:
@@ -50,6 +50,9 @@ class Reader {
 
     // parent read task
     struct ReadTask* parent_{nullptr};
+
+    // whether the string is bulk(length prefixed), eg: blob error of RESP3
+    bool bulk_{false};
   };
 
  public:
@@ -130,6 +133,16 @@ class Reader {
   int ProcessLineItem(NoncontiguousBuffer& in, NoncontiguousBuffer::const_iterator& cur_itr, size_t& consume_len,
                       size_t& pos, ReadTask* cur_task);
 
+  /// @brief parse null item of RESP3
+  /// @private For internal use purpose only.
+  int ProcessNullItem(NoncontiguousBuffer& in, NoncontiguousBuffer::const_iterator& cur_itr, size_t& consume_len,
+                      size_t& pos);
+
+  /// @brief parse boolean item of RESP3
+  /// @private For internal use purpose only.
+  int ProcessBooleanItem(NoncontiguousBuffer& in, NoncontiguousBuffer::const_iterator& cur_itr, size_t& consume_len,
+                         size_t& pos);
+
   /// @brief parse bulk item
   /// @private For internal use purpose only.
   int ProcessBulkItem(NoncontiguousBuffer& in, NoncontiguousBuffer::const_iterator& cur_itr, size_t& consume_len,
@@ -653,6 +653,58 @@ TEST_F(ReaderTest, pipeline) {
   ASSERT_FALSE(r_.IsProtocolError());
 }
 
+TEST_F(ReaderTest, Resp3Types) {
+  std::string s =
+      "_\r\n#t\r\n#f\r\n,3.14\r\n(3492890328409238509324850943850943825024385\r\n=15\r\ntxt:Some string\r\n"
+      "!21\r\nSYNTAX invalid syntax\r\n~2\r\n:1\r\n:2\r\n%2\r\n+first\r\n:1\r\n+second\r\n_\r\n";
+  NoncontiguousBufferBuilder builder;
+  builder.Append(s.c_str(), s.size());
+  NoncontiguousBuffer in = builder.DestructiveGet();
+  std::deque<std::any> out;
+  while (r_.GetReply(in, out)) {
+  }
+  ASSERT_FALSE(r_.IsProtocolError());
+  ASSERT_EQ(0, in.ByteSize());
+  ASSERT_EQ(9, out.size());
+
+  auto reply = [&out](int i) -> const redis::Reply& { return std::any_cast<const redis::Reply&>(out[i]); };
+  ASSERT_TRUE(reply(0).IsNil());
+  ASSERT_TRUE(reply(1).IsBool());
+  ASSERT_EQ(1, reply(1).GetInteger());
+  ASSERT_EQ(0, reply(2).GetInteger());
+  ASSERT_TRUE(reply(3).IsDouble());
+  ASSERT_EQ("3.14", reply(3).GetString());
+  ASSERT_TRUE(reply(4).IsBigNumber());
+  ASSERT_EQ("3492890328409238509324850943850943825024385", reply(4).GetString());
+  ASSERT_TRUE(reply(5).IsVerbatim());
+  ASSERT_EQ("txt:Some string", reply(5).GetString());
+  ASSERT_TRUE(reply(6).IsError());
+  ASSERT_EQ("SYNTAX invalid syntax", reply(6).GetString());
+  ASSERT_TRUE(reply(7).IsSet());
+  ASSERT_EQ(2, reply(7).GetArray().size());
+  ASSERT_TRUE(reply(8).IsMap());
+  ASSERT_EQ(4, reply(8).GetArray().size());
+  ASSERT_EQ("second", reply(8).GetArray()[2].GetString());
+  ASSERT_TRUE(reply(8).GetArray()[3].IsNil());
+}
+
+TEST_F(ReaderTest, Resp3Push) {
+  std::string s = ">2\r\n$10\r\ninvalidate\r\n*1\r\n$3\r\nfoo\r\n$3\r\nbar\r\n";
+  NoncontiguousBufferBuilder builder;
+  builder.Append(s.c_str(), s.size());
+  NoncontiguousBuffer in = builder.DestructiveGet();
+  std::deque<std::any> out;
+  ASSERT_TRUE(r_.GetReply(in, out));
+  ASSERT_TRUE(r_.GetReply(in, out));
+  ASSERT_EQ(2, out.size());
+
+  auto& push = std::any_cast<const redis::Reply&>(out[0]);
+  ASSERT_TRUE(push.IsPush());
+  ASSERT_EQ("invalidate", push.GetArray()[0].GetString());
+  ASSERT_EQ("foo", push.GetArray()[1].GetArray()[0].GetString());
+  ASSERT_EQ("bar", std::any_cast<const redis::Reply&>(out[1]).GetString());
+}
+
 TEST_F(ReaderTest, SerialNoCrossBuffer) {
   r_.Init();
   std::string str1 = "@12345\r\n+OK\r\n@";
@@ -114,10 +114,56 @@ TransInfo RedisServiceProxy::ProxyOptionToTransInfo() {
   TRPC_ASSERT((codec_->Name() == "redis" || codec_->Name() == "istore") && "protocol name must be redis or istore");
   TransInfo trans_info = ServiceProxy::ProxyOptionToTransInfo();
   // set option_->redis_conf so we can use it
-  trans_info.user_data = GetServiceProxyOption()->redis_conf;
+  const RedisClientConf& redis_conf = GetServiceProxyOption()->redis_conf;
+  trans_info.user_data = redis_conf;
+
+  // The server sends the invalidation messages of the keys read through the connection(RESP3 push), they are picked
+  // out of the response stream by near-cache. The tracking state is gone with the connection, so is the cache.
+  if (redis_conf.enable && redis_conf.near_cache.enable) {
+    NearCache::Options options;
+    options.mode =
+        redis_conf.near_cache.mode == "broadcast" ? NearCache::Mode::kBroadcast : NearCache::Mode::kDefault;
+    options.prefixes = redis_conf.near_cache.prefixes;
+    options.max_bytes = redis_conf.near_cache.max_bytes;
+    options.shards = redis_conf.near_cache.shards;
+    near_cache_ = std::make_shared<NearCache>(options);
+
+    trans_info.checker_function = [near_cache = near_cache_, checker = std::move(trans_info.checker_function)](
+                                      const ConnectionPtr& conn, NoncontiguousBuffer& in, std::deque<std::any>& out) {
+      return near_cache->CheckResponse(checker, conn, in, out);
+    };
+    trans_info.conn_close_function = [near_cache = near_cache_,
+                                      conn_close = std::move(trans_info.conn_close_function)](const Connection* conn) {
+      near_cache->Clear();
+      if (conn_close) {
+        conn_close(conn);
+      }
+    };
+  }
   return trans_info;
 }
 
+bool RedisServiceProxy::CheckNearCacheSupported(const ClientContextPtr& context) {
+  if (!near_cache_ || context->GetPipelineCount() <= 1) {
+    return true;
+  }
+
+  std::string error("service name:");
+  error += GetServiceName();
+  error += ", near-cache does not support the merged pipeline request(pipeline count > 1).";
+  TRPC_LOG_ERROR(error);
+
+  Status status;
+  status.SetFrameworkRetCode(TrpcRetCode::TRPC_CLIENT_ENCODE_ERR);
+  status.SetErrorMessage(error);
+  context->SetStatus(std::move(status));
+  return false;
+}
+
+NearCache::Stats RedisServiceProxy::GetNearCacheStats() const {
+  return near_cache_ ? near_cache_->GetStats() : NearCache::Stats{};
+}
+
 Status RedisServiceProxy::Command(const ClientContextPtr& context, std::string&& cmd) {
   Request req;
 
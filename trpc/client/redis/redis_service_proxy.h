@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "trpc/client/redis/formatter.h"
+#include "trpc/client/redis/near_cache.h"
 #include "trpc/client/redis/reply.h"
 #include "trpc/client/redis/request.h"
 #include "trpc/client/service_proxy.h"
@@ -95,6 +96,9 @@ class RedisServiceProxy : public ServiceProxy {
   /// @brief Same as above interface which param cmd is right value
   Status Command(const ClientContextPtr& context, std::string&& cmd);
 
+  /// @brief Get the statistics of near-cache, all zero when near-cache is not enabled.
+  NearCache::Stats GetNearCacheStats() const;
+
  protected:
   /// @private For internal use purpose only.
   TransInfo ProxyOptionToTransInfo() override;
@@ -119,8 +123,16 @@ class RedisServiceProxy : public ServiceProxy {
   template <class RequestMessage>
   Status OnewayInvoke(const ClientContextPtr& context, RequestMessage&& req);
 
+ private:
+  // The replies of a merged pipeline request(pipeline count > 1) are read as a whole, which the push messages of
+  // near-cache would be mixed into, so such requests are rejected when near-cache is enabled.
+  bool CheckNearCacheSupported(const ClientContextPtr& context);
+
  private:
   std::shared_ptr<redis::Formatter> formatter_;
+
+  // Created when `near_cache` is enabled in RedisClientConf
+  NearCachePtr near_cache_;
 };
 
 template <class RequestMessage, class ResponseMessage>
@@ -157,6 +169,15 @@ Status RedisServiceProxy::UnaryInvoke(const ClientContextPtr& context, RequestMe
 
 template <class RequestMessage, class ResponseMessage>
 void RedisServiceProxy::UnaryInvokeImp(const ClientContextPtr& context, RequestMessage&& req, ResponseMessage* rsp) {
+  if (!CheckNearCacheSupported(context)) {
+    return;
+  }
+
+  NearCache::Ticket ticket;
+  if (near_cache_ && near_cache_->OnRequest(req, rsp, &ticket)) {
+    return;
+  }
+
   const ProtocolPtr& req_protocol = context->GetRequest();
 
   if (!codec_->FillRequest(context, req_protocol, reinterpret_cast<void*>(&req))) {
@@ -193,6 +214,10 @@ void RedisServiceProxy::UnaryInvokeImp(const ClientContextPtr& context, RequestM
     context->SetStatus(std::move(status));
     return;
   }
+
+  if (near_cache_) {
+    near_cache_->OnReply(ticket, *rsp);
+  }
 }
 
 template <class RequestMessage, class ResponseMessage>
@@ -223,6 +248,21 @@ Future<ResponseMessage> RedisServiceProxy::AsyncUnaryInvoke(const ClientContextP
 
 template <class RequestMessage, class ResponseMessage>
 Future<ResponseMessage> RedisServiceProxy::AsyncUnaryInvokeImp(const ClientContextPtr& context, RequestMessage&& req) {
+  if (!CheckNearCacheSupported(context)) {
+    RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+    return MakeExceptionFuture<ResponseMessage>(CommonException(context->GetStatus().ErrorMessage().c_str()));
+  }
+
+  NearCache::Ticket ticket;
+  if (near_cache_) {
+    ResponseMessage rsp_obj;
+    if (near_cache_->OnRequest(req, &rsp_obj, &ticket)) {
+      context->SetResponseData(&rsp_obj);
+      RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+      return MakeReadyFuture<ResponseMessage>(std::move(rsp_obj));
+    }
+  }
+
   ProtocolPtr& req_protocol = context->GetRequest();
 
   if (!codec_->FillRequest(context, req_protocol, reinterpret_cast<void*>(&req))) {
@@ -244,7 +284,7 @@ Future<ResponseMessage> RedisServiceProxy::AsyncUnaryInvokeImp(const ClientConte
   }
 
   return ServiceProxy::AsyncUnaryInvoke(context, req_protocol)
-      .Then([this, context](Future<ProtocolPtr>&& rsp_protocol) {
+      .Then([this, context, ticket = std::move(ticket)](Future<ProtocolPtr>&& rsp_protocol) {
         if (rsp_protocol.IsFailed()) {
           RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
           return MakeExceptionFuture<ResponseMessage>(rsp_protocol.GetException());
@@ -272,6 +312,10 @@ Future<ResponseMessage> RedisServiceProxy::AsyncUnaryInvokeImp(const ClientConte
           return MakeExceptionFuture<ResponseMessage>(CommonException(context->GetStatus().ErrorMessage().c_str()));
         }
 
+        if (near_cache_) {
+          near_cache_->OnReply(ticket, rsp_obj);
+        }
+
         context->SetResponseData(&rsp_obj);
 
         RunFilters(FilterPoint::CLIENT_POST_RPC_INVOKE, context);
@@ -296,6 +340,16 @@ Status RedisServiceProxy::OnewayInvoke(const ClientContextPtr& context, RequestM
 
   auto filter_ret = RunFilters(FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
   if (filter_ret == 0) {
+    if (!CheckNearCacheSupported(context)) {
+      return context->GetStatus();
+    }
+    if (near_cache_) {
+      // Only to evict the keys written by the request locally
+      Reply reply;
+      NearCache::Ticket ticket;
+      near_cache_->OnRequest(req, &reply, &ticket);
+    }
+
     const ProtocolPtr& req_protocol = context->GetRequest();
 
     if (!codec_->FillRequest(context, req_protocol, reinterpret_cast<void*>(&req))) {
@@ -33,6 +33,8 @@ struct NilReplyMarker {};
 struct InvalidReplyMarker {};
 
 /// @brief redis reply wrapper class
+/// @note The aggregate types of RESP3(PUSH/MAP/SET) are stored as array, the keys and values of MAP are placed
+///       alternately. BOOL is stored as integer(0 or 1), DOUBLE/BIGNUM/VERB are stored as string.
 struct Reply {
  public:
   enum Type {
@@ -44,6 +46,14 @@ struct Reply {
     NIL,
     ARRAY,
     INVALID,
+    // RESP3 types
+    PUSH,
+    MAP,
+    SET,
+    BOOL,
+    DOUBLE,
+    BIGNUM,
+    VERB,
   };
 
   Type type_ = Type::NONE;
@@ -143,8 +153,15 @@ struct Reply {
   inline bool IsArray() const { return type_ == Type::ARRAY; }
   inline bool IsInteger() const { return type_ == Type::INTEGER; }
   inline bool IsInvalid() const { return type_ == Type::INVALID; }
-
-  /// @brief Get reply as string ONLY when type is in[string/status/error]
+  inline bool IsPush() const { return type_ == Type::PUSH; }
+  inline bool IsMap() const { return type_ == Type::MAP; }
+  inline bool IsSet() const { return type_ == Type::SET; }
+  inline bool IsBool() const { return type_ == Type::BOOL; }
+  inline bool IsDouble() const { return type_ == Type::DOUBLE; }
+  inline bool IsBigNumber() const { return type_ == Type::BIGNUM; }
+  inline bool IsVerbatim() const { return type_ == Type::VERB; }
+
+  /// @brief Get reply as string ONLY when type is in[string/status/error/double/bignum/verb]
   inline const std::basic_string<char>& GetString() const { return std::get<std::string>(u_); }
 
   inline int64_t GetInteger() const { return std::get<int64_t>(u_); }
@@ -165,7 +182,7 @@ struct Reply {
   /// @brief Get reply as Array when need for high performance
   /// It will use std::move the move this reply,so DO NOT invoke repeatly
   inline int GetArray(std::vector<Reply>& value) {
-    if (has_value_ && type_ == Type::ARRAY) {
+    if (has_value_ && (type_ == Type::ARRAY || type_ == Type::PUSH || type_ == Type::MAP || type_ == Type::SET)) {
       value = std::move(std::get<std::vector<Reply>>(u_));
 
       has_value_ = false;
@@ -192,6 +209,20 @@ struct Reply {
         return "error";
       case Type::INVALID:
         return "invalid";
+      case Type::PUSH:
+        return "push";
+      case Type::MAP:
+        return "map";
+      case Type::SET:
+        return "set";
+      case Type::BOOL:
+        return "bool";
+      case Type::DOUBLE:
+        return "double";
+      case Type::BIGNUM:
+        return "bignum";
+      case Type::VERB:
+        return "verb";
       default:
         return "unkonwn";
     }
@@ -216,8 +247,19 @@ inline std::ostream& operator<<(std::ostream& os, const trpc::redis::Reply& repl
     case trpc::redis::Reply::ERROR:
       os << "<error> " << reply.GetString();
       break;
+    case trpc::redis::Reply::DOUBLE:
+    case trpc::redis::Reply::BIGNUM:
+    case trpc::redis::Reply::VERB:
+      os << "<" << reply.TypeToString() << "> " << reply.GetString();
+      break;
+    case trpc::redis::Reply::BOOL:
+      os << "<bool> " << (reply.GetInteger() ? "true" : "false");
+      break;
+    case trpc::redis::Reply::PUSH:
+    case trpc::redis::Reply::MAP:
+    case trpc::redis::Reply::SET:
     case trpc::redis::Reply::ARRAY:
-      os << "<array> " << reply.GetArray().size() << "[";
+      os << "<" << reply.TypeToString() << "> " << reply.GetArray().size() << "[";
       for (auto& item : reply.GetArray()) {
         os << item;
       }
@@ -0,0 +1,173 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/client/scatter_gather.h"
+
+#include <algorithm>
+
+#include "trpc/naming/trpc_naming.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+NodeAddr ToNodeAddr(const TrpcEndpointInfo& endpoint) {
+  NodeAddr addr;
+  addr.ip = endpoint.host;
+  addr.port = endpoint.port;
+  addr.addr_type = endpoint.is_ipv6 ? NodeAddr::AddrType::kIpV6 : NodeAddr::AddrType::kIpV4;
+  return addr;
+}
+
+bool IsSameAddr(const NodeAddr& addr, const TrpcEndpointInfo& endpoint) {
+  return addr.ip == endpoint.host && addr.port == endpoint.port;
+}
+
+TrpcSelectorInfo MakeSelectorInfo(const ClientContextPtr& context, SelectorPolicy policy) {
+  const auto* option = context->GetServiceProxyOption();
+  TRPC_ASSERT(option != nullptr);
+
+  TrpcSelectorInfo info;
+  info.plugin_name = option->selector_name;
+  info.selector_info.name = context->GetServiceTarget();
+  info.selector_info.policy = policy;
+  info.selector_info.load_balance_name = option->load_balance_name;
+  info.selector_info.load_balance_type = option->load_balance_type;
+  info.selector_info.context = context;
+  auto iter = option->service_filter_configs.find(option->selector_name);
+  if (iter != option->service_filter_configs.end()) {
+    info.selector_info.extend_select_info = &iter->second;
+  }
+  return info;
+}
+
+}  // namespace
+
+std::vector<ScatterTarget> SelectAllTargets(const ServiceProxyPtr& proxy, bool with_replica) {
+  auto context = MakeClientContext(proxy);
+  std::vector<TrpcEndpointInfo> endpoints;
+  if (naming::SelectBatch(MakeSelectorInfo(context, SelectorPolicy::ALL), endpoints) != 0 || endpoints.empty()) {
+    TRPC_FMT_ERROR("select all endpoints of {} failed", context->GetServiceTarget());
+    return {};
+  }
+
+  std::vector<ScatterTarget> targets(endpoints.size());
+  for (std::size_t i = 0; i < endpoints.size(); ++i) {
+    targets[i].addr = ToNodeAddr(endpoints[i]);
+    if (with_replica && endpoints.size() > 1) {
+      targets[i].replica = ToNodeAddr(endpoints[(i + 1) % endpoints.size()]);
+    }
+  }
+  return targets;
+}
+
+std::vector<ScatterTarget> SelectTargetsByKey(const ServiceProxyPtr& proxy, const std::vector<std::string>& keys,
+                                              bool with_replica) {
+  std::vector<ScatterTarget> targets(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    auto context = MakeClientContext(proxy);
+    context->SetHashKey(keys[i]);
+
+    TrpcEndpointInfo endpoint;
+    if (naming::Select(MakeSelectorInfo(context, SelectorPolicy::ONE), endpoint) != 0) {
+      TRPC_FMT_ERROR("select endpoint of {} by key {} failed", context->GetServiceTarget(), keys[i]);
+      return {};
+    }
+    targets[i].addr = ToNodeAddr(endpoint);
+
+    if (!with_replica) {
+      continue;
+    }
+    std::vector<TrpcEndpointInfo> candidates;
+    auto info = MakeSelectorInfo(context, SelectorPolicy::MULTIPLE);
+    info.selector_info.select_num = 2;
+    if (naming::SelectBatch(info, candidates) == 0) {
+      auto it = std::find_if(candidates.begin(), candidates.end(),
+                             [&](const TrpcEndpointInfo& candidate) { return !IsSameAddr(targets[i].addr, candidate); });
+      if (it != candidates.end()) {
+        targets[i].replica = ToNodeAddr(*it);
+      }
+    }
+  }
+  return targets;
+}
+
+namespace detail {
+
+GatherTracker::GatherTracker(const ScatterGatherOption& option, std::size_t shard_count)
+    : policy_(option.policy), shard_count_(shard_count) {
+  if (policy_ == GatherPolicy::kAll || option.count == 0 || option.count > shard_count) {
+    required_ = shard_count;
+  } else {
+    required_ = option.count;
+  }
+  completed_ = CheckCompleted();
+}
+
+bool GatherTracker::OnShardDone(bool succeeded) {
+  ++done_;
+  if (succeeded) {
+    ++succeeded_;
+  }
+  completed_ = CheckCompleted();
+  return completed_;
+}
+
+bool GatherTracker::CheckCompleted() const {
+  switch (policy_) {
+    case GatherPolicy::kQuorum:
+      // Completes once the quorum is reached, or can not be reached by the shards left.
+      return succeeded_ >= required_ || shard_count_ - (done_ - succeeded_) < required_;
+    case GatherPolicy::kFirstN:
+      return done_ >= required_;
+    default:
+      return done_ >= shard_count_;
+  }
+}
+
+Status GatherTracker::GetStatus() const {
+  switch (policy_) {
+    case GatherPolicy::kQuorum:
+      if (succeeded_ < required_) {
+        return Status(TrpcRetCode::TRPC_INVOKE_UNKNOWN_ERR, 0,
+                      "quorum not reached, " + std::to_string(succeeded_) + " of " + std::to_string(required_) +
+                          " shards succeeded");
+      }
+      return kDefaultStatus;
+    case GatherPolicy::kFirstN:
+      return kDefaultStatus;
+    default:
+      if (succeeded_ < shard_count_) {
+        return Status(TrpcRetCode::TRPC_INVOKE_UNKNOWN_ERR, 0,
+                      std::to_string(shard_count_ - succeeded_) + " of " + std::to_string(shard_count_) +
+                          " shards failed");
+      }
+      return kDefaultStatus;
+  }
+}
+
+Status ExceptionToStatus(const ClientContextPtr& context, Exception&& ex) {
+  if (ex.is<UnaryRpcError>()) {
+    return ex.Get<UnaryRpcError>()->GetStatus();
+  }
+  if (!context->GetStatus().OK()) {
+    return context->GetStatus();
+  }
+  return Status(ex.GetExceptionCode(), 0, ex.what());
+}
+
+}  // namespace detail
+
+}  // namespace trpc
@@ -0,0 +1,263 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "trpc/client/call_template.h"
+#include "trpc/client/make_client_context.h"
+#include "trpc/client/rpc_service_proxy.h"
+#include "trpc/common/status.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/future.h"
+#include "trpc/future/future.h"
+#include "trpc/future/future_utility.h"
+#include "trpc/tvar/compound_ops/latency_recorder.h"
+#include "trpc/util/function.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+/// @brief The policy to decide when a scatter-gather call completes.
+enum class GatherPolicy {
+  /// Completes when all the shards are done.
+  kAll,
+  /// Completes as soon as `ScatterGatherOption::count` shards succeed, or when it's impossible to get so many.
+  kQuorum,
+  /// Completes as soon as `ScatterGatherOption::count` shards are done, whether they succeed or not.
+  kFirstN,
+};
+
+/// @brief Options of a scatter-gather call.
+struct ScatterGatherOption {
+  GatherPolicy policy{GatherPolicy::kAll};
+
+  /// The `K` of `kQuorum` or the `N` of `kFirstN`, it's clamped to the number of shards, 0 means all the shards.
+  std::size_t count{0};
+
+  /// The deadline(ms) shared by all the shards, 0 means the timeout of the call template.
+  uint32_t timeout{0};
+
+  /// If it's not 0, a shard which has not responded within `hedge_delay`(ms) is hedged to its replica(if any) by
+  /// backup request, the first response of the two is used.
+  uint32_t hedge_delay{0};
+
+  /// Called to customize the client context of each shard(eg: set metadata) before it's sent.
+  Function<void(std::size_t shard, const ClientContextPtr& context)> context_hook{nullptr};
+
+  /// If it's set, the latency(us) of each shard done is recorded in it.
+  tvar::LatencyRecorder* shard_latency{nullptr};
+};
+
+/// @brief A shard of a scatter-gather call.
+struct ScatterTarget {
+  /// The address the shard is sent to.
+  NodeAddr addr;
+
+  /// The replica which the shard is hedged to.
+  std::optional<NodeAddr> replica;
+};
+
+/// @brief The result of a shard.
+template <class ResponseMessage>
+struct ShardResult {
+  /// Whether the shard was done before the call completed, the other fields are valid only if it's true.
+  bool done{false};
+
+  Status status{TrpcRetCode::TRPC_CLIENT_CANCELED_ERR, 0, "shard not done before gathering completed"};
+
+  ResponseMessage response;
+
+  uint64_t latency_us{0};
+};
+
+/// @brief The result of a scatter-gather call, results are in the same order as the targets.
+template <class ResponseMessage>
+struct GatherResult {
+  /// OK if the gather policy is satisfied, the results of the shards done are available in either case.
+  Status status;
+
+  std::vector<ShardResult<ResponseMessage>> shards;
+
+  /// Number of shards done/succeeded before the call completed.
+  std::size_t done_count{0};
+  std::size_t succeeded_count{0};
+};
+
+/// @brief Select all the endpoints of the service of `proxy` from naming, each one is a shard.
+/// @param with_replica if it's true, the next endpoint is set as the replica of each shard.
+/// @return empty on error.
+std::vector<ScatterTarget> SelectAllTargets(const ServiceProxyPtr& proxy, bool with_replica = false);
+
+/// @brief Select a shard for each hash key from naming, by the load balance of `proxy`(which should be a hash one).
+/// @param with_replica if it's true, another endpoint is selected as the replica of each shard.
+/// @return empty on error.
+std::vector<ScatterTarget> SelectTargetsByKey(const ServiceProxyPtr& proxy, const std::vector<std::string>& keys,
+                                              bool with_replica = false);
+
+namespace detail {
+
+/// @brief Tracks the shards done according to the gather policy, it's not thread-safe.
+class GatherTracker {
+ public:
+  GatherTracker(const ScatterGatherOption& option, std::size_t shard_count);
+
+  /// @brief Record a shard done.
+  /// @return true if the call completes by this shard.
+  bool OnShardDone(bool succeeded);
+
+  /// @brief Whether the call completes without any shard, eg: there's no shard or the count required is 0.
+  bool IsCompleted() const { return completed_; }
+
+  /// @brief The status of the call once it completes.
+  Status GetStatus() const;
+
+  std::size_t GetDoneCount() const { return done_; }
+
+  std::size_t GetSucceededCount() const { return succeeded_; }
+
+ private:
+  bool CheckCompleted() const;
+
+ private:
+  GatherPolicy policy_;
+  std::size_t shard_count_;
+  std::size_t required_;
+  std::size_t done_{0};
+  std::size_t succeeded_{0};
+  bool completed_{false};
+};
+
+Status ExceptionToStatus(const ClientContextPtr& context, Exception&& ex);
+
+}  // namespace detail
+
+/// @brief Asynchronous scatter-gather call: sends the request to each target in parallel, and completes according to
+///        the gather policy with partial results.
+/// @param requests one request for each target, or a single request broadcast to all the targets.
+/// @note  The shards still in flight when the call completes are not canceled, their results are just dropped.
+template <class RequestMessage, class ResponseMessage>
+Future<GatherResult<ResponseMessage>> AsyncScatterGather(const std::shared_ptr<RpcServiceProxy>& proxy,
+                                                         const CallTemplatePtr& call_template,
+                                                         const std::vector<ScatterTarget>& targets,
+                                                         const std::vector<RequestMessage>& requests,
+                                                         const ScatterGatherOption& option = {}) {
+  TRPC_ASSERT(requests.size() == 1 || requests.size() == targets.size());
+
+  struct State {
+    State(const ScatterGatherOption& option, std::size_t shard_count) : tracker(option, shard_count) {
+      result.shards.resize(shard_count);
+    }
+
+    std::mutex mutex;
+    detail::GatherTracker tracker;
+    GatherResult<ResponseMessage> result;
+    Promise<GatherResult<ResponseMessage>> promise;
+    bool fulfilled{false};
+
+    // Called with the lock held, the result is taken out and the shards done later are dropped.
+    GatherResult<ResponseMessage> TakeResult() {
+      fulfilled = true;
+      result.status = tracker.GetStatus();
+      result.done_count = tracker.GetDoneCount();
+      result.succeeded_count = tracker.GetSucceededCount();
+      return std::move(result);
+    }
+  };
+
+  auto state = std::make_shared<State>(option, targets.size());
+  auto ft = state->promise.GetFuture();
+  if (state->tracker.IsCompleted()) {
+    state->promise.SetValue(state->TakeResult());
+    return ft;
+  }
+
+  uint32_t timeout = option.timeout != 0 ? option.timeout : call_template->timeout;
+  for (std::size_t i = 0; i < targets.size(); ++i) {
+    auto context = MakeClientContext(proxy, call_template);
+    context->SetTimeout(timeout);
+    if (option.hedge_delay != 0 && targets[i].replica) {
+      context->SetBackupRequestDelay(option.hedge_delay);
+      context->SetBackupRequestAddrs({targets[i].addr, *targets[i].replica});
+    } else {
+      context->SetAddr(targets[i].addr.ip, targets[i].addr.port);
+    }
+    if (option.context_hook) {
+      option.context_hook(i, context);
+    }
+
+    const auto& request = requests.size() == 1 ? requests[0] : requests[i];
+    uint64_t begin_us = trpc::GetSteadyMicroSeconds();
+    proxy->template AsyncUnaryInvoke<RequestMessage, ResponseMessage>(context, request)
+        .Then([state, context, i, begin_us, shard_latency = option.shard_latency](Future<ResponseMessage>&& ft) {
+          uint64_t latency_us = trpc::GetSteadyMicroSeconds() - begin_us;
+          if (shard_latency) {
+            shard_latency->Update(static_cast<uint32_t>(latency_us));
+          }
+
+          std::optional<GatherResult<ResponseMessage>> result;
+          {
+            std::scoped_lock _(state->mutex);
+            if (state->fulfilled) {
+              return MakeReadyFuture<>();
+            }
+
+            auto& shard = state->result.shards[i];
+            shard.done = true;
+            shard.latency_us = latency_us;
+            if (ft.IsReady()) {
+              shard.status = kDefaultStatus;
+              shard.response = ft.GetValue0();
+            } else {
+              shard.status = detail::ExceptionToStatus(context, ft.GetException());
+            }
+            if (state->tracker.OnShardDone(shard.status.OK())) {
+              result = state->TakeResult();
+            }
+          }
+          // Run the continuations of the caller out of the lock.
+          if (result) {
+            state->promise.SetValue(std::move(*result));
+          }
+          return MakeReadyFuture<>();
+        });
+  }
+
+  return ft;
+}
+
+/// @brief Synchronous scatter-gather call, see `AsyncScatterGather`. It blocks the current fiber in fiber runtime,
+///        or the current thread otherwise.
+template <class RequestMessage, class ResponseMessage>
+GatherResult<ResponseMessage> ScatterGather(const std::shared_ptr<RpcServiceProxy>& proxy,
+                                            const CallTemplatePtr& call_template,
+                                            const std::vector<ScatterTarget>& targets,
+                                            const std::vector<RequestMessage>& requests,
+                                            const ScatterGatherOption& option = {}) {
+  auto ft = AsyncScatterGather<RequestMessage, ResponseMessage>(proxy, call_template, targets, requests, option);
+  if (IsRunningInFiberWorker()) {
+    return fiber::BlockingGet(std::move(ft)).GetValue0();
+  }
+  return future::BlockingGet(std::move(ft)).GetValue0();
+}
+
+}  // namespace trpc
@@ -0,0 +1,386 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/client/scatter_gather.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "trpc/client/service_proxy_option_setter.h"
+#include "trpc/client/testing/service_proxy_testing.h"
+#include "trpc/codec/trpc/trpc_client_codec.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/proto/testing/helloworld.pb.h"
+#include "trpc/runtime/runtime.h"
+
+namespace trpc::testing {
+
+using detail::GatherTracker;
+
+TEST(GatherTrackerTest, All) {
+  GatherTracker tracker(ScatterGatherOption{.policy = GatherPolicy::kAll, .count = 1}, 3);
+  ASSERT_FALSE(tracker.IsCompleted());
+  ASSERT_FALSE(tracker.OnShardDone(true));
+  ASSERT_FALSE(tracker.OnShardDone(false));
+  ASSERT_TRUE(tracker.OnShardDone(true));
+  ASSERT_EQ(3, tracker.GetDoneCount());
+  ASSERT_EQ(2, tracker.GetSucceededCount());
+  // Partial results.
+  ASSERT_FALSE(tracker.GetStatus().OK());
+}
+
+TEST(GatherTrackerTest, Quorum) {
+  GatherTracker tracker(ScatterGatherOption{.policy = GatherPolicy::kQuorum, .count = 2}, 4);
+  ASSERT_FALSE(tracker.OnShardDone(false));
+  ASSERT_FALSE(tracker.OnShardDone(true));
+  ASSERT_TRUE(tracker.OnShardDone(true));
+  ASSERT_TRUE(tracker.GetStatus().OK());
+}
+
+TEST(GatherTrackerTest, QuorumUnreachable) {
+  GatherTracker tracker(ScatterGatherOption{.policy = GatherPolicy::kQuorum, .count = 2}, 3);
+  ASSERT_FALSE(tracker.OnShardDone(false));
+  // Only one shard is left, the quorum can not be reached anymore.
+  ASSERT_TRUE(tracker.OnShardDone(false));
+  ASSERT_FALSE(tracker.GetStatus().OK());
+}
+
+TEST(GatherTrackerTest, FirstN) {
+  GatherTracker tracker(ScatterGatherOption{.policy = GatherPolicy::kFirstN, .count = 2}, 5);
+  ASSERT_FALSE(tracker.OnShardDone(false));
+  ASSERT_TRUE(tracker.OnShardDone(true));
+  ASSERT_TRUE(tracker.GetStatus().OK());
+
+  // The count is clamped to the number of shards.
+  GatherTracker clamped(ScatterGatherOption{.policy = GatherPolicy::kFirstN, .count = 10}, 2);
+  ASSERT_FALSE(clamped.OnShardDone(true));
+  ASSERT_TRUE(clamped.OnShardDone(true));
+}
+
+TEST(GatherTrackerTest, NoShard) {
+  GatherTracker tracker(ScatterGatherOption{}, 0);
+  ASSERT_TRUE(tracker.IsCompleted());
+  ASSERT_TRUE(tracker.GetStatus().OK());
+}
+
+TEST(ScatterGatherTest, NoTarget) {
+  auto ft = AsyncScatterGather<std::string, std::string>(nullptr, nullptr, {}, {"hello"});
+  ASSERT_TRUE(ft.IsReady());
+  auto result = ft.GetValue0();
+  ASSERT_TRUE(result.status.OK());
+  ASSERT_TRUE(result.shards.empty());
+}
+
+TEST(ScatterGatherTest, ShardNotDone) {
+  ShardResult<std::string> shard;
+  ASSERT_FALSE(shard.done);
+  ASSERT_EQ(TrpcRetCode::TRPC_CLIENT_CANCELED_ERR, shard.status.GetFrameworkRetCode());
+}
+
+namespace {
+
+// The address of the shard(the primary one if it's hedged) which the context is sent to.
+std::string ShardIp(const ClientContextPtr& context) {
+  if (context->IsBackupRequest()) {
+    return context->GetBackupRequestRetryInfo()->backup_addrs[0].addr.ip;
+  }
+  return context->GetIp();
+}
+
+}  // namespace
+
+class MockTrpcClientCodec : public TrpcClientCodec {
+ public:
+  std::string Name() const { return "mock_codec"; }
+
+  MOCK_METHOD(bool, FillRequest, (const ClientContextPtr& context, const ProtocolPtr& in, void* out), (override));
+  MOCK_METHOD(bool, FillResponse, (const ClientContextPtr& context, const ProtocolPtr& in, void* out), (override));
+};
+
+class MockRpcServiceProxy : public RpcServiceProxy {
+ public:
+  void SetMockServiceProxyOption(const std::shared_ptr<ServiceProxyOption>& option) {
+    SetServiceProxyOptionInner(option);
+  }
+
+  MOCK_METHOD(Future<ProtocolPtr>, AsyncUnaryTransportInvoke,
+              (const ClientContextPtr& context, const ProtocolPtr& req_protocol), (override));
+};
+
+// The transport is mocked: the request of each shard is pending until the test replies to it or fails it.
+class ScatterGatherTestFixture : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    codec_ = std::make_shared<::testing::NiceMock<MockTrpcClientCodec>>();
+    ON_CALL(*codec_, FillRequest(::testing::_, ::testing::_, ::testing::_)).WillByDefault(::testing::Return(true));
+    // The response tells which shard it's from.
+    ON_CALL(*codec_, FillResponse(::testing::_, ::testing::_, ::testing::_))
+        .WillByDefault(::testing::Invoke([](const ClientContextPtr& context, const ProtocolPtr&, void* out) {
+          static_cast<test::helloworld::HelloReply*>(out)->set_msg(ShardIp(context));
+          return true;
+        }));
+    ClientCodecFactory::GetInstance()->Register(codec_);
+    RegisterPlugins();
+
+    detail::SetDefaultOption(option_);
+    option_->name = "trpc.test.helloworld.Greeter";
+    option_->caller_name = "Test.HelloWorldClient";
+    option_->codec_name = "mock_codec";
+    option_->conn_type = "long";
+    option_->network = "tcp";
+    option_->timeout = 1000;
+    option_->selector_name = "direct";
+  }
+
+  static void TearDownTestCase() {
+    UnregisterPlugins();
+    codec_ = nullptr;
+  }
+
+ protected:
+  void SetUp() override {
+    proxy_ = std::make_shared<::testing::NiceMock<MockRpcServiceProxy>>();
+    proxy_->SetMockServiceProxyOption(option_);
+    ON_CALL(*proxy_, AsyncUnaryTransportInvoke(::testing::_, ::testing::_))
+        .WillByDefault(::testing::Invoke([this](const ClientContextPtr& context, const ProtocolPtr&) {
+          std::scoped_lock _(mutex_);
+          contexts_.push_back(context);
+          return pending_[ShardIp(context)].GetFuture();
+        }));
+    call_template_ = proxy_->PrepareCall("/trpc.test.helloworld.Greeter/SayHello");
+  }
+
+  void TearDown() override {
+    proxy_->Stop();
+    proxy_->Destroy();
+  }
+
+  static std::vector<ScatterTarget> MakeTargets(std::size_t count) {
+    std::vector<ScatterTarget> targets(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      targets[i].addr.ip = "127.0.0." + std::to_string(i + 1);
+      targets[i].addr.port = 10001;
+    }
+    return targets;
+  }
+
+  Future<GatherResult<test::helloworld::HelloReply>> AsyncCall(const std::vector<ScatterTarget>& targets,
+                                                               const ScatterGatherOption& option) {
+    return AsyncScatterGather<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+        proxy_, call_template_, targets, {test::helloworld::HelloRequest()}, option);
+  }
+
+  void Reply(const std::string& ip) { TakePending(ip).SetValue(codec_->CreateResponsePtr()); }
+
+  void Fail(const std::string& ip) {
+    TakePending(ip).SetException(CommonException("invoke timeout", TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR));
+  }
+
+  std::vector<ClientContextPtr> GetContexts() {
+    std::scoped_lock _(mutex_);
+    return contexts_;
+  }
+
+ private:
+  Promise<ProtocolPtr> TakePending(const std::string& ip) {
+    std::scoped_lock _(mutex_);
+    auto iter = pending_.find(ip);
+    EXPECT_NE(iter, pending_.end());
+    auto promise = std::move(iter->second);
+    pending_.erase(iter);
+    return promise;
+  }
+
+ protected:
+  static std::shared_ptr<ServiceProxyOption> option_;
+  static std::shared_ptr<::testing::NiceMock<MockTrpcClientCodec>> codec_;
+  std::shared_ptr<::testing::NiceMock<MockRpcServiceProxy>> proxy_;
+  CallTemplatePtr call_template_;
+
+  std::mutex mutex_;
+  std::map<std::string, Promise<ProtocolPtr>> pending_;
+  std::vector<ClientContextPtr> contexts_;
+};
+
+std::shared_ptr<ServiceProxyOption> ScatterGatherTestFixture::option_ = std::make_shared<ServiceProxyOption>();
+std::shared_ptr<::testing::NiceMock<MockTrpcClientCodec>> ScatterGatherTestFixture::codec_ = nullptr;
+
+TEST_F(ScatterGatherTestFixture, AllWithPartialResults) {
+  auto ft = AsyncCall(MakeTargets(3), ScatterGatherOption{.policy = GatherPolicy::kAll, .timeout = 200});
+  auto contexts = GetContexts();
+  ASSERT_EQ(3, contexts.size());
+  for (const auto& context : contexts) {
+    // All the shards share one deadline.
+    ASSERT_EQ(200, context->GetTimeout());
+    ASSERT_EQ("/trpc.test.helloworld.Greeter/SayHello", context->GetFuncName());
+  }
+
+  Reply("127.0.0.1");
+  Fail("127.0.0.2");
+  ASSERT_FALSE(ft.IsReady());
+  Reply("127.0.0.3");
+  ASSERT_TRUE(ft.IsReady());
+
+  auto result = ft.GetValue0();
+  ASSERT_FALSE(result.status.OK());
+  ASSERT_EQ(3, result.done_count);
+  ASSERT_EQ(2, result.succeeded_count);
+  ASSERT_TRUE(result.shards[0].status.OK());
+  ASSERT_EQ("127.0.0.1", result.shards[0].response.msg());
+  ASSERT_TRUE(result.shards[1].done);
+  ASSERT_EQ(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, result.shards[1].status.GetFrameworkRetCode());
+  ASSERT_EQ("127.0.0.3", result.shards[2].response.msg());
+}
+
+TEST_F(ScatterGatherTestFixture, QuorumDropsStragglers) {
+  auto ft = AsyncCall(MakeTargets(3), ScatterGatherOption{.policy = GatherPolicy::kQuorum, .count = 2});
+  Reply("127.0.0.3");
+  ASSERT_FALSE(ft.IsReady());
+  Reply("127.0.0.1");
+  // The quorum is reached without waiting for the straggler.
+  ASSERT_TRUE(ft.IsReady());
+
+  auto result = ft.GetValue0();
+  ASSERT_TRUE(result.status.OK());
+  ASSERT_EQ(2, result.succeeded_count);
+  ASSERT_EQ("127.0.0.1", result.shards[0].response.msg());
+  ASSERT_FALSE(result.shards[1].done);
+  ASSERT_EQ(TrpcRetCode::TRPC_CLIENT_CANCELED_ERR, result.shards[1].status.GetFrameworkRetCode());
+  ASSERT_EQ("127.0.0.3", result.shards[2].response.msg());
+
+  // The late reply of the straggler is dropped.
+  Reply("127.0.0.2");
+  ASSERT_FALSE(result.shards[1].done);
+  ASSERT_TRUE(result.shards[1].response.msg().empty());
+}
+
+TEST_F(ScatterGatherTestFixture, QuorumUnreachable) {
+  auto ft = AsyncCall(MakeTargets(3), ScatterGatherOption{.policy = GatherPolicy::kQuorum, .count = 2});
+  Fail("127.0.0.1");
+  ASSERT_FALSE(ft.IsReady());
+  Fail("127.0.0.2");
+  // Completes without waiting for the last shard, as the quorum can not be reached anymore.
+  ASSERT_TRUE(ft.IsReady());
+
+  auto result = ft.GetValue0();
+  ASSERT_FALSE(result.status.OK());
+  ASSERT_EQ(2, result.done_count);
+  ASSERT_EQ(0, result.succeeded_count);
+  Reply("127.0.0.3");
+}
+
+TEST_F(ScatterGatherTestFixture, FirstN) {
+  auto ft = AsyncCall(MakeTargets(3), ScatterGatherOption{.policy = GatherPolicy::kFirstN, .count = 1});
+  Fail("127.0.0.2");
+  ASSERT_TRUE(ft.IsReady());
+
+  auto result = ft.GetValue0();
+  // Completes by the first shard done, even if it failed.
+  ASSERT_TRUE(result.status.OK());
+  ASSERT_EQ(1, result.done_count);
+  ASSERT_EQ(0, result.succeeded_count);
+  ASSERT_TRUE(result.shards[1].done);
+  ASSERT_FALSE(result.shards[0].done);
+  Reply("127.0.0.1");
+  Reply("127.0.0.3");
+}
+
+TEST_F(ScatterGatherTestFixture, Hedging) {
+  auto targets = MakeTargets(2);
+  targets[0].replica = NodeAddr{.port = 10001, .ip = "127.0.0.10"};
+  std::vector<std::size_t> hooked;
+  ScatterGatherOption option{.hedge_delay = 10};
+  option.context_hook = [&hooked](std::size_t shard, const ClientContextPtr& context) { hooked.push_back(shard); };
+
+  auto ft = AsyncCall(targets, option);
+  ASSERT_EQ((std::vector<std::size_t>{0, 1}), hooked);
+
+  auto contexts = GetContexts();
+  ASSERT_EQ(2, contexts.size());
+  for (const auto& context : contexts) {
+    if (ShardIp(context) == "127.0.0.1") {
+      // The shard with a replica is sent as backup request, the transport hedges it to the replica after the delay.
+      ASSERT_TRUE(context->IsBackupRequest());
+      auto* retry_info = context->GetBackupRequestRetryInfo();
+      ASSERT_EQ(10, retry_info->delay);
+      ASSERT_EQ(2, retry_info->backup_addrs.size());
+      ASSERT_EQ("127.0.0.10", retry_info->backup_addrs[1].addr.ip);
+    } else {
+      ASSERT_FALSE(context->IsBackupRequest());
+      ASSERT_EQ("127.0.0.2", context->GetIp());
+    }
+  }
+
+  Reply("127.0.0.1");
+  Reply("127.0.0.2");
+  ASSERT_TRUE(ft.IsReady());
+  ASSERT_TRUE(ft.GetValue0().status.OK());
+}
+
+TEST_F(ScatterGatherTestFixture, SyncInFutureMode) {
+  auto targets = MakeTargets(2);
+  std::thread replier([this] {
+    while (GetContexts().size() < 2) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    Reply("127.0.0.1");
+    Fail("127.0.0.2");
+  });
+
+  // Blocks the current thread.
+  auto result = ScatterGather<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+      proxy_, call_template_, targets, {test::helloworld::HelloRequest()});
+  replier.join();
+
+  ASSERT_FALSE(result.status.OK());
+  ASSERT_EQ(2, result.done_count);
+  ASSERT_EQ("127.0.0.1", result.shards[0].response.msg());
+}
+
+TEST_F(ScatterGatherTestFixture, SyncInFiberMode) {
+  auto targets = MakeTargets(2);
+  GatherResult<test::helloworld::HelloReply> result;
+  RunAsFiber([&] {
+    ASSERT_TRUE(StartFiberDetached([this] {
+      while (GetContexts().size() < 2) {
+        FiberSleepFor(std::chrono::milliseconds(1));
+      }
+      Reply("127.0.0.2");
+      Reply("127.0.0.1");
+    }));
+
+    // Blocks the current fiber only.
+    result = ScatterGather<test::helloworld::HelloRequest, test::helloworld::HelloReply>(
+        proxy_, call_template_, targets, {test::helloworld::HelloRequest()},
+        ScatterGatherOption{.policy = GatherPolicy::kQuorum, .count = 2});
+  });
+  // Restore the runtime type changed by `RunAsFiber`.
+  runtime::SetRuntimeType(runtime::kThreadRuntime);
+
+  ASSERT_TRUE(result.status.OK());
+  ASSERT_EQ(2, result.succeeded_count);
+  ASSERT_EQ("127.0.0.2", result.shards[1].response.msg());
+}
+
+}  // namespace trpc::testing
@@ -430,6 +430,11 @@ void ServiceProxy::FillClientContext(const ClientContextPtr& context) {
     }
   }
 
+  // The names have been resolved when the context was created from a call template.
+  if (context->GetCallTemplate() != nullptr) {
+    return;
+  }
+
   if (context->GetCallerName().empty()) {
     context->SetCallerName(option_->caller_name);
   }
@@ -439,6 +444,21 @@ void ServiceProxy::FillClientContext(const ClientContextPtr& context) {
   }
 }
 
+CallTemplatePtr ServiceProxy::PrepareCall(std::string func_name,
+                                          const google::protobuf::MethodDescriptor* method_desc) {
+  TRPC_ASSERT(option_ && "the option of service proxy must be set before preparing a call");
+
+  auto call_template = std::make_shared<CallTemplate>();
+  call_template->func_name = std::move(func_name);
+  call_template->caller_name = option_->caller_name;
+  call_template->callee_name = option_->callee_name;
+  // Provide compatibility handling. If the timeout duration is not set, set it to the default value of 5000.
+  call_template->timeout = option_->timeout == UINT32_MAX ? 5000 : option_->timeout;
+  call_template->method_desc = method_desc;
+
+  return call_template;
+}
+
 ConnectionType ServiceProxy::GetClientConnectType() {
   ConnectionType conn_type = ConnectionType::kTcpLong;
   if (option_->network == "tcp") {
@@ -468,8 +488,16 @@ TransInfo ServiceProxy::ProxyOptionToTransInfo() {
   trans_info.send_queue_capacity = option_->send_queue_capacity;
   trans_info.send_queue_timeout = option_->send_queue_timeout;
   trans_info.is_complex_conn = option_->is_conn_complex;
+  trans_info.use_shm = option_->network == "shm";
   trans_info.support_pipeline = option_->support_pipeline;
   trans_info.fiber_pipeline_connector_queue_size = option_->fiber_pipeline_connector_queue_size;
+  trans_info.udp_batch_size = option_->udp_batch_size;
+  trans_info.udp_batch_max_delay_us = option_->udp_batch_max_delay_us;
+  trans_info.conn_egress_rate_limit = option_->conn_egress_rate_limit;
+  if (option_->egress_rate_limit != 0) {
+    trans_info.egress_bucket = std::make_shared<TokenBucket>(option_->egress_rate_limit);
+  }
+  trans_info.conn_scale_load_threshold = option_->conn_scale_load_threshold;
   trans_info.protocol = option_->codec_name;
   trans_info.fiber_connpool_shards = option_->fiber_connpool_shards;
   trans_info.endpoint_hash_bucket_size = option_->endpoint_hash_bucket_size;
@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/client/call_template.h"
 #include "trpc/client/client_context.h"
 #include "trpc/client/service_proxy_option.h"
 #include "trpc/codec/client_codec.h"
@@ -57,6 +58,15 @@ class ServiceProxy {
   /// @note It only completes request sending without waiting for response.
   Status OnewayInvoke(const ClientContextPtr& context, const ProtocolPtr& req);
 
+  /// @brief Resolve the per-method invariants of the calls to `func_name` once, used with
+  ///        `MakeClientContext(proxy, call_template)` for methods which are called repeatedly (thread-safe).
+  /// @param func_name The function name of the remote service, eg: /trpc.test.helloworld.Greeter/SayHello
+  /// @param method_desc Method descriptor used internally within protobuf, may be nullptr.
+  /// @return The immutable call template, which can be shared by multiple threads.
+  /// @note The call template refers to the option of service proxy, it must be prepared again after the option of
+  ///       service proxy is changed.
+  CallTemplatePtr PrepareCall(std::string func_name, const google::protobuf::MethodDescriptor* method_desc = nullptr);
+
   /// @brief Get option of service proxy (thread-safe).
   const ServiceProxyOption* GetServiceProxyOption() { return option_.get(); }
   ServiceProxyOption* GetMutableServiceProxyOption() { return option_.get(); }
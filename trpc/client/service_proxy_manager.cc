@@ -17,6 +17,15 @@
 
 namespace trpc {
 
+bool ServiceProxyManager::GetProxyConfig(const std::string& name, ServiceProxyConfig& proxy_conf, bool& configured) {
+  configured = TrpcConfig::GetInstance()->GetClientServiceConfig(name, proxy_conf);
+  if (!configured && TrpcConfig::GetInstance()->HasClientServiceConfig(name)) {
+    TRPC_FMT_CRITICAL("GetProxy failed, the config of client service {} is malformed.", name);
+    return false;
+  }
+  return true;
+}
+
 void ServiceProxyManager::SetOptionFromConfig(const ServiceProxyConfig& proxy_conf,
                                               std::shared_ptr<ServiceProxyOption>& option) {
   option->codec_name = proxy_conf.protocol;
@@ -52,6 +61,11 @@ void ServiceProxyManager::SetOptionFromConfig(const ServiceProxyConfig& proxy_co
   option->ssl_config = proxy_conf.ssl_config;
   option->support_pipeline = proxy_conf.support_pipeline;
   option->fiber_pipeline_connector_queue_size = proxy_conf.fiber_pipeline_connector_queue_size;
+  option->udp_batch_size = proxy_conf.udp_batch_size;
+  option->udp_batch_max_delay_us = proxy_conf.udp_batch_max_delay_us;
+  option->conn_egress_rate_limit = proxy_conf.conn_egress_rate_limit;
+  option->egress_rate_limit = proxy_conf.egress_rate_limit;
+  option->conn_scale_load_threshold = proxy_conf.conn_scale_load_threshold;
   option->fiber_connpool_shards = proxy_conf.fiber_connpool_shards;
 
   option->service_filter_configs = proxy_conf.service_filter_configs;
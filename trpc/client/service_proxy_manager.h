@@ -89,6 +89,9 @@ class ServiceProxyManager {
   void Destroy();
 
  private:
+  // Gets the config of the service proxy from the framework configuration, `proxy_conf` is left default if not
+  // configured. Returns false if it's configured but malformed, as the client services are decoded on first use.
+  bool GetProxyConfig(const std::string& name, ServiceProxyConfig& proxy_conf, bool& configured);
   void SetOptionFromConfig(const ServiceProxyConfig& proxy_conf, std::shared_ptr<ServiceProxyOption>& option);
   void SetOptionDefaultValue(const std::string& name, std::shared_ptr<ServiceProxyOption>& option);
 
@@ -118,18 +121,13 @@ std::shared_ptr<T> ServiceProxyManager::GetProxy(const std::string& name) {
 
   auto option = std::make_shared<ServiceProxyOption>();
 
-  const ClientConfig& conf = TrpcConfig::GetInstance()->GetClientConfig();
-
-  auto iter = std::find_if(conf.service_proxy_config.begin(), conf.service_proxy_config.end(),
-                           [&](const ServiceProxyConfig& proxy_conf) { return proxy_conf.name == name; });
-
-  if (iter != conf.service_proxy_config.end()) {
-    SetOptionFromConfig(*iter, option);
-  } else {
-    // Initialize option with default configuration.
-    ServiceProxyConfig proxy_config;
-    SetOptionFromConfig(proxy_config, option);
+  // Initialize option with default configuration if not configured.
+  ServiceProxyConfig proxy_config;
+  bool configured = false;
+  if (!GetProxyConfig(name, proxy_config, configured)) {
+    return nullptr;
   }
+  SetOptionFromConfig(proxy_config, option);
 
   SetOptionDefaultValue(name, option);
 
@@ -202,18 +200,13 @@ std::shared_ptr<T> ServiceProxyManager::GetProxy(const std::string& name,
 
   auto option = std::make_shared<ServiceProxyOption>();
 
-  const ClientConfig& conf = TrpcConfig::GetInstance()->GetClientConfig();
-
-  auto iter = std::find_if(conf.service_proxy_config.begin(), conf.service_proxy_config.end(),
-                           [&](const ServiceProxyConfig& proxy_conf) { return proxy_conf.name == name; });
-
-  if (iter != conf.service_proxy_config.end()) {
-    SetOptionFromConfig(*iter, option);
-  } else {
-    // Initialize option with default configuration.
-    ServiceProxyConfig proxy_config;
-    SetOptionFromConfig(proxy_config, option);
+  // Initialize option with default configuration if not configured.
+  ServiceProxyConfig proxy_config;
+  bool configured = false;
+  if (!GetProxyConfig(name, proxy_config, configured)) {
+    return nullptr;
   }
+  SetOptionFromConfig(proxy_config, option);
 
   SetOptionDefaultValue(name, option);
 
@@ -251,10 +244,12 @@ std::shared_ptr<T> ServiceProxyManager::GetProxy(const std::string& name, const
 
   auto option = std::make_shared<ServiceProxyOption>();
 
-  const ClientConfig& conf = TrpcConfig::GetInstance()->GetClientConfig();
-
-  auto iter = std::find_if(conf.service_proxy_config.begin(), conf.service_proxy_config.end(),
-                           [&](const ServiceProxyConfig& proxy_conf) { return proxy_conf.name == name; });
+  // Initialize option with default configuration if not configured.
+  ServiceProxyConfig proxy_config;
+  bool configured = false;
+  if (!GetProxyConfig(name, proxy_config, configured)) {
+    return nullptr;
+  }
 
   if (option_ptr) {
     // priority: interface settings > configuration file > default values
@@ -262,20 +257,14 @@ std::shared_ptr<T> ServiceProxyManager::GetProxy(const std::string& name, const
     detail::SetDefaultOption(option);
 
     // set option values from configuration file
-    if (iter != conf.service_proxy_config.end()) {
-      SetOptionFromConfig(*iter, option);
+    if (configured) {
+      SetOptionFromConfig(proxy_config, option);
     }
 
     // Set the specified non-default values in option_ptr.
     detail::SetSpecifiedOption(option_ptr, option);
   } else {
-    if (iter != conf.service_proxy_config.end()) {
-      SetOptionFromConfig(*iter, option);
-    } else {
-      // Initialize option with default configuration.
-      ServiceProxyConfig proxy_config;
-      SetOptionFromConfig(proxy_config, option);
-    }
+    SetOptionFromConfig(proxy_config, option);
   }
 
   // The name parameter of option is consistent with the name parameter of GetProxy.
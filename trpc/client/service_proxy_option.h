@@ -169,6 +169,28 @@ struct ServiceProxyOption {
   /// if memory usage high, reduce it
   uint32_t fiber_pipeline_connector_queue_size{16 * 1024};
 
+  /// The max number of datagrams sent/received by one sendmmsg/recvmmsg call of the fiber udp connection.
+  /// 1 means batching is disabled.
+  /// Note: it's supported only in Fiber mode.
+  uint32_t udp_batch_size{1};
+
+  /// The max delay in microseconds a datagram may wait for the batch to fill up. Zero means no waiting.
+  /// Note: it's supported only in Fiber mode, and ignored in the connection pool mode.
+  uint32_t udp_batch_max_delay_us{0};
+
+  /// The egress bandwidth limit(bytes per second) of each connection. Zero means not limited.
+  /// Note: it's supported only in Fiber mode(tcp).
+  uint64_t conn_egress_rate_limit{0};
+
+  /// The egress bandwidth limit(bytes per second) shared by all the connections. Zero means not limited.
+  /// Note: it's supported only in Fiber mode(tcp).
+  uint64_t egress_rate_limit{0};
+
+  /// The load(percent) of the multiplexed connections above which a new connection is opened, up to `max_conn_num`.
+  /// Zero means the connections are selected by round-robin.
+  /// Note: it's supported only in Fiber conn-complex mode of grpc.
+  uint32_t conn_scale_load_threshold{0};
+
   /// The hashmap bucket size for storing ip/port <--> Connector
   uint32_t endpoint_hash_bucket_size{kEndpointHashBucketSize};
 
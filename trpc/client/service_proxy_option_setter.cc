@@ -214,6 +214,21 @@ void SetSpecifiedOption(const ServiceProxyOption* option_ptr, const std::shared_
       GetValidInput<uint32_t>(option_ptr->fiber_pipeline_connector_queue_size, 16 * 1024);
   SetOutputByValidInput<uint32_t>(fiber_pipeline_connector_queue_size, option->fiber_pipeline_connector_queue_size);
 
+  auto udp_batch_size = GetValidInput<uint32_t>(option_ptr->udp_batch_size, 1);
+  SetOutputByValidInput<uint32_t>(udp_batch_size, option->udp_batch_size);
+
+  auto udp_batch_max_delay_us = GetValidInput<uint32_t>(option_ptr->udp_batch_max_delay_us, 0);
+  SetOutputByValidInput<uint32_t>(udp_batch_max_delay_us, option->udp_batch_max_delay_us);
+
+  auto conn_egress_rate_limit = GetValidInput<uint64_t>(option_ptr->conn_egress_rate_limit, 0);
+  SetOutputByValidInput<uint64_t>(conn_egress_rate_limit, option->conn_egress_rate_limit);
+
+  auto egress_rate_limit = GetValidInput<uint64_t>(option_ptr->egress_rate_limit, 0);
+  SetOutputByValidInput<uint64_t>(egress_rate_limit, option->egress_rate_limit);
+
+  auto conn_scale_load_threshold = GetValidInput<uint32_t>(option_ptr->conn_scale_load_threshold, 0);
+  SetOutputByValidInput<uint32_t>(conn_scale_load_threshold, option->conn_scale_load_threshold);
+
   auto fiber_connpool_shards = GetValidInput<uint32_t>(option_ptr->fiber_connpool_shards, 4);
   SetOutputByValidInput<uint32_t>(fiber_connpool_shards, option->fiber_connpool_shards);
 }
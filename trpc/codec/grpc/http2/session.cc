@@ -43,6 +43,20 @@ void Session::DeleteStream(uint32_t stream_id) {
   }
 }
 
+uint32_t Session::GetRemoteMaxConcurrentStreams() const {
+  if (!session_) {
+    return 0;
+  }
+  return nghttp2_session_get_remote_settings(session_, NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS);
+}
+
+int32_t Session::GetRemoteWindowSize() const {
+  if (!session_) {
+    return 0;
+  }
+  return nghttp2_session_get_remote_window_size(session_);
+}
+
 int Session::SignalRead(NoncontiguousBuffer* in) {
   while (!in->Empty()) {
     auto first_buffer = in->FirstContiguous();
@@ -174,6 +174,16 @@ class Session {
   // @return true if the reduction is successful; false if the window size is insufficient.
   virtual bool DecreaseRemoteWindowSize(int32_t occupy_window_size) { return false; }
 
+  // @brief Gets the number of the streams which are not closed yet.
+  std::size_t GetActiveStreamCount() const { return streams_.size(); }
+
+  // @brief Gets the SETTINGS_MAX_CONCURRENT_STREAMS of the peer, it's unlimited(0xffffffff) before the SETTINGS frame
+  // of the peer is received.
+  uint32_t GetRemoteMaxConcurrentStreams() const;
+
+  // @brief Gets the available window size for connection-level flow control of sending.
+  int32_t GetRemoteWindowSize() const;
+
   void SetOnResponseCallback(OnResponseCallback&& on_response_cb) {
     options_.on_response_cb = std::move(on_response_cb);
   }
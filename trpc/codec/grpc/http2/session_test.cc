@@ -333,6 +333,22 @@ TEST_F(Http2SessionImplTest, SubmitRequestOk) {
   ASSERT_EQ(recv_request->ToString(), send_request_str);
 }
 
+TEST_F(Http2SessionImplTest, StreamMetrics) {
+  ASSERT_TRUE(Http2Handshake());
+  ASSERT_EQ(client_session_->GetRemoteMaxConcurrentStreams(), http2::Session::Http2Settings().max_concurrent_streams);
+  ASSERT_GT(client_session_->GetRemoteWindowSize(), 0);
+
+  auto send_request = CreateHttp2Request();
+  ASSERT_TRUE(SubmitRequest(send_request));
+  ASSERT_EQ(client_session_->GetActiveStreamCount(), 1);
+
+  ASSERT_EQ(request_recv_queue_.size(), 1);
+  auto send_response = CreateHttp2Response();
+  send_response->SetStreamId(request_recv_queue_.front()->GetStreamId());
+  ASSERT_TRUE(SubmitResponse(send_response));
+  ASSERT_EQ(client_session_->GetActiveStreamCount(), 0);
+}
+
 TEST_F(Http2SessionImplTest, SubmitResponseOk) { TestSubmitResponseOrInStreamWayOk(false); }
 
 TEST_F(Http2SessionImplTest, SubmitResponseInStreamWayOk) { TestSubmitResponseOrInStreamWayOk(true); }
@@ -21,6 +21,7 @@
 
 #include "picohttpparser.h"
 
+#include "trpc/codec/http/http_stream_parser.h"
 #include "trpc/util/http/response.h"
 #include "trpc/util/http/stream/http_client_stream_response.h"
 
@@ -34,7 +35,7 @@ struct InflightHttpResponse {
   size_t max_packet_size{0};
   bool new_request{true};
   bool is_chunked{false};
-  phr_chunked_decoder chunk_decoder{};
+  stream::HttpChunkedDecoder chunk_decoder;
 };
 using InflightHttpResponsePtr = std::shared_ptr<InflightHttpResponse>;
 
@@ -121,10 +122,7 @@ int ParseHeader(const ConnectionPtr& conn, InflightHttpResponsePtr& inflight_res
   inflight_response->max_packet_size = max_packet_size;
   inflight_response->new_request = true;
   inflight_response->is_chunked = is_chunked;
-  inflight_response->chunk_decoder = {
-      .bytes_left_in_chunk = 0,
-      .consume_trailer = true,
-  };
+  inflight_response->chunk_decoder.Reset();
 
   return nparse;
 }
@@ -162,19 +160,15 @@ ssize_t ParseContent(const ConnectionPtr& conn, InflightHttpResponsePtr& infligh
     fully_received = (inflight_response->expect_content_bytes -= read_size) == 0;
     buffer = in.Cut(read_size);
   } else {
-    phr_chunked_decoder& decoder = inflight_response->chunk_decoder;
-    std::string in_buffer = FlattenSlow(in);
-    size_t buf_size = in_buffer.size();
-    ssize_t left = phr_decode_chunked(&decoder, in_buffer.data(), &buf_size);
-    if (left == kParserError) {
-      return left;
+    // Decodes the chunks in place, the chunk data is cut out of "in" without copying.
+    size_t in_size = in.ByteSize();
+    int ret = inflight_response->chunk_decoder.Decode(&in, &buffer);
+    if (ret == stream::kParseHttpError) {
+      return kParserError;
     }
-    fully_received = left != kParserNeedMore;
-    read_size = in_buffer.size() - std::max(left, 0l);
-    in.Skip(read_size);
-    NoncontiguousBufferBuilder builder;
-    builder.Append(in_buffer.c_str(), buf_size);
-    buffer = builder.DestructiveGet();
+
+    fully_received = ret == stream::kParseHttpSucc;
+    read_size = in_size - in.ByteSize();
   }
 
   auto p = std::any_cast<stream::HttpClientStreamResponsePtr>(&(conn->GetUserAny()));
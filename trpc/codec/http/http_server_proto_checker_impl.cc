@@ -17,6 +17,7 @@
 
 #include "picohttpparser.h"
 
+#include "trpc/codec/http/http_stream_parser.h"
 #include "trpc/transport/server/fiber/fiber_server_connection_handler_factory.h"
 #include "trpc/transport/server/fiber/fiber_server_transport_impl.h"
 #include "trpc/util/http/util.h"
@@ -33,7 +34,7 @@ struct InternalInflightHttpRequest {
   bool new_request = true;   // whether a new request? A request that has finished parsing the headers would be false.
   bool is_chunked = false;   // whether a chunked request?
   bool is_blocking = false;  // whether in the streaming blocking environment?
-  phr_chunked_decoder chunk_decoder;  // chunked decoder
+  stream::HttpChunkedDecoder chunk_decoder;  // chunked decoder
 };
 using InternalInflightHttpRequestPtr = std::shared_ptr<InternalInflightHttpRequest>;
 
@@ -111,10 +112,7 @@ int ParseHeader(const ConnectionPtr& conn, InternalInflightHttpRequestPtr& infli
   inflight_request->request->SetMaxBodySize(inflight_request->max_body_size);
   inflight_request->new_request = true;
   inflight_request->is_chunked = is_chunked;
-  inflight_request->chunk_decoder = {
-      .bytes_left_in_chunk = 0,
-      .consume_trailer = true,
-  };
+  inflight_request->chunk_decoder.Reset();
 
   return parsed_bytes;
 }
@@ -159,21 +157,15 @@ ssize_t ParseContent(const ConnectionPtr& conn, InternalInflightHttpRequestPtr&
     fully_received = (inflight_request->expect_content_bytes -= read_size) == 0;
     buffer = in.Cut(read_size);
   } else {
-    phr_chunked_decoder& decoder = inflight_request->chunk_decoder;
-    std::string in_buffer = FlattenSlow(in);
-    size_t buf_size = in_buffer.size();
-    ssize_t left = phr_decode_chunked(&decoder, in_buffer.data(), &buf_size);
-    // phr_decode_chunked return -1 when failed, -2 when request is incomplete
-    if (left == kParserError) {
-      return left;
+    // Decodes the chunks in place, the chunk data is cut out of "in" without copying.
+    size_t in_size = in.ByteSize();
+    int ret = inflight_request->chunk_decoder.Decode(&in, &buffer);
+    if (ret == stream::kParseHttpError) {
+      return kParserError;
     }
 
-    fully_received = left != kParserNeedMore;
-    read_size = in_buffer.size() - std::max(left, 0l);
-    in.Skip(read_size);
-    NoncontiguousBufferBuilder builder;
-    builder.Append(in_buffer.c_str(), buf_size);
-    buffer = builder.DestructiveGet();
+    fully_received = ret == stream::kParseHttpSucc;
+    read_size = in_size - in.ByteSize();
   }
   if (!AppendBuffer(conn, inflight_request, std::move(buffer), fully_received)) {
     return kParserError;
@@ -13,9 +13,9 @@
 
 #include "trpc/codec/http/http_stream_parser.h"
 
+#include <algorithm>
 #include <optional>
 
-#include "trpc/util/buffer/noncontiguous_buffer_view.h"
 #include "trpc/util/http/common.h"
 #include "trpc/util/http/util.h"
 #include "trpc/util/log/logging.h"
@@ -131,13 +131,6 @@ int ParseHttpTrailer(const NoncontiguousBuffer& in, http::HttpHeader* out) {
 
 namespace {
 
-enum {
-  CHUNKED_IN_CHUNK_SIZE,
-  CHUNKED_IN_CHUNK_EXT,
-  CHUNKED_IN_CHUNK_DATA,
-  CHUNKED_IN_CHUNK_CRLF,
-};
-
 static int DecodeHex(int ch) {
   if ('0' <= ch && ch <= '9') {
     return ch - '0';
@@ -152,89 +145,91 @@ static int DecodeHex(int ch) {
 
 }  // namespace
 
-int ParseHttpChunk(NoncontiguousBuffer* in, NoncontiguousBuffer* out) {
-  trpc::detail::NoncontiguousBufferView bytes(*in);
-  auto buf_start = bytes.begin();
-  auto buf_end = bytes.end();
-  auto buf = bytes.begin();
-
-  char state = CHUNKED_IN_CHUNK_SIZE;
-  int hex_count = 0;
-  size_t chunk_size = 0;
-  size_t ext_size = 0;
-
-  switch (state) {
-    case CHUNKED_IN_CHUNK_SIZE:
-      for (;; ++buf) {
-        if (buf == buf_end) {
-          return kParseHttpNeedMore;
-        }
-        int v;
-        if ((v = DecodeHex(*buf)) == -1) {
-          if (hex_count == 0) {
-            return kParseHttpError;
-          }
-          break;
-        }
-        if (hex_count == sizeof(size_t) * 2) {
-          return kParseHttpError;
+int HttpChunkedDecoder::Decode(NoncontiguousBuffer* in, NoncontiguousBuffer* out) {
+  while (state_ != State::kDone && !in->Empty()) {
+    if (state_ == State::kChunkData) {
+      size_t size = std::min(bytes_left_in_chunk_, in->ByteSize());
+      out->Append(in->Cut(size));
+      bytes_left_in_chunk_ -= size;
+      if (bytes_left_in_chunk_ == 0) {
+        state_ = State::kChunkCrlf;
+      }
+      continue;
+    }
+
+    // Scans the control bytes of the first block until the chunk data begins.
+    BufferView block = in->FirstContiguous();
+    size_t scanned = 0;
+    while (scanned < block.size() && state_ != State::kChunkData && state_ != State::kDone) {
+      if (!Consume(block.data()[scanned++])) {
+        return kParseHttpError;
+      }
+    }
+    in->Skip(scanned);
+  }
+
+  return state_ == State::kDone ? kParseHttpSucc : kParseHttpNeedMore;
+}
+
+void HttpChunkedDecoder::Reset() {
+  state_ = State::kChunkSize;
+  hex_count_ = 0;
+  bytes_left_in_chunk_ = 0;
+}
+
+bool HttpChunkedDecoder::Consume(char c) {
+  switch (state_) {
+    case State::kChunkSize: {
+      int v = DecodeHex(c);
+      if (v != -1) {
+        if (hex_count_ == sizeof(size_t) * 2) {
+          return false;
         }
-        chunk_size = chunk_size * 16 + v;
-        ++hex_count;
+        bytes_left_in_chunk_ = bytes_left_in_chunk_ * 16 + v;
+        ++hex_count_;
+        return true;
+      }
+      if (hex_count_ == 0) {
+        return false;
       }
-      hex_count = 0;
-      state = CHUNKED_IN_CHUNK_EXT;
+      hex_count_ = 0;
+      state_ = State::kChunkExt;
+    }
     // fallthru
-    case CHUNKED_IN_CHUNK_EXT:
+    case State::kChunkExt:
       // RFC 7230 A.2 "Line folding in chunk extensions is disallowed"
-      for (;; ++buf) {
-        if (buf == buf_end) {
-          return kParseHttpNeedMore;
-        }
-        if (*buf == '\012') {
-          break;
+      if (c == '\012') {
+        if (bytes_left_in_chunk_ != 0) {
+          state_ = State::kChunkData;
+        } else {
+          state_ = stop_at_trailer_ ? State::kDone : State::kTrailerLineHead;
         }
       }
-      ++buf;
-      ext_size = buf - buf_start;
-      if (chunk_size == 0) {
-        in->Skip(ext_size);
-        return ext_size;
+      return true;
+    case State::kChunkCrlf:
+      if (c == '\015') {
+        return true;
       }
-      state = CHUNKED_IN_CHUNK_DATA;
-    // fallthru
-    case CHUNKED_IN_CHUNK_DATA: {
-      size_t avail = buf_end - buf;
-      if (avail < chunk_size) {
-        return kParseHttpNeedMore;
+      if (c != '\012') {
+        return false;
       }
-      buf = buf + chunk_size;
-      state = CHUNKED_IN_CHUNK_CRLF;
-    }
-    // fallthru
-    case CHUNKED_IN_CHUNK_CRLF: {
-      auto crlf_buf_begin = buf;
-      for (;; ++buf) {
-        if (buf == buf_end) {
-          return kParseHttpNeedMore;
-        }
-        if (*buf != '\015') {
-          break;
-        }
+      state_ = State::kChunkSize;
+      return true;
+    case State::kTrailerLineHead:
+      if (c == '\015') {
+        return true;
       }
-      if (*buf != '\012') {
-        return kParseHttpError;
+      state_ = c == '\012' ? State::kDone : State::kTrailerLineMiddle;
+      return true;
+    case State::kTrailerLineMiddle:
+      if (c == '\012') {
+        state_ = State::kTrailerLineHead;
       }
-      ++buf;
-      in->Skip(ext_size);
-      *out = in->Cut(chunk_size);
-      in->Skip(buf - crlf_buf_begin);
-      return buf - buf_start;
-    }
+      return true;
     default:
       TRPC_ASSERT(false && "decoder is corrupt");
   }
-  return kParseHttpError;
+  return false;
 }
 
 }  // namespace trpc::stream
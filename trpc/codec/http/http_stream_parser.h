@@ -52,13 +52,48 @@ int ParseHttpHeader(const NoncontiguousBuffer& in, http::HttpHeader* out, HttpSt
 ///         or kParseHttpError will be returned.
 int ParseHttpTrailer(const NoncontiguousBuffer& in, http::HttpHeader* out);
 
-/// @brief Parses a chunk
-/// @param in the data to parse
-/// @param [out] out chunk data
-/// @return When successful, the number of bytes successfully parsed will be returned. When failed, kParseHttpNeedMore
-///         or kParseHttpError will be returned.
-/// @note After successfully parsing out the chunk, the chunk data in "in" will be transferred to "out", and there is no
-///       need to perform a Skip operation on the "in" object externally.
-int ParseHttpChunk(NoncontiguousBuffer* in, NoncontiguousBuffer* out);
+/// @brief Incremental decoder of a chunked(Transfer-Encoding: chunked) body, including the trailer.
+///        The control bytes(chunk-size lines, CRLFs and trailer) are scanned block by block in place, the chunk data is
+///        moved out with `Cut` without copying, and the decoding resumes exactly where it stopped when more data comes.
+class HttpChunkedDecoder {
+ public:
+  /// @param stop_at_trailer whether to stop right after the last chunk(chunk-size 0) line, leaving the trailer and the
+  ///        final CRLF in "in" for the caller to parse, e.g. when the trailer fields are needed
+  explicit HttpChunkedDecoder(bool stop_at_trailer = false) : stop_at_trailer_(stop_at_trailer) {}
+
+  /// @brief Decodes as much of the body in "in" as possible.
+  /// @param in the data to decode, the decoded bytes are removed from it
+  /// @param [out] out the chunk data decoded is appended to it
+  /// @return kParseHttpSucc when the whole body(including the trailer unless `stop_at_trailer` is set) has been
+  ///         decoded, the bytes left in "in" belong to the trailer or the next message. kParseHttpNeedMore when all the
+  ///         bytes of "in" are consumed but the body is not completed yet. kParseHttpError when the body is malformed.
+  int Decode(NoncontiguousBuffer* in, NoncontiguousBuffer* out);
+
+  /// @brief Resets the decoder to decode a new body.
+  void Reset();
+
+  /// @brief Whether the whole body has been decoded.
+  bool IsDone() const { return state_ == State::kDone; }
+
+ private:
+  enum class State : uint8_t {
+    kChunkSize,
+    kChunkExt,
+    kChunkData,
+    kChunkCrlf,
+    kTrailerLineHead,
+    kTrailerLineMiddle,
+    kDone,
+  };
+
+  // Consumes one control byte, returns false if it's malformed.
+  bool Consume(char c);
+
+ private:
+  bool stop_at_trailer_{false};
+  State state_{State::kChunkSize};
+  int hex_count_{0};
+  size_t bytes_left_in_chunk_{0};
+};
 
 }  // namespace trpc::stream
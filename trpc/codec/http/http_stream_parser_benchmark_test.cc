@@ -0,0 +1,71 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+// Measures the throughput of decoding a long-lived chunked stream, not a part of the default test targets as it
+// decodes 64MB per chunk size.
+// Run it with: bazel test //trpc/codec/http:http_stream_parser_benchmark_test --test_output=all
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/http/http_stream_parser.h"
+
+namespace trpc::testing {
+
+using namespace trpc::stream;
+
+// Decodes a long-lived chunked stream which arrives 64KB at a time.
+void DecodeThroughput(size_t chunk_size, size_t total_size) {
+  char chunk_header[32];
+  snprintf(chunk_header, sizeof(chunk_header), "%zx\r\n", chunk_size);
+  std::string chunk = chunk_header + std::string(chunk_size, 'x') + "\r\n";
+  NoncontiguousBufferBuilder builder;
+  for (size_t i = 0; i < total_size / chunk_size; ++i) {
+    builder.Append(chunk);
+  }
+  builder.Append("0\r\n\r\n");
+  NoncontiguousBuffer stream = builder.DestructiveGet();
+
+  HttpChunkedDecoder decoder;
+  NoncontiguousBuffer in;
+  size_t decoded = 0;
+  int ret = kParseHttpNeedMore;
+  auto begin = std::chrono::steady_clock::now();
+  while (!stream.Empty()) {
+    in.Append(stream.Cut(std::min<size_t>(64 * 1024, stream.ByteSize())));
+    NoncontiguousBuffer out;
+    ret = decoder.Decode(&in, &out);
+    ASSERT_NE(kParseHttpError, ret);
+    decoded += out.ByteSize();
+  }
+  auto cost_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+
+  ASSERT_EQ(kParseHttpSucc, ret);
+  ASSERT_EQ(total_size / chunk_size * chunk_size, decoded);
+  std::cout << "chunk size: " << chunk_size << ", decoded " << decoded << " bytes in " << cost_us << "us, "
+            << (cost_us > 0 ? decoded / cost_us : 0) << " MB/s" << std::endl;
+}
+
+/// @brief Throughput of 1KB and 1MB chunks.
+TEST(HttpChunkedDecoderBenchmark, Throughput) {
+  DecodeThroughput(1024, 64 * 1024 * 1024);
+  DecodeThroughput(1024 * 1024, 64 * 1024 * 1024);
+}
+
+}  // namespace trpc::testing
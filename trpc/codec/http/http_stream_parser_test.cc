@@ -14,6 +14,9 @@
 #include "trpc/codec/http/http_stream_parser.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -376,44 +379,119 @@ TEST(HttpStreamParserTest, TestParseHttpTrailer) {
   ASSERT_EQ(header.Get("foo"), "a");
 }
 
-void DoTestParseHttpChunk(std::string raw_data, std::vector<std::string> validate_data, ParserRetCode validate_status) {
-  int status = 0;
-  NoncontiguousBuffer in = BuildBuffer(raw_data);
-  size_t count = 0;
-  int parse_bytes_count = 0;
-  for (;; ++count) {
-    NoncontiguousBuffer out;
-    int parse_bytes = ParseHttpChunk(&in, &out);
-    if (parse_bytes < 0) {
-      status = parse_bytes;
-      break;
-    }
-    parse_bytes_count += parse_bytes;
-    if (out.Empty()) {
-      break;
+// Feeds `raw_data` to the decoder `step` bytes at a time, every piece is a separate block.
+int DecodeInPieces(const std::string& raw_data, size_t step, std::string* body, std::string* left) {
+  HttpChunkedDecoder decoder;
+  NoncontiguousBuffer in, out;
+  int ret = kParseHttpNeedMore;
+  for (size_t pos = 0; pos < raw_data.size() && ret == kParseHttpNeedMore; pos += step) {
+    in.Append(BuildBuffer(raw_data.substr(pos, step)));
+    ret = decoder.Decode(&in, &out);
+    if (ret == kParseHttpSucc) {
+      in.Append(BuildBuffer(raw_data.substr(std::min(pos + step, raw_data.size()))));
     }
-    std::string chunk = FlattenSlow(out);
-    ASSERT_EQ(chunk, validate_data[count]);
   }
+  *body = FlattenSlow(out);
+  *left = FlattenSlow(in);
+  return ret;
+}
 
-  if (validate_status == 0) {
-    ASSERT_EQ(FlattenSlow(in), "");
-    ASSERT_EQ(count, validate_data.size());
-    ASSERT_EQ(parse_bytes_count, raw_data.length());
-  } else {
-    ASSERT_EQ(status, validate_status);
+TEST(HttpChunkedDecoderTest, Decode) {
+  std::string raw_data = "6;comment=hi\r\nhello \r\nb\r\nworld hello\r\n0\r\nfoo: bar\r\n\r\nGET / HTTP/1.1\r\n";
+  for (size_t step = 1; step <= raw_data.size(); ++step) {
+    std::string body, left;
+    ASSERT_EQ(kParseHttpSucc, DecodeInPieces(raw_data, step, &body, &left)) << "step: " << step;
+    ASSERT_EQ("hello world hello", body);
+    ASSERT_EQ("GET / HTTP/1.1\r\n", left);
   }
+
+  std::string body, left;
+  ASSERT_EQ(kParseHttpSucc, DecodeInPieces("b\nhello world\n0\n\n", 3, &body, &left));
+  ASSERT_EQ("hello world", body);
+  ASSERT_EQ("", left);
 }
 
-TEST(HttpStreamParserTest, TestParseHttpChunk) {
-  DoTestParseHttpChunk("b\r\nhello world\r\n0\r\n", {"hello world"}, kParserSucc);
-  DoTestParseHttpChunk("6\r\nhello \r\n5\r\nworld\r\n0\r\n", {"hello ", "world"}, kParserSucc);
-  DoTestParseHttpChunk("6;comment=hi\r\nhello \r\n5\r\nworld\r\n0\r\n", {"hello ", "world"}, kParserSucc);
-  DoTestParseHttpChunk("b\nhello world\n0\n", {"hello world"}, kParserSucc);
-  // partial
-  DoTestParseHttpChunk("6\r\nhello \r\nffffffffffffffff\r\nabcdefg", {"hello "}, kParserNeedMore);
-  // failures
-  DoTestParseHttpChunk("6\r\nhello \r\nfffffffffffffffff\r\nabcdefg", {"hello "}, kParserError);
+TEST(HttpChunkedDecoderTest, NeedMore) {
+  std::string body, left;
+  // The trailer is not completed yet.
+  ASSERT_EQ(kParseHttpNeedMore, DecodeInPieces("5\r\nhello\r\n0\r\n", 4, &body, &left));
+  ASSERT_EQ("hello", body);
+  ASSERT_EQ("", left);
+
+  // The chunk data is emitted as soon as it arrives.
+  ASSERT_EQ(kParseHttpNeedMore, DecodeInPieces("a\r\nhello", 100, &body, &left));
+  ASSERT_EQ("hello", body);
+}
+
+TEST(HttpChunkedDecoderTest, Error) {
+  std::string body, left;
+  ASSERT_EQ(kParseHttpError, DecodeInPieces("x\r\nhello\r\n", 1, &body, &left));
+  ASSERT_EQ(kParseHttpError, DecodeInPieces("fffffffffffffffff\r\n", 4, &body, &left));
+  ASSERT_EQ(kParseHttpError, DecodeInPieces("5\r\nhelloX\r\n", 2, &body, &left));
+}
+
+TEST(HttpChunkedDecoderTest, ZeroCopy) {
+  HttpChunkedDecoder decoder;
+  NoncontiguousBuffer in = BuildBuffer("5\r\nhello\r\n0\r\n\r\n");
+  const char* data = in.FirstContiguous().data();
+
+  NoncontiguousBuffer out;
+  ASSERT_EQ(kParseHttpSucc, decoder.Decode(&in, &out));
+  ASSERT_TRUE(decoder.IsDone());
+  // The chunk data references the memory of the input.
+  ASSERT_EQ(data + 3, out.FirstContiguous().data());
+
+  decoder.Reset();
+  ASSERT_FALSE(decoder.IsDone());
+}
+
+TEST(HttpChunkedDecoderTest, StopAtTrailer) {
+  HttpChunkedDecoder decoder(true);
+  NoncontiguousBuffer in = BuildBuffer("5\r\nhel");
+  NoncontiguousBuffer out;
+  ASSERT_EQ(kParseHttpNeedMore, decoder.Decode(&in, &out));
+  in.Append(BuildBuffer("lo\r\n0\r"));
+  ASSERT_EQ(kParseHttpNeedMore, decoder.Decode(&in, &out));
+  in.Append(BuildBuffer("\nt1: v1\r\n\r\n"));
+  ASSERT_EQ(kParseHttpSucc, decoder.Decode(&in, &out));
+  ASSERT_EQ("hello", FlattenSlow(out));
+  // The trailer is left to the caller.
+  ASSERT_EQ("t1: v1\r\n\r\n", FlattenSlow(in));
+}
+
+// Decodes a chunked stream of `chunk_num` chunks which arrives `piece_size` bytes at a time, so that the chunks
+// span many pieces or many chunks share one piece.
+void DecodeStream(size_t chunk_size, size_t chunk_num, size_t piece_size) {
+  char chunk_header[32];
+  snprintf(chunk_header, sizeof(chunk_header), "%zx\r\n", chunk_size);
+  std::string chunk = chunk_header + std::string(chunk_size, 'x') + "\r\n";
+  NoncontiguousBufferBuilder builder;
+  for (size_t i = 0; i < chunk_num; ++i) {
+    builder.Append(chunk);
+  }
+  builder.Append("0\r\n\r\n");
+  NoncontiguousBuffer stream = builder.DestructiveGet();
+
+  HttpChunkedDecoder decoder;
+  NoncontiguousBuffer in;
+  size_t decoded = 0;
+  int ret = kParseHttpNeedMore;
+  while (!stream.Empty()) {
+    in.Append(stream.Cut(std::min(piece_size, stream.ByteSize())));
+    NoncontiguousBuffer out;
+    ret = decoder.Decode(&in, &out);
+    ASSERT_NE(kParseHttpError, ret);
+    decoded += out.ByteSize();
+  }
+
+  ASSERT_EQ(kParseHttpSucc, ret);
+  ASSERT_TRUE(in.Empty());
+  ASSERT_EQ(chunk_size * chunk_num, decoded);
+}
+
+TEST(HttpChunkedDecoderTest, DecodeStream) {
+  DecodeStream(1000, 100, 4096);
+  DecodeStream(256 * 1024, 2, 64 * 1024);
 }
 
 }  // namespace trpc::testing
@@ -109,6 +109,15 @@ class Protocol {
   virtual void SetFuncName(std::string func_name) { func_ = std::move(func_name); }
   virtual const std::string& GetFuncName() const { return func_; }
 
+  /// @brief Set names of caller, callee and function which are immutable and kept alive by `owner`, depends on the
+  ///        implementation of the specific protocol. By default they are copied, a protocol may refer to them instead.
+  virtual void SetSharedNames(std::shared_ptr<const void> owner, const std::string& caller_name,
+                              const std::string& callee_name, const std::string& func_name) {
+    SetCallerName(caller_name);
+    SetCalleeName(callee_name);
+    SetFuncName(func_name);
+  }
+
   /// @brief Set key-value pair, depends on the implementation of the specific protocol.
   virtual void SetKVInfo(std::string key, std::string value) { trans_info_[key] = value; }
 
@@ -23,6 +23,7 @@
 #include "trpc/serialization/serialization_factory.h"
 #include "trpc/util/buffer/zero_copy_stream.h"
 #include "trpc/util/log/logging.h"
+#include "trpc/util/object_pool/pool_allocator.h"
 
 namespace trpc {
 
@@ -46,8 +47,11 @@ void TrpcClientCodec::FillTrpcRequestHeader(const ClientContextPtr& context, Trp
   req->req_header.set_call_type(context->GetCallType());
   req->req_header.set_request_id(context->GetRequestId());
   req->req_header.set_timeout(context->GetTimeout());
-  req->req_header.set_caller(context->GetCallerName());
-  req->req_header.set_callee(context->GetCalleeName());
+  // The names are kept in the request of the context already, and may be shared with a call template.
+  if (req != context->GetRequest().get()) {
+    req->req_header.set_caller(context->GetCallerName());
+    req->req_header.set_callee(context->GetCalleeName());
+  }
   req->req_header.set_message_type(context->GetMessageType());
   req->req_header.set_content_type(context->GetReqEncodeType());
   req->req_header.set_content_encoding(context->GetReqCompressType());
@@ -149,9 +153,13 @@ bool TrpcClientCodec::FillResponse(const ClientContextPtr& context, const Protoc
   return true;
 }
 
-ProtocolPtr TrpcClientCodec::CreateRequestPtr() { return std::make_shared<TrpcRequestProtocol>(); }
+ProtocolPtr TrpcClientCodec::CreateRequestPtr() {
+  return std::allocate_shared<TrpcRequestProtocol>(object_pool::PoolAllocator<TrpcRequestProtocol>());
+}
 
-ProtocolPtr TrpcClientCodec::CreateResponsePtr() { return std::make_shared<TrpcResponseProtocol>(); }
+ProtocolPtr TrpcClientCodec::CreateResponsePtr() {
+  return std::allocate_shared<TrpcResponseProtocol>(object_pool::PoolAllocator<TrpcResponseProtocol>());
+}
 
 uint32_t TrpcClientCodec::GetSequenceId(const ProtocolPtr& rsp) const {
   auto* trpc_rsp_msg = static_cast<TrpcResponseProtocol*>(rsp.get());
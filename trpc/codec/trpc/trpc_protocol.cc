@@ -15,12 +15,39 @@
 
 #include <arpa/inet.h>
 
+#include "google/protobuf/io/coded_stream.h"
+
 #include "trpc/util/buffer/zero_copy_stream.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
 
+namespace {
+
+constexpr uint32_t kLengthDelimitedWireType = 2;
+
+// Size of a string field in protobuf wire format, empty strings are skipped as proto3 does.
+size_t NameFieldByteSize(uint32_t field_number, const std::string* name) {
+  if (name == nullptr || name->empty()) {
+    return 0;
+  }
+  using google::protobuf::io::CodedOutputStream;
+  return CodedOutputStream::VarintSize32(field_number << 3 | kLengthDelimitedWireType) +
+         CodedOutputStream::VarintSize32(name->size()) + name->size();
+}
+
+void WriteNameField(uint32_t field_number, const std::string* name, google::protobuf::io::CodedOutputStream* out) {
+  if (name == nullptr || name->empty()) {
+    return;
+  }
+  out->WriteTag(field_number << 3 | kLengthDelimitedWireType);
+  out->WriteVarint32(name->size());
+  out->WriteString(*name);
+}
+
+}  // namespace
+
 bool TrpcFixedHeader::Decode(NoncontiguousBuffer& buff, bool skip) {
   if (TRPC_UNLIKELY(buff.ByteSize() < TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE)) {
     TRPC_FMT_ERROR("buff.ByteSize:{} less than {}", buff.ByteSize(), TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE);
@@ -138,7 +165,7 @@ bool TrpcRequestProtocol::ZeroCopyDecode(NoncontiguousBuffer& buff) {
 
 bool TrpcRequestProtocol::ZeroCopyEncode(NoncontiguousBuffer& buff) {
   req_header.set_attachment_size(req_attachment.ByteSize());
-  auto pb_header_size = req_header.ByteSizeLong();
+  auto pb_header_size = req_header.ByteSizeLong() + SharedNamesByteSize();
   fixed_header.pb_header_size = pb_header_size;
   fixed_header.data_frame_size =
       TrpcFixedHeader::TRPC_PROTO_PREFIX_SPACE + pb_header_size + req_body.ByteSize() + req_attachment.ByteSize();
@@ -155,6 +182,13 @@ bool TrpcRequestProtocol::ZeroCopyEncode(NoncontiguousBuffer& buff) {
       TRPC_LOG_ERROR("Encode rsp_header error.");
       return false;
     }
+    if (shared_names_owner_ != nullptr) {
+      // Fields may appear in any order on the wire, so the shared names are appended after the other fields.
+      google::protobuf::io::CodedOutputStream out(&nbos);
+      WriteNameField(RequestProtocol::kCallerFieldNumber, shared_caller_, &out);
+      WriteNameField(RequestProtocol::kCalleeFieldNumber, shared_callee_, &out);
+      WriteNameField(RequestProtocol::kFuncFieldNumber, shared_func_, &out);
+    }
     nbos.Flush();
   }
   builder.Append(std::move(req_body));
@@ -166,6 +200,26 @@ bool TrpcRequestProtocol::ZeroCopyEncode(NoncontiguousBuffer& buff) {
   return true;
 }
 
+void TrpcRequestProtocol::SetSharedNames(std::shared_ptr<const void> owner, const std::string& caller_name,
+                                         const std::string& callee_name, const std::string& func_name) {
+  req_header.clear_caller();
+  req_header.clear_callee();
+  req_header.clear_func();
+  shared_names_owner_ = std::move(owner);
+  shared_caller_ = &caller_name;
+  shared_callee_ = &callee_name;
+  shared_func_ = &func_name;
+}
+
+size_t TrpcRequestProtocol::SharedNamesByteSize() const {
+  if (shared_names_owner_ == nullptr) {
+    return 0;
+  }
+  return NameFieldByteSize(RequestProtocol::kCallerFieldNumber, shared_caller_) +
+         NameFieldByteSize(RequestProtocol::kCalleeFieldNumber, shared_callee_) +
+         NameFieldByteSize(RequestProtocol::kFuncFieldNumber, shared_func_);
+}
+
 void TrpcRequestProtocol::SetKVInfo(std::string key, std::string value) {
   auto trans_info = req_header.mutable_trans_info();
   (*trans_info)[std::move(key)] = std::move(value);
@@ -111,16 +111,34 @@ class TrpcRequestProtocol : public Protocol {
   virtual uint32_t GetTimeout() const { return req_header.timeout(); }
 
   /// @brief Set/Get name of caller.
-  void SetCallerName(std::string caller_name) override { req_header.set_caller(std::move(caller_name)); }
-  const std::string& GetCallerName() const override { return req_header.caller(); }
+  void SetCallerName(std::string caller_name) override {
+    req_header.set_caller(std::move(caller_name));
+    shared_caller_ = nullptr;
+  }
+  const std::string& GetCallerName() const override {
+    return shared_caller_ != nullptr ? *shared_caller_ : req_header.caller();
+  }
 
   /// @brief Set/Get name of callee.
-  void SetCalleeName(std::string callee_name) override { req_header.set_callee(std::move(callee_name)); }
-  const std::string& GetCalleeName() const override { return req_header.callee(); }
+  void SetCalleeName(std::string callee_name) override {
+    req_header.set_callee(std::move(callee_name));
+    shared_callee_ = nullptr;
+  }
+  const std::string& GetCalleeName() const override {
+    return shared_callee_ != nullptr ? *shared_callee_ : req_header.callee();
+  }
 
   /// @brief  Set/Get function name of RPC.
-  void SetFuncName(std::string func_name) override { req_header.set_func(std::move(func_name)); }
-  const std::string& GetFuncName() const override { return req_header.func(); }
+  void SetFuncName(std::string func_name) override {
+    req_header.set_func(std::move(func_name));
+    shared_func_ = nullptr;
+  }
+  const std::string& GetFuncName() const override { return shared_func_ != nullptr ? *shared_func_ : req_header.func(); }
+
+  /// @brief Refer to the names instead of copying them into `req_header`, they are written to the wire directly from
+  ///        the shared strings when the request is encoded.
+  void SetSharedNames(std::shared_ptr<const void> owner, const std::string& caller_name,
+                      const std::string& callee_name, const std::string& func_name) override;
 
   /// @brief Set key-value pair (tans-info map).
   void SetKVInfo(std::string key, std::string value) override;
@@ -146,6 +164,18 @@ class TrpcRequestProtocol : public Protocol {
 
   // Content of attachment.
   NoncontiguousBuffer req_attachment;
+
+ private:
+  // Size of the shared names in the encoded `req_header`.
+  size_t SharedNamesByteSize() const;
+
+ private:
+  // Keeps the shared names alive, eg: the call template of client.
+  std::shared_ptr<const void> shared_names_owner_;
+  // The names used instead of those in `req_header` if they are not nullptr.
+  const std::string* shared_caller_{nullptr};
+  const std::string* shared_callee_{nullptr};
+  const std::string* shared_func_{nullptr};
 };
 
 /// @brief Trpc response protocol message.
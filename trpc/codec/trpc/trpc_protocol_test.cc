@@ -252,6 +252,122 @@ TEST(TrpcRequestProtocol, TrpcRequestProtocolId) {
   ASSERT_EQ(1, id_res_32);
 }
 
+namespace {
+
+// Encodes `req` with a body and decodes it back, the decoded request is only valid if the shared names are written
+// to the wire correctly.
+bool EncodeAndDecode(TrpcRequestProtocol& req, TrpcRequestProtocol& decoded) {
+  req.fixed_header.magic_value = TrpcMagic::TRPC_MAGIC_VALUE;
+  req.req_body = CreateBufferSlow("hello world");
+
+  NoncontiguousBuffer buff;
+  if (!req.ZeroCopyEncode(buff)) {
+    return false;
+  }
+  if (buff.ByteSize() != req.fixed_header.data_frame_size) {
+    return false;
+  }
+  if (!decoded.ZeroCopyDecode(buff) || buff.ByteSize() != 0) {
+    return false;
+  }
+  return FlattenSlow(decoded.req_body) == "hello world";
+}
+
+}  // namespace
+
+TEST(TrpcRequestProtocol, SharedNamesEncodeAndDecode) {
+  auto owner = std::make_shared<std::string>("owner");
+  std::string caller("test_client");
+  std::string callee("trpc.test.helloworld.Greeter");
+  std::string func("/trpc.test.helloworld.Greeter/SayHello");
+
+  TrpcRequestProtocol req;
+  req.SetRequestId(1);
+  req.SetTimeout(1000);
+  req.SetSharedNames(owner, caller, callee, func);
+  ASSERT_EQ(caller, req.GetCallerName());
+  ASSERT_EQ(callee, req.GetCalleeName());
+  ASSERT_EQ(func, req.GetFuncName());
+  // The names are referred to rather than copied into the header.
+  ASSERT_TRUE(req.req_header.caller().empty());
+
+  TrpcRequestProtocol decoded;
+  ASSERT_TRUE(EncodeAndDecode(req, decoded));
+  ASSERT_EQ(caller, decoded.GetCallerName());
+  ASSERT_EQ(callee, decoded.GetCalleeName());
+  ASSERT_EQ(func, decoded.GetFuncName());
+  ASSERT_EQ(1, decoded.req_header.request_id());
+  ASSERT_EQ(1000, decoded.GetTimeout());
+}
+
+TEST(TrpcRequestProtocol, SharedNamesEmpty) {
+  auto owner = std::make_shared<std::string>("owner");
+  std::string empty;
+  std::string func("/trpc.test.helloworld.Greeter/SayHello");
+
+  TrpcRequestProtocol req;
+  req.SetRequestId(1);
+  req.SetSharedNames(owner, empty, empty, func);
+
+  TrpcRequestProtocol decoded;
+  ASSERT_TRUE(EncodeAndDecode(req, decoded));
+  ASSERT_TRUE(decoded.GetCallerName().empty());
+  ASSERT_TRUE(decoded.GetCalleeName().empty());
+  ASSERT_EQ(func, decoded.GetFuncName());
+
+  // Same size as the header with the names set, in which empty strings are skipped as well.
+  TrpcRequestProtocol copied;
+  copied.SetRequestId(1);
+  copied.SetFuncName(func);
+  ASSERT_EQ(copied.req_header.ByteSizeLong(), decoded.fixed_header.pb_header_size);
+}
+
+TEST(TrpcRequestProtocol, SharedNamesLongerThanOneByteVarint) {
+  auto owner = std::make_shared<std::string>("owner");
+  // The lengths take two and three bytes of varint.
+  std::string caller(128, 'a');
+  std::string callee(300, 'b');
+  std::string func(20000, 'c');
+
+  TrpcRequestProtocol req;
+  req.SetRequestId(1);
+  req.SetSharedNames(owner, caller, callee, func);
+
+  TrpcRequestProtocol decoded;
+  ASSERT_TRUE(EncodeAndDecode(req, decoded));
+  ASSERT_EQ(caller, decoded.GetCallerName());
+  ASSERT_EQ(callee, decoded.GetCalleeName());
+  ASSERT_EQ(func, decoded.GetFuncName());
+}
+
+TEST(TrpcRequestProtocol, SharedNamesWithExplicitFields) {
+  auto owner = std::make_shared<std::string>("owner");
+  std::string caller("test_client");
+  std::string callee("trpc.test.helloworld.Greeter");
+  std::string func("/trpc.test.helloworld.Greeter/SayHello");
+
+  TrpcRequestProtocol req;
+  req.SetSharedNames(owner, caller, callee, func);
+  // The explicitly set name takes the place of the shared one.
+  req.SetCallerName("explicit_client");
+  req.SetRequestId(1);
+  req.SetTimeout(1000);
+  req.SetKVInfo("key", "value");
+  req.req_header.set_call_type(1);
+  req.req_attachment = CreateBufferSlow("test attachment");
+
+  TrpcRequestProtocol decoded;
+  ASSERT_TRUE(EncodeAndDecode(req, decoded));
+  ASSERT_EQ("explicit_client", decoded.GetCallerName());
+  ASSERT_EQ(callee, decoded.GetCalleeName());
+  ASSERT_EQ(func, decoded.GetFuncName());
+  ASSERT_EQ(1, decoded.req_header.request_id());
+  ASSERT_EQ(1000, decoded.GetTimeout());
+  ASSERT_EQ(1, decoded.req_header.call_type());
+  ASSERT_EQ("value", decoded.req_header.trans_info().at("key"));
+  ASSERT_EQ("test attachment", FlattenSlow(decoded.req_attachment));
+}
+
 size_t FillTrpcResponseProtocolDataWithoutAttachment(TrpcResponseProtocol& rsp) {
   rsp.fixed_header.magic_value = TrpcMagic::TRPC_MAGIC_VALUE;
   rsp.fixed_header.data_frame_type = 0;
@@ -54,6 +54,11 @@ void ServiceProxyConfig::Display() const {
   TRPC_LOG_DEBUG("idle_time:" << idle_time);
   TRPC_LOG_DEBUG("threadmodel_instance_name:" << threadmodel_instance_name);
   TRPC_LOG_DEBUG("support_pipeline:" << support_pipeline);
+  TRPC_LOG_DEBUG("udp_batch_size:" << udp_batch_size);
+  TRPC_LOG_DEBUG("udp_batch_max_delay_us:" << udp_batch_max_delay_us);
+  TRPC_LOG_DEBUG("conn_egress_rate_limit:" << conn_egress_rate_limit);
+  TRPC_LOG_DEBUG("egress_rate_limit:" << egress_rate_limit);
+  TRPC_LOG_DEBUG("conn_scale_load_threshold:" << conn_scale_load_threshold);
 
   if (redis_conf.enable) {
     redis_conf.Display();
@@ -67,6 +72,10 @@ void ServiceProxyConfig::Display() const {
     if (iter != service_filter_configs.end()) {
       std::any_cast<RetryHedgingLimitConfig>(iter->second).Display();
     }
+    iter = service_filter_configs.find(kRetryBudgetFilter);
+    if (iter != service_filter_configs.end()) {
+      std::any_cast<RetryBudgetConfig>(iter->second).Display();
+    }
   }
 
   TRPC_LOG_DEBUG("--------------------------------");
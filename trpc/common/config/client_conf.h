@@ -66,6 +66,29 @@ struct ServiceProxyConfig {
   /// if memory usage high, reduce it
   uint32_t fiber_pipeline_connector_queue_size = 16 * 1024;
 
+  /// The max number of datagrams sent by one sendmmsg/recvmmsg call of the fiber udp connection
+  /// If set 1, batching is disabled
+  uint32_t udp_batch_size{1};
+
+  /// The max delay(us) a datagram may wait for the batch to fill up before being flushed
+  /// If set 0, the datagrams queued at the moment are flushed immediately
+  /// Ignored in the connection pool mode, where a connection carries one request at a time
+  uint32_t udp_batch_max_delay_us{0};
+
+  /// The egress bandwidth limit(bytes per second) of each connection of the fiber tcp connection
+  /// If set 0, not limited
+  uint64_t conn_egress_rate_limit{0};
+
+  /// The egress bandwidth limit(bytes per second) shared by all the fiber tcp connections of the service
+  /// If set 0, not limited
+  uint64_t egress_rate_limit{0};
+
+  /// The load(percent of the active streams to the max concurrent streams of the peer) of the multiplexed
+  /// connections above which a new connection is opened, up to `max_conn_num`. Used in fiber conn-complex mode
+  /// of the stream multiplexing protocols(eg: grpc).
+  /// If set 0, the connections are selected by round-robin
+  uint32_t conn_scale_load_threshold{0};
+
   /// The timeout(ms) of check connection establishment
   /// If set 0, not check
   uint32_t connect_timeout{kDefaultConnectTimeout};
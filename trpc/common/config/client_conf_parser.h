@@ -35,6 +35,11 @@ struct convert<trpc::ServiceProxyConfig> {
     node["is_conn_complex"] = proxy_config.is_conn_complex;
     node["support_pipeline"] = proxy_config.support_pipeline;
     node["fiber_pipeline_connector_queue_size"] = proxy_config.fiber_pipeline_connector_queue_size;
+    node["udp_batch_size"] = proxy_config.udp_batch_size;
+    node["udp_batch_max_delay_us"] = proxy_config.udp_batch_max_delay_us;
+    node["conn_egress_rate_limit"] = proxy_config.conn_egress_rate_limit;
+    node["egress_rate_limit"] = proxy_config.egress_rate_limit;
+    node["conn_scale_load_threshold"] = proxy_config.conn_scale_load_threshold;
     node["connect_timeout"] = proxy_config.connect_timeout;
     node["timeout"] = proxy_config.timeout;
     node["request_timeout_check_interval"] = proxy_config.request_timeout_check_interval;
@@ -64,6 +69,10 @@ struct convert<trpc::ServiceProxyConfig> {
     if (iter != filter_configs.end()) {
       node["filter_config"][iter->first] = std::any_cast<trpc::RetryHedgingLimitConfig>(iter->second);
     }
+    iter = filter_configs.find(trpc::kRetryBudgetFilter);
+    if (iter != filter_configs.end()) {
+      node["filter_config"][iter->first] = std::any_cast<trpc::RetryBudgetConfig>(iter->second);
+    }
 
     node["ssl"] = proxy_config.ssl_config;
 
@@ -89,6 +98,20 @@ struct convert<trpc::ServiceProxyConfig> {
       auto queue_size = node["fiber_pipeline_connector_queue_size"].as<uint32_t>();
       proxy_config.fiber_pipeline_connector_queue_size = queue_size > 0 ? queue_size : 16 * 1024;
     }
+    if (node["udp_batch_size"]) {
+      auto batch_size = node["udp_batch_size"].as<uint32_t>();
+      proxy_config.udp_batch_size = batch_size > 0 ? batch_size : 1;
+    }
+    if (node["udp_batch_max_delay_us"]) {
+      proxy_config.udp_batch_max_delay_us = node["udp_batch_max_delay_us"].as<uint32_t>();
+    }
+    if (node["conn_egress_rate_limit"]) {
+      proxy_config.conn_egress_rate_limit = node["conn_egress_rate_limit"].as<uint64_t>();
+    }
+    if (node["egress_rate_limit"]) proxy_config.egress_rate_limit = node["egress_rate_limit"].as<uint64_t>();
+    if (node["conn_scale_load_threshold"]) {
+      proxy_config.conn_scale_load_threshold = node["conn_scale_load_threshold"].as<uint32_t>();
+    }
     if (node["connect_timeout"]) proxy_config.connect_timeout = node["connect_timeout"].as<uint32_t>();
     if (node["timeout"]) proxy_config.timeout = node["timeout"].as<uint32_t>();
     if (node["request_timeout_check_interval"]) {
@@ -132,6 +155,10 @@ struct convert<trpc::ServiceProxyConfig> {
             node["filter_config"][trpc::kRetryHedgingLimitFilter].as<trpc::RetryHedgingLimitConfig>();
         proxy_config.service_filter_configs[trpc::kRetryHedgingLimitFilter] = retry_hedging_config;
       }
+      if (node["filter_config"][trpc::kRetryBudgetFilter]) {
+        auto retry_budget_config = node["filter_config"][trpc::kRetryBudgetFilter].as<trpc::RetryBudgetConfig>();
+        proxy_config.service_filter_configs[trpc::kRetryBudgetFilter] = retry_budget_config;
+      }
     }
 
     if (node["redis"]) {
@@ -55,12 +55,19 @@ TEST(ClientConfigTest, All) {
 
   proxy_config.redis_conf.password = "my_redis";
   proxy_config.redis_conf.enable = true;
+  proxy_config.redis_conf.near_cache.enable = true;
+  proxy_config.redis_conf.near_cache.mode = "broadcast";
+  proxy_config.redis_conf.near_cache.prefixes = {"user:"};
 
   RetryHedgingLimitConfig retry_hedging_config;
   retry_hedging_config.max_tokens = 10;
 
   proxy_config.service_filter_configs[kRetryHedgingLimitFilter] = retry_hedging_config;
 
+  RetryBudgetConfig retry_budget_config;
+  retry_budget_config.retry_ratio = 0.2;
+  proxy_config.service_filter_configs[kRetryBudgetFilter] = retry_budget_config;
+
   client_config.filters = {"tpstelemetry"};
   client_config.service_proxy_config.push_back(proxy_config);
 
@@ -107,12 +114,27 @@ TEST(ClientConfigTest, All) {
   ASSERT_EQ(proxy_config.redis_conf.enable, tmp_proxy_config.redis_conf.enable);
   ASSERT_EQ(proxy_config.redis_conf.user_name, tmp_proxy_config.redis_conf.user_name);
   ASSERT_EQ(proxy_config.redis_conf.password, tmp_proxy_config.redis_conf.password);
+  ASSERT_TRUE(tmp_proxy_config.redis_conf.near_cache.enable);
+  ASSERT_EQ(proxy_config.redis_conf.near_cache.mode, tmp_proxy_config.redis_conf.near_cache.mode);
+  ASSERT_EQ(proxy_config.redis_conf.near_cache.prefixes, tmp_proxy_config.redis_conf.near_cache.prefixes);
 
   auto tmp_retry_hedging_config = std::any_cast<RetryHedgingLimitConfig>(
       tmp_proxy_config.service_filter_configs[kRetryHedgingLimitFilter]);
   ASSERT_EQ(retry_hedging_config.max_tokens, tmp_retry_hedging_config.max_tokens);
 
+  auto tmp_retry_budget_config =
+      std::any_cast<RetryBudgetConfig>(tmp_proxy_config.service_filter_configs[kRetryBudgetFilter]);
+  ASSERT_DOUBLE_EQ(retry_budget_config.retry_ratio, tmp_retry_budget_config.retry_ratio);
+
   ASSERT_EQ(client_config.filters[0], tmp_client_config.filters[0]);
 }
 
+TEST(ClientConfigTest, UnknownNearCacheMode) {
+  YAML::Node node = YAML::Load("enable: true\nmode: bcast\n");
+  ASSERT_THROW(node.as<RedisNearCacheConf>(), YAML::Exception);
+
+  node = YAML::Load("enable: true\nmode: broadcast\nprefixes: [\"user:\"]\n");
+  ASSERT_EQ("broadcast", node.as<RedisNearCacheConf>().mode);
+}
+
 }  // namespace trpc::testing
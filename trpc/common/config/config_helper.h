@@ -36,6 +36,11 @@ class ConfigHelper {
   /// @param config_path absolute path of yaml file
   bool Init(const std::string& config_path);
 
+  /// @brief Set the directory of the config snapshots, `Init` loads the config from its snapshot there if the content
+  ///        is unchanged, otherwise parses the config and saves the snapshot. If empty(default), no snapshot is used.
+  /// @note  It should be called before `Init`.
+  void SetSnapshotDir(const std::string& snapshot_dir) { snapshot_dir_ = snapshot_dir; }
+
   /// @brief Reset config patch.
   void ResetConfigPath(const std::string& config_path) { conf_path_ = config_path; }
 
@@ -141,6 +146,9 @@ class ConfigHelper {
   // after initiation, store the path for reloading
   std::string conf_path_;
 
+  // the directory of the config snapshots
+  std::string snapshot_dir_;
+
   // store the config update callbacks
   std::map<std::string, std::function<void(const YAML::Node&)>> update_notifiers_;
 };
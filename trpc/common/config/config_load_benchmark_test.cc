@@ -0,0 +1,113 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+// Measures the loading time of a mesh config with thousands of client services, not a part of the default test
+// targets as the result depends on the machine.
+// Run it with: bazel test //trpc/common/config:config_load_benchmark_test --test_output=all
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "yaml-cpp/yaml.h"
+
+#include "trpc/common/config/config_snapshot.h"
+#include "trpc/common/config/trpc_config.h"
+
+namespace trpc::testing {
+
+namespace {
+
+// A mesh config with `n` client services.
+std::string MakeLargeConfig(int n) {
+  std::string content = "global:\n  threadmodel:\n    fiber:\n      - instance_name: fiber_instance\nclient:\n";
+  content += "  filter:\n    - client_filter\n  service:\n";
+  for (int i = 0; i < n; ++i) {
+    auto name = "trpc.test.helloworld.Greeter" + std::to_string(i);
+    content += "    - name: " + name + "\n";
+    content += "      target: " + name + "\n";
+    content += "      namespace: Production\n";
+    content += "      protocol: trpc\n";
+    content += "      timeout: " + std::to_string(1000 + i) + "\n";
+    content += "      network: tcp\n";
+    content += "      conn_type: long\n";
+    content += "      selector_name: polaris\n";
+    content += "      filter:\n        - tpstelemetry\n        - prometheus\n";
+  }
+  return content;
+}
+
+int64_t ElapsedUs(std::chrono::steady_clock::time_point begin) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+}  // namespace
+
+TEST(ConfigLoadBenchmark, Snapshot) {
+  auto content = MakeLargeConfig(5000);
+
+  auto begin = std::chrono::steady_clock::now();
+  YAML::Node root = YAML::Load(content);
+  auto parse_us = ElapsedUs(begin);
+
+  uint64_t hash = ConfigSnapshot::Hash(content);
+  auto data = ConfigSnapshot::Encode(hash, root);
+
+  begin = std::chrono::steady_clock::now();
+  YAML::Node decoded;
+  ASSERT_TRUE(ConfigSnapshot::Decode(data, ConfigSnapshot::Hash(content), decoded));
+  auto decode_us = ElapsedUs(begin);
+
+  ASSERT_EQ(5000, decoded["client"]["service"].size());
+  std::cout << "yaml size: " << content.size() << ", snapshot size: " << data.size() << ", parse: " << parse_us
+            << "us, decode snapshot(with hash): " << decode_us << "us" << std::endl;
+}
+
+TEST(ConfigLoadBenchmark, TrpcConfigInit) {
+  constexpr int kServiceNum = 2000;
+  std::string path1 = "./config_load_benchmark_test1.yaml";
+  std::string path2 = "./config_load_benchmark_test2.yaml";
+  auto content = MakeLargeConfig(kServiceNum);
+  std::ofstream(path1) << content;
+  std::ofstream(path2) << content;
+
+  trpc::TrpcConfig* trpc_config = trpc::TrpcConfig::GetInstance();
+  trpc_config->SetSnapshotDir(".");
+
+  // Parses the config and saves the snapshot.
+  auto begin = std::chrono::steady_clock::now();
+  ASSERT_EQ(trpc_config->Init(path1), 0);
+  auto parse_us = ElapsedUs(begin);
+
+  begin = std::chrono::steady_clock::now();
+  ASSERT_EQ(kServiceNum, trpc_config->GetClientConfig().service_proxy_config.size());
+  auto decode_us = ElapsedUs(begin);
+
+  // Loads from the snapshot.
+  begin = std::chrono::steady_clock::now();
+  ASSERT_EQ(trpc_config->Init(path2), 0);
+  auto load_us = ElapsedUs(begin);
+
+  std::cout << "init by parsing: " << parse_us << "us, init from snapshot: " << load_us << "us, decode "
+            << kServiceNum << " client services: " << decode_us << "us" << std::endl;
+
+  trpc_config->SetSnapshotDir("");
+  std::remove(ConfigSnapshot::GetPath(".", ConfigSnapshot::Hash(content)).c_str());
+  std::remove(path1.c_str());
+  std::remove(path2.c_str());
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,256 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/config/config_snapshot.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace trpc {
+
+namespace {
+
+constexpr std::string_view kMagic{"TRPCCFG\x01", 8};
+
+enum NodeTag : uint8_t {
+  kNull = 0,
+  kScalar = 1,
+  kSequence = 2,
+  kMap = 3,
+};
+
+void PutVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void PutFixed64(uint64_t value, std::string* out) {
+  for (int i = 0; i < 8; ++i) {
+    out->push_back(static_cast<char>(value >> (8 * i)));
+  }
+}
+
+void EncodeNode(const YAML::Node& node, std::string* out) {
+  switch (node.Type()) {
+    case YAML::NodeType::Scalar:
+      out->push_back(kScalar);
+      PutVarint(node.Scalar().size(), out);
+      out->append(node.Scalar());
+      break;
+    case YAML::NodeType::Sequence:
+      out->push_back(kSequence);
+      PutVarint(node.size(), out);
+      for (const auto& child : node) {
+        EncodeNode(child, out);
+      }
+      break;
+    case YAML::NodeType::Map:
+      out->push_back(kMap);
+      PutVarint(node.size(), out);
+      for (const auto& kv : node) {
+        EncodeNode(kv.first, out);
+        EncodeNode(kv.second, out);
+      }
+      break;
+    default:
+      out->push_back(kNull);
+      break;
+  }
+}
+
+class Reader {
+ public:
+  explicit Reader(std::string_view data) : data_(data) {}
+
+  bool GetVarint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64 && pos_ < data_.size(); shift += 7) {
+      uint8_t byte = data_[pos_++];
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool GetFixed64(uint64_t* value) {
+    if (data_.size() - pos_ < 8) {
+      return false;
+    }
+    *value = 0;
+    for (int i = 0; i < 8; ++i) {
+      *value |= static_cast<uint64_t>(static_cast<uint8_t>(data_[pos_++])) << (8 * i);
+    }
+    return true;
+  }
+
+  bool GetBytes(uint64_t size, std::string_view* bytes) {
+    if (data_.size() - pos_ < size) {
+      return false;
+    }
+    *bytes = data_.substr(pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  // Decodes into `node` in place, so that all the nodes of the tree share one memory instead of merging the memory of
+  // each child into its parent's.
+  bool GetNode(YAML::Node& node, int depth) {
+    // Guards the stack against malformed data.
+    if (depth > 256 || pos_ >= data_.size()) {
+      return false;
+    }
+
+    uint8_t tag = data_[pos_++];
+    uint64_t size = 0;
+    switch (tag) {
+      case kNull:
+        node = YAML::Null;
+        return true;
+      case kScalar: {
+        std::string_view scalar;
+        if (!GetVarint(&size) || !GetBytes(size, &scalar)) {
+          return false;
+        }
+        node = std::string(scalar);
+        return true;
+      }
+      case kSequence:
+        if (!GetVarint(&size) || size > data_.size() - pos_) {
+          return false;
+        }
+        node = YAML::Node(YAML::NodeType::Sequence);
+        for (uint64_t i = 0; i < size; ++i) {
+          node.push_back(YAML::Null);
+          YAML::Node child = node[i];
+          if (!GetNode(child, depth + 1)) {
+            return false;
+          }
+        }
+        return true;
+      case kMap:
+        if (!GetVarint(&size) || size > data_.size() - pos_) {
+          return false;
+        }
+        node = YAML::Node(YAML::NodeType::Map);
+        for (uint64_t i = 0; i < size; ++i) {
+          YAML::Node key;
+          if (!GetNode(key, depth + 1)) {
+            return false;
+          }
+          YAML::Node value = node[key];
+          if (!GetNode(value, depth + 1)) {
+            return false;
+          }
+        }
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool Done() const { return pos_ == data_.size(); }
+
+ private:
+  std::string_view data_;
+  std::size_t pos_{0};
+};
+
+}  // namespace
+
+uint64_t ConfigSnapshot::Hash(std::string_view content) {
+  // FNV-1a, stable across builds and platforms.
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : content) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::string ConfigSnapshot::Encode(uint64_t hash, const YAML::Node& root) {
+  std::string out;
+  out.append(kMagic);
+  PutFixed64(hash, &out);
+  EncodeNode(root, &out);
+  return out;
+}
+
+bool ConfigSnapshot::Decode(std::string_view data, uint64_t hash, YAML::Node& root) {
+  if (data.substr(0, kMagic.size()) != kMagic) {
+    return false;
+  }
+
+  Reader reader(data.substr(kMagic.size()));
+  uint64_t snapshot_hash = 0;
+  if (!reader.GetFixed64(&snapshot_hash) || snapshot_hash != hash) {
+    return false;
+  }
+
+  YAML::Node node;
+  if (!reader.GetNode(node, 0) || !reader.Done()) {
+    return false;
+  }
+  root = node;
+  return true;
+}
+
+std::string ConfigSnapshot::GetPath(const std::string& dir, uint64_t hash) {
+  char name[64];
+  snprintf(name, sizeof(name), "trpc_config.%016lx.snapshot", static_cast<unsigned long>(hash));
+  return dir + "/" + name;
+}
+
+bool ConfigSnapshot::Load(const std::string& dir, std::string_view content, YAML::Node& root) {
+  uint64_t hash = Hash(content);
+  std::ifstream ifs(GetPath(dir, hash), std::ios::in | std::ios::binary);
+  if (!ifs) {
+    return false;
+  }
+
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  return Decode(ss.str(), hash, root);
+}
+
+bool ConfigSnapshot::Save(const std::string& dir, std::string_view content, const YAML::Node& root) {
+  uint64_t hash = Hash(content);
+  std::string path = GetPath(dir, hash);
+  std::string tmp_path = path + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!ofs) {
+      return false;
+    }
+    ofs << Encode(hash, root);
+    if (!ofs.good()) {
+      ofs.close();
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace trpc
@@ -0,0 +1,55 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "yaml-cpp/yaml.h"
+
+namespace trpc {
+
+/// @brief Compact binary snapshot of the parsed framework config, keyed by the hash of the config content(with the
+///        environment variables expanded). Rebuilding the yaml node tree from the snapshot skips the yaml scanning and
+///        parsing, which dominates the loading of large configs.
+/// @note  The format: 8 bytes magic, 8 bytes content hash, then the root node. A node is a type byte followed by:
+///        nothing(null), the length and the bytes(scalar), the count and the nodes(sequence), or the count and the
+///        key-value node pairs(map). Lengths and counts are varints.
+class ConfigSnapshot {
+ public:
+  /// @brief Hash of the config content.
+  static uint64_t Hash(std::string_view content);
+
+  /// @brief Encodes the yaml node tree parsed from the content whose hash is `hash`.
+  static std::string Encode(uint64_t hash, const YAML::Node& root);
+
+  /// @brief Decodes the yaml node tree from `data`.
+  /// @return false if `data` is not a snapshot of the content whose hash is `hash`, or it's malformed.
+  static bool Decode(std::string_view data, uint64_t hash, YAML::Node& root);
+
+  /// @brief Gets the path of the snapshot file of the content whose hash is `hash` in directory `dir`.
+  static std::string GetPath(const std::string& dir, uint64_t hash);
+
+  /// @brief Loads the yaml node tree of `content` from the snapshot file in directory `dir`.
+  /// @return false if the snapshot file does not exist or is invalid.
+  static bool Load(const std::string& dir, std::string_view content, YAML::Node& root);
+
+  /// @brief Saves the yaml node tree parsed from `content` to a snapshot file in directory `dir`.
+  /// @note  The file is written to a temporary file then renamed, so that the processes started at the same time
+  ///        never read a partial one.
+  static bool Save(const std::string& dir, std::string_view content, const YAML::Node& root);
+};
+
+}  // namespace trpc
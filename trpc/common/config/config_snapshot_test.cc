@@ -0,0 +1,108 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/config/config_snapshot.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/common/config/config_helper.h"
+
+namespace trpc::testing {
+
+namespace {
+
+constexpr char kConfigPath[] = "./trpc/common/config/testing/fiber.yaml";
+
+// A mesh config with `n` client services.
+std::string MakeLargeConfig(int n) {
+  std::string content = "global:\n  threadmodel:\n    fiber:\n      - instance_name: fiber_instance\nclient:\n  service:\n";
+  for (int i = 0; i < n; ++i) {
+    auto name = "trpc.test.helloworld.Greeter" + std::to_string(i);
+    content += "    - name: " + name + "\n";
+    content += "      target: " + name + "\n";
+    content += "      namespace: Production\n";
+    content += "      protocol: trpc\n";
+    content += "      timeout: 1000\n";
+    content += "      network: tcp\n";
+    content += "      conn_type: long\n";
+    content += "      selector_name: polaris\n";
+    content += "      filter:\n        - tpstelemetry\n        - prometheus\n";
+  }
+  return content;
+}
+
+}  // namespace
+
+TEST(ConfigSnapshot, EncodeDecode) {
+  auto content = ConfigHelper::LoadFromPath(kConfigPath);
+  YAML::Node root = YAML::Load(content);
+  uint64_t hash = ConfigSnapshot::Hash(content);
+
+  auto data = ConfigSnapshot::Encode(hash, root);
+  YAML::Node decoded;
+  ASSERT_TRUE(ConfigSnapshot::Decode(data, hash, decoded));
+  ASSERT_EQ(YAML::Dump(root), YAML::Dump(decoded));
+  ASSERT_EQ("Test", decoded["server"]["app"].as<std::string>());
+  ASSERT_EQ(10000, decoded["server"]["service"][0]["max_conn_num"].as<int>());
+
+  // Snapshot of another content.
+  ASSERT_FALSE(ConfigSnapshot::Decode(data, hash + 1, decoded));
+  // Truncated.
+  ASSERT_FALSE(ConfigSnapshot::Decode(data.substr(0, data.size() - 1), hash, decoded));
+  // Not a snapshot.
+  ASSERT_FALSE(ConfigSnapshot::Decode(content, hash, decoded));
+}
+
+TEST(ConfigSnapshot, NullAndEmpty) {
+  YAML::Node root = YAML::Load("a: ~\nb: []\nc: {}\nd: ''\n");
+  auto data = ConfigSnapshot::Encode(1, root);
+  YAML::Node decoded;
+  ASSERT_TRUE(ConfigSnapshot::Decode(data, 1, decoded));
+  ASSERT_TRUE(decoded["a"].IsNull());
+  ASSERT_TRUE(decoded["b"].IsSequence());
+  ASSERT_EQ(0, decoded["b"].size());
+  ASSERT_TRUE(decoded["c"].IsMap());
+  ASSERT_EQ("", decoded["d"].as<std::string>());
+  ASSERT_FALSE(decoded["e"]);
+}
+
+TEST(ConfigSnapshot, SaveLoad) {
+  auto content = MakeLargeConfig(10);
+  YAML::Node root = YAML::Load(content);
+  ASSERT_TRUE(ConfigSnapshot::Save(".", content, root));
+
+  YAML::Node loaded;
+  ASSERT_TRUE(ConfigSnapshot::Load(".", content, loaded));
+  ASSERT_EQ(YAML::Dump(root), YAML::Dump(loaded));
+
+  // The snapshot is keyed by the content.
+  ASSERT_FALSE(ConfigSnapshot::Load(".", content + "\n", loaded));
+
+  std::remove(ConfigSnapshot::GetPath(".", ConfigSnapshot::Hash(content)).c_str());
+}
+
+TEST(ConfigSnapshot, ExpandEnv) {
+  setenv("TRPC_CONFIG_SNAPSHOT_TEST", "value", 1);
+  ASSERT_EQ("a: value, b: , c: ${}, d: $value, e: ${x-y}",
+            ConfigHelper::ExpandEnv(
+                "a: ${TRPC_CONFIG_SNAPSHOT_TEST}, b: ${TRPC_CONFIG_SNAPSHOT_NOT_SET}, c: ${}, "
+                "d: $${TRPC_CONFIG_SNAPSHOT_TEST}, e: ${x-y}"));
+  ASSERT_EQ("value", ConfigHelper::ExpandEnv("${TRPC_CONFIG_SNAPSHOT_TEST}"));
+  ASSERT_EQ("${TRPC_CONFIG_SNAPSHOT_TEST", ConfigHelper::ExpandEnv("${TRPC_CONFIG_SNAPSHOT_TEST"));
+}
+
+}  // namespace trpc::testing
@@ -23,6 +23,17 @@ void SeparateThreadModelSchedulingConfig::Display() const {
   TRPC_LOG_DEBUG("scheduling_name:" << scheduling_name);
   TRPC_LOG_DEBUG("local_queue_size:" << local_queue_size);
   TRPC_LOG_DEBUG("max_timer_size:" << max_timer_size);
+  TRPC_LOG_DEBUG("handoff_batch_size:" << handoff_batch_size);
+
+  TRPC_LOG_DEBUG("================================");
+}
+
+void ThreadModelQueuePolicyConfig::Display() const {
+  TRPC_LOG_DEBUG("================================");
+
+  TRPC_LOG_DEBUG("name:" << name);
+  TRPC_LOG_DEBUG("codel_target_delay_ms:" << codel_target_delay_ms);
+  TRPC_LOG_DEBUG("codel_interval_ms:" << codel_interval_ms);
 
   TRPC_LOG_DEBUG("================================");
 }
@@ -44,6 +55,7 @@ void DefaultThreadModelInstanceConfig::Display() const {
   TRPC_LOG_DEBUG("io_uring_flags:" << io_uring_flags);
 
   scheduling.Display();
+  queue_policy.Display();
 
   TRPC_LOG_DEBUG("================================");
 }
@@ -66,6 +78,10 @@ void FiberThreadModelInstanceConfig::Display() const {
   TRPC_LOG_DEBUG("fiber_stack_enable_guard_page:" << fiber_stack_enable_guard_page);
   TRPC_LOG_DEBUG("fiber_scheduling_name:" << fiber_scheduling_name);
   TRPC_LOG_DEBUG("enable_gdb_debug:" << enable_gdb_debug);
+  TRPC_LOG_DEBUG("fiber_stack_registry_path:" << fiber_stack_registry_path);
+  TRPC_LOG_DEBUG("deadline_aware_dispatch:" << deadline_aware_dispatch);
+  TRPC_LOG_DEBUG("fair_queuing:" << fair_queuing);
+  TRPC_LOG_DEBUG("max_running_handlers:" << max_running_handlers);
 
   TRPC_LOG_DEBUG("================================");
 }
@@ -142,6 +158,12 @@ void GlobalConfig::Display() const {
   TRPC_LOG_DEBUG("enable_set:" << enable_set);
   TRPC_LOG_DEBUG("full_set_name:" << full_set_name);
   TRPC_LOG_DEBUG("thread_disable_process_name:" << thread_disable_process_name);
+  TRPC_LOG_DEBUG("write_buffer_budget:" << write_buffer_budget);
+  TRPC_LOG_DEBUG("egress_rate_limit:" << egress_rate_limit);
+  TRPC_LOG_DEBUG("plugin_init_parallelism:" << plugin_init_parallelism);
+  TRPC_LOG_DEBUG("startup_trace_path:" << startup_trace_path);
+  TRPC_LOG_DEBUG("capture_path:" << capture_path);
+  TRPC_LOG_DEBUG("capture_max_size:" << capture_max_size);
 
   threadmodel_config.Display();
 
@@ -87,6 +87,25 @@ struct FiberThreadModelInstanceConfig {
   /// @brief Enable debug fiber using gdb
   bool enable_gdb_debug = false;
 
+  /// @brief Path prefix of the fiber stack registry, empty means disabled
+  /// if set, the stacks and entry functions of live fibers are published to `{prefix}.{pid}` for perf tooling
+  std::string fiber_stack_registry_path;
+
+  /// @brief Whether to dispatch the handler fibers of requests in the order of their deadline
+  /// once `max_running_handlers` handler fibers are running in a scheduling group, the requests whose deadline
+  /// has passed are shed before running
+  bool deadline_aware_dispatch{false};
+
+  /// @brief Whether to share the handler fibers between services by weighted deficit round robin
+  /// once `max_running_handlers` handler fibers are running in a scheduling group, the weight of a service is
+  /// `fair_queuing_weight` in its service config
+  bool fair_queuing{false};
+
+  /// @brief Max number of handler fibers running at the same time per scheduling group
+  /// only use in deadline-aware dispatch and fair queuing, if not set, it is 256 times the number of workers per
+  /// scheduling group
+  uint32_t max_running_handlers{0};
+
   void Display() const;
 };
 
@@ -101,6 +120,27 @@ struct SeparateThreadModelSchedulingConfig {
   /// @brief Max size of timer each handle thread
   uint32_t max_timer_size{10240};
 
+  /// @brief Max number of handle tasks an io thread accumulates during one round of its reactor loop before handing
+  ///        them over to the handle threads at once(with a single wakeup)
+  /// @note  0 or 1 means each task is handed over immediately
+  uint32_t handoff_batch_size{0};
+
+  void Display() const;
+};
+
+/// @brief Merge/separate threadmodel handle task queue management config
+struct ThreadModelQueuePolicyConfig {
+  /// @brief The name of queue policy, "fifo" or "codel"
+  /// @note  codel: sheds the tasks queued for too long once the queue is standing, and serves the newest tasks first
+  ///        meanwhile(adaptive lifo, only for non_steal scheduling)
+  std::string name{"fifo"};
+
+  /// @brief The acceptable minimum queuing delay(ms), only used by codel
+  uint32_t codel_target_delay_ms{5};
+
+  /// @brief The window(ms) over which the minimum queuing delay is measured, only used by codel
+  uint32_t codel_interval_ms{100};
+
   void Display() const;
 };
 
@@ -142,6 +182,9 @@ struct DefaultThreadModelInstanceConfig {
   /// @brief For separate threadmodel
   SeparateThreadModelSchedulingConfig scheduling;
 
+  /// @brief Handle task queue management policy
+  ThreadModelQueuePolicyConfig queue_policy;
+
   /// @brief Whether to use async_io
   bool enable_async_io{false};
 
@@ -285,6 +328,33 @@ struct GlobalConfig {
   /// @brief periodic interval of the runtime info reporting in milliseconds
   uint32_t report_runtime_info_interval{60000};
 
+  /// @brief The memory budget(bytes) of the io-send queues of all the connections in the process. Once exceeded, the
+  ///        connections still holding data to send stop reading requests and the new data sent on them fails fast.
+  /// @note  Use in fiber runtime, if set 0, not limited
+  uint64_t write_buffer_budget{0};
+
+  /// @brief The egress bandwidth limit(bytes per second) shared by all the connections in the process
+  /// @note  Use in fiber runtime(tcp), if set 0, not limited
+  uint64_t egress_rate_limit{0};
+
+  /// @brief The maximum number of plugins initialized at the same time. The plugins independent of each other(see
+  ///        `Plugin::GetDependencies`) are initialized in parallel, in fibers in fiber runtime, otherwise in threads.
+  /// @note  If set 0 or 1, the plugins are initialized one by one
+  uint32_t plugin_init_parallelism{1};
+
+  /// @brief The file to write the time the startup stages and the plugin initializations take to, in Chrome Trace
+  ///        Event Format. They are also exposed by the admin service(`/cmds/startup`).
+  /// @note  If empty, not written
+  std::string startup_trace_path;
+
+  /// @brief The file to capture the requests of the services to, which can be replayed by the replay
+  ///        tool(trpc/tools/replay). The requests are sampled by `capture_sample_rate` in the service config.
+  /// @note  If empty, not captured
+  std::string capture_path;
+
+  /// @brief The maximum size(bytes) of the capture file, the requests beyond it are dropped
+  uint64_t capture_max_size{64 * 1024 * 1024};
+
   /// @brief Framework threadmodel config
   /// @note  Choose one threadmodel to use
   ThreadModelConfig threadmodel_config;
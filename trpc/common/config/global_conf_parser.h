@@ -45,6 +45,10 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
     node["fiber_stack_enable_guard_page"] = config.fiber_stack_enable_guard_page;
     node["fiber_scheduling_name"] = config.fiber_scheduling_name;
     node["enable_gdb_debug"] = config.enable_gdb_debug;
+    node["fiber_stack_registry_path"] = config.fiber_stack_registry_path;
+    node["deadline_aware_dispatch"] = config.deadline_aware_dispatch;
+    node["fair_queuing"] = config.fair_queuing;
+    node["max_running_handlers"] = config.max_running_handlers;
 
     return node;
   }
@@ -118,6 +122,22 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
       config.enable_gdb_debug = node["enable_gdb_debug"].as<bool>();
     }
 
+    if (node["fiber_stack_registry_path"]) {
+      config.fiber_stack_registry_path = node["fiber_stack_registry_path"].as<std::string>();
+    }
+
+    if (node["deadline_aware_dispatch"]) {
+      config.deadline_aware_dispatch = node["deadline_aware_dispatch"].as<bool>();
+    }
+
+    if (node["fair_queuing"]) {
+      config.fair_queuing = node["fair_queuing"].as<bool>();
+    }
+
+    if (node["max_running_handlers"]) {
+      config.max_running_handlers = node["max_running_handlers"].as<uint32_t>();
+    }
+
     return true;
   }
 };
@@ -130,6 +150,7 @@ struct convert<trpc::SeparateThreadModelSchedulingConfig> {
     node["scheduling_name"] = config.scheduling_name;
     node["local_queue_size"] = config.local_queue_size;
     node["max_timer_size"] = config.max_timer_size;
+    node["handoff_batch_size"] = config.handoff_batch_size;
 
     return node;
   }
@@ -153,6 +174,39 @@ struct convert<trpc::SeparateThreadModelSchedulingConfig> {
       config.max_timer_size = node["max_timer_size"].as<uint32_t>();
     }
 
+    if (node["handoff_batch_size"]) {
+      config.handoff_batch_size = node["handoff_batch_size"].as<uint32_t>();
+    }
+
+    return true;
+  }
+};
+
+template <>
+struct convert<trpc::ThreadModelQueuePolicyConfig> {
+  static YAML::Node encode(const trpc::ThreadModelQueuePolicyConfig& config) {
+    YAML::Node node;
+
+    node["name"] = config.name;
+    node["codel_target_delay_ms"] = config.codel_target_delay_ms;
+    node["codel_interval_ms"] = config.codel_interval_ms;
+
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::ThreadModelQueuePolicyConfig& config) {
+    if (node["name"]) {
+      config.name = node["name"].as<std::string>();
+    }
+
+    if (node["codel_target_delay_ms"]) {
+      config.codel_target_delay_ms = node["codel_target_delay_ms"].as<uint32_t>();
+    }
+
+    if (node["codel_interval_ms"]) {
+      config.codel_interval_ms = node["codel_interval_ms"].as<uint32_t>();
+    }
+
     return true;
   }
 };
@@ -172,6 +226,7 @@ struct convert<trpc::DefaultThreadModelInstanceConfig> {
     node["io_thread_task_queue_size"] = config.io_thread_task_queue_size;
     node["handle_thread_task_queue_size"] = config.handle_thread_task_queue_size;
     node["scheduling"] = config.scheduling;
+    node["queue_policy"] = config.queue_policy;
     node["enable_async_io"] = config.enable_async_io;
     node["io_uring_entries"] = config.io_uring_entries;
     node["io_uring_flags"] = config.io_uring_flags;
@@ -220,6 +275,10 @@ struct convert<trpc::DefaultThreadModelInstanceConfig> {
       config.scheduling = node["scheduling"].as<trpc::SeparateThreadModelSchedulingConfig>();
     }
 
+    if (node["queue_policy"]) {
+      config.queue_policy = node["queue_policy"].as<trpc::ThreadModelQueuePolicyConfig>();
+    }
+
     if (node["enable_async_io"]) {
       config.enable_async_io = node["enable_async_io"].as<bool>();
     }
@@ -411,6 +470,12 @@ struct convert<trpc::GlobalConfig> {
     node["inner_periphery_task_scheduler_thread_num"] = global_config.inner_periphery_task_scheduler_thread_num;
     node["enable_runtime_report"] = global_config.enable_runtime_report;
     node["report_runtime_info_interval"] = global_config.report_runtime_info_interval;
+    node["write_buffer_budget"] = global_config.write_buffer_budget;
+    node["egress_rate_limit"] = global_config.egress_rate_limit;
+    node["plugin_init_parallelism"] = global_config.plugin_init_parallelism;
+    node["startup_trace_path"] = global_config.startup_trace_path;
+    node["capture_path"] = global_config.capture_path;
+    node["capture_max_size"] = global_config.capture_max_size;
     node["threadmodel"] = global_config.threadmodel_config;
     node["heartbeat"] = global_config.heartbeat_config;
     node["buffer_pool"] = global_config.buffer_pool_config;
@@ -475,6 +540,30 @@ struct convert<trpc::GlobalConfig> {
       global_config.report_runtime_info_interval = node["report_runtime_info_interval"].as<uint32_t>();
     }
 
+    if (node["write_buffer_budget"]) {
+      global_config.write_buffer_budget = node["write_buffer_budget"].as<uint64_t>();
+    }
+
+    if (node["egress_rate_limit"]) {
+      global_config.egress_rate_limit = node["egress_rate_limit"].as<uint64_t>();
+    }
+
+    if (node["plugin_init_parallelism"]) {
+      global_config.plugin_init_parallelism = node["plugin_init_parallelism"].as<uint32_t>();
+    }
+
+    if (node["startup_trace_path"]) {
+      global_config.startup_trace_path = node["startup_trace_path"].as<std::string>();
+    }
+
+    if (node["capture_path"]) {
+      global_config.capture_path = node["capture_path"].as<std::string>();
+    }
+
+    if (node["capture_max_size"]) {
+      global_config.capture_max_size = node["capture_max_size"].as<uint64_t>();
+    }
+
     if (node["threadmodel"]) {
       auto item = node["threadmodel"].as<trpc::ThreadModelConfig>();
       global_config.threadmodel_config = item;
@@ -17,10 +17,22 @@
 
 namespace trpc {
 
+void RedisNearCacheConf::Display() const {
+  TRPC_LOG_DEBUG("redis near_cache mode:" << mode);
+  for (const auto& prefix : prefixes) {
+    TRPC_LOG_DEBUG("redis near_cache prefix:" << prefix);
+  }
+  TRPC_LOG_DEBUG("redis near_cache max_bytes:" << max_bytes);
+  TRPC_LOG_DEBUG("redis near_cache shards:" << shards);
+}
+
 void RedisClientConf::Display() const {
   TRPC_LOG_DEBUG("redis_password:" << password);
   TRPC_LOG_DEBUG("redis user name:" << user_name);
   TRPC_LOG_DEBUG("redis_db:" << db);
+  if (near_cache.enable) {
+    near_cache.Display();
+  }
 }
 
 }  // namespace trpc
@@ -15,11 +15,33 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "yaml-cpp/yaml.h"
 
 namespace trpc {
 
+/// @brief Config of client side caching(near-cache) based on RESP3 client tracking
+struct RedisNearCacheConf {
+  /// @brief Whether enable near-cache, the connections are switched to RESP3 if it's enabled
+  bool enable{false};
+
+  /// @brief Tracking mode, "default": the server remembers the keys read by the connection,
+  /// "broadcast": the server notifies the modification of all the keys matching `prefixes`, other values are rejected
+  std::string mode{"default"};
+
+  /// @brief Key prefixes in broadcast mode, empty means all the keys
+  std::vector<std::string> prefixes;
+
+  /// @brief Max memory(bytes) of the cached replies
+  uint64_t max_bytes{64 * 1024 * 1024};
+
+  /// @brief Number of the shards of the cache
+  uint32_t shards{16};
+
+  void Display() const;
+};
+
 /// @brief Client config for accessing redis
 /// Mainly contains authentication information
 struct RedisClientConf {
@@ -35,6 +57,9 @@ struct RedisClientConf {
   /// @brief Whether enable auth
   bool enable{false};
 
+  /// @brief Near-cache of GET replies
+  RedisNearCacheConf near_cache;
+
   void Display() const;
 };
 
@@ -19,6 +19,43 @@
 
 namespace YAML {
 
+template <>
+struct convert<trpc::RedisNearCacheConf> {
+  static YAML::Node encode(const trpc::RedisNearCacheConf& near_cache_conf) {
+    YAML::Node node;
+    node["enable"] = near_cache_conf.enable;
+    node["mode"] = near_cache_conf.mode;
+    node["prefixes"] = near_cache_conf.prefixes;
+    node["max_bytes"] = near_cache_conf.max_bytes;
+    node["shards"] = near_cache_conf.shards;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::RedisNearCacheConf& near_cache_conf) {  // NOLINT
+    if (node["enable"]) {
+      near_cache_conf.enable = node["enable"].as<bool>();
+    }
+    if (node["mode"]) {
+      near_cache_conf.mode = node["mode"].as<std::string>();
+      // The unknown mode is rejected rather than falling back to "default", the keys tracked would not match the
+      // ones cached.
+      if (near_cache_conf.mode != "default" && near_cache_conf.mode != "broadcast") {
+        return false;
+      }
+    }
+    if (node["prefixes"]) {
+      near_cache_conf.prefixes = node["prefixes"].as<std::vector<std::string>>();
+    }
+    if (node["max_bytes"]) {
+      near_cache_conf.max_bytes = node["max_bytes"].as<uint64_t>();
+    }
+    if (node["shards"]) {
+      near_cache_conf.shards = node["shards"].as<uint32_t>();
+    }
+    return true;
+  }
+};
+
 template <>
 struct convert<trpc::RedisClientConf> {
   static YAML::Node encode(const trpc::RedisClientConf& redis_conf) {
@@ -26,6 +63,9 @@ struct convert<trpc::RedisClientConf> {
     node["password"] = redis_conf.password;
     node["user_name"] = redis_conf.user_name;
     node["db"] = redis_conf.db;
+    if (redis_conf.near_cache.enable) {
+      node["near_cache"] = redis_conf.near_cache;
+    }
     return node;
   }
 
@@ -39,6 +79,9 @@ struct convert<trpc::RedisClientConf> {
     if (node["db"]) {
       redis_conf.db = node["db"].as<uint32_t>();
     }
+    if (node["near_cache"]) {
+      redis_conf.near_cache = node["near_cache"].as<trpc::RedisNearCacheConf>();
+    }
     return true;
   }
 };
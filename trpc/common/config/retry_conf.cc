@@ -22,4 +22,15 @@ void RetryHedgingLimitConfig::Display() const {
   TRPC_LOG_DEBUG("token_ratio:" << token_ratio);
 }
 
+void RetryBudgetConfig::Display() const {
+  TRPC_LOG_DEBUG("max_tokens:" << max_tokens);
+  TRPC_LOG_DEBUG("retry_ratio:" << retry_ratio);
+  TRPC_LOG_DEBUG("max_attempts:" << max_attempts);
+  TRPC_LOG_DEBUG("base_backoff_ms:" << base_backoff_ms);
+  TRPC_LOG_DEBUG("max_backoff_ms:" << max_backoff_ms);
+  TRPC_LOG_DEBUG("retryable_codes size:" << retryable_codes.size());
+  TRPC_LOG_DEBUG("idempotent_retryable_codes size:" << idempotent_retryable_codes.size());
+  TRPC_LOG_DEBUG("retryable_func_codes size:" << retryable_func_codes.size());
+}
+
 }  // namespace trpc
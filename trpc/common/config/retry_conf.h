@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "yaml-cpp/yaml.h"
 
 namespace trpc {
@@ -32,4 +34,31 @@ struct RetryHedgingLimitConfig {
   void Display() const;
 };
 
+constexpr char kRetryBudgetFilter[] = "retry_budget";
+
+/// @brief Config of the retry budget shared by the retries and hedged(backup) requests to the same callee.
+struct RetryBudgetConfig {
+  /// Capacity of the budget, in retries
+  int max_tokens{100};
+  /// Fraction of a retry deposited to the budget by each successful request, eg: 0.1 allows at most one retry per
+  /// ten successful requests in the long run
+  double retry_ratio{0.1};
+  /// Maximum number of attempts(including the first one) of a call invoked with retries
+  int max_attempts{3};
+  /// Backoff before the n-th retry is a random value in [0, min(max_backoff_ms, base_backoff_ms * 2^(n-1))]
+  int base_backoff_ms{10};
+  int max_backoff_ms{200};
+  /// Framework return codes for which any request is retried. Empty means the defaults: server overload,
+  /// server limited and connect error, which are known to be rejected before the callee handles the request.
+  std::vector<int> retryable_codes;
+  /// Extra return codes for which only idempotent requests are retried. Empty means the defaults: client invoke
+  /// timeout, network error and server timeout, after which the callee may have handled the request.
+  std::vector<int> idempotent_retryable_codes;
+  /// Return codes of the callee(func codes) for which any request is retried. The codes of the callee may coincide
+  /// with the framework ones, so that they are never retried unless listed here explicitly.
+  std::vector<int> retryable_func_codes;
+
+  void Display() const;
+};
+
 }  // namespace trpc
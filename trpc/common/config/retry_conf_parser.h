@@ -39,4 +39,48 @@ struct convert<trpc::RetryHedgingLimitConfig> {
   }
 };
 
+template <>
+struct convert<trpc::RetryBudgetConfig> {
+  static YAML::Node encode(const trpc::RetryBudgetConfig& config) {
+    YAML::Node node;
+    node["max_tokens"] = config.max_tokens;
+    node["retry_ratio"] = config.retry_ratio;
+    node["max_attempts"] = config.max_attempts;
+    node["base_backoff_ms"] = config.base_backoff_ms;
+    node["max_backoff_ms"] = config.max_backoff_ms;
+    node["retryable_codes"] = config.retryable_codes;
+    node["idempotent_retryable_codes"] = config.idempotent_retryable_codes;
+    node["retryable_func_codes"] = config.retryable_func_codes;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::RetryBudgetConfig& config) {  // NOLINT
+    if (node["max_tokens"]) {
+      config.max_tokens = node["max_tokens"].as<int>();
+    }
+    if (node["retry_ratio"]) {
+      config.retry_ratio = node["retry_ratio"].as<double>();
+    }
+    if (node["max_attempts"]) {
+      config.max_attempts = node["max_attempts"].as<int>();
+    }
+    if (node["base_backoff_ms"]) {
+      config.base_backoff_ms = node["base_backoff_ms"].as<int>();
+    }
+    if (node["max_backoff_ms"]) {
+      config.max_backoff_ms = node["max_backoff_ms"].as<int>();
+    }
+    if (node["retryable_codes"]) {
+      config.retryable_codes = node["retryable_codes"].as<std::vector<int>>();
+    }
+    if (node["idempotent_retryable_codes"]) {
+      config.idempotent_retryable_codes = node["idempotent_retryable_codes"].as<std::vector<int>>();
+    }
+    if (node["retryable_func_codes"]) {
+      config.retryable_func_codes = node["retryable_func_codes"].as<std::vector<int>>();
+    }
+    return true;
+  }
+};
+
 }  // namespace YAML
@@ -31,4 +31,26 @@ TEST(RetryHedgingLimitConfig, Parse) {
   ASSERT_EQ(2, node["token_ratio"].as<int>());
 }
 
+TEST(RetryBudgetConfig, Parse) {
+  YAML::Node node;
+  node["max_tokens"] = 20;
+  node["retry_ratio"] = 0.2;
+  node["max_attempts"] = 2;
+  node["retryable_codes"].push_back(22);
+  node["retryable_func_codes"].push_back(10001);
+
+  trpc::RetryBudgetConfig config;
+  ASSERT_TRUE(YAML::convert<trpc::RetryBudgetConfig>::decode(node, config));
+  ASSERT_EQ(10, config.base_backoff_ms);
+  ASSERT_EQ(200, config.max_backoff_ms);
+  ASSERT_TRUE(config.idempotent_retryable_codes.empty());
+
+  node = YAML::convert<trpc::RetryBudgetConfig>::encode(config);
+  ASSERT_EQ(20, node["max_tokens"].as<int>());
+  ASSERT_DOUBLE_EQ(0.2, node["retry_ratio"].as<double>());
+  ASSERT_EQ(2, node["max_attempts"].as<int>());
+  ASSERT_EQ(std::vector<int>{22}, node["retryable_codes"].as<std::vector<int>>());
+  ASSERT_EQ(std::vector<int>{10001}, node["retryable_func_codes"].as<std::vector<int>>());
+}
+
 }  // namespace trpc::testing
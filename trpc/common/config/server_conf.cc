@@ -38,8 +38,15 @@ void ServiceConfig::Display() const {
   TRPC_LOG_DEBUG("recv_buffer_size:" << recv_buffer_size);
   TRPC_LOG_DEBUG("send_queue_capacity:" << send_queue_capacity);
   TRPC_LOG_DEBUG("send_queue_timeout:" << send_queue_timeout);
+  TRPC_LOG_DEBUG("write_buffer_budget:" << write_buffer_budget);
+  TRPC_LOG_DEBUG("conn_egress_rate_limit:" << conn_egress_rate_limit);
+  TRPC_LOG_DEBUG("egress_rate_limit:" << egress_rate_limit);
   TRPC_LOG_DEBUG("threadmodel_instance_name:" << threadmodel_instance_name);
   TRPC_LOG_DEBUG("accept_thread_num:" << accept_thread_num);
+  TRPC_LOG_DEBUG("fiber_scheduling_groups:" << fiber_scheduling_groups);
+  TRPC_LOG_DEBUG("fair_queuing_weight:" << fair_queuing_weight);
+  TRPC_LOG_DEBUG("capture_sample_rate:" << capture_sample_rate);
+  TRPC_LOG_DEBUG("resource_accounting:" << resource_accounting);
   TRPC_LOG_DEBUG("stream_read_timeout:" << stream_read_timeout);
   TRPC_LOG_DEBUG("stream_max_window_size:" << stream_max_window_size);
 
@@ -62,6 +69,8 @@ void ServerConfig::Display() const {
   TRPC_LOG_DEBUG("enable_server_stats:" << enable_server_stats);
   TRPC_LOG_DEBUG("server_stats_interval:" << server_stats_interval);
   TRPC_LOG_DEBUG("stop_max_wait_time:" << stop_max_wait_time);
+  TRPC_LOG_DEBUG("hot_restart_path:" << hot_restart_path);
+  TRPC_LOG_DEBUG("hot_restart_timeout:" << hot_restart_timeout);
 
   for (const auto& i : services_config) {
     i.Display();
@@ -98,6 +98,19 @@ struct ServiceConfig {
   /// Use in fiber runtime
   uint32_t send_queue_timeout{3000};
 
+  /// @brief The memory budget(bytes) of the io-send queues of all the connections of the service. Once exceeded, the
+  /// connections still holding data to send stop reading requests and the new data sent on them fails fast.
+  /// Use in fiber runtime, if set 0, not limited
+  uint64_t write_buffer_budget{0};
+
+  /// @brief The egress bandwidth limit(bytes per second) of each connection of the service
+  /// Use in fiber runtime(tcp), if set 0, not limited
+  uint64_t conn_egress_rate_limit{0};
+
+  /// @brief The egress bandwidth limit(bytes per second) shared by all the connections of the service
+  /// Use in fiber runtime(tcp), if set 0, not limited
+  uint64_t egress_rate_limit{0};
+
   /// @brief The thread model type use by service, deprecated.
   std::string threadmodel_type;
 
@@ -109,6 +122,23 @@ struct ServiceConfig {
   /// @brief The number of threads(fibers) listening on the port
   uint32_t accept_thread_num{1};
 
+  /// @brief The scheduling groups(indexes) the connections of the service are dispatched to, so that the requests of
+  /// the service are handled by the fiber workers of these scheduling groups only
+  /// @note  Specified in range or indexes, e.g.: 0-1,3. Use in fiber runtime, if not set, all the scheduling groups
+  std::string fiber_scheduling_groups;
+
+  /// @brief The weight of the service when the services share the handler fibers by fair queuing
+  /// Use in fiber runtime with `fair_queuing` of the fiber threadmodel enabled
+  uint32_t fair_queuing_weight{1};
+
+  /// @brief Captures one out of every `capture_sample_rate` requests of the service to `capture_path` of the global
+  ///        config, if set 0, not captured
+  uint32_t capture_sample_rate{0};
+
+  /// @brief Whether to account the cpu time, the allocated bytes and the wait time of each request of the service,
+  ///        which are shown in rpcz and aggregated per method by tvar under `/trpc/server/resource_usage`
+  bool resource_accounting{false};
+
   /// @brief Under streaming, the timeout for reading messages from the stream
   int stream_read_timeout{3000};
 
@@ -177,6 +207,14 @@ struct ServerConfig {
   /// @brief set max wait timeout(ms) when stop incase cannot stop
   uint32_t stop_max_wait_time{5000};
 
+  /// @brief The unix socket path used to hand the listening sockets over on hot restart
+  /// The new process takes over the listening sockets of the old one serving at this path, then the old one stops
+  /// listening and drains the requests in-flight. If empty, hot restart is disabled
+  std::string hot_restart_path;
+
+  /// @brief Timeout(ms) of taking over the listening sockets from the old process on hot restart
+  uint32_t hot_restart_timeout{3000};
+
   void Display() const;
 };
 
@@ -49,9 +49,16 @@ struct convert<trpc::ServiceConfig> {
     node["recv_buffer_size"] = service_config.recv_buffer_size;
     node["send_queue_capacity"] = service_config.send_queue_capacity;
     node["send_queue_timeout"] = service_config.send_queue_timeout;
+    node["write_buffer_budget"] = service_config.write_buffer_budget;
+    node["conn_egress_rate_limit"] = service_config.conn_egress_rate_limit;
+    node["egress_rate_limit"] = service_config.egress_rate_limit;
     node["threadmodel_type"] = service_config.threadmodel_type;
     node["threadmodel_instance_name"] = service_config.threadmodel_instance_name;
     node["accept_thread_num"] = service_config.accept_thread_num;
+    node["fiber_scheduling_groups"] = service_config.fiber_scheduling_groups;
+    node["fair_queuing_weight"] = service_config.fair_queuing_weight;
+    node["capture_sample_rate"] = service_config.capture_sample_rate;
+    node["resource_accounting"] = service_config.resource_accounting;
     node["stream_read_timeout"] = service_config.stream_read_timeout;
     node["stream_max_window_size"] = service_config.stream_max_window_size;
     node["filter"] = service_config.service_filters;
@@ -123,6 +130,15 @@ struct convert<trpc::ServiceConfig> {
     if (node["send_queue_timeout"]) {
       service_config.send_queue_timeout = node["send_queue_timeout"].as<uint32_t>();
     }
+    if (node["write_buffer_budget"]) {
+      service_config.write_buffer_budget = node["write_buffer_budget"].as<uint64_t>();
+    }
+    if (node["conn_egress_rate_limit"]) {
+      service_config.conn_egress_rate_limit = node["conn_egress_rate_limit"].as<uint64_t>();
+    }
+    if (node["egress_rate_limit"]) {
+      service_config.egress_rate_limit = node["egress_rate_limit"].as<uint64_t>();
+    }
     if (node["threadmodel_type"]) {
       service_config.threadmodel_type = node["threadmodel_type"].as<std::string>();
     }
@@ -150,6 +166,18 @@ struct convert<trpc::ServiceConfig> {
       }
 #endif
     }
+    if (node["fiber_scheduling_groups"]) {
+      service_config.fiber_scheduling_groups = node["fiber_scheduling_groups"].as<std::string>();
+    }
+    if (node["fair_queuing_weight"]) {
+      service_config.fair_queuing_weight = node["fair_queuing_weight"].as<uint32_t>();
+    }
+    if (node["capture_sample_rate"]) {
+      service_config.capture_sample_rate = node["capture_sample_rate"].as<uint32_t>();
+    }
+    if (node["resource_accounting"]) {
+      service_config.resource_accounting = node["resource_accounting"].as<bool>();
+    }
     if (node["filter"]) {
       service_config.service_filters = node["filter"].as<std::vector<std::string>>();
     }
@@ -181,6 +209,8 @@ struct convert<trpc::ServerConfig> {
     node["filter"] = server_config.filters;
     node["service"] = server_config.services_config;
     node["stop_max_wait_time"] = server_config.stop_max_wait_time;
+    node["hot_restart_path"] = server_config.hot_restart_path;
+    node["hot_restart_timeout"] = server_config.hot_restart_timeout;
 
     return node;
   }
@@ -245,6 +275,14 @@ struct convert<trpc::ServerConfig> {
       server_config.stop_max_wait_time = node["stop_max_wait_time"].as<uint32_t>();
     }
 
+    if (node["hot_restart_path"]) {
+      server_config.hot_restart_path = node["hot_restart_path"].as<std::string>();
+    }
+
+    if (node["hot_restart_timeout"]) {
+      server_config.hot_restart_timeout = node["hot_restart_timeout"].as<uint32_t>();
+    }
+
     return true;
   }
 };
@@ -35,6 +35,8 @@ TEST(ServerConfigTest, server_config_test) {
   server_config.server_stats_interval = 60000;
   server_config.filters = {"tpstelemetry"};
   server_config.stop_max_wait_time = 1000;
+  server_config.hot_restart_path = "/tmp/helloworld.hot_restart.sock";
+  server_config.hot_restart_timeout = 2000;
 
   ServiceConfig service_config;
   service_config.service_name = "trpc.test.helloworld.Greeter";
@@ -54,6 +56,9 @@ TEST(ServerConfigTest, server_config_test) {
   service_config.recv_buffer_size = 20000000;
   service_config.send_queue_capacity = 20000000;
   service_config.send_queue_timeout = 5000;
+  service_config.write_buffer_budget = 1 << 30;
+  service_config.conn_egress_rate_limit = 1 << 20;
+  service_config.egress_rate_limit = 1 << 24;
   service_config.threadmodel_instance_name = "instance1";
   service_config.accept_thread_num = 2;
   service_config.stream_read_timeout = 3000;
@@ -84,6 +89,8 @@ TEST(ServerConfigTest, server_config_test) {
   ASSERT_EQ(server_config.server_stats_interval, tmp.server_stats_interval);
   ASSERT_EQ(server_config.filters[0], tmp.filters[0]);
   ASSERT_EQ(server_config.stop_max_wait_time, tmp.stop_max_wait_time);
+  ASSERT_EQ(server_config.hot_restart_path, tmp.hot_restart_path);
+  ASSERT_EQ(server_config.hot_restart_timeout, tmp.hot_restart_timeout);
 
   ASSERT_EQ(server_config.services_config.front().service_name, tmp.services_config.front().service_name);
   ASSERT_EQ(server_config.services_config.front().network, tmp.services_config.front().network);
@@ -101,6 +108,11 @@ TEST(ServerConfigTest, server_config_test) {
   ASSERT_EQ(server_config.services_config.front().recv_buffer_size, tmp.services_config.front().recv_buffer_size);
   ASSERT_EQ(server_config.services_config.front().send_queue_capacity, tmp.services_config.front().send_queue_capacity);
   ASSERT_EQ(server_config.services_config.front().send_queue_timeout, tmp.services_config.front().send_queue_timeout);
+  ASSERT_EQ(server_config.services_config.front().write_buffer_budget,
+            tmp.services_config.front().write_buffer_budget);
+  ASSERT_EQ(server_config.services_config.front().conn_egress_rate_limit,
+            tmp.services_config.front().conn_egress_rate_limit);
+  ASSERT_EQ(server_config.services_config.front().egress_rate_limit, tmp.services_config.front().egress_rate_limit);
   ASSERT_EQ(server_config.services_config.front().stream_read_timeout, tmp.services_config.front().stream_read_timeout);
   ASSERT_EQ(server_config.services_config.front().share_transport, tmp.services_config.front().share_transport);
   ASSERT_EQ(server_config.services_config.front().stream_max_window_size,
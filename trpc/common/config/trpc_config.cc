@@ -106,7 +106,7 @@ bool CheckThreadNumConfig(const std::vector<FiberThreadModelInstanceConfig>& fib
 }
 
 bool CheckDuplicatedConfig(const std::vector<ServiceConfig>& services_config,
-                           const std::vector<ServiceProxyConfig>& service_proxys_config,
+                           const std::vector<std::string>& service_proxy_names,
                            const std::vector<FiberThreadModelInstanceConfig>& fiber_models,
                            const std::vector<DefaultThreadModelInstanceConfig>& default_models) {
   std::set<std::string> duplicated_conf;
@@ -143,12 +143,12 @@ bool CheckDuplicatedConfig(const std::vector<ServiceConfig>& services_config,
   }
   duplicated_conf.clear();
   // Checking duplidated client->service->name
-  for (auto& service_proxy_config : service_proxys_config) {
-    if (duplicated_conf.find(service_proxy_config.name) != duplicated_conf.end()) {
-      TRPC_LOG_WARN("Detect duplicated service name for [client->service]: " << service_proxy_config.name);
+  for (auto& service_proxy_name : service_proxy_names) {
+    if (duplicated_conf.find(service_proxy_name) != duplicated_conf.end()) {
+      TRPC_LOG_WARN("Detect duplicated service name for [client->service]: " << service_proxy_name);
       return false;
     } else {
-      duplicated_conf.insert(service_proxy_config.name);
+      duplicated_conf.insert(service_proxy_name);
     }
   }
   duplicated_conf.clear();
@@ -161,7 +161,6 @@ bool TrpcConfig::GuaranteeValidConfig() {
   auto& default_models = GetGlobalConfig().threadmodel_config.default_model;
   auto& fiber_models = GetGlobalConfig().threadmodel_config.fiber_model;
   auto& services_config = GetServerConfig().services_config;
-  auto& service_proxys_config = GetClientConfig().service_proxy_config;
   // The following yaml checks correspond to the scenarios covered in trpc/common/config/invalid_test_config folder.
   // More checkings need to be added into both places(here and `invalid_test_config` folder).
   // Threadmodel checking 00: Thread model instance names configured under 'global' are not duplicated.
@@ -173,7 +172,7 @@ bool TrpcConfig::GuaranteeValidConfig() {
   // Threadmodel checking 01: when global, server->services, client->services all of them haven't config threadmodel
   // type
   if (default_models.size() == 0 && fiber_models.size() == 0) {
-    CheckServicesConfigThreadModel(services_config, service_proxys_config);
+    CheckServicesConfigThreadModel(services_config, GetClientConfig().service_proxy_config);
   }
 
   // Threadmodel checking 02: server/client configured a threadmodel but can't found at global
@@ -190,7 +189,7 @@ bool TrpcConfig::GuaranteeValidConfig() {
   }
 
   // Checking duplicate configurations(threadmodel instance/server->service/client->service)
-  if (!CheckDuplicatedConfig(services_config, service_proxys_config, fiber_models, default_models)) {
+  if (!CheckDuplicatedConfig(services_config, client_service_names_, fiber_models, default_models)) {
     return false;
   }
   return true;
@@ -200,6 +199,79 @@ void TrpcConfig::Clear() {
   global_config_ = GlobalConfig();
   server_config_ = ServerConfig();
   client_config_ = ClientConfig();
+  client_service_nodes_.clear();
+  client_service_configs_.clear();
+  client_service_names_.clear();
+  client_service_index_.clear();
+  client_services_decoded_.store(true, std::memory_order_release);
+}
+
+bool TrpcConfig::InitClientConfig(const YAML::Node& node) {
+  YAML::Node others(YAML::NodeType::Map);
+  YAML::Node services;
+  for (const auto& kv : node) {
+    if (kv.first.Scalar() == "service") {
+      services = kv.second;
+    } else {
+      others.force_insert(kv.first, kv.second);
+    }
+  }
+  client_config_ = others.as<ClientConfig>();
+
+  if (!services || !services.IsSequence()) {
+    return !services || services.IsNull();
+  }
+
+  client_service_nodes_.reserve(services.size());
+  client_service_names_.reserve(services.size());
+  for (const auto& service : services) {
+    // The services are decoded on first use, only their structure is checked here so that the config which can never
+    // be decoded still fails the Init.
+    if (!service.IsMap() || (service["name"] && !service["name"].IsScalar())) {
+      TRPC_LOG_ERROR("Parse client service config error: a client service must be a map with a scalar name");
+      return false;
+    }
+    std::string name = service["name"] ? service["name"].Scalar() : "";
+    client_service_index_.emplace(name, client_service_nodes_.size());
+    client_service_names_.push_back(std::move(name));
+    client_service_nodes_.push_back(service);
+  }
+  client_service_configs_.resize(client_service_nodes_.size());
+  client_services_decoded_.store(client_service_nodes_.empty(), std::memory_order_release);
+
+  return true;
+}
+
+bool TrpcConfig::DecodeClientServices() const {
+  if (client_services_decoded_.load(std::memory_order_acquire)) {
+    return true;
+  }
+
+  std::scoped_lock lock(client_services_mutex_);
+  if (client_services_decoded_.load(std::memory_order_relaxed)) {
+    return true;
+  }
+
+  bool ok = true;
+  client_config_.service_proxy_config.reserve(client_service_nodes_.size());
+  for (std::size_t i = 0; i < client_service_nodes_.size(); ++i) {
+    if (client_service_configs_[i]) {
+      client_config_.service_proxy_config.push_back(std::move(*client_service_configs_[i]));
+      continue;
+    }
+    try {
+      client_config_.service_proxy_config.push_back(client_service_nodes_[i].as<ServiceProxyConfig>());
+    } catch (std::exception& ex) {
+      TRPC_LOG_ERROR("Parse client service config error:" << ex.what());
+      ok = false;
+    }
+  }
+  client_config_.Display();
+
+  client_service_nodes_.clear();
+  client_service_configs_.clear();
+  client_services_decoded_.store(true, std::memory_order_release);
+  return ok;
 }
 
 int TrpcConfig::Init(const std::string& conf_path) {
@@ -236,13 +308,16 @@ int TrpcConfig::Init(const std::string& conf_path) {
     }
 
     area = "client";
-    if (ConfigHelper::GetInstance()->IsNodeExist({area})) {
-      if (ConfigHelper::GetInstance()->GetConfig({area}, client_config_)) {
-        client_config_.Display();
-      } else {
+    YAML::Node client_node;
+    if (ConfigHelper::GetInstance()->GetNode({area}, client_node)) {
+      if (!InitClientConfig(client_node)) {
         TRPC_LOG_ERROR("Parse Area error:" << area);
         return -1;
       }
+      if (strict_client_services_ && !DecodeClientServices()) {
+        TRPC_LOG_ERROR("Parse Area error:" << area << ", malformed client service");
+        return -1;
+      }
     }
   } catch (std::exception& ex) {
     TRPC_LOG_ERROR("Parse Config error:" << ex.what());
@@ -335,7 +410,34 @@ bool TrpcConfig::GetClientServiceNode(const std::string& service_name, YAML::Nod
   return false;
 }
 
+bool TrpcConfig::HasClientServiceConfig(const std::string& service_name) const {
+  return client_service_index_.find(service_name) != client_service_index_.end();
+}
+
 bool TrpcConfig::GetClientServiceConfig(const std::string& service_name, ServiceProxyConfig& config) {
+  if (!client_services_decoded_.load(std::memory_order_acquire)) {
+    std::scoped_lock lock(client_services_mutex_);
+    if (!client_services_decoded_.load(std::memory_order_relaxed)) {
+      auto it = client_service_index_.find(service_name);
+      if (it == client_service_index_.end()) {
+        return false;
+      }
+      auto& cached = client_service_configs_[it->second];
+      if (cached) {
+        config = *cached;
+        return true;
+      }
+      try {
+        cached = client_service_nodes_[it->second].as<ServiceProxyConfig>();
+        config = *cached;
+        return true;
+      } catch (std::exception& ex) {
+        TRPC_LOG_ERROR("Parse client service config of " << service_name << " error:" << ex.what());
+        return false;
+      }
+    }
+  }
+
   for (const auto& service : client_config_.service_proxy_config) {
     if (service.name == service_name) {
       config = service;
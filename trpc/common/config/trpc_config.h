@@ -13,8 +13,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -48,9 +52,30 @@ class TrpcConfig {
   const ServerConfig& GetServerConfig() const { return server_config_; }
   ServerConfig& GetMutableServerConfig() { return server_config_; }
 
+  /// @brief Set the directory of the config snapshots, `Init` loads the config from its snapshot there if the config
+  ///        content is unchanged, otherwise parses the config and saves the snapshot. If empty(default), not used.
+  /// @note  It should be called before `Init`.
+  void SetSnapshotDir(const std::string& snapshot_dir) { ConfigHelper::GetInstance()->SetSnapshotDir(snapshot_dir); }
+
+  /// @brief Set whether `Init` decodes all the client services and fails on a malformed one, instead of decoding each
+  ///        of them on first use(default), which reports a malformed service only when it is used.
+  /// @note  It should be called before `Init`.
+  void SetStrictClientServices(bool strict) { strict_client_services_ = strict; }
+
   /// @brief Get client config of framework
-  const ClientConfig& GetClientConfig() const { return client_config_; }
-  ClientConfig& GetMutableClientConfig() { return client_config_; }
+  /// @note  The client services are decoded on the first call, prefer `GetClientServiceConfig` to get the config of
+  ///        one service.
+  const ClientConfig& GetClientConfig() const {
+    DecodeClientServices();
+    return client_config_;
+  }
+  ClientConfig& GetMutableClientConfig() {
+    DecodeClientServices();
+    return client_config_;
+  }
+
+  /// @brief Get the filters used by all the client services, it does not decode the client services.
+  const std::vector<std::string>& GetClientFilters() const { return client_config_.filters; }
 
   /// @brief Get tvar config of framework
   const TvarConfig& GetTvarConfig() const { return global_config_.tvar_config; }
@@ -132,8 +157,13 @@ class TrpcConfig {
   /// @param service_name service name
   /// @param config service proxy config
   /// @return True: success, False: failure
+  /// @note  Only the service got is decoded if the client services are not decoded yet, so a malformed service is
+  ///        reported here instead of at `Init`, use `HasClientServiceConfig` to tell it from an unconfigured one.
   bool GetClientServiceConfig(const std::string& service_name, ServiceProxyConfig& config);
 
+  /// @brief Whether the service is configured in client-config, no matter whether its config can be decoded or not
+  bool HasClientServiceConfig(const std::string& service_name) const;
+
   /// @brief Get yaml node by service name and section name in client-config
   /// @param service_name service name
   /// @param section section name
@@ -168,12 +198,37 @@ class TrpcConfig {
   bool GuaranteeValidConfig();
   void Clear();
 
+  // Decodes the client-config except the services, which are indexed by name to be decoded on first use.
+  bool InitClientConfig(const YAML::Node& node);
+
+  // Returns false if any of the client services not decoded yet fails to be decoded.
+  bool DecodeClientServices() const;
+
  private:
   GlobalConfig global_config_;
 
   ServerConfig server_config_;
 
-  ClientConfig client_config_;
+  // The client services are decoded on first use, as mesh configs may contain thousands of them.
+  mutable ClientConfig client_config_;
+
+  // The yaml nodes of the client services not decoded yet, in configuration order.
+  mutable std::vector<YAML::Node> client_service_nodes_;
+
+  // The client services decoded by `GetClientServiceConfig` before all of them are decoded, by index.
+  mutable std::vector<std::optional<ServiceProxyConfig>> client_service_configs_;
+
+  // The names of the client services, in configuration order.
+  std::vector<std::string> client_service_names_;
+
+  // The index of the first client service with the name in `client_service_nodes_`.
+  std::unordered_map<std::string, std::size_t> client_service_index_;
+
+  mutable std::atomic<bool> client_services_decoded_{true};
+
+  mutable std::mutex client_services_mutex_;
+
+  bool strict_client_services_{false};
 };
 
 }  // namespace trpc
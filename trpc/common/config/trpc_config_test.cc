@@ -11,10 +11,13 @@
 //
 //
 
-#include <iostream>
+#include <cstdio>
+#include <fstream>
+#include <string>
 
 #include "gtest/gtest.h"
 
+#include "trpc/common/config/config_snapshot.h"
 #include "trpc/common/config/trpc_config.h"
 
 namespace trpc::testing {
@@ -26,12 +29,144 @@ TEST(TrpcConfig, TestInit) {
 
   const auto& global = trpc_config->GetGlobalConfig();
   ASSERT_EQ(global.threadmodel_config.fiber_model.size(), 1);
+  ASSERT_EQ(global.plugin_init_parallelism, 4);
+  ASSERT_EQ(global.startup_trace_path, "./startup_trace.json");
+  ASSERT_TRUE(global.capture_path.empty());
+  ASSERT_EQ(global.capture_max_size, 1048576);
 
   const auto& server = trpc_config->GetServerConfig();
   ASSERT_EQ(server.app, "Test");
+  ASSERT_EQ(server.services_config.size(), 1);
+  ASSERT_TRUE(server.services_config[0].resource_accounting);
 
   const auto& client = trpc_config->GetClientConfig();
   ASSERT_EQ(client.filters.size(), 1);
 }
 
+namespace {
+
+// Writes a mesh config with `n` client services to `path`.
+std::string WriteLargeConfig(const std::string& path, int n) {
+  std::string content = "global:\n  threadmodel:\n    fiber:\n      - instance_name: fiber_instance\nclient:\n";
+  content += "  filter:\n    - client_filter\n  service:\n";
+  for (int i = 0; i < n; ++i) {
+    auto name = "trpc.test.helloworld.Greeter" + std::to_string(i);
+    content += "    - name: " + name + "\n";
+    content += "      target: " + name + "\n";
+    content += "      namespace: Production\n";
+    content += "      protocol: trpc\n";
+    content += "      timeout: " + std::to_string(1000 + i) + "\n";
+    content += "      network: tcp\n";
+    content += "      selector_name: polaris\n";
+  }
+  std::ofstream(path) << content;
+  return content;
+}
+
+}  // namespace
+
+TEST(TrpcConfig, LazyClientServices) {
+  constexpr int kServiceNum = 2000;
+  std::string path = "./trpc_config_test_lazy.yaml";
+  WriteLargeConfig(path, kServiceNum);
+
+  trpc::TrpcConfig* trpc_config = trpc::TrpcConfig::GetInstance();
+  ASSERT_EQ(trpc_config->Init(path), 0);
+
+  ASSERT_EQ(std::vector<std::string>{"client_filter"}, trpc_config->GetClientFilters());
+
+  // Only the service got is decoded.
+  ServiceProxyConfig config;
+  ASSERT_TRUE(trpc_config->GetClientServiceConfig("trpc.test.helloworld.Greeter10", config));
+  ASSERT_EQ("trpc.test.helloworld.Greeter10", config.target);
+  ASSERT_EQ(1010, config.timeout);
+  // Decoded once and cached.
+  ServiceProxyConfig cached;
+  ASSERT_TRUE(trpc_config->GetClientServiceConfig("trpc.test.helloworld.Greeter10", cached));
+  ASSERT_EQ(1010, cached.timeout);
+  ASSERT_FALSE(trpc_config->GetClientServiceConfig("trpc.test.helloworld.NotExist", config));
+
+  const auto& client = trpc_config->GetClientConfig();
+  ASSERT_EQ(kServiceNum, client.service_proxy_config.size());
+  ASSERT_EQ("trpc.test.helloworld.Greeter1999", client.service_proxy_config.back().name);
+  // The cached service is kept in configuration order.
+  ASSERT_EQ("trpc.test.helloworld.Greeter10", client.service_proxy_config[10].name);
+  ASSERT_EQ(1010, client.service_proxy_config[10].timeout);
+  ASSERT_EQ(std::vector<std::string>{"client_filter"}, client.filters);
+
+  ASSERT_TRUE(trpc_config->GetClientServiceConfig("trpc.test.helloworld.Greeter20", config));
+  ASSERT_EQ(1020, config.timeout);
+
+  std::remove(path.c_str());
+}
+
+TEST(TrpcConfig, DuplicatedClientService) {
+  std::string path = "./trpc_config_test_duplicated.yaml";
+  std::ofstream(path) << "client:\n  service:\n    - name: a\n    - name: b\n    - name: a\n";
+
+  ASSERT_NE(trpc::TrpcConfig::GetInstance()->Init(path), 0);
+
+  std::remove(path.c_str());
+}
+
+TEST(TrpcConfig, MalformedClientService) {
+  std::string path = "./trpc_config_test_malformed.yaml";
+  trpc::TrpcConfig* trpc_config = trpc::TrpcConfig::GetInstance();
+
+  // The structure is checked at Init.
+  std::ofstream(path) << "client:\n  service:\n    - name: a\n    - b\n";
+  ASSERT_NE(trpc_config->Init(path), 0);
+
+  std::string path1 = "./trpc_config_test_malformed1.yaml";
+  std::ofstream(path1) << "client:\n  service:\n    - name: [a]\n";
+  ASSERT_NE(trpc_config->Init(path1), 0);
+
+  // The values are checked when the service is decoded, it's reported instead of falling back to the default config.
+  std::string path2 = "./trpc_config_test_malformed2.yaml";
+  std::ofstream(path2) << "client:\n  service:\n    - name: a\n      timeout: abc\n    - name: b\n";
+  ASSERT_EQ(trpc_config->Init(path2), 0);
+  ServiceProxyConfig config;
+  ASSERT_FALSE(trpc_config->GetClientServiceConfig("a", config));
+  ASSERT_TRUE(trpc_config->HasClientServiceConfig("a"));
+  ASSERT_TRUE(trpc_config->GetClientServiceConfig("b", config));
+  ASSERT_FALSE(trpc_config->HasClientServiceConfig("c"));
+
+  // The strict mode decodes all the services at Init.
+  trpc_config->SetStrictClientServices(true);
+  ASSERT_NE(trpc_config->Init(path2), 0);
+  trpc_config->SetStrictClientServices(false);
+
+  std::remove(path.c_str());
+  std::remove(path1.c_str());
+  std::remove(path2.c_str());
+}
+
+TEST(TrpcConfig, Snapshot) {
+  // `Init` reloads the config only if the path changes.
+  std::string path1 = "./trpc_config_test_snapshot1.yaml";
+  std::string path2 = "./trpc_config_test_snapshot2.yaml";
+  auto content = WriteLargeConfig(path1, 2000);
+  WriteLargeConfig(path2, 2000);
+
+  trpc::TrpcConfig* trpc_config = trpc::TrpcConfig::GetInstance();
+  trpc_config->SetSnapshotDir(".");
+
+  // Parses the config and saves the snapshot.
+  ASSERT_EQ(trpc_config->Init(path1), 0);
+  ASSERT_TRUE(std::ifstream(ConfigSnapshot::GetPath(".", ConfigSnapshot::Hash(content))).good());
+
+  // Loads from the snapshot.
+  ASSERT_EQ(trpc_config->Init(path2), 0);
+
+  ServiceProxyConfig config;
+  ASSERT_TRUE(trpc_config->GetClientServiceConfig("trpc.test.helloworld.Greeter1999", config));
+  ASSERT_EQ(2999, config.timeout);
+  ASSERT_EQ(1, trpc_config->GetGlobalConfig().threadmodel_config.fiber_model.size());
+
+  trpc_config->SetSnapshotDir("");
+  std::remove(ConfigSnapshot::GetPath(".", ConfigSnapshot::Hash(content)).c_str());
+  std::remove(path1.c_str());
+  std::remove(path2.c_str());
+}
+
 }  // namespace trpc::testing
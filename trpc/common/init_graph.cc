@@ -0,0 +1,200 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/init_graph.h"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "trpc/common/startup_trace.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_condition_variable.h"
+#include "trpc/coroutine/fiber_mutex.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+// Shared by the caller and the steps running, so that it outlives the last step which notifies the caller.
+struct RunState {
+  FiberMutex mutex;
+  FiberConditionVariable cv;
+  // indexes of the steps whose dependencies all succeeded
+  std::deque<std::size_t> ready;
+  // lanes not used by the steps running
+  std::vector<uint32_t> free_lanes;
+  uint32_t running{0};
+  bool failed{false};
+};
+
+}  // namespace
+
+bool InitGraph::AddStep(const std::string& name, std::vector<std::string> deps, Function<bool()>&& init) {
+  if (step_index_.count(name) > 0) {
+    TRPC_FMT_ERROR("init step `{}` duplicated.", name);
+    return false;
+  }
+
+  Step step;
+  step.name = name;
+  step.deps = std::move(deps);
+  step.init = std::move(init);
+  step_index_.emplace(name, steps_.size());
+  steps_.push_back(std::move(step));
+  return true;
+}
+
+bool InitGraph::Run(uint32_t parallelism) {
+  failed_steps_.clear();
+
+  std::vector<std::size_t> order;
+  bool ok = Sort(&order);
+  if (ok) {
+    ok = parallelism <= 1 ? RunSequential(order) : RunParallel(parallelism);
+  }
+
+  for (const auto& step : steps_) {
+    if (!step.done) {
+      failed_steps_.push_back(step.name);
+    }
+  }
+
+  return ok && failed_steps_.empty();
+}
+
+bool InitGraph::Sort(std::vector<std::size_t>* order) {
+  for (auto& step : steps_) {
+    step.dependents.clear();
+    step.pending_deps = 0;
+    step.done = false;
+  }
+
+  for (std::size_t i = 0; i < steps_.size(); ++i) {
+    for (const auto& dep : steps_[i].deps) {
+      auto it = step_index_.find(dep);
+      if (it == step_index_.end()) {
+        TRPC_FMT_ERROR("init step `{}` depends on unknown step `{}`.", steps_[i].name, dep);
+        return false;
+      }
+      steps_[it->second].dependents.push_back(i);
+      ++steps_[i].pending_deps;
+    }
+  }
+
+  // Kahn's algorithm, the steps left are in a cycle.
+  std::vector<std::size_t> pending_deps(steps_.size());
+  for (std::size_t i = 0; i < steps_.size(); ++i) {
+    pending_deps[i] = steps_[i].pending_deps;
+    if (pending_deps[i] == 0) {
+      order->push_back(i);
+    }
+  }
+  for (std::size_t i = 0; i < order->size(); ++i) {
+    for (auto dependent : steps_[(*order)[i]].dependents) {
+      if (--pending_deps[dependent] == 0) {
+        order->push_back(dependent);
+      }
+    }
+  }
+
+  if (order->size() != steps_.size()) {
+    for (std::size_t i = 0; i < steps_.size(); ++i) {
+      if (pending_deps[i] != 0) {
+        TRPC_FMT_ERROR("init step `{}` is in a dependency cycle.", steps_[i].name);
+      }
+    }
+    return false;
+  }
+
+  return true;
+}
+
+bool InitGraph::RunStep(Step& step, uint32_t lane) {
+  ScopedStartupSpan span(step.name, category_, lane);
+  step.done = step.init();
+  if (!step.done) {
+    span.SetFailed();
+    TRPC_FMT_ERROR("init step `{}` failed.", step.name);
+  }
+  return step.done;
+}
+
+bool InitGraph::RunSequential(const std::vector<std::size_t>& order) {
+  for (auto index : order) {
+    if (!RunStep(steps_[index], 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool InitGraph::RunParallel(uint32_t parallelism) {
+  auto state = std::make_shared<RunState>();
+  for (std::size_t i = 0; i < steps_.size(); ++i) {
+    if (steps_[i].pending_deps == 0) {
+      state->ready.push_back(i);
+    }
+  }
+  // Lane 0 is left to the framework startup stages.
+  for (uint32_t lane = parallelism; lane > 0; --lane) {
+    state->free_lanes.push_back(lane);
+  }
+
+  bool in_fiber = IsRunningInFiberWorker();
+
+  std::unique_lock lock(state->mutex);
+  while (true) {
+    while (!state->failed && !state->ready.empty() && !state->free_lanes.empty()) {
+      std::size_t index = state->ready.front();
+      state->ready.pop_front();
+      uint32_t lane = state->free_lanes.back();
+      state->free_lanes.pop_back();
+      ++state->running;
+
+      auto task = [this, state, index, lane] {
+        bool ok = RunStep(steps_[index], lane);
+
+        std::scoped_lock lock(state->mutex);
+        if (ok) {
+          for (auto dependent : steps_[index].dependents) {
+            if (--steps_[dependent].pending_deps == 0) {
+              state->ready.push_back(dependent);
+            }
+          }
+        } else {
+          state->failed = true;
+        }
+        state->free_lanes.push_back(lane);
+        --state->running;
+        state->cv.notify_all();
+      };
+
+      if (!in_fiber || !StartFiberDetached(task)) {
+        std::thread(std::move(task)).detach();
+      }
+    }
+
+    if (state->running == 0) {
+      break;
+    }
+    state->cv.wait(lock);
+  }
+
+  return !state->failed;
+}
+
+}  // namespace trpc
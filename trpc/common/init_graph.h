@@ -0,0 +1,80 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/util/function.h"
+
+namespace trpc {
+
+/// @brief Runs the initialization steps(eg: of the plugins) as a dependency graph, the steps independent of each
+///        other run in parallel: in fibers when called in a fiber worker, otherwise in threads.
+/// @note  The time each step takes is recorded in `StartupTrace`.
+class InitGraph {
+ public:
+  /// @param category category of the steps recorded in `StartupTrace`
+  explicit InitGraph(std::string category) : category_(std::move(category)) {}
+
+  /// @brief Adds a step.
+  /// @param name unique name of the step
+  /// @param deps names of the steps it depends on, it runs after all of them succeeded
+  /// @param init the step, returns false if failed
+  /// @return false if the name is used by another step
+  bool AddStep(const std::string& name, std::vector<std::string> deps, Function<bool()>&& init);
+
+  /// @brief Runs the steps, at most `parallelism` steps run at the same time.
+  /// @return true if all the steps succeeded. The steps depending on a failed one do not run, and nothing runs if
+  ///         a dependency is unknown or the dependencies form a cycle.
+  /// @note  If `parallelism` <= 1, the steps run one by one in the calling context.
+  bool Run(uint32_t parallelism);
+
+  /// @brief Gets the names of the steps which failed or did not run in the last `Run`.
+  const std::vector<std::string>& GetFailedSteps() const { return failed_steps_; }
+
+ private:
+  struct Step {
+    std::string name;
+    std::vector<std::string> deps;
+    Function<bool()> init;
+    // indexes of the steps depending on this step
+    std::vector<std::size_t> dependents;
+    // number of dependencies not finished yet
+    std::size_t pending_deps{0};
+    bool done{false};
+  };
+
+  // Gets the steps in dependency order, fails on unknown dependencies and cycles.
+  bool Sort(std::vector<std::size_t>* order);
+
+  bool RunStep(Step& step, uint32_t lane);
+
+  bool RunSequential(const std::vector<std::size_t>& order);
+
+  bool RunParallel(uint32_t parallelism);
+
+ private:
+  std::string category_;
+
+  std::vector<Step> steps_;
+
+  std::unordered_map<std::string, std::size_t> step_index_;
+
+  std::vector<std::string> failed_steps_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,141 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/init_graph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/common/startup_trace.h"
+#include "trpc/util/time.h"
+
+namespace trpc::testing {
+
+class InitGraphTest : public ::testing::Test {
+ protected:
+  void SetUp() override { StartupTrace::GetInstance()->Clear(); }
+
+  Function<bool()> MakeStep(const std::string& name, bool ok = true, int sleep_ms = 0) {
+    return [this, name, ok, sleep_ms] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+      std::scoped_lock lock(mutex_);
+      finished_.push_back(name);
+      return ok;
+    };
+  }
+
+  std::size_t PositionOf(const std::string& name) {
+    return std::find(finished_.begin(), finished_.end(), name) - finished_.begin();
+  }
+
+  std::mutex mutex_;
+  std::vector<std::string> finished_;
+};
+
+TEST_F(InitGraphTest, DependencyOrder) {
+  for (uint32_t parallelism : {1, 4}) {
+    finished_.clear();
+
+    InitGraph graph("plugin");
+    ASSERT_TRUE(graph.AddStep("c", {"a", "b"}, MakeStep("c")));
+    ASSERT_TRUE(graph.AddStep("a", {}, MakeStep("a", true, 10)));
+    ASSERT_TRUE(graph.AddStep("b", {"a"}, MakeStep("b")));
+    ASSERT_TRUE(graph.AddStep("d", {}, MakeStep("d")));
+    ASSERT_FALSE(graph.AddStep("d", {}, MakeStep("d")));
+
+    ASSERT_TRUE(graph.Run(parallelism));
+    ASSERT_TRUE(graph.GetFailedSteps().empty());
+    ASSERT_EQ(4, finished_.size());
+    ASSERT_LT(PositionOf("a"), PositionOf("b"));
+    ASSERT_LT(PositionOf("b"), PositionOf("c"));
+  }
+}
+
+TEST_F(InitGraphTest, Parallel) {
+  InitGraph graph("plugin");
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(graph.AddStep(std::to_string(i), {}, MakeStep(std::to_string(i), true, 100)));
+  }
+
+  uint64_t begin_ms = trpc::time::GetSteadyMilliSeconds();
+  ASSERT_TRUE(graph.Run(4));
+  ASSERT_LT(trpc::time::GetSteadyMilliSeconds() - begin_ms, 300);
+
+  auto spans = StartupTrace::GetInstance()->GetSpans();
+  ASSERT_EQ(4, spans.size());
+  std::vector<uint32_t> lanes;
+  for (const auto& span : spans) {
+    ASSERT_EQ("plugin", span.category);
+    ASSERT_GE(span.cost_us, 100 * 1000);
+    ASSERT_TRUE(span.ok);
+    lanes.push_back(span.lane);
+  }
+  // The steps running at the same time are put in different lanes.
+  std::sort(lanes.begin(), lanes.end());
+  ASSERT_EQ((std::vector<uint32_t>{1, 2, 3, 4}), lanes);
+}
+
+TEST_F(InitGraphTest, LimitedParallelism) {
+  InitGraph graph("plugin");
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(graph.AddStep(std::to_string(i), {}, MakeStep(std::to_string(i), true, 50)));
+  }
+
+  uint64_t begin_ms = trpc::time::GetSteadyMilliSeconds();
+  ASSERT_TRUE(graph.Run(2));
+  ASSERT_GE(trpc::time::GetSteadyMilliSeconds() - begin_ms, 100);
+  ASSERT_EQ(4, finished_.size());
+}
+
+TEST_F(InitGraphTest, Failed) {
+  for (uint32_t parallelism : {1, 4}) {
+    finished_.clear();
+
+    InitGraph graph("plugin");
+    ASSERT_TRUE(graph.AddStep("a", {}, MakeStep("a", false)));
+    ASSERT_TRUE(graph.AddStep("b", {"a"}, MakeStep("b")));
+
+    ASSERT_FALSE(graph.Run(parallelism));
+    ASSERT_EQ((std::vector<std::string>{"a"}), finished_);
+    ASSERT_EQ((std::vector<std::string>{"a", "b"}), graph.GetFailedSteps());
+  }
+}
+
+TEST_F(InitGraphTest, UnknownDependency) {
+  InitGraph graph("plugin");
+  ASSERT_TRUE(graph.AddStep("a", {"x"}, MakeStep("a")));
+  ASSERT_TRUE(graph.AddStep("b", {}, MakeStep("b")));
+
+  ASSERT_FALSE(graph.Run(4));
+  ASSERT_TRUE(finished_.empty());
+}
+
+TEST_F(InitGraphTest, Cycle) {
+  InitGraph graph("plugin");
+  ASSERT_TRUE(graph.AddStep("a", {"c"}, MakeStep("a")));
+  ASSERT_TRUE(graph.AddStep("b", {"a"}, MakeStep("b")));
+  ASSERT_TRUE(graph.AddStep("c", {"b"}, MakeStep("c")));
+  ASSERT_TRUE(graph.AddStep("d", {}, MakeStep("d")));
+
+  ASSERT_FALSE(graph.Run(4));
+  ASSERT_TRUE(finished_.empty());
+  ASSERT_EQ(4, graph.GetFailedSteps().size());
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,100 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/startup_trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+#include "json/json.h"
+
+#include "trpc/util/log/logging.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+void StartupTrace::Record(StartupSpan&& span) {
+  std::scoped_lock lock(mutex_);
+  spans_.push_back(std::move(span));
+}
+
+std::vector<StartupSpan> StartupTrace::GetSpans() const {
+  std::vector<StartupSpan> spans;
+  {
+    std::scoped_lock lock(mutex_);
+    spans = spans_;
+  }
+  // The enclosing step begins first, so it goes ahead when both begin at the same time.
+  std::stable_sort(spans.begin(), spans.end(), [](const StartupSpan& a, const StartupSpan& b) {
+    return a.begin_us < b.begin_us || (a.begin_us == b.begin_us && a.cost_us > b.cost_us);
+  });
+  return spans;
+}
+
+std::string StartupTrace::ToTraceEvents() const {
+  auto spans = GetSpans();
+  uint64_t base_us = spans.empty() ? 0 : spans.front().begin_us;
+
+  Json::Value events(Json::arrayValue);
+  for (const auto& span : spans) {
+    // Complete event, see https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    Json::Value event;
+    event["name"] = span.name;
+    event["cat"] = span.category;
+    event["ph"] = "X";
+    event["ts"] = Json::UInt64(span.begin_us - base_us);
+    event["dur"] = Json::UInt64(span.cost_us);
+    event["pid"] = 0;
+    event["tid"] = span.lane;
+    event["args"]["ok"] = span.ok;
+    events.append(std::move(event));
+  }
+
+  Json::Value root;
+  root["traceEvents"] = std::move(events);
+  root["displayTimeUnit"] = "ms";
+
+  Json::StreamWriterBuilder json_builder;
+  json_builder["indentation"] = "";
+  return Json::writeString(json_builder, root);
+}
+
+bool StartupTrace::Dump(const std::string& path) const {
+  std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+  if (!ofs.is_open()) {
+    TRPC_FMT_ERROR("open startup trace file {} failed.", path);
+    return false;
+  }
+  ofs << ToTraceEvents();
+  return ofs.good();
+}
+
+void StartupTrace::Clear() {
+  std::scoped_lock lock(mutex_);
+  spans_.clear();
+}
+
+ScopedStartupSpan::ScopedStartupSpan(std::string name, std::string category, uint32_t lane) {
+  span_.name = std::move(name);
+  span_.category = std::move(category);
+  span_.lane = lane;
+  span_.begin_us = trpc::time::GetSteadyMicroSeconds();
+}
+
+ScopedStartupSpan::~ScopedStartupSpan() {
+  span_.cost_us = trpc::time::GetSteadyMicroSeconds() - span_.begin_us;
+  StartupTrace::GetInstance()->Record(std::move(span_));
+}
+
+}  // namespace trpc
@@ -0,0 +1,91 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace trpc {
+
+/// @brief A timed step of the startup, eg: the initialization of a plugin.
+struct StartupSpan {
+  /// name of the step
+  std::string name;
+
+  /// category of the step, eg: "stage"(framework startup stage), "plugin"(plugin initialization)
+  std::string category;
+
+  /// steady time(us) when the step begins
+  uint64_t begin_us{0};
+
+  /// time(us) the step takes
+  uint64_t cost_us{0};
+
+  /// lane(row) of the step in the trace file, the steps run at the same time are put in different lanes
+  uint32_t lane{0};
+
+  /// whether the step succeeded
+  bool ok{true};
+};
+
+/// @brief Records the timed steps of the startup, which are exposed by the admin service(`/cmds/startup`) and can be
+///        dumped to a trace file in Chrome Trace Event Format(opened by chrome://tracing or https://ui.perfetto.dev).
+class StartupTrace {
+ public:
+  static StartupTrace* GetInstance() {
+    static StartupTrace instance;
+    return &instance;
+  }
+
+  /// @brief Records a step.
+  void Record(StartupSpan&& span);
+
+  /// @brief Gets the steps recorded, sorted by the begin time.
+  std::vector<StartupSpan> GetSpans() const;
+
+  /// @brief Converts the steps recorded to Chrome Trace Event Format.
+  std::string ToTraceEvents() const;
+
+  /// @brief Writes the steps recorded to `path` in Chrome Trace Event Format.
+  bool Dump(const std::string& path) const;
+
+  /// @brief Clears the steps recorded.
+  void Clear();
+
+ private:
+  StartupTrace() = default;
+  StartupTrace(const StartupTrace&) = delete;
+  StartupTrace& operator=(const StartupTrace&) = delete;
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<StartupSpan> spans_;
+};
+
+/// @brief Times the scope as a step of the startup.
+class ScopedStartupSpan {
+ public:
+  ScopedStartupSpan(std::string name, std::string category, uint32_t lane = 0);
+  ~ScopedStartupSpan();
+
+  /// @brief Marks the step as failed.
+  void SetFailed() { span_.ok = false; }
+
+ private:
+  StartupSpan span_;
+};
+
+}  // namespace trpc
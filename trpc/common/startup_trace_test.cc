@@ -0,0 +1,77 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/startup_trace.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "json/json.h"
+
+namespace trpc::testing {
+
+TEST(StartupTrace, Record) {
+  StartupTrace::GetInstance()->Clear();
+  StartupTrace::GetInstance()->Record({"b", "plugin", 120, 30, 1, false});
+  StartupTrace::GetInstance()->Record({"a", "plugin", 110, 20, 2, true});
+  StartupTrace::GetInstance()->Record({"Start", "stage", 100, 100, 0, true});
+
+  auto spans = StartupTrace::GetInstance()->GetSpans();
+  ASSERT_EQ(3, spans.size());
+  ASSERT_EQ("Start", spans[0].name);
+  ASSERT_EQ("a", spans[1].name);
+  ASSERT_EQ("b", spans[2].name);
+
+  std::string path = "startup_trace_test.json";
+  ASSERT_TRUE(StartupTrace::GetInstance()->Dump(path));
+  std::ifstream ifs(path);
+  std::stringstream content;
+  content << ifs.rdbuf();
+
+  Json::Value root;
+  Json::Reader reader;
+  ASSERT_TRUE(reader.parse(content.str(), root));
+  const auto& events = root["traceEvents"];
+  ASSERT_EQ(3, events.size());
+  ASSERT_EQ("Start", events[0]["name"].asString());
+  ASSERT_EQ("stage", events[0]["cat"].asString());
+  ASSERT_EQ("X", events[0]["ph"].asString());
+  ASSERT_EQ(0, events[0]["ts"].asUInt64());
+  ASSERT_EQ(100, events[0]["dur"].asUInt64());
+  ASSERT_EQ(20, events[2]["ts"].asUInt64());
+  ASSERT_EQ(1, events[2]["tid"].asUInt());
+  ASSERT_FALSE(events[2]["args"]["ok"].asBool());
+
+  StartupTrace::GetInstance()->Clear();
+  ASSERT_TRUE(StartupTrace::GetInstance()->GetSpans().empty());
+}
+
+TEST(StartupTrace, ScopedStartupSpan) {
+  StartupTrace::GetInstance()->Clear();
+  {
+    ScopedStartupSpan span("Initialize", "stage");
+    span.SetFailed();
+  }
+
+  auto spans = StartupTrace::GetInstance()->GetSpans();
+  ASSERT_EQ(1, spans.size());
+  ASSERT_EQ("Initialize", spans[0].name);
+  ASSERT_EQ("stage", spans[0].category);
+  ASSERT_EQ(0, spans[0].lane);
+  ASSERT_FALSE(spans[0].ok);
+  ASSERT_GT(spans[0].begin_us, 0);
+}
+
+}  // namespace trpc::testing
@@ -25,8 +25,11 @@
 
 #include "gflags/gflags.h"
 
+#include "trpc/capture/traffic_capture.h"
+#include "trpc/common/startup_trace.h"
 #include "trpc/filter/server_filter_manager.h"
 #include "trpc/runtime/runtime.h"
+#include "trpc/transport/server/common/listener_handoff.h"
 #include "trpc/tvar/common/sampler.h"
 #include "trpc/util/chrono/chrono.h"
 #include "trpc/util/time.h"
@@ -36,6 +39,8 @@ namespace trpc {
 DEFINE_bool(trpc_version, false, "trpc cpp version flag");
 DEFINE_string(config, "trpc_cpp_default.yaml", "trpc cpp framework config file");
 DEFINE_bool(daemon, false, "run in daemon mode");
+DEFINE_string(config_snapshot_dir, "", "directory of the config snapshots to speed up loading config, unused if empty");
+DEFINE_bool(config_strict_client_services, false, "decode all the client services at startup and fail on a malformed one");
 
 static std::atomic_bool terminate_;
 
@@ -65,6 +70,11 @@ void TrpcApp::InitializeRuntime() {
   server_ = trpc::GetTrpcServer();
   server_->SetTerminateFunction([]() -> bool { return terminate_.load(std::memory_order_acquire); });
 
+  const GlobalConfig& global_config = TrpcConfig::GetInstance()->GetGlobalConfig();
+  if (!global_config.capture_path.empty()) {
+    capture::TrafficCapture::GetInstance()->Start(global_config.capture_path, global_config.capture_max_size);
+  }
+
   if (!runtime::StartRuntime()) {
     std::cerr << "StartRuntime Failed and Exit." << std::endl;
     TRPC_LOG_CRITICAL("StartRuntime Failed and Exit.");
@@ -88,31 +98,59 @@ void TrpcApp::DestroyRuntime() {
 
   server_->Destroy();
 
+  capture::TrafficCapture::GetInstance()->Stop();
+
   TrpcPlugin::GetInstance()->DestroyResource();
 }
 
 void TrpcApp::Execute() {
   uint64_t begin_time = trpc::time::GetMilliSeconds();
+  uint64_t begin_us = trpc::time::GetSteadyMicroSeconds();
 
   TrpcPlugin::GetInstance()->SetInvokeByFramework();
 
-  // register user custom plugin
-  RegisterPlugins();
+  {
+    // register user custom plugin
+    ScopedStartupSpan span("TrpcApp::RegisterPlugins", "stage");
+    RegisterPlugins();
+  }
 
-  // register framework inner plugin
-  TrpcPlugin::GetInstance()->RegisterPlugins();
+  {
+    // register framework inner plugin
+    ScopedStartupSpan span("TrpcPlugin::RegisterPlugins", "stage");
+    TrpcPlugin::GetInstance()->RegisterPlugins();
+  }
 
-  TRPC_ASSERT(server_->Initialize());
+  {
+    ScopedStartupSpan span("TrpcServer::Initialize", "stage");
+    TRPC_ASSERT(server_->Initialize());
+  }
   server_->SetTerminateFunction([]() -> bool { return terminate_.load(std::memory_order_acquire); });
 
-  int ret = Initialize();
+  // On hot restart, takes over the listening sockets of the old process before any service listens.
+  const ServerConfig& server_config = TrpcConfig::GetInstance()->GetServerConfig();
+  bool hot_restart = !server_config.hot_restart_path.empty();
+  if (hot_restart) {
+    ScopedStartupSpan span("ListenerHandoff::Takeover", "stage");
+    ListenerHandoff::GetInstance()->Takeover(server_config.hot_restart_path, server_config.hot_restart_timeout);
+  }
+
+  int ret = 0;
+  {
+    ScopedStartupSpan span("TrpcApp::Initialize", "stage");
+    ret = Initialize();
+  }
   if (ret != 0) {
     std::cerr << "Initialize Failed and Terminate Server." << std::endl;
     TRPC_LOG_CRITICAL("Initialize Failed and Terminate Server.");
 
     terminate_.store(true, std::memory_order_release);
   } else {
-    bool is_server_start_success = server_->Start();
+    bool is_server_start_success = false;
+    {
+      ScopedStartupSpan span("TrpcServer::Start", "stage");
+      is_server_start_success = server_->Start();
+    }
     if (!is_server_start_success) {
       std::cerr << "TrpcServer Start failed." << std::endl;
       TRPC_LOG_CRITICAL("TrpcServer Start failed.");
@@ -122,10 +160,32 @@ void TrpcApp::Execute() {
       std::cout << "Server InitializeRuntime use time:" << (trpc::time::GetMilliSeconds() - begin_time) << "(ms)"
                 << std::endl;
 
+      StartupTrace::GetInstance()->Record(
+          {"TrpcApp::Startup", "stage", begin_us, trpc::time::GetSteadyMicroSeconds() - begin_us, 0, true});
+      const std::string& startup_trace_path = TrpcConfig::GetInstance()->GetGlobalConfig().startup_trace_path;
+      if (!startup_trace_path.empty()) {
+        StartupTrace::GetInstance()->Dump(startup_trace_path);
+      }
+
+      if (hot_restart) {
+        // The old process stops listening and drains the requests in-flight once told, and so does this process when
+        // the next one takes over.
+        ListenerHandoff::GetInstance()->CompleteTakeover();
+        ListenerHandoff::GetInstance()->Serve(server_config.hot_restart_path,
+                                              [] { terminate_.store(true, std::memory_order_release); });
+      }
+
       server_->WaitForShutdown();
+
+      if (hot_restart) {
+        ListenerHandoff::GetInstance()->StopServing();
+      }
     }
   }
 
+  // The old process keeps serving if this one fails to start.
+  ListenerHandoff::GetInstance()->CancelTakeover();
+
   Destroy();
 
   TrpcPlugin::GetInstance()->UnregisterPlugins();
@@ -158,6 +218,8 @@ void TrpcApp::ParseFrameworkConfig(int argc, char* argv[]) {
     exit(-1);
   }
 
+  TrpcConfig::GetInstance()->SetSnapshotDir(FLAGS_config_snapshot_dir);
+  TrpcConfig::GetInstance()->SetStrictClientServices(FLAGS_config_strict_client_services);
   int ret = TrpcConfig::GetInstance()->Init(FLAGS_config);
   if (ret != 0) {
     std::cerr << "load config failed." << std::endl;
@@ -19,6 +19,8 @@
 #include "trpc/codec/client_codec_factory.h"
 #include "trpc/codec/codec_manager.h"
 #include "trpc/codec/server_codec_factory.h"
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/common/init_graph.h"
 #include "trpc/compressor/compressor_factory.h"
 #include "trpc/compressor/trpc_compressor.h"
 #include "trpc/config/config_factory.h"
@@ -147,42 +149,43 @@ void TrpcPlugin::CollectPlugins() {
 }
 
 void TrpcPlugin::InitPlugins() {
-  auto it = plugins_.begin();
-  while (it != plugins_.end()) {
-    PluginInfo& plugin_info = it->second;
-
-    InitPlugin(plugin_info);
+  // The plugins independent of each other are initialized in parallel.
+  InitGraph graph("plugin");
+  for (auto& [plugin_name, plugin_info] : plugins_) {
+    std::vector<std::string> dep_plugin_names;
+    plugin_info.plugin->GetDependencies(dep_plugin_names);
 
-    ++it;
-  }
-}
-
-void TrpcPlugin::InitPlugin(PluginInfo& plugin_info) {
-  if (plugin_info.is_inited) {
-    return;
-  }
-
-  // Init the dep plugins
-  std::vector<std::string> dep_plugin_names;
-  plugin_info.plugin->GetDependencies(dep_plugin_names);
-  if (!dep_plugin_names.empty()) {
+    std::vector<std::string> deps;
     for (const auto& name : dep_plugin_names) {
       auto it = FindPlugin(name);
       if (it == plugins_.end()) {
         TRPC_FMT_ERROR("plugin `{}` dependence plugin `{}` not found.", plugin_info.plugin->Name(), name);
         TRPC_ASSERT(false);
       }
-
-      InitPlugin(it->second);
+      deps.push_back(it->first);
     }
+
+    graph.AddStep(plugin_name, std::move(deps), [this, &plugin_info] { return InitPlugin(plugin_info); });
+  }
+
+  uint32_t parallelism = TrpcConfig::GetInstance()->GetGlobalConfig().plugin_init_parallelism;
+  if (!graph.Run(parallelism)) {
+    TRPC_FMT_ERROR("plugins init failed, plugins not inited: {}.", graph.GetFailedSteps().size());
+    TRPC_ASSERT(false);
+  }
+}
+
+bool TrpcPlugin::InitPlugin(PluginInfo& plugin_info) {
+  if (plugin_info.is_inited) {
+    return true;
   }
 
-  // Init self
   if (plugin_info.plugin->Init() != 0) {
     TRPC_FMT_ERROR("plugin {} init failed.", plugin_info.plugin->Name());
-    TRPC_ASSERT(false);
+    return false;
   }
   plugin_info.is_inited = true;
+  return true;
 }
 
 void TrpcPlugin::StartPlugins() {
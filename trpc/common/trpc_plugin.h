@@ -158,7 +158,7 @@ class TrpcPlugin {
 
   void CollectPlugins();
   void InitPlugins();
-  void InitPlugin(PluginInfo& plugin_info);
+  bool InitPlugin(PluginInfo& plugin_info);
   void StartPlugins();
   void StartPlugin(PluginInfo& plugin_info);
   void StopPlugins();
@@ -0,0 +1,97 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/retry_budget.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "trpc/util/concurrency/lightly_concurrent_hashmap.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+// Budgets of the callees, they are never destroyed so that the pointers handed out stay valid.
+concurrency::LightlyConcurrentHashMap<std::string, RetryBudget*>& GetBudgets() {
+  static auto* budgets = new concurrency::LightlyConcurrentHashMap<std::string, RetryBudget*>();
+  return *budgets;
+}
+
+}  // namespace
+
+RetryBudget* RetryBudget::Find(const std::string& callee) {
+  RetryBudget* budget = nullptr;
+  GetBudgets().Get(callee, budget);
+  return budget;
+}
+
+RetryBudget* RetryBudget::FindOrCreate(const std::string& callee, const RetryBudgetConfig& config) {
+  RetryBudget* budget = Find(callee);
+  if (TRPC_LIKELY(budget != nullptr)) {
+    return budget;
+  }
+
+  // Only the first calls of a callee get here, the lock makes sure that the budget(and its tvars) is created once.
+  static std::mutex mutex;
+  std::scoped_lock lock(mutex);
+  if (!GetBudgets().Get(callee, budget)) {
+    budget = new RetryBudget(callee, config);
+    GetBudgets().Insert(callee, budget);
+  }
+  return budget;
+}
+
+RetryBudget::RetryBudget(const std::string& callee, const RetryBudgetConfig& config)
+    : max_tokens_(static_cast<std::int64_t>(config.max_tokens) * kUnit),
+      deposit_tokens_(std::max<std::int64_t>(static_cast<std::int64_t>(config.retry_ratio * kUnit), 1)),
+      tokens_(max_tokens_),
+      group_(tvar::TrpcVarGroup::FindOrCreate("/trpc/client/" + callee + "/retry_budget")),
+      retries_(group_, "retries"),
+      rejected_(group_, "rejected") {
+  TRPC_ASSERT(config.max_tokens > 0);
+  TRPC_ASSERT(config.retry_ratio > 0 && config.retry_ratio <= 1);
+}
+
+void RetryBudget::Deposit() {
+  auto tokens = tokens_.load(std::memory_order_relaxed);
+  // A full budget is the common case of a healthy callee, it is checked first to avoid writing the shared cache line.
+  while (tokens < max_tokens_) {
+    if (tokens_.compare_exchange_weak(tokens, std::min(tokens + deposit_tokens_, max_tokens_),
+                                      std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+bool RetryBudget::TryWithdraw() {
+  auto tokens = tokens_.load(std::memory_order_relaxed);
+  while (tokens >= kUnit) {
+    if (tokens_.compare_exchange_weak(tokens, tokens - kUnit, std::memory_order_relaxed)) {
+      retries_.Increment();
+      return true;
+    }
+  }
+  rejected_.Increment();
+  return false;
+}
+
+void RetryBudget::Refund() {
+  auto tokens = tokens_.load(std::memory_order_relaxed);
+  while (!tokens_.compare_exchange_weak(tokens, std::min(tokens + kUnit, max_tokens_), std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace trpc
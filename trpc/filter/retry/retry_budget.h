@@ -0,0 +1,70 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "trpc/common/config/retry_conf.h"
+#include "trpc/tvar/basic_ops/reducer.h"
+
+namespace trpc {
+
+/// @brief Token bucket limiting the retries(including hedged requests) to a callee, so that retries can not amplify
+///        the load of an unhealthy callee. Each successful request deposits `retry_ratio` token and each retry
+///        withdraws one token, the budget is lock-free and shared by all fibers calling the callee.
+///        The withdrawals(`retries`) and the retries rejected by an exhausted budget(`rejected`) are exposed by tvar
+///        under `/trpc/client/{callee}/retry_budget`.
+class RetryBudget {
+ public:
+  /// @brief Get the budget of `callee`, created by `config` at the first time. All the callers of the same callee
+  ///        share the budget, the configs of the later callers are ignored.
+  /// @note Lock-free once the budget is created.
+  static RetryBudget* FindOrCreate(const std::string& callee, const RetryBudgetConfig& config);
+
+  /// @brief Get the budget of `callee`, it's lock-free.
+  /// @return nullptr if the budget is not created yet
+  static RetryBudget* Find(const std::string& callee);
+
+  RetryBudget(const std::string& callee, const RetryBudgetConfig& config);
+
+  /// @brief Deposit the budget for a successful request.
+  void Deposit();
+
+  /// @brief Withdraw one token for a retry.
+  /// @return false if the budget is exhausted, then the retry should be abandoned.
+  bool TryWithdraw();
+
+  /// @brief Give back the token withdrawn for a retry which is not sent at last(eg: the original request of a hedged
+  ///        call succeeds before the backup request is sent).
+  void Refund();
+
+  /// @brief Get the number of remaining tokens.
+  double GetTokens() const { return static_cast<double>(tokens_.load(std::memory_order_relaxed)) / kUnit; }
+
+ private:
+  // Tokens are kept in milli-tokens so that fractional deposits stay in integer arithmetic.
+  static constexpr std::int64_t kUnit = 1000;
+
+  const std::int64_t max_tokens_;
+  const std::int64_t deposit_tokens_;
+  std::atomic<std::int64_t> tokens_;
+
+  tvar::TrpcVarGroup* group_;
+  tvar::Counter<uint64_t> retries_;
+  tvar::Counter<uint64_t> rejected_;
+};
+
+}  // namespace trpc
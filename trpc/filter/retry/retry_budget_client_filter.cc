@@ -0,0 +1,89 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/retry_budget_client_filter.h"
+
+#include <memory>
+#include <string>
+
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+RetryBudgetClientFilter::RetryBudgetClientFilter(const RetryBudgetConfig* config) {
+  if (config != nullptr) {
+    config_ = *config;
+  }
+}
+
+std::vector<FilterPoint> RetryBudgetClientFilter::GetFilterPoint() {
+  std::vector<FilterPoint> points = {FilterPoint::CLIENT_PRE_RPC_INVOKE, FilterPoint::CLIENT_POST_RPC_INVOKE};
+  return points;
+}
+
+void RetryBudgetClientFilter::operator()(FilterStatus& status, FilterPoint point, const ClientContextPtr& context) {
+  switch (point) {
+    case FilterPoint::CLIENT_PRE_RPC_INVOKE:
+      if (context->IsBackupRequest()) {
+        if (GetBudget(context)->TryWithdraw()) {
+          context->SetFilterData(GetFilterID(), true);
+        } else {
+          TRPC_FMT_DEBUG("Cancel backup request due to exhausted retry budget");
+          context->CancelBackupRequest();
+        }
+      }
+      break;
+    case FilterPoint::CLIENT_POST_RPC_INVOKE: {
+      RetryBudget* budget = GetBudget(context);
+      if (context->GetStatus().OK()) {
+        budget->Deposit();
+      }
+      bool* withdrawn = context->GetFilterData<bool>(GetFilterID());
+      if (withdrawn != nullptr && *withdrawn) {
+        // The backup request may be cancelled by others(eg: selector) or not sent as the original request returns in
+        // time, the token is only consumed by a backup request actually sent.
+        if (!context->IsBackupRequest() || context->GetBackupRequestRetryInfo()->resend_count == 0) {
+          budget->Refund();
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+MessageClientFilterPtr RetryBudgetClientFilter::Create(const std::any& param) {
+  RetryBudgetConfig config;
+  if (param.has_value()) {
+    config = std::any_cast<RetryBudgetConfig>(param);
+  }
+
+  return std::make_shared<RetryBudgetClientFilter>(&config);
+}
+
+RetryBudget* RetryBudgetClientFilter::GetBudget(const ClientContextPtr& context) {
+  RetryBudget* budget = budget_.load(std::memory_order_acquire);
+  if (TRPC_LIKELY(budget != nullptr)) {
+    return budget;
+  }
+
+  const ServiceProxyOption* option = context->GetServiceProxyOption();
+  const std::string& callee = option != nullptr ? option->name : context->GetCalleeName();
+  budget = RetryBudget::FindOrCreate(callee, config_);
+  budget_.store(budget, std::memory_order_release);
+  return budget;
+}
+
+}  // namespace trpc
@@ -0,0 +1,52 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+
+#include "trpc/client/client_context.h"
+#include "trpc/common/config/retry_conf.h"
+#include "trpc/filter/client_filter_base.h"
+#include "trpc/filter/retry/retry_budget.h"
+
+namespace trpc {
+
+/// @brief The filter that makes the hedged(backup) requests and the retries of `InvokeWithRetry` to a callee share
+///        the same retry budget(see `RetryBudget`):
+///        1. Each successful call deposits the budget of the callee.
+///        2. A call with backup request withdraws one token from the budget before it is sent, the backup request is
+///        cancelled if the budget is exhausted. The token is given back if the backup request is not sent at last.
+class RetryBudgetClientFilter : public MessageClientFilter {
+ public:
+  explicit RetryBudgetClientFilter(const RetryBudgetConfig* config);
+
+  std::string Name() override { return kRetryBudgetFilter; }
+
+  std::vector<FilterPoint> GetFilterPoint() override;
+
+  void operator()(FilterStatus& status, FilterPoint point, const ClientContextPtr& context) override;
+
+  MessageClientFilterPtr Create(const std::any& param) override;
+
+ private:
+  RetryBudget* GetBudget(const ClientContextPtr& context);
+
+ private:
+  RetryBudgetConfig config_;
+
+  // Budget of the callee, looked up at the first call as the callee is unknown when the filter is created.
+  std::atomic<RetryBudget*> budget_{nullptr};
+};
+
+}  // namespace trpc
@@ -0,0 +1,83 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/retry_budget_client_filter.h"
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+namespace {
+
+ClientContextPtr MakeBackupRequestContext(const std::string& callee) {
+  auto context = MakeRefCounted<ClientContext>();
+  context->SetCalleeName(callee);
+  context->SetBackupRequestDelay(10);
+  return context;
+}
+
+}  // namespace
+
+TEST(RetryBudgetClientFilter, GetFilterPointAndCreate) {
+  RetryBudgetClientFilter filter(nullptr);
+  std::vector<FilterPoint> points = filter.GetFilterPoint();
+  ASSERT_EQ(points.size(), 2);
+  ASSERT_EQ(points[0], FilterPoint::CLIENT_PRE_RPC_INVOKE);
+
+  ASSERT_TRUE(filter.Create(std::any()) != nullptr);
+  ASSERT_TRUE(filter.Create(RetryBudgetConfig{}) != nullptr);
+}
+
+TEST(RetryBudgetClientFilter, operator) {
+  const std::string callee = "trpc.test.retry_budget.RetryBudgetClientFilter";
+  RetryBudgetConfig config;
+  config.max_tokens = 1;
+  config.retry_ratio = 0.5;
+  RetryBudgetClientFilter filter(nullptr);
+  auto budget_filter = filter.Create(config);
+  RetryBudget* budget = RetryBudget::FindOrCreate(callee, config);
+
+  FilterStatus status = FilterStatus::CONTINUE;
+  // The backup request is sent and fails, the token is consumed.
+  auto context = MakeBackupRequestContext(callee);
+  budget_filter->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+  ASSERT_TRUE(context->IsBackupRequest());
+  context->GetBackupRequestRetryInfo()->resend_count = 1;
+  context->SetStatus(Status(-1, "request fail"));
+  budget_filter->operator()(status, FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+  ASSERT_DOUBLE_EQ(0, budget->GetTokens());
+
+  // The budget is exhausted, the backup request is cancelled.
+  context = MakeBackupRequestContext(callee);
+  budget_filter->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+  ASSERT_FALSE(context->IsBackupRequest());
+  budget_filter->operator()(status, FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+  ASSERT_DOUBLE_EQ(0.5, budget->GetTokens());
+
+  // Successful calls refill the budget.
+  context = MakeBackupRequestContext(callee);
+  budget_filter->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+  ASSERT_FALSE(context->IsBackupRequest());
+  budget_filter->operator()(status, FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+  ASSERT_DOUBLE_EQ(1, budget->GetTokens());
+
+  // The original request succeeds in time, the token of the backup request is given back.
+  context = MakeBackupRequestContext(callee);
+  budget_filter->operator()(status, FilterPoint::CLIENT_PRE_RPC_INVOKE, context);
+  ASSERT_TRUE(context->IsBackupRequest());
+  ASSERT_DOUBLE_EQ(0, budget->GetTokens());
+  budget_filter->operator()(status, FilterPoint::CLIENT_POST_RPC_INVOKE, context);
+  ASSERT_DOUBLE_EQ(1, budget->GetTokens());
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,88 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/retry_budget.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(RetryBudget, WithdrawAndDeposit) {
+  RetryBudgetConfig config;
+  config.max_tokens = 2;
+  config.retry_ratio = 0.5;
+  RetryBudget budget("trpc.test.retry_budget.WithdrawAndDeposit", config);
+  ASSERT_DOUBLE_EQ(2, budget.GetTokens());
+
+  ASSERT_TRUE(budget.TryWithdraw());
+  ASSERT_TRUE(budget.TryWithdraw());
+  // Exhausted.
+  ASSERT_FALSE(budget.TryWithdraw());
+
+  // Two successful requests are needed for a retry.
+  budget.Deposit();
+  ASSERT_FALSE(budget.TryWithdraw());
+  budget.Deposit();
+  ASSERT_TRUE(budget.TryWithdraw());
+
+  budget.Refund();
+  ASSERT_DOUBLE_EQ(1, budget.GetTokens());
+
+  // Never exceed the capacity.
+  for (int i = 0; i < 10; ++i) {
+    budget.Deposit();
+  }
+  budget.Refund();
+  ASSERT_DOUBLE_EQ(2, budget.GetTokens());
+}
+
+TEST(RetryBudget, Concurrent) {
+  RetryBudgetConfig config;
+  config.max_tokens = 1000;
+  config.retry_ratio = 0.1;
+  RetryBudget budget("trpc.test.retry_budget.Concurrent", config);
+
+  std::vector<std::thread> threads;
+  std::atomic<int> withdrawn{0};
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 1000; ++j) {
+        withdrawn += budget.TryWithdraw();
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  ASSERT_EQ(1000, withdrawn);
+  ASSERT_DOUBLE_EQ(0, budget.GetTokens());
+}
+
+TEST(RetryBudget, FindOrCreate) {
+  ASSERT_EQ(nullptr, RetryBudget::Find("trpc.test.retry_budget.FindOrCreate"));
+
+  RetryBudgetConfig config;
+  RetryBudget* budget = RetryBudget::FindOrCreate("trpc.test.retry_budget.FindOrCreate", config);
+  ASSERT_TRUE(budget != nullptr);
+
+  config.max_tokens = 1;
+  ASSERT_EQ(budget, RetryBudget::FindOrCreate("trpc.test.retry_budget.FindOrCreate", config));
+  ASSERT_DOUBLE_EQ(100, budget->GetTokens());
+  ASSERT_EQ(budget, RetryBudget::Find("trpc.test.retry_budget.FindOrCreate"));
+}
+
+}  // namespace trpc::testing
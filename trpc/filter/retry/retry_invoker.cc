@@ -0,0 +1,156 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/retry_invoker.h"
+
+#include <algorithm>
+#include <any>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "trpc/client/make_client_context.h"
+#include "trpc/common/config/retry_conf.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/filter/retry/retry_budget.h"
+#include "trpc/filter/retry/retry_policy.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+namespace {
+
+const RetryBudgetConfig& GetRetryBudgetConfig(const ServiceProxyOption* option) {
+  auto iter = option->service_filter_configs.find(kRetryBudgetFilter);
+  if (iter != option->service_filter_configs.end()) {
+    return std::any_cast<const RetryBudgetConfig&>(iter->second);
+  }
+  static const RetryBudgetConfig kDefaultConfig;
+  return kDefaultConfig;
+}
+
+// The config is only looked up by the first calls of the callee, before its budget is created.
+RetryBudget* GetRetryBudget(const ServiceProxyOption* option) {
+  RetryBudget* budget = RetryBudget::Find(option->name);
+  if (TRPC_LIKELY(budget != nullptr)) {
+    return budget;
+  }
+  return RetryBudget::FindOrCreate(option->name, GetRetryBudgetConfig(option));
+}
+
+bool HasRetryBudgetFilter(const ServiceProxyOption* option) {
+  const auto& filters = option->service_filters;
+  return std::find(filters.begin(), filters.end(), kRetryBudgetFilter) != filters.end();
+}
+
+// Gets the timeout(ms) the service proxy applies to `context`, UINT32_MAX if there is none.
+uint32_t GetEffectiveTimeout(const ServiceProxyOption* option, const ClientContextPtr& context) {
+  uint32_t timeout = context->GetTimeout();
+  if (!context->IsIgnoreProxyTimeout()) {
+    timeout = std::min(timeout, option->timeout);
+  }
+  return timeout;
+}
+
+// Shortens the timeout of `context` to the time left of the whole call.
+void LimitTimeout(const ClientContextPtr& context, uint32_t left_ms) {
+  if (left_ms >= context->GetTimeout()) {
+    return;
+  }
+  if (context->IsUseFullLinkTimeout()) {
+    context->SetFullLinkTimeout(left_ms);
+  } else {
+    context->SetTimeout(left_ms, context->IsIgnoreProxyTimeout());
+  }
+}
+
+}  // namespace
+
+Status InvokeWithRetry(const Function<ClientContextPtr()>& make_context, const ServiceProxyPtr& proxy,
+                       const Function<Status(const ClientContextPtr&)>& call, bool idempotent) {
+  const ServiceProxyOption* option = proxy->GetServiceProxyOption();
+  // The filter deposits the budget for every call, including the ones invoked here.
+  bool deposit = !HasRetryBudgetFilter(option);
+
+  uint64_t begin_ms = trpc::time::GetSteadyMilliSeconds();
+  ClientContextPtr context = make_context();
+  uint32_t timeout = GetEffectiveTimeout(option, context);
+
+  Status status = call(context);
+  if (status.OK()) {
+    if (deposit) {
+      GetRetryBudget(option)->Deposit();
+    }
+    return status;
+  }
+
+  // Failures are the uncommon path, so that the policy is built here rather than for every call.
+  RetryPolicy policy(GetRetryBudgetConfig(option));
+  RetryBudget* budget = GetRetryBudget(option);
+
+  for (int attempt = 1; attempt < policy.GetMaxAttempts(); ++attempt) {
+    if (!policy.IsRetryable(status, idempotent)) {
+      break;
+    }
+
+    uint32_t backoff_ms = policy.GetBackoffMs(attempt);
+    if (timeout != UINT32_MAX) {
+      uint64_t cost_ms = trpc::time::GetSteadyMilliSeconds() - begin_ms;
+      uint64_t left_ms = cost_ms < timeout ? timeout - cost_ms : 0;
+      // Both the backoff and another attempt have to fit in the deadline of the whole call.
+      if (left_ms <= backoff_ms) {
+        TRPC_FMT_DEBUG("Abandon retry of {} due to insufficient time left: {}ms", option->name, left_ms);
+        break;
+      }
+    }
+
+    // The budget is withdrawn once the retry is certain to be sent.
+    if (!budget->TryWithdraw()) {
+      TRPC_FMT_DEBUG("Abandon retry of {} due to exhausted retry budget", option->name);
+      break;
+    }
+
+    if (backoff_ms > 0) {
+      FiberSleepFor(std::chrono::milliseconds(backoff_ms));
+    }
+
+    context = make_context();
+    if (timeout != UINT32_MAX) {
+      uint64_t cost_ms = trpc::time::GetSteadyMilliSeconds() - begin_ms;
+      LimitTimeout(context, cost_ms < timeout ? static_cast<uint32_t>(timeout - cost_ms) : 0);
+    }
+    status = call(context);
+    if (status.OK()) {
+      if (deposit) {
+        budget->Deposit();
+      }
+      break;
+    }
+  }
+
+  return status;
+}
+
+Status InvokeWithRetry(const ServerContextPtr& context, const ServiceProxyPtr& proxy,
+                       const Function<Status(const ClientContextPtr&)>& call, bool idempotent) {
+  return InvokeWithRetry([&context, &proxy]() { return MakeClientContext(context, proxy); }, proxy, call, idempotent);
+}
+
+Status InvokeWithRetry(const ServiceProxyPtr& proxy, const Function<Status(const ClientContextPtr&)>& call,
+                       bool idempotent) {
+  return InvokeWithRetry([&proxy]() { return MakeClientContext(proxy); }, proxy, call, idempotent);
+}
+
+}  // namespace trpc
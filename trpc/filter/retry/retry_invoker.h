@@ -0,0 +1,53 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "trpc/client/client_context.h"
+#include "trpc/client/service_proxy.h"
+#include "trpc/common/status.h"
+#include "trpc/server/server_context.h"
+#include "trpc/util/function.h"
+
+namespace trpc {
+
+/// @brief Invoke a call of `proxy` with retries. A failed attempt is retried after a jittered backoff if:
+///        1. Its status is eligible for retry(see `RetryPolicy`), with respect to `idempotent`.
+///        2. The number of attempts does not reach `max_attempts`.
+///        3. The retry budget of the callee is not exhausted(see `RetryBudget`).
+///        4. The remaining time of the whole call is longer than the backoff, so that another attempt has a chance.
+///        The retry config is `filter_config.retry_budget` of the service proxy, or the default one if not set. The
+///        budget is deposited by the `retry_budget` filter if it is configured for the service proxy(so that it is
+///        shared with the hedged requests), otherwise by the successful calls of `InvokeWithRetry` only.
+/// @param make_context creates the client context for each attempt, eg: `MakeClientContext(server_context, proxy)`
+/// @param proxy service proxy to invoke with
+/// @param call invokes the call with the client context created for each attempt, eg:
+///        `[&](const ClientContextPtr& ctx) { return proxy->SayHello(ctx, req, &rsp); }`
+/// @param idempotent whether the request can be handled more than once by the callee safely
+/// @return status of the last attempt
+/// @note The timeout of the first context(capped by the timeout of the service proxy) is the deadline of the whole
+///       call, the later attempts only have the time left after the backoff. The backoff is slept in the current
+///       fiber(or pthread outside the fiber runtime).
+Status InvokeWithRetry(const Function<ClientContextPtr()>& make_context, const ServiceProxyPtr& proxy,
+                       const Function<Status(const ClientContextPtr&)>& call, bool idempotent = false);
+
+/// @brief Same as above, with the client contexts created from `context` of the request being handled, so that the
+///        attempts inherit its full-link timeout, trans info and tracing.
+Status InvokeWithRetry(const ServerContextPtr& context, const ServiceProxyPtr& proxy,
+                       const Function<Status(const ClientContextPtr&)>& call, bool idempotent = false);
+
+/// @brief Same as above, with the client contexts created from `proxy` only.
+Status InvokeWithRetry(const ServiceProxyPtr& proxy, const Function<Status(const ClientContextPtr&)>& call,
+                       bool idempotent = false);
+
+}  // namespace trpc
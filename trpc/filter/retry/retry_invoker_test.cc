@@ -0,0 +1,183 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/retry_invoker.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/make_client_context.h"
+#include "trpc/client/service_proxy_option_setter.h"
+#include "trpc/client/testing/service_proxy_testing.h"
+#include "trpc/codec/trpc/trpc.pb.h"
+#include "trpc/codec/trpc/trpc_protocol.h"
+#include "trpc/common/config/retry_conf.h"
+#include "trpc/server/server_context.h"
+#include "trpc/util/time.h"
+
+namespace trpc::testing {
+
+namespace {
+
+TestServiceProxyPtr GetTestServiceProxy(const std::string& name, const RetryBudgetConfig& config) {
+  TestServiceProxyPtr service_proxy = std::make_shared<TestServiceProxy>();
+  auto proxy_option = std::make_shared<ServiceProxyOption>();
+  detail::SetDefaultOption(proxy_option);
+  proxy_option->name = name;
+  proxy_option->codec_name = "trpc";
+  proxy_option->service_filter_configs[kRetryBudgetFilter] = config;
+  service_proxy->SetServiceProxyOption(proxy_option);
+  return service_proxy;
+}
+
+RetryBudgetConfig GetRetryBudgetConfig() {
+  RetryBudgetConfig config;
+  config.base_backoff_ms = 1;
+  config.max_backoff_ms = 2;
+  return config;
+}
+
+}  // namespace
+
+class RetryInvokerTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() { RegisterPlugins(); }
+
+  static void TearDownTestCase() { UnregisterPlugins(); }
+};
+
+TEST_F(RetryInvokerTest, RetryUntilSuccess) {
+  auto proxy = GetTestServiceProxy("trpc.test.retry_invoker.RetryUntilSuccess", GetRetryBudgetConfig());
+  int attempts = 0;
+  Status status = InvokeWithRetry(proxy, [&](const ClientContextPtr& ctx) {
+    EXPECT_TRUE(ctx != nullptr);
+    if (++attempts < 3) {
+      return Status(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, 0, "overload");
+    }
+    return kSuccStatus;
+  });
+  ASSERT_TRUE(status.OK());
+  ASSERT_EQ(3, attempts);
+}
+
+TEST_F(RetryInvokerTest, Idempotent) {
+  auto proxy = GetTestServiceProxy("trpc.test.retry_invoker.Idempotent", GetRetryBudgetConfig());
+  int attempts = 0;
+  auto call = [&](const ClientContextPtr& ctx) {
+    ++attempts;
+    return Status(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, 0, "timeout");
+  };
+
+  // The callee may have handled the request, it is not retried unless the request is idempotent.
+  Status status = InvokeWithRetry(proxy, call);
+  ASSERT_EQ(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, status.GetFrameworkRetCode());
+  ASSERT_EQ(1, attempts);
+
+  attempts = 0;
+  status = InvokeWithRetry(proxy, call, true);
+  ASSERT_EQ(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, status.GetFrameworkRetCode());
+  ASSERT_EQ(3, attempts);
+}
+
+TEST_F(RetryInvokerTest, BudgetExhausted) {
+  RetryBudgetConfig config = GetRetryBudgetConfig();
+  config.max_tokens = 1;
+  auto proxy = GetTestServiceProxy("trpc.test.retry_invoker.BudgetExhausted", config);
+  int attempts = 0;
+  auto call = [&](const ClientContextPtr& ctx) {
+    ++attempts;
+    return Status(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, 0, "overload");
+  };
+
+  InvokeWithRetry(proxy, call);
+  ASSERT_EQ(2, attempts);
+
+  attempts = 0;
+  InvokeWithRetry(proxy, call);
+  ASSERT_EQ(1, attempts);
+}
+
+TEST_F(RetryInvokerTest, InheritServerContext) {
+  auto proxy = GetTestServiceProxy("trpc.test.retry_invoker.InheritServerContext", GetRetryBudgetConfig());
+  ServerContextPtr server_context = MakeRefCounted<ServerContext>();
+  server_context->SetRequestMsg(std::make_shared<TrpcRequestProtocol>());
+  server_context->SetRecvTimestampUs(trpc::time::GetMicroSeconds());
+  server_context->SetTimeout(1000);
+  server_context->AddReqTransInfo("key", "value");
+
+  int attempts = 0;
+  Status status = InvokeWithRetry(server_context, proxy, [&](const ClientContextPtr& ctx) {
+    const auto& trans_info = ctx->GetPbReqTransInfo();
+    auto iter = trans_info.find("key");
+    EXPECT_TRUE(iter != trans_info.end() && iter->second == "value");
+    EXPECT_LE(ctx->GetTimeout(), 1000);
+    if (++attempts < 2) {
+      return Status(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, 0, "overload");
+    }
+    return kSuccStatus;
+  });
+  ASSERT_TRUE(status.OK());
+  ASSERT_EQ(2, attempts);
+}
+
+TEST_F(RetryInvokerTest, Deadline) {
+  auto proxy = GetTestServiceProxy("trpc.test.retry_invoker.Deadline", GetRetryBudgetConfig());
+  uint32_t timeout = 1000;
+  auto make_context = [&]() {
+    ClientContextPtr ctx = MakeClientContext(proxy);
+    ctx->SetTimeout(timeout);
+    return ctx;
+  };
+
+  // The later attempts only have the time left of the whole call.
+  int attempts = 0;
+  Status status = InvokeWithRetry(make_context, proxy, [&](const ClientContextPtr& ctx) {
+    if (++attempts == 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      return Status(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, 0, "overload");
+    }
+    EXPECT_LE(ctx->GetTimeout(), 950);
+    return kSuccStatus;
+  });
+  ASSERT_TRUE(status.OK());
+  ASSERT_EQ(2, attempts);
+
+  // No retry once the deadline of the whole call is exceeded.
+  timeout = 20;
+  attempts = 0;
+  status = InvokeWithRetry(make_context, proxy, [&](const ClientContextPtr& ctx) {
+    ++attempts;
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    return Status(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, 0, "overload");
+  });
+  ASSERT_EQ(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, status.GetFrameworkRetCode());
+  ASSERT_EQ(1, attempts);
+}
+
+TEST_F(RetryInvokerTest, FuncCodeNotRetried) {
+  auto proxy = GetTestServiceProxy("trpc.test.retry_invoker.FuncCodeNotRetried", GetRetryBudgetConfig());
+  int attempts = 0;
+  // The business code of the callee equals the code of client invoke timeout.
+  Status status = InvokeWithRetry(proxy, [&](const ClientContextPtr& ctx) {
+    ++attempts;
+    return Status(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, "business error");
+  }, true);
+  ASSERT_EQ(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, status.GetFuncRetCode());
+  ASSERT_EQ(1, attempts);
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,67 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/retry_policy.h"
+
+#include <algorithm>
+
+#include "trpc/codec/trpc/trpc.pb.h"
+#include "trpc/util/algorithm/random.h"
+
+namespace trpc {
+
+RetryPolicy::RetryPolicy(const RetryBudgetConfig& config)
+    : max_attempts_(std::max(config.max_attempts, 1)),
+      base_backoff_ms_(std::max(config.base_backoff_ms, 0)),
+      max_backoff_ms_(std::max(config.max_backoff_ms, config.base_backoff_ms)),
+      retryable_codes_(config.retryable_codes),
+      idempotent_retryable_codes_(config.idempotent_retryable_codes),
+      retryable_func_codes_(config.retryable_func_codes) {
+  if (retryable_codes_.empty()) {
+    // The callee rejects these requests before handling them, so that retrying them is always safe.
+    retryable_codes_ = {TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, TrpcRetCode::TRPC_SERVER_LIMITED_ERR,
+                        TrpcRetCode::TRPC_CLIENT_CONNECT_ERR};
+  }
+  if (idempotent_retryable_codes_.empty()) {
+    idempotent_retryable_codes_ = {TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, TrpcRetCode::TRPC_CLIENT_NETWORK_ERR,
+                                   TrpcRetCode::TRPC_SERVER_TIMEOUT_ERR};
+  }
+}
+
+bool RetryPolicy::IsRetryable(const Status& status, bool idempotent) const {
+  if (status.OK()) {
+    return false;
+  }
+
+  if (int code = status.GetFrameworkRetCode(); code != 0) {
+    return Contains(retryable_codes_, code) || (idempotent && Contains(idempotent_retryable_codes_, code));
+  }
+  // The business codes of the callee may equal the framework ones, eg: 101, but mean something else.
+  return Contains(retryable_func_codes_, status.GetFuncRetCode());
+}
+
+uint32_t RetryPolicy::GetBackoffMs(int retry) const {
+  if (base_backoff_ms_ == 0 || retry <= 0) {
+    return 0;
+  }
+
+  // The shift is bounded to avoid overflow, the backoff is capped by `max_backoff_ms_` long before it anyway.
+  uint64_t backoff = static_cast<uint64_t>(base_backoff_ms_) << std::min(retry - 1, 20);
+  return Random<uint32_t>(0, static_cast<uint32_t>(std::min<uint64_t>(backoff, max_backoff_ms_)));
+}
+
+bool RetryPolicy::Contains(const std::vector<int>& codes, int code) {
+  return std::find(codes.begin(), codes.end(), code) != codes.end();
+}
+
+}  // namespace trpc
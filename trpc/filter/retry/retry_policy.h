@@ -0,0 +1,54 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "trpc/common/config/retry_conf.h"
+#include "trpc/common/status.h"
+
+namespace trpc {
+
+/// @brief Decides whether a failed call is retried and how long to back off before the retry.
+class RetryPolicy {
+ public:
+  explicit RetryPolicy(const RetryBudgetConfig& config);
+
+  /// @brief Whether the call failed with `status` is eligible for retry. The framework code is classified by the
+  ///        retryable codes, and the func code(set by the callee) only by the explicitly configured func codes.
+  /// @param idempotent whether the request can be handled more than once by the callee safely, only idempotent
+  ///        requests are retried when the callee may have handled the request(eg: timeout)
+  bool IsRetryable(const Status& status, bool idempotent) const;
+
+  /// @brief Get the backoff(ms) before the `retry`-th(starts from 1) retry, with full jitter to avoid the retries
+  ///        from many callers arriving at the same time.
+  uint32_t GetBackoffMs(int retry) const;
+
+  /// @brief Get the maximum number of attempts(including the first one) of a call.
+  int GetMaxAttempts() const { return max_attempts_; }
+
+ private:
+  static bool Contains(const std::vector<int>& codes, int code);
+
+ private:
+  int max_attempts_;
+  uint32_t base_backoff_ms_;
+  uint32_t max_backoff_ms_;
+  std::vector<int> retryable_codes_;
+  std::vector<int> idempotent_retryable_codes_;
+  std::vector<int> retryable_func_codes_;
+};
+
+}  // namespace trpc
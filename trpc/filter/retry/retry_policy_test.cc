@@ -0,0 +1,74 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/retry/retry_policy.h"
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/trpc/trpc.pb.h"
+
+namespace trpc::testing {
+
+TEST(RetryPolicy, IsRetryable) {
+  RetryPolicy policy(RetryBudgetConfig{});
+
+  ASSERT_FALSE(policy.IsRetryable(kSuccStatus, true));
+
+  Status overload(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR, 0, "overload");
+  ASSERT_TRUE(policy.IsRetryable(overload, false));
+  ASSERT_TRUE(policy.IsRetryable(overload, true));
+
+  Status timeout(TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, 0, "timeout");
+  ASSERT_FALSE(policy.IsRetryable(timeout, false));
+  ASSERT_TRUE(policy.IsRetryable(timeout, true));
+
+  Status decode(TrpcRetCode::TRPC_CLIENT_DECODE_ERR, 0, "decode");
+  ASSERT_FALSE(policy.IsRetryable(decode, true));
+
+  // Return codes of the callee are not classified as the framework ones, even if they are equal.
+  Status func(0, 1, "func error");
+  ASSERT_FALSE(policy.IsRetryable(func, true));
+  Status func_timeout(0, TrpcRetCode::TRPC_CLIENT_INVOKE_TIMEOUT_ERR, "func error");
+  ASSERT_FALSE(policy.IsRetryable(func_timeout, true));
+
+  RetryBudgetConfig config;
+  config.retryable_codes = {1};
+  RetryPolicy custom(config);
+  ASSERT_FALSE(custom.IsRetryable(func, false));
+  ASSERT_TRUE(custom.IsRetryable(Status(1, 0, "framework error"), false));
+  ASSERT_FALSE(custom.IsRetryable(overload, false));
+
+  config.retryable_func_codes = {1};
+  RetryPolicy func_retry(config);
+  ASSERT_TRUE(func_retry.IsRetryable(func, false));
+  ASSERT_FALSE(func_retry.IsRetryable(func_timeout, true));
+}
+
+TEST(RetryPolicy, GetBackoffMs) {
+  RetryBudgetConfig config;
+  config.max_attempts = 0;
+  config.base_backoff_ms = 10;
+  config.max_backoff_ms = 30;
+  RetryPolicy policy(config);
+  ASSERT_EQ(1, policy.GetMaxAttempts());
+
+  ASSERT_EQ(0, policy.GetBackoffMs(0));
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_LE(policy.GetBackoffMs(1), 10);
+    ASSERT_LE(policy.GetBackoffMs(2), 20);
+    ASSERT_LE(policy.GetBackoffMs(3), 30);
+    ASSERT_LE(policy.GetBackoffMs(100), 30);
+  }
+}
+
+}  // namespace trpc::testing
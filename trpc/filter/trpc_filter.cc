@@ -132,7 +132,7 @@ bool InitializeClientFilter() {
   }
 
   // 3. Put filters into the FilterManager in the order specified by the configuration.
-  std::vector<std::string> filter_names = trpc::TrpcConfig::GetInstance()->GetClientConfig().filters;
+  std::vector<std::string> filter_names = trpc::TrpcConfig::GetInstance()->GetClientFilters();
   for (auto& filter_name : filter_names) {
     auto filter = FilterManager::GetInstance()->GetMessageClientFilter(filter_name);
     if (filter != nullptr) {
@@ -133,6 +133,8 @@ void RpczServerFilter::PostSchedSendHandle(const trpc::ServerContextPtr& context
   if (ptr && ptr->sample_flag && ptr->span != nullptr) {
     ptr->span->SetSendRealUs(trpc::GetSystemMicroSeconds());
     ptr->span->SetErrorCode(context->GetStatus().GetFrameworkRetCode());
+    const auto& usage = context->GetResourceUsage();
+    ptr->span->SetResourceUsage(usage.cpu_time_us, usage.runnable_wait_us, usage.blocked_wait_us, usage.alloc_bytes);
     if (context->GetResponseMsg()) {
       ptr->span->SetResponseSize(context->GetResponseMsg()->GetMessageSize());
     }
@@ -287,6 +287,12 @@ std::string Span::ServerSpanToString() {
   span_info << trpc::TimeStringHelper::ConvertMicroSecsToStr(CallbackRealUs()) << "   " << leave_func_cost
             << "(us) leave customer func" << std::endl;
 
+  if (CpuTimeUs() || RunnableWaitUs() || BlockedWaitUs() || AllocBytes()) {
+    span_info << trpc::TimeStringHelper::ConvertMicroSecsToStr(CallbackRealUs()) << "   cpu " << CpuTimeUs()
+              << "(us), runnable wait " << RunnableWaitUs() << "(us), blocked wait " << BlockedWaitUs()
+              << "(us), alloc " << AllocBytes() << "(bytes)" << std::endl;
+  }
+
   span_info << trpc::TimeStringHelper::ConvertMicroSecsToStr(StartEncodeRealUs()) << "   "
             << (StartEncodeRealUs() - CallbackRealUs()) << "(us) start encode" << std::endl;
 
@@ -345,6 +351,8 @@ void Span::Display() {
      << std::endl;
   os << "error_code:" << ErrorCode() << std::endl;
   os << "response_size:" << ResponseSize() << std::endl;
+  os << "cpu_time_us:" << CpuTimeUs() << ", runnable_wait_us:" << RunnableWaitUs()
+     << ", blocked_wait_us:" << BlockedWaitUs() << ", alloc_bytes:" << AllocBytes() << std::endl;
   os << "viewer_name:" << ViewerName() << std::endl;
   os << "------------------------------------------" << std::endl;
   TRPC_FMT_DEBUG("Span info:{}", os.str());
@@ -187,6 +187,16 @@ class Span : public LinkNode<Span> {
   /// @private
   void SetErrorCode(int error_code) { error_code_ = error_code; }
 
+  /// @brief Set resources used by handling the request, only recorded with `resource_accounting` of the service.
+  /// @private
+  void SetResourceUsage(uint64_t cpu_time_us, uint64_t runnable_wait_us, uint64_t blocked_wait_us,
+                        uint64_t alloc_bytes) {
+    cpu_time_us_ = cpu_time_us;
+    runnable_wait_us_ = runnable_wait_us;
+    blocked_wait_us_ = blocked_wait_us;
+    alloc_bytes_ = alloc_bytes;
+  }
+
   /// @brief Set timestamp start to invoke rpc.
   /// @private
   void SetStartRpcInvokeRealUs(uint64_t tm) { start_rpc_invoke_real_us_ = tm + base_real_us_; }
@@ -375,6 +385,22 @@ class Span : public LinkNode<Span> {
   /// @private
   uint32_t ResponseSize() const { return response_size_; }
 
+  /// @brief Get cpu time(us) spent by handling the request.
+  /// @private
+  uint64_t CpuTimeUs() const { return cpu_time_us_; }
+
+  /// @brief Get time(us) the handling fiber waited for a worker while being runnable.
+  /// @private
+  uint64_t RunnableWaitUs() const { return runnable_wait_us_; }
+
+  /// @brief Get time(us) the handling fiber(or thread) was blocked.
+  /// @private
+  uint64_t BlockedWaitUs() const { return blocked_wait_us_; }
+
+  /// @brief Get bytes allocated from the framework memory pool by handling the request.
+  /// @private
+  uint64_t AllocBytes() const { return alloc_bytes_; }
+
   /// @brief Get custom logs appended by TRPC_RPCZ_PRINT.
   /// @private
   const std::string& CustomLogs() const { return custom_logs_; }
@@ -433,6 +459,12 @@ class Span : public LinkNode<Span> {
 
   uint32_t response_size_;
 
+  // Resources used by handling the request.
+  uint64_t cpu_time_us_{0};
+  uint64_t runnable_wait_us_{0};
+  uint64_t blocked_wait_us_{0};
+  uint64_t alloc_bytes_{0};
+
   // Base timestamp in microsecond.
   uint64_t base_real_us_{0};
 
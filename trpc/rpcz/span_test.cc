@@ -84,6 +84,12 @@ TEST(SpanTest, SetGetParamsTest) {
     span_ptr->SetErrorCode(0);
     ASSERT_EQ(span_ptr->ErrorCode(), 0);
 
+    span_ptr->SetResourceUsage(10, 20, 30, 4096);
+    ASSERT_EQ(span_ptr->CpuTimeUs(), 10);
+    ASSERT_EQ(span_ptr->RunnableWaitUs(), 20);
+    ASSERT_EQ(span_ptr->BlockedWaitUs(), 30);
+    ASSERT_EQ(span_ptr->AllocBytes(), 4096);
+
     span_ptr->SetLastLogRealUs(9999999999);
     ASSERT_EQ(span_ptr->LastLogRealUs(), 9999999999);
     trpc::object_pool::Delete<trpc::rpcz::Span>(span_ptr);
@@ -190,6 +196,16 @@ TEST(SpanTest, ServerSpanToString) {
   ASSERT_NE(p9, span_info.npos);
   std::string::size_type p10 = span_info.find("Send response(0) to trpc.app.server.greater(0.0.0.0:12345)");
   ASSERT_NE(p10, span_info.npos);
+  // Resource usage is not shown unless accounted.
+  ASSERT_EQ(span_info.find("blocked wait"), span_info.npos);
+
+  server_span->SetResourceUsage(10, 20, 30, 4096);
+  span_info = server_span->ServerSpanToString();
+  std::string::size_type p11 =
+      span_info.find("cpu 10(us), runnable wait 20(us), blocked wait 30(us), alloc 4096(bytes)");
+  ASSERT_NE(p11, span_info.npos);
+  ASSERT_LT(p5, p11);
+  ASSERT_LT(p11, span_info.find("start encode"));
   trpc::object_pool::Delete<trpc::rpcz::Span>(server_span);
 }
 
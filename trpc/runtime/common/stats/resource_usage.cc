@@ -0,0 +1,111 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/common/stats/resource_usage.h"
+
+#include <time.h>
+
+#include <chrono>
+
+#include "trpc/runtime/threadmodel/fiber/detail/fiber_entity.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
+#include "trpc/util/chrono/tsc.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+uint64_t ReadThreadCpuTimeNs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t ReadSteadyTimeNs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+fiber::detail::FiberEntity* GetAccountableFiberEntity() {
+  auto* fiber = fiber::detail::GetCurrentFiberEntity();
+  if (fiber == nullptr || fiber == fiber::detail::GetMasterFiberEntity()) {
+    return nullptr;
+  }
+  return fiber;
+}
+
+// The usage of the fiber so far, including the current run which has not been accumulated on switch out.
+fiber::detail::FiberResourceUsage ReadFiberResourceUsage(const fiber::detail::FiberEntity* fiber) {
+  auto usage = fiber->resource_usage;
+  auto now = ReadTsc();
+  usage.running_tsc += now > fiber->run_begin_tsc ? now - fiber->run_begin_tsc : 0;
+  usage.allocated_bytes += memory_pool::GetTlsAllocatedBytes() - fiber->run_begin_allocated_bytes;
+  return usage;
+}
+
+uint64_t TscToMicroSeconds(uint64_t tsc) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(DurationFromTsc(0, tsc)).count();
+}
+
+}  // namespace
+
+void ResourceUsageRecorder::Start() {
+  auto* fiber = GetAccountableFiberEntity();
+  fiber_ = fiber;
+  if (fiber) {
+    if (fiber->resource_accounting++ == 0) {
+      fiber->resource_usage = {};
+      fiber->run_begin_tsc = ReadTsc();
+      fiber->run_begin_allocated_bytes = memory_pool::GetTlsAllocatedBytes();
+    }
+    auto usage = ReadFiberResourceUsage(fiber);
+    running_ = usage.running_tsc;
+    runnable_wait_ = usage.runnable_wait_tsc;
+    blocked_wait_ = usage.blocked_wait_tsc;
+    allocated_bytes_ = usage.allocated_bytes;
+    return;
+  }
+
+  running_ = ReadThreadCpuTimeNs();
+  wall_ = ReadSteadyTimeNs();
+  allocated_bytes_ = memory_pool::GetTlsAllocatedBytes();
+}
+
+ResourceUsage ResourceUsageRecorder::Stop() {
+  ResourceUsage result;
+  if (fiber_) {
+    auto* fiber = static_cast<fiber::detail::FiberEntity*>(fiber_);
+    TRPC_ASSERT(fiber == fiber::detail::GetCurrentFiberEntity() && fiber->resource_accounting > 0);
+
+    auto usage = ReadFiberResourceUsage(fiber);
+    --fiber->resource_accounting;
+    fiber_ = nullptr;
+
+    result.cpu_time_us = TscToMicroSeconds(usage.running_tsc - running_);
+    result.runnable_wait_us = TscToMicroSeconds(usage.runnable_wait_tsc - runnable_wait_);
+    result.blocked_wait_us = TscToMicroSeconds(usage.blocked_wait_tsc - blocked_wait_);
+    result.alloc_bytes = usage.allocated_bytes - allocated_bytes_;
+    return result;
+  }
+
+  uint64_t cpu_ns = ReadThreadCpuTimeNs() - running_;
+  uint64_t wall_ns = ReadSteadyTimeNs() - wall_;
+  result.cpu_time_us = cpu_ns / 1000;
+  result.blocked_wait_us = wall_ns > cpu_ns ? (wall_ns - cpu_ns) / 1000 : 0;
+  result.alloc_bytes = memory_pool::GetTlsAllocatedBytes() - allocated_bytes_;
+  return result;
+}
+
+}  // namespace trpc
@@ -0,0 +1,61 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace trpc {
+
+/// @brief Resources used by a piece of work, eg: handling a request.
+struct ResourceUsage {
+  /// time(us) spent running on cpu
+  uint64_t cpu_time_us = 0;
+
+  /// time(us) spent waiting for a fiber worker while being runnable, always 0 outside fiber runtime
+  uint64_t runnable_wait_us = 0;
+
+  /// time(us) spent blocked, eg: waiting for a mutex, a timer or the response of a downstream call
+  uint64_t blocked_wait_us = 0;
+
+  /// bytes of the memory blocks allocated from the framework memory pool
+  uint64_t alloc_bytes = 0;
+};
+
+/// @brief Records the resources used by the current fiber(or thread outside fiber runtime) between `Start` and `Stop`,
+///        which must be called in the same fiber(or thread). Recorders can be nested.
+/// @note In fiber runtime, the time is measured by TSC at fiber switches, so cpu time includes the time the worker
+///       thread is preempted by the OS. Outside fiber runtime, cpu time is read by `CLOCK_THREAD_CPUTIME_ID` and the
+///       rest of the elapsed time is counted as blocked.
+class ResourceUsageRecorder {
+ public:
+  /// @brief Start recording.
+  void Start();
+
+  /// @brief Stop recording.
+  /// @return the resources used since `Start`
+  ResourceUsage Stop();
+
+ private:
+  // the fiber being accounted, null outside fiber runtime
+  void* fiber_{nullptr};
+
+  // readings at `Start`, in TSC ticks in fiber runtime and in nanoseconds outside
+  uint64_t running_{0};
+  uint64_t runnable_wait_{0};
+  uint64_t blocked_wait_{0};
+  uint64_t allocated_bytes_{0};
+  uint64_t wall_{0};
+};
+
+}  // namespace trpc
@@ -0,0 +1,84 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/common/stats/resource_usage_stats.h"
+
+#include <mutex>
+#include <utility>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+tvar::TrpcVarGroup* CreateMethodGroup(std::string_view method) {
+  // Method names start with '/', eg: "/trpc.test.helloworld.Greeter/SayHello".
+  std::string path = "/trpc/server/resource_usage";
+  if (method.empty() || method.front() != '/') {
+    path += '/';
+  }
+  path += method;
+  return tvar::TrpcVarGroup::FindOrCreate(path);
+}
+
+}  // namespace
+
+ResourceUsageStats::MethodStats::MethodStats(std::string_view method)
+    : group(CreateMethodGroup(method)),
+      requests(group, "requests"),
+      cpu_time_us(group, "cpu_time_us"),
+      runnable_wait_us(group, "runnable_wait_us"),
+      blocked_wait_us(group, "blocked_wait_us"),
+      alloc_bytes(group, "alloc_bytes") {}
+
+void ResourceUsageStats::Update(std::string_view method, const ResourceUsage& usage) {
+  if (method.empty()) {
+    return;
+  }
+
+  MethodStats* stats = FindOrCreate(method);
+  if (stats == nullptr) {
+    return;
+  }
+
+  stats->requests.Increment();
+  stats->cpu_time_us.Add(usage.cpu_time_us);
+  stats->runnable_wait_us.Add(usage.runnable_wait_us);
+  stats->blocked_wait_us.Add(usage.blocked_wait_us);
+  stats->alloc_bytes.Add(usage.alloc_bytes);
+}
+
+ResourceUsageStats::MethodStats* ResourceUsageStats::FindOrCreate(std::string_view method) {
+  std::string name(method);
+  {
+    std::shared_lock lock(mutex_);
+    if (auto it = methods_.find(name); it != methods_.end()) {
+      return it->second.get();
+    }
+  }
+
+  std::unique_lock lock(mutex_);
+  if (auto it = methods_.find(name); it != methods_.end()) {
+    return it->second.get();
+  }
+  if (methods_.size() >= kMaxMethods) {
+    TRPC_FMT_WARN_ONCE("too many methods to aggregate the resource usage, method: {}", method);
+    return nullptr;
+  }
+  auto* stats = new MethodStats(method);
+  methods_.emplace(std::move(name), std::unique_ptr<MethodStats>(stats));
+  return stats;
+}
+
+}  // namespace trpc
@@ -0,0 +1,62 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "trpc/runtime/common/stats/resource_usage.h"
+#include "trpc/tvar/basic_ops/reducer.h"
+
+namespace trpc {
+
+/// @brief Aggregates the resources used by the requests of each method, exposed by tvar under
+///        `/trpc/server/resource_usage/{method}`.
+class ResourceUsageStats {
+ public:
+  /// Methods beyond it are not aggregated, in case of unbounded names (eg: http paths).
+  static constexpr std::size_t kMaxMethods = 1024;
+
+  static ResourceUsageStats* GetInstance() {
+    static ResourceUsageStats instance;
+    return &instance;
+  }
+
+  /// @brief Add the resources used by a request of `method`.
+  void Update(std::string_view method, const ResourceUsage& usage);
+
+ private:
+  struct MethodStats {
+    explicit MethodStats(std::string_view method);
+
+    tvar::TrpcVarGroup* group;
+    tvar::Counter<uint64_t> requests;
+    tvar::Counter<uint64_t> cpu_time_us;
+    tvar::Counter<uint64_t> runnable_wait_us;
+    tvar::Counter<uint64_t> blocked_wait_us;
+    tvar::Counter<uint64_t> alloc_bytes;
+  };
+
+  MethodStats* FindOrCreate(std::string_view method);
+
+ private:
+  std::shared_mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<MethodStats>> methods_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,41 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/common/stats/resource_usage_stats.h"
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(ResourceUsageStatsTest, Update) {
+  ResourceUsage usage;
+  usage.cpu_time_us = 10;
+  usage.runnable_wait_us = 20;
+  usage.blocked_wait_us = 30;
+  usage.alloc_bytes = 4096;
+
+  auto* stats = ResourceUsageStats::GetInstance();
+  stats->Update("/trpc.test.helloworld.Greeter/SayHello", usage);
+  stats->Update("/trpc.test.helloworld.Greeter/SayHello", usage);
+  stats->Update("", usage);
+
+  auto method = tvar::TrpcVarGroup::TryGet("/trpc/server/resource_usage/trpc.test.helloworld.Greeter/SayHello");
+  ASSERT_TRUE(method);
+  ASSERT_EQ((*method)["requests"].asUInt64(), 2);
+  ASSERT_EQ((*method)["cpu_time_us"].asUInt64(), 20);
+  ASSERT_EQ((*method)["runnable_wait_us"].asUInt64(), 40);
+  ASSERT_EQ((*method)["blocked_wait_us"].asUInt64(), 60);
+  ASSERT_EQ((*method)["alloc_bytes"].asUInt64(), 8192);
+}
+
+}  // namespace trpc::testing
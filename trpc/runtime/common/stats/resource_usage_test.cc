@@ -0,0 +1,107 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/common/stats/resource_usage.h"
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/runtime/threadmodel/fiber/detail/fiber_entity.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
+#include "trpc/util/chrono/tsc.h"
+
+namespace trpc::testing {
+
+namespace {
+
+void BusyRun(std::chrono::microseconds duration) {
+  auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+void AllocateBlocks(int count) {
+  for (int i = 0; i < count; ++i) {
+    memory_pool::Deallocate(memory_pool::Allocate());
+  }
+}
+
+}  // namespace
+
+TEST(ResourceUsageRecorderTest, RecordInThread) {
+  ResourceUsageRecorder recorder;
+  recorder.Start();
+  BusyRun(std::chrono::milliseconds(5));
+  AllocateBlocks(2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ResourceUsage usage = recorder.Stop();
+
+  ASSERT_GE(usage.cpu_time_us, 3000);
+  ASSERT_GE(usage.blocked_wait_us, 8000);
+  ASSERT_EQ(usage.runnable_wait_us, 0);
+  ASSERT_EQ(usage.alloc_bytes, 2 * memory_pool::GetMemBlockSize());
+}
+
+TEST(ResourceUsageRecorderTest, RecordInFiber) {
+  using fiber::detail::FiberEntity;
+
+  fiber::detail::SetUpMasterFiberEntity();
+  FiberEntity* master = fiber::detail::GetMasterFiberEntity();
+
+  ResourceUsage usage;
+  ResourceUsage nested_usage;
+  FiberEntity* fiber = fiber::detail::CreateFiberEntity(nullptr, [&] {
+    ResourceUsageRecorder recorder;
+    recorder.Start();
+    AllocateBlocks(1);
+    BusyRun(std::chrono::milliseconds(2));
+
+    // Blocked for 5ms then runnable for 3ms.
+    master->Resume();
+
+    ResourceUsageRecorder nested_recorder;
+    nested_recorder.Start();
+    AllocateBlocks(1);
+    nested_usage = nested_recorder.Stop();
+
+    usage = recorder.Stop();
+    master->Resume();
+  });
+
+  fiber->Resume();
+  ASSERT_EQ(fiber->resource_accounting, 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  fiber->last_ready_tsc = ReadTsc();
+  std::this_thread::sleep_for(std::chrono::milliseconds(3));
+  fiber->Resume();
+
+  ASSERT_EQ(fiber->resource_accounting, 0);
+  ASSERT_EQ(fiber->resource_usage.switches, 1);
+  fiber::detail::FreeFiberEntity(fiber);
+
+  ASSERT_GE(usage.cpu_time_us, 1500);
+  ASSERT_LT(usage.cpu_time_us, 5000);
+  ASSERT_GE(usage.blocked_wait_us, 4000);
+  ASSERT_GE(usage.runnable_wait_us, 2000);
+  ASSERT_LT(usage.runnable_wait_us, usage.blocked_wait_us);
+  ASSERT_EQ(usage.alloc_bytes, 2 * memory_pool::GetMemBlockSize());
+
+  ASSERT_EQ(nested_usage.blocked_wait_us, 0);
+  ASSERT_EQ(nested_usage.runnable_wait_us, 0);
+  ASSERT_EQ(nested_usage.alloc_bytes, memory_pool::GetMemBlockSize());
+}
+
+}  // namespace trpc::testing
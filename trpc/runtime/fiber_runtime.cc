@@ -112,6 +112,10 @@ void StartRuntime() {
       options.stack_enable_guard_page = conf.fiber_stack_enable_guard_page;
       options.disable_process_name = global_config.thread_disable_process_name;
       options.enable_gdb_debug = conf.enable_gdb_debug;
+      options.stack_registry_path = conf.fiber_stack_registry_path;
+      options.deadline_aware_dispatch = conf.deadline_aware_dispatch;
+      options.fair_queuing = conf.fair_queuing;
+      options.max_running_handlers = conf.max_running_handlers;
     } else {
       options.group_name = "fiber_instance";
     }
@@ -20,10 +20,12 @@
 #include <utility>
 
 #include "trpc/runtime/iomodel/reactor/common/connection_handler.h"
+#include "trpc/runtime/iomodel/reactor/common/egress_shaper.h"
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
 #include "trpc/runtime/iomodel/reactor/common/io_message.h"
 #include "trpc/runtime/iomodel/reactor/common/network_address.h"
 #include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/runtime/iomodel/reactor/common/write_buffer_budget.h"
 #include "trpc/runtime/iomodel/reactor/event_handler.h"
 
 namespace trpc {
@@ -137,6 +139,19 @@ class alignas(8) Connection : public EventHandler {
   uint32_t GetSendQueueTimeout() const { return send_queue_timeout_; }
   void SetSendQueueTimeout(uint32_t send_queue_timeout) { send_queue_timeout_ = send_queue_timeout; }
 
+  /// @brief Get/Set the write buffer budget of the service(current fiber use), nullptr means not limited
+  const std::shared_ptr<WriteBufferBudget>& GetWriteBufferBudget() const { return write_buffer_budget_; }
+  void SetWriteBufferBudget(std::shared_ptr<WriteBufferBudget> budget) { write_buffer_budget_ = std::move(budget); }
+
+  /// @brief Get/Set the egress rate limit(bytes per second) of the connection(current fiber tcp use), 0 means not limited
+  uint64_t GetEgressRateLimit() const { return egress_rate_limit_; }
+  void SetEgressRateLimit(uint64_t egress_rate_limit) { egress_rate_limit_ = egress_rate_limit; }
+
+  /// @brief Get/Set the egress token bucket shared by the connections of the service(current fiber tcp use),
+  ///        nullptr means not limited
+  const std::shared_ptr<TokenBucket>& GetServiceEgressBucket() const { return service_egress_bucket_; }
+  void SetServiceEgressBucket(std::shared_ptr<TokenBucket> bucket) { service_egress_bucket_ = std::move(bucket); }
+
   /// @brief Get/Set self-define field
   std::any& GetUserAny() { return user_any_; }
   void SetUserAny(std::any&& user_data) { user_any_ = std::move(user_data); }
@@ -194,6 +209,16 @@ class alignas(8) Connection : public EventHandler {
   // when send queue exceeded the limit
   uint32_t send_queue_timeout_{10000000};
 
+  // The write buffer budget shared by the connections of the service(current fiber use)
+  std::shared_ptr<WriteBufferBudget> write_buffer_budget_;
+
+  // The egress rate limit(bytes per second) of the connection(current fiber tcp use)
+  // 0: not limited
+  uint64_t egress_rate_limit_{0};
+
+  // The egress token bucket shared by the connections of the service(current fiber tcp use)
+  std::shared_ptr<TokenBucket> service_egress_bucket_;
+
   // The timeout that check if the client connection has timed out(ms)
   // default 0, not check
   uint32_t check_connect_timeout_{0};
@@ -103,6 +103,10 @@ using NotifySendMsgFunction = std::function<void(const Connection*)>;
 ///        after the connection pipeline sends a message successfully
 using PipelineSendNotifyFunction = std::function<void(const IoMessage&)>;
 
+/// @brief The function that notifies the message
+///        which failed to be sent
+using MessageFailedFunction = std::function<void(const IoMessage&, ConnectionErrorCode)>;
+
 /// @brief Base class for connection hander
 ///        eg: protocol handshake/analysis/resource cleanup, etc.
 class ConnectionHandler {
@@ -170,6 +174,11 @@ class ConnectionHandler {
   ///        For redis pipeline use
   virtual uint32_t GetMergeRequestCount() { return 1; }
 
+  /// @brief Get the load(percent) of the requests multiplexed on the connection, 100 means no more requests can be
+  ///        sent right now. For the multiplexing protocols with a concurrency limit, eg: grpc
+  /// @return -1: unknown
+  virtual int GetLoad() { return -1; }
+
   /// @brief Set/Get some state information saved in the protocol parsing process
   ///        eg: handle http HEAD request
   virtual void SetCurrentContextExt(uint32_t context_ext) {}
@@ -0,0 +1,136 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/egress_shaper.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace trpc {
+
+namespace {
+
+int64_t ToNanos(std::chrono::steady_clock::time_point tp) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+}
+
+}  // namespace
+
+TokenBucket* TokenBucket::Global() {
+  static TokenBucket bucket;
+  return &bucket;
+}
+
+void TokenBucket::Reset(uint64_t rate, uint64_t burst) {
+  constexpr uint64_t kMinDefaultBurst = 64 * 1024;
+
+  rate_ = rate;
+  if (rate_ == 0) {
+    burst_ = 0;
+    nanos_per_byte_ = 0;
+    burst_nanos_ = 0;
+    return;
+  }
+
+  burst_ = burst != 0 ? burst : std::max(rate_ / 10, kMinDefaultBurst);
+  nanos_per_byte_ = 1e9 / static_cast<double>(rate_);
+  burst_nanos_ = BytesToNanos(burst_);
+  full_at_.store(0, std::memory_order_relaxed);
+}
+
+std::size_t TokenBucket::Available(std::chrono::steady_clock::time_point now) const {
+  if (!Enabled()) {
+    return std::numeric_limits<std::size_t>::max();
+  }
+
+  auto now_ns = ToNanos(now);
+  auto left_ns = now_ns + burst_nanos_ - std::max(full_at_.load(std::memory_order_relaxed), now_ns);
+  if (left_ns <= 0) {
+    return 0;
+  }
+  return std::min<uint64_t>(static_cast<uint64_t>(left_ns / nanos_per_byte_), burst_);
+}
+
+void TokenBucket::Consume(std::size_t bytes, std::chrono::steady_clock::time_point now) {
+  if (!Enabled() || bytes == 0) {
+    return;
+  }
+
+  auto now_ns = ToNanos(now);
+  auto cost = BytesToNanos(bytes);
+  auto full_at = full_at_.load(std::memory_order_relaxed);
+  while (!full_at_.compare_exchange_weak(full_at, std::max(full_at, now_ns) + cost, std::memory_order_relaxed)) {
+  }
+}
+
+std::chrono::nanoseconds TokenBucket::Delay(std::size_t bytes, std::chrono::steady_clock::time_point now) const {
+  if (!Enabled()) {
+    return std::chrono::nanoseconds(0);
+  }
+
+  auto now_ns = ToNanos(now);
+  auto cost = BytesToNanos(std::min<uint64_t>(bytes, burst_));
+  auto wait_ns = std::max(full_at_.load(std::memory_order_relaxed), now_ns) + cost - burst_nanos_ - now_ns;
+  return std::chrono::nanoseconds(std::max<int64_t>(wait_ns, 0));
+}
+
+void EgressShaper::Init(uint64_t conn_rate, std::shared_ptr<TokenBucket> service_bucket) {
+  bucket_num_ = 0;
+
+  conn_bucket_.Reset(conn_rate);
+  if (conn_bucket_.Enabled()) {
+    buckets_[bucket_num_++] = &conn_bucket_;
+  }
+
+  service_bucket_ = std::move(service_bucket);
+  if (service_bucket_ && service_bucket_->Enabled()) {
+    buckets_[bucket_num_++] = service_bucket_.get();
+  }
+
+  if (TokenBucket::Global()->Enabled()) {
+    buckets_[bucket_num_++] = TokenBucket::Global();
+  }
+}
+
+std::size_t EgressShaper::MinQuota(const TokenBucket* bucket) const {
+  return std::min<uint64_t>(kMinQuota, bucket->GetBurst());
+}
+
+std::size_t EgressShaper::GetQuota(std::size_t max_bytes, std::chrono::steady_clock::time_point now) const {
+  std::size_t quota = max_bytes;
+  for (std::size_t i = 0; i != bucket_num_; ++i) {
+    auto available = buckets_[i]->Available(now);
+    if (available < std::min(max_bytes, MinQuota(buckets_[i]))) {
+      return 0;
+    }
+    quota = std::min(quota, available);
+  }
+  return quota;
+}
+
+void EgressShaper::Consume(std::size_t bytes, std::chrono::steady_clock::time_point now) {
+  for (std::size_t i = 0; i != bucket_num_; ++i) {
+    buckets_[i]->Consume(bytes, now);
+  }
+}
+
+std::chrono::nanoseconds EgressShaper::GetDelay(std::chrono::steady_clock::time_point now) const {
+  std::chrono::nanoseconds delay(0);
+  for (std::size_t i = 0; i != bucket_num_; ++i) {
+    delay = std::max(delay, buckets_[i]->Delay(MinQuota(buckets_[i]), now));
+  }
+  return delay;
+}
+
+}  // namespace trpc
@@ -0,0 +1,105 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "trpc/util/align.h"
+
+namespace trpc {
+
+/// @brief A lock-free token bucket limiting the bytes sent per second.
+///        It's implemented by GCRA(generic cell rate algorithm), the state is a single timestamp: the time when the
+///        bucket becomes full again.
+class TokenBucket {
+ public:
+  /// @param rate bytes per second, 0 means not limited.
+  /// @param burst the max bytes can be sent at once, 0 means the bytes of 100ms(at least 64KB).
+  explicit TokenBucket(uint64_t rate = 0, uint64_t burst = 0) { Reset(rate, burst); }
+
+  /// @brief The bucket of the whole process, set by `global.egress_rate_limit`.
+  static TokenBucket* Global();
+
+  /// @brief Reset the rate and the burst, it must be called before the bucket is used.
+  void Reset(uint64_t rate, uint64_t burst = 0);
+
+  bool Enabled() const { return rate_ != 0; }
+
+  uint64_t GetRate() const { return rate_; }
+  uint64_t GetBurst() const { return burst_; }
+
+  /// @brief Get the bytes can be sent at `now`.
+  std::size_t Available(std::chrono::steady_clock::time_point now) const;
+
+  /// @brief Charge the bytes sent, the bucket may go into debt if more than `Available` is sent.
+  void Consume(std::size_t bytes, std::chrono::steady_clock::time_point now);
+
+  /// @brief Get how long to wait from `now` until `bytes`(no more than the burst) can be sent.
+  std::chrono::nanoseconds Delay(std::size_t bytes, std::chrono::steady_clock::time_point now) const;
+
+ private:
+  int64_t BytesToNanos(std::size_t bytes) const { return static_cast<int64_t>(bytes * nanos_per_byte_); }
+
+ private:
+  uint64_t rate_{0};
+  uint64_t burst_{0};
+  double nanos_per_byte_{0};
+  int64_t burst_nanos_{0};
+
+  // The time(ns since the epoch of the steady clock) when the bucket becomes full.
+  alignas(hardware_destructive_interference_size) std::atomic<int64_t> full_at_{0};
+};
+
+/// @brief Shapes the egress bandwidth of a connection by the token buckets of the connection itself, of the service
+///        it belongs to and of the whole process. The bytes sent are charged to all of them.
+class EgressShaper {
+ public:
+  /// @brief Set the buckets, the ones not enabled are ignored. The bucket of the whole process(`TokenBucket::Global()`)
+  ///        is applied if it's enabled.
+  /// @param conn_rate bytes per second of the connection, 0 means not limited.
+  /// @param service_bucket the bucket shared by the connections of the service, may be nullptr.
+  void Init(uint64_t conn_rate, std::shared_ptr<TokenBucket> service_bucket);
+
+  bool Enabled() const { return bucket_num_ != 0; }
+
+  /// @brief Get the bytes can be sent at `now`, at most `max_bytes`.
+  /// @note  0 is returned rather than a few bytes, to avoid writing the data out in tiny pieces.
+  std::size_t GetQuota(std::size_t max_bytes, std::chrono::steady_clock::time_point now) const;
+
+  /// @brief Charge the bytes sent.
+  void Consume(std::size_t bytes, std::chrono::steady_clock::time_point now);
+
+  /// @brief Get how long to wait from `now` until a non-zero quota is available.
+  std::chrono::nanoseconds GetDelay(std::chrono::steady_clock::time_point now) const;
+
+ private:
+  // The minimum bytes of a write when shaped.
+  static constexpr std::size_t kMinQuota = 4096;
+
+  std::size_t MinQuota(const TokenBucket* bucket) const;
+
+ private:
+  TokenBucket conn_bucket_;
+  std::shared_ptr<TokenBucket> service_bucket_;
+
+  std::array<TokenBucket*, 3> buckets_{};
+  std::size_t bucket_num_{0};
+};
+
+}  // namespace trpc
@@ -0,0 +1,100 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/egress_shaper.h"
+
+#include <limits>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+using namespace std::literals;
+
+namespace trpc::testing {
+
+TEST(TokenBucket, NotLimited) {
+  TokenBucket bucket;
+  auto now = std::chrono::steady_clock::now();
+  ASSERT_FALSE(bucket.Enabled());
+  ASSERT_EQ(std::numeric_limits<std::size_t>::max(), bucket.Available(now));
+  bucket.Consume(1024, now);
+  ASSERT_EQ(0ns, bucket.Delay(1024, now));
+}
+
+TEST(TokenBucket, DefaultBurst) {
+  ASSERT_EQ(64 * 1024, TokenBucket(1000).GetBurst());
+  ASSERT_EQ(1000000, TokenBucket(10000000).GetBurst());
+  ASSERT_EQ(100, TokenBucket(1000, 100).GetBurst());
+}
+
+TEST(TokenBucket, ConsumeAndRefill) {
+  // 1 byte per microsecond.
+  TokenBucket bucket(1000000, 1000);
+  auto now = std::chrono::steady_clock::now();
+
+  ASSERT_EQ(1000, bucket.Available(now));
+  bucket.Consume(600, now);
+  ASSERT_EQ(400, bucket.Available(now));
+  ASSERT_EQ(0ns, bucket.Delay(400, now));
+  ASSERT_EQ(100us, bucket.Delay(500, now));
+
+  // Go into debt.
+  bucket.Consume(600, now);
+  ASSERT_EQ(0, bucket.Available(now));
+  ASSERT_EQ(201us, bucket.Delay(1, now));
+
+  ASSERT_EQ(100, bucket.Available(now + 300us));
+  ASSERT_EQ(1000, bucket.Available(now + 10ms));
+}
+
+TEST(EgressShaper, Hierarchy) {
+  TokenBucket::Global()->Reset(0);
+
+  EgressShaper shaper;
+  shaper.Init(0, nullptr);
+  ASSERT_FALSE(shaper.Enabled());
+  ASSERT_EQ(12345, shaper.GetQuota(12345, std::chrono::steady_clock::now()));
+
+  // The service is slower than the connection.
+  auto service_bucket = std::make_shared<TokenBucket>(1000000, 10000);
+  shaper.Init(2000000, service_bucket);
+  ASSERT_TRUE(shaper.Enabled());
+
+  auto now = std::chrono::steady_clock::now();
+  ASSERT_EQ(5000, shaper.GetQuota(5000, now));
+  ASSERT_EQ(10000, shaper.GetQuota(1000000, now));
+  shaper.Consume(10000, now);
+  ASSERT_EQ(0, shaper.GetQuota(1000000, now));
+  ASSERT_EQ(0, service_bucket->Available(now));
+
+  // Tiny quota is not granted, wait for a larger one.
+  ASSERT_EQ(0, shaper.GetQuota(1000000, now + 1ms));
+  ASSERT_EQ(4096us, shaper.GetDelay(now));
+  ASSERT_EQ(4096, shaper.GetQuota(1000000, now + 4096us));
+  // Small writes are not delayed.
+  ASSERT_EQ(100, shaper.GetQuota(100, now + 1ms));
+}
+
+TEST(EgressShaper, Global) {
+  TokenBucket::Global()->Reset(1000000, 8192);
+
+  EgressShaper shaper;
+  shaper.Init(0, nullptr);
+  ASSERT_TRUE(shaper.Enabled());
+  auto now = std::chrono::steady_clock::now();
+  ASSERT_EQ(8192, shaper.GetQuota(1000000, now));
+
+  TokenBucket::Global()->Reset(0);
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,503 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/shm_channel.h"
+
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+constexpr uint32_t kShmMagic = 0x5452534d;  // "TRSM"
+constexpr uint32_t kShmVersion = 1;
+
+constexpr std::size_t kMinRingCapacity = 64 * 1024;
+constexpr std::size_t kMaxRingCapacity = 1UL << 30;
+
+// The area before the data of rings, holds `SegmentHeader` and two `RingHeader`s.
+constexpr std::size_t kHeaderAreaSize = 4096;
+
+constexpr std::size_t kRecordAlignment = 8;
+
+// Do not leave a fragment smaller than this at the end of the ring, wrap around instead.
+constexpr std::size_t kMinRecordPayload = 1024;
+
+// Flags of records.
+constexpr uint32_t kRecordPadding = 1;
+constexpr uint32_t kRecordReleased = 2;
+
+struct SegmentHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t ring_capacity;
+};
+
+struct RecordHeader {
+  uint32_t size;
+  std::atomic<uint32_t> flags;
+};
+
+static_assert(sizeof(RecordHeader) == kRecordAlignment);
+
+struct Handshake {
+  uint32_t magic;
+  uint32_t version;
+};
+
+inline std::size_t AlignUp(std::size_t n, std::size_t alignment) { return (n + alignment - 1) & ~(alignment - 1); }
+
+inline std::size_t RecordSize(std::size_t payload) { return AlignUp(sizeof(RecordHeader) + payload, kRecordAlignment); }
+
+inline std::size_t RoundUpPowerOfTwo(std::size_t n) {
+  std::size_t v = 1;
+  while (v < n) {
+    v <<= 1;
+  }
+  return v;
+}
+
+inline std::size_t SegmentSize(std::size_t ring_capacity) { return kHeaderAreaSize + 2 * ring_capacity; }
+
+}  // namespace
+
+// The producer and the consumer owned fields are kept in different cache lines.
+struct ShmChannel::RingHeader {
+  // Written by the producer.
+  alignas(64) std::atomic<uint64_t> tail;
+  std::atomic<uint32_t> producer_waiting;
+
+  // Written by the consumer.
+  alignas(64) std::atomic<uint64_t> head;
+  std::atomic<uint32_t> consumer_waiting;
+};
+
+static_assert(sizeof(SegmentHeader) <= 64);
+
+namespace {
+
+std::string GetShmRendezvousDir() { return "/tmp/trpc_shm_" + std::to_string(::geteuid()); }
+
+}  // namespace
+
+bool PrepareShmRendezvousDir() {
+  std::string dir = GetShmRendezvousDir();
+  if (::mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST) {
+    TRPC_LOG_ERROR("create shm rendezvous dir " << dir << " failed, errno:" << errno << ", msg:" << strerror(errno));
+    return false;
+  }
+
+  // The directory may be created by others in advance, so that they can accept the segments of this user.
+  struct stat st;
+  if (::lstat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode) || st.st_uid != ::geteuid() ||
+      (st.st_mode & (S_IRWXG | S_IRWXO)) != 0) {
+    TRPC_LOG_ERROR("shm rendezvous dir " << dir << " must be a directory owned by uid " << ::geteuid()
+                                         << " and not accessible by others");
+    return false;
+  }
+
+  return true;
+}
+
+UnixAddress GetShmRendezvousAddress(const NetworkAddress& addr) {
+  std::string path = GetShmRendezvousDir() + "/" + addr.Ip() + "_" + std::to_string(addr.Port()) + ".sock";
+  return UnixAddress(path.c_str());
+}
+
+ShmChannel::ShmChannel(char* base, std::size_t mapped_size, std::size_t ring_capacity, bool is_client)
+    : base_(base), mapped_size_(mapped_size), capacity_(ring_capacity) {
+  // Ring 0 is from client to server, ring 1 is from server to client.
+  Ring rings[2];
+  for (int i = 0; i < 2; ++i) {
+    rings[i].header = reinterpret_cast<RingHeader*>(base_ + 64 + i * sizeof(RingHeader));
+    rings[i].data = base_ + kHeaderAreaSize + i * capacity_;
+  }
+  tx_ = is_client ? rings[0] : rings[1];
+  rx_ = is_client ? rings[1] : rings[0];
+
+  read_cursor_.store(rx_.header->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+ShmChannel::~ShmChannel() {
+  if (memfd_ >= 0) {
+    ::close(memfd_);
+  }
+  ::munmap(base_, mapped_size_);
+}
+
+RefPtr<ShmChannel> ShmChannel::Create(std::size_t ring_capacity) {
+  static_assert(kHeaderAreaSize >= 64 + 2 * sizeof(RingHeader));
+
+  ring_capacity = RoundUpPowerOfTwo(std::clamp(ring_capacity, kMinRingCapacity, kMaxRingCapacity));
+  std::size_t size = SegmentSize(ring_capacity);
+
+  int fd = ::memfd_create("trpc_shm", MFD_CLOEXEC);
+  if (fd < 0) {
+    TRPC_LOG_ERROR("memfd_create failed, errno:" << errno << ", msg:" << strerror(errno));
+    return nullptr;
+  }
+
+  if (::ftruncate(fd, size) != 0) {
+    TRPC_LOG_ERROR("ftruncate shm segment failed, errno:" << errno << ", msg:" << strerror(errno));
+    ::close(fd);
+    return nullptr;
+  }
+
+  void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+  if (base == MAP_FAILED) {
+    TRPC_LOG_ERROR("mmap shm segment failed, errno:" << errno << ", msg:" << strerror(errno));
+    ::close(fd);
+    return nullptr;
+  }
+
+  // A new memfd is zero-filled, so are the heads and tails of rings.
+  auto* segment = static_cast<SegmentHeader*>(base);
+  segment->magic = kShmMagic;
+  segment->version = kShmVersion;
+  segment->ring_capacity = ring_capacity;
+
+  auto channel = RefPtr<ShmChannel>(adopt_ptr, new ShmChannel(static_cast<char*>(base), size, ring_capacity, true));
+  channel->memfd_ = fd;
+  // Both consumers are idle until the first doorbell.
+  channel->tx_.header->consumer_waiting.store(1, std::memory_order_relaxed);
+  channel->rx_.header->consumer_waiting.store(1, std::memory_order_relaxed);
+
+  return channel;
+}
+
+RefPtr<ShmChannel> ShmChannel::Attach(int memfd) {
+  struct stat st;
+  if (::fstat(memfd, &st) != 0 || static_cast<std::size_t>(st.st_size) < kHeaderAreaSize) {
+    TRPC_LOG_ERROR("invalid shm segment, fd:" << memfd);
+    ::close(memfd);
+    return nullptr;
+  }
+
+  std::size_t size = st.st_size;
+  void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, memfd, 0);
+  ::close(memfd);
+  if (base == MAP_FAILED) {
+    TRPC_LOG_ERROR("mmap shm segment failed, errno:" << errno << ", msg:" << strerror(errno));
+    return nullptr;
+  }
+
+  auto* segment = static_cast<SegmentHeader*>(base);
+  std::size_t ring_capacity = segment->ring_capacity;
+  if (segment->magic != kShmMagic || segment->version != kShmVersion || ring_capacity < kMinRingCapacity ||
+      ring_capacity > kMaxRingCapacity || (ring_capacity & (ring_capacity - 1)) != 0 ||
+      SegmentSize(ring_capacity) != size) {
+    TRPC_LOG_ERROR("invalid shm segment, magic:" << segment->magic << ", version:" << segment->version
+                                                 << ", ring capacity:" << ring_capacity << ", size:" << size);
+    ::munmap(base, size);
+    return nullptr;
+  }
+
+  return RefPtr<ShmChannel>(adopt_ptr, new ShmChannel(static_cast<char*>(base), size, ring_capacity, false));
+}
+
+bool ShmChannel::SendHandshake(int sock_fd) {
+  TRPC_ASSERT(memfd_ >= 0);
+
+  Handshake handshake{.magic = kShmMagic, .version = kShmVersion};
+  iovec iov{.iov_base = &handshake, .iov_len = sizeof(handshake)};
+
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {0};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(cmsg), &memfd_, sizeof(int));
+
+  if (::sendmsg(sock_fd, &msg, MSG_NOSIGNAL) != sizeof(handshake)) {
+    TRPC_LOG_ERROR("send shm handshake failed, errno:" << errno << ", msg:" << strerror(errno));
+    return false;
+  }
+
+  // The server holds its own reference of the segment now.
+  ::close(memfd_);
+  memfd_ = -1;
+
+  return true;
+}
+
+int ShmChannel::RecvHandshake(int sock_fd) {
+  Handshake handshake{};
+  iovec iov{.iov_base = &handshake, .iov_len = sizeof(handshake)};
+
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {0};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t n = ::recvmsg(sock_fd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+  if (n < 0) {
+    return -1;
+  }
+
+  int memfd = -1;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+      cmsg->cmsg_len == CMSG_LEN(sizeof(int))) {
+    memcpy(&memfd, CMSG_DATA(cmsg), sizeof(int));
+  }
+
+  if (n != sizeof(handshake) || handshake.magic != kShmMagic || handshake.version != kShmVersion || memfd < 0 ||
+      (msg.msg_flags & MSG_CTRUNC)) {
+    TRPC_LOG_ERROR("invalid shm handshake, size:" << n << ", magic:" << handshake.magic
+                                                  << ", version:" << handshake.version);
+    if (memfd >= 0) {
+      ::close(memfd);
+    }
+    errno = n == 0 ? ECONNRESET : EPROTO;
+    return -1;
+  }
+
+  return memfd;
+}
+
+void ShmChannel::SetDoorbellFd(int fd) {
+  std::scoped_lock _(doorbell_lock_);
+  doorbell_fd_ = fd;
+}
+
+void ShmChannel::RingDoorbell() {
+  std::scoped_lock _(doorbell_lock_);
+  if (doorbell_fd_ >= 0) {
+    // The peer drains all bytes on wakeup, so a failure (the socket buffer is full of doorbells, or the peer is gone)
+    // can be ignored safely.
+    char c = 0;
+    ::send(doorbell_fd_, &c, 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+  }
+}
+
+int ShmChannel::Writev(const iovec* iov, int iovcnt) {
+  std::size_t total = 0;
+  for (int i = 0; i < iovcnt; ++i) {
+    total += iov[i].iov_len;
+  }
+  if (TRPC_UNLIKELY(total == 0)) {
+    return 0;
+  }
+
+  RingHeader* header = tx_.header;
+  const uint64_t mask = capacity_ - 1;
+  uint64_t tail = header->tail.load(std::memory_order_relaxed);
+  uint64_t head = header->head.load(std::memory_order_acquire);
+
+  std::size_t written = 0;
+  int iov_index = 0;
+  std::size_t iov_offset = 0;
+  while (written < total) {
+    std::size_t free = capacity_ - (tail - head);
+    std::size_t pos = tail & mask;
+    std::size_t contiguous = capacity_ - pos;
+    std::size_t left = total - written;
+
+    if (contiguous < sizeof(RecordHeader) + std::min(left, kMinRecordPayload)) {
+      // Too little space at the end of the ring, skip it so that the record is not split into small pieces.
+      if (free < contiguous) {
+        break;
+      }
+      auto* padding = reinterpret_cast<RecordHeader*>(tx_.data + pos);
+      padding->size = contiguous - sizeof(RecordHeader);
+      padding->flags.store(kRecordPadding, std::memory_order_relaxed);
+      tail += contiguous;
+      free -= contiguous;
+      pos = 0;
+      contiguous = capacity_;
+    }
+
+    std::size_t avail = std::min(free, contiguous);
+    if (avail <= sizeof(RecordHeader)) {
+      break;
+    }
+
+    std::size_t payload = std::min(left, avail - sizeof(RecordHeader));
+    auto* record = reinterpret_cast<RecordHeader*>(tx_.data + pos);
+    char* dst = tx_.data + pos + sizeof(RecordHeader);
+    for (std::size_t copied = 0; copied < payload;) {
+      std::size_t n = std::min(payload - copied, iov[iov_index].iov_len - iov_offset);
+      memcpy(dst + copied, static_cast<const char*>(iov[iov_index].iov_base) + iov_offset, n);
+      copied += n;
+      iov_offset += n;
+      if (iov_offset == iov[iov_index].iov_len) {
+        ++iov_index;
+        iov_offset = 0;
+      }
+    }
+    record->size = payload;
+    record->flags.store(0, std::memory_order_relaxed);
+
+    tail += RecordSize(payload);
+    written += payload;
+  }
+
+  if (tail != header->tail.load(std::memory_order_relaxed)) {
+    header->tail.store(tail, std::memory_order_release);
+
+    // Pairs with the fence in `PrepareWaitReadable`: either we see the consumer is waiting, or it sees the new tail.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->consumer_waiting.load(std::memory_order_relaxed) &&
+        header->consumer_waiting.exchange(0, std::memory_order_relaxed)) {
+      RingDoorbell();
+    }
+  }
+
+  if (written == 0) {
+    errno = EAGAIN;
+    return -1;
+  }
+
+  return written;
+}
+
+std::size_t ShmChannel::Read(NoncontiguousBuffer& buffer, std::size_t max_bytes) {
+  RingHeader* header = rx_.header;
+  const uint64_t mask = capacity_ - 1;
+  uint64_t tail = header->tail.load(std::memory_order_acquire);
+  uint64_t cursor = read_cursor_.load(std::memory_order_relaxed);
+  if (TRPC_UNLIKELY(tail - cursor > capacity_)) {
+    TRPC_LOG_ERROR("corrupted shm ring, cursor:" << cursor << ", tail:" << tail);
+    return 0;
+  }
+
+  std::size_t read = 0;
+  while (cursor != tail && read < max_bytes) {
+    uint64_t pos = cursor;
+    auto* record = reinterpret_cast<RecordHeader*>(rx_.data + (pos & mask));
+    // The size is read once, the peer may still write the shared memory.
+    std::size_t payload = record->size;
+    if (TRPC_UNLIKELY(!IsValidRecord(pos, payload, tail))) {
+      TRPC_LOG_ERROR("corrupted shm record, size:" << payload << ", pos:" << pos << ", tail:" << tail);
+      break;
+    }
+
+    cursor += RecordSize(payload);
+    read_cursor_.store(cursor, std::memory_order_release);
+
+    if (record->flags.load(std::memory_order_relaxed) & kRecordPadding) {
+      Release(pos);
+      continue;
+    }
+
+    // Every block holds a reference of the channel, which is given back in `ReleaseRecord`.
+    Ref();
+    char* data = reinterpret_cast<char*>(record) + sizeof(RecordHeader);
+    auto block = object_pool::MakeLwUnique<BufferBlock>();
+    block->WrapUp(MakeRefCounted<ContiguousBuffer>(data, payload, &ShmChannel::ReleaseRecord, this));
+    buffer.Append(std::move(block));
+    read += payload;
+  }
+
+  return read;
+}
+
+bool ShmChannel::IsValidRecord(uint64_t pos, std::size_t payload, uint64_t end) const {
+  // A record is never split at the end of the ring, and it must lie before `end`.
+  std::size_t size = RecordSize(payload);
+  return payload <= capacity_ && size <= end - pos && (pos & (capacity_ - 1)) + size <= capacity_;
+}
+
+void ShmChannel::ReleaseRecord(char* payload, void* arg) {
+  auto* channel = static_cast<ShmChannel*>(arg);
+  auto offset = static_cast<uint64_t>(payload - sizeof(RecordHeader) - channel->rx_.data);
+  uint64_t head = channel->rx_.header->head.load(std::memory_order_relaxed);
+  // Recover the absolute position of the record from its offset in the ring: it lies in [head, head + capacity).
+  uint64_t pos = head + ((offset - head) & (channel->capacity_ - 1));
+  channel->Release(pos);
+  channel->Deref();
+}
+
+void ShmChannel::Release(uint64_t pos) {
+  RingHeader* header = rx_.header;
+  const uint64_t mask = capacity_ - 1;
+
+  {
+    std::scoped_lock _(release_lock_);
+    auto* record = reinterpret_cast<RecordHeader*>(rx_.data + (pos & mask));
+    record->flags.fetch_or(kRecordReleased, std::memory_order_relaxed);
+
+    // Give the space back to the producer up to the first record still in use.
+    uint64_t head = header->head.load(std::memory_order_relaxed);
+    uint64_t old_head = head;
+    uint64_t cursor = read_cursor_.load(std::memory_order_acquire);
+    while (head != cursor) {
+      auto* h = reinterpret_cast<RecordHeader*>(rx_.data + (head & mask));
+      if (!(h->flags.load(std::memory_order_relaxed) & kRecordReleased)) {
+        break;
+      }
+      // The records before the cursor were checked by `Read`, but the peer may have rewritten their sizes since then,
+      // never move the head beyond the cursor.
+      std::size_t size = h->size;
+      if (TRPC_UNLIKELY(!IsValidRecord(head, size, cursor))) {
+        TRPC_LOG_ERROR("corrupted shm record, size:" << size << ", pos:" << head << ", cursor:" << cursor);
+        break;
+      }
+      head += RecordSize(size);
+    }
+    if (head == old_head) {
+      return;
+    }
+    header->head.store(head, std::memory_order_release);
+  }
+
+  // Pairs with the fence in `PrepareWaitWritable`.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header->producer_waiting.load(std::memory_order_relaxed) &&
+      header->producer_waiting.exchange(0, std::memory_order_relaxed)) {
+    RingDoorbell();
+  }
+}
+
+bool ShmChannel::PrepareWaitReadable() {
+  RingHeader* header = rx_.header;
+  header->consumer_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header->tail.load(std::memory_order_acquire) != read_cursor_.load(std::memory_order_relaxed)) {
+    header->consumer_waiting.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+bool ShmChannel::PrepareWaitWritable() {
+  RingHeader* header = tx_.header;
+  header->producer_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  uint64_t used = header->tail.load(std::memory_order_relaxed) - header->head.load(std::memory_order_acquire);
+  if (capacity_ - used > sizeof(RecordHeader) + kMinRecordPayload) {
+    header->producer_waiting.store(0, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace trpc
@@ -0,0 +1,135 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "trpc/runtime/iomodel/reactor/common/network_address.h"
+#include "trpc/runtime/iomodel/reactor/common/unix_address.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/ref_ptr.h"
+
+namespace trpc {
+
+/// @brief The default capacity in bytes of each direction of the shared memory channel.
+constexpr std::size_t kDefaultShmRingCapacity = 1024 * 1024;
+
+/// @brief Get the unix address on which the shared memory server listening on `addr` accepts handshakes.
+///        Both sides derive it from the ip/port of the service, so no extra addressing is needed.
+/// @note The address lies in a directory private to the effective user(/tmp/trpc_shm_<euid>, mode 0700), so only the
+///       processes of the same user can exchange segments. Call `PrepareShmRendezvousDir` before using it.
+UnixAddress GetShmRendezvousAddress(const NetworkAddress& addr);
+
+/// @brief Create the directory of the rendezvous addresses if it does not exist, and check that it's owned by the
+///        effective user and not accessible by others.
+/// @return false if the directory can not be created or is not private.
+bool PrepareShmRendezvousDir();
+
+/// @brief A bidirectional channel between two processes on the same host. It's made up of two
+///        single-producer/single-consumer byte rings in a shared memory segment (memfd), one for each direction.
+///
+///        The segment is created by the client and passed to the server through a unix socket (SCM_RIGHTS). The
+///        same unix socket is used as the doorbell afterwards: a byte is written to it only when the peer is going to
+///        sleep (waiting for data, or waiting for free space), so a busy channel moves data without any syscall.
+///
+///        Data read from the channel is not copied: every record of the ring is exposed as a block of the
+///        `NoncontiguousBuffer` which references the shared memory directly, and its space is given back to the
+///        producer once the block is destroyed. So the channel outlives the connection as long as any block is alive.
+/// @note `Writev` must be called by one producer at a time, and `Read` by one consumer at a time.
+class ShmChannel : public RefCounted<ShmChannel> {
+ public:
+  /// @brief Create a new segment, as the client side of the channel.
+  /// @param ring_capacity capacity of each direction, rounded up to a power of two.
+  /// @return nullptr on failure.
+  static RefPtr<ShmChannel> Create(std::size_t ring_capacity = kDefaultShmRingCapacity);
+
+  /// @brief Attach to the segment created by the client, as the server side of the channel.
+  /// @param memfd the memfd received by `RecvHandshake`, it's closed by this method.
+  /// @return nullptr on failure.
+  static RefPtr<ShmChannel> Attach(int memfd);
+
+  /// @brief Send the segment to the server via the connected unix socket `sock_fd`.
+  bool SendHandshake(int sock_fd);
+
+  /// @brief Receive the segment from the client via the unix socket `sock_fd`.
+  /// @return the memfd of the segment, -1 on failure(errno is set, EAGAIN means the handshake has not arrived yet).
+  static int RecvHandshake(int sock_fd);
+
+  /// @brief Set the unix socket used to wake up the peer, -1 disables the doorbell.
+  void SetDoorbellFd(int fd);
+
+  /// @brief Copy the data into the ring of the outgoing direction.
+  /// @return the number of bytes written, -1 with errno set to EAGAIN if the ring is full.
+  int Writev(const iovec* iov, int iovcnt);
+
+  /// @brief Move the records of the incoming direction into `buffer` without copying.
+  /// @param max_bytes stop reading once this many bytes are read, the last record is never split.
+  /// @return the number of bytes read.
+  std::size_t Read(NoncontiguousBuffer& buffer, std::size_t max_bytes);
+
+  /// @brief Called by the consumer before waiting for the doorbell.
+  /// @return false if there is data to read, the caller should read again instead of waiting.
+  bool PrepareWaitReadable();
+
+  /// @brief Called by the producer before waiting for the doorbell when the ring is full.
+  /// @return false if there is space to write, the caller should write again instead of waiting.
+  bool PrepareWaitWritable();
+
+  ~ShmChannel();
+
+ private:
+  struct RingHeader;
+  struct Ring {
+    RingHeader* header{nullptr};
+    char* data{nullptr};
+  };
+
+  ShmChannel(char* base, std::size_t mapped_size, std::size_t ring_capacity, bool is_client);
+
+  // Whether the record at `pos` with `payload` bytes lies in the ring and before `end`, the size of a record comes from
+  // the peer, so it must be checked before use.
+  bool IsValidRecord(uint64_t pos, std::size_t payload, uint64_t end) const;
+  static void ReleaseRecord(char* payload, void* arg);
+  void Release(uint64_t pos);
+  void RingDoorbell();
+
+ private:
+  char* base_{nullptr};
+  std::size_t mapped_size_{0};
+  std::size_t capacity_{0};
+
+  // The memfd of the segment, kept by the client until the handshake is sent.
+  int memfd_{-1};
+
+  Ring tx_;
+  Ring rx_;
+
+  // The position of the next record to read in `rx_`, records before it may not be released yet.
+  std::atomic<uint64_t> read_cursor_{0};
+
+  // Serializes giving space of `rx_` back to the producer, records may be released out of order.
+  std::mutex release_lock_;
+
+  std::mutex doorbell_lock_;
+  int doorbell_fd_{-1};
+};
+
+using ShmChannelPtr = RefPtr<ShmChannel>;
+
+}  // namespace trpc
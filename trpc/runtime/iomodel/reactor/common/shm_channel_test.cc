@@ -0,0 +1,236 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/shm_channel.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+class ShmChannelTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds_));
+
+    client_ = ShmChannel::Create(64 * 1024);
+    ASSERT_TRUE(client_);
+    ASSERT_TRUE(client_->SendHandshake(fds_[0]));
+
+    int memfd = ShmChannel::RecvHandshake(fds_[1]);
+    ASSERT_GE(memfd, 0);
+    server_ = ShmChannel::Attach(memfd);
+    ASSERT_TRUE(server_);
+
+    client_->SetDoorbellFd(fds_[0]);
+    server_->SetDoorbellFd(fds_[1]);
+  }
+
+  void TearDown() override {
+    client_ = nullptr;
+    server_ = nullptr;
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  // Return the number of doorbells received on `fd`.
+  static int DrainDoorbell(int fd) {
+    char buf[64];
+    int total = 0;
+    while (true) {
+      int n = ::recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+      if (n <= 0) {
+        return total;
+      }
+      total += n;
+    }
+  }
+
+  static int Write(ShmChannel* channel, const std::string& data) {
+    iovec iov{.iov_base = const_cast<char*>(data.data()), .iov_len = data.size()};
+    return channel->Writev(&iov, 1);
+  }
+
+  int fds_[2];
+  ShmChannelPtr client_;
+  ShmChannelPtr server_;
+};
+
+TEST_F(ShmChannelTest, RecvHandshakeNotReady) {
+  errno = 0;
+  ASSERT_EQ(-1, ShmChannel::RecvHandshake(fds_[1]));
+  ASSERT_EQ(EAGAIN, errno);
+}
+
+TEST_F(ShmChannelTest, WriteAndRead) {
+  std::string part1(100, 'a'), part2(200, 'b');
+  iovec iov[2] = {{.iov_base = part1.data(), .iov_len = part1.size()},
+                  {.iov_base = part2.data(), .iov_len = part2.size()}};
+  ASSERT_EQ(300, client_->Writev(iov, 2));
+  // The server is idle, so it's woken up.
+  ASSERT_EQ(1, DrainDoorbell(fds_[1]));
+
+  NoncontiguousBuffer buffer;
+  ASSERT_EQ(300, server_->Read(buffer, 1024));
+  ASSERT_EQ(part1 + part2, FlattenSlow(buffer));
+  ASSERT_EQ(0, server_->Read(buffer, 1024));
+
+  // The server is not waiting anymore, no doorbell is needed.
+  ASSERT_EQ(3, Write(client_.Get(), "xyz"));
+  ASSERT_EQ(0, DrainDoorbell(fds_[1]));
+
+  // Data arrived before waiting.
+  ASSERT_FALSE(server_->PrepareWaitReadable());
+  ASSERT_EQ(3, server_->Read(buffer, 1024));
+  ASSERT_TRUE(server_->PrepareWaitReadable());
+  ASSERT_EQ(3, Write(client_.Get(), "abc"));
+  ASSERT_EQ(1, DrainDoorbell(fds_[1]));
+
+  // The other direction.
+  NoncontiguousBuffer response;
+  ASSERT_EQ(5, Write(server_.Get(), "hello"));
+  ASSERT_EQ(1, DrainDoorbell(fds_[0]));
+  ASSERT_EQ(5, client_->Read(response, 1024));
+  ASSERT_EQ("hello", FlattenSlow(response));
+}
+
+TEST_F(ShmChannelTest, ZeroCopy) {
+  std::string data(1000, 'z');
+  ASSERT_EQ(1000, Write(client_.Get(), data));
+
+  NoncontiguousBuffer buffer;
+  ASSERT_EQ(1000, server_->Read(buffer, 1024));
+  ASSERT_EQ(1, buffer.size());
+  const char* block = buffer.begin()->data();
+
+  // The block references the memory written by the client.
+  ASSERT_EQ(1000, Write(client_.Get(), data));
+  NoncontiguousBuffer next;
+  ASSERT_EQ(1000, server_->Read(next, 1024));
+  ASSERT_NE(block, next.begin()->data());
+  ASSERT_EQ(data, FlattenSlow(buffer));
+  ASSERT_EQ(data, FlattenSlow(next));
+}
+
+TEST_F(ShmChannelTest, FullAndRelease) {
+  std::string data(16 * 1024, 'f');
+  std::size_t written = 0;
+  while (true) {
+    int n = Write(client_.Get(), data);
+    if (n < 0) {
+      ASSERT_EQ(EAGAIN, errno);
+      break;
+    }
+    written += n;
+  }
+  ASSERT_LE(written, 64 * 1024);
+  ASSERT_GT(written, 60 * 1024);
+  ASSERT_TRUE(client_->PrepareWaitWritable());
+
+  NoncontiguousBuffer buffer;
+  ASSERT_EQ(written, server_->Read(buffer, 1024 * 1024));
+  ASSERT_EQ(0, DrainDoorbell(fds_[0]));
+
+  // Releasing the data read gives the space back, and wakes up the client.
+  buffer.Clear();
+  ASSERT_EQ(1, DrainDoorbell(fds_[0]));
+  ASSERT_FALSE(client_->PrepareWaitWritable());
+
+  // Wrap around the end of the ring.
+  for (int i = 0; i < 16; ++i) {
+    std::string payload(5000 + i, static_cast<char>('a' + i));
+    ASSERT_EQ(payload.size(), Write(client_.Get(), payload));
+    NoncontiguousBuffer received;
+    ASSERT_EQ(payload.size(), server_->Read(received, 1024 * 1024));
+    ASSERT_EQ(payload, FlattenSlow(received));
+  }
+}
+
+TEST_F(ShmChannelTest, ReleaseOutOfOrder) {
+  // Fill up the ring with three records.
+  ASSERT_EQ(30000, Write(client_.Get(), std::string(30000, '1')));
+  ASSERT_EQ(30000, Write(client_.Get(), std::string(30000, '2')));
+  int left = Write(client_.Get(), std::string(30000, '3'));
+  ASSERT_GT(left, 0);
+  ASSERT_LT(left, 30000);
+
+  NoncontiguousBuffer first, second, third;
+  ASSERT_EQ(30000, server_->Read(first, 1));
+  ASSERT_EQ(30000, server_->Read(second, 1));
+  ASSERT_EQ(left, server_->Read(third, 1));
+
+  // The space of the later records can not be reused before the first one is released.
+  second.Clear();
+  third.Clear();
+  ASSERT_EQ(-1, Write(client_.Get(), "x"));
+  first.Clear();
+  ASSERT_EQ(30000, Write(client_.Get(), std::string(30000, '4')));
+}
+
+TEST_F(ShmChannelTest, ChannelOutlivesConnection) {
+  ASSERT_EQ(5, Write(client_.Get(), "hello"));
+  NoncontiguousBuffer buffer;
+  ASSERT_EQ(5, server_->Read(buffer, 1024));
+
+  // The block keeps the mapping alive.
+  server_->SetDoorbellFd(-1);
+  server_ = nullptr;
+  ASSERT_EQ("hello", FlattenSlow(buffer));
+}
+
+TEST_F(ShmChannelTest, CorruptedRecordSize) {
+  ASSERT_EQ(5, Write(client_.Get(), "hello"));
+  NoncontiguousBuffer buffer;
+  ASSERT_EQ(5, server_->Read(buffer, 1024));
+
+  // The peer rewrites the size of the record after it's read, the head must not be moved beyond the records read.
+  auto* size = reinterpret_cast<uint32_t*>(const_cast<char*>(buffer.FirstContiguous().data()) - 8);
+  *size = 0xffffffff;
+  buffer.Clear();
+
+  // The space of the corrupted record is never given back, but the rest of the ring is still usable.
+  ASSERT_EQ(5, Write(client_.Get(), "world"));
+  ASSERT_EQ(5, server_->Read(buffer, 1024));
+  ASSERT_EQ("world", FlattenSlow(buffer));
+  buffer.Clear();
+
+  // The producer never sees more free space than the ring has.
+  ASSERT_LT(Write(client_.Get(), std::string(128 * 1024, 'x')), 64 * 1024);
+}
+
+TEST(ShmRendezvousAddress, Derive) {
+  NetworkAddress addr("127.0.0.1", 10001, NetworkAddress::IpType::kIpV4);
+  std::string dir = "/tmp/trpc_shm_" + std::to_string(::geteuid());
+  ASSERT_EQ(dir + "/127.0.0.1_10001.sock", GetShmRendezvousAddress(addr).Path());
+}
+
+TEST(ShmRendezvousAddress, PrivateDir) {
+  std::string dir = "/tmp/trpc_shm_" + std::to_string(::geteuid());
+  ASSERT_TRUE(PrepareShmRendezvousDir());
+  struct stat st;
+  ASSERT_EQ(0, ::stat(dir.c_str(), &st));
+  ASSERT_EQ(0700, st.st_mode & 0777);
+
+  // A directory accessible by others is refused.
+  ASSERT_EQ(0, ::chmod(dir.c_str(), 0755));
+  ASSERT_FALSE(PrepareShmRendezvousDir());
+  ASSERT_EQ(0, ::chmod(dir.c_str(), 0700));
+  ASSERT_TRUE(PrepareShmRendezvousDir());
+}
+
+}  // namespace trpc::testing
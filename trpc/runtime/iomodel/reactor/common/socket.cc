@@ -210,6 +210,14 @@ int Socket::RecvMsg(msghdr* message, int flag, NetworkAddress* peer_addr) {
   return ret;
 }
 
+int Socket::SendMmsg(struct mmsghdr* msgvec, unsigned int vlen, int flag) {
+  return ::sendmmsg(fd_, msgvec, vlen, flag);
+}
+
+int Socket::RecvMmsg(struct mmsghdr* msgvec, unsigned int vlen, int flag) {
+  return ::recvmmsg(fd_, msgvec, vlen, flag, nullptr);
+}
+
 bool Socket::SetBlock(bool block) {
   int val = 0;
 
@@ -102,6 +102,14 @@ class Socket {
   /// @brief Recv msg
   int RecvMsg(msghdr* message, int flag, NetworkAddress* peer_addr);
 
+  /// @brief Send multiple msgs by one system call
+  /// @return the number of msgs sent, -1 on failed
+  int SendMmsg(struct mmsghdr* msgvec, unsigned int vlen, int flag = 0);
+
+  /// @brief Recv multiple msgs by one system call
+  /// @return the number of msgs received, -1 on failed
+  int RecvMmsg(struct mmsghdr* msgvec, unsigned int vlen, int flag = 0);
+
   /// @brief Set SO_REUSEADD
   bool SetReuseAddr();
 
@@ -0,0 +1,70 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "trpc/util/align.h"
+
+namespace trpc {
+
+/// @brief The memory budget of the write queues of connections.
+///        The bytes queued but not written out yet are charged to the budget, once it's exceeded, the connections
+///        which still hold data to write stop reading requests and the new messages sent on them fail fast, instead
+///        of letting the queues grow without bound when the peers consume slowly.
+/// @note  The accounting is only enabled when a limit is set(0 means not limited), the limit must be set before the
+///        connections are created.
+class WriteBufferBudget {
+ public:
+  explicit WriteBufferBudget(std::size_t limit = 0) : limit_(limit) {}
+
+  /// @brief The budget of the whole process, set by `global.write_buffer_budget`.
+  static WriteBufferBudget* Global();
+
+  /// @brief Get/Set the limit in bytes, 0 means not limited.
+  std::size_t GetLimit() const { return limit_; }
+  void SetLimit(std::size_t limit) { limit_ = limit; }
+
+  bool Enabled() const { return limit_ != 0; }
+
+  /// @brief Whether the bytes charged reach the limit.
+  bool Exceeded() const { return limit_ != 0 && used_.load(std::memory_order_relaxed) >= limit_; }
+
+  void Charge(std::size_t bytes) { used_.fetch_add(bytes, std::memory_order_relaxed); }
+  void Refund(std::size_t bytes) { used_.fetch_sub(bytes, std::memory_order_relaxed); }
+
+  /// @brief Get the bytes charged currently.
+  std::size_t GetUsed() const { return used_.load(std::memory_order_relaxed); }
+
+  /// @brief Count the messages rejected because of the budget.
+  void AddRejected() { rejected_.fetch_add(1, std::memory_order_relaxed); }
+  uint64_t GetRejectedCount() const { return rejected_.load(std::memory_order_relaxed); }
+
+  /// @brief Count the connections whose reading is paused because of the budget.
+  void IncPausedConnection() { paused_conns_.fetch_add(1, std::memory_order_relaxed); }
+  void DecPausedConnection() { paused_conns_.fetch_sub(1, std::memory_order_relaxed); }
+  int64_t GetPausedConnectionCount() const { return paused_conns_.load(std::memory_order_relaxed); }
+
+ private:
+  std::size_t limit_;
+
+  alignas(hardware_destructive_interference_size) std::atomic<std::size_t> used_{0};
+
+  alignas(hardware_destructive_interference_size) std::atomic<uint64_t> rejected_{0};
+  std::atomic<int64_t> paused_conns_{0};
+};
+
+}  // namespace trpc
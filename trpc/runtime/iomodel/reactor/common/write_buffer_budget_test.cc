@@ -0,0 +1,60 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/write_buffer_budget.h"
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(WriteBufferBudget, NotLimited) {
+  WriteBufferBudget budget;
+  ASSERT_FALSE(budget.Enabled());
+  budget.Charge(1024 * 1024);
+  ASSERT_FALSE(budget.Exceeded());
+}
+
+TEST(WriteBufferBudget, ChargeAndRefund) {
+  WriteBufferBudget budget(100);
+  ASSERT_TRUE(budget.Enabled());
+
+  budget.Charge(60);
+  ASSERT_FALSE(budget.Exceeded());
+  budget.Charge(40);
+  ASSERT_TRUE(budget.Exceeded());
+  ASSERT_EQ(100, budget.GetUsed());
+
+  budget.Refund(1);
+  ASSERT_FALSE(budget.Exceeded());
+  budget.Refund(99);
+  ASSERT_EQ(0, budget.GetUsed());
+}
+
+TEST(WriteBufferBudget, Stats) {
+  WriteBufferBudget budget(100);
+  budget.AddRejected();
+  budget.AddRejected();
+  ASSERT_EQ(2, budget.GetRejectedCount());
+
+  budget.IncPausedConnection();
+  budget.IncPausedConnection();
+  budget.DecPausedConnection();
+  ASSERT_EQ(1, budget.GetPausedConnectionCount());
+}
+
+TEST(WriteBufferBudget, Global) {
+  ASSERT_EQ(WriteBufferBudget::Global(), WriteBufferBudget::Global());
+  ASSERT_FALSE(WriteBufferBudget::Global()->Enabled());
+}
+
+}  // namespace trpc::testing
@@ -32,6 +32,14 @@ TcpAcceptor::TcpAcceptor(Reactor* reactor, const NetworkAddress& tcp_addr)
       idle_fd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)) {
 }
 
+TcpAcceptor::TcpAcceptor(Reactor* reactor, const NetworkAddress& tcp_addr, Socket listening_socket)
+    : reactor_(reactor),
+      tcp_addr_(tcp_addr),
+      socket_(listening_socket),
+      idle_fd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)),
+      inherited_(true) {
+}
+
 TcpAcceptor::~TcpAcceptor() {
   socket_.Close();
   close(idle_fd_);
@@ -55,24 +63,28 @@ bool TcpAcceptor::EnableListen(int backlog) {
 
   SetFd(socket_.GetFd());
 
-  socket_.SetReuseAddr();
-  socket_.SetReusePort();
-  socket_.SetTcpNoDelay();
-  socket_.SetNoCloseWait();
   socket_.SetBlock(false);
-  socket_.SetKeepAlive();
 
-  auto& set_socket_opt_fun = GetAcceptSetSocketOptFunction();
-  if (set_socket_opt_fun) {
-    set_socket_opt_fun(socket_);
-  }
+  // The options of the socket inherited are kept.
+  if (!inherited_) {
+    socket_.SetReuseAddr();
+    socket_.SetReusePort();
+    socket_.SetTcpNoDelay();
+    socket_.SetNoCloseWait();
+    socket_.SetKeepAlive();
+
+    auto& set_socket_opt_fun = GetAcceptSetSocketOptFunction();
+    if (set_socket_opt_fun) {
+      set_socket_opt_fun(socket_);
+    }
 
-  if (!socket_.Bind(tcp_addr_)) {
-    return false;
-  }
+    if (!socket_.Bind(tcp_addr_)) {
+      return false;
+    }
 
-  if (!socket_.Listen(backlog)) {
-    return false;
+    if (!socket_.Listen(backlog)) {
+      return false;
+    }
   }
 
   EnableEvent(EventHandler::EventType::kReadEvent);
@@ -28,6 +28,9 @@ class TcpAcceptor final : public Acceptor {
  public:
   explicit TcpAcceptor(Reactor* reactor, const NetworkAddress& tcp_addr);
 
+  /// @brief Accepts on the socket listening already(eg: inherited from the old process on hot restart)
+  TcpAcceptor(Reactor* reactor, const NetworkAddress& tcp_addr, Socket listening_socket);
+
   ~TcpAcceptor() override;
 
   bool EnableListen(int backlog = 1024) override;
@@ -48,6 +51,9 @@ class TcpAcceptor final : public Acceptor {
   int idle_fd_{-1};
 
   bool enable_{false};
+
+  // Whether the socket is listening already
+  bool inherited_{false};
 };
 
 }  // namespace trpc
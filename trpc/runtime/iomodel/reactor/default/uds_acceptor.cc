@@ -32,6 +32,14 @@ UdsAcceptor::UdsAcceptor(Reactor* reactor, const UnixAddress& unix_addr)
       idle_fd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)) {
 }
 
+UdsAcceptor::UdsAcceptor(Reactor* reactor, const UnixAddress& unix_addr, Socket listening_socket)
+    : reactor_(reactor),
+      unix_addr_(unix_addr),
+      socket_(listening_socket),
+      idle_fd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)),
+      inherited_(true) {
+}
+
 UdsAcceptor::~UdsAcceptor() {
   socket_.Close();
   if (idle_fd_ >= 0) {
@@ -58,17 +66,21 @@ bool UdsAcceptor::EnableListen(int backlog) {
   SetFd(socket_.GetFd());
 
   socket_.SetBlock(false);
-  auto& set_socket_opt_fun = GetAcceptSetSocketOptFunction();
-  if (set_socket_opt_fun) {
-    set_socket_opt_fun(socket_);
-  }
 
-  if (!socket_.Bind(unix_addr_)) {
-    return false;
-  }
+  // The options of the socket inherited are kept.
+  if (!inherited_) {
+    auto& set_socket_opt_fun = GetAcceptSetSocketOptFunction();
+    if (set_socket_opt_fun) {
+      set_socket_opt_fun(socket_);
+    }
 
-  if (!socket_.Listen(backlog)) {
-    return false;
+    if (!socket_.Bind(unix_addr_)) {
+      return false;
+    }
+
+    if (!socket_.Listen(backlog)) {
+      return false;
+    }
   }
 
   EnableEvent(EventHandler::EventType::kReadEvent);
@@ -28,6 +28,9 @@ class UdsAcceptor final : public Acceptor {
  public:
   explicit UdsAcceptor(Reactor* reactor, const UnixAddress& unix_addr);
 
+  /// @brief Accepts on the socket listening already(eg: inherited from the old process on hot restart)
+  UdsAcceptor(Reactor* reactor, const UnixAddress& unix_addr, Socket listening_socket);
+
   ~UdsAcceptor() override;
 
   bool EnableListen(int backlog = 1024) override;
@@ -48,6 +51,9 @@ class UdsAcceptor final : public Acceptor {
   int idle_fd_{-1};
 
   bool enable_{false};
+
+  // Whether the socket is listening already
+  bool inherited_{false};
 };
 
 }  // namespace trpc
@@ -38,6 +38,24 @@ FiberAcceptor::FiberAcceptor(Reactor* reactor, const UnixAddress& unix_addr)
       idle_fd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)) {
 }
 
+FiberAcceptor::FiberAcceptor(Reactor* reactor, const NetworkAddress& tcp_addr, Socket listening_socket)
+    : FiberConnection(reactor),
+      socket_(listening_socket),
+      is_net_(true),
+      inherited_(true),
+      tcp_addr_(tcp_addr),
+      idle_fd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)) {
+}
+
+FiberAcceptor::FiberAcceptor(Reactor* reactor, const UnixAddress& unix_addr, Socket listening_socket)
+    : FiberConnection(reactor),
+      socket_(listening_socket),
+      is_net_(false),
+      inherited_(true),
+      unix_addr_(unix_addr),
+      idle_fd_(::open("/dev/null", O_RDONLY | O_CLOEXEC)) {
+}
+
 FiberAcceptor::~FiberAcceptor() {
   socket_.Close();
 
@@ -60,28 +78,32 @@ bool FiberAcceptor::Listen() {
 
   SetFd(socket_.GetFd());
 
-  socket_.SetReuseAddr();
-  socket_.SetReusePort();
-  socket_.SetTcpNoDelay();
-  socket_.SetNoCloseWait();
   socket_.SetBlock(false);
-  socket_.SetKeepAlive();
-  if (set_socket_opt_func_) {
-    set_socket_opt_func_(socket_);
-  }
 
-  if (is_net_) {
-    if (!socket_.Bind(tcp_addr_)) {
-      return false;
+  // The options of the socket inherited are kept.
+  if (!inherited_) {
+    socket_.SetReuseAddr();
+    socket_.SetReusePort();
+    socket_.SetTcpNoDelay();
+    socket_.SetNoCloseWait();
+    socket_.SetKeepAlive();
+    if (set_socket_opt_func_) {
+      set_socket_opt_func_(socket_);
     }
-  } else {
-    if (!socket_.Bind(unix_addr_)) {
-      return false;
+
+    if (is_net_) {
+      if (!socket_.Bind(tcp_addr_)) {
+        return false;
+      }
+    } else {
+      if (!socket_.Bind(unix_addr_)) {
+        return false;
+      }
     }
-  }
 
-  if (!socket_.Listen(1024)) {
-    return false;
+    if (!socket_.Listen(1024)) {
+      return false;
+    }
   }
 
   EnableEvent(EventHandler::EventType::kReadEvent);
@@ -31,6 +31,11 @@ class FiberAcceptor : public FiberConnection {
 
   explicit FiberAcceptor(Reactor* reactor, const UnixAddress& unix_addr);
 
+  /// @brief Accepts on the socket listening already(eg: inherited from the old process on hot restart)
+  FiberAcceptor(Reactor* reactor, const NetworkAddress& tcp_addr, Socket listening_socket);
+
+  FiberAcceptor(Reactor* reactor, const UnixAddress& unix_addr, Socket listening_socket);
+
   ~FiberAcceptor() override;
 
   /// @brief Begin to listen connection
@@ -64,6 +69,9 @@ class FiberAcceptor : public FiberConnection {
   // tcp or uds
   bool is_net_;
 
+  // whether the socket is listening already
+  bool inherited_{false};
+
   // tcp listen addr
   NetworkAddress tcp_addr_;
 
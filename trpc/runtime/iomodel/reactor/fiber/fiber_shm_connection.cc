@@ -0,0 +1,417 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_shm_connection.h"
+
+#include <sys/socket.h>
+
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+#include "trpc/util/time.h"
+
+using namespace std::literals;
+
+namespace trpc {
+
+/// @brief Io-handler which reads/writes the shared memory channel of the connection.
+class FiberShmConnection::ShmIoHandler : public IoHandler {
+ public:
+  explicit ShmIoHandler(FiberShmConnection* conn) : conn_(conn) {}
+
+  Connection* GetConnection() const override { return conn_; }
+
+  HandshakeStatus Handshake(bool is_read_event) override { return HandshakeStatus::kSucc; }
+
+  // The incoming data is read by `FiberShmConnection` directly without copying.
+  int Read(void* buffer, uint32_t size) override {
+    errno = EAGAIN;
+    return -1;
+  }
+
+  int Writev(const iovec* iov, int iovcnt) override {
+    if (TRPC_UNLIKELY(!conn_->channel_)) {
+      errno = EAGAIN;
+      return -1;
+    }
+    // The ring has a single producer, while the writing buffer list and the protocol(eg: grpc handshaking) may both
+    // write to the connection.
+    std::scoped_lock _(lock_);
+    return conn_->channel_->Writev(iov, iovcnt);
+  }
+
+ private:
+  FiberShmConnection* conn_;
+  std::mutex lock_;
+};
+
+namespace {
+
+// Copy the data into the heap, so that the shared memory referenced by `from` can be given back to the producer.
+void CopyTo(NoncontiguousBuffer& to, const NoncontiguousBuffer& from) {
+  NoncontiguousBufferBuilder builder;
+  for (auto&& block : from) {
+    builder.Append(block.data(), block.size());
+  }
+  to.Append(builder.DestructiveGet());
+}
+
+}  // namespace
+
+FiberShmConnection::FiberShmConnection(Reactor* reactor, const Socket& socket)
+    : FiberConnection(reactor), socket_(socket) {
+  TRPC_ASSERT(socket_.IsValid());
+
+  SetFd(socket_.GetFd());
+  SetIoHandler(std::make_unique<ShmIoHandler>(this));
+}
+
+FiberShmConnection::~FiberShmConnection() {
+  TRPC_LOG_DEBUG("~FiberShmConnection fd:" << socket_.GetFd() << ", conn_id:" << this->GetConnId());
+  TRPC_ASSERT(!socket_.IsValid());
+}
+
+void FiberShmConnection::Established() {
+  writing_buffers_.SetBudget(GetWriteBufferBudget().get());
+  SetEstablishTimestamp(trpc::time::GetMilliSeconds());
+  SetConnectionState(ConnectionState::kConnected);
+  SetConnActiveTime(trpc::time::GetMilliSeconds());
+
+  TRPC_ASSERT(GetConnectionHandler());
+
+  GetConnectionHandler()->ConnectionEstablished();
+
+  AttachReactor();
+
+  TRPC_LOG_TRACE("FiberShmConnection::Established fd:" << socket_.GetFd() << ", ip:" << GetPeerIp()
+                                                       << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
+                                                       << ", conn_id: " << this->GetConnId() << ", Connect ok.");
+}
+
+bool FiberShmConnection::DoConnect() {
+  TRPC_ASSERT(GetConnectionState() == ConnectionState::kUnconnected);
+  TRPC_ASSERT(socket_.IsValid());
+
+  SetDoConnectTimestamp(trpc::time::GetMilliSeconds());
+
+  UnixAddress rendezvous_addr = GetShmRendezvousAddress(NetworkAddress(GetPeerIp(), GetPeerPort(), GetPeerIpType()));
+
+  // Connecting to a unix socket completes immediately, so the handshake can be sent right now.
+  // The directory is checked on every connect, so that the segment is never sent to an address others can listen on.
+  channel_ = PrepareShmRendezvousDir() ? ShmChannel::Create() : nullptr;
+  if (channel_ && socket_.Connect(rendezvous_addr) == 0 && channel_->SendHandshake(socket_.GetFd())) {
+    channel_->SetDoorbellFd(socket_.GetFd());
+
+    TRPC_LOG_DEBUG("FiberShmConnection::DoConnect target: " << rendezvous_addr.Path() << ", fd: " << socket_.GetFd()
+                                                            << ", conn_id: " << this->GetConnId() << ", succ.");
+
+    Established();
+
+    return true;
+  }
+
+  TRPC_LOG_ERROR("FiberShmConnection::DoConnect target: " << rendezvous_addr.Path() << ", fd: " << socket_.GetFd()
+                                                          << ", conn_id: " << this->GetConnId() << ", failed.");
+
+  channel_ = nullptr;
+  socket_.Close();
+
+  return false;
+}
+
+void FiberShmConnection::StartHandshaking() { RestartReadIn(0ns); }
+
+int FiberShmConnection::Send(IoMessage&& msg) {
+  if (!Enabled()) {
+    return -1;
+  }
+
+  auto append_status =
+      writing_buffers_.Append(std::move(msg.buffer), std::move(msg), GetSendQueueCapacity(), GetSendQueueTimeout());
+  if (TRPC_LIKELY(append_status == WritingBufferList::kAppendHead)) {
+    constexpr auto kMaximumBytesPerCall = 1048576;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (conn_unavailable_) {
+      return -1;
+    }
+    auto flush_status = FlushWritingBuffer(kMaximumBytesPerCall);
+    lock.unlock();
+    if (TRPC_LIKELY(flush_status == FlushStatus::kFlushed)) {
+      return 0;
+    } else if (flush_status == FlushStatus::kQuotaExceeded) {
+      RestartWriteIn(0ms);
+      return 0;
+    } else if (flush_status == FlushStatus::kChannelSaturated) {
+      WaitForWritable();
+      return 0;
+    } else {
+      TRPC_LOG_WARN("FiberShmConnection::Send failed to write ip:" << GetPeerIp() << ", port:" << GetPeerPort()
+                                                                    << ", is_client:" << IsClient()
+                                                                    << ", conn_id: " << this->GetConnId());
+      Kill(CleanupReason::kError);
+      return -1;
+    }
+  } else if (append_status == WritingBufferList::kTimeout) {
+    TRPC_LOG_ERROR("FiberShmConnection::Send timeout to write ip:" << GetPeerIp() << ", port:" << GetPeerPort()
+                                                                   << ", is_client:" << IsClient()
+                                                                   << ", conn_id: " << this->GetConnId());
+    return -2;
+  } else if (append_status == WritingBufferList::kOverBudget) {
+    TRPC_FMT_ERROR_EVERY_SECOND("FiberShmConnection::Send exceeded write buffer budget ip:{}, port:{}, conn_id:{}",
+                                GetPeerIp(), GetPeerPort(), this->GetConnId());
+    return -1;
+  }
+
+  return 0;
+}
+
+void FiberShmConnection::DoClose(bool destroy) { Stop(); }
+
+void FiberShmConnection::Stop() {
+  TRPC_LOG_DEBUG("FiberShmConnection::Stop fd:" << socket_.GetFd() << ", ip:" << GetPeerIp()
+                                                << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
+                                                << ", conn_id:" << this->GetConnId());
+  Kill(CleanupReason::UserInitiated);
+}
+
+void FiberShmConnection::Join() { WaitForCleanup(); }
+
+bool FiberShmConnection::AttachChannel() {
+  int memfd = ShmChannel::RecvHandshake(socket_.GetFd());
+  if (memfd < 0) {
+    return false;
+  }
+
+  channel_ = ShmChannel::Attach(memfd);
+  if (!channel_) {
+    errno = EPROTO;
+    return false;
+  }
+  channel_->SetDoorbellFd(socket_.GetFd());
+
+  return true;
+}
+
+bool FiberShmConnection::DrainDoorbell() {
+  char buffer[256];
+  while (true) {
+    int n = socket_.Recv(buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (n > 0) {
+      continue;
+    }
+    return n < 0 && errno == EAGAIN;
+  }
+}
+
+FiberConnection::EventAction FiberShmConnection::OnReadable() {
+  if (!Enabled()) {
+    return EventAction::kLeaving;
+  }
+
+  if (TRPC_UNLIKELY(!channel_)) {
+    if (!AttachChannel()) {
+      if (errno == EAGAIN) {
+        return EventAction::kReady;
+      }
+      TRPC_LOG_WARN("FiberShmConnection::OnReadable handshake failed, fd:" << socket_.GetFd() << ", errno:" << errno
+                                                                          << ", conn_id:" << this->GetConnId());
+      Kill(CleanupReason::kHandshakeFailed);
+      return EventAction::kLeaving;
+    }
+  }
+
+  // The doorbell is rung either for new data, or for the space released by the peer.
+  bool alive = DrainDoorbell();
+  if (write_blocked_.load(std::memory_order_relaxed) && write_blocked_.exchange(false, std::memory_order_relaxed)) {
+    RestartWriteIn(0ns);
+  }
+
+  size_t recv_buffer_size = GetRecvBufferSize();
+  size_t max_bytes = recv_buffer_size != 0 ? recv_buffer_size : std::numeric_limits<std::size_t>::max();
+  // Stop consuming requests while the data to write is piling up. Unlike tcp, the read event is kept since the
+  // doorbell also tells the space released by the peer, the reading is resumed once the data is flushed.
+  while (TRPC_LIKELY(!writing_buffers_.TryPauseReading())) {
+    NoncontiguousBuffer incoming;
+    if (channel_->Read(incoming, max_bytes) == 0) {
+      if (channel_->PrepareWaitReadable()) {
+        break;
+      }
+      continue;
+    }
+
+    // Complete packets are handed over without copying. But the records of an incomplete packet are copied out,
+    // otherwise a packet larger than the ring would never be received.
+    bool zero_copy = read_buffer_.Empty();
+    if (zero_copy) {
+      read_buffer_ = std::move(incoming);
+    } else {
+      CopyTo(read_buffer_, incoming);
+    }
+
+    auto rc = ConsumeReadData();
+    if (TRPC_UNLIKELY(rc != EventAction::kReady)) {
+      TRPC_LOG_WARN("FiberShmConnection::OnReadable ConsumeReadData failed, ip:"
+                    << GetPeerIp() << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
+                    << ", conn_id:" << this->GetConnId());
+      Kill(CleanupReason::kError);
+      return rc;
+    }
+
+    if (zero_copy && !read_buffer_.Empty()) {
+      NoncontiguousBuffer partial = std::move(read_buffer_);
+      read_buffer_.Clear();
+      CopyTo(read_buffer_, partial);
+    }
+  }
+
+  if (TRPC_UNLIKELY(!alive)) {
+    TRPC_LOG_DEBUG("FiberShmConnection::OnReadable remote close, ip:" << GetPeerIp() << ", port:" << GetPeerPort()
+                                                                      << ", is_client:" << IsClient()
+                                                                      << ", conn_id:" << this->GetConnId());
+    Kill(CleanupReason::kDisconnect);
+    return EventAction::kLeaving;
+  }
+
+  return EventAction::kReady;
+}
+
+FiberConnection::EventAction FiberShmConnection::ConsumeReadData() {
+  if (read_buffer_.ByteSize() <= 0) {
+    return EventAction::kReady;
+  }
+
+  RefPtr ref(ref_ptr, this);
+  std::deque<std::any> data;
+  int checker_ret = GetConnectionHandler()->CheckMessage(ref, read_buffer_, data);
+  if (checker_ret == kPacketFull) {
+    if (!GetConnectionHandler()->HandleMessage(ref, data)) {
+      return EventAction::kLeaving;
+    }
+
+    SetConnActiveTime(trpc::time::GetMilliSeconds());
+    GetConnectionHandler()->UpdateConnection();
+
+    return EventAction::kReady;
+  } else if (checker_ret == kPacketError) {
+    return EventAction::kLeaving;
+  }
+
+  return EventAction::kReady;
+}
+
+FiberConnection::EventAction FiberShmConnection::OnWritable() {
+  if (!Enabled()) {
+    return EventAction::kLeaving;
+  }
+
+  auto status = FlushWritingBuffer(std::numeric_limits<std::size_t>::max());
+  if (status == FlushStatus::kFlushed) {
+    return EventAction::kSuppress;
+  } else if (status == FlushStatus::kChannelSaturated) {
+    // The unix socket is always writable, so the write event is suppressed until the peer rings the doorbell.
+    WaitForWritable();
+    return EventAction::kSuppress;
+  } else {
+    Kill(CleanupReason::kError);
+    return EventAction::kLeaving;
+  }
+}
+
+void FiberShmConnection::WaitForWritable() {
+  write_blocked_.store(true, std::memory_order_relaxed);
+  if (!channel_->PrepareWaitWritable() && write_blocked_.exchange(false, std::memory_order_relaxed)) {
+    RestartWriteIn(0ns);
+  }
+}
+
+FiberShmConnection::FlushStatus FiberShmConnection::FlushWritingBuffer(std::size_t max_bytes) {
+  auto bytes_quota = max_bytes;
+
+  while (bytes_quota) {
+    bool emptied = false;
+    bool short_write = false;
+    auto written = writing_buffers_.FlushTo(GetIoHandler(), GetConnectionHandler(), bytes_quota,
+                                            GetSendQueueCapacity(), SupportPipeline(), &emptied, &short_write);
+    if (TRPC_UNLIKELY(written < 0)) {
+      if (errno == EAGAIN) {
+        return FlushStatus::kChannelSaturated;
+      }
+      return FlushStatus::kError;
+    }
+    TRPC_ASSERT(static_cast<std::size_t>(written) <= bytes_quota);
+
+    bytes_quota -= written;
+
+    if (TRPC_UNLIKELY(writing_buffers_.TryResumeReading())) {
+      // The data left in the ring will not ring the doorbell, so a read event is emulated.
+      GetReactor()->SubmitTask([this, ref = RefPtr(ref_ptr, this)] {
+        if (Enabled()) {
+          HandleReadEvent();
+        }
+      });
+    }
+
+    SetConnActiveTime(trpc::time::GetMilliSeconds());
+    GetConnectionHandler()->UpdateConnection();
+
+    TRPC_ASSERT(!(short_write && emptied));
+    if (emptied) {
+      return FlushStatus::kFlushed;
+    }
+    if (short_write) {
+      return FlushStatus::kChannelSaturated;
+    }
+  }
+
+  return FlushStatus::kQuotaExceeded;
+}
+
+void FiberShmConnection::OnError(int err) {
+  TRPC_LOG_DEBUG("FiberShmConnection::OnError ip:" << GetPeerIp() << ", port:" << GetPeerPort()
+                                                   << ", fd: " << socket_.GetFd() << ", is_client:" << IsClient()
+                                                   << ", conn_id:" << this->GetConnId() << ", err:" << err);
+  Kill(CleanupReason::kError);
+}
+
+void FiberShmConnection::OnCleanup(CleanupReason reason) {
+  TRPC_ASSERT(reason != CleanupReason::kNone);
+
+  TRPC_LOG_DEBUG("FiberShmConnection::OnCleanup ip:" << GetPeerIp() << ", port:" << GetPeerPort()
+                                                     << ", is_client:" << IsClient() << ", fd: " << socket_.GetFd()
+                                                     << ", conn_id:" << this->GetConnId()
+                                                     << ", reason:" << static_cast<int>(reason));
+
+  cleanup_reason_ = reason;
+
+  GetConnectionHandler()->ConnectionClosed();
+  GetConnectionHandler()->CleanResource();
+
+  writing_buffers_.Stop();
+
+  {
+    std::scoped_lock<std::mutex> _(mutex_);
+    conn_unavailable_ = true;
+    // The channel may outlive the connection (held by the buffers read), so it must not ring the closed socket.
+    if (channel_) {
+      channel_->SetDoorbellFd(-1);
+    }
+    GetIoHandler()->Destroy();
+    socket_.Close();
+  }
+}
+
+}  // namespace trpc
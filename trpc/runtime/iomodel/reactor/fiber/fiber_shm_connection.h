@@ -0,0 +1,87 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "trpc/runtime/iomodel/reactor/common/io_handler.h"
+#include "trpc/runtime/iomodel/reactor/common/shm_channel.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
+#include "trpc/runtime/iomodel/reactor/fiber/writing_buffer_list.h"
+
+namespace trpc {
+
+/// @brief Fiber connection to a peer on the same host, the data is moved through a shared memory channel instead of
+///        the kernel network stack. The unix socket of the connection is only used for the handshake and the doorbell.
+/// @note  The connection installs its own io-handler which reads/writes the shared memory channel, so the io-handler
+///        of the protocol(eg: ssl) is not used.
+class FiberShmConnection final : public FiberConnection {
+ public:
+  /// @param socket a connected(client) or accepted(server) unix socket.
+  explicit FiberShmConnection(Reactor* reactor, const Socket& socket);
+
+  ~FiberShmConnection() override;
+
+  void Established() override;
+
+  bool DoConnect() override;
+
+  void StartHandshaking() override;
+
+  int Send(IoMessage&& msg) override;
+
+  void DoClose(bool destroy) override;
+
+  void Stop() override;
+
+  void Join() override;
+
+ private:
+  enum class FlushStatus {
+    kFlushed,
+    kQuotaExceeded,
+    kChannelSaturated,
+    kError
+  };
+
+  class ShmIoHandler;
+
+  EventAction OnReadable() override;
+  EventAction OnWritable() override;
+  void OnError(int err) override;
+  void OnCleanup(CleanupReason reason) override;
+  bool AttachChannel();
+  bool DrainDoorbell();
+  FiberShmConnection::FlushStatus FlushWritingBuffer(std::size_t max_bytes);
+  FiberConnection::EventAction ConsumeReadData();
+  void WaitForWritable();
+
+ private:
+  Socket socket_;
+
+  // Created by `DoConnect` on the client side, attached on the first readable event on the server side.
+  ShmChannelPtr channel_;
+
+  // Set when the outgoing ring is full, the write event is restarted once the peer releases some space.
+  std::atomic<bool> write_blocked_{false};
+
+  // Recv buffer
+  alignas(hardware_destructive_interference_size) NoncontiguousBuffer read_buffer_;
+
+  // Send buffer list
+  alignas(hardware_destructive_interference_size) WritingBufferList writing_buffers_;
+};
+
+}  // namespace trpc
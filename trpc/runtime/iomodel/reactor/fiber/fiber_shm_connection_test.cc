@@ -0,0 +1,232 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_shm_connection.h"
+
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "trpc/coroutine/fiber.h"
+#include "trpc/runtime/fiber_runtime.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_acceptor.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
+#include "trpc/util/latch.h"
+#include "trpc/util/net_util.h"
+
+namespace trpc::testing {
+
+// Packets are prefixed by their length(4 bytes, host byte order).
+class LengthPrefixedHandler : public ConnectionHandler {
+ public:
+  using Callback = Function<void(NoncontiguousBuffer&&)>;
+
+  LengthPrefixedHandler(Connection* conn, Callback&& cb) : conn_(conn), cb_(std::move(cb)) {}
+
+  Connection* GetConnection() const override { return conn_; }
+
+  int CheckMessage(const ConnectionPtr&, NoncontiguousBuffer& in, std::deque<std::any>& out) override {
+    while (in.ByteSize() >= sizeof(uint32_t)) {
+      uint32_t size = 0;
+      FlattenToSlow(in, &size, sizeof(size));
+      if (in.ByteSize() < sizeof(size) + size) {
+        break;
+      }
+      out.emplace_back(in.Cut(sizeof(size) + size));
+    }
+    return out.empty() ? kPacketLess : kPacketFull;
+  }
+
+  bool HandleMessage(const ConnectionPtr&, std::deque<std::any>& msgs) override {
+    for (auto& msg : msgs) {
+      cb_(std::move(std::any_cast<NoncontiguousBuffer&>(msg)));
+    }
+    return true;
+  }
+
+ private:
+  Connection* conn_;
+  Callback cb_;
+};
+
+NoncontiguousBuffer MakePacket(std::size_t size, char c) {
+  uint32_t len = size;
+  NoncontiguousBufferBuilder builder;
+  builder.Append(&len, sizeof(len));
+  builder.Append(std::string(size, c));
+  return builder.DestructiveGet();
+}
+
+class FiberShmConnectionTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    reactor_ = fiber::GetReactor(0, -2);
+    addr_ = NetworkAddress(util::GenRandomAvailablePort(), false, NetworkAddress::IpType::kIpV4);
+
+    // Echo every packet back.
+    ASSERT_TRUE(PrepareShmRendezvousDir());
+    acceptor_ = MakeRefCounted<FiberAcceptor>(reactor_, GetShmRendezvousAddress(addr_));
+    acceptor_->SetAcceptHandleFunction([](AcceptConnectionInfo& connection_info) {
+      connection_info.socket.SetBlock(false);
+      auto conn = MakeRefCounted<FiberShmConnection>(reactor_, connection_info.socket);
+      conn->SetRecvBufferSize(8192);
+      conn->SetConnectionHandler(std::make_unique<LengthPrefixedHandler>(conn.Get(), [conn = conn.Get()](auto&& pkt) {
+        IoMessage msg;
+        msg.buffer = std::move(pkt);
+        conn->Send(std::move(msg));
+      }));
+      conn->Established();
+      conn->StartHandshaking();
+      server_conns_.push_back(std::move(conn));
+      return true;
+    });
+    ASSERT_TRUE(acceptor_->Listen());
+  }
+
+  static void TearDownTestCase() {
+    for (auto& conn : server_conns_) {
+      conn->Stop();
+      conn->Join();
+    }
+    server_conns_.clear();
+
+    acceptor_->Stop();
+    acceptor_->Join();
+    acceptor_ = nullptr;
+  }
+
+ protected:
+  RefPtr<FiberShmConnection> CreateClientConn() {
+    Socket socket = Socket::CreateUnixSocket();
+    socket.SetBlock(false);
+
+    auto conn = MakeRefCounted<FiberShmConnection>(reactor_, socket);
+    conn->SetPeerIp(addr_.Ip());
+    conn->SetPeerPort(addr_.Port());
+    conn->SetPeerIpType(addr_.Type());
+    conn->SetRecvBufferSize(8192);
+    conn->SetClient();
+    conn->SetConnectionHandler(std::make_unique<LengthPrefixedHandler>(conn.Get(), [this](auto&& pkt) {
+      received_data_ += FlattenSlow(pkt);
+      received_ += pkt.ByteSize();
+    }));
+
+    EXPECT_TRUE(conn->DoConnect());
+    conn->StartHandshaking();
+
+    return conn;
+  }
+
+  void WaitForReceived(std::size_t size) {
+    while (received_.load() < size) {
+      FiberSleepFor(std::chrono::milliseconds(1));
+    }
+  }
+
+ protected:
+  static Reactor* reactor_;
+  static NetworkAddress addr_;
+  static RefPtr<FiberAcceptor> acceptor_;
+  static std::vector<RefPtr<FiberShmConnection>> server_conns_;
+
+  std::atomic<std::size_t> received_{0};
+  std::string received_data_;
+};
+
+Reactor* FiberShmConnectionTest::reactor_ = nullptr;
+NetworkAddress FiberShmConnectionTest::addr_;
+RefPtr<FiberAcceptor> FiberShmConnectionTest::acceptor_;
+std::vector<RefPtr<FiberShmConnection>> FiberShmConnectionTest::server_conns_;
+
+TEST_F(FiberShmConnectionTest, Echo) {
+  auto client_conn = CreateClientConn();
+
+  for (int i = 0; i < 10; ++i) {
+    IoMessage msg;
+    msg.buffer = MakePacket(100, 'a' + i);
+    ASSERT_EQ(0, client_conn->Send(std::move(msg)));
+  }
+  WaitForReceived(10 * (100 + sizeof(uint32_t)));
+
+  ASSERT_EQ(10 * (100 + sizeof(uint32_t)), received_.load());
+  ASSERT_EQ(FlattenSlow(MakePacket(100, 'a')), received_data_.substr(0, 100 + sizeof(uint32_t)));
+
+  client_conn->Stop();
+  client_conn->Join();
+}
+
+TEST_F(FiberShmConnectionTest, LargerThanRing) {
+  auto client_conn = CreateClientConn();
+
+  // The packet does not fit in the ring, so it's written and read piece by piece.
+  constexpr std::size_t kSize = 3 * kDefaultShmRingCapacity;
+  IoMessage msg;
+  msg.buffer = MakePacket(kSize, 'x');
+  ASSERT_EQ(0, client_conn->Send(std::move(msg)));
+  WaitForReceived(kSize + sizeof(uint32_t));
+
+  ASSERT_EQ(FlattenSlow(MakePacket(kSize, 'x')), received_data_);
+
+  client_conn->Stop();
+  client_conn->Join();
+}
+
+TEST_F(FiberShmConnectionTest, ConnectFail) {
+  Socket socket = Socket::CreateUnixSocket();
+  socket.SetBlock(false);
+
+  auto conn = MakeRefCounted<FiberShmConnection>(reactor_, socket);
+  conn->SetPeerIp("127.0.0.1");
+  conn->SetPeerPort(1);
+  conn->SetPeerIpType(NetworkAddress::IpType::kIpV4);
+  conn->SetClient();
+
+  ASSERT_FALSE(conn->DoConnect());
+}
+
+}  // namespace trpc::testing
+
+int Start(int argc, char** argv, std::function<int(int, char**)> cb) {
+  signal(SIGPIPE, SIG_IGN);
+
+  trpc::fiber::StartRuntime();
+
+  int rc = 0;
+  {
+    trpc::Latch l(1);
+    trpc::StartFiberDetached([&] {
+      trpc::StartAllFiberReactor();
+
+      rc = cb(argc, argv);
+
+      trpc::StopAllFiberReactor();
+      trpc::JoinAllFiberReactor();
+
+      l.count_down();
+    });
+    l.wait();
+  }
+
+  trpc::fiber::TerminateRuntime();
+  return rc;
+}
+
+int InitAndRunAllTests(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return Start(argc, argv, [](auto, auto) { return ::RUN_ALL_TESTS(); });
+}
+
+int main(int argc, char** argv) { return InitAndRunAllTests(argc, argv); }
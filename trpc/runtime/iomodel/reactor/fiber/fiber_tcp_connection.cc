@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/util/chrono/chrono.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/time.h"
@@ -36,6 +37,8 @@ FiberTcpConnection::~FiberTcpConnection() {
 }
 
 void FiberTcpConnection::Established() {
+  writing_buffers_.SetBudget(GetWriteBufferBudget().get());
+  egress_shaper_.Init(GetEgressRateLimit(), GetServiceEgressBucket());
   SetEstablishTimestamp(trpc::time::GetMilliSeconds());
   SetConnectionState(ConnectionState::kConnected);
   SetConnActiveTime(trpc::time::GetMilliSeconds());
@@ -126,6 +129,9 @@ int FiberTcpConnection::Send(IoMessage&& msg) {
     } else if (flush_status == FlushStatus::kSystemBufferSaturated || flush_status == FlushStatus::kQuotaExceeded) {
       RestartWriteIn(0ms);
       return 0;
+    } else if (flush_status == FlushStatus::kShaped) {
+      RestartWriteIn(egress_shaper_.GetDelay(ReadSteadyClock()));
+      return 0;
     } else if (flush_status == FlushStatus::kPartialWrite || flush_status == FlushStatus::kError) {
       TRPC_LOG_WARN("FiberTcpConnection::Send failed to write ip:"
                      << GetPeerIp() << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
@@ -149,6 +155,10 @@ int FiberTcpConnection::Send(IoMessage&& msg) {
                                                                    << ", is_client:" << IsClient()
                                                                    << ", conn_id: " << this->GetConnId());
     return -2;
+  } else if (append_status == WritingBufferList::kOverBudget) {
+    TRPC_FMT_ERROR_EVERY_SECOND("FiberTcpConnection::Send exceeded write buffer budget ip:{}, port:{}, conn_id:{}",
+                                GetPeerIp(), GetPeerPort(), this->GetConnId());
+    return -1;
   }
 
   return 0;
@@ -188,6 +198,10 @@ FiberConnection::EventAction FiberTcpConnection::OnReadable() {
 
   ReadStatus status;
   do {
+    // Stop reading requests while the data to write is piling up, it's restarted once the data is flushed.
+    if (TRPC_UNLIKELY(writing_buffers_.TryPauseReading())) {
+      return EventAction::kSuppress;
+    }
     status = ReadData();
     if (TRPC_LIKELY(status != ReadStatus::kError)) {
       auto rc = ConsumeReadData();
@@ -289,6 +303,10 @@ FiberConnection::EventAction FiberTcpConnection::OnWritable() {
     return EventAction::kReady;
   } else if (status == FlushStatus::kFlushed) {
     return EventAction::kSuppress;
+  } else if (status == FlushStatus::kShaped) {
+    // Wait for the tokens instead of the writable event.
+    RestartWriteIn(egress_shaper_.GetDelay(ReadSteadyClock()));
+    return EventAction::kSuppress;
   } else if (status == FlushStatus::kPartialWrite || status == FlushStatus::kNothingWritten) {
     Kill(CleanupReason::kDisconnect);
     return EventAction::kLeaving;
@@ -304,6 +322,14 @@ FiberTcpConnection::FlushStatus FiberTcpConnection::FlushWritingBuffer(std::size
   auto bytes_quota = max_bytes;
   bool ever_succeeded = false;
 
+  if (TRPC_UNLIKELY(egress_shaper_.Enabled())) {
+    bytes_quota = egress_shaper_.GetQuota(max_bytes, ReadSteadyClock());
+    if (bytes_quota == 0) {
+      return FlushStatus::kShaped;
+    }
+  }
+  bool shaped = bytes_quota < max_bytes;
+
   while (bytes_quota) {
     bool emptied = false;
     bool short_write = false;
@@ -331,6 +357,14 @@ FiberTcpConnection::FlushStatus FiberTcpConnection::FlushWritingBuffer(std::size
     ever_succeeded = true;
     bytes_quota -= written;
 
+    if (TRPC_UNLIKELY(egress_shaper_.Enabled())) {
+      egress_shaper_.Consume(written, ReadSteadyClock());
+    }
+
+    if (TRPC_UNLIKELY(writing_buffers_.TryResumeReading())) {
+      RestartReadIn(0ns);
+    }
+
     // Update the active time of the connection when there is a write operation on the file descriptor (fd)
     SetConnActiveTime(trpc::time::GetMilliSeconds());
     GetConnectionHandler()->UpdateConnection();
@@ -344,7 +378,7 @@ FiberTcpConnection::FlushStatus FiberTcpConnection::FlushWritingBuffer(std::size
     }
   }
 
-  return FlushStatus::kQuotaExceeded;
+  return shaped ? FlushStatus::kShaped : FlushStatus::kQuotaExceeded;
 }
 
 void FiberTcpConnection::OnError(int err) {
@@ -13,6 +13,7 @@
 #include <list>
 #include <memory>
 
+#include "trpc/runtime/iomodel/reactor/common/egress_shaper.h"
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/writing_buffer_list.h"
@@ -49,6 +50,7 @@ class FiberTcpConnection final : public FiberConnection {
     kSystemBufferSaturated,
     kPartialWrite,
     kNothingWritten,
+    kShaped,
     kError
   };
 
@@ -82,6 +84,9 @@ class FiberTcpConnection final : public FiberConnection {
 
   // Send buffer list
   alignas(hardware_destructive_interference_size) WritingBufferList writing_buffers_;
+
+  // Limits the egress bandwidth, only accessed by the writer.
+  EgressShaper egress_shaper_;
 };
 
 }  // namespace trpc
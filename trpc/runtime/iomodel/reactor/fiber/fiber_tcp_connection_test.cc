@@ -26,6 +26,7 @@
 #include "trpc/runtime/iomodel/reactor/common/default_io_handler.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_acceptor.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
+#include "trpc/util/chrono/chrono.h"
 #include "trpc/util/latch.h"
 #include "trpc/util/net_util.h"
 
@@ -153,7 +154,7 @@ class FiberTcpConnectionTestImpl {
   }
 
   template <class IoHandlerType>
-  RefPtr<FiberTcpConnection> CreateClientConn() {
+  RefPtr<FiberTcpConnection> CreateClientConn(uint64_t egress_rate_limit = 0) {
     trpc::Socket socket = Socket::CreateTcpSocket(addr_.IsIpv6());
     socket.SetTcpNoDelay();
     socket.SetCloseWaitDefault();
@@ -165,6 +166,7 @@ class FiberTcpConnectionTestImpl {
     client_conn->SetPeerPort(addr_.Port());
     client_conn->SetPeerIpType(addr_.Type());
     client_conn->SetClient();
+    client_conn->SetEgressRateLimit(egress_rate_limit);
 
     std::unique_ptr<ConnectionTestHandler> handler = std::make_unique<ConnectionTestHandler>(kDataSize, client_conn.Get());
     auto cb = [this] { client_received_ += kDataSize; };
@@ -204,8 +206,8 @@ class FiberTcpConnectionTest : public ::testing::Test {
   static void TearDownTestCase() { test_impl_.TearDown(); }
 
   template <class IoHandlerType>
-  RefPtr<FiberTcpConnection> CreateClientConn() {
-    return test_impl_.CreateClientConn<IoHandlerType>();
+  RefPtr<FiberTcpConnection> CreateClientConn(uint64_t egress_rate_limit = 0) {
+    return test_impl_.CreateClientConn<IoHandlerType>(egress_rate_limit);
   }
 
   std::size_t GetServerReceived() { return test_impl_.GetServerReceived(); }
@@ -314,6 +316,46 @@ TEST_F(FiberTcpConnectionTest, WriteError2) {
   client_conn->Join();
 }
 
+class CountingIoHandler : public DefaultIoHandler {
+ public:
+  using DefaultIoHandler::DefaultIoHandler;
+
+  int Writev(const iovec* iov, int iovcnt) override {
+    int ret = DefaultIoHandler::Writev(iov, iovcnt);
+    if (ret > 0) {
+      written += ret;
+    }
+    return ret;
+  }
+
+  std::atomic<std::size_t> written{0};
+};
+
+TEST_F(FiberTcpConnectionTest, EgressShaped) {
+  // 1MB/s, the burst is 100KB.
+  RefPtr<FiberTcpConnection> client_conn = CreateClientConn<CountingIoHandler>(1000000);
+  auto* io_handler = static_cast<CountingIoHandler*>(client_conn->GetIoHandler());
+
+  constexpr std::size_t kCount = 3000;
+  auto start = ReadSteadyClock();
+  for (std::size_t i = 0; i != kCount; ++i) {
+    IoMessage msg;
+    msg.seq_id = 0;
+    msg.buffer = CreateBufferSlow(std::string(kDataSize, 1));
+    ASSERT_EQ(0, client_conn->Send(std::move(msg)));
+  }
+
+  ASSERT_LT(io_handler->written.load(), kCount * kDataSize);
+  while (io_handler->written.load() != kCount * kDataSize) {
+    FiberSleepFor(std::chrono::milliseconds(1));
+  }
+  // The bytes beyond the burst(200KB) are sent at 1MB/s.
+  ASSERT_GE(ReadSteadyClock() - start, std::chrono::milliseconds(150));
+
+  client_conn->Stop();
+  client_conn->Join();
+}
+
 }  // namespace testing
 
 }  // namespace trpc
@@ -10,8 +10,13 @@
 
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_udp_transceiver.h"
 
+#include <algorithm>
 #include <limits>
 #include <utility>
+#include <vector>
+
+#include "trpc/coroutine/fiber_timer.h"
+#include "trpc/util/chrono/chrono.h"
 
 namespace trpc {
 
@@ -45,6 +50,11 @@ void FiberUdpTransceiver::EnableReadWrite() {
   SetInitializationState(InitializationState::kInitializedSuccess);
 }
 
+void FiberUdpTransceiver::SetBatchOptions(std::size_t batch_size, std::chrono::microseconds max_delay) {
+  batch_size_ = std::min(std::max<std::size_t>(batch_size, 1), WritingDatagramList::kMaxBatchSize);
+  batch_max_delay_ = max_delay;
+}
+
 void FiberUdpTransceiver::RestartWriteEvent() {
   // The FlushWritingBuffer function of udp can be executed concurrently, and RestartWriteEvent may be called multiple
   // times. Here, we limit the registration of the write event to only one time by using the restart_write_count_
@@ -79,6 +89,12 @@ int FiberUdpTransceiver::Send(IoMessage&& msg) {
 int FiberUdpTransceiver::SendWithDatagramList(IoMessage&& msg) {
   NetworkAddress to(msg.ip, msg.port, NetworkAddress::IpType::kUnknown);
   if (write_list_.Append(std::move(to), std::move(msg))) {
+    // Write-behind: wait a while for the packets sent by other fibers, unless there are enough to fill a batch.
+    if (batch_size_ > 1 && batch_max_delay_.count() > 0 && write_list_.Size() < batch_size_) {
+      ScheduleBatchFlush();
+      return 0;
+    }
+
     auto rc = FlushWritingBuffer(max_writes_percall_);
 
     if (rc == FlushStatus::kSystemBufferSaturated || rc == FlushStatus::kQuotaExceeded) {
@@ -105,6 +121,28 @@ int FiberUdpTransceiver::SendWithDatagramList(IoMessage&& msg) {
   return -1;
 }
 
+void FiberUdpTransceiver::ScheduleBatchFlush() {
+  if (batch_flush_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  SetFiberDetachedTimer(ReadSteadyClock() + batch_max_delay_, [this, ref = RefPtr(ref_ptr, this)] {
+    batch_flush_scheduled_.store(false, std::memory_order_release);
+    if (!Enabled()) {
+      return;
+    }
+
+    auto rc = FlushWritingBuffer(max_writes_percall_);
+    if (rc == FlushStatus::kSystemBufferSaturated || rc == FlushStatus::kQuotaExceeded) {
+      RestartWriteEvent();
+    } else if (rc == FlushStatus::kPartialWrite || rc == FlushStatus::kNothingWritten || rc == FlushStatus::kError) {
+      TRPC_LOG_ERROR("FiberUdpTransceiver::ScheduleBatchFlush send datagram error, fd:"
+                     << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
+                     << ", rc:" << static_cast<int>(rc) << ", errno:" << errno);
+    }
+  });
+}
+
 void FiberUdpTransceiver::Stop() {
   // Resource cleanup should only be performed when the initialization is successful
   if (GetInitializationState() == InitializationState::kInitializedSuccess) {
@@ -120,6 +158,10 @@ void FiberUdpTransceiver::Join() {
 }
 
 FiberConnection::EventAction FiberUdpTransceiver::OnReadable() {
+  if (batch_size_ > 1) {
+    return OnBatchReadable();
+  }
+
   read_buffer_.Clear();
 
   while (true) {
@@ -139,31 +181,94 @@ FiberConnection::EventAction FiberUdpTransceiver::OnReadable() {
       }
     }
 
-    SetPeerIp(peer_addr.Ip());
-    SetPeerPort(peer_addr.Port());
     TRPC_ASSERT(static_cast<uint32_t>(read) <= kUdpBuffSize);
-    read_buffer_.Append(CreateBufferSlow(recv_buffer, read));
-
-    RefPtr ref(ref_ptr, this);
-    std::deque<std::any> data;
-    int checker_ret = GetConnectionHandler()->CheckMessage(ref, read_buffer_, data);
-    if (checker_ret == kPacketFull) {
-      bool handle_ret = GetConnectionHandler()->HandleMessage(ref, data);
-      if (!handle_ret) {
-        TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable MessageHandle error, fd:"
-                       << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
-                       << ", ip:" << GetPeerIp() << ", port:" << GetPeerPort());
+    if (!HandleDatagram(recv_buffer, read, peer_addr)) {
+      break;
+    }
+  }
+  return EventAction::kReady;
+}
+
+FiberConnection::EventAction FiberUdpTransceiver::OnBatchReadable() {
+  read_buffer_.Clear();
+
+  // The buffers are allocated lazily, only the threads which really read in batches pay for them.
+  thread_local std::vector<char> recv_buffers;
+  thread_local iovec iov[WritingDatagramList::kMaxBatchSize];
+  thread_local mmsghdr msgs[WritingDatagramList::kMaxBatchSize];
+  thread_local sockaddr_storage addrs[WritingDatagramList::kMaxBatchSize];
+  if (recv_buffers.size() < batch_size_ * kUdpBuffSize) {
+    recv_buffers.resize(batch_size_ * kUdpBuffSize);
+  }
+
+  while (true) {
+    for (std::size_t i = 0; i != batch_size_; ++i) {
+      iov[i].iov_base = recv_buffers.data() + i * kUdpBuffSize;
+      iov[i].iov_len = kUdpBuffSize;
+      msgs[i].msg_hdr = {.msg_name = &addrs[i],
+                         .msg_namelen = sizeof(sockaddr_storage),
+                         .msg_iov = &iov[i],
+                         .msg_iovlen = 1,
+                         .msg_control = nullptr,
+                         .msg_controllen = 0,
+                         .msg_flags = 0};
+      msgs[i].msg_len = 0;
+    }
+
+    int read = socket_.RecvMmsg(msgs, batch_size_);
+    if (read < 0) {
+      if (errno == EAGAIN) {
         break;
+      } else {
+        TRPC_LOG_ERROR("FiberUdpTransceiver::OnBatchReadable read datagram error, fd:"
+                       << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
+                       << ", ip:" << GetPeerIp() << ", port:" << GetPeerPort() << ", errno:" << errno);
+        // only discard the packet received, no need to close the socket
+        return EventAction::kReady;
+      }
+    }
+
+    for (int i = 0; i != read; ++i) {
+      NetworkAddress peer_addr(reinterpret_cast<const sockaddr*>(&addrs[i]));
+      if (!HandleDatagram(static_cast<const char*>(iov[i].iov_base), msgs[i].msg_len, peer_addr)) {
+        // Only discard the bad packet(logged by `HandleDatagram`), the others in the batch are still handled.
+        read_buffer_.Clear();
+        continue;
       }
-    } else if (checker_ret == kPacketError) {
-      TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable check error, fd:"
+    }
+
+    // The socket receive buffer has been drained.
+    if (static_cast<std::size_t>(read) < batch_size_) {
+      break;
+    }
+  }
+  return EventAction::kReady;
+}
+
+bool FiberUdpTransceiver::HandleDatagram(const char* data, std::size_t len, const NetworkAddress& peer_addr) {
+  SetPeerIp(peer_addr.Ip());
+  SetPeerPort(peer_addr.Port());
+  read_buffer_.Append(CreateBufferSlow(data, len));
+
+  RefPtr ref(ref_ptr, this);
+  std::deque<std::any> data_list;
+  int checker_ret = GetConnectionHandler()->CheckMessage(ref, read_buffer_, data_list);
+  if (checker_ret == kPacketFull) {
+    bool handle_ret = GetConnectionHandler()->HandleMessage(ref, data_list);
+    if (!handle_ret) {
+      TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable MessageHandle error, fd:"
                      << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
                      << ", ip:" << GetPeerIp() << ", port:" << GetPeerPort());
-      // only discard the packet received, no need to close the socket
-      return EventAction::kReady;
+      return false;
     }
+  } else if (checker_ret == kPacketError) {
+    TRPC_LOG_ERROR("FiberUdpTransceiver::OnReadable check error, fd:"
+                   << socket_.GetFd() << ", conn_id:" << this->GetConnId() << ", is_client:" << IsClient()
+                   << ", ip:" << GetPeerIp() << ", port:" << GetPeerPort());
+    // only discard the packet received, no need to close the socket
+    return false;
   }
-  return EventAction::kReady;
+  return true;
 }
 
 FiberConnection::EventAction FiberUdpTransceiver::OnWritable() {
@@ -207,7 +312,8 @@ FiberUdpTransceiver::FlushStatus FiberUdpTransceiver::FlushWritingBuffer(std::si
   while (max_writes--) {
     bool emptied;
 
-    auto rc = write_list_.FlushTo(socket_, GetConnectionHandler(), &emptied);
+    auto rc = batch_size_ > 1 ? write_list_.FlushBatchTo(socket_, GetConnectionHandler(), batch_size_, &emptied)
+                              : write_list_.FlushTo(socket_, GetConnectionHandler(), &emptied);
     if (rc == 0) {
       return emptied ? FlushStatus::kFlushed : FlushStatus::kNothingWritten;
     } else if (rc < 0) {
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <memory>
 
@@ -30,6 +32,19 @@ class FiberUdpTransceiver final : public FiberConnection {
   /// @brief Start listening for read/write events
   void EnableReadWrite();
 
+  /// @brief Set the options of sending/receiving udp packets in batches by `sendmmsg`/`recvmmsg`.
+  /// @param batch_size The maximum number of udp packets per system call, 0 or 1 means no batching.
+  /// @param max_delay The maximum time that a udp packet waits for other packets to be sent with it in one batch,
+  ///                  0 means the packets appended concurrently are sent as soon as possible without waiting.
+  /// @note It must be called before `EnableReadWrite`.
+  void SetBatchOptions(std::size_t batch_size, std::chrono::microseconds max_delay);
+
+  /// @brief Send a udp packet.
+  /// @return 0 on success, -1 on failure
+  /// @note With `max_delay` of the batch options, the packet may wait to be sent by the timer(write-behind), 0 is
+  ///       returned once it is queued. A packet which fails to be sent in a batch is dropped and passed to
+  ///       `ConnectionHandler::NotifyMessageFailed` of this transceiver, the handler is responsible for failing the
+  ///       request it belongs to. If the handler ignores it, the request ends with a timeout.
   int Send(IoMessage&& msg) override;
 
   void Stop() override;
@@ -51,6 +66,15 @@ class FiberUdpTransceiver final : public FiberConnection {
 
   int SendWithDatagramList(IoMessage&& msg);
 
+  // Arm a timer to flush the packets waiting in the batch, if it has not been armed.
+  void ScheduleBatchFlush();
+
+  // Read udp packets by one `recvmmsg` call per batch.
+  EventAction OnBatchReadable();
+
+  // Handle one received udp packet, returns false if the reading should be stopped.
+  bool HandleDatagram(const char* data, std::size_t len, const NetworkAddress& peer_addr);
+
  private:
   Socket socket_;
 
@@ -69,6 +93,15 @@ class FiberUdpTransceiver final : public FiberConnection {
 
   WritingDatagramList write_list_;
 
+  // The maximum number of udp packets sent/received per system call, no batching if it is less than 2.
+  std::size_t batch_size_ = 1;
+
+  // The maximum time that a udp packet waits to be gathered into a batch.
+  std::chrono::microseconds batch_max_delay_{0};
+
+  // Whether the timer to flush the batch has been armed.
+  std::atomic<bool> batch_flush_scheduled_{false};
+
   // Listening address
   NetworkAddress udp_addr_;
 };
@@ -13,6 +13,7 @@
 
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_udp_transceiver.h"
 
+#include <atomic>
 #include <random>
 #include <string>
 #include <utility>
@@ -151,6 +152,125 @@ TEST(TestFiberUdpTransceiver, Normal) {
   client_udp_transceiver->Join();
 }
 
+
+// Each datagram is a packet, the ones starting with 'e' are malformed.
+class BatchTestHandler : public ConnectionHandler {
+ public:
+  explicit BatchTestHandler(Connection* conn) : conn_(conn) {}
+
+  Connection* GetConnection() const override { return conn_; }
+
+  int CheckMessage(const ConnectionPtr&, NoncontiguousBuffer& in, std::deque<std::any>& out) override {
+    std::string data = FlattenSlow(in);
+    in.Clear();
+    if (data.empty() || data[0] == 'e') {
+      return kPacketError;
+    }
+    out.emplace_back(std::move(data));
+    return kPacketFull;
+  }
+
+  bool HandleMessage(const ConnectionPtr&, std::deque<std::any>& data) override {
+    handled += data.size();
+    return true;
+  }
+
+  void NotifyMessageFailed(const IoMessage& msg, ConnectionErrorCode) override {
+    failed_seq_id = msg.seq_id;
+    ++failed;
+  }
+
+  std::atomic<std::size_t> handled{0};
+  std::atomic<std::size_t> failed{0};
+  std::atomic<uint32_t> failed_seq_id{0};
+
+ private:
+  Connection* conn_;
+};
+
+RefPtr<FiberUdpTransceiver> CreateBatchTransceiver(const NetworkAddress* bind_addr, std::size_t batch_size,
+                                                   std::chrono::microseconds max_delay) {
+  Reactor* reactor = trpc::fiber::GetReactor(0, -2);
+  trpc::Socket socket = Socket::CreateUdpSocket(false);
+  socket.SetBlock(false);
+  if (bind_addr != nullptr) {
+    socket.SetReuseAddr();
+    socket.Bind(*bind_addr);
+  }
+
+  auto transceiver = MakeRefCounted<FiberUdpTransceiver>(reactor, socket, bind_addr == nullptr);
+  if (bind_addr == nullptr) {
+    transceiver->SetClient();
+  }
+  transceiver->SetConnectionHandler(std::make_unique<BatchTestHandler>(transceiver.Get()));
+  transceiver->SetIoHandler(std::make_unique<DefaultIoHandler>(transceiver.Get()));
+  transceiver->SetBatchOptions(batch_size, max_delay);
+  transceiver->EnableReadWrite();
+  return transceiver;
+}
+
+BatchTestHandler* GetBatchTestHandler(const RefPtr<FiberUdpTransceiver>& transceiver) {
+  return static_cast<BatchTestHandler*>(transceiver->GetConnectionHandler());
+}
+
+void WaitFor(const std::atomic<std::size_t>& value, std::size_t expected) {
+  auto deadline = ReadSteadyClock() + std::chrono::seconds(3);
+  while (value.load() < expected && ReadSteadyClock() < deadline) {
+    FiberSleepFor(std::chrono::milliseconds(1));
+  }
+}
+
+TEST(TestFiberUdpTransceiver, BatchReadSkipsMalformedDatagram) {
+  NetworkAddress addr("127.0.0.1", trpc::util::GenRandomAvailablePort(), NetworkAddress::IpType::kIpV4);
+  auto server = CreateBatchTransceiver(&addr, 8, std::chrono::microseconds(0));
+
+  // A malformed datagram in the middle of a batch must not discard the ones behind it.
+  trpc::Socket client_socket = Socket::CreateUdpSocket(false);
+  for (int i = 0; i != 10; ++i) {
+    std::string data = i == 4 ? "error" : "data" + std::to_string(i);
+    ASSERT_EQ(client_socket.SendTo(data.data(), data.size(), 0, addr), static_cast<int>(data.size()));
+  }
+
+  WaitFor(GetBatchTestHandler(server)->handled, 9);
+  ASSERT_EQ(GetBatchTestHandler(server)->handled.load(), 9);
+
+  client_socket.Close();
+  server->Stop();
+  server->Join();
+}
+
+TEST(TestFiberUdpTransceiver, WriteBehindBatchDropsFailedDatagram) {
+  NetworkAddress addr("127.0.0.1", trpc::util::GenRandomAvailablePort(), NetworkAddress::IpType::kIpV4);
+  auto server = CreateBatchTransceiver(&addr, 8, std::chrono::microseconds(0));
+  auto client = CreateBatchTransceiver(nullptr, 8, std::chrono::microseconds(1000));
+
+  auto make_msg = [](uint32_t seq_id, std::string ip, uint16_t port) {
+    IoMessage msg;
+    msg.seq_id = seq_id;
+    msg.ip = std::move(ip);
+    msg.port = port;
+    msg.buffer = CreateBufferSlow("data" + std::to_string(seq_id));
+    return msg;
+  };
+  // An ipv6 destination can never be reached by the ipv4 socket, the packet fails at the head of the batch.
+  ASSERT_EQ(client->Send(make_msg(1, "::1", addr.Port())), 0);
+  ASSERT_EQ(client->Send(make_msg(2, addr.Ip(), addr.Port())), 0);
+  ASSERT_EQ(client->Send(make_msg(3, addr.Ip(), addr.Port())), 0);
+
+  // The packets are queued(write-behind) and flushed by the timer, the failed one is passed to its handler.
+  WaitFor(GetBatchTestHandler(client)->failed, 1);
+  ASSERT_EQ(GetBatchTestHandler(client)->failed.load(), 1);
+  ASSERT_EQ(GetBatchTestHandler(client)->failed_seq_id.load(), 1);
+
+  WaitFor(GetBatchTestHandler(server)->handled, 2);
+  ASSERT_EQ(GetBatchTestHandler(server)->handled.load(), 2);
+
+  client->Stop();
+  client->Join();
+  server->Stop();
+  server->Join();
+}
+
 }  // namespace trpc::testing
 
 int Start(int argc, char** argv, std::function<int(int, char**)> cb) {
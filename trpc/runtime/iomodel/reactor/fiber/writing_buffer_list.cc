@@ -38,9 +38,18 @@ struct ObjectPoolTraits<WritingBufferList::Node> {
 
 }  // namespace object_pool
 
+WritingBufferList::WritingBufferList() {
+  if (WriteBufferBudget::Global()->Enabled()) {
+    global_budget_ = WriteBufferBudget::Global();
+  }
+}
+
 WritingBufferList::~WritingBufferList() {
   Stop();
 
+  // Give back the bytes never written out.
+  RefundBudget(size_.load(std::memory_order_acquire));
+
   // Free the list.
   object_pool::LwUniquePtr<Node> ptr;
   auto current = head_.load(std::memory_order_acquire);
@@ -67,6 +76,10 @@ WritingBufferList::~WritingBufferList() {
 void WritingBufferList::Stop() {
   stop_token_.store(true, std::memory_order_release);
 
+  if (reading_paused_.exchange(false, std::memory_order_relaxed)) {
+    WriteBufferBudget::Global()->DecPausedConnection();
+  }
+
   if (TRPC_LIKELY(fiber::detail::IsFiberContextPresent())) {
     writable_cv_.notify_all();
     Append({}, {}, std::numeric_limits<size_t>::max(), 0);
@@ -120,6 +133,7 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
   if (size_.fetch_sub(flushed, std::memory_order_acq_rel) - flushed < max_capacity) {
     writable_cv_.notify_one();
   }
+  RefundBudget(flushed);
 
   // Rewind.
   //
@@ -180,6 +194,11 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
 
 WritingBufferList::BufferAppendStatus WritingBufferList::Append(NoncontiguousBuffer buffer, IoMessage&& io_msg,
                                                                 size_t max_capacity, int64_t timeout) {
+  if (TRPC_UNLIKELY(!buffer.Empty() && OverBudget())) {
+    WriteBufferBudget::Global()->AddRejected();
+    return kOverBudget;
+  }
+
   if (max_capacity != 0) {
     std::unique_lock lock{mutex_};
     if (!writable_cv_.wait_for(lock, std::chrono::milliseconds(timeout), [&] {
@@ -191,6 +210,7 @@ WritingBufferList::BufferAppendStatus WritingBufferList::Append(NoncontiguousBuf
 
   // `size_` must add before appending node, otherwise `FlushTo` might underflow on sub.
   size_.fetch_add(buffer.ByteSize(), std::memory_order_release);
+  ChargeBudget(buffer.ByteSize());
 
   auto node = object_pool::MakeLwUnique<Node>();
   node->next.store(nullptr, std::memory_order_relaxed);
@@ -236,4 +256,76 @@ void WritingBufferList::PreSendMessage(bool support_pipeline, ConnectionHandler*
   current->pre_send_flag.store(true, std::memory_order_release);
 }
 
+void WritingBufferList::SetBudget(WriteBufferBudget* budget) {
+  service_budget_ = (budget && budget->Enabled()) ? budget : nullptr;
+}
+
+bool WritingBufferList::OverBudget() const {
+  if (TRPC_LIKELY(!global_budget_ && !service_budget_)) {
+    return false;
+  }
+  return size_.load(std::memory_order_acquire) > 0 &&
+         ((global_budget_ && global_budget_->Exceeded()) || (service_budget_ && service_budget_->Exceeded()));
+}
+
+bool WritingBufferList::TryPauseReading() {
+  if (TRPC_LIKELY(!global_budget_ && !service_budget_)) {
+    return false;
+  }
+
+  if (!OverBudget()) {
+    // The reader may still be watching events while paused(eg: shm connection), clear the mark by itself then.
+    if (TRPC_UNLIKELY(reading_paused_.load(std::memory_order_relaxed)) &&
+        reading_paused_.exchange(false, std::memory_order_seq_cst)) {
+      WriteBufferBudget::Global()->DecPausedConnection();
+    }
+    return false;
+  }
+  if (reading_paused_.load(std::memory_order_relaxed)) {
+    return true;
+  }
+
+  WriteBufferBudget::Global()->IncPausedConnection();
+  reading_paused_.store(true, std::memory_order_seq_cst);
+  // Check again, the list may have been flushed by the writer before it saw the mark.
+  if (!OverBudget() && reading_paused_.exchange(false, std::memory_order_seq_cst)) {
+    WriteBufferBudget::Global()->DecPausedConnection();
+    return false;
+  }
+  return true;
+}
+
+bool WritingBufferList::TryResumeReading() {
+  if (TRPC_LIKELY(!global_budget_ && !service_budget_)) {
+    return false;
+  }
+
+  // Pairs with the one in `TryPauseReading`, the mark is not missed after `size_` is decreased.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (TRPC_LIKELY(!reading_paused_.load(std::memory_order_relaxed)) || OverBudget() ||
+      !reading_paused_.exchange(false, std::memory_order_seq_cst)) {
+    return false;
+  }
+  WriteBufferBudget::Global()->DecPausedConnection();
+  return true;
+}
+
+void WritingBufferList::ChargeBudget(size_t bytes) {
+  if (global_budget_) {
+    global_budget_->Charge(bytes);
+  }
+  if (service_budget_) {
+    service_budget_->Charge(bytes);
+  }
+}
+
+void WritingBufferList::RefundBudget(size_t bytes) {
+  if (global_budget_) {
+    global_budget_->Refund(bytes);
+  }
+  if (service_budget_) {
+    service_budget_->Refund(bytes);
+  }
+}
+
 }  // namespace trpc
@@ -17,6 +17,7 @@
 #include "trpc/runtime/iomodel/reactor/common/connection_handler.h"
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
 #include "trpc/runtime/iomodel/reactor/common/io_message.h"
+#include "trpc/runtime/iomodel/reactor/common/write_buffer_budget.h"
 #include "trpc/util/align.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 
@@ -32,9 +33,9 @@ struct ObjectPoolTraits;
 /// @brief An mpsc writing buffer queue.
 class alignas(hardware_destructive_interference_size) WritingBufferList {
  public:
-  enum BufferAppendStatus { kAppendHead, kAppendTail, kTimeout };
+  enum BufferAppendStatus { kAppendHead, kAppendTail, kTimeout, kOverBudget };
 
-  WritingBufferList() = default;
+  WritingBufferList();
 
   ~WritingBufferList();
 
@@ -53,12 +54,31 @@ class alignas(hardware_destructive_interference_size) WritingBufferList {
                   bool support_pipeline, bool* emptied, bool* short_write);
 
   /// @brief Append the buffer to be sent to the tail of the list
+  /// @note  It fails fast with `kOverBudget` if the list still holds data while a write buffer budget is exceeded.
   BufferAppendStatus Append(NoncontiguousBuffer buffer, IoMessage&& io_msg, size_t max_capacity, int64_t timeout);
 
   void Stop();
 
   size_t Size() { return size_; }
 
+  /// @brief Set the write buffer budget of the service, the bytes appended are charged to it as well as to the
+  ///        budget of the whole process. The budgets not enabled are ignored.
+  /// @note  It must be called before appending any buffer.
+  void SetBudget(WriteBufferBudget* budget);
+
+  /// @brief Whether a write buffer budget is exceeded while the list still holds data to write.
+  bool OverBudget() const;
+
+  /// @brief Called by the reader of the connection before reading, it marks the reading as paused if the list is over
+  ///        budget.
+  /// @return true: the reader should stop reading until `TryResumeReading` returns true.
+  bool TryPauseReading();
+
+  /// @brief Called by the writer of the connection after flushing, it clears the paused mark once the list is not over
+  ///        budget anymore.
+  /// @return true: the reading was paused, the writer should restart it.
+  bool TryResumeReading();
+
  private:
   struct Node {
     std::atomic<Node*> next;
@@ -70,6 +90,9 @@ class alignas(hardware_destructive_interference_size) WritingBufferList {
 
   void PreSendMessage(bool support_pipeline, ConnectionHandler* conn_handle, Node* current);
 
+  void ChargeBudget(size_t bytes);
+  void RefundBudget(size_t bytes);
+
  private:
   alignas(hardware_destructive_interference_size) std::atomic<Node*> head_{nullptr};
   alignas(hardware_destructive_interference_size) std::atomic<Node*> tail_{nullptr};
@@ -78,6 +101,13 @@ class alignas(hardware_destructive_interference_size) WritingBufferList {
   FiberMutex mutex_;
   FiberConditionVariable writable_cv_;
   std::atomic<bool> stop_token_{false};
+
+  // The budgets charged, nullptr if not enabled.
+  WriteBufferBudget* global_budget_{nullptr};
+  WriteBufferBudget* service_budget_{nullptr};
+
+  // Whether the reading of the connection is paused because of the budgets.
+  std::atomic<bool> reading_paused_{false};
 };
 
 }  // namespace trpc
@@ -132,11 +132,48 @@ void TestShortWrite() {
   ASSERT_TRUE(short_write);
 }
 
+void TestOverBudget() {
+  WriteBufferBudget budget(5);
+  {
+    WritingBufferList buffer;
+    buffer.SetBudget(&budget);
+
+    // The first buffer is always accepted, even if it's larger than the budget.
+    ASSERT_EQ(WritingBufferList::BufferAppendStatus::kAppendHead, buffer.Append(CreateBufferSlow("123"), {}, 0, 0));
+    ASSERT_FALSE(buffer.OverBudget());
+    ASSERT_EQ(WritingBufferList::BufferAppendStatus::kAppendTail, buffer.Append(CreateBufferSlow("2234"), {}, 0, 0));
+    ASSERT_EQ(7, budget.GetUsed());
+    ASSERT_TRUE(buffer.OverBudget());
+    ASSERT_EQ(WritingBufferList::BufferAppendStatus::kOverBudget, buffer.Append(CreateBufferSlow("3"), {}, 0, 0));
+    ASSERT_EQ(1, WriteBufferBudget::Global()->GetRejectedCount());
+
+    ASSERT_TRUE(buffer.TryPauseReading());
+    ASSERT_EQ(1, WriteBufferBudget::Global()->GetPausedConnectionCount());
+    ASSERT_FALSE(buffer.TryResumeReading());
+
+    // Flushing gives the bytes back.
+    std::unique_ptr<IoHandler> io_handler = std::make_unique<TestIoHandler>();
+    bool emptied = false;
+    bool short_write = true;
+    MockConnHanlder mock_handler;
+    ASSERT_EQ(buffer.FlushTo(io_handler.get(), &mock_handler, 3, 0, false, &emptied, &short_write), 3);
+    ASSERT_EQ(4, budget.GetUsed());
+    ASSERT_FALSE(buffer.OverBudget());
+    ASSERT_TRUE(buffer.TryResumeReading());
+    ASSERT_EQ(0, WriteBufferBudget::Global()->GetPausedConnectionCount());
+    ASSERT_FALSE(buffer.TryPauseReading());
+    ASSERT_EQ(WritingBufferList::BufferAppendStatus::kAppendTail, buffer.Append(CreateBufferSlow("3"), {}, 0, 0));
+  }
+  // So does destroying the list.
+  ASSERT_EQ(0, budget.GetUsed());
+}
+
 TEST(WritingBufferList, All) {
   RunAsFiber([]() {
     TestEmptied();
     TestPartialFlush();
     TestShortWrite();
+    TestOverBudget();
   });
 }
 
@@ -10,10 +10,13 @@
 
 #include "trpc/runtime/iomodel/reactor/fiber/writing_datagram_list.h"
 
+#include <errno.h>
+
 #include <algorithm>
 #include <climits>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace trpc {
 
@@ -66,6 +69,112 @@ ssize_t WritingDatagramList::FlushTo(Socket& socket, ConnectionHandler* conn_han
   return rc;
 }
 
+ssize_t WritingDatagramList::FlushBatchTo(Socket& socket, ConnectionHandler* conn_handler, std::size_t max_batch,
+                                          bool* emptied) {
+  thread_local std::vector<std::tuple<NetworkAddress, IoMessage>> batch;
+  batch.clear();
+
+  max_batch = std::min(max_batch, kMaxBatchSize);
+  *emptied = false;
+
+  std::unique_lock lk(lock_);
+  if (list_.empty()) {
+    *emptied = true;
+    return 0;
+  }
+
+  // Pop the packets from the queue first to reduce the granularity of the lock
+  while (!list_.empty() && batch.size() < max_batch) {
+    batch.emplace_back(std::move(list_.front()));
+    list_.pop_front();
+  }
+  lk.unlock();
+
+  thread_local iovec iov[IOV_MAX];
+  thread_local mmsghdr msgs[kMaxBatchSize];
+  // Used for highly fragmented situations
+  std::string flatten[kMaxBatchSize];
+  std::size_t used_iov = 0;
+  std::size_t nmsg = 0;
+
+  for (; nmsg != batch.size(); ++nmsg) {
+    auto&& [to, io_msg] = batch[nmsg];
+    std::size_t nv = io_msg.buffer.size();
+    iovec* msg_iov = iov + used_iov;
+
+    if (TRPC_UNLIKELY(nv > IOV_MAX)) {  // highly fragmented
+      if (used_iov + 1 > IOV_MAX) {
+        break;
+      }
+      TRPC_LOG_WARN("msg is highly fragmented and cannot be handled by `iovec`s. Flattening.");
+      flatten[nmsg] = FlattenSlow(io_msg.buffer);
+      msg_iov->iov_base = const_cast<char*>(flatten[nmsg].data());
+      msg_iov->iov_len = flatten[nmsg].size();
+      nv = 1;
+    } else {
+      // The remaining `iovec`s are not enough, the left packets will be sent in the next batch.
+      if (used_iov + nv > IOV_MAX) {
+        break;
+      }
+      std::size_t i = 0;
+      for (auto bi = io_msg.buffer.begin(); bi != io_msg.buffer.end(); ++bi, ++i) {
+        msg_iov[i].iov_base = const_cast<char*>(bi->data());
+        msg_iov[i].iov_len = bi->size();
+      }
+    }
+    used_iov += nv;
+
+    msgs[nmsg].msg_hdr = {.msg_name = const_cast<void*>(reinterpret_cast<const void*>(to.SockAddr())),
+                          .msg_namelen = to.Socklen(),
+                          .msg_iov = msg_iov,
+                          .msg_iovlen = nv,
+                          .msg_control = nullptr,
+                          .msg_controllen = 0,
+                          .msg_flags = 0};
+    msgs[nmsg].msg_len = 0;
+  }
+
+  int rc = socket.SendMmsg(msgs, nmsg);
+  int saved_errno = errno;
+  std::size_t sent = rc > 0 ? static_cast<std::size_t>(rc) : 0;
+
+  for (std::size_t i = 0; i != sent; ++i) {
+    conn_handler->MessageWriteDone(std::get<1>(batch[i]));
+  }
+
+  // `sendmmsg` fails only if the first packet fails, the error of a later one is returned by the next call.
+  // Unless the socket buffer is full, the packet will never be sent, so drop it rather than blocking the ones behind.
+  if (rc < 0 && saved_errno != EAGAIN && saved_errno != EWOULDBLOCK && !batch.empty()) {
+    auto&& [to, io_msg] = batch[0];
+    TRPC_FMT_ERROR("send datagram to {} failed, errno:{}, dropped", to.ToString(), saved_errno);
+    conn_handler->NotifyMessageFailed(io_msg, ConnectionErrorCode::kNetworkException);
+    sent = 1;
+  }
+
+  // The dropped packet counts as consumed, so that the caller goes on with the packets behind it rather than failing.
+  if (rc < 0 && sent == 1) {
+    rc = 1;
+  }
+
+  // Put the packets which have not been sent back to the head of the list, keeping their order.
+  if (sent != batch.size()) {
+    lk.lock();
+    for (std::size_t i = batch.size(); i != sent; --i) {
+      list_.emplace_front(std::move(batch[i - 1]));
+    }
+    lk.unlock();
+  }
+  batch.clear();
+
+  errno = saved_errno;
+  return rc;
+}
+
+std::size_t WritingDatagramList::Size() const {
+  std::scoped_lock lk(lock_);
+  return list_.size();
+}
+
 bool WritingDatagramList::Append(NetworkAddress to, IoMessage&& io_msg) {
   std::scoped_lock lk(lock_);
   list_.emplace_back(std::tuple(std::move(to), std::move(io_msg)));
@@ -31,9 +31,27 @@ class WritingDatagramList {
   /// @return ssize_t the size of the data that has been sent
   ssize_t FlushTo(Socket& socket, ConnectionHandler* conn_handler, bool* emptied);
 
+  /// @brief Send multiple udp packets from the head of the list by one `sendmmsg` call
+  /// @param socket the socket to send data
+  /// @param conn_handler connection handler
+  /// @param max_batch the maximum number of udp packets to send
+  /// @param emptied whether the data has all been sent
+  /// @return ssize_t the number of udp packets that have been sent or dropped, -1 if the socket buffer is full(errno is
+  ///         set to `EAGAIN`)
+  /// @note The udp packets that have not been sent are put back to the head of the list in order. On an error other
+  ///       than `EAGAIN`, the first packet(the one failed) is dropped and passed to
+  ///       `ConnectionHandler::NotifyMessageFailed`, so that it does not block the packets behind it.
+  ssize_t FlushBatchTo(Socket& socket, ConnectionHandler* conn_handler, std::size_t max_batch, bool* emptied);
+
   /// @brief Append the udp packet to be sent to the tail of the list
   bool Append(NetworkAddress to, IoMessage&& io_msg);
 
+  /// @brief Get the number of udp packets waiting to be sent
+  std::size_t Size() const;
+
+  /// @brief The maximum number of udp packets sent by one `FlushBatchTo` call
+  static constexpr std::size_t kMaxBatchSize = 64;
+
  private:
   mutable std::mutex lock_;
   std::deque<std::tuple<NetworkAddress, IoMessage>> list_;
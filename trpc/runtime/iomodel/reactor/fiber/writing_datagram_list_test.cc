@@ -16,6 +16,7 @@
 #include <climits>
 #include <random>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -37,6 +38,10 @@ class MockConnHanlder : public ConnectionHandler {
   int CheckMessage(const ConnectionPtr&, NoncontiguousBuffer&, std::deque<std::any>&) override { return 0; }
 
   bool HandleMessage(const ConnectionPtr&, std::deque<std::any>&) override { return true; }
+
+  void NotifyMessageFailed(const IoMessage& msg, ConnectionErrorCode) override { failed_seq_ids.push_back(msg.seq_id); }
+
+  std::vector<uint32_t> failed_seq_ids;
 };
 
 TEST(WritingDatagramList, Normal) {
@@ -94,4 +99,88 @@ TEST(WritingDatagramList, Normal) {
   ASSERT_TRUE(emptied);
 }
 
+TEST(WritingDatagramList, FlushBatch) {
+  uint16_t recv_port = trpc::util::GenRandomAvailablePort();
+  Socket recv_socket = Socket::CreateUdpSocket(false);
+  Socket send_socket = Socket::CreateUdpSocket(false);
+  NetworkAddress recv_addr("127.0.0.1", recv_port, NetworkAddress::IpType::kIpV4);
+  recv_socket.Bind(recv_addr);
+
+  WritingDatagramList wdl;
+  for (size_t i = 1; i <= 3; ++i) {
+    IoMessage io_msg;
+    io_msg.buffer = CreateBufferSlow(std::string(i * 100, 'x').data());
+    io_msg.seq_id = i;
+    ASSERT_TRUE(wdl.Append(recv_addr, std::move(io_msg)));
+  }
+  ASSERT_EQ(3, wdl.Size());
+
+  bool emptied;
+  MockConnHanlder mock_handler;
+  ssize_t send_count = wdl.FlushBatchTo(send_socket, &mock_handler, 2, &emptied);
+  ASSERT_EQ(2, send_count);
+  ASSERT_FALSE(emptied);
+  ASSERT_EQ(1, wdl.Size());
+
+  send_count = wdl.FlushBatchTo(send_socket, &mock_handler, 2, &emptied);
+  ASSERT_EQ(1, send_count);
+  ASSERT_EQ(0, wdl.Size());
+
+  // datagrams keep their boundaries and order
+  constexpr uint32_t kUdpBuffSize = 64 * 1024;
+  char recv_buffer[kUdpBuffSize];
+  NetworkAddress peer_addr;
+  for (size_t i = 1; i <= 3; ++i) {
+    int recv_size = recv_socket.RecvFrom(recv_buffer, kUdpBuffSize, 0, &peer_addr);
+    ASSERT_EQ(i * 100, recv_size);
+  }
+
+  // the list is empty now
+  send_count = wdl.FlushBatchTo(send_socket, &mock_handler, 2, &emptied);
+  ASSERT_EQ(0, send_count);
+  ASSERT_TRUE(emptied);
+}
+
+TEST(WritingDatagramList, FlushBatchDropsFailedDatagram) {
+  uint16_t recv_port = trpc::util::GenRandomAvailablePort();
+  Socket recv_socket = Socket::CreateUdpSocket(false);
+  Socket send_socket = Socket::CreateUdpSocket(false);
+  NetworkAddress recv_addr("127.0.0.1", recv_port, NetworkAddress::IpType::kIpV4);
+  recv_socket.Bind(recv_addr);
+
+  WritingDatagramList wdl;
+  // Larger than the max udp payload, it can never be sent.
+  IoMessage oversized_io_msg;
+  oversized_io_msg.buffer = CreateBufferSlow(std::string(70000, 'x').data());
+  oversized_io_msg.seq_id = 1;
+  ASSERT_TRUE(wdl.Append(recv_addr, std::move(oversized_io_msg)));
+  for (uint32_t i = 2; i <= 3; ++i) {
+    IoMessage io_msg;
+    io_msg.buffer = CreateBufferSlow(std::string(i * 100, 'x').data());
+    io_msg.seq_id = i;
+    ASSERT_TRUE(wdl.Append(recv_addr, std::move(io_msg)));
+  }
+
+  bool emptied;
+  MockConnHanlder mock_handler;
+  ssize_t send_count = wdl.FlushBatchTo(send_socket, &mock_handler, 8, &emptied);
+  // The dropped datagram is counted, the caller is not failed for it.
+  ASSERT_EQ(1, send_count);
+  ASSERT_EQ(std::vector<uint32_t>{1}, mock_handler.failed_seq_ids);
+  // The datagrams behind the failed one are kept.
+  ASSERT_EQ(2, wdl.Size());
+
+  send_count = wdl.FlushBatchTo(send_socket, &mock_handler, 8, &emptied);
+  ASSERT_EQ(2, send_count);
+  ASSERT_EQ(0, wdl.Size());
+
+  constexpr uint32_t kUdpBuffSize = 64 * 1024;
+  char recv_buffer[kUdpBuffSize];
+  NetworkAddress peer_addr;
+  for (size_t i = 2; i <= 3; ++i) {
+    int recv_size = recv_socket.RecvFrom(recv_buffer, kUdpBuffSize, 0, &peer_addr);
+    ASSERT_EQ(i * 100, recv_size);
+  }
+}
+
 }  // namespace trpc::testing
@@ -47,6 +47,9 @@ std::shared_ptr<ThreadModel> CreateMergeThreadModel(const DefaultThreadModelInst
   options.enable_async_io = config.enable_async_io;
   options.io_uring_entries = config.io_uring_entries;
   options.io_uring_flags = config.io_uring_flags;
+  options.queue_policy.name = config.queue_policy.name;
+  options.queue_policy.codel_target_delay_ms = config.queue_policy.codel_target_delay_ms;
+  options.queue_policy.codel_interval_ms = config.queue_policy.codel_interval_ms;
   options.cpu_affinitys.clear();
 
   if (!config.io_cpu_affinitys.empty()) {
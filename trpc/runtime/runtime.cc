@@ -17,6 +17,8 @@
 #include "trpc/coroutine/fiber.h"
 #include "trpc/runtime/common/periphery_task_scheduler.h"
 #include "trpc/runtime/fiber_runtime.h"
+#include "trpc/runtime/iomodel/reactor/common/egress_shaper.h"
+#include "trpc/runtime/iomodel/reactor/common/write_buffer_budget.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
 #include "trpc/runtime/merge_runtime.h"
 #include "trpc/runtime/separate_runtime.h"
@@ -84,6 +86,10 @@ bool StartRuntime() {
   memory_pool::SetMemBlockSize(buffer_pool_config.block_size);
   memory_pool::SetMemPoolThreshold(buffer_pool_config.mem_pool_threshold);
 
+  // Must be set before any connection is created.
+  WriteBufferBudget::Global()->SetLimit(global_config.write_buffer_budget);
+  TokenBucket::Global()->Reset(global_config.egress_rate_limit);
+
   internal::TimeKeeper::Instance()->Start();
 
   if (IsInFiberRuntime()) {
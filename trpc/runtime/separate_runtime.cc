@@ -40,6 +40,15 @@ static std::vector<ThreadModel*> business_threadmodels;
 
 namespace {
 
+QueuePolicyOptions CreateQueuePolicyOptions(const ThreadModelQueuePolicyConfig& config) {
+  QueuePolicyOptions options;
+  options.name = config.name;
+  options.codel_target_delay_ms = config.codel_target_delay_ms;
+  options.codel_interval_ms = config.codel_interval_ms;
+
+  return options;
+}
+
 NonStealScheduling::Options CreateNonStealSchedulingOptions(const DefaultThreadModelInstanceConfig& config) {
   TRPC_ASSERT(!config.instance_name.empty());
 
@@ -50,6 +59,7 @@ NonStealScheduling::Options CreateNonStealSchedulingOptions(const DefaultThreadM
   options.worker_thread_num = handle_thread_num;
   options.local_queue_size = config.scheduling.local_queue_size;
   options.global_queue_size = config.handle_thread_task_queue_size;
+  options.queue_policy = CreateQueuePolicyOptions(config.queue_policy);
 
   return options;
 }
@@ -63,6 +73,7 @@ StealScheduling::Options CreateStealSchedulingOptions(const DefaultThreadModelIn
   options.group_name = config.instance_name;
   options.worker_thread_num = handle_thread_num;
   options.global_queue_size = config.handle_thread_task_queue_size;
+  options.queue_policy = CreateQueuePolicyOptions(config.queue_policy);
 
   return options;
 }
@@ -114,6 +125,7 @@ std::shared_ptr<ThreadModel> CreateSeparateThreadModel(const DefaultThreadModelI
   options.enable_async_io = config.enable_async_io;
   options.io_uring_entries = config.io_uring_entries;
   options.io_uring_flags = config.io_uring_flags;
+  options.handoff_batch_size = config.scheduling.handoff_batch_size;
   options.handle_cpu_affinitys.clear();
   options.io_cpu_affinitys.clear();
 
@@ -43,6 +43,23 @@ struct MsgTask {
 
   /// task processing method
   MsgTaskHandler handler;
+
+  /// Called ahead of `handler` when the task is shed by the queue policy(eg: codel) of the thread model or by the
+  /// deadline-aware dispatch of the fiber thread model, it marks the task as failed so that `handler` fails fast.
+  /// Tasks without it are never shed by the queue policy.
+  MsgTaskHandler overload_handler;
+
+  /// steady time(us) when the task is submitted to the queue, only recorded when the queue policy needs it
+  uint64_t enqueue_timestamp_us = 0;
+
+  /// absolute deadline(us, same clock as `trpc::time::GetMicroSeconds`) of the task, 0 means no deadline.
+  /// Only used by the deadline-aware dispatch of the fiber thread model.
+  uint64_t deadline_us = 0;
+
+  /// flow(eg: service) the task belongs to and the weight of the flow, the flows share the handler fibers in
+  /// proportion to their weights. Only used by the fair queuing of the fiber thread model.
+  uint32_t flow_id = 0;
+  uint32_t flow_weight = 1;
 };
 
 namespace object_pool {
@@ -0,0 +1,55 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/threadmodel/common/queue_policy.h"
+
+#include "trpc/util/object_pool/object_pool.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+bool CoDelController::OnDequeue(uint64_t delay_us, uint64_t now_us) {
+  if (interval_end_us_ == 0) {
+    interval_end_us_ = now_us + interval_us_;
+  }
+
+  if (delay_us < min_delay_us_) {
+    min_delay_us_ = delay_us;
+  }
+
+  if (now_us >= interval_end_us_) {
+    overloaded_ = min_delay_us_ > target_delay_us_;
+    min_delay_us_ = std::numeric_limits<uint64_t>::max();
+    interval_end_us_ = now_us + interval_us_;
+  }
+
+  return overloaded_ && delay_us > 2 * target_delay_us_;
+}
+
+void MarkMsgTaskEnqueued(MsgTask* task) { task->enqueue_timestamp_us = trpc::GetSteadyMicroSeconds(); }
+
+void RunMsgTask(MsgTask* task, CoDelController* codel) {
+  if (codel != nullptr && task->enqueue_timestamp_us > 0) {
+    uint64_t now_us = trpc::GetSteadyMicroSeconds();
+    uint64_t delay_us = now_us > task->enqueue_timestamp_us ? now_us - task->enqueue_timestamp_us : 0;
+    if (codel->OnDequeue(delay_us, now_us) && task->overload_handler) {
+      task->overload_handler();
+    }
+  }
+
+  task->handler();
+
+  trpc::object_pool::Delete<MsgTask>(task);
+}
+
+}  // namespace trpc
@@ -0,0 +1,75 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "trpc/runtime/threadmodel/common/msg_task.h"
+
+namespace trpc {
+
+/// @brief Tasks are executed in the order they are submitted.
+constexpr std::string_view kFifoQueuePolicy = "fifo";
+
+/// @brief Tasks that stay in the queue for too long are shed once the queue is standing(CoDel), and the newest tasks
+///        are served first while it's standing(adaptive LIFO).
+constexpr std::string_view kCoDelQueuePolicy = "codel";
+
+/// @brief Queue management policy of the handle task queues in separate/merge thread model.
+struct QueuePolicyOptions {
+  /// @brief name of the policy, `kFifoQueuePolicy` or `kCoDelQueuePolicy`
+  std::string name{kFifoQueuePolicy};
+
+  /// @brief the acceptable minimum queuing delay(ms) of the tasks, only used by codel
+  uint32_t codel_target_delay_ms{5};
+
+  /// @brief the window(ms) over which the minimum queuing delay is measured, only used by codel
+  uint32_t codel_interval_ms{100};
+};
+
+/// @brief Controlled-delay(CoDel) state of a task queue, following the variant used together with adaptive LIFO:
+///        the queue is overloaded when the minimum queuing delay over the last interval exceeds the target, in which
+///        case tasks that have been queued longer than twice the target are shed.
+/// @note  Not thread-safe, each worker thread owns the controller of the queue it consumes.
+class CoDelController {
+ public:
+  CoDelController(uint64_t target_delay_us, uint64_t interval_us)
+      : target_delay_us_(target_delay_us), interval_us_(interval_us) {}
+
+  /// @brief Update the state with a task dequeued at `now_us` after waiting `delay_us` in the queue.
+  /// @return true if the task should be shed.
+  bool OnDequeue(uint64_t delay_us, uint64_t now_us);
+
+  /// @brief Whether the queue was standing during the last interval.
+  bool IsOverloaded() const { return overloaded_; }
+
+ private:
+  uint64_t target_delay_us_;
+  uint64_t interval_us_;
+  uint64_t interval_end_us_{0};
+  uint64_t min_delay_us_{std::numeric_limits<uint64_t>::max()};
+  bool overloaded_{false};
+};
+
+/// @brief Record the enqueue time of the task, which is used by `RunMsgTask` to measure its queuing delay.
+void MarkMsgTaskEnqueued(MsgTask* task);
+
+/// @brief Execute the task and delete it. If `codel` is not null and decides to shed the task, the
+///        `overload_handler` of the task is called ahead of its `handler`, so that the task fails fast.
+void RunMsgTask(MsgTask* task, CoDelController* codel);
+
+}  // namespace trpc
@@ -0,0 +1,94 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/threadmodel/common/queue_policy.h"
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/object_pool/object_pool.h"
+#include "trpc/util/time.h"
+
+namespace trpc::testing {
+
+TEST(CoDelControllerTest, NotOverloadedWhenQueueDrains) {
+  CoDelController codel(5000, 100000);
+
+  // Some tasks wait for long, but the queue drains at least once per interval.
+  uint64_t now = 1000000;
+  for (int i = 0; i < 1000; ++i, now += 1000) {
+    ASSERT_FALSE(codel.OnDequeue(i % 10 == 0 ? 0 : 50000, now));
+  }
+  ASSERT_FALSE(codel.IsOverloaded());
+}
+
+TEST(CoDelControllerTest, ShedWhenQueueIsStanding) {
+  CoDelController codel(5000, 100000);
+
+  uint64_t now = 1000000;
+  // First interval: the minimum delay exceeds the target.
+  for (int i = 0; i <= 100; ++i, now += 1000) {
+    codel.OnDequeue(8000, now);
+  }
+  ASSERT_TRUE(codel.IsOverloaded());
+
+  // Only tasks waiting longer than twice the target are shed.
+  ASSERT_FALSE(codel.OnDequeue(8000, now));
+  ASSERT_TRUE(codel.OnDequeue(20000, now));
+
+  // The queue drains in the next interval, so it recovers.
+  for (int i = 0; i <= 100; ++i, now += 1000) {
+    codel.OnDequeue(100, now);
+  }
+  ASSERT_FALSE(codel.IsOverloaded());
+  ASSERT_FALSE(codel.OnDequeue(20000, now));
+}
+
+TEST(RunMsgTaskTest, Run) {
+  int executed = 0, overloaded = 0;
+  auto* task = object_pool::New<MsgTask>();
+  task->handler = [&] { ++executed; };
+  task->overload_handler = [&] { ++overloaded; };
+  MarkMsgTaskEnqueued(task);
+
+  RunMsgTask(task, nullptr);
+  ASSERT_EQ(1, executed);
+  ASSERT_EQ(0, overloaded);
+}
+
+TEST(RunMsgTaskTest, Shed) {
+  CoDelController codel(1, 10);
+  uint64_t now = trpc::GetSteadyMicroSeconds();
+  codel.OnDequeue(100000, now);
+  codel.OnDequeue(100000, now + 10);
+  ASSERT_TRUE(codel.IsOverloaded());
+
+  std::string trace;
+  auto* task = object_pool::New<MsgTask>();
+  task->handler = [&] { trace += "handle"; };
+  task->overload_handler = [&] { trace += "overload,"; };
+  task->enqueue_timestamp_us = now - 100000;
+
+  RunMsgTask(task, &codel);
+  ASSERT_EQ("overload,handle", trace);
+
+  // Tasks without `overload_handler` are never shed.
+  trace.clear();
+  task = object_pool::New<MsgTask>();
+  task->handler = [&] { trace += "handle"; };
+  task->enqueue_timestamp_us = now - 100000;
+
+  RunMsgTask(task, &codel);
+  ASSERT_EQ("handle", trace);
+}
+
+}  // namespace trpc::testing
@@ -16,6 +16,7 @@
 
 #include <pthread.h>
 
+#include <algorithm>
 #include <limits>
 #include <utility>
 
@@ -23,6 +24,8 @@
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling_group.h"
 #include "trpc/runtime/threadmodel/fiber/detail/stack_allocator_impl.h"
 #include "trpc/runtime/threadmodel/fiber/detail/waitable.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
+#include "trpc/util/chrono/tsc.h"
 #include "trpc/util/deferred.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/string_helper.h"
@@ -173,6 +176,33 @@ void FiberEntity::ResumeOn(Function<void()>&& cb) noexcept {
   Resume();
 }
 
+void OnAccountedFiberSwitchOut(FiberEntity* fiber) noexcept {
+  auto now = ReadTsc();
+  auto&& usage = fiber->resource_usage;
+
+  usage.running_tsc += now > fiber->run_begin_tsc ? now - fiber->run_begin_tsc : 0;
+  usage.allocated_bytes += memory_pool::GetTlsAllocatedBytes() - fiber->run_begin_allocated_bytes;
+  ++usage.switches;
+  fiber->switch_out_tsc = now;
+}
+
+void OnAccountedFiberSwitchIn(FiberEntity* fiber) noexcept {
+  auto now = ReadTsc();
+  auto&& usage = fiber->resource_usage;
+
+  // The fiber may be made ready again before it has been switched out (e.g.
+  // woken up by another worker at once), in which case it has never been
+  // blocked. TSC may also be slightly inconsistent between the workers.
+  auto ready_tsc = std::clamp(fiber->last_ready_tsc, fiber->switch_out_tsc, std::max(now, fiber->switch_out_tsc));
+  usage.blocked_wait_tsc += ready_tsc - fiber->switch_out_tsc;
+  usage.runnable_wait_tsc += now > ready_tsc ? now - ready_tsc : 0;
+
+  // We may be resumed on another worker, whose allocation counter is unrelated
+  // to the one we were switched out from.
+  fiber->run_begin_tsc = now;
+  fiber->run_begin_allocated_bytes = memory_pool::GetTlsAllocatedBytes();
+}
+
 ErasedPtr* FiberEntity::GetFlsSlow(std::size_t index) noexcept {
   TRPC_FMT_WARN_ONCE("Excessive FLS usage. Performance will likely degrade.");
   if (TRPC_UNLIKELY(!external_fls)) {
@@ -268,6 +298,12 @@ FiberEntity* InstantiateFiberEntity(SchedulingGroup* sg, FiberDesc* desc) noexce
   fiber->last_ready_tsc = desc->last_ready_tsc;
   fiber->scheduling_group_local = desc->scheduling_group_local;
   fiber->is_fiber_reactor = desc->is_fiber_reactor;
+  if (TRPC_UNLIKELY(IsFiberStackRegistryEnabled())) {
+    // Published after `start_proc` is set, so that the entry of the fiber is known.
+    auto stack_low = reinterpret_cast<char*>(fiber->GetStackTop()) - fiber->GetStackLimit();
+    fiber->stack_registry_slot = RegisterFiberStack(fiber->debugging_fiber_id, stack_low, fiber->GetStackTop(),
+                                                    fiber->start_proc.GetInvokerAddress());
+  }
 
 #ifdef TRPC_INTERNAL_USE_ASAN
   fiber->asan_stack_bottom = stack;
@@ -286,6 +322,9 @@ void FreeFiberEntity(FiberEntity* fiber) noexcept {
   uint32_t fiber_stack_size = fiber->stack_size;
 
   fiber_count.fetch_sub(1, std::memory_order_relaxed);
+  if (TRPC_UNLIKELY(fiber->stack_registry_slot != kInvalidFiberStackSlot)) {
+    UnregisterFiberStack(fiber->stack_registry_slot);
+  }
   fiber->ever_started_magic = 0;  // Hopefully the compiler does not optimize
                                   // this away.
 
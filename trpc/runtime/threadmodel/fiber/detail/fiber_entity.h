@@ -19,12 +19,14 @@
 
 #include "trpc/runtime/threadmodel/fiber/detail/assembly.h"
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_desc.h"
+#include "trpc/runtime/threadmodel/fiber/detail/fiber_stack_registry.h"
 #include "trpc/runtime/threadmodel/fiber/detail/runnable_entity.h"
 #include "trpc/util/align.h"
 #include "trpc/util/check.h"
 #include "trpc/util/doubly_linked_list.h"
 #include "trpc/util/erased_ptr.h"
 #include "trpc/util/function.h"
+#include "trpc/util/likely.h"
 #include "trpc/util/object_pool/object_pool_ptr.h"
 #include "trpc/util/thread/spinlock.h"
 
@@ -35,6 +37,25 @@ class SchedulingGroup;
 
 enum class FiberState { Ready, Running, Waiting, Yield, Dead };
 
+// Resources used by a fiber while it's accounted, in TSC ticks and bytes of the
+// framework memory pool.
+struct FiberResourceUsage {
+  // Time spent running on a worker.
+  std::uint64_t running_tsc = 0;
+
+  // Time spent in run queue, i.e. ready but waiting for a worker.
+  std::uint64_t runnable_wait_tsc = 0;
+
+  // Time spent waiting for something else (mutex, I/O, timer, ...).
+  std::uint64_t blocked_wait_tsc = 0;
+
+  // Bytes of the memory blocks allocated while running.
+  std::uint64_t allocated_bytes = 0;
+
+  // Times of being switched out.
+  std::uint64_t switches = 0;
+};
+
 const std::size_t kPageSize = getpagesize();
 constexpr auto kFiberMagicSize = 64;
 constexpr std::uint64_t kFiberEverStartedMagic = 0x11223344ABABBBAA;
@@ -152,6 +173,20 @@ struct alignas(hardware_destructive_interference_size) FiberEntity
   // is reactor fiber
   bool is_fiber_reactor = false;
 
+  // Nesting depth of the resource accounting (@sa: `ResourceUsageRecorder`).
+  // The fields below are only maintained while it's non-zero, so the fibers
+  // not being accounted pay only a branch on each switch.
+  std::uint32_t resource_accounting = 0;
+
+  // TSC and allocated bytes of the running thread when the fiber was switched
+  // in last time, and TSC when it was switched out last time.
+  std::uint64_t run_begin_tsc = 0;
+  std::uint64_t run_begin_allocated_bytes = 0;
+  std::uint64_t switch_out_tsc = 0;
+
+  // Accumulated since the accounting started, excluding the current run.
+  FiberResourceUsage resource_usage;
+
   // Set if there is a pending `ResumeOn`. Cleared once `ResumeOn` completes.
   Function<void()> resume_proc = nullptr;
 
@@ -179,6 +214,10 @@ struct alignas(hardware_destructive_interference_size) FiberEntity
   // Entry point of this fiber. Cleared on first time the fiber is run.
   Function<void()> start_proc = nullptr;
 
+  // Slot of this fiber in the fiber stack registry, used by `fiber_perf.py` to
+  // attribute perf samples to fibers (@sa: `fiber_stack_registry.h`).
+  std::uint32_t stack_registry_slot = kInvalidFiberStackSlot;
+
 #ifdef TRPC_INTERNAL_USE_ASAN
   // Lowest address of this fiber's stack.
   const void* asan_stack_bottom = nullptr;
@@ -333,6 +372,11 @@ uint32_t GetFiberCount();
 // Defined in `./fiber/detail/fcontext/{arch}/*.S`
 extern "C" void jump_context(void** self, void* to, void* context);
 
+// Maintains `FiberEntity::resource_usage` of a fiber being accounted when it's
+// switched out / in. Kept out of line so that `Resume()` stays small.
+void OnAccountedFiberSwitchOut(FiberEntity* fiber) noexcept;
+void OnAccountedFiberSwitchIn(FiberEntity* fiber) noexcept;
+
 template <class F>
 inline void DestructiveRunCallback(F* cb) {
   (*cb)();
@@ -374,6 +418,10 @@ inline void FiberEntity::Resume() noexcept {
   trpc::internal::tsan::SwitchToFiber(tsan_fiber);
 #endif
 
+  if (TRPC_UNLIKELY(caller->resource_accounting)) {
+    OnAccountedFiberSwitchOut(caller);
+  }
+
   // Argument `context` (i.e., `this`) is only used the first time the context
   // is jumped to (in `FiberProc`).
   jump_context(&caller->state_save_area, state_save_area, this);
@@ -388,6 +436,10 @@ inline void FiberEntity::Resume() noexcept {
 
   SetCurrentFiberEntity(caller);  // The caller has back.
 
+  if (TRPC_UNLIKELY(caller->resource_accounting)) {
+    OnAccountedFiberSwitchIn(caller);
+  }
+
   // Check for pending `ResumeOn`.
   DestructiveRunCallbackOpt(&caller->resume_proc);
 }
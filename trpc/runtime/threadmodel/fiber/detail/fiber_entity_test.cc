@@ -10,6 +10,10 @@
 
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_entity.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include "gtest/gtest.h"
 
 namespace trpc::fiber::detail {
@@ -192,4 +196,35 @@ TEST(FiberEntity, List) {
   ASSERT_EQ(&fiber1->chain, fiber1->chain.prev);
 }
 
+TEST(FiberEntity, StackRegistry) {
+  auto fiber = CreateFiberEntity(nullptr, [] {});
+  ASSERT_EQ(kInvalidFiberStackSlot, fiber->stack_registry_slot);
+  FreeFiberEntity(fiber);
+
+  ASSERT_TRUE(EnableFiberStackRegistry("/tmp/trpc_fiber_entity_test"));
+  int fd = open(GetFiberStackRegistryPath().c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  std::size_t size = sizeof(FiberStackRegistryHeader) + sizeof(FiberStackRecord) * kFiberStackRegistryLiveCapacity;
+  auto header = static_cast<const FiberStackRegistryHeader*>(mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0));
+  close(fd);
+  ASSERT_NE(MAP_FAILED, header);
+  auto records = reinterpret_cast<const FiberStackRecord*>(header + 1);
+
+  Function<void()> start_proc = [] {};
+  auto entry = start_proc.GetInvokerAddress();
+  fiber = CreateFiberEntity(nullptr, std::move(start_proc));
+  ASSERT_NE(kInvalidFiberStackSlot, fiber->stack_registry_slot);
+  auto&& record = records[fiber->stack_registry_slot];
+  ASSERT_EQ(fiber->debugging_fiber_id, record.fiber_id);
+  ASSERT_EQ(entry, record.entry);
+  // The runtime stack is placed right below the `FiberEntity`.
+  ASSERT_LT(record.stack_low, reinterpret_cast<std::uintptr_t>(fiber));
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(fiber->GetStackTop()), record.stack_high);
+  FreeFiberEntity(fiber);
+  ASSERT_EQ(0, record.fiber_id);
+
+  munmap(const_cast<FiberStackRegistryHeader*>(header), size);
+  unlink(GetFiberStackRegistryPath().c_str());
+}
+
 }  // namespace trpc::fiber::detail
@@ -0,0 +1,199 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/threadmodel/fiber/detail/fiber_stack_registry.h"
+
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "trpc/util/log/logging.h"
+#include "trpc/util/chrono/time.h"
+
+namespace trpc::fiber::detail {
+
+namespace {
+
+// Each thread caches some free slots, so that registering a fiber rarely takes the lock.
+constexpr std::size_t kMaxTlsFreeSlots = 256;
+constexpr std::size_t kFreeSlotsTransferBatch = 128;
+
+std::mutex enable_mutex;
+std::string registry_path;
+
+FiberStackRegistryHeader* header = nullptr;
+FiberStackRecord* live_records = nullptr;
+FiberStackRecord* history_records = nullptr;
+
+std::atomic<uint32_t> next_unused_slot{0};
+std::mutex free_slots_mutex;
+std::vector<uint32_t> free_slots;
+
+struct TlsFreeSlots {
+  std::vector<uint32_t> slots;
+
+  ~TlsFreeSlots() {
+    std::scoped_lock lock(free_slots_mutex);
+    free_slots.insert(free_slots.end(), slots.begin(), slots.end());
+  }
+};
+
+std::vector<uint32_t>& GetTlsFreeSlots() {
+  thread_local TlsFreeSlots tls_free_slots;
+  return tls_free_slots.slots;
+}
+
+void TransferSlots(std::vector<uint32_t>* from, std::vector<uint32_t>* to) {
+  auto count = std::min(from->size(), kFreeSlotsTransferBatch);
+  to->insert(to->end(), from->end() - count, from->end());
+  from->resize(from->size() - count);
+}
+
+uint32_t AllocateSlot() {
+  auto&& local = GetTlsFreeSlots();
+  if (local.empty()) {
+    {
+      std::scoped_lock lock(free_slots_mutex);
+      TransferSlots(&free_slots, &local);
+    }
+    if (local.empty()) {
+      // Checked first so that the counter does not overflow when the registry is full.
+      if (next_unused_slot.load(std::memory_order_relaxed) >= kFiberStackRegistryLiveCapacity) {
+        return kInvalidFiberStackSlot;
+      }
+      auto slot = next_unused_slot.fetch_add(1, std::memory_order_relaxed);
+      return slot < kFiberStackRegistryLiveCapacity ? slot : kInvalidFiberStackSlot;
+    }
+  }
+  auto slot = local.back();
+  local.pop_back();
+  return slot;
+}
+
+void FreeSlot(uint32_t slot) {
+  auto&& local = GetTlsFreeSlots();
+  local.push_back(slot);
+  if (local.size() > kMaxTlsFreeSlots) {
+    std::scoped_lock lock(free_slots_mutex);
+    TransferSlots(&local, &free_slots);
+  }
+}
+
+void WriteRecord(FiberStackRecord* record, uint64_t fiber_id, uint64_t stack_low, uint64_t stack_high,
+                 uint64_t entry, uint64_t start_ns, uint64_t end_ns) {
+  auto seq = record->sequence.load(std::memory_order_relaxed);
+  record->sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  record->fiber_id = fiber_id;
+  record->stack_low = stack_low;
+  record->stack_high = stack_high;
+  record->entry = entry;
+  record->start_ns = start_ns;
+  record->end_ns = end_ns;
+  record->sequence.store(seq + 2, std::memory_order_release);
+}
+
+uint64_t GetImageBase() {
+  uint64_t base = 0;
+  // The main executable is always the first one iterated.
+  dl_iterate_phdr(
+      [](struct dl_phdr_info* info, size_t, void* data) {
+        *static_cast<uint64_t*>(data) = info->dlpi_addr;
+        return 1;
+      },
+      &base);
+  return base;
+}
+
+}  // namespace
+
+bool EnableFiberStackRegistry(const std::string& path_prefix) {
+  std::scoped_lock lock(enable_mutex);
+  if (IsFiberStackRegistryEnabled()) {
+    return true;
+  }
+
+  std::string path = path_prefix + "." + std::to_string(getpid());
+  std::size_t size = sizeof(FiberStackRegistryHeader) +
+                     sizeof(FiberStackRecord) * (kFiberStackRegistryLiveCapacity + kFiberStackRegistryHistoryCapacity);
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    TRPC_FMT_ERROR("open fiber stack registry {} failed: {}", path, strerror(errno));
+    return false;
+  }
+  void* addr = MAP_FAILED;
+  if (ftruncate(fd, size) == 0) {
+    addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (addr == MAP_FAILED) {
+    TRPC_FMT_ERROR("map fiber stack registry {} failed: {}", path, strerror(errno));
+    return false;
+  }
+
+  header = static_cast<FiberStackRegistryHeader*>(addr);
+  live_records = reinterpret_cast<FiberStackRecord*>(header + 1);
+  history_records = live_records + kFiberStackRegistryLiveCapacity;
+
+  // The file is zero-filled, so that all the records are unused.
+  header->version = kFiberStackRegistryVersion;
+  header->header_size = sizeof(FiberStackRegistryHeader);
+  header->record_size = sizeof(FiberStackRecord);
+  header->live_capacity = kFiberStackRegistryLiveCapacity;
+  header->history_capacity = kFiberStackRegistryHistoryCapacity;
+  header->pid = getpid();
+  header->image_base = GetImageBase();
+  // Written at last, so that the readers never see a partially initialized header.
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(header->magic, "TRPCFSR", sizeof(header->magic));
+
+  registry_path = std::move(path);
+  internal::fiber_stack_registry_enabled.store(true, std::memory_order_release);
+  TRPC_FMT_INFO("fiber stack registry is published to {}", registry_path);
+  return true;
+}
+
+uint32_t RegisterFiberStack(uint64_t fiber_id, const void* stack_low, const void* stack_high,
+                            std::uintptr_t entry) noexcept {
+  if (!internal::fiber_stack_registry_enabled.load(std::memory_order_acquire)) {
+    return kInvalidFiberStackSlot;
+  }
+
+  auto slot = AllocateSlot();
+  if (slot == kInvalidFiberStackSlot) {
+    TRPC_FMT_WARN_EVERY_SECOND("fiber stack registry is full, the stacks of new fibers are not published");
+    return slot;
+  }
+  WriteRecord(&live_records[slot], fiber_id, reinterpret_cast<uintptr_t>(stack_low),
+              reinterpret_cast<uintptr_t>(stack_high), entry, time::GetSteadyNanoSeconds(), 0);
+  return slot;
+}
+
+void UnregisterFiberStack(uint32_t slot) noexcept {
+  auto&& record = live_records[slot];
+  auto index = header->history_next.fetch_add(1, std::memory_order_relaxed) % kFiberStackRegistryHistoryCapacity;
+  WriteRecord(&history_records[index], record.fiber_id, record.stack_low, record.stack_high, record.entry,
+              record.start_ns, time::GetSteadyNanoSeconds());
+  WriteRecord(&record, 0, 0, 0, 0, 0, 0);
+  FreeSlot(slot);
+}
+
+const std::string& GetFiberStackRegistryPath() noexcept { return registry_path; }
+
+}  // namespace trpc::fiber::detail
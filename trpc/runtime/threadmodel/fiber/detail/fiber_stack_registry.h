@@ -0,0 +1,96 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace trpc::fiber::detail {
+
+/// @brief The fiber stack registry publishes the stacks of the live fibers and their entry functions in a memory
+///        mapped file, so that the profilers(eg: perf) and offline tools can attribute the samples taken on fiber
+///        stacks to the fibers. The recently exited fibers are kept in a history ring, so that the samples can be
+///        attributed after the fibers exit. See `trpc/tools/fiber_perf`.
+///
+///        The file consists of a header, `kFiberStackRegistryLiveCapacity` live records and
+///        `kFiberStackRegistryHistoryCapacity` history records. Records are written with a seqlock: `sequence` is odd
+///        while the record is being written, readers should retry or skip the record.
+constexpr uint32_t kFiberStackRegistryVersion = 1;
+constexpr uint32_t kFiberStackRegistryLiveCapacity = 1 << 17;
+constexpr uint32_t kFiberStackRegistryHistoryCapacity = 1 << 16;
+constexpr uint32_t kInvalidFiberStackSlot = 0xffffffff;
+
+struct FiberStackRegistryHeader {
+  // "TRPCFSR"
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint32_t record_size;
+  uint32_t live_capacity;
+  uint32_t history_capacity;
+  uint32_t pid;
+  // Load bias of the main executable, used to symbolize the entries of a PIE binary.
+  uint64_t image_base;
+  // Number of records ever written to the history ring.
+  std::atomic<uint64_t> history_next;
+  char reserved[16];
+};
+
+struct FiberStackRecord {
+  std::atomic<uint64_t> sequence;
+  // 0 if the live record is not used.
+  uint64_t fiber_id;
+  // Usable range of the stack: [stack_low, stack_high).
+  uint64_t stack_low;
+  uint64_t stack_high;
+  // Address of the code invoking the entry function of the fiber.
+  uint64_t entry;
+  // CLOCK_MONOTONIC(ns) when the fiber is created and exits, `end_ns` is 0 while the fiber is alive.
+  uint64_t start_ns;
+  uint64_t end_ns;
+  uint64_t reserved;
+};
+
+static_assert(sizeof(FiberStackRegistryHeader) == 64);
+static_assert(sizeof(FiberStackRecord) == 64);
+
+namespace internal {
+
+inline std::atomic<bool> fiber_stack_registry_enabled{false};
+
+}  // namespace internal
+
+/// @brief Create the registry file `{path_prefix}.{pid}` and start publishing the fiber stacks, the fibers created
+///        before it are not published.
+/// @return true on success or if it is already enabled
+bool EnableFiberStackRegistry(const std::string& path_prefix);
+
+/// @brief Whether the registry is enabled.
+inline bool IsFiberStackRegistryEnabled() noexcept {
+  return internal::fiber_stack_registry_enabled.load(std::memory_order_relaxed);
+}
+
+/// @brief Publish a live fiber stack.
+/// @return the slot of the record, or `kInvalidFiberStackSlot` if the registry is full
+uint32_t RegisterFiberStack(uint64_t fiber_id, const void* stack_low, const void* stack_high,
+                            std::uintptr_t entry) noexcept;
+
+/// @brief Move the record of an exited fiber to the history ring.
+void UnregisterFiberStack(uint32_t slot) noexcept;
+
+/// @brief Get the path of the registry file, empty if the registry is not enabled.
+const std::string& GetFiberStackRegistryPath() noexcept;
+
+}  // namespace trpc::fiber::detail
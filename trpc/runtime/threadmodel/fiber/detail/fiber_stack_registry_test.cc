@@ -0,0 +1,133 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/threadmodel/fiber/detail/fiber_stack_registry.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::fiber::detail::testing {
+
+class FiberStackRegistryTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() { ASSERT_TRUE(EnableFiberStackRegistry("/tmp/trpc_fiber_stack_registry_test")); }
+
+  static void TearDownTestCase() { unlink(GetFiberStackRegistryPath().c_str()); }
+
+  // Maps the registry file like an external tool does.
+  void SetUp() override {
+    int fd = open(GetFiberStackRegistryPath().c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+    struct stat st;
+    ASSERT_EQ(0, fstat(fd, &st));
+    size_ = st.st_size;
+    addr_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(MAP_FAILED, addr_);
+  }
+
+  void TearDown() override { munmap(addr_, size_); }
+
+  const FiberStackRegistryHeader* Header() const { return static_cast<const FiberStackRegistryHeader*>(addr_); }
+
+  const FiberStackRecord* Live() const { return reinterpret_cast<const FiberStackRecord*>(Header() + 1); }
+
+  const FiberStackRecord* History() const { return Live() + Header()->live_capacity; }
+
+  void* addr_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+TEST_F(FiberStackRegistryTest, Header) {
+  ASSERT_TRUE(IsFiberStackRegistryEnabled());
+  ASSERT_EQ("/tmp/trpc_fiber_stack_registry_test." + std::to_string(getpid()), GetFiberStackRegistryPath());
+  // Enabling it again is a no-op.
+  ASSERT_TRUE(EnableFiberStackRegistry("/tmp/another_prefix"));
+  ASSERT_EQ("/tmp/trpc_fiber_stack_registry_test." + std::to_string(getpid()), GetFiberStackRegistryPath());
+
+  auto header = Header();
+  ASSERT_EQ(0, memcmp(header->magic, "TRPCFSR", sizeof(header->magic)));
+  ASSERT_EQ(kFiberStackRegistryVersion, header->version);
+  ASSERT_EQ(sizeof(FiberStackRegistryHeader), header->header_size);
+  ASSERT_EQ(sizeof(FiberStackRecord), header->record_size);
+  ASSERT_EQ(kFiberStackRegistryLiveCapacity, header->live_capacity);
+  ASSERT_EQ(kFiberStackRegistryHistoryCapacity, header->history_capacity);
+  ASSERT_EQ(static_cast<uint32_t>(getpid()), header->pid);
+  ASSERT_EQ(sizeof(FiberStackRegistryHeader) +
+                sizeof(FiberStackRecord) * (header->live_capacity + header->history_capacity),
+            size_);
+}
+
+TEST_F(FiberStackRegistryTest, RegisterAndUnregister) {
+  char stack[256];
+  auto history_next = Header()->history_next.load();
+
+  auto slot = RegisterFiberStack(12345, stack, stack + sizeof(stack), 0x1000);
+  ASSERT_NE(kInvalidFiberStackSlot, slot);
+
+  auto&& live = Live()[slot];
+  ASSERT_EQ(0, live.sequence.load() % 2);
+  ASSERT_EQ(12345, live.fiber_id);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(stack), live.stack_low);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(stack + sizeof(stack)), live.stack_high);
+  ASSERT_EQ(0x1000, live.entry);
+  ASSERT_NE(0, live.start_ns);
+  ASSERT_EQ(0, live.end_ns);
+
+  UnregisterFiberStack(slot);
+  ASSERT_EQ(0, live.fiber_id);
+
+  ASSERT_EQ(history_next + 1, Header()->history_next.load());
+  auto&& history = History()[history_next % Header()->history_capacity];
+  ASSERT_EQ(12345, history.fiber_id);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(stack), history.stack_low);
+  ASSERT_EQ(0x1000, history.entry);
+  ASSERT_LE(history.start_ns, history.end_ns);
+
+  // The slot freed is reused.
+  ASSERT_EQ(slot, RegisterFiberStack(12346, stack, stack + sizeof(stack), 0x1000));
+  UnregisterFiberStack(slot);
+}
+
+TEST_F(FiberStackRegistryTest, MultiThreads) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 4; ++i) {
+    threads.emplace_back([i] {
+      std::vector<uint32_t> slots;
+      for (int j = 0; j != 1000; ++j) {
+        slots.push_back(RegisterFiberStack(i * 1000 + j + 1, nullptr, nullptr, 0));
+        ASSERT_NE(kInvalidFiberStackSlot, slots.back());
+      }
+      for (auto slot : slots) {
+        UnregisterFiberStack(slot);
+      }
+    });
+  }
+  for (auto&& t : threads) {
+    t.join();
+  }
+
+  for (uint32_t i = 0; i != Header()->live_capacity; ++i) {
+    ASSERT_EQ(0, Live()[i].fiber_id);
+  }
+}
+
+}  // namespace trpc::fiber::detail::testing
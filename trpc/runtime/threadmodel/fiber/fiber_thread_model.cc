@@ -15,6 +15,7 @@
 
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_entity.h"
+#include "trpc/runtime/threadmodel/fiber/detail/fiber_stack_registry.h"
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_worker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling_group.h"
@@ -77,6 +78,20 @@ std::string StringifyCPUs(const std::vector<unsigned>& cpus) {
   return result;
 }
 
+bool StartHandleFiber(detail::SchedulingGroup* sg, MsgTaskHandler&& handler) {
+  auto desc = fiber::detail::NewFiberDesc();
+  if (TRPC_UNLIKELY(desc == nullptr)) {
+    TRPC_FMT_ERROR("Create fiber desc failed");
+    return false;
+  }
+
+  desc->start_proc = std::move(handler);
+  TRPC_CHECK(!desc->exit_barrier);
+  desc->scheduling_group_local = false;
+
+  return sg->StartFiber(desc);
+}
+
 }  // namespace
 
 FiberThreadModel::FiberThreadModel(Options&& options) : options_(std::move(options)) {}
@@ -87,6 +102,9 @@ void FiberThreadModel::Start() noexcept {
   fiber::detail::SetFiberPoolNumByMmap(options_.pool_num_by_mmap);
   fiber::detail::SetFiberStackEnableGuardPage(options_.stack_enable_guard_page);
   fiber::detail::SetEnableGdbDebug(options_.enable_gdb_debug);
+  if (!options_.stack_registry_path.empty()) {
+    fiber::detail::EnableFiberStackRegistry(options_.stack_registry_path);
+  }
 
   InitializeConcurrency();
   InitializeNumaAwareness();
@@ -193,7 +211,6 @@ detail::SchedulingGroup* FiberThreadModel::GetSchedulingGroup(std::size_t index)
 
 bool FiberThreadModel::SubmitHandleTask(MsgTask* handle_task) noexcept {
   TRPC_ASSERT(handle_task);
-  ScopedDeferred _([&] { object_pool::Delete<MsgTask>(handle_task); });
 
   detail::SchedulingGroup* sg = NearestSchedulingGroup();
   if (handle_task->dst_thread_key >= 0) {
@@ -201,17 +218,36 @@ bool FiberThreadModel::SubmitHandleTask(MsgTask* handle_task) noexcept {
     sg = GetSchedulingGroup(id);
   }
 
-  auto desc = fiber::detail::NewFiberDesc();
-  if (TRPC_UNLIKELY(desc == nullptr)) {
-    TRPC_FMT_ERROR("Create fiber desc failed");
-    return false;
+  if (options_.deadline_aware_dispatch || options_.fair_queuing) {
+    return GetHandleTaskDispatcher(sg)->Submit(handle_task);
   }
 
-  desc->start_proc = std::move(handle_task->handler);
-  TRPC_CHECK(!desc->exit_barrier);
-  desc->scheduling_group_local = false;
+  ScopedDeferred _([&] { object_pool::Delete<MsgTask>(handle_task); });
+  return StartHandleFiber(sg, std::move(handle_task->handler));
+}
 
-  return sg->StartFiber(desc);
+HandleTaskDispatcher* FiberThreadModel::GetHandleTaskDispatcher(detail::SchedulingGroup* sg) {
+  // There are only a few scheduling groups.
+  for (auto* e : flatten_scheduling_groups_) {
+    if (e->scheduling_group.get() == sg) {
+      return e->handle_task_dispatcher.get();
+    }
+  }
+  TRPC_CHECK(false, "Unknown scheduling group.");
+  return nullptr;
+}
+
+HandleTaskDispatcher::Stats FiberThreadModel::GetHandleTaskDispatchStats() {
+  HandleTaskDispatcher::Stats sum;
+  for (auto* e : flatten_scheduling_groups_) {
+    if (e->handle_task_dispatcher) {
+      auto stats = e->handle_task_dispatcher->GetStats();
+      sum.dispatched += stats.dispatched;
+      sum.queued += stats.queued;
+      sum.shed += stats.shed;
+    }
+  }
+  return sum;
 }
 
 std::size_t FiberThreadModel::GetFiberQueueSize() {
@@ -256,6 +292,18 @@ std::unique_ptr<FiberThreadModel::FullyFledgedSchedulingGroup> FiberThreadModel:
   }
   rc->timer_worker = std::make_unique<detail::TimerWorker>(rc->scheduling_group.get(), options_.disable_process_name);
   rc->scheduling_group->SetTimerWorker(rc->timer_worker.get());
+
+  if (options_.deadline_aware_dispatch || options_.fair_queuing) {
+    HandleTaskDispatcher::Options dispatcher_options;
+    dispatcher_options.deadline_aware = options_.deadline_aware_dispatch;
+    dispatcher_options.fair_queuing = options_.fair_queuing;
+    dispatcher_options.max_running =
+        options_.max_running_handlers > 0 ? options_.max_running_handlers : 256 * scheduling_group_size;
+    rc->handle_task_dispatcher = std::make_unique<HandleTaskDispatcher>(
+        dispatcher_options, [sg = rc->scheduling_group.get()](MsgTaskHandler&& handler) {
+          return StartHandleFiber(sg, std::move(handler));
+        });
+  }
   return rc;
 }
 
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "trpc/runtime/threadmodel/common/msg_task.h"
+#include "trpc/runtime/threadmodel/fiber/handle_task_dispatcher.h"
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_worker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling_group.h"
 #include "trpc/runtime/threadmodel/fiber/detail/timer_worker.h"
@@ -85,6 +86,28 @@ class FiberThreadModel final : public ThreadModel {
 
     /// Enable debug fiber using gdb
     bool enable_gdb_debug{false};
+
+    /// Path prefix of the fiber stack registry, empty means disabled.
+    /// If set, the stack range and entry function of each live fiber are published to the mmap'd file
+    /// `{prefix}.{pid}`, so that `trpc/tools/fiber_perf` can attribute perf samples to fibers.
+    std::string stack_registry_path;
+
+    /// Enable deadline-aware dispatch of the handle tasks or not.
+    /// If true, once `max_running_handlers` handler fibers are running in a scheduling group, the handle tasks
+    /// submitted to it wait in the order of their deadline(earliest first), tasks without deadline wait in a FIFO
+    /// bucket, and the tasks whose deadline has passed are shed when they are taken out.
+    /// If false, a fiber is started for each handle task at once, and it waits in the FIFO fiber run queue.
+    bool deadline_aware_dispatch{false};
+
+    /// Enable fair queuing of the handle tasks between services(flows) or not.
+    /// If true, once `max_running_handlers` handler fibers are running in a scheduling group, the services share the
+    /// handler fibers of it by deficit round robin weighted by `MsgTask::flow_weight`.
+    bool fair_queuing{false};
+
+    /// Max number of handler fibers running at the same time per scheduling group, only used by deadline-aware
+    /// dispatch and fair queuing. If not specified, it will be set to 256 times the number of fiber workers of the
+    /// scheduling group.
+    uint32_t max_running_handlers{0};
   };
 
   // `SchedulingGroup` and its workers (both fiber worker and timer worker).
@@ -93,6 +116,7 @@ class FiberThreadModel final : public ThreadModel {
     std::unique_ptr<detail::SchedulingGroup> scheduling_group;
     std::vector<std::unique_ptr<detail::FiberWorker>> fiber_workers;
     std::unique_ptr<detail::TimerWorker> timer_worker;
+    std::unique_ptr<HandleTaskDispatcher> handle_task_dispatcher;
   };
 
   explicit FiberThreadModel(Options&& options);
@@ -126,6 +150,10 @@ class FiberThreadModel final : public ThreadModel {
   /// @brief traverse all `SchedulingGroup` to get the size of the fibers to be run in the run queue
   std::size_t GetFiberQueueSize();
 
+  /// @brief Get the statistics of deadline-aware dispatch/fair queuing summed over all scheduling groups, all zeros if
+  ///        neither is enabled.
+  HandleTaskDispatcher::Stats GetHandleTaskDispatchStats();
+
   std::vector<FullyFledgedSchedulingGroup*>& GetSchedulingGroups() { return flatten_scheduling_groups_; }
 
   std::vector<std::unique_ptr<FullyFledgedSchedulingGroup>>& GetSchedulingGroups(std::size_t index) {
@@ -149,6 +177,7 @@ class FiberThreadModel final : public ThreadModel {
   const std::vector<unsigned>& GetFiberWorkerAccessibleCPUs();
   std::vector<unsigned> GetFiberWorkerAccessibleCPUsImpl();
   std::size_t FindBestSchedulingGroupSize(std::size_t per_node_workers);
+  HandleTaskDispatcher* GetHandleTaskDispatcher(detail::SchedulingGroup* sg);
 
  private:
   constexpr static size_t kMaxSchedulingGroupSize = 15;
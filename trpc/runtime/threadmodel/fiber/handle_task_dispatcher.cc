@@ -0,0 +1,227 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/threadmodel/fiber/handle_task_dispatcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "trpc/util/check.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/object_pool/object_pool.h"
+#include "trpc/util/time.h"
+
+namespace trpc::fiber {
+
+HandleTaskDispatcher::HandleTaskDispatcher(const Options& options, StartFiberFunction&& start_fiber)
+    : options_(options), start_fiber_(std::move(start_fiber)) {
+  TRPC_ASSERT(options_.max_running > 0);
+  if (options_.fifo_share == 0) {
+    options_.fifo_share = 1;
+  }
+  if (options_.quantum_us == 0) {
+    options_.quantum_us = 1;
+  }
+}
+
+HandleTaskDispatcher::~HandleTaskDispatcher() {
+  // The workers have exited, the remaining tasks can not be handled anymore.
+  for (auto& [id, flow] : flows_) {
+    while (MsgTask* task = PopFromFlowLocked(flow.get())) {
+      object_pool::Delete<MsgTask>(task);
+    }
+  }
+}
+
+bool HandleTaskDispatcher::Submit(MsgTask* task) {
+  Flow* flow = nullptr;
+  {
+    std::scoped_lock _(mutex_);
+    flow = GetFlowLocked(task);
+    if (running_ >= options_.max_running) {
+      if (options_.deadline_aware && task->deadline_us > 0) {
+        flow->deadline_queue.push(Entry{task->deadline_us, seq_++, task});
+      } else {
+        flow->fifo_queue.push_back(task);
+      }
+      ++queue_size_;
+      if (!flow->active) {
+        // Like DRR, a flow starts with no credit when it becomes backlogged.
+        flow->active = true;
+        flow->deficit_us = 0;
+        active_flows_.push_back(flow);
+      }
+      queued_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    ++running_;
+  }
+
+  if (TRPC_LIKELY(Start(task, flow, 0))) {
+    return true;
+  }
+
+  object_pool::Delete<MsgTask>(task);
+  // The task did not occupy the slot, so the waiting tasks(if any) are still served by the running handlers.
+  std::scoped_lock _(mutex_);
+  --running_;
+  return false;
+}
+
+std::size_t HandleTaskDispatcher::GetQueueSize() {
+  std::scoped_lock _(mutex_);
+  return queue_size_;
+}
+
+HandleTaskDispatcher::Stats HandleTaskDispatcher::GetStats() {
+  Stats stats;
+  stats.dispatched = dispatched_.load(std::memory_order_relaxed);
+  stats.queued = queued_.load(std::memory_order_relaxed);
+  stats.shed = shed_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+bool HandleTaskDispatcher::Start(MsgTask* task, Flow* flow, int64_t charged_us) {
+  // Only the pointer is captured, so the task is left intact if the fiber can not be started.
+  bool ok = start_fiber_([this, task, flow, charged_us]() {
+    if (!options_.fair_queuing) {
+      RunAndDelete(task);
+      OnHandlerExit(flow, charged_us, 0);
+      return;
+    }
+
+    uint64_t begin_us = trpc::time::GetMicroSeconds();
+    RunAndDelete(task);
+    OnHandlerExit(flow, charged_us, static_cast<int64_t>(trpc::time::GetMicroSeconds() - begin_us));
+  });
+  if (ok) {
+    dispatched_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return ok;
+}
+
+void HandleTaskDispatcher::OnHandlerExit(Flow* flow, int64_t charged_us, int64_t cost_us) {
+  while (true) {
+    MsgTask* task = nullptr;
+    {
+      std::scoped_lock _(mutex_);
+      if (options_.fair_queuing) {
+        // Correct the estimated cost charged on dispatch with the real one. Idle flows carry no debt.
+        if (flow->active) {
+          flow->deficit_us -= cost_us - charged_us;
+        }
+        if (cost_us > 0) {
+          flow->avg_cost_us = (flow->avg_cost_us * 7 + cost_us) / 8;
+        }
+      }
+
+      task = PopLocked(&flow, &charged_us);
+      if (task == nullptr) {
+        --running_;
+        return;
+      }
+    }
+
+    // The slot of the exited handler is handed over to `task`.
+    // A task which is shed or fails to start does not use the slot, what it's charged is refunded in the next round.
+    cost_us = 0;
+    if (options_.deadline_aware && task->deadline_us > 0 && task->deadline_us <= trpc::time::GetMicroSeconds()) {
+      shed_.fetch_add(1, std::memory_order_relaxed);
+      Shed(task);
+      continue;
+    }
+
+    if (TRPC_LIKELY(Start(task, flow, charged_us))) {
+      return;
+    }
+
+    // Out of fibers, fail the task fast in the current fiber.
+    Shed(task);
+  }
+}
+
+HandleTaskDispatcher::Flow* HandleTaskDispatcher::GetFlowLocked(const MsgTask* task) {
+  uint32_t id = options_.fair_queuing ? task->flow_id : 0;
+  auto& flow = flows_[id];
+  if (TRPC_UNLIKELY(!flow)) {
+    flow = std::make_unique<Flow>();
+    // Until measured, a handler is assumed to take a tenth of the quantum.
+    flow->avg_cost_us = std::max<int64_t>(1, options_.quantum_us / 10);
+  }
+  flow->weight = std::max<uint32_t>(1, task->flow_weight);
+  return flow.get();
+}
+
+MsgTask* HandleTaskDispatcher::PopLocked(Flow** flow, int64_t* charged_us) {
+  while (!active_flows_.empty()) {
+    Flow* front = active_flows_.front();
+    if (options_.fair_queuing && front->deficit_us <= 0) {
+      // Grant the quantum of the next round and move on to the next flow.
+      front->deficit_us += static_cast<int64_t>(options_.quantum_us) * front->weight;
+      active_flows_.pop_front();
+      active_flows_.push_back(front);
+      continue;
+    }
+
+    MsgTask* task = PopFromFlowLocked(front);
+    TRPC_ASSERT(task);
+    --queue_size_;
+
+    int64_t charge = 0;
+    if (options_.fair_queuing) {
+      charge = std::max<int64_t>(1, front->avg_cost_us);
+      front->deficit_us -= charge;
+    }
+    if (front->Empty()) {
+      front->active = false;
+      front->deficit_us = 0;
+      active_flows_.pop_front();
+    }
+
+    *flow = front;
+    *charged_us = charge;
+    return task;
+  }
+
+  return nullptr;
+}
+
+MsgTask* HandleTaskDispatcher::PopFromFlowLocked(Flow* flow) {
+  MsgTask* task = nullptr;
+  bool take_fifo =
+      !flow->fifo_queue.empty() && (flow->deadline_queue.empty() || ++flow->pops % options_.fifo_share == 0);
+  if (take_fifo) {
+    task = flow->fifo_queue.front();
+    flow->fifo_queue.pop_front();
+  } else if (!flow->deadline_queue.empty()) {
+    task = flow->deadline_queue.top().task;
+    flow->deadline_queue.pop();
+  }
+  return task;
+}
+
+void HandleTaskDispatcher::Shed(MsgTask* task) {
+  if (task->overload_handler) {
+    task->overload_handler();
+  }
+  RunAndDelete(task);
+}
+
+void HandleTaskDispatcher::RunAndDelete(MsgTask* task) {
+  MsgTaskHandler handler = std::move(task->handler);
+  object_pool::Delete<MsgTask>(task);
+  handler();
+}
+
+}  // namespace trpc::fiber
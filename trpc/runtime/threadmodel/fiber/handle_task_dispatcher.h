@@ -0,0 +1,147 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/runtime/threadmodel/common/msg_task.h"
+#include "trpc/util/function.h"
+
+namespace trpc::fiber {
+
+/// @brief Dispatcher of the handle tasks of a scheduling group. At most `max_running` handler fibers started by the
+///        dispatcher run at the same time, the tasks submitted beyond that wait in the dispatcher instead of the FIFO
+///        fiber run queue, and the next one is started when a handler fiber exits.
+///        The waiting tasks are queued per flow(eg: service):
+///        1. If deadline-aware, tasks with a deadline are ordered by it(earliest first), tasks without deadline wait
+///           in a FIFO bucket, and tasks whose deadline has already passed when taken out are shed(their
+///           `overload_handler` is called ahead of their `handler`, so that they fail fast). Otherwise tasks are FIFO.
+///        2. If fair queuing, the flows share the running slots by deficit round robin(DRR) weighted by
+///           `MsgTask::flow_weight`, where the cost of a task is the time its handler holds a running slot. Otherwise
+///           all the tasks belong to a single flow.
+class HandleTaskDispatcher {
+ public:
+  /// @brief Start a fiber running the handler, return false on failure.
+  using StartFiberFunction = Function<bool(MsgTaskHandler&&)>;
+
+  struct Options {
+    /// Max number of the handler fibers running at the same time
+    uint32_t max_running{1024};
+
+    /// Order the tasks by deadline and shed the expired ones or not
+    bool deadline_aware{true};
+
+    /// Share the running slots between flows by weighted DRR or not
+    bool fair_queuing{false};
+
+    /// One out of `fifo_share` dispatches of a flow takes the task from the no-deadline bucket when tasks with
+    /// deadline are waiting as well, so that tasks without deadline are not starved.
+    uint32_t fifo_share{8};
+
+    /// The time(us) of running slot granted to a flow of weight 1 per DRR round
+    uint32_t quantum_us{1000};
+  };
+
+  struct Stats {
+    /// number of tasks started as fibers
+    uint64_t dispatched{0};
+
+    /// number of tasks which had to wait in the dispatcher
+    uint64_t queued{0};
+
+    /// number of tasks shed because their deadline had passed
+    uint64_t shed{0};
+  };
+
+  HandleTaskDispatcher(const Options& options, StartFiberFunction&& start_fiber);
+
+  ~HandleTaskDispatcher();
+
+  /// @brief Submit a task, the dispatcher takes the ownership of it.
+  /// @return false if the task should have been started at once but the fiber could not be started, the task is
+  ///         deleted without calling its handler in this case.
+  bool Submit(MsgTask* task);
+
+  /// @brief Number of the tasks waiting in the dispatcher.
+  std::size_t GetQueueSize();
+
+  Stats GetStats();
+
+ private:
+  struct Entry {
+    uint64_t deadline_us;
+    uint64_t seq;
+    MsgTask* task;
+  };
+
+  struct EntryLater {
+    bool operator()(const Entry& a, const Entry& b) const {
+      return a.deadline_us != b.deadline_us ? a.deadline_us > b.deadline_us : a.seq > b.seq;
+    }
+  };
+
+  struct Flow {
+    uint32_t weight{1};
+
+    // Running slot time(us) the flow may still use in the current DRR round, it goes negative when the handlers
+    // turn out to run longer than charged.
+    int64_t deficit_us{0};
+
+    // Moving average of the running slot time(us) of the handlers, charged when a task is dispatched and corrected
+    // once its handler exits.
+    int64_t avg_cost_us{0};
+
+    // Whether the flow is in `active_flows_`, i.e. it has waiting tasks.
+    bool active{false};
+
+    uint64_t pops{0};
+    std::priority_queue<Entry, std::vector<Entry>, EntryLater> deadline_queue;
+    std::deque<MsgTask*> fifo_queue;
+
+    bool Empty() const { return deadline_queue.empty() && fifo_queue.empty(); }
+  };
+
+  bool Start(MsgTask* task, Flow* flow, int64_t charged_us);
+  void OnHandlerExit(Flow* flow, int64_t charged_us, int64_t cost_us);
+  Flow* GetFlowLocked(const MsgTask* task);
+  MsgTask* PopLocked(Flow** flow, int64_t* charged_us);
+  MsgTask* PopFromFlowLocked(Flow* flow);
+  void Shed(MsgTask* task);
+  void RunAndDelete(MsgTask* task);
+
+ private:
+  Options options_;
+  StartFiberFunction start_fiber_;
+
+  std::mutex mutex_;
+  uint32_t running_{0};
+  uint64_t seq_{0};
+  std::size_t queue_size_{0};
+  std::unordered_map<uint32_t, std::unique_ptr<Flow>> flows_;
+  std::deque<Flow*> active_flows_;
+
+  std::atomic<uint64_t> dispatched_{0};
+  std::atomic<uint64_t> queued_{0};
+  std::atomic<uint64_t> shed_{0};
+};
+
+}  // namespace trpc::fiber
@@ -0,0 +1,232 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/threadmodel/fiber/handle_task_dispatcher.h"
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/time.h"
+
+namespace trpc::fiber::testing {
+
+class HandleTaskDispatcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    HandleTaskDispatcher::Options options;
+    options.max_running = 1;
+    options.fifo_share = 2;
+    CreateDispatcher(options);
+  }
+
+  void CreateDispatcher(const HandleTaskDispatcher::Options& options) {
+    dispatcher_ = std::make_unique<HandleTaskDispatcher>(options, [this](MsgTaskHandler&& handler) {
+      if (fail_start_) {
+        return false;
+      }
+      fibers_.push_back(std::move(handler));
+      return true;
+    });
+  }
+
+  void TearDown() override { dispatcher_.reset(); }
+
+  MsgTask* NewTask(std::string name, uint64_t deadline_us) {
+    MsgTask* task = object_pool::New<MsgTask>();
+    task->deadline_us = deadline_us;
+    task->handler = [this, name]() { executed_.push_back(name); };
+    task->overload_handler = [this, name]() { shed_.push_back(name); };
+    return task;
+  }
+
+  // The handler of the task keeps running for `cost_us`.
+  MsgTask* NewFlowTask(std::string name, uint32_t flow_id, uint32_t flow_weight, uint64_t cost_us) {
+    MsgTask* task = object_pool::New<MsgTask>();
+    task->flow_id = flow_id;
+    task->flow_weight = flow_weight;
+    task->handler = [this, name, cost_us]() {
+      uint64_t end_us = trpc::time::GetMicroSeconds() + cost_us;
+      while (trpc::time::GetMicroSeconds() < end_us) {
+      }
+      executed_.push_back(name);
+    };
+    return task;
+  }
+
+  // Number of the tasks of each flow executed before one of the flows runs out of tasks.
+  std::pair<int, int> CountWhileBothBacklogged(const std::string& a, const std::string& b, int total_a,
+                                               int total_b) {
+    int count_a = 0;
+    int count_b = 0;
+    for (auto& name : executed_) {
+      if (count_a == total_a || count_b == total_b) {
+        break;
+      }
+      name == a ? ++count_a : ++count_b;
+    }
+    return {count_a, count_b};
+  }
+
+  // Run the started fibers one by one, as if there was a single worker.
+  void RunFibers() {
+    while (!fibers_.empty()) {
+      auto fiber = std::move(fibers_.front());
+      fibers_.pop_front();
+      fiber();
+    }
+  }
+
+ protected:
+  std::unique_ptr<HandleTaskDispatcher> dispatcher_;
+  std::deque<MsgTaskHandler> fibers_;
+  bool fail_start_{false};
+  std::vector<std::string> executed_;
+  std::vector<std::string> shed_;
+};
+
+TEST_F(HandleTaskDispatcherTest, EarliestDeadlineFirst) {
+  uint64_t now_us = trpc::time::GetMicroSeconds();
+
+  // The first task occupies the only slot, the others wait in the dispatcher.
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("running", now_us + 1000000)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("late", now_us + 3000000)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("early", now_us + 1000000)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("middle", now_us + 2000000)));
+  ASSERT_EQ(1, fibers_.size());
+  ASSERT_EQ(3, dispatcher_->GetQueueSize());
+
+  RunFibers();
+
+  ASSERT_EQ((std::vector<std::string>{"running", "early", "middle", "late"}), executed_);
+  ASSERT_TRUE(shed_.empty());
+  ASSERT_EQ(0, dispatcher_->GetQueueSize());
+
+  auto stats = dispatcher_->GetStats();
+  ASSERT_EQ(4, stats.dispatched);
+  ASSERT_EQ(3, stats.queued);
+  ASSERT_EQ(0, stats.shed);
+}
+
+TEST_F(HandleTaskDispatcherTest, FifoBucketIsNotStarved) {
+  uint64_t now_us = trpc::time::GetMicroSeconds();
+
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("running", 0)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("fifo1", 0)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("fifo2", 0)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("edf1", now_us + 1000000)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("edf2", now_us + 2000000)));
+
+  RunFibers();
+
+  // Every second dispatch takes the no-deadline bucket while both have tasks waiting.
+  ASSERT_EQ((std::vector<std::string>{"running", "edf1", "fifo1", "edf2", "fifo2"}), executed_);
+}
+
+TEST_F(HandleTaskDispatcherTest, ShedExpiredAtDequeue) {
+  uint64_t now_us = trpc::time::GetMicroSeconds();
+
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("running", 0)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("expired", now_us + 1000)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("alive", now_us + 10000000)));
+
+  while (trpc::time::GetMicroSeconds() <= now_us + 1000) {
+  }
+  RunFibers();
+
+  // The expired task fails fast: its overload handler is called ahead of its handler.
+  ASSERT_EQ((std::vector<std::string>{"expired"}), shed_);
+  ASSERT_EQ((std::vector<std::string>{"running", "expired", "alive"}), executed_);
+  ASSERT_EQ(1, dispatcher_->GetStats().shed);
+  ASSERT_EQ(2, dispatcher_->GetStats().dispatched);
+}
+
+TEST_F(HandleTaskDispatcherTest, StartFiberFailed) {
+  fail_start_ = true;
+  ASSERT_FALSE(dispatcher_->Submit(NewTask("failed", 0)));
+  ASSERT_TRUE(executed_.empty());
+
+  // The slot is released.
+  fail_start_ = false;
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("ok", 0)));
+  RunFibers();
+  ASSERT_EQ((std::vector<std::string>{"ok"}), executed_);
+}
+
+TEST_F(HandleTaskDispatcherTest, FairQueuingByWeight) {
+  HandleTaskDispatcher::Options options;
+  options.max_running = 1;
+  options.fair_queuing = true;
+  options.deadline_aware = false;
+  options.quantum_us = 1000;
+  CreateDispatcher(options);
+
+  ASSERT_TRUE(dispatcher_->Submit(NewFlowTask("running", 0, 1, 0)));
+  for (int i = 0; i < 40; ++i) {
+    ASSERT_TRUE(dispatcher_->Submit(NewFlowTask("light", 1, 1, 200)));
+    ASSERT_TRUE(dispatcher_->Submit(NewFlowTask("heavy", 2, 3, 200)));
+  }
+  RunFibers();
+  ASSERT_EQ(81, executed_.size());
+
+  executed_.erase(executed_.begin());
+  auto [light, heavy] = CountWhileBothBacklogged("light", "heavy", 40, 40);
+  // The flow of weight 3 gets about 3 times the running slot time.
+  ASSERT_GE(heavy, 2 * light);
+  ASSERT_LE(heavy, 5 * light);
+}
+
+TEST_F(HandleTaskDispatcherTest, FairQueuingByCost) {
+  HandleTaskDispatcher::Options options;
+  options.max_running = 1;
+  options.fair_queuing = true;
+  options.deadline_aware = false;
+  options.quantum_us = 1000;
+  CreateDispatcher(options);
+
+  ASSERT_TRUE(dispatcher_->Submit(NewFlowTask("running", 0, 1, 0)));
+  for (int i = 0; i < 60; ++i) {
+    ASSERT_TRUE(dispatcher_->Submit(NewFlowTask("slow", 1, 1, 400)));
+    ASSERT_TRUE(dispatcher_->Submit(NewFlowTask("fast", 2, 1, 100)));
+  }
+  RunFibers();
+
+  executed_.erase(executed_.begin());
+  auto [slow, fast] = CountWhileBothBacklogged("slow", "fast", 60, 60);
+  // Equal weights share the running slot time, rather than the number of tasks.
+  ASSERT_GE(fast * 100 * 2, slow * 400);
+  ASSERT_LE(fast * 100, slow * 400 * 2);
+}
+
+TEST_F(HandleTaskDispatcherTest, FifoWithoutDeadlineAware) {
+  HandleTaskDispatcher::Options options;
+  options.max_running = 1;
+  options.deadline_aware = false;
+  CreateDispatcher(options);
+
+  uint64_t now_us = trpc::time::GetMicroSeconds();
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("running", 0)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("expired", now_us)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("late", now_us + 2000000)));
+  ASSERT_TRUE(dispatcher_->Submit(NewTask("early", now_us + 1000000)));
+  RunFibers();
+
+  ASSERT_EQ((std::vector<std::string>{"running", "expired", "late", "early"}), executed_);
+  ASSERT_TRUE(shed_.empty());
+}
+
+}  // namespace trpc::fiber::testing
@@ -46,6 +46,11 @@ MergeThreadModel::MergeThreadModel(Options&& options) : options_(std::move(optio
     worker_options.io_uring_flags = options_.io_uring_flags;
 
     worker_threads_.push_back(std::make_unique<MergeWorkerThread>(std::move(worker_options)));
+
+    if (options_.queue_policy.name == kCoDelQueuePolicy) {
+      codel_controllers_.push_back(std::make_unique<CoDelController>(options_.queue_policy.codel_target_delay_ms * 1000,
+                                                                      options_.queue_policy.codel_interval_ms * 1000));
+    }
   }
 }
 
@@ -106,10 +111,14 @@ bool MergeThreadModel::SubmitMsgTask(MsgTask* task) noexcept {
 
   Reactor* reactor = worker_threads_[id]->GetReactor();
 
-  bool ret = reactor->SubmitTask([task]() {
-    task->handler();
-    object_pool::Delete<MsgTask>(task);
-  });
+  // The controller is only accessed by the worker thread executing the task.
+  CoDelController* codel = nullptr;
+  if (!codel_controllers_.empty()) {
+    codel = codel_controllers_[id].get();
+    MarkMsgTaskEnqueued(task);
+  }
+
+  bool ret = reactor->SubmitTask([task, codel]() { RunMsgTask(task, codel); });
 
   if (!ret) {
     object_pool::Delete<MsgTask>(task);
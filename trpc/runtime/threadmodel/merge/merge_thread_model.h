@@ -19,6 +19,7 @@
 
 #include "trpc/runtime/iomodel/reactor/reactor.h"
 #include "trpc/runtime/threadmodel/common/msg_task.h"
+#include "trpc/runtime/threadmodel/common/queue_policy.h"
 #include "trpc/runtime/threadmodel/thread_model.h"
 #include "trpc/runtime/threadmodel/merge/merge_worker_thread.h"
 
@@ -55,6 +56,10 @@ class MergeThreadModel final : public ThreadModel {
 
     /// bind cpu core strictly or not
     bool disallow_cpu_migration{false};
+
+    /// queue management policy of the tasks submitted to other worker threads
+    /// @note Only the shedding of codel applies, the tasks are still executed in the order they are submitted.
+    QueuePolicyOptions queue_policy;
   };
 
   explicit MergeThreadModel(Options&& options);
@@ -98,6 +103,9 @@ class MergeThreadModel final : public ThreadModel {
   Options options_;
 
   std::vector<std::unique_ptr<MergeWorkerThread>> worker_threads_;
+
+  // Only created when the queue policy is codel, one per worker thread.
+  std::vector<std::unique_ptr<CoDelController>> codel_controllers_;
 };
 
 }  // namespace trpc
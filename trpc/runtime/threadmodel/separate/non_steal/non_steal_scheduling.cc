@@ -20,6 +20,17 @@
 
 namespace trpc::separate {
 
+namespace {
+
+// Max number of tasks executed each time the worker thread handles its queues.
+constexpr uint32_t kMaxExecuteCountOnce = 100;
+
+// Tasks submitted from outside go to the local queue of the preferred worker thread only while it is shorter than
+// this, otherwise they go to the global queue, so that the preferred thread does not become the bottleneck.
+constexpr uint32_t kMaxPreferredQueueSize = 64;
+
+}  // namespace
+
 NonStealScheduling::NonStealScheduling(Options&& options) : options_(std::move(options)) {
   TRPC_ASSERT(options_.worker_thread_num > 0);
   TRPC_ASSERT(options_.global_queue_size > 0);
@@ -35,6 +46,14 @@ NonStealScheduling::NonStealScheduling(Options&& options) : options_(std::move(o
   for (size_t i = 0; i < options_.worker_thread_num; ++i) {
     timer_queues_.push_back(std::make_unique<TimerQueue>());
   }
+
+  if (options_.queue_policy.name == kCoDelQueuePolicy) {
+    for (size_t i = 0; i < options_.worker_thread_num; ++i) {
+      codel_controllers_.push_back(std::make_unique<CoDelController>(options_.queue_policy.codel_target_delay_ms * 1000,
+                                                                      options_.queue_policy.codel_interval_ms * 1000));
+    }
+    lifo_batches_.resize(options_.worker_thread_num);
+  }
 }
 
 void NonStealScheduling::Enter(int32_t current_worker_thread_id) noexcept {
@@ -68,16 +87,20 @@ void NonStealScheduling::ExecuteTask(std::size_t worker_index) noexcept {
 }
 
 void NonStealScheduling::HandleMsgTask(std::size_t worker_index) noexcept {
-  uint32_t execute_count = 100;
+  CoDelController* codel = GetCoDelController(worker_index);
+  if (codel && codel->IsOverloaded()) {
+    HandleMsgTaskInLifo(worker_index);
+    return;
+  }
+
+  uint32_t execute_count = kMaxExecuteCountOnce;
   while (execute_count > 0) {
     // report its own heartbeat information before each task execution.
     HeartBeat(Size(worker_index));
 
     MsgTask* task = Pop(worker_index);
     if (task) {
-      task->handler();
-
-      trpc::object_pool::Delete<MsgTask>(task);
+      RunMsgTask(task, codel);
     } else {
       break;
     }
@@ -86,6 +109,32 @@ void NonStealScheduling::HandleMsgTask(std::size_t worker_index) noexcept {
   }
 }
 
+void NonStealScheduling::HandleMsgTaskInLifo(std::size_t worker_index) noexcept {
+  // The queues are standing, so the oldest tasks are likely to time out anyway. Serve the newest ones first so that
+  // they still meet their deadlines, and leave the oldest ones to be shed by codel.
+  CoDelController* codel = GetCoDelController(worker_index);
+  std::vector<MsgTask*>& batch = lifo_batches_[worker_index];
+  while (batch.size() < kMaxExecuteCountOnce) {
+    MsgTask* task = Pop(worker_index);
+    if (!task) {
+      break;
+    }
+    batch.push_back(task);
+  }
+
+  for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+    HeartBeat(Size(worker_index));
+
+    RunMsgTask(*it, codel);
+  }
+
+  batch.clear();
+}
+
+CoDelController* NonStealScheduling::GetCoDelController(std::size_t worker_index) const noexcept {
+  return codel_controllers_.empty() ? nullptr : codel_controllers_[worker_index].get();
+}
+
 void NonStealScheduling::HandleTimerTask(std::size_t worker_index) noexcept {
   timer_queues_[worker_index]->RunExpiredTimers(trpc::time::GetMilliSeconds());
 }
@@ -118,6 +167,23 @@ bool NonStealScheduling::SubmitHandleTask(MsgTask* handle_task) noexcept {
   return ret;
 }
 
+std::size_t NonStealScheduling::SubmitHandleTasks(MsgTask** handle_tasks, std::size_t size,
+                                                  int32_t preferred_worker_index) noexcept {
+  std::size_t failed = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    MsgTask* task = handle_tasks[i];
+    if (!Push(task, preferred_worker_index)) {
+      handle_tasks[failed++] = task;
+    }
+  }
+
+  if (failed < size) {
+    Notify();
+  }
+
+  return failed;
+}
+
 uint64_t NonStealScheduling::AddTimer(TimerTask* timer_task) noexcept {
   std::size_t worker_index = GetCurrentWorkerIndex();
   if (worker_index != static_cast<std::size_t>(-1)) {
@@ -174,7 +240,11 @@ uint32_t NonStealScheduling::Capacity(std::size_t worker_index) const {
   return global_task_queue_.Capacity() + local_task_queues_[worker_index].Capacity();
 }
 
-bool NonStealScheduling::Push(MsgTask* task) noexcept {
+bool NonStealScheduling::Push(MsgTask* task, int32_t preferred_worker_index) noexcept {
+  if (!codel_controllers_.empty()) {
+    MarkMsgTaskEnqueued(task);
+  }
+
   if (task->dst_thread_key < 0) {
     switch (task->task_type) {
       case trpc::runtime::kParallelTask:
@@ -183,6 +253,12 @@ bool NonStealScheduling::Push(MsgTask* task) noexcept {
       default:
         std::size_t worker_index = GetCurrentWorkerIndex();
         if (worker_index == static_cast<std::size_t>(-1)) {
+          if (preferred_worker_index >= 0 && preferred_worker_index < options_.worker_thread_num) {
+            auto& preferred_queue = local_task_queues_[preferred_worker_index];
+            if (preferred_queue.Size() < kMaxPreferredQueueSize && preferred_queue.Push(task)) {
+              return true;
+            }
+          }
           return global_task_queue_.Push(task);
         } else {
           return local_task_queues_[worker_index].Push(task);
@@ -13,8 +13,13 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "trpc/runtime/iomodel/reactor/default/timer_queue.h"
 #include "trpc/runtime/threadmodel/common/msg_task.h"
+#include "trpc/runtime/threadmodel/common/queue_policy.h"
 #include "trpc/runtime/threadmodel/common/timer_task.h"
 #include "trpc/runtime/threadmodel/separate/separate_scheduling.h"
 #include "trpc/util/queue/bounded_mpmc_queue.h"
@@ -38,6 +43,9 @@ class NonStealScheduling final : public SeparateScheduling {
 
     /// @brief size of the current thread's local queue
     uint32_t local_queue_size = 50000;
+
+    /// @brief queue management policy of the task queues
+    QueuePolicyOptions queue_policy;
   };
 
   explicit NonStealScheduling(Options&& options);
@@ -58,6 +66,9 @@ class NonStealScheduling final : public SeparateScheduling {
 
   bool SubmitHandleTask(MsgTask* handle_task) noexcept override;
 
+  std::size_t SubmitHandleTasks(MsgTask** handle_tasks, std::size_t size,
+                                int32_t preferred_worker_index) noexcept override;
+
   uint64_t AddTimer(TimerTask* timer_task) noexcept override;
   void PauseTimer(uint64_t timer_id) noexcept override;
   void ResumeTimer(uint64_t timer_id) noexcept override;
@@ -70,7 +81,9 @@ class NonStealScheduling final : public SeparateScheduling {
 
  private:
   void HandleMsgTask(std::size_t worker_index) noexcept;
-  bool Push(MsgTask* task) noexcept;
+  void HandleMsgTaskInLifo(std::size_t worker_index) noexcept;
+  CoDelController* GetCoDelController(std::size_t worker_index) const noexcept;
+  bool Push(MsgTask* task, int32_t preferred_worker_index = -1) noexcept;
   MsgTask* Pop(std::size_t worker_index) noexcept;
   uint32_t Size(std::size_t worker_index) const;
   uint32_t Capacity(std::size_t worker_index) const;
@@ -97,6 +110,12 @@ class NonStealScheduling final : public SeparateScheduling {
   std::unique_ptr<BoundedMPMCQueue<MsgTask*>[]> local_task_queues_;
 
   std::vector<std::unique_ptr<TimerQueue>> timer_queues_;
+
+  // Only created when the queue policy is codel, one per worker thread.
+  std::vector<std::unique_ptr<CoDelController>> codel_controllers_;
+
+  // Tasks taken out of the queues to be executed newest-first while the queues are standing.
+  std::vector<std::vector<MsgTask*>> lifo_batches_;
 };
 
 }  // namespace trpc::separate
@@ -17,6 +17,15 @@
 
 namespace trpc {
 
+std::size_t SeparateScheduling::SubmitHandleTasks(MsgTask** handle_tasks, std::size_t size,
+                                                  int32_t preferred_worker_index) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    SubmitHandleTask(handle_tasks[i]);
+  }
+
+  return 0;
+}
+
 static std::unordered_map<std::string, SeparateSchedulingCreateFunction> scheduling_create_funtion_map;
 
 bool RegisterSeparateSchedulingImpl(const std::string& name, SeparateSchedulingCreateFunction&& func) {
@@ -67,6 +67,17 @@ class SeparateScheduling {
   /// @note task must be generated by the object pool
   virtual bool SubmitHandleTask(MsgTask* handle_task) noexcept = 0;
 
+  /// @brief submit a batch of handle tasks, the handle threads are woken up once for the whole batch
+  /// @param handle_tasks tasks to submit
+  /// @param size number of tasks
+  /// @param preferred_worker_index index of the handle thread preferred to run the tasks without specified thread
+  ///        (eg: the one sharing the cache with the submitting io thread), -1 means no preference
+  /// @return number of tasks failed to submit, they are moved to the front of `handle_tasks` and still owned by the
+  ///         caller
+  /// @note the default implementation submits the tasks one by one, and the tasks failed to submit are deleted
+  virtual std::size_t SubmitHandleTasks(MsgTask** handle_tasks, std::size_t size,
+                                        int32_t preferred_worker_index) noexcept;
+
   virtual uint64_t AddTimer(TimerTask* timer_task) noexcept { return kInvalidTimerId; }
   virtual void PauseTimer(uint64_t timer_id) noexcept {}
   virtual void ResumeTimer(uint64_t timer_id) noexcept {}
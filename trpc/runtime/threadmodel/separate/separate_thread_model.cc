@@ -13,12 +13,16 @@
 
 #include "trpc/runtime/threadmodel/separate/separate_thread_model.h"
 
+#include <algorithm>
 #include <mutex>
 
+#include "trpc/runtime/threadmodel/common/queue_policy.h"
 #include "trpc/util/check.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/object_pool/object_pool.h"
 #include "trpc/util/random.h"
+#include "trpc/util/thread/cpu.h"
+#include "trpc/util/time.h"
 
 namespace trpc {
 
@@ -68,6 +72,39 @@ SeparateThreadModel::SeparateThreadModel(Options&& options) : options_(std::move
 
     io_threads_.push_back(std::make_unique<IoWorkerThread>(std::move(worker_options)));
   }
+
+  if (options_.handoff_batch_size > 1) {
+    InitHandoffBatches();
+  }
+}
+
+void SeparateThreadModel::InitHandoffBatches() {
+  handoff_batches_ = std::make_unique<HandoffBatch[]>(io_threads_.size());
+  for (std::size_t i = 0; i != io_threads_.size(); ++i) {
+    handoff_batches_[i].tasks.reserve(options_.handoff_batch_size);
+  }
+
+  // The threads are bound to dedicated cpus, so the io thread prefers the handle thread sharing the last level cache
+  // with it, the data of the request is likely still in the cache.
+  if (!options_.disallow_cpu_migration) {
+    return;
+  }
+  for (std::size_t i = 0; i != io_threads_.size(); ++i) {
+    auto shared_cpus = GetProcessorsSharingLastLevelCache(options_.io_cpu_affinitys[i]);
+    if (!shared_cpus) {
+      continue;
+    }
+
+    std::vector<int32_t> candidates;
+    for (std::size_t j = 0; j != handle_threads_.size(); ++j) {
+      if (std::find(shared_cpus->begin(), shared_cpus->end(), options_.handle_cpu_affinitys[j]) != shared_cpus->end()) {
+        candidates.push_back(j);
+      }
+    }
+    if (!candidates.empty()) {
+      handoff_batches_[i].preferred_handle_index = candidates[i % candidates.size()];
+    }
+  }
 }
 
 void SeparateThreadModel::Start() noexcept {
@@ -142,7 +179,88 @@ bool SeparateThreadModel::SubmitIoTask(MsgTask* io_task) noexcept {
 bool SeparateThreadModel::SubmitHandleTask(MsgTask* handle_task) noexcept {
   TRPC_ASSERT(handle_task);
 
-  return handle_scheduling_->SubmitHandleTask(handle_task);
+  HandoffBatch* batch = GetCurrentHandoffBatch();
+  if (!batch) {
+    return handle_scheduling_->SubmitHandleTask(handle_task);
+  }
+
+  // Tasks decoded during one round of the reactor loop are handed over together by an inner task of the reactor,
+  // which runs after all the ready events of this round are processed.
+  if (batch->tasks.empty()) {
+    batch->first_task_us = trpc::time::GetSteadyMicroSeconds();
+  }
+  batch->tasks.push_back(handle_task);
+
+  if (batch->tasks.size() >= options_.handoff_batch_size) {
+    FlushHandoffBatch(batch);
+  } else if (!batch->flush_scheduled) {
+    batch->flush_scheduled = true;
+    Reactor* reactor = io_threads_[WorkerThread::GetCurrentWorkerThread()->Id()]->GetReactor();
+    reactor->SubmitInnerTask([this, batch]() {
+      batch->flush_scheduled = false;
+      FlushHandoffBatch(batch);
+    });
+  }
+
+  return true;
+}
+
+SeparateThreadModel::HandoffBatch* SeparateThreadModel::GetCurrentHandoffBatch() const noexcept {
+  if (!handoff_batches_) {
+    return nullptr;
+  }
+
+  WorkerThread* current = WorkerThread::GetCurrentWorkerThread();
+  if (!current || current->Role() != kIo || current->GroupId() != options_.group_id) {
+    return nullptr;
+  }
+
+  return &handoff_batches_[current->Id()];
+}
+
+void SeparateThreadModel::FlushHandoffBatch(HandoffBatch* batch) noexcept {
+  std::size_t size = batch->tasks.size();
+  if (size == 0) {
+    return;
+  }
+
+  uint64_t delay_us = trpc::time::GetSteadyMicroSeconds() - batch->first_task_us;
+  batch->batches.fetch_add(1, std::memory_order_relaxed);
+  batch->batched_tasks.fetch_add(size, std::memory_order_relaxed);
+  batch->delay_sum_us.fetch_add(delay_us, std::memory_order_relaxed);
+  if (delay_us > batch->delay_max_us.load(std::memory_order_relaxed)) {
+    batch->delay_max_us.store(delay_us, std::memory_order_relaxed);
+  }
+
+  std::size_t failed =
+      handle_scheduling_->SubmitHandleTasks(batch->tasks.data(), size, batch->preferred_handle_index);
+
+  // The submitter has been told the tasks are accepted, so they can not be dropped silently. A task which is able to
+  // fail fast is marked as overloaded, others are executed by the io thread directly.
+  for (std::size_t i = 0; i < failed; ++i) {
+    MsgTask* task = batch->tasks[i];
+    if (task->overload_handler) {
+      task->overload_handler();
+    }
+    RunMsgTask(task, nullptr);
+  }
+  batch->tasks.clear();
+}
+
+SeparateThreadModel::HandoffStats SeparateThreadModel::GetHandoffStats() const noexcept {
+  HandoffStats stats;
+  if (!handoff_batches_) {
+    return stats;
+  }
+
+  for (std::size_t i = 0; i != io_threads_.size(); ++i) {
+    const HandoffBatch& batch = handoff_batches_[i];
+    stats.batches += batch.batches.load(std::memory_order_relaxed);
+    stats.tasks += batch.batched_tasks.load(std::memory_order_relaxed);
+    stats.delay_sum_us += batch.delay_sum_us.load(std::memory_order_relaxed);
+    stats.delay_max_us = std::max(stats.delay_max_us, batch.delay_max_us.load(std::memory_order_relaxed));
+  }
+  return stats;
 }
 
 std::vector<Reactor*> SeparateThreadModel::GetReactors() const noexcept {
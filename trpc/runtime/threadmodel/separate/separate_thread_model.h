@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -66,6 +67,23 @@ class SeparateThreadModel final : public ThreadModel {
 
     /// bind cpu core strictly or not
     bool disallow_cpu_migration{false};
+
+    /// max number of handle tasks an io thread accumulates during one round of its reactor loop before handing them
+    /// over to the handle threads at once, 0 or 1 means each task is handed over immediately
+    uint32_t handoff_batch_size{0};
+  };
+
+  /// @brief statistics of handing over the handle tasks from io threads in batches
+  struct HandoffStats {
+    /// number of batches, the handle threads are woken up once per batch
+    uint64_t batches{0};
+
+    /// number of tasks handed over in batches
+    uint64_t tasks{0};
+
+    /// time(us) the tasks wait in io threads before being handed over, measured from the first task of each batch
+    uint64_t delay_sum_us{0};
+    uint64_t delay_max_us{0};
   };
 
   explicit SeparateThreadModel(Options&& options);
@@ -85,6 +103,9 @@ class SeparateThreadModel final : public ThreadModel {
   /// @brief submit task to handle thread
   bool SubmitHandleTask(MsgTask* handle_task) noexcept override;
 
+  /// @brief get the statistics of handing over the handle tasks in batches (thread-safe)
+  HandoffStats GetHandoffStats() const noexcept;
+
   /// @brief submit task to io thread (thread-safe)
   bool SubmitIoTask(MsgTask* io_task) noexcept;
 
@@ -110,6 +131,26 @@ class SeparateThreadModel final : public ThreadModel {
   /// @brief get number of handle threads (thread-safe)
   int GetHandleThreadNum() const { return handle_threads_.size(); }
 
+ private:
+  // Handle tasks accumulated by an io thread, only accessed by the io thread except the statistics.
+  struct HandoffBatch {
+    std::vector<MsgTask*> tasks;
+    uint64_t first_task_us{0};
+    bool flush_scheduled{false};
+
+    // Index of the handle thread sharing the last level cache with the io thread, -1 if unknown.
+    int32_t preferred_handle_index{-1};
+
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> batched_tasks{0};
+    std::atomic<uint64_t> delay_sum_us{0};
+    std::atomic<uint64_t> delay_max_us{0};
+  };
+
+  void InitHandoffBatches();
+  HandoffBatch* GetCurrentHandoffBatch() const noexcept;
+  void FlushHandoffBatch(HandoffBatch* batch) noexcept;
+
  private:
   Options options_;
 
@@ -118,6 +159,9 @@ class SeparateThreadModel final : public ThreadModel {
   std::vector<std::unique_ptr<HandleWorkerThread>> handle_threads_;
 
   std::vector<std::unique_ptr<IoWorkerThread>> io_threads_;
+
+  // One per io thread, only created when `handoff_batch_size` > 1.
+  std::unique_ptr<HandoffBatch[]> handoff_batches_;
 };
 
 }  // namespace trpc
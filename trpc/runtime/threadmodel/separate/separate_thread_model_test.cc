@@ -606,6 +606,51 @@ TEST_F(TestSeparateThreadModel, SubmitHandleTask7OnSeparate) {
   EXPECT_EQ(std::this_thread::get_id() != handle_tid, true);
 }
 
+// Test the handle tasks submitted by an io thread in one round of its reactor loop are handed over in batches
+TEST_F(TestSeparateThreadModel, HandoffInBatch) {
+  // A dedicated thread model, so that the handoff of the other tests is not affected.
+  SeparateThreadModel::Options thread_model_options;
+  thread_model_options.group_id = 1;
+  thread_model_options.group_name = "handoff_group";
+  thread_model_options.scheduling_name =
+      (TestSeparateThreadModel::schedule_type_ == kTaskflow ? kStealScheduling : kNonStealScheduling);
+  thread_model_options.io_thread_num = 1;
+  thread_model_options.handle_thread_num = 2;
+  thread_model_options.handoff_batch_size = 8;
+  auto thread_model = std::make_unique<SeparateThreadModel>(std::move(thread_model_options));
+  thread_model->Start();
+
+  constexpr int kTaskNum = 36;
+  std::atomic_int counter{0};
+  std::atomic_bool submitted{false};
+
+  Reactor::Task reactor_task = [&counter, &submitted, model = thread_model.get()] {
+    for (int i = 0; i < kTaskNum; ++i) {
+      MsgTask* task = trpc::object_pool::New<MsgTask>();
+      task->task_type = trpc::runtime::kRequestMsg;
+      task->param = nullptr;
+      task->handler = [&counter]() { counter++; };
+      task->group_id = model->GroupId();
+
+      model->SubmitHandleTask(std::move(task));
+    }
+    submitted = true;
+  };
+  thread_model->GetReactor()->SubmitTask(std::move(reactor_task));
+
+  while (counter != kTaskNum) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(submitted);
+
+  // 4 full batches, and the rest handed over at the end of the round.
+  auto stats = thread_model->GetHandoffStats();
+  ASSERT_EQ(kTaskNum, stats.tasks);
+  ASSERT_EQ(5, stats.batches);
+
+  thread_model->Terminate();
+}
+
 // Test when a handle thread is waiting for a condition to be ready, you can use ExecuteTask to allow the current thread
 // to continue consuming tasks
 TEST_F(TestSeparateThreadModel, ExecuteTask) {
@@ -43,6 +43,13 @@ StealScheduling::StealScheduling(Options&& options)
   for (size_t i = 0; i < options_.worker_thread_num; ++i) {
     timer_queues_.push_back(std::make_unique<TimerQueue>());
   }
+
+  if (options_.queue_policy.name == kCoDelQueuePolicy) {
+    for (size_t i = 0; i < options_.worker_thread_num; ++i) {
+      codel_controllers_.push_back(std::make_unique<CoDelController>(options_.queue_policy.codel_target_delay_ms * 1000,
+                                                                      options_.queue_policy.codel_interval_ms * 1000));
+    }
+  }
 }
 
 void StealScheduling::Enter(int32_t current_worker_thread_id) noexcept {
@@ -68,8 +75,7 @@ void StealScheduling::Schedule() noexcept {
       }
 
       while (task) {
-        task->handler();
-        trpc::object_pool::Delete<MsgTask>(task);
+        RunMsgTask(task, GetCoDelController(worker_index));
         task = local_task_queues_[worker_index].Pop();
 
         HandleTimerTask(worker_index);
@@ -183,8 +189,7 @@ void StealScheduling::ExploreTask(MsgTask*& t) noexcept {
 
 void StealScheduling::ExecuteTask(std::size_t worker_index) noexcept {
   if (auto t = local_task_queues_[worker_index].Pop(); t) {
-    t->handler();
-    trpc::object_pool::Delete<MsgTask>(t);
+    RunMsgTask(t, GetCoDelController(worker_index));
   } else {
     if ((worker_index == vtm_[worker_index])) {
       global_task_queue_.Pop(t);
@@ -193,8 +198,7 @@ void StealScheduling::ExecuteTask(std::size_t worker_index) noexcept {
     }
 
     if (t) {
-      t->handler();
-      trpc::object_pool::Delete<MsgTask>(t);
+      RunMsgTask(t, GetCoDelController(worker_index));
     } else {
       vtm_[worker_index] = rdvtm_(rdgen_);
     }
@@ -235,6 +239,24 @@ bool StealScheduling::SubmitHandleTask(MsgTask* handle_task) noexcept {
   return ret;
 }
 
+std::size_t StealScheduling::SubmitHandleTasks(MsgTask** handle_tasks, std::size_t size,
+                                               int32_t preferred_worker_index) noexcept {
+  std::size_t failed = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    MsgTask* task = handle_tasks[i];
+    if (TRPC_UNLIKELY(!Push(task, false))) {
+      handle_tasks[failed++] = task;
+    }
+  }
+
+  // One idle worker thread is enough, it wakes up others when it finds more tasks to steal.
+  if (failed < size && GetCurrentWorkerIndex() == static_cast<std::size_t>(-1)) {
+    notifier_.Notify(false);
+  }
+
+  return failed;
+}
+
 uint64_t StealScheduling::AddTimer(TimerTask* timer_task) noexcept {
   std::size_t worker_index = GetCurrentWorkerIndex();
   if (worker_index != static_cast<std::size_t>(-1)) {
@@ -286,13 +308,17 @@ uint32_t StealScheduling::Size(std::size_t worker_index) {
   return local_task_queues_[worker_index].Size() + global_task_queue_.Size();
 }
 
-bool StealScheduling::Push(MsgTask* task) noexcept {
+bool StealScheduling::Push(MsgTask* task, bool notify) noexcept {
+  if (!codel_controllers_.empty()) {
+    MarkMsgTaskEnqueued(task);
+  }
+
   std::size_t worker_index = GetCurrentWorkerIndex();
   if (worker_index != static_cast<std::size_t>(-1)) {
     local_task_queues_[worker_index].Push(task);
   } else {
     bool ret = global_task_queue_.Push(task);
-    if (ret) {
+    if (ret && notify) {
       notifier_.Notify(false);
     }
     return ret;
@@ -300,6 +326,10 @@ bool StealScheduling::Push(MsgTask* task) noexcept {
   return true;
 }
 
+CoDelController* StealScheduling::GetCoDelController(std::size_t worker_index) const noexcept {
+  return codel_controllers_.empty() ? nullptr : codel_controllers_[worker_index].get();
+}
+
 void StealScheduling::Destroy() noexcept {
   local_task_queues_.reset();
   timer_queues_.clear();
@@ -23,6 +23,7 @@
 
 #include "trpc/runtime/iomodel/reactor/default/timer_queue.h"
 #include "trpc/runtime/threadmodel/common/msg_task.h"
+#include "trpc/runtime/threadmodel/common/queue_policy.h"
 #include "trpc/runtime/threadmodel/common/timer_task.h"
 #include "trpc/runtime/threadmodel/separate/separate_scheduling.h"
 #include "trpc/util/queue/bounded_mpmc_queue.h"
@@ -55,6 +56,10 @@ class StealScheduling final : public SeparateScheduling {
 
     /// @brief size of the global queue
     uint32_t global_queue_size = 50000;
+
+    /// @brief queue management policy of the task queues
+    /// @note  Only the shedding of codel applies, the owner of a local queue always takes its newest task first.
+    QueuePolicyOptions queue_policy;
   };
 
   explicit StealScheduling(Options&& options);
@@ -75,6 +80,10 @@ class StealScheduling final : public SeparateScheduling {
 
   bool SubmitHandleTask(MsgTask* handle_task) noexcept override;
 
+  /// @note `preferred_worker_index` is ignored, the local queue of a worker thread can only be pushed by itself.
+  std::size_t SubmitHandleTasks(MsgTask** handle_tasks, std::size_t size,
+                                int32_t preferred_worker_index) noexcept override;
+
   uint64_t AddTimer(TimerTask* timer_task) noexcept override;
   void PauseTimer(uint64_t timer_id) noexcept override;
   void ResumeTimer(uint64_t timer_id) noexcept override;
@@ -86,7 +95,7 @@ class StealScheduling final : public SeparateScheduling {
   void Destroy() noexcept override;
 
  private:
-  bool Push(MsgTask* task) noexcept;
+  bool Push(MsgTask* task, bool notify = true) noexcept;
   uint32_t Size(std::size_t worker_index);
 
   void HandleTimerTask(std::size_t worker_index) noexcept;
@@ -99,6 +108,7 @@ class StealScheduling final : public SeparateScheduling {
 
   bool WaitForTask(MsgTask*& task, size_t worker_index) noexcept;
   void ExploreTask(MsgTask*& t) noexcept;
+  CoDelController* GetCoDelController(std::size_t worker_index) const noexcept;
 
  private:
   Options options_;
@@ -118,6 +128,9 @@ class StealScheduling final : public SeparateScheduling {
   std::vector<size_t> vtm_;
   std::uniform_int_distribution<size_t> rdvtm_;
   std::default_random_engine rdgen_{std::random_device{}()};  // NOLINT
+
+  // Only created when the queue policy is codel, one per worker thread.
+  std::vector<std::unique_ptr<CoDelController>> codel_controllers_;
 };
 
 }  // namespace trpc::separate
@@ -14,6 +14,7 @@
 #include "trpc/server/http_service.h"
 
 #include "trpc/codec/http/http_protocol.h"
+#include "trpc/runtime/common/stats/resource_usage_stats.h"
 #include "trpc/util/deferred.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/time.h"
@@ -120,8 +121,19 @@ void HttpService::Handle(const std::string& path, http::HandlerBase* handler, Se
     return;
   }
 
+  bool resource_accounting = GetServiceAdapterOption().resource_accounting;
+  ResourceUsageRecorder resource_usage_recorder;
+  if (resource_accounting) {
+    resource_usage_recorder.Start();
+  }
+
   // Runs user handler.
   auto status = Dispatch(path, handler, context, req, rsp);
+
+  if (resource_accounting) {
+    context->SetResourceUsage(resource_usage_recorder.Stop());
+    ResourceUsageStats::GetInstance()->Update(context->GetFuncName(), context->GetResourceUsage());
+  }
   if (context->IsResponse()) {
     context->SetStatus(std::move(status));
     // For some tracing or log replay plugins.
@@ -0,0 +1,98 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "trpc/server/rpc/rpc_batcher.h"
+#include "trpc/server/rpc/unary_rpc_method_handler.h"
+
+namespace trpc {
+
+/// @brief A call accumulated in a batch.
+template <class RequestType, class ResponseType>
+struct BatchRpcCall {
+  /// The context of the caller.
+  ServerContextPtr context;
+
+  /// The decoded request.
+  const RequestType* request{nullptr};
+
+  /// The response to fill in, it's sent back to the caller after the batch handler returns.
+  ResponseType* response{nullptr};
+
+  /// The result of the call, the response is not sent if it's not OK.
+  Status status;
+};
+
+/// @brief The implementation of micro-batching rpc method handler, the concurrent requests of the method are
+///        accumulated up to `RpcBatchOption::max_size` items or `RpcBatchOption::max_delay`, then handed over to the
+///        batch function at once, and the responses are sent back to each caller.
+template <class RequestType, class ResponseType>
+class BatchRpcMethodHandler : public UnaryRpcMethodHandler<RequestType, ResponseType> {
+ public:
+  using Call = BatchRpcCall<RequestType, ResponseType>;
+
+  using BatchRpcMethodFunction = std::function<void(std::vector<Call>&)>;
+
+  using UnaryRpcMethodHandler<RequestType, ResponseType>::PreExecute;
+  using UnaryRpcMethodHandler<RequestType, ResponseType>::PostExecute;
+
+  /// @param name the name of the method, used to expose the batch statistics.
+  BatchRpcMethodHandler(const BatchRpcMethodFunction& func, const RpcBatchOption& option, std::string_view name = "")
+      : func_(func), batcher_(option, [this](std::vector<Call>&& calls) { HandleBatch(calls); }, name) {}
+
+  void Execute(const ServerContextPtr& context, NoncontiguousBuffer&& req_body,
+               NoncontiguousBuffer& rsp_body) noexcept override {
+    if (!PreExecute(context, std::move(req_body))) {
+      // if decoding error, no need to execute PostExecute
+      if (!IsDecodeError(context)) {
+        PostExecute(context, rsp_body);
+      }
+      return;
+    }
+
+    // The response is sent back once the batch is handled.
+    context->SetResponse(false);
+    batcher_.Add(Call{context, static_cast<RequestType*>(context->GetRequestData()),
+                      static_cast<ResponseType*>(context->GetResponseData()), kDefaultStatus});
+  }
+
+  const RpcBatchStats& GetStats() const { return batcher_.GetStats(); }
+
+ private:
+  void Execute(const ServerContextPtr& context) noexcept override { TRPC_ASSERT(false && "Unreachable"); }
+
+  void HandleBatch(std::vector<Call>& calls) {
+    func_(calls);
+    for (auto& call : calls) {
+      call.context->SendUnaryResponse(call.status, *call.response);
+    }
+  }
+
+  bool IsDecodeError(const ServerContextPtr& context) {
+    return context->GetStatus().GetFrameworkRetCode() ==
+           context->GetServerCodec()->GetProtocolRetCode(codec::ServerRetCode::DECODE_ERROR);
+  }
+
+ private:
+  BatchRpcMethodFunction func_;
+  RpcBatcher<Call> batcher_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,158 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/server/rpc/batch_rpc_method_handler.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "trpc/codec/codec_manager.h"
+#include "trpc/codec/trpc/testing/trpc_protocol_testing.h"
+#include "trpc/proto/testing/helloworld.pb.h"
+#include "trpc/serialization/trpc_serialization.h"
+#include "trpc/server/rpc/rpc_service_impl.h"
+#include "trpc/server/testing/mock_server_transport.h"
+#include "trpc/server/testing/server_context_testing.h"
+
+namespace trpc::testing {
+
+using HelloRequest = trpc::test::helloworld::HelloRequest;
+using HelloReply = trpc::test::helloworld::HelloReply;
+using HelloCall = BatchRpcCall<HelloRequest, HelloReply>;
+
+constexpr std::string_view kBatchSayHello = "/trpc.test.helloworld.Greeter/BatchSayHello";
+
+constexpr int kBadRequestRetCode = 10001;
+
+// Registers the batch method the same way as the code generated by trpc_cpp_plugin.
+class BatchGreeter : public RpcServiceImpl {
+ public:
+  BatchGreeter() {
+    for (const std::string_view& method : {kBatchSayHello}) {
+      AddRpcServiceMethod(new ::trpc::RpcServiceMethod(
+          method.data(), ::trpc::MethodType::UNARY,
+          new ::trpc::BatchRpcMethodHandler<HelloRequest, HelloReply>(
+              std::bind(&BatchGreeter::BatchSayHello, this, std::placeholders::_1),
+              ::trpc::RpcBatchOption{3, std::chrono::microseconds(10000000)}, method)));
+    }
+  }
+
+  void BatchSayHello(std::vector<HelloCall>& calls) {
+    batch_sizes.push_back(calls.size());
+    for (auto& call : calls) {
+      if (call.request->msg() == "bad") {
+        call.status = Status(kBadRequestRetCode, "bad request");
+        continue;
+      }
+      call.response->set_msg("hello " + call.request->msg());
+    }
+  }
+
+  std::vector<std::size_t> batch_sizes;
+};
+
+class BatchRpcMethodHandlerTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    codec::Init();
+    serialization::Init();
+  }
+
+  static void TearDownTestCase() {
+    codec::Destroy();
+    serialization::Destroy();
+  }
+
+ protected:
+  void SetUp() override {
+    greeter_ = std::make_shared<BatchGreeter>();
+    greeter_->SetServerTransport(&transport_);
+    EXPECT_CALL(transport_, SendMsg(::testing::_, ::testing::_))
+        .WillRepeatedly(::testing::Invoke([this](ServerContextPtr& context, NoncontiguousBuffer&& buffer) {
+          Reply reply{context->GetStatus(), ""};
+          if (context->GetStatus().OK()) {
+            HelloReply hello_rsp;
+            EXPECT_TRUE(UnPackTrpcResponse(buffer, DummyTrpcProtocol{}, &hello_rsp));
+            reply.msg = hello_rsp.msg();
+          }
+          replies_.emplace(context->GetRequestId(), std::move(reply));
+          return 0;
+        }));
+  }
+
+  void Call(uint32_t request_id, const std::string& msg) {
+    DummyTrpcProtocol req_data;
+    req_data.request_id = request_id;
+    req_data.func = kBatchSayHello;
+
+    HelloRequest hello_req;
+    hello_req.set_msg(msg);
+
+    NoncontiguousBuffer req_bin_data;
+    ASSERT_TRUE(PackTrpcRequest(req_data, static_cast<void*>(&hello_req), req_bin_data));
+
+    ServerContextPtr context = MakeTestServerContext("trpc", greeter_.get(), std::move(req_bin_data));
+    greeter_->Dispatch(context, context->GetRequestMsg(), context->GetResponseMsg());
+    // The response is sent once the batch is handled.
+    ASSERT_FALSE(context->IsResponse());
+  }
+
+  struct Reply {
+    Status status;
+    std::string msg;
+  };
+
+  MockServerTransport transport_;
+  std::shared_ptr<BatchGreeter> greeter_;
+  std::map<uint32_t, Reply> replies_;
+};
+
+TEST_F(BatchRpcMethodHandlerTest, ScatterResponsesToCallers) {
+  Call(1, "a");
+  Call(2, "b");
+  ASSERT_TRUE(replies_.empty());
+
+  // The third call fills the batch up.
+  Call(3, "c");
+  ASSERT_EQ(std::vector<std::size_t>{3}, greeter_->batch_sizes);
+  ASSERT_EQ(3, replies_.size());
+  ASSERT_EQ("hello a", replies_[1].msg);
+  ASSERT_EQ("hello b", replies_[2].msg);
+  ASSERT_EQ("hello c", replies_[3].msg);
+}
+
+TEST_F(BatchRpcMethodHandlerTest, PerCallErrorStatus) {
+  Call(1, "a");
+  Call(2, "bad");
+  Call(3, "c");
+  ASSERT_EQ(3, replies_.size());
+
+  ASSERT_TRUE(replies_[1].status.OK());
+  ASSERT_EQ("hello a", replies_[1].msg);
+  // Only the failed call gets the error, the others in the same batch are not affected.
+  ASSERT_EQ(kBadRequestRetCode, replies_[2].status.GetFuncRetCode());
+  ASSERT_EQ("bad request", replies_[2].status.ErrorMessage());
+  ASSERT_TRUE(replies_[3].status.OK());
+  ASSERT_EQ("hello c", replies_[3].msg);
+}
+
+}  // namespace trpc::testing
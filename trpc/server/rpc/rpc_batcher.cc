@@ -0,0 +1,91 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/server/rpc/rpc_batcher.h"
+
+#include <algorithm>
+#include <string>
+
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_timer.h"
+#include "trpc/runtime/common/periphery_task_scheduler.h"
+#include "trpc/runtime/threadmodel/common/msg_task.h"
+#include "trpc/runtime/threadmodel/common/worker_thread.h"
+#include "trpc/runtime/threadmodel/thread_model_manager.h"
+
+namespace trpc {
+
+RpcBatchStats::RpcBatchStats(std::string_view name) {
+  if (name.empty()) {
+    batch_size_ = std::make_unique<tvar::LatencyRecorder>();
+    wait_time_us_ = std::make_unique<tvar::LatencyRecorder>();
+    return;
+  }
+
+  // Method names start with '/', eg: "/trpc.test.helloworld.Greeter/SayHello".
+  std::string path = "/trpc/server/batch";
+  if (name.front() != '/') {
+    path += '/';
+  }
+  path += name;
+  auto* group = tvar::TrpcVarGroup::FindOrCreate(path);
+  batch_size_ = std::make_unique<tvar::LatencyRecorder>(group, "batch_size");
+  wait_time_us_ = std::make_unique<tvar::LatencyRecorder>(group, "wait_time_us");
+}
+
+void RpcBatchStats::Update(std::size_t batch_size, std::chrono::microseconds wait_time) {
+  batch_size_->Update(static_cast<uint32_t>(batch_size));
+  wait_time_us_->Update(static_cast<uint32_t>(wait_time.count() > 0 ? wait_time.count() : 0));
+}
+
+namespace detail {
+
+void SetRpcBatchFiberTimer(std::chrono::microseconds delay, Function<void()>&& cb) {
+  SetFiberDetachedTimer(std::chrono::steady_clock::now() + delay, std::move(cb));
+}
+
+std::uint64_t SubmitRpcBatchPeriodicalTask(std::chrono::microseconds interval, Function<void()>&& cb) {
+  auto interval_ms = std::max<std::uint64_t>(1, (interval.count() + 999) / 1000);
+  return PeripheryTaskScheduler::GetInstance()->SubmitInnerPeriodicalTask(std::move(cb), interval_ms,
+                                                                          "RpcBatchFlushTask");
+}
+
+void RemoveRpcBatchPeriodicalTask(std::uint64_t task_id) {
+  PeripheryTaskScheduler::GetInstance()->RemoveInnerTask(task_id);
+}
+
+bool IsRunningInFiberWorker() { return ::trpc::IsRunningInFiberWorker(); }
+
+std::string GetCurrentThreadModelName() {
+  WorkerThread* current = WorkerThread::GetCurrentWorkerThread();
+  return current != nullptr ? current->GetGroupName() : std::string();
+}
+
+bool SubmitRpcBatchHandleTask(const std::string& thread_model_name, Function<void()>&& cb) {
+  ThreadModel* thread_model = ThreadModelManager::GetInstance()->Get(thread_model_name);
+  if (thread_model == nullptr) {
+    return false;
+  }
+
+  MsgTask* task = object_pool::New<MsgTask>();
+  task->task_type = runtime::kParallelTask;
+  task->group_id = thread_model->GroupId();
+  task->handler = std::move(cb);
+  // The task is released by the thread model if it fails to be submitted.
+  return thread_model->SubmitHandleTask(task);
+}
+
+}  // namespace detail
+
+}  // namespace trpc
@@ -0,0 +1,267 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "trpc/tvar/compound_ops/latency_recorder.h"
+#include "trpc/util/function.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+/// @brief Default value of `RpcBatchOption::max_delay`.
+constexpr std::chrono::microseconds kDefaultRpcBatchMaxDelay{1000};
+
+/// @brief Options of server-side micro-batching.
+struct RpcBatchOption {
+  /// A batch is flushed once it holds `max_size` items, 0 or 1 disables the batching.
+  std::size_t max_size{0};
+
+  /// A batch is flushed once its first item has waited for `max_delay`, 0 means `kDefaultRpcBatchMaxDelay`.
+  std::chrono::microseconds max_delay{0};
+};
+
+/// @brief Statistics of the batches flushed, exposed by tvar under `/trpc/server/batch/{name}`:
+///        `batch_size` is the number of items of each batch, `wait_time_us` is how long the first item of each batch
+///        waited before the batch was flushed.
+class RpcBatchStats {
+ public:
+  /// @param name the name of the batcher(eg: method name), the statistics are not exposed if it's empty.
+  explicit RpcBatchStats(std::string_view name);
+
+  void Update(std::size_t batch_size, std::chrono::microseconds wait_time);
+
+  const tvar::LatencyRecorder& GetBatchSize() const { return *batch_size_; }
+
+  const tvar::LatencyRecorder& GetWaitTime() const { return *wait_time_us_; }
+
+ private:
+  std::unique_ptr<tvar::LatencyRecorder> batch_size_;
+  std::unique_ptr<tvar::LatencyRecorder> wait_time_us_;
+};
+
+namespace detail {
+
+/// @brief Runs `cb` in a fiber once `delay` elapsed, only used in fiber runtime.
+void SetRpcBatchFiberTimer(std::chrono::microseconds delay, Function<void()>&& cb);
+
+/// @brief Runs `cb` every `interval`(rounded up to milliseconds) by the periphery task scheduler.
+/// @return the task id, 0 on error.
+std::uint64_t SubmitRpcBatchPeriodicalTask(std::chrono::microseconds interval, Function<void()>&& cb);
+
+void RemoveRpcBatchPeriodicalTask(std::uint64_t task_id);
+
+/// @brief Gets the name of the thread model which the current thread belongs to, empty if it's not a worker thread.
+std::string GetCurrentThreadModelName();
+
+/// @brief Runs `cb` by a handle thread of the thread model named `thread_model_name`.
+/// @return false if the thread model does not exist or its task queue is full.
+bool SubmitRpcBatchHandleTask(const std::string& thread_model_name, Function<void()>&& cb);
+
+bool IsRunningInFiberWorker();
+
+}  // namespace detail
+
+/// @brief Accumulates items added concurrently and hands them over to the flush function in batches.
+/// @note  A full batch is flushed by the caller of `Add` who fills it up. An expired batch is flushed by a fiber timer
+///        in fiber runtime. In other thread models, a periodical task of the periphery task scheduler(with millisecond
+///        precision) finds the expired batch and hands it over to a handle thread of the thread model calling `Add`,
+///        so the flush function never runs on the periphery task scheduler.
+template <class T>
+class RpcBatcher {
+ public:
+  using FlushFunction = Function<void(std::vector<T>&&)>;
+
+  RpcBatcher(const RpcBatchOption& option, FlushFunction&& flush, std::string_view name = "")
+      : core_(std::make_shared<Core>(option, std::move(flush), name)) {}
+
+  ~RpcBatcher() {
+    if (core_->task_id != 0) {
+      detail::RemoveRpcBatchPeriodicalTask(core_->task_id);
+    }
+    // Nobody will flush the pending items anymore.
+    Flush();
+  }
+
+  RpcBatcher(const RpcBatcher&) = delete;
+  RpcBatcher& operator=(const RpcBatcher&) = delete;
+
+  /// @brief Add an item, the batch is flushed in place if it's full.
+  void Add(T&& item) {
+    std::vector<T> batch;
+    std::chrono::microseconds wait_time{0};
+    std::uint64_t seq = 0;
+    bool arm_timer = false;
+    {
+      std::scoped_lock _(core_->mutex);
+      auto now = std::chrono::microseconds(trpc::GetSteadyMicroSeconds());
+      if (core_->pending.empty()) {
+        core_->opened_at = now;
+        ++core_->seq;
+        arm_timer = true;
+      }
+      core_->pending.push_back(std::move(item));
+      if (core_->pending.size() >= core_->option.max_size) {
+        batch.swap(core_->pending);
+        wait_time = now - core_->opened_at;
+      }
+      seq = core_->seq;
+    }
+
+    if (!batch.empty()) {
+      core_->Run(std::move(batch), wait_time);
+    } else if (arm_timer) {
+      ArmTimer(seq);
+    }
+  }
+
+  /// @brief Flush the pending items at once.
+  void Flush() {
+    std::vector<T> batch;
+    std::chrono::microseconds wait_time{0};
+    {
+      std::scoped_lock _(core_->mutex);
+      batch.swap(core_->pending);
+      wait_time = std::chrono::microseconds(trpc::GetSteadyMicroSeconds()) - core_->opened_at;
+    }
+    if (!batch.empty()) {
+      core_->Run(std::move(batch), wait_time);
+    }
+  }
+
+  const RpcBatchOption& GetOption() const { return core_->option; }
+
+  const RpcBatchStats& GetStats() const { return core_->stats; }
+
+ private:
+  // Shared with the timers, which may fire after the batcher is destroyed.
+  struct Core {
+    Core(const RpcBatchOption& opt, FlushFunction&& func, std::string_view name)
+        : option(opt), flush(std::move(func)), stats(name) {
+      if (option.max_delay.count() <= 0) {
+        option.max_delay = kDefaultRpcBatchMaxDelay;
+      }
+    }
+
+    void Run(std::vector<T>&& batch, std::chrono::microseconds wait_time) {
+      stats.Update(batch.size(), wait_time);
+      flush(std::move(batch));
+    }
+
+    // Flush the batch numbered `expected_seq` if it's still pending, or any batch that has expired if `expected_seq`
+    // is 0.
+    void FlushExpired(std::uint64_t expected_seq) {
+      std::vector<T> batch;
+      std::chrono::microseconds wait_time{0};
+      {
+        std::scoped_lock _(mutex);
+        if (pending.empty()) {
+          return;
+        }
+        wait_time = std::chrono::microseconds(trpc::GetSteadyMicroSeconds()) - opened_at;
+        if (expected_seq != 0 ? expected_seq != seq : wait_time < option.max_delay) {
+          return;
+        }
+        batch.swap(pending);
+      }
+      Run(std::move(batch), wait_time);
+    }
+
+    RpcBatchOption option;
+    FlushFunction flush;
+    RpcBatchStats stats;
+
+    std::mutex mutex;
+    std::vector<T> pending;
+    std::chrono::microseconds opened_at{0};
+    // Sequence number of the pending batch, used to tell whether the batch a timer is armed for is flushed already.
+    std::uint64_t seq{0};
+
+    std::once_flag task_once;
+    std::uint64_t task_id{0};
+
+    // The thread model whose handle threads flush the expired batches, empty if `Add` is not called by a worker
+    // thread(then they are flushed by the periodical task).
+    std::string thread_model_name;
+    // Whether a flush of the expired batch has been handed over to the thread model and not run yet.
+    std::atomic<bool> flush_submitted{false};
+  };
+
+  void ArmTimer(std::uint64_t seq) {
+    std::weak_ptr<Core> weak_core = core_;
+    if (detail::IsRunningInFiberWorker()) {
+      detail::SetRpcBatchFiberTimer(core_->option.max_delay, [weak_core, seq] {
+        if (auto core = weak_core.lock()) {
+          core->FlushExpired(seq);
+        }
+      });
+      return;
+    }
+
+    std::call_once(core_->task_once, [this, weak_core] {
+      core_->thread_model_name = detail::GetCurrentThreadModelName();
+      core_->task_id = detail::SubmitRpcBatchPeriodicalTask(core_->option.max_delay, [weak_core] {
+        if (auto core = weak_core.lock()) {
+          HandOverExpired(core, weak_core);
+        }
+      });
+    });
+  }
+
+  // Runs by the periodical task, the expired batch is handed over to a handle thread rather than flushed in place.
+  static void HandOverExpired(const std::shared_ptr<Core>& core, const std::weak_ptr<Core>& weak_core) {
+    if (core->thread_model_name.empty()) {
+      core->FlushExpired(0);
+      return;
+    }
+
+    {
+      std::scoped_lock _(core->mutex);
+      if (core->pending.empty() ||
+          std::chrono::microseconds(trpc::GetSteadyMicroSeconds()) - core->opened_at < core->option.max_delay) {
+        return;
+      }
+    }
+    if (core->flush_submitted.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+
+    bool submitted = detail::SubmitRpcBatchHandleTask(core->thread_model_name, [weak_core] {
+      if (auto core = weak_core.lock()) {
+        core->flush_submitted.store(false, std::memory_order_release);
+        core->FlushExpired(0);
+      }
+    });
+    if (!submitted) {
+      // Retried by the next round of the periodical task.
+      core->flush_submitted.store(false, std::memory_order_release);
+    }
+  }
+
+ private:
+  std::shared_ptr<Core> core_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,126 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/server/rpc/rpc_batcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_latch.h"
+#include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/runtime/common/periphery_task_scheduler.h"
+
+namespace trpc::testing {
+
+class RpcBatcherTest : public ::testing::Test {
+ protected:
+  RpcBatcher<int>::FlushFunction Collect() {
+    return [this](std::vector<int>&& batch) {
+      std::scoped_lock _(mutex_);
+      batches_.push_back(std::move(batch));
+    };
+  }
+
+  std::size_t BatchCount() {
+    std::scoped_lock _(mutex_);
+    return batches_.size();
+  }
+
+  std::mutex mutex_;
+  std::vector<std::vector<int>> batches_;
+};
+
+TEST_F(RpcBatcherTest, FlushFullBatch) {
+  RpcBatcher<int> batcher(RpcBatchOption{.max_size = 3, .max_delay = std::chrono::seconds(10)}, Collect());
+  batcher.Add(1);
+  batcher.Add(2);
+  ASSERT_EQ(0, BatchCount());
+  // The third item fills the batch up.
+  batcher.Add(3);
+  ASSERT_EQ(1, BatchCount());
+  ASSERT_EQ((std::vector<int>{1, 2, 3}), batches_[0]);
+
+  batcher.Add(4);
+  batcher.Flush();
+  ASSERT_EQ(2, BatchCount());
+  ASSERT_EQ((std::vector<int>{4}), batches_[1]);
+
+  ASSERT_EQ(2, batcher.GetStats().GetBatchSize().Count());
+  ASSERT_EQ(3, batcher.GetStats().GetBatchSize().MaxLatency());
+}
+
+TEST_F(RpcBatcherTest, BatchingDisabled) {
+  RpcBatcher<int> batcher(RpcBatchOption{}, Collect());
+  ASSERT_EQ(kDefaultRpcBatchMaxDelay, batcher.GetOption().max_delay);
+  batcher.Add(1);
+  batcher.Add(2);
+  ASSERT_EQ(2, BatchCount());
+}
+
+TEST_F(RpcBatcherTest, FlushPendingOnDestruction) {
+  {
+    RpcBatcher<int> batcher(RpcBatchOption{.max_size = 10, .max_delay = std::chrono::seconds(10)}, Collect());
+    batcher.Add(1);
+  }
+  ASSERT_EQ(1, BatchCount());
+}
+
+TEST_F(RpcBatcherTest, FlushExpiredBatchInFiber) {
+  RunAsFiber([this] {
+    RpcBatcher<int> batcher(RpcBatchOption{.max_size = 100, .max_delay = std::chrono::milliseconds(10)}, Collect());
+
+    FiberLatch latch(10);
+    for (int i = 0; i < 10; ++i) {
+      StartFiberDetached([&batcher, &latch, i] {
+        batcher.Add(int{i});
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+    ASSERT_EQ(0, BatchCount());
+
+    while (BatchCount() == 0) {
+      FiberSleepFor(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(1, BatchCount());
+    ASSERT_EQ(10, batches_[0].size());
+    ASSERT_GE(batcher.GetStats().GetWaitTime().MaxLatency(), 10000);
+  });
+}
+
+TEST_F(RpcBatcherTest, FlushExpiredBatchInThread) {
+  PeripheryTaskScheduler::GetInstance()->Init();
+  PeripheryTaskScheduler::GetInstance()->Start();
+
+  {
+    RpcBatcher<int> batcher(RpcBatchOption{.max_size = 100, .max_delay = std::chrono::milliseconds(10)}, Collect());
+    batcher.Add(1);
+    batcher.Add(2);
+
+    while (BatchCount() == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ((std::vector<int>{1, 2}), batches_[0]);
+  }
+
+  PeripheryTaskScheduler::GetInstance()->Stop();
+  PeripheryTaskScheduler::GetInstance()->Join();
+}
+
+}  // namespace trpc::testing
@@ -225,23 +225,27 @@ void ServerContext::HandleEncodeErrorResponse(std::string&& err_msg) {
   SendUnaryResponse(encode_error);
 }
 
-void ServerContext::SetRealTimeout() {
-  bool use_fulllink = false;
-  if (invoke_info_.timeout != UINT32_MAX) {
-    use_fulllink = true;
-  }
+uint32_t ServerContext::GetRealTimeout(bool* use_fulllink) const {
+  uint32_t timeout = invoke_info_.timeout;
+  *use_fulllink = timeout != UINT32_MAX;
 
   if (service_) {
     auto& option = service_->GetServiceAdapterOption();
     if (!option.disable_request_timeout) {
-      use_fulllink = use_fulllink && (invoke_info_.timeout <= option.timeout);
-      invoke_info_.timeout = std::min(option.timeout, invoke_info_.timeout);
+      *use_fulllink = *use_fulllink && (timeout <= option.timeout);
+      timeout = std::min(option.timeout, timeout);
     } else {
-      invoke_info_.timeout = option.timeout;
-      use_fulllink = false;
+      timeout = option.timeout;
+      *use_fulllink = false;
     }
   }
 
+  return timeout;
+}
+
+void ServerContext::SetRealTimeout() {
+  bool use_fulllink = false;
+  invoke_info_.timeout = GetRealTimeout(&use_fulllink);
   SetStateFlag(use_fulllink, kIsUseFulllinkTimeoutMask);
 }
 
@@ -33,6 +33,7 @@
 #include "trpc/common/status.h"
 #include "trpc/compressor/compressor_type.h"
 #include "trpc/filter/server_filter_controller.h"
+#include "trpc/runtime/common/stats/resource_usage.h"
 #include "trpc/serialization/serialization_type.h"
 #include "trpc/server/method_handler.h"
 #include "trpc/stream/stream_provider.h"
@@ -98,6 +99,17 @@ class ServerContext : public RefCounted<ServerContext> {
   /// @note  time accuracy is 100us level.
   uint64_t GetSendTimestampUs() const { return metrics_info_.send_timestamp_us; }
 
+  /// @brief Framework use or for testing. Set the resources used by the handling of the current request.
+  void SetResourceUsage(const ResourceUsage& usage) { metrics_info_.resource_usage = usage; }
+
+  /// @brief Get the resources(cpu time, allocated bytes, wait time) used by the dispatching of the current request to
+  ///        its method handler, including the request body deserialization, the user handler and the response body
+  ///        serialization done by the method handler.
+  /// @note  Only recorded when `resource_accounting` of the service is enabled, all zero otherwise. The protocol
+  ///        decoding before the dispatching and the work done after the handler returns (eg: the response packet
+  ///        encoding and sending) are not included.
+  const ResourceUsage& GetResourceUsage() const { return metrics_info_.resource_usage; }
+
   /// @brief Get the time when a request is received, in milliseconds.
   /// @note For the purpose of measuring the elapsed time of the main framework process.
   inline uint64_t GetRecvTimestamp() const { return GetRecvTimestampUs() / 1000; }
@@ -303,6 +315,12 @@ class ServerContext : public RefCounted<ServerContext> {
   /// @private
   void SetRealTimeout();
 
+  /// @brief Framework use or for testing. Get the actual timeout time of the current request as `SetRealTimeout`
+  ///        does, without changing the context.
+  /// @param[out] use_fulllink whether the actual timeout is the full link timeout
+  /// @private
+  uint32_t GetRealTimeout(bool* use_fulllink) const;
+
   /// @brief Get the call type of the current request.
   uint8_t GetCallType() const { return invoke_info_.rpc_call_type; }
 
@@ -719,6 +737,9 @@ class ServerContext : public RefCounted<ServerContext> {
 
     // the time(us) when the response data corresponding to the current request is sent
     uint64_t send_timestamp_us = 0;
+
+    // the resources used by the handling of the current request
+    ResourceUsage resource_usage;
   };
 
   struct alignas(8) ExtendInfo {
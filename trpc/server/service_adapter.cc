@@ -14,6 +14,7 @@
 #include "trpc/server/service_adapter.h"
 
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <memory>
 #include <optional>
@@ -117,6 +118,19 @@ bool ServiceAdapter::Initialize() {
     return false;
   }
 
+  if (thread_model_->Type() == kFiber) {
+    static std::atomic<uint32_t> next_flow_id{1};
+    flow_id_ = next_flow_id.fetch_add(1, std::memory_order_relaxed);
+
+    auto* group = tvar::TrpcVarGroup::FindOrCreate("/trpc/server/service/" + option_.service_name);
+    handler_time_us_ = std::make_unique<tvar::Counter<uint64_t>>(group, "handler_time_us");
+    handled_requests_ = std::make_unique<tvar::Counter<uint64_t>>(group, "handled_requests");
+  }
+
+  if (option_.capture_sample_rate > 0) {
+    capture_sampler_ = std::make_unique<capture::CaptureSampler>(option_.capture_sample_rate);
+  }
+
   return true;
 }
 
@@ -235,6 +249,11 @@ STransportReqMsg* ServiceAdapter::CreateSTransportReqMsg(const ConnectionPtr& co
   context->SetRequestMsg(server_codec_->CreateRequestObject());
   context->SetResponseMsg(server_codec_->CreateResponseObject());
 
+  if (capture_sampler_ && capture::TrafficCapture::GetInstance()->IsStarted() && capture_sampler_->Sample()) {
+    capture::TrafficCapture::GetInstance()->Capture(recv_timestamp_us, server_codec_->Name(), option_.service_name,
+                                                     msg);
+  }
+
   bool ret = server_codec_->ZeroCopyDecode(context, std::move(msg), context->GetRequestMsg());
   if (!ret) {
     TRPC_FMT_ERROR_EVERY_SECOND("request header decode failed, ip: {}, port: {}", context->GetIp(), context->GetPort());
@@ -316,6 +335,14 @@ bool ServiceAdapter::HandleMessage(const ConnectionPtr& conn, std::deque<std::an
     MsgTask* task = object_pool::New<MsgTask>();
     task->handler = std::move(msg_handler);
     task->group_id = thread_model_->GroupId();
+    // When shed by the queue policy of the thread model, the request is answered with an overload error at once.
+    task->overload_handler = [req_msg]() {
+      Status& status = req_msg->context->GetStatus();
+      if (status.OK()) {
+        status.SetFrameworkRetCode(TrpcRetCode::TRPC_SERVER_OVERLOAD_ERR);
+        status.SetErrorMessage("request shed by queue policy");
+      }
+    };
 
     Service* service = req_msg->context->GetService();
     HandleRequestDispatcherFunction& dispatcher = service->GetHandleRequestDispatcherFunction();
@@ -379,6 +406,10 @@ bool ServiceAdapter::HandleFiberMessage(const ConnectionPtr& conn, std::deque<st
       }
 
       context->SetEndTimestampUs(trpc::time::GetMicroSeconds());
+      if (handler_time_us_) {
+        handler_time_us_->Add(context->GetEndTimestampUs() - context->GetBeginTimestampUs());
+        handled_requests_->Increment();
+      }
 
       trpc::object_pool::Delete(req_msg);
 
@@ -399,6 +430,10 @@ bool ServiceAdapter::HandleFiberMessage(const ConnectionPtr& conn, std::deque<st
     MsgTask* task = object_pool::New<MsgTask>();
     task->handler = std::move(msg_handler);
     task->group_id = thread_model_->GroupId();
+    task->flow_id = flow_id_;
+    task->flow_weight = option_.fair_queuing_weight;
+
+    SetHandleTaskDeadline(req_msg, recv_timestamp_us, task);
 
     Service* service = req_msg->context->GetService();
     HandleRequestDispatcherFunction& dispatcher = service->GetHandleRequestDispatcherFunction();
@@ -426,6 +461,35 @@ bool ServiceAdapter::HandleFiberMessage(const ConnectionPtr& conn, std::deque<st
   return true;
 }
 
+void ServiceAdapter::SetHandleTaskDeadline(STransportReqMsg* req_msg, uint64_t recv_timestamp_us, MsgTask* task) {
+  // The deadline of the request orders the handler fibers when deadline-aware dispatch is enabled, the request
+  // is answered with a timeout error at once if its deadline has passed before it's dispatched. It's derived from
+  // the actual timeout(see `ServerContext::SetRealTimeout`), which is applied to the context when dispatched.
+  bool use_fulllink = false;
+  uint32_t timeout = req_msg->context->GetRealTimeout(&use_fulllink);
+  if (timeout == UINT32_MAX) {
+    return;
+  }
+
+  task->deadline_us = recv_timestamp_us + static_cast<uint64_t>(timeout) * 1000;
+  task->overload_handler = [req_msg, use_fulllink]() {
+    auto& context = req_msg->context;
+    Status& status = context->GetStatus();
+    if (!status.OK()) {
+      return;
+    }
+    if (use_fulllink) {
+      status.SetFrameworkRetCode(
+          context->GetServerCodec()->GetProtocolRetCode(trpc::codec::ServerRetCode::FULL_LINK_TIMEOUT_ERROR));
+      status.SetErrorMessage("request full-link timeout before dispatch.");
+    } else {
+      status.SetFrameworkRetCode(
+          context->GetServerCodec()->GetProtocolRetCode(trpc::codec::ServerRetCode::TIMEOUT_ERROR));
+      status.SetErrorMessage("request timeout before dispatch.");
+    }
+  };
+}
+
 void ServiceAdapter::SetSSLConfigToBindInfo(trpc::BindInfo& bind_info) {
   // Set SSL/TLS context and options for server.
 #ifdef TRPC_BUILD_INCLUDE_SSL
@@ -463,7 +527,11 @@ void ServiceAdapter::FillBindInfo(trpc::BindInfo& bind_info) {
   bind_info.recv_buffer_size = option_.recv_buffer_size;
   bind_info.send_queue_capacity = option_.send_queue_capacity;
   bind_info.send_queue_timeout = option_.send_queue_timeout;
+  bind_info.write_buffer_budget = option_.write_buffer_budget;
+  bind_info.conn_egress_rate_limit = option_.conn_egress_rate_limit;
+  bind_info.egress_rate_limit = option_.egress_rate_limit;
   bind_info.accept_thread_num = option_.accept_thread_num;
+  bind_info.scheduling_groups = option_.fiber_scheduling_groups;
   bind_info.accept_function = service_->GetAcceptConnectionFunction();
   bind_info.dispatch_accept_function = service_->GetDispatchAcceptConnectionFunction();
   bind_info.conn_establish_function = service_->GetConnectionEstablishFunction();
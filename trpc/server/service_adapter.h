@@ -22,9 +22,12 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/capture/traffic_capture.h"
 #include "trpc/codec/server_codec.h"
+#include "trpc/runtime/threadmodel/common/msg_task.h"
 #include "trpc/server/service.h"
 #include "trpc/server/service_adapter_option.h"
+#include "trpc/tvar/basic_ops/reducer.h"
 
 namespace trpc {
 
@@ -87,6 +90,12 @@ class ServiceAdapter {
   ///         false: handle failed
   bool HandleFiberMessage(const ConnectionPtr& conn, std::deque<std::any>& msg);
 
+  /// @brief Framework use or for testing. Set the deadline of the handle task of the request from its actual timeout
+  ///        (see `ServerContext::SetRealTimeout`), the request is answered with a (full-link) timeout error if the
+  ///        task is shed when the deadline has passed.
+  /// @private
+  static void SetHandleTaskDeadline(STransportReqMsg* req_msg, uint64_t recv_timestamp_us, MsgTask* task);
+
   /// @brief set automatic listening to true
   ///        when TRpcServer starts, it will start listening services
   void SetAutoStart() { auto_start_ = true; }
@@ -137,6 +146,14 @@ class ServiceAdapter {
 
   // whether listening flag
   bool is_listened_{false};
+  // flow of the requests of the service in the fair queuing of fiber threadmodel
+  uint32_t flow_id_{0};
+  // the time(us) spent by the handler fibers of the service and the number of requests they handled, exposed by tvar
+  // under `/trpc/server/service/{service_name}`, only in fiber runtime
+  std::unique_ptr<tvar::Counter<uint64_t>> handler_time_us_;
+  std::unique_ptr<tvar::Counter<uint64_t>> handled_requests_;
+  // samples the requests to capture, only when `capture_sample_rate` is set
+  std::unique_ptr<capture::CaptureSampler> capture_sampler_;
 };
 
 using ServiceAdapterPtr = std::shared_ptr<ServiceAdapter>;
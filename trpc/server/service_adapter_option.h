@@ -86,9 +86,35 @@ struct ServiceAdapterOption {
   /// Use in fiber runtime
   uint32_t send_queue_timeout{3000};
 
+  /// The memory budget(bytes) of the io-send queues of all the connections
+  /// Use in fiber runtime, if set 0, not limited
+  uint64_t write_buffer_budget{0};
+
+  /// The egress bandwidth limit(bytes per second) of each connection
+  /// Use in fiber runtime(tcp), if set 0, not limited
+  uint64_t conn_egress_rate_limit{0};
+
+  /// The egress bandwidth limit(bytes per second) shared by all the connections
+  /// Use in fiber runtime(tcp), if set 0, not limited
+  uint64_t egress_rate_limit{0};
+
   /// The number of threads(fibers) listening on the port
   uint32_t accept_thread_num{1};
 
+  /// The scheduling groups(indexes) the connections of the service are dispatched to
+  /// Use in fiber runtime, if empty, all the scheduling groups
+  std::vector<uint32_t> fiber_scheduling_groups;
+
+  /// The weight of the service when the services share the handler fibers by fair queuing
+  /// Use in fiber runtime
+  uint32_t fair_queuing_weight{1};
+
+  /// Captures one out of every `capture_sample_rate` requests, 0 means not captured
+  uint32_t capture_sample_rate{0};
+
+  /// Whether to account the resources(cpu time, allocated bytes, wait time) used by each request
+  bool resource_accounting{false};
+
   /// The thread model type use by service, deprecated.
   std::string threadmodel_type;
 
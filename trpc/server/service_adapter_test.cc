@@ -0,0 +1,135 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/server/service_adapter.h"
+
+#include <memory>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/codec_manager.h"
+#include "trpc/codec/trpc/testing/trpc_protocol_testing.h"
+#include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/proto/testing/helloworld.pb.h"
+#include "trpc/serialization/trpc_serialization.h"
+#include "trpc/server/testing/server_context_testing.h"
+#include "trpc/server/testing/service_adapter_testing.h"
+
+namespace trpc::testing {
+
+namespace {
+
+class EmptyService : public Service {
+ public:
+  void HandleTransportMessage(STransportReqMsg* recv, STransportRspMsg** send) noexcept override {}
+};
+
+struct TaskDeadline {
+  uint64_t deadline_us = 0;
+  // Status of the request after the task is shed.
+  Status status;
+  int timeout_ret = 0;
+  int full_link_timeout_ret = 0;
+};
+
+// Sets the deadline of the task of a request(client timeout `client_timeout` ms) to the service.
+TaskDeadline SetDeadline(ServiceAdapterOption&& option, uint32_t client_timeout, uint64_t recv_timestamp_us) {
+  TaskDeadline result;
+  RunAsFiber([&] {
+    auto service = std::make_shared<EmptyService>();
+    auto adapter = std::make_unique<ServiceAdapter>(std::move(option));
+    FillServiceAdapter(adapter.get(), "trpc.test.helloworld.Greeter", service);
+
+    DummyTrpcProtocol req_data;
+    req_data.timeout = client_timeout;
+    trpc::test::helloworld::HelloRequest hello_req;
+    NoncontiguousBuffer req_bin_data;
+    ASSERT_TRUE(PackTrpcRequest(req_data, static_cast<void*>(&hello_req), req_bin_data));
+
+    STransportReqMsg req_msg;
+    req_msg.context = MakeTestServerContext("trpc", service.get(), std::move(req_bin_data));
+    ASSERT_TRUE(req_msg.context->GetStatus().OK());
+
+    MsgTask task;
+    ServiceAdapter::SetHandleTaskDeadline(&req_msg, recv_timestamp_us, &task);
+    // The actual timeout is applied to the context when the request is dispatched.
+    ASSERT_EQ(client_timeout, req_msg.context->GetTimeout());
+
+    result.deadline_us = task.deadline_us;
+    if (task.overload_handler) {
+      task.overload_handler();
+    }
+    result.status = req_msg.context->GetStatus();
+    result.timeout_ret =
+        req_msg.context->GetServerCodec()->GetProtocolRetCode(codec::ServerRetCode::TIMEOUT_ERROR);
+    result.full_link_timeout_ret =
+        req_msg.context->GetServerCodec()->GetProtocolRetCode(codec::ServerRetCode::FULL_LINK_TIMEOUT_ERROR);
+  });
+  return result;
+}
+
+}  // namespace
+
+class ServiceAdapterTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    codec::Init();
+    serialization::Init();
+  }
+
+  static void TearDownTestCase() {
+    codec::Destroy();
+    serialization::Destroy();
+  }
+};
+
+TEST_F(ServiceAdapterTest, HandleTaskDeadlineOfFullLinkTimeout) {
+  ServiceAdapterOption option = CreateServiceAdapterOption();
+  option.timeout = 2000;
+  TaskDeadline result = SetDeadline(std::move(option), 1000, 1000000);
+
+  ASSERT_EQ(1000000 + 1000 * 1000, result.deadline_us);
+  ASSERT_EQ(result.full_link_timeout_ret, result.status.GetFrameworkRetCode());
+}
+
+TEST_F(ServiceAdapterTest, HandleTaskDeadlineOfServiceTimeout) {
+  ServiceAdapterOption option = CreateServiceAdapterOption();
+  option.timeout = 500;
+  TaskDeadline result = SetDeadline(std::move(option), 1000, 1000000);
+
+  ASSERT_EQ(1000000 + 500 * 1000, result.deadline_us);
+  ASSERT_EQ(result.timeout_ret, result.status.GetFrameworkRetCode());
+}
+
+TEST_F(ServiceAdapterTest, HandleTaskDeadlineOfDisableRequestTimeout) {
+  ServiceAdapterOption option = CreateServiceAdapterOption();
+  option.timeout = 2000;
+  option.disable_request_timeout = true;
+  TaskDeadline result = SetDeadline(std::move(option), 1000, 1000000);
+
+  // The timeout of the client is ignored.
+  ASSERT_EQ(1000000 + 2000 * 1000, result.deadline_us);
+  ASSERT_EQ(result.timeout_ret, result.status.GetFrameworkRetCode());
+
+  option = CreateServiceAdapterOption();
+  option.timeout = UINT32_MAX;
+  option.disable_request_timeout = true;
+  result = SetDeadline(std::move(option), 1000, 1000000);
+
+  // No deadline, the task is never shed by the deadline.
+  ASSERT_EQ(0, result.deadline_us);
+  ASSERT_TRUE(result.status.OK());
+}
+
+}  // namespace trpc::testing
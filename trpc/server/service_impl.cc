@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "trpc/codec/codec_helper.h"
+#include "trpc/runtime/common/stats/resource_usage_stats.h"
 #include "trpc/server/server_context.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/time.h"
@@ -74,8 +75,19 @@ void ServiceImpl::HandleTransportMessage(STransportReqMsg* recv, STransportRspMs
     return;
   }
 
+  bool resource_accounting = GetServiceAdapterOption().resource_accounting;
+  ResourceUsageRecorder resource_usage_recorder;
+  if (resource_accounting) {
+    resource_usage_recorder.Start();
+  }
+
   Dispatch(context, context->GetRequestMsg(), context->GetResponseMsg());
 
+  if (resource_accounting) {
+    context->SetResourceUsage(resource_usage_recorder.Stop());
+    ResourceUsageStats::GetInstance()->Update(context->GetFuncName(), context->GetResourceUsage());
+  }
+
   // the request of one-way call does not return a packet
   if (context->GetCallType() == kOnewayCall) {
     filter_controller.RunMessageServerFilters(FilterPoint::SERVER_PRE_SEND_MSG, context);
@@ -17,6 +17,7 @@
 #include <chrono>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -29,11 +30,34 @@
 #include "trpc/util/chrono/time.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/string/string_util.h"
+#include "trpc/util/string/string_helper.h"
 
 using namespace std::literals;
 
 namespace trpc {
 
+namespace {
+
+// An input example of '0,2-3' will be converted to a list of [0, 2, 3].
+bool ParseSchedulingGroups(const std::string& conf, std::vector<uint32_t>& groups) {
+  for (auto&& e : Split(conf, ",")) {
+    auto range = Split(e, "-");
+    std::optional<uint32_t> start = range.empty() ? std::nullopt : TryParse<uint32_t>(Trim(range[0]));
+    std::optional<uint32_t> end = range.size() == 2 ? TryParse<uint32_t>(Trim(range[1])) : start;
+    if (range.size() > 2 || !start || !end || *start > *end) {
+      return false;
+    }
+    for (uint32_t i = *start; i <= *end; ++i) {
+      groups.push_back(i);
+    }
+  }
+  std::sort(groups.begin(), groups.end());
+  groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+  return !groups.empty();
+}
+
+}  // namespace
+
 TrpcServer::TrpcServer(const ServerConfig& server_config) : terminate_(false), server_config_(server_config) {}
 
 bool TrpcServer::Initialize() {
@@ -70,7 +94,19 @@ void TrpcServer::BuildServiceAdapterOption(const ServiceConfig& config, ServiceA
   option.recv_buffer_size = config.recv_buffer_size;
   option.send_queue_capacity = config.send_queue_capacity;
   option.send_queue_timeout = config.send_queue_timeout;
+  option.write_buffer_budget = config.write_buffer_budget;
+  option.conn_egress_rate_limit = config.conn_egress_rate_limit;
+  option.egress_rate_limit = config.egress_rate_limit;
   option.accept_thread_num = config.accept_thread_num;
+  if (!config.fiber_scheduling_groups.empty() &&
+      !ParseSchedulingGroups(config.fiber_scheduling_groups, option.fiber_scheduling_groups)) {
+    TRPC_FMT_ERROR("service {} has invalid fiber_scheduling_groups: {}, all scheduling groups are used.",
+                   config.service_name, config.fiber_scheduling_groups);
+    option.fiber_scheduling_groups.clear();
+  }
+  option.fair_queuing_weight = config.fair_queuing_weight;
+  option.capture_sample_rate = config.capture_sample_rate;
+  option.resource_accounting = config.resource_accounting;
   option.threadmodel_type = config.threadmodel_type;
   option.threadmodel_instance_name = config.threadmodel_instance_name;
   option.stream_read_timeout = config.stream_read_timeout;
@@ -13,10 +13,14 @@
 
 #include "trpc/stream/grpc/grpc_client_stream_connection_handler.h"
 
+#include <algorithm>
+#include <string>
+
 #include "trpc/codec/client_codec_factory.h"
 #include "trpc/codec/grpc/grpc_protocol.h"
 #include "trpc/coroutine/fiber.h"
 #include "trpc/stream/client_stream_handler_factory.h"
+#include "trpc/stream/grpc/grpc_client_stream_handler.h"
 #include "trpc/stream/grpc/util.h"
 
 namespace trpc::stream {
@@ -28,6 +32,9 @@ StreamHandlerPtr CreateAndInitStreamHandler(Connection* conn, bool fiber_mode) {
   options.fiber_mode = fiber_mode;
   options.connection_id = conn->GetConnId();
   StreamHandlerPtr stream_handler = ClientStreamHandlerFactory::GetInstance()->Create("grpc", std::move(options));
+  if (auto grpc_stream_handler = dynamic_cast<GrpcClientStreamHandler*>(stream_handler.Get())) {
+    grpc_stream_handler->ExposeSessionMetrics(conn->GetPeerIp() + ":" + std::to_string(conn->GetPeerPort()));
+  }
   return stream_handler;
 }
 
@@ -126,6 +133,22 @@ bool FiberGrpcClientStreamConnectionHandler::EncodeStreamMessage(IoMessage* mess
   return EncodeStreamMessageHelper(stream_handler_, message);
 }
 
+int FiberGrpcClientStreamConnectionHandler::GetLoad() {
+  // A DATA frame of the default max frame size can not be sent with a smaller window.
+  constexpr int32_t kStalledWindowSize = 16384;
+
+  auto grpc_stream_handler = dynamic_cast<GrpcClientStreamHandler*>(stream_handler_.Get());
+  if (!grpc_stream_handler) {
+    return -1;
+  }
+
+  auto metrics = grpc_stream_handler->GetSessionMetrics();
+  if (metrics.remote_window_size < kStalledWindowSize || metrics.max_concurrent_streams == 0) {
+    return 100;
+  }
+  return std::min<uint64_t>(100, metrics.active_streams * 100ULL / metrics.max_concurrent_streams);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -48,6 +48,9 @@ class FiberGrpcClientStreamConnectionHandler : public FiberClientStreamConnectio
   // @brief Whether to send the encoded stream messages at the network layer.
   bool NeedSendStreamMessage() override { return false; }
   int DoHandshake() override;
+  // @brief The load is the percent of the active streams to the max concurrent streams of the peer, it's 100 if the
+  // connection-level flow control window is stalled.
+  int GetLoad() override;
 
  private:
   /// Used to distinguish between streaming and non-streaming packets in mixed packet scenarios.
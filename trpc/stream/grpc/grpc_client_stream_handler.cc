@@ -14,6 +14,7 @@
 #include "trpc/stream/grpc/grpc_client_stream_handler.h"
 
 #include <mutex>
+#include <string>
 
 #include "trpc/client/client_context.h"
 #include "trpc/codec/grpc/grpc_protocol.h"
@@ -51,6 +52,8 @@ bool GrpcClientStreamHandler::Init() {
     out_.emplace_back(std::move(response));
   });
 
+  UpdateSessionMetrics();
+
   return true;
 }
 
@@ -60,6 +63,7 @@ int GrpcClientStreamHandler::ParseMessage(NoncontiguousBuffer* in, std::deque<st
     return -1;
   }
   out->swap(out_);
+  UpdateSessionMetrics();
   return 0;
 }
 
@@ -76,9 +80,42 @@ int GrpcClientStreamHandler::EncodeHttp2Request(const http2::RequestPtr& request
     return signal_ok;
   }
   unary_stream_ids_.insert(request->GetStreamId());
+  UpdateSessionMetrics();
   return 0;
 }
 
+GrpcClientStreamHandler::SessionMetrics GrpcClientStreamHandler::GetSessionMetrics() const {
+  SessionMetrics metrics;
+  metrics.active_streams = active_streams_.load(std::memory_order_relaxed);
+  metrics.max_concurrent_streams = max_concurrent_streams_.load(std::memory_order_relaxed);
+  metrics.remote_window_size = remote_window_size_.load(std::memory_order_relaxed);
+  return metrics;
+}
+
+void GrpcClientStreamHandler::ExposeSessionMetrics(std::string_view name) {
+  static std::atomic<uint64_t> session_id_gen{0};
+
+  std::string leaf(name);
+  leaf += '_';
+  leaf += std::to_string(session_id_gen.fetch_add(1, std::memory_order_relaxed));
+
+  active_streams_tvar_ = std::make_unique<tvar::PassiveStatus<uint32_t>>(
+      tvar::TrpcVarGroup::FindOrCreate("/trpc/client/grpc_session/active_streams"), leaf,
+      [this] { return active_streams_.load(std::memory_order_relaxed); });
+  max_concurrent_streams_tvar_ = std::make_unique<tvar::PassiveStatus<uint32_t>>(
+      tvar::TrpcVarGroup::FindOrCreate("/trpc/client/grpc_session/max_concurrent_streams"), leaf,
+      [this] { return max_concurrent_streams_.load(std::memory_order_relaxed); });
+  remote_window_size_tvar_ = std::make_unique<tvar::PassiveStatus<int32_t>>(
+      tvar::TrpcVarGroup::FindOrCreate("/trpc/client/grpc_session/remote_window_size"), leaf,
+      [this] { return remote_window_size_.load(std::memory_order_relaxed); });
+}
+
+void GrpcClientStreamHandler::UpdateSessionMetrics() {
+  active_streams_.store(session_->GetActiveStreamCount(), std::memory_order_relaxed);
+  max_concurrent_streams_.store(session_->GetRemoteMaxConcurrentStreams(), std::memory_order_relaxed);
+  remote_window_size_.store(session_->GetRemoteWindowSize(), std::memory_order_relaxed);
+}
+
 namespace {
 http2::RequestPtr GetHttp2Request(const std::any& msg) {
   http2::RequestPtr http2_request{nullptr};
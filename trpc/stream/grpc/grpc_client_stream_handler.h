@@ -14,20 +14,33 @@
 #pragma once
 
 #include <any>
+#include <atomic>
 #include <deque>
 #include <memory>
+#include <string_view>
 #include <utility>
 
 #include "trpc/codec/grpc/http2/request.h"
 #include "trpc/codec/grpc/http2/session.h"
 #include "trpc/coroutine/fiber_mutex.h"
 #include "trpc/stream/stream_handler.h"
+#include "trpc/tvar/basic_ops/passive_status.h"
 
 namespace trpc::stream {
 
 /// @brief The implementation of tRPC client stream handler.
 class GrpcClientStreamHandler : public StreamHandler {
  public:
+  // @brief Snapshot of the HTTP/2 session state, it's used to balance the calls between the connections.
+  struct SessionMetrics {
+    // Number of the streams which are not closed yet.
+    uint32_t active_streams{0};
+    // SETTINGS_MAX_CONCURRENT_STREAMS of the peer.
+    uint32_t max_concurrent_streams{0};
+    // Available window size for connection-level flow control of sending.
+    int32_t remote_window_size{0};
+  };
+
   explicit GrpcClientStreamHandler(StreamOptions&& options);
   ~GrpcClientStreamHandler() override = default;
 
@@ -50,12 +63,23 @@ class GrpcClientStreamHandler : public StreamHandler {
   void SetSession(std::unique_ptr<http2::Session>&& session) { session_ = std::move(session); }
   http2::Session* GetSession() { return session_.get(); }
 
+  // @brief Gets the metrics of the session, it can be called by any thread.
+  SessionMetrics GetSessionMetrics() const;
+
+  // @brief Exposes the metrics of the session by tvar, as `/trpc/client/grpc_session/{metric}/{name}_{session id}`,
+  // the tvars are removed with the stream handler.
+  // @param name the name of the session, eg: the address of the peer.
+  void ExposeSessionMetrics(std::string_view name);
+
  protected:
   // @brief Submit the HTTP/2 request `request` and write the sendable data to `buffer`.
   int EncodeHttp2Request(const http2::RequestPtr& request, NoncontiguousBuffer* buffer);
 
   virtual int GetNetworkErrorCode() { return -1; }
 
+  // @brief Publishes the metrics of the session after it's changed.
+  void UpdateSessionMetrics();
+
  protected:
   StreamOptions options_;
 
@@ -71,6 +95,16 @@ class GrpcClientStreamHandler : public StreamHandler {
   // Save the variables of the checked package in the session callback. In CheckMessage, the checked package will be
   // swapped.
   std::deque<std::any> out_;
+
+  // Metrics published by `UpdateSessionMetrics`, so that they can be read without holding the session.
+  std::atomic<uint32_t> active_streams_{0};
+  std::atomic<uint32_t> max_concurrent_streams_{0};
+  std::atomic<int32_t> remote_window_size_{0};
+
+  // Tvars reading the metrics above, so they're declared after the metrics to be destroyed first.
+  std::unique_ptr<tvar::PassiveStatus<uint32_t>> active_streams_tvar_;
+  std::unique_ptr<tvar::PassiveStatus<uint32_t>> max_concurrent_streams_tvar_;
+  std::unique_ptr<tvar::PassiveStatus<int32_t>> remote_window_size_tvar_;
 };
 
 /// @brief gRPC client stream protocol handler in separate/merge thread mode, currently mainly handling Unary RPC and
@@ -13,6 +13,9 @@
 
 #include "trpc/stream/grpc/grpc_client_stream_handler.h"
 
+#include <optional>
+#include <string>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -23,6 +26,7 @@
 #include "trpc/codec/grpc/http2/testing/mock_session.h"
 #include "trpc/coroutine/fiber_latch.h"
 #include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/tvar/common/tvar_group.h"
 
 namespace trpc::testing {
 
@@ -147,6 +151,50 @@ TEST_F(GrpcClientStreamHandlerTest, DefaultEncodeTransportMessageFailedDueToSign
   ASSERT_EQ(-1, default_stream_handler_->EncodeTransportMessage(&request_msg));
 }
 
+TEST_F(GrpcClientStreamHandlerTest, SessionMetrics) {
+  ASSERT_TRUE(default_stream_handler_->Init());
+
+  // The peer's SETTINGS is not received yet, the defaults of HTTP/2 are used.
+  auto metrics = default_stream_handler_->GetSessionMetrics();
+  ASSERT_EQ(0, metrics.active_streams);
+  ASSERT_EQ(0xffffffff, metrics.max_concurrent_streams);
+  ASSERT_EQ(65535, metrics.remote_window_size);
+
+  IoMessage request_msg = CreateTransportMessage(grpc_unary_request_);
+  ASSERT_EQ(0, default_stream_handler_->EncodeTransportMessage(&request_msg));
+  ASSERT_EQ(1, default_stream_handler_->GetSessionMetrics().active_streams);
+}
+
+TEST_F(GrpcClientStreamHandlerTest, ExposeSessionMetrics) {
+  // Gets the value of the tvar of the metric exposed for the session of the peer.
+  auto get_metric = [](const std::string& metric) -> std::optional<Json::Value> {
+    auto metrics = tvar::TrpcVarGroup::TryGet("/trpc/client/grpc_session/" + metric);
+    if (!metrics) {
+      return std::nullopt;
+    }
+    for (const auto& name : metrics->getMemberNames()) {
+      if (name.rfind("127.0.0.1:10001_", 0) == 0) {
+        return (*metrics)[name];
+      }
+    }
+    return std::nullopt;
+  };
+
+  ASSERT_TRUE(default_stream_handler_->Init());
+  default_stream_handler_->ExposeSessionMetrics("127.0.0.1:10001");
+  ASSERT_EQ(0, get_metric("active_streams")->asUInt());
+  ASSERT_EQ(0xffffffff, get_metric("max_concurrent_streams")->asUInt());
+  ASSERT_EQ(65535, get_metric("remote_window_size")->asInt());
+
+  IoMessage request_msg = CreateTransportMessage(grpc_unary_request_);
+  ASSERT_EQ(0, default_stream_handler_->EncodeTransportMessage(&request_msg));
+  ASSERT_EQ(1, get_metric("active_streams")->asUInt());
+
+  // Removed with the stream handler.
+  default_stream_handler_ = nullptr;
+  ASSERT_FALSE(get_metric("active_streams"));
+}
+
 TEST_F(GrpcClientStreamHandlerTest, FiberEncodeTransportMessageOk) {
   RunAsFiber([&]() {
     IoMessage request_msg = CreateTransportMessage(grpc_unary_request_);
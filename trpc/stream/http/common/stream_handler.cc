@@ -90,6 +90,7 @@ int HttpCommonStreamHandler::ParseMessageImpl(NoncontiguousBuffer* in, std::dequ
       is_chunked_ = frame->GetMutableMetaData()->is_chunk;
       has_trailer_ = frame->GetMutableMetaData()->has_trailer;
       expect_bytes_ = frame->GetMutableMetaData()->content_length;
+      chunked_decoder_.Reset();
       in->Skip(parse_bytes);
       out->push_back(static_pointer_cast<HttpStreamFrame>(frame));
       // Parsing needs to continue for both chunked mode and non-chunked mode with Content-Length not greater than zero.
@@ -109,22 +110,22 @@ int HttpCommonStreamHandler::ParseMessageImpl(NoncontiguousBuffer* in, std::dequ
     case ParseState::kAfterParseHeader: {
       // parses data
       if (is_chunked_) {
-        while (true) {
-          auto frame = MakeRefCounted<HttpStreamData>();
-          int parse_bytes = ParseHttpChunk(in, frame->GetMutableData());
-          if (parse_bytes > 0) {
-            if (!frame->GetMutableData()->Empty()) {  // there are more chunked blocks to be parsed
-              out->push_back(static_pointer_cast<HttpStreamFrame>(frame));
-              continue;
-            } else {  // reach the end
-              out->push_back(static_pointer_cast<HttpStreamFrame>(MakeRefCounted<HttpStreamEof>()));
-              parse_state_ = ParseState::kAfterParseData;
-              break;
-            }
-          } else {
-            return parse_bytes;
-          }
+        // The decoder keeps its state across reads, so a chunk split over several reads is neither re-scanned nor
+        // held back: the data received so far is pushed at once.
+        auto frame = MakeRefCounted<HttpStreamData>();
+        int ret = chunked_decoder_.Decode(in, frame->GetMutableData());
+        if (ret == kParseHttpError) {
+          return ret;
+        }
+        if (!frame->GetMutableData()->Empty()) {
+          out->push_back(static_pointer_cast<HttpStreamFrame>(frame));
+        }
+        if (ret == kParseHttpNeedMore) {
+          return ret;
         }
+        // reach the end
+        out->push_back(static_pointer_cast<HttpStreamFrame>(MakeRefCounted<HttpStreamEof>()));
+        parse_state_ = ParseState::kAfterParseData;
       } else {
         if (expect_bytes_ == 0) {
           // push eof frame
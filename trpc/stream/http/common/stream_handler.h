@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "trpc/codec/http/http_stream_parser.h"
 #include "trpc/stream/http/common/stream.h"
 #include "trpc/stream/stream_handler.h"
 
@@ -80,6 +81,8 @@ class HttpCommonStreamHandler : public StreamHandler {
   size_t expect_bytes_{0};
   /// @brief The flag indicating whether has trailer
   bool has_trailer_{false};
+  /// @brief The decoder of the chunked body, it stops before the trailer which is parsed in kAfterParseData
+  HttpChunkedDecoder chunked_decoder_{true};
 
   /// @brief The flag indicating whether pass the idle state successfully
   bool pass_state_idle_{false};
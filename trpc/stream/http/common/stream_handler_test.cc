@@ -126,7 +126,7 @@ TEST_F(HttpCommonStreamHandlerTest, TestParseHttpChunkWithDataOk) {
   std::deque<std::any> out;
   NoncontiguousBuffer buf = BuildBuffer("Transfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n7\r\n stream\r\n0\r\n\r\n");
   ASSERT_EQ(mock_stream_handler_->ParseMessage(&buf, &out), 0);
-  ASSERT_EQ(out.size(), 4);
+  ASSERT_EQ(out.size(), 3);
   ParseDequeOut(out);
   ASSERT_TRUE(out.empty());
   ASSERT_EQ(header_->GetMutableHeader()->Get("Transfer-Encoding"), "chunked");
@@ -157,7 +157,7 @@ TEST_F(HttpCommonStreamHandlerTest, ParseHttpChunkWithTrailerOk) {
   NoncontiguousBuffer buf =
       BuildBuffer("Transfer-Encoding: chunked\r\nTrailer: t1\r\n\r\n5\r\nhello\r\n7\r\n stream\r\n0\r\nt1: v1\r\n\r\n");
   ASSERT_EQ(mock_stream_handler_->ParseMessage(&buf, &out), 0);
-  ASSERT_EQ(out.size(), 5);
+  ASSERT_EQ(out.size(), 4);
   ParseDequeOut(out);
   ASSERT_TRUE(out.empty());
   ASSERT_EQ(header_->GetMutableHeader()->Get("Transfer-Encoding"), "chunked");
@@ -188,13 +188,52 @@ TEST_F(HttpCommonStreamHandlerTest, ParseHttpChunkDataInCompleteAndError) {
   out.pop_front();
   ASSERT_TRUE(out.empty());
 
+  // The partial chunk data is pushed as soon as it arrives.
   buf = BuildBuffer("5\r\nhe");
   ASSERT_EQ(mock_stream_handler_->ParseMessage(&buf, &out), -2);
-  ASSERT_EQ(out.size(), 0);
+  ASSERT_EQ(out.size(), 1);
+  out.pop_front();
 
   buf = BuildBuffer("zz\rh");
   ASSERT_EQ(out.size(), 0);
   ASSERT_EQ(mock_stream_handler_->ParseMessage(&buf, &out), -1);
 }
 
+TEST_F(HttpCommonStreamHandlerTest, ParseHttpChunkSplitAcrossReadsOk) {
+  std::string raw_data = "Transfer-Encoding: chunked\r\nTrailer: t1\r\n\r\n5\r\nhello\r\n7\r\n stream\r\n0\r\nt1: v1\r\n\r\n";
+  size_t body_begin = raw_data.find("\r\n\r\n") + 4;
+  for (size_t step = 1; step <= raw_data.size() - body_begin; ++step) {
+    SetUp();
+    data_.Clear();
+    eof_ = nullptr;
+    trailer_ = nullptr;
+
+    std::deque<std::any> out;
+    NoncontiguousBuffer in = BuildBuffer(raw_data.substr(0, body_begin));
+    ASSERT_EQ(mock_stream_handler_->ParseMessage(&in, &out), 0);
+    ASSERT_EQ(out.size(), 1);
+
+    // Every read carries `step` bytes of the body, so the chunk-size lines, the chunk data and the trailer are split
+    // at every possible position.
+    std::deque<std::any> all_out;
+    all_out.swap(out);
+    int ret = -2;
+    for (size_t pos = body_begin; pos < raw_data.size(); pos += step) {
+      in.Append(BuildBuffer(raw_data.substr(pos, step)));
+      ret = mock_stream_handler_->ParseMessage(&in, &out);
+      ASSERT_NE(ret, -1) << "step: " << step;
+      all_out.insert(all_out.end(), out.begin(), out.end());
+      out.clear();
+    }
+    ASSERT_EQ(ret, 0) << "step: " << step;
+    ASSERT_TRUE(in.Empty());
+
+    ParseDequeOut(all_out);
+    ASSERT_TRUE(all_out.empty());
+    ASSERT_EQ(FlattenSlow(data_), "hello stream") << "step: " << step;
+    ASSERT_TRUE(eof_ != nullptr);
+    ASSERT_EQ(trailer_->GetMutableHeader()->Get("t1"), "v1");
+  }
+}
+
 }  // namespace trpc::testing
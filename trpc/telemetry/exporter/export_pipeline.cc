@@ -0,0 +1,231 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/telemetry/exporter/export_pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "trpc/compressor/trpc_compressor.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+#include "trpc/util/time.h"
+
+namespace trpc::telemetry {
+
+namespace {
+
+std::atomic<uint32_t> next_pipeline_id{0};
+
+// The batcher drains the buffers at least so often, so that the buffers do not fill up between the flushes.
+constexpr uint32_t kMaxDrainIntervalMs = 10;
+
+}  // namespace
+
+ExportPipeline::ExportPipeline(ExportPipelineOptions options)
+    : options_(std::move(options)),
+      id_(next_pipeline_id.fetch_add(1, std::memory_order_relaxed)),
+      group_(tvar::TrpcVarGroup::FindOrCreate("/trpc/telemetry/exporter/" + options_.name)),
+      exported_(group_, "exported"),
+      dropped_(group_, "dropped"),
+      batches_(group_, "batches"),
+      failed_batches_(group_, "failed_batches") {
+  TRPC_ASSERT(options_.sink != nullptr);
+  TRPC_ASSERT(options_.buffer_capacity > 0 && options_.max_batch_records > 0);
+}
+
+ExportPipeline::~ExportPipeline() { Stop(); }
+
+bool ExportPipeline::Start() {
+  if (stopped_.load(std::memory_order_relaxed) || batcher_.joinable()) {
+    return false;
+  }
+  batcher_ = std::thread([this] { BatcherLoop(); });
+  return true;
+}
+
+void ExportPipeline::Stop() {
+  if (stopped_.exchange(true, std::memory_order_seq_cst)) {
+    return;
+  }
+
+  if (batcher_.joinable()) {
+    {
+      std::scoped_lock lock(mutex_);
+      notified_.store(true, std::memory_order_relaxed);
+    }
+    cv_.notify_one();
+    batcher_.join();
+  }
+
+  // The producers which have not seen `stopped_` may still be enqueueing, wait for them and export the records
+  // left in the buffers, so that no record is lost without being counted.
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    buffers = buffers_;
+  }
+  for (auto& buffer : buffers) {
+    while (buffer->exporting.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+  }
+  DrainBuffers();
+  if (batch_records_ > 0) {
+    FlushBatch();
+  }
+}
+
+bool ExportPipeline::Export(ExportRecord&& record) {
+  if (TRPC_UNLIKELY(record.data.size() > options_.max_record_size)) {
+    dropped_.Increment();
+    return false;
+  }
+
+  ThreadBuffer* buffer = GetThreadBuffer();
+  // Pairs with `Stop`: either `Stop` sees the flag and waits for the record to be enqueued before the final drain,
+  // or the record sees `stopped_` and is dropped.
+  buffer->exporting.store(true, std::memory_order_seq_cst);
+  if (TRPC_UNLIKELY(stopped_.load(std::memory_order_seq_cst))) {
+    buffer->exporting.store(false, std::memory_order_release);
+    dropped_.Increment();
+    return false;
+  }
+  bool enqueued = buffer->queue.Enqueue(std::move(record));
+  buffer->exporting.store(false, std::memory_order_release);
+  if (TRPC_UNLIKELY(!enqueued)) {
+    dropped_.Increment();
+    return false;
+  }
+
+  // Wake up the batcher when the buffer is half full rather than for every record, it drains the buffers
+  // periodically anyway.
+  if (TRPC_UNLIKELY(buffer->queue.Size() == (buffer->queue.Capacity() >> 1))) {
+    notified_.store(true, std::memory_order_relaxed);
+    cv_.notify_one();
+  }
+  return true;
+}
+
+std::vector<std::shared_ptr<ExportPipeline::ThreadBuffer>>& ExportPipeline::GetThreadBuffers() {
+  struct ThreadBuffers {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    ~ThreadBuffers() {
+      for (auto& buffer : buffers) {
+        if (buffer != nullptr) {
+          buffer->retired.store(true, std::memory_order_release);
+        }
+      }
+    }
+  };
+  thread_local ThreadBuffers thread_buffers;
+  return thread_buffers.buffers;
+}
+
+ExportPipeline::ThreadBuffer* ExportPipeline::GetThreadBuffer() {
+  auto& buffers = GetThreadBuffers();
+  if (TRPC_LIKELY(id_ < buffers.size() && buffers[id_] != nullptr)) {
+    return buffers[id_].get();
+  }
+  return CreateThreadBuffer();
+}
+
+ExportPipeline::ThreadBuffer* ExportPipeline::CreateThreadBuffer() {
+  auto buffer = std::make_shared<ThreadBuffer>();
+  buffer->queue.Init(options_.buffer_capacity);
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    buffers_.push_back(buffer);
+  }
+
+  auto& buffers = GetThreadBuffers();
+  if (buffers.size() <= id_) {
+    buffers.resize(id_ + 1);
+  }
+  buffers[id_] = std::move(buffer);
+  return buffers[id_].get();
+}
+
+void ExportPipeline::BatcherLoop() {
+  const auto drain_interval = std::chrono::milliseconds(std::min(options_.flush_interval_ms, kMaxDrainIntervalMs));
+  // The records left when stopped are exported by `Stop` after joining the batcher.
+  while (!stopped_.load(std::memory_order_acquire)) {
+    DrainBuffers();
+    if (batch_records_ > 0 && time::GetSteadyMilliSeconds() - batch_begin_ms_ >= options_.flush_interval_ms) {
+      FlushBatch();
+    }
+
+    std::unique_lock lock(mutex_);
+    cv_.wait_for(lock, drain_interval, [this] { return notified_.load(std::memory_order_relaxed); });
+    notified_.store(false, std::memory_order_relaxed);
+  }
+}
+
+void ExportPipeline::DrainBuffers() {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::scoped_lock lock(buffers_mutex_);
+    buffers = buffers_;
+  }
+
+  ExportRecord record;
+  for (auto& buffer : buffers) {
+    // Check before draining, the producer never writes the buffer after it is retired.
+    bool retired = buffer->retired.load(std::memory_order_acquire);
+    while (buffer->queue.Dequeue(&record)) {
+      AppendToBatch(std::move(record));
+    }
+    if (retired) {
+      std::scoped_lock lock(buffers_mutex_);
+      buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), buffer), buffers_.end());
+    }
+  }
+}
+
+void ExportPipeline::AppendToBatch(ExportRecord&& record) {
+  if (batch_records_ == 0) {
+    batch_begin_ms_ = time::GetSteadyMilliSeconds();
+  }
+  EncodeExportRecord(record, batch_builder_);
+  ++batch_records_;
+  batch_bytes_ += GetEncodedSize(record);
+
+  if (batch_records_ >= options_.max_batch_records || batch_bytes_ >= options_.max_batch_bytes) {
+    FlushBatch();
+  }
+}
+
+void ExportPipeline::FlushBatch() {
+  ExportBatch batch;
+  batch.record_count = batch_records_;
+  batch.data = batch_builder_.DestructiveGet();
+  batch_builder_ = NoncontiguousBufferBuilder();
+  batch_records_ = 0;
+  batch_bytes_ = 0;
+
+  if (compressor::CompressIfNeeded(options_.compress_type, batch.data)) {
+    batch.compress_type = options_.compress_type;
+  } else {
+    TRPC_FMT_WARN_EVERY_SECOND("compress telemetry batch failed, compress type: {}", options_.compress_type);
+  }
+
+  exported_.Add(batch.record_count);
+  batches_.Increment();
+  if (!options_.sink->Export(batch)) {
+    failed_batches_.Increment();
+  }
+}
+
+}  // namespace trpc::telemetry
@@ -0,0 +1,142 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trpc/compressor/compressor_type.h"
+#include "trpc/telemetry/exporter/export_record.h"
+#include "trpc/telemetry/exporter/export_sink.h"
+#include "trpc/tvar/basic_ops/reducer.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/queue/bounded_mpsc_queue.h"
+
+namespace trpc::telemetry {
+
+/// @brief Options of the export pipeline.
+struct ExportPipelineOptions {
+  /// Name of the pipeline, its counters are exposed by tvar under `/trpc/telemetry/exporter/{name}`
+  std::string name;
+
+  /// Destination of the records
+  ExportSinkPtr sink;
+
+  /// Capacity(records) of the buffer of each producer thread, records are dropped when the buffer is full
+  uint32_t buffer_capacity{4096};
+
+  /// Records larger than it are dropped
+  uint32_t max_record_size{64 * 1024};
+
+  /// A batch is exported once it has `max_batch_records` records or `max_batch_bytes` bytes(before compression), or
+  /// its first record has waited for `flush_interval_ms`
+  uint32_t max_batch_records{1024};
+  uint32_t max_batch_bytes{1024 * 1024};
+  uint32_t flush_interval_ms{1000};
+
+  /// Compression of the batches
+  compressor::CompressType compress_type{compressor::kNone};
+};
+
+/// @brief The pipeline exporting the telemetry records(spans, metrics, logs) produced on the request path to a sink
+///        asynchronously, so that the plugins do not batch, compress and send the data by themselves:
+///        1. `Export` moves the record into the lock-free buffer of the calling thread, it costs tens of nanoseconds
+///        and never blocks. Records are dropped when the buffer is full, so that the memory is bounded.
+///        2. A batcher thread drains the buffers, encodes the records into batches, and hands the batches to the sink
+///        after compression.
+///        The counters of the records/batches are exposed by tvar: `exported`, `dropped`, `batches`,
+///        `failed_batches`.
+class ExportPipeline {
+ public:
+  explicit ExportPipeline(ExportPipelineOptions options);
+
+  ~ExportPipeline();
+
+  /// @brief Start the batcher thread. Records exported before it are buffered.
+  bool Start();
+
+  /// @brief Stop the batcher thread after exporting the buffered records, the records exported after it are dropped.
+  void Stop();
+
+  /// @brief Export a record, it is safe to call from any thread/fiber.
+  /// @return false if the record is dropped
+  bool Export(ExportRecord&& record);
+
+  /// @brief Get the number of the records exported to the sink(including the ones in failed batches).
+  uint64_t GetExportedCount() const { return exported_.GetValue(); }
+
+  /// @brief Get the number of the records dropped.
+  uint64_t GetDroppedCount() const { return dropped_.GetValue(); }
+
+ private:
+  struct ThreadBuffer {
+    BoundedMPSCQueue<ExportRecord> queue;
+
+    // Set when the producer thread exits, the buffer is released after drained.
+    std::atomic<bool> retired{false};
+
+    // Set while the producer is enqueueing a record, `Stop` waits for it before the final drain.
+    std::atomic<bool> exporting{false};
+  };
+
+  // Buffers of the calling thread indexed by the pipeline id.
+  static std::vector<std::shared_ptr<ThreadBuffer>>& GetThreadBuffers();
+
+  ThreadBuffer* GetThreadBuffer();
+
+  ThreadBuffer* CreateThreadBuffer();
+
+  void BatcherLoop();
+
+  void DrainBuffers();
+
+  void AppendToBatch(ExportRecord&& record);
+
+  void FlushBatch();
+
+ private:
+  const ExportPipelineOptions options_;
+
+  const uint32_t id_;
+
+  std::atomic<bool> stopped_{false};
+
+  std::mutex buffers_mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<bool> notified_{false};
+  std::thread batcher_;
+
+  // The batch being built, only accessed by the batcher thread.
+  NoncontiguousBufferBuilder batch_builder_;
+  uint32_t batch_records_{0};
+  std::size_t batch_bytes_{0};
+  uint64_t batch_begin_ms_{0};
+
+  tvar::TrpcVarGroup* group_;
+  tvar::Counter<uint64_t> exported_;
+  tvar::Counter<uint64_t> dropped_;
+  tvar::Counter<uint64_t> batches_;
+  tvar::Counter<uint64_t> failed_batches_;
+};
+
+}  // namespace trpc::telemetry
@@ -0,0 +1,175 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/telemetry/exporter/export_pipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::telemetry::testing {
+
+namespace {
+
+class TestSink : public ExportSink {
+ public:
+  std::string Name() const override { return "test"; }
+
+  bool Export(const ExportBatch& batch) override {
+    std::vector<ExportRecord> records;
+    EXPECT_TRUE(DecodeExportBatch(batch, &records));
+    std::scoped_lock lock(mutex_);
+    batches_.push_back(std::move(records));
+    return true;
+  }
+
+  std::vector<std::vector<ExportRecord>> GetBatches() {
+    std::scoped_lock lock(mutex_);
+    return batches_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::vector<ExportRecord>> batches_;
+};
+
+ExportRecord MakeRecord(uint64_t timestamp_us) { return {ExportRecordType::kSpan, timestamp_us, "span"}; }
+
+}  // namespace
+
+TEST(ExportPipeline, FlushBySize) {
+  auto sink = MakeRefCounted<TestSink>();
+  ExportPipelineOptions options;
+  options.name = "FlushBySize";
+  options.sink = sink;
+  options.max_batch_records = 10;
+  ExportPipeline pipeline(options);
+  ASSERT_TRUE(pipeline.Start());
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 5; ++i) {
+    threads.emplace_back([&pipeline] {
+      for (int j = 0; j < 5; ++j) {
+        ASSERT_TRUE(pipeline.Export(MakeRecord(j)));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  pipeline.Stop();
+
+  auto batches = sink->GetBatches();
+  ASSERT_EQ(3, batches.size());
+  ASSERT_EQ(10, batches[0].size());
+  ASSERT_EQ(10, batches[1].size());
+  ASSERT_EQ(5, batches[2].size());
+  ASSERT_EQ(25, pipeline.GetExportedCount());
+  ASSERT_EQ(0, pipeline.GetDroppedCount());
+
+  // Dropped after stopped.
+  ASSERT_FALSE(pipeline.Export(MakeRecord(0)));
+  ASSERT_EQ(1, pipeline.GetDroppedCount());
+}
+
+TEST(ExportPipeline, FlushByTime) {
+  auto sink = MakeRefCounted<TestSink>();
+  ExportPipelineOptions options;
+  options.name = "FlushByTime";
+  options.sink = sink;
+  options.flush_interval_ms = 10;
+  ExportPipeline pipeline(options);
+  ASSERT_TRUE(pipeline.Start());
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(pipeline.Export(MakeRecord(i)));
+  }
+  for (int i = 0; i < 100 && sink->GetBatches().empty(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  auto batches = sink->GetBatches();
+  ASSERT_EQ(1, batches.size());
+  ASSERT_EQ(3, batches[0].size());
+  ASSERT_EQ(2, batches[0][2].timestamp_us);
+}
+
+TEST(ExportPipeline, BoundedMemory) {
+  auto sink = MakeRefCounted<TestSink>();
+  ExportPipelineOptions options;
+  options.name = "BoundedMemory";
+  options.sink = sink;
+  options.buffer_capacity = 4;
+  options.max_record_size = 8;
+  ExportPipeline pipeline(options);
+
+  // Records are buffered before the pipeline starts, until the buffer is full.
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(i < 4, pipeline.Export(MakeRecord(i)));
+  }
+  ASSERT_FALSE(pipeline.Export({ExportRecordType::kSpan, 0, std::string(9, 'x')}));
+  ASSERT_EQ(7, pipeline.GetDroppedCount());
+
+  ASSERT_TRUE(pipeline.Start());
+  pipeline.Stop();
+  auto batches = sink->GetBatches();
+  ASSERT_EQ(1, batches.size());
+  ASSERT_EQ(4, batches[0].size());
+}
+
+TEST(ExportPipeline, ExportDuringStop) {
+  auto sink = MakeRefCounted<TestSink>();
+  ExportPipelineOptions options;
+  options.name = "ExportDuringStop";
+  options.sink = sink;
+  options.buffer_capacity = 1024 * 1024;
+  ExportPipeline pipeline(options);
+  ASSERT_TRUE(pipeline.Start());
+
+  std::atomic<uint64_t> succeeded{0};
+  std::atomic<bool> stopped{false};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      // Keep exporting until some records are dropped after the pipeline is stopped.
+      while (true) {
+        bool dropped_after_stop = stopped.load();
+        if (pipeline.Export(MakeRecord(0))) {
+          succeeded.fetch_add(1);
+        } else if (dropped_after_stop) {
+          break;
+        }
+      }
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  pipeline.Stop();
+  stopped.store(true);
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // Every record accepted is exported, none is left in the buffers.
+  uint64_t records = 0;
+  for (auto& batch : sink->GetBatches()) {
+    records += batch.size();
+  }
+  ASSERT_EQ(succeeded.load(), records);
+  ASSERT_EQ(succeeded.load(), pipeline.GetExportedCount());
+}
+
+}  // namespace trpc::telemetry::testing
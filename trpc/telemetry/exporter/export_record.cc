@@ -0,0 +1,61 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/telemetry/exporter/export_record.h"
+
+#include <cstring>
+
+#include "trpc/compressor/trpc_compressor.h"
+
+namespace trpc::telemetry {
+
+void EncodeExportRecord(const ExportRecord& record, NoncontiguousBufferBuilder& builder) {
+  char header[kExportRecordHeaderSize];
+  header[0] = static_cast<char>(record.type);
+  uint32_t size = static_cast<uint32_t>(record.data.size());
+  memcpy(header + 1, &record.timestamp_us, sizeof(record.timestamp_us));
+  memcpy(header + 9, &size, sizeof(size));
+  builder.Append(header, sizeof(header));
+  builder.Append(record.data.data(), record.data.size());
+}
+
+bool DecodeExportBatch(const ExportBatch& batch, std::vector<ExportRecord>* records) {
+  NoncontiguousBuffer data = batch.data;
+  if (!compressor::DecompressIfNeeded(batch.compress_type, data)) {
+    return false;
+  }
+
+  std::string flatten = FlattenSlow(data);
+  std::size_t pos = 0;
+  records->reserve(records->size() + batch.record_count);
+  for (uint32_t i = 0; i < batch.record_count; ++i) {
+    if (flatten.size() - pos < kExportRecordHeaderSize) {
+      return false;
+    }
+    ExportRecord record;
+    uint32_t size = 0;
+    record.type = static_cast<ExportRecordType>(flatten[pos]);
+    memcpy(&record.timestamp_us, flatten.data() + pos + 1, sizeof(record.timestamp_us));
+    memcpy(&size, flatten.data() + pos + 9, sizeof(size));
+    pos += kExportRecordHeaderSize;
+    if (flatten.size() - pos < size) {
+      return false;
+    }
+    record.data.assign(flatten, pos, size);
+    pos += size;
+    records->push_back(std::move(record));
+  }
+  return pos == flatten.size();
+}
+
+}  // namespace trpc::telemetry
@@ -0,0 +1,65 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "trpc/compressor/compressor_type.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::telemetry {
+
+/// @brief Type of the telemetry records.
+enum class ExportRecordType : uint8_t {
+  kSpan = 1,
+  kMetric = 2,
+  kLog = 3,
+};
+
+/// @brief A telemetry record to export, its data is encoded by the producer(eg: a serialized span).
+struct ExportRecord {
+  ExportRecordType type{ExportRecordType::kSpan};
+
+  /// time(us) when the record is produced
+  uint64_t timestamp_us{0};
+
+  std::string data;
+};
+
+/// @brief A batch of records handed to the sink. The records are encoded one after another in host byte order:
+///        type(1 byte) + timestamp_us(8 bytes) + data size(4 bytes) + data, then compressed by `compress_type`.
+struct ExportBatch {
+  uint32_t record_count{0};
+
+  compressor::CompressType compress_type{compressor::kNone};
+
+  NoncontiguousBuffer data;
+};
+
+/// @brief Size of the header(type + timestamp_us + data size) of an encoded record.
+constexpr std::size_t kExportRecordHeaderSize = 13;
+
+/// @brief Size of the record in an uncompressed batch.
+inline std::size_t GetEncodedSize(const ExportRecord& record) { return kExportRecordHeaderSize + record.data.size(); }
+
+/// @brief Append the record to an uncompressed batch.
+void EncodeExportRecord(const ExportRecord& record, NoncontiguousBufferBuilder& builder);
+
+/// @brief Decompress the batch and decode the records in it, used by the sinks which need the records.
+/// @return false if the batch is corrupted
+bool DecodeExportBatch(const ExportBatch& batch, std::vector<ExportRecord>* records);
+
+}  // namespace trpc::telemetry
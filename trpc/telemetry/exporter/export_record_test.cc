@@ -0,0 +1,77 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/telemetry/exporter/export_record.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/compressor/compressor_factory.h"
+#include "trpc/compressor/gzip/gzip_compressor.h"
+#include "trpc/compressor/trpc_compressor.h"
+
+namespace trpc::telemetry::testing {
+
+namespace {
+
+ExportBatch MakeBatch(const std::vector<ExportRecord>& records) {
+  NoncontiguousBufferBuilder builder;
+  for (const auto& record : records) {
+    EncodeExportRecord(record, builder);
+  }
+  ExportBatch batch;
+  batch.record_count = records.size();
+  batch.data = builder.DestructiveGet();
+  return batch;
+}
+
+}  // namespace
+
+TEST(ExportRecord, EncodeAndDecode) {
+  std::vector<ExportRecord> records = {{ExportRecordType::kSpan, 1, "span"},
+                                       {ExportRecordType::kMetric, 2, ""},
+                                       {ExportRecordType::kLog, 3, std::string(1000, 'x')}};
+  ExportBatch batch = MakeBatch(records);
+  ASSERT_EQ(3 * kExportRecordHeaderSize + 1004, batch.data.ByteSize());
+
+  std::vector<ExportRecord> decoded;
+  ASSERT_TRUE(DecodeExportBatch(batch, &decoded));
+  ASSERT_EQ(3, decoded.size());
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    ASSERT_EQ(records[i].type, decoded[i].type);
+    ASSERT_EQ(records[i].timestamp_us, decoded[i].timestamp_us);
+    ASSERT_EQ(records[i].data, decoded[i].data);
+  }
+
+  // Corrupted batch.
+  batch.record_count = 4;
+  ASSERT_FALSE(DecodeExportBatch(batch, &decoded));
+}
+
+TEST(ExportRecord, DecodeCompressed) {
+  ASSERT_TRUE(compressor::CompressorFactory::GetInstance()->Register(MakeRefCounted<compressor::GzipCompressor>()));
+
+  ExportBatch batch = MakeBatch({{ExportRecordType::kSpan, 1, std::string(100, 'x')}});
+  ASSERT_TRUE(compressor::CompressIfNeeded(compressor::kGzip, batch.data));
+  batch.compress_type = compressor::kGzip;
+
+  std::vector<ExportRecord> decoded;
+  ASSERT_TRUE(DecodeExportBatch(batch, &decoded));
+  ASSERT_EQ(1, decoded.size());
+  ASSERT_EQ(std::string(100, 'x'), decoded[0].data);
+
+  compressor::CompressorFactory::GetInstance()->Clear();
+}
+
+}  // namespace trpc::telemetry::testing
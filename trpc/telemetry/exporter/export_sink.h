@@ -0,0 +1,40 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <string>
+
+#include "trpc/telemetry/exporter/export_record.h"
+#include "trpc/util/ref_ptr.h"
+
+namespace trpc::telemetry {
+
+/// @brief The interface of the destination of the export pipeline(eg: a collector, a local file).
+class ExportSink : public RefCounted<ExportSink> {
+ public:
+  virtual ~ExportSink() = default;
+
+  /// @brief Name of the sink.
+  virtual std::string Name() const = 0;
+
+  /// @brief Export a batch of records.
+  /// @return true on success
+  /// @note It is only called by the batcher thread of the pipeline, so that it can block without affecting the
+  ///       requests, but a slow sink makes the records dropped once the buffers are full.
+  virtual bool Export(const ExportBatch& batch) = 0;
+};
+
+using ExportSinkPtr = RefPtr<ExportSink>;
+
+}  // namespace trpc::telemetry
@@ -0,0 +1,98 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/telemetry/exporter/file_export_sink.h"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::telemetry {
+
+namespace {
+
+constexpr uint32_t kBatchMagic = 0x54455850;  // "PXET"
+
+struct BatchHeader {
+  uint32_t magic;
+  uint32_t record_count;
+  uint32_t data_size;
+  uint8_t compress_type;
+} __attribute__((packed));
+
+}  // namespace
+
+FileExportSink::FileExportSink(std::string path) : path_(std::move(path)) {
+  file_ = fopen(path_.c_str(), "ab");
+  if (file_ == nullptr) {
+    TRPC_FMT_ERROR("open export file {} failed: {}", path_, strerror(errno));
+  }
+}
+
+FileExportSink::~FileExportSink() {
+  if (file_ != nullptr) {
+    fclose(file_);
+  }
+}
+
+bool FileExportSink::Export(const ExportBatch& batch) {
+  if (file_ == nullptr) {
+    return false;
+  }
+
+  BatchHeader header{kBatchMagic, batch.record_count, static_cast<uint32_t>(batch.data.ByteSize()),
+                     batch.compress_type};
+  if (fwrite(&header, sizeof(header), 1, file_) != 1) {
+    return false;
+  }
+  for (const auto& block : batch.data) {
+    if (fwrite(block.data(), 1, block.size(), file_) != block.size()) {
+      return false;
+    }
+  }
+  return fflush(file_) == 0;
+}
+
+bool FileExportSink::ReadFile(const std::string& path, std::vector<ExportBatch>* batches) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  bool ok = true;
+  BatchHeader header;
+  while (fread(&header, sizeof(header), 1, file) == 1) {
+    if (header.magic != kBatchMagic) {
+      ok = false;
+      break;
+    }
+    std::string data(header.data_size, '\0');
+    if (fread(data.data(), 1, data.size(), file) != data.size()) {
+      ok = false;
+      break;
+    }
+    ExportBatch batch;
+    batch.record_count = header.record_count;
+    batch.compress_type = header.compress_type;
+    NoncontiguousBufferBuilder builder;
+    builder.Append(data);
+    batch.data = builder.DestructiveGet();
+    batches->push_back(std::move(batch));
+  }
+  fclose(file);
+  return ok;
+}
+
+}  // namespace trpc::telemetry
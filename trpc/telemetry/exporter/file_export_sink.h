@@ -0,0 +1,45 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "trpc/telemetry/exporter/export_sink.h"
+
+namespace trpc::telemetry {
+
+/// @brief The sink appending the batches to a local file, mainly for testing and offline analysis. Each batch is
+///        written as a header(magic, record count, compress type, data size) followed by the batch data.
+class FileExportSink : public ExportSink {
+ public:
+  explicit FileExportSink(std::string path);
+
+  ~FileExportSink() override;
+
+  std::string Name() const override { return "file"; }
+
+  bool Export(const ExportBatch& batch) override;
+
+  /// @brief Read the batches written by the sink.
+  /// @return false if the file can not be read or is corrupted
+  static bool ReadFile(const std::string& path, std::vector<ExportBatch>* batches);
+
+ private:
+  std::string path_;
+  FILE* file_{nullptr};
+};
+
+}  // namespace trpc::telemetry
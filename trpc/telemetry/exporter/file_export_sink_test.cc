@@ -0,0 +1,57 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/telemetry/exporter/file_export_sink.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::telemetry::testing {
+
+TEST(FileExportSink, ExportAndRead) {
+  std::string path = "file_export_sink_test.bin";
+  unlink(path.c_str());
+
+  {
+    auto sink = MakeRefCounted<FileExportSink>(path);
+    ASSERT_EQ("file", sink->Name());
+    for (int i = 0; i < 2; ++i) {
+      NoncontiguousBufferBuilder builder;
+      EncodeExportRecord({ExportRecordType::kSpan, static_cast<uint64_t>(i), "span"}, builder);
+      ExportBatch batch;
+      batch.record_count = 1;
+      batch.data = builder.DestructiveGet();
+      ASSERT_TRUE(sink->Export(batch));
+    }
+  }
+
+  std::vector<ExportBatch> batches;
+  ASSERT_TRUE(FileExportSink::ReadFile(path, &batches));
+  ASSERT_EQ(2, batches.size());
+  for (int i = 0; i < 2; ++i) {
+    std::vector<ExportRecord> records;
+    ASSERT_TRUE(DecodeExportBatch(batches[i], &records));
+    ASSERT_EQ(1, records.size());
+    ASSERT_EQ(i, records[0].timestamp_us);
+    ASSERT_EQ("span", records[0].data);
+  }
+
+  ASSERT_FALSE(FileExportSink::ReadFile("not_exist_file.bin", &batches));
+  unlink(path.c_str());
+}
+
+}  // namespace trpc::telemetry::testing
@@ -22,6 +22,8 @@
 #include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/io/zero_copy_stream.h"
 
+#include "trpc/tools/comm/trpc_cpp_options.pb.h"
+
 namespace trpc::tools {
 
 const char* kDeclaration =
@@ -267,6 +269,26 @@ bool ContainStreamMethod(const google::protobuf::FileDescriptor* file) {
   return false;
 }
 
+bool IsBatchMethod(const google::protobuf::MethodDescriptor* method) {
+  if (method->client_streaming() || method->server_streaming()) {
+    return false;
+  }
+  return method->options().GetExtension(trpc::cpp_ext).batch_max_size() > 1;
+}
+
+bool ContainBatchMethod(const google::protobuf::FileDescriptor* file) {
+  for (int i = 0; i < file->service_count(); ++i) {
+    auto service = file->service(i);
+    for (int j = 0; j < service->method_count(); j++) {
+      if (IsBatchMethod(service->method(j))) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 bool CheckProtoFileValid(const google::protobuf::FileDescriptor* file, std::string* error) {
   bool ok = true;
   if (file == nullptr) {
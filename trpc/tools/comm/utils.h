@@ -55,6 +55,11 @@ void WriteToFile(google::protobuf::compiler::GeneratorContext* context, const st
 
 bool ContainStreamMethod(const google::protobuf::FileDescriptor* file);
 
+// Whether the unary method is micro-batched on the server side, see `CppExt.batch_max_size`.
+bool IsBatchMethod(const google::protobuf::MethodDescriptor* method);
+
+bool ContainBatchMethod(const google::protobuf::FileDescriptor* file);
+
 bool CheckProtoFileValid(const google::protobuf::FileDescriptor* file, std::string* error);
 
 }  // namespace trpc::tools
@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+#
+#
+# Tencent is pleased to support the open source community by making tRPC available.
+#
+# Copyright (C) 2023 THL A29 Limited, a Tencent company.
+# All rights reserved.
+#
+# If you have downloaded a copy of the tRPC source code from Tencent,
+# please note that tRPC source code is licensed under the  Apache 2.0 License,
+# A copy of the Apache 2.0 License is included in this file.
+#
+#
+"""Attribute perf samples to fibers.
+
+The fiber runtime publishes the stacks of the fibers and their entry functions
+to the fiber stack registry file (`fiber_stack_registry_path` in the fiber
+thread model config), @sa: `trpc/runtime/threadmodel/fiber/detail/fiber_stack_registry.h`.
+
+Usage:
+
+1. Dump the records of the registry:
+   `fiber_perf.py dump /path/to/registry.<pid> [--binary /path/to/prog]`
+
+2. Record with the same clock as the registry and with the user stack pointer:
+   `perf record -k CLOCK_MONOTONIC --user-regs=sp -g -p <pid>`
+
+3. Stitch the samples to the fibers, the output is in folded format, which can
+   be fed to `flamegraph.pl`:
+   `perf script --ns -F comm,tid,time,ip,sym,uregs | \
+        fiber_perf.py stitch /path/to/registry.<pid> --binary /path/to/prog`
+"""
+from __future__ import print_function
+
+import argparse
+import bisect
+import collections
+import re
+import struct
+import subprocess
+import sys
+
+MAGIC = b'TRPCFSR\0'
+HEADER_FORMAT = '<8s6IQQ16s'
+RECORD_FORMAT = '<8Q'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+Header = collections.namedtuple('Header', [
+    'version', 'header_size', 'record_size', 'live_capacity',
+    'history_capacity', 'pid', 'image_base', 'history_next'
+])
+
+Record = collections.namedtuple(
+    'Record',
+    ['fiber_id', 'stack_low', 'stack_high', 'entry', 'start_ns', 'end_ns'])
+
+
+def read_registry(path):
+    """Returns: (`Header`, live `Record`s, history `Record`s).
+
+    The registry may be updated while it is read, the records being written
+    (odd sequence) are skipped.
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) < HEADER_SIZE:
+        raise ValueError('%s is too small to be a fiber stack registry' % path)
+    fields = struct.unpack_from(HEADER_FORMAT, data)
+    if fields[0] != MAGIC:
+        raise ValueError('%s is not a fiber stack registry' % path)
+    header = Header(*fields[1:9])
+    if header.record_size != RECORD_SIZE:
+        raise ValueError('unsupported record size %d' % header.record_size)
+
+    def read_records(offset, count):
+        records = []
+        for i in range(count):
+            pos = offset + i * RECORD_SIZE
+            if pos + RECORD_SIZE > len(data):
+                break
+            sequence, fiber_id, low, high, entry, start, end, _ = \
+                struct.unpack_from(RECORD_FORMAT, data, pos)
+            if sequence % 2 != 0 or fiber_id == 0:
+                continue
+            records.append(Record(fiber_id, low, high, entry, start, end))
+        return records
+
+    live = read_records(header.header_size, header.live_capacity)
+    history = read_records(
+        header.header_size + header.live_capacity * RECORD_SIZE,
+        min(header.history_capacity, header.history_next))
+    return header, live, history
+
+
+def symbolize(binary, image_base, addresses):
+    """Returns: dict of address -> function name, resolved by `addr2line`."""
+    addresses = sorted(set(addresses))
+    names = {addr: '0x%x' % addr for addr in addresses}
+    if not binary or not addresses:
+        return names
+    try:
+        output = subprocess.check_output(
+            ['addr2line', '-f', '-C', '-e', binary] +
+            ['0x%x' % (addr - image_base) for addr in addresses],
+            universal_newlines=True)
+    except (OSError, subprocess.CalledProcessError) as e:
+        print('addr2line failed: %s' % e, file=sys.stderr)
+        return names
+    lines = output.split('\n')
+    for i, addr in enumerate(addresses):
+        if 2 * i < len(lines) and lines[2 * i] != '??':
+            names[addr] = lines[2 * i]
+    return names
+
+
+class FiberIndex(object):
+    """Finds the fiber a stack pointer belongs to at a given time.
+
+    Fiber stacks are reused, so a stack range maps to several fibers over time.
+    """
+
+    def __init__(self, records):
+        by_range = collections.defaultdict(list)
+        for record in records:
+            by_range[(record.stack_low, record.stack_high)].append(record)
+        self._ranges = sorted(by_range)
+        self._lows = [low for low, _ in self._ranges]
+        self._records = [
+            sorted(by_range[r], key=lambda x: x.start_ns) for r in self._ranges
+        ]
+
+    def find(self, sp, time_ns):
+        """Returns: the `Record` of the fiber, or None if `sp` is not on a
+        fiber stack. If `time_ns` is None, the most recent fiber is returned.
+        """
+        i = bisect.bisect_right(self._lows, sp) - 1
+        if i < 0 or sp >= self._ranges[i][1]:
+            return None
+        candidates = self._records[i]
+        if time_ns is None:
+            return candidates[-1]
+        for record in reversed(candidates):
+            if record.start_ns <= time_ns and (record.end_ns == 0 or
+                                               time_ns < record.end_ns):
+                return record
+        return None
+
+
+SAMPLE_HEADER = re.compile(r'^\S*.*?\s(\d+)\s+(\d+)\.(\d+):')
+STACK_POINTER = re.compile(r'\bsp:0x([0-9a-fA-F]+)')
+FRAME = re.compile(r'^\s+[0-9a-fA-F]+\s+(.*?)(\s+\(.*\))?$')
+
+
+def parse_perf_script(lines):
+    """Parses the output of `perf script --ns -F comm,tid,time,ip,sym,uregs`.
+
+    Yields: (comm, tid, time_ns, sp, frames), frames are outermost first.
+    """
+    sample = None
+    for line in lines:
+        line = line.rstrip('\n')
+        if not line.strip():
+            continue
+        m = SAMPLE_HEADER.match(line)
+        if m and not line.startswith('\t'):
+            if sample:
+                yield sample[0], sample[1], sample[2], sample[3], \
+                    list(reversed(sample[4]))
+            comm = line.split()[0]
+            time_ns = int(m.group(2)) * 1000000000 + int(
+                m.group(3).ljust(9, '0')[:9])
+            sample = [comm, int(m.group(1)), time_ns, None, []]
+            line = line[m.end():]
+        if sample is None:
+            continue
+        sp = STACK_POINTER.search(line)
+        if sp:
+            sample[3] = int(sp.group(1), 16)
+            continue
+        frame = FRAME.match(line)
+        if frame:
+            sample[4].append(frame.group(1).split('+0x')[0] or '[unknown]')
+    if sample:
+        yield sample[0], sample[1], sample[2], sample[3], \
+            list(reversed(sample[4]))
+
+
+def dump(args):
+    header, live, history = read_registry(args.registry)
+    names = symbolize(args.binary, header.image_base,
+                      [r.entry for r in live + history])
+    print('pid %d, version %d, image base 0x%x, %d live, %d exited' %
+          (header.pid, header.version, header.image_base, len(live),
+           header.history_next))
+    print('%-12s %-18s %-18s %-20s %-20s %s' %
+          ('fiber', 'stack_low', 'stack_high', 'start_ns', 'end_ns', 'entry'))
+    records = live + (history if args.history else [])
+    for r in sorted(records, key=lambda x: x.start_ns):
+        print('%-12d 0x%-16x 0x%-16x %-20d %-20s %s' %
+              (r.fiber_id, r.stack_low, r.stack_high, r.start_ns,
+               r.end_ns or '-', names[r.entry]))
+
+
+def stitch(args):
+    header, live, history = read_registry(args.registry)
+    names = symbolize(args.binary, header.image_base,
+                      [r.entry for r in live + history])
+    index = FiberIndex(live + history)
+
+    folded = collections.Counter()
+    total = attributed = 0
+    for comm, _, time_ns, sp, frames in parse_perf_script(args.input):
+        total += 1
+        record = None
+        if sp is not None:
+            record = index.find(sp, None if args.ignore_time else time_ns)
+        if record is None:
+            root = comm
+        else:
+            attributed += 1
+            root = 'fiber:' + names[record.entry]
+            if args.per_fiber:
+                root += '#%d' % record.fiber_id
+        folded[';'.join([root] + frames)] += 1
+
+    for stack, count in folded.most_common():
+        print('%s %d' % (stack, count))
+    print('%d of %d samples are attributed to fibers.' % (attributed, total),
+          file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    subparsers = parser.add_subparsers(dest='command')
+    subparsers.required = True
+
+    dump_parser = subparsers.add_parser('dump', help='dump the registry')
+    dump_parser.add_argument('registry', help='path of the registry file')
+    dump_parser.add_argument('--binary', help='binary to symbolize entries')
+    dump_parser.add_argument('--history',
+                             action='store_true',
+                             help='dump the exited fibers as well')
+    dump_parser.set_defaults(func=dump)
+
+    stitch_parser = subparsers.add_parser(
+        'stitch', help='attribute `perf script` samples to fibers')
+    stitch_parser.add_argument('registry', help='path of the registry file')
+    stitch_parser.add_argument('--binary', help='binary to symbolize entries')
+    stitch_parser.add_argument('--input',
+                               type=argparse.FileType('r'),
+                               default=sys.stdin,
+                               help='output of `perf script`, stdin if absent')
+    stitch_parser.add_argument('--per-fiber',
+                               action='store_true',
+                               help='do not merge fibers of the same entry')
+    stitch_parser.add_argument(
+        '--ignore-time',
+        action='store_true',
+        help='match by stack pointer only, for perf data not recorded with '
+        '`-k CLOCK_MONOTONIC`')
+    stitch_parser.set_defaults(func=stitch)
+
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()
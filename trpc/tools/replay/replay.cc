@@ -0,0 +1,92 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "gflags/gflags.h"
+
+#include "trpc/capture/capture_file.h"
+#include "trpc/tools/replay/replayer.h"
+
+DEFINE_string(capture_file, "", "capture file written by the server(global->capture_path)");
+DEFINE_string(target, "127.0.0.1:8080", "ip:port of the server to replay to, eg: 127.0.0.1:8080 or [::1]:8080");
+DEFINE_double(speed, 1.0, "scale of the original timing, eg: 2 resends at twice the rate, 0 resends at full speed");
+DEFINE_uint32(connections, 8, "number of the connections to the server");
+DEFINE_uint32(timeout_ms, 3000, "timeout(ms) of waiting for a response");
+DEFINE_string(service, "", "only replays the requests of this service if not empty");
+DEFINE_string(report_output, "", "file to write the report to in json, which can be used as --baseline_report later");
+DEFINE_string(baseline_report, "", "report of a previous replay to compare with");
+
+namespace {
+
+bool ParseTarget(const std::string& target, trpc::replay::ReplayOptions* options) {
+  auto pos = target.rfind(':');
+  if (pos == std::string::npos) {
+    return false;
+  }
+  std::string ip = target.substr(0, pos);
+  if (ip.size() >= 2 && ip.front() == '[' && ip.back() == ']') {
+    ip = ip.substr(1, ip.size() - 2);
+  }
+  options->ip = ip;
+  options->port = std::atoi(target.c_str() + pos + 1);
+  return options->port > 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  gflags::SetUsageMessage("Replays the requests captured by a trpc server against a target server.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  trpc::replay::ReplayOptions options;
+  if (!ParseTarget(FLAGS_target, &options)) {
+    std::cerr << "invalid target: " << FLAGS_target << std::endl;
+    return -1;
+  }
+  options.speed = FLAGS_speed;
+  options.connections = FLAGS_connections;
+  options.timeout_ms = FLAGS_timeout_ms;
+  options.service = FLAGS_service;
+
+  trpc::capture::CaptureReader reader;
+  if (!reader.Open(FLAGS_capture_file)) {
+    std::cerr << "open capture file failed: " << FLAGS_capture_file << std::endl;
+    return -1;
+  }
+
+  trpc::replay::Replayer replayer(options);
+  trpc::replay::ReplayReport report = replayer.Run(reader);
+  std::cout << report.ToString();
+
+  if (!FLAGS_report_output.empty()) {
+    std::ofstream(FLAGS_report_output) << report.ToJson();
+  }
+
+  if (!FLAGS_baseline_report.empty()) {
+    std::ifstream in(FLAGS_baseline_report);
+    std::stringstream content;
+    content << in.rdbuf();
+    trpc::replay::ReplayReport baseline;
+    if (!in || !baseline.FromJson(content.str())) {
+      std::cerr << "read baseline report failed: " << FLAGS_baseline_report << std::endl;
+      return -1;
+    }
+    std::cout << std::endl << trpc::replay::CompareReports(baseline, report);
+  }
+
+  return report.failed == 0 ? 0 : 1;
+}
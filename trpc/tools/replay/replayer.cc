@@ -0,0 +1,403 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/tools/replay/replayer.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fmt/format.h"
+#include "json/json.h"
+
+#include "trpc/util/http/http_parser.h"
+
+namespace trpc::replay {
+
+namespace {
+
+// See `TrpcFixedHeader`: 2 bytes magic, 1 byte data frame type, 1 byte stream frame type, 4 bytes frame size, ...
+constexpr std::size_t kTrpcFixedHeaderSize = 16;
+constexpr uint16_t kTrpcMagic = 0x930;
+
+int64_t CheckTrpcResponse(std::string_view in) {
+  if (in.size() < kTrpcFixedHeaderSize) {
+    return 0;
+  }
+
+  uint16_t magic = 0;
+  memcpy(&magic, in.data(), sizeof(magic));
+  uint32_t frame_size = 0;
+  memcpy(&frame_size, in.data() + 4, sizeof(frame_size));
+  frame_size = ntohl(frame_size);
+  if (ntohs(magic) != kTrpcMagic || frame_size < kTrpcFixedHeaderSize) {
+    return -1;
+  }
+  return in.size() < frame_size ? 0 : frame_size;
+}
+
+int64_t CheckHttpResponse(std::string_view in) {
+  http::Response response;
+  return http::Parse(in.data(), in.size(), &response);
+}
+
+uint64_t ElapsedUs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+// A blocking connection to the target, with one request in-flight at most.
+class Connection {
+ public:
+  explicit Connection(const ReplayOptions& options) : options_(options) {}
+  ~Connection() { Close(); }
+
+  bool IsConnected() const { return fd_ >= 0; }
+
+  bool Connect() {
+    sockaddr_storage addr{};
+    socklen_t addr_len = 0;
+    auto* addr4 = reinterpret_cast<sockaddr_in*>(&addr);
+    auto* addr6 = reinterpret_cast<sockaddr_in6*>(&addr);
+    if (inet_pton(AF_INET, options_.ip.c_str(), &addr4->sin_addr) == 1) {
+      addr4->sin_family = AF_INET;
+      addr4->sin_port = htons(options_.port);
+      addr_len = sizeof(*addr4);
+    } else if (inet_pton(AF_INET6, options_.ip.c_str(), &addr6->sin6_addr) == 1) {
+      addr6->sin6_family = AF_INET6;
+      addr6->sin6_port = htons(options_.port);
+      addr_len = sizeof(*addr6);
+    } else {
+      return false;
+    }
+
+    fd_ = ::socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+      return false;
+    }
+    int on = 1;
+    ::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    if (::connect(fd_, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0) {
+      int err = 0;
+      socklen_t err_len = sizeof(err);
+      if (errno != EINPROGRESS || !Wait(POLLOUT, options_.timeout_ms) ||
+          ::getsockopt(fd_, SOL_SOCKET, SO_ERROR, &err, &err_len) != 0 || err != 0) {
+        Close();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool Send(std::string_view data) {
+    // The server may have closed the connection after the last response(eg: http "Connection: close").
+    char c;
+    if (::recv(fd_, &c, sizeof(c), MSG_PEEK | MSG_DONTWAIT) == 0 && !Reconnect()) {
+      return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.timeout_ms);
+    while (!data.empty()) {
+      ssize_t n = ::send(fd_, data.data(), data.size(), MSG_NOSIGNAL);
+      if (n > 0) {
+        data.remove_prefix(n);
+      } else if (n < 0 && errno == EAGAIN) {
+        if (!Wait(POLLOUT, RemainingMs(deadline))) {
+          return false;
+        }
+      } else if (n < 0 && errno == EINTR) {
+        continue;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool Receive(const ResponseCheckFunction& check) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.timeout_ms);
+    while (true) {
+      int64_t size = check(buffer_);
+      if (size > 0) {
+        buffer_.erase(0, size);
+        return true;
+      } else if (size < 0) {
+        return false;
+      }
+
+      char data[16384];
+      ssize_t n = ::recv(fd_, data, sizeof(data), 0);
+      if (n > 0) {
+        buffer_.append(data, n);
+      } else if (n < 0 && errno == EAGAIN) {
+        if (!Wait(POLLIN, RemainingMs(deadline))) {
+          return false;
+        }
+      } else if (n < 0 && errno == EINTR) {
+        continue;
+      } else {
+        return false;
+      }
+    }
+  }
+
+  void Close() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    buffer_.clear();
+  }
+
+ private:
+  bool Reconnect() {
+    Close();
+    return Connect();
+  }
+
+  bool Wait(int16_t events, int timeout_ms) {
+    if (timeout_ms <= 0) {
+      return false;
+    }
+    pollfd pfd{fd_, events, 0};
+    int n = 0;
+    do {
+      n = ::poll(&pfd, 1, timeout_ms);
+    } while (n < 0 && errno == EINTR);
+    return n > 0;
+  }
+
+  static int RemainingMs(std::chrono::steady_clock::time_point deadline) {
+    auto now = std::chrono::steady_clock::now();
+    return now >= deadline ? 0 : std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+  }
+
+ private:
+  const ReplayOptions& options_;
+  int fd_{-1};
+  std::string buffer_;
+};
+
+struct WorkerResult {
+  std::vector<uint64_t> latencies_us;
+  uint64_t failed{0};
+  uint64_t max_lag_us{0};
+};
+
+}  // namespace
+
+Replayer::Replayer(const ReplayOptions& options) : options_(options) {
+  SetResponseCheckFunction("trpc", CheckTrpcResponse);
+  SetResponseCheckFunction("http", CheckHttpResponse);
+  SetResponseCheckFunction("trpc_over_http", CheckHttpResponse);
+}
+
+void Replayer::SetResponseCheckFunction(const std::string& protocol, ResponseCheckFunction&& func) {
+  check_functions_[protocol] = std::move(func);
+}
+
+ReplayReport Replayer::Run(capture::CaptureReader& reader) {
+  ReplayReport report;
+
+  struct Request {
+    capture::CaptureRecord record;
+    const ResponseCheckFunction* check;
+  };
+  std::vector<Request> requests;
+  capture::CaptureRecord record;
+  reader.Rewind();
+  while (reader.Next(&record)) {
+    auto it = check_functions_.find(std::string(record.protocol));
+    if (it == check_functions_.end() || (!options_.service.empty() && record.service != options_.service)) {
+      ++report.skipped;
+      continue;
+    }
+    requests.push_back({record, &it->second});
+  }
+  if (requests.empty()) {
+    return report;
+  }
+
+  // The records are appended concurrently, so they are not strictly in order of time.
+  std::stable_sort(requests.begin(), requests.end(),
+                   [](const Request& a, const Request& b) { return a.record.timestamp_us < b.record.timestamp_us; });
+  uint64_t base_us = requests.front().record.timestamp_us;
+  report.total = requests.size();
+  report.original_duration_us = requests.back().record.timestamp_us - base_us;
+  if (report.original_duration_us > 0) {
+    report.original_qps = report.total * 1000000.0 / report.original_duration_us;
+  }
+
+  uint32_t connections = std::max(options_.connections, 1U);
+  std::vector<WorkerResult> results(connections);
+  std::vector<std::thread> workers;
+  std::atomic<std::size_t> next{0};
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < connections; ++i) {
+    workers.emplace_back([&, result = &results[i]] {
+      Connection conn(options_);
+      while (true) {
+        std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= requests.size()) {
+          break;
+        }
+        const auto& request = requests[index];
+
+        if (options_.speed > 0) {
+          auto at = start + std::chrono::microseconds(
+                                static_cast<uint64_t>((request.record.timestamp_us - base_us) / options_.speed));
+          auto now = std::chrono::steady_clock::now();
+          if (now < at) {
+            std::this_thread::sleep_until(at);
+          } else {
+            result->max_lag_us = std::max(result->max_lag_us, ElapsedUs(at, now));
+          }
+        }
+
+        if (!conn.IsConnected() && !conn.Connect()) {
+          ++result->failed;
+          continue;
+        }
+        auto begin = std::chrono::steady_clock::now();
+        if (!conn.Send(request.record.frame) || !conn.Receive(*request.check)) {
+          ++result->failed;
+          conn.Close();
+          continue;
+        }
+        result->latencies_us.push_back(ElapsedUs(begin, std::chrono::steady_clock::now()));
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  report.duration_us = ElapsedUs(start, std::chrono::steady_clock::now());
+
+  std::vector<uint64_t> latencies_us;
+  for (auto& result : results) {
+    latencies_us.insert(latencies_us.end(), result.latencies_us.begin(), result.latencies_us.end());
+    report.failed += result.failed;
+    report.max_lag_us = std::max(report.max_lag_us, result.max_lag_us);
+  }
+  report.succeeded = latencies_us.size();
+  if (report.duration_us > 0) {
+    report.qps = report.succeeded * 1000000.0 / report.duration_us;
+  }
+  if (!latencies_us.empty()) {
+    std::sort(latencies_us.begin(), latencies_us.end());
+    auto percentile = [&](double p) {
+      return latencies_us[std::min(latencies_us.size() - 1, static_cast<std::size_t>(latencies_us.size() * p))];
+    };
+    uint64_t sum = 0;
+    for (auto latency : latencies_us) {
+      sum += latency;
+    }
+    report.avg_latency_us = sum / latencies_us.size();
+    report.p50_latency_us = percentile(0.5);
+    report.p90_latency_us = percentile(0.9);
+    report.p99_latency_us = percentile(0.99);
+    report.max_latency_us = latencies_us.back();
+  }
+
+  return report;
+}
+
+std::string ReplayReport::ToJson() const {
+  Json::Value root;
+  root["total"] = Json::UInt64(total);
+  root["succeeded"] = Json::UInt64(succeeded);
+  root["failed"] = Json::UInt64(failed);
+  root["skipped"] = Json::UInt64(skipped);
+  root["original_duration_us"] = Json::UInt64(original_duration_us);
+  root["original_qps"] = original_qps;
+  root["duration_us"] = Json::UInt64(duration_us);
+  root["qps"] = qps;
+  root["avg_latency_us"] = Json::UInt64(avg_latency_us);
+  root["p50_latency_us"] = Json::UInt64(p50_latency_us);
+  root["p90_latency_us"] = Json::UInt64(p90_latency_us);
+  root["p99_latency_us"] = Json::UInt64(p99_latency_us);
+  root["max_latency_us"] = Json::UInt64(max_latency_us);
+  root["max_lag_us"] = Json::UInt64(max_lag_us);
+
+  Json::StreamWriterBuilder json_builder;
+  return Json::writeString(json_builder, root);
+}
+
+bool ReplayReport::FromJson(const std::string& json) {
+  Json::CharReaderBuilder builder;
+  Json::Value root;
+  std::string err_msg;
+  const std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+  if (!reader->parse(json.c_str(), json.c_str() + json.size(), &root, &err_msg) || !root.isObject()) {
+    return false;
+  }
+
+  total = root["total"].asUInt64();
+  succeeded = root["succeeded"].asUInt64();
+  failed = root["failed"].asUInt64();
+  skipped = root["skipped"].asUInt64();
+  original_duration_us = root["original_duration_us"].asUInt64();
+  original_qps = root["original_qps"].asDouble();
+  duration_us = root["duration_us"].asUInt64();
+  qps = root["qps"].asDouble();
+  avg_latency_us = root["avg_latency_us"].asUInt64();
+  p50_latency_us = root["p50_latency_us"].asUInt64();
+  p90_latency_us = root["p90_latency_us"].asUInt64();
+  p99_latency_us = root["p99_latency_us"].asUInt64();
+  max_latency_us = root["max_latency_us"].asUInt64();
+  max_lag_us = root["max_lag_us"].asUInt64();
+  return true;
+}
+
+std::string ReplayReport::ToString() const {
+  return fmt::format(
+      "requests: {} total, {} succeeded, {} failed, {} skipped\n"
+      "original: {:.3f}s, {:.1f} qps\n"
+      "replay: {:.3f}s, {:.1f} qps, max lag {}us\n"
+      "latency(us): avg {}, p50 {}, p90 {}, p99 {}, max {}\n",
+      total, succeeded, failed, skipped, original_duration_us / 1000000.0, original_qps, duration_us / 1000000.0, qps,
+      max_lag_us, avg_latency_us, p50_latency_us, p90_latency_us, p99_latency_us, max_latency_us);
+}
+
+std::string CompareReports(const ReplayReport& baseline, const ReplayReport& candidate) {
+  auto line = [](std::string_view name, double base, double value) {
+    std::string change = base > 0 ? fmt::format("{:+.1f}%", (value - base) * 100 / base) : "-";
+    return fmt::format("{:<16}{:>14.1f}{:>14.1f}{:>10}\n", name, base, value, change);
+  };
+
+  std::string out = fmt::format("{:<16}{:>14}{:>14}{:>10}\n", "metric", "baseline", "candidate", "change");
+  out += line("qps", baseline.qps, candidate.qps);
+  out += line("failed", baseline.failed, candidate.failed);
+  out += line("avg_latency_us", baseline.avg_latency_us, candidate.avg_latency_us);
+  out += line("p50_latency_us", baseline.p50_latency_us, candidate.p50_latency_us);
+  out += line("p90_latency_us", baseline.p90_latency_us, candidate.p90_latency_us);
+  out += line("p99_latency_us", baseline.p99_latency_us, candidate.p99_latency_us);
+  out += line("max_latency_us", baseline.max_latency_us, candidate.max_latency_us);
+  return out;
+}
+
+}  // namespace trpc::replay
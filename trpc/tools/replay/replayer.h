@@ -0,0 +1,117 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "trpc/capture/capture_file.h"
+#include "trpc/util/function.h"
+
+namespace trpc::replay {
+
+/// @brief Options of replaying a capture file.
+struct ReplayOptions {
+  /// ip and port of the target server
+  std::string ip{"127.0.0.1"};
+  int port{0};
+
+  /// Scale of the timing, the requests are resent at `speed` times the original rate. If set 0, the requests are
+  /// resent as fast as possible.
+  double speed{1.0};
+
+  /// Number of the connections to the target, each connection has at most one request in-flight
+  uint32_t connections{8};
+
+  /// Timeout(ms) of connecting and waiting for a response
+  uint32_t timeout_ms{3000};
+
+  /// Only replays the requests of this service if not empty
+  std::string service;
+};
+
+/// @brief Result of replaying a capture file.
+struct ReplayReport {
+  /// number of the requests resent
+  uint64_t total{0};
+
+  /// number of the requests which got a response in time
+  uint64_t succeeded{0};
+
+  /// number of the requests which failed to send or got no response in time
+  uint64_t failed{0};
+
+  /// number of the requests skipped, whose protocol can not be replayed or service is not selected
+  uint64_t skipped{0};
+
+  /// time(us) between the first and the last request in the capture file, and the request rate of them
+  uint64_t original_duration_us{0};
+  double original_qps{0};
+
+  /// time(us) the replay takes, and the rate of the responses got
+  uint64_t duration_us{0};
+  double qps{0};
+
+  /// latency(us) of the requests succeeded
+  uint64_t avg_latency_us{0};
+  uint64_t p50_latency_us{0};
+  uint64_t p90_latency_us{0};
+  uint64_t p99_latency_us{0};
+  uint64_t max_latency_us{0};
+
+  /// the maximum delay(us) of sending a request behind its schedule, a large value means the connections are not
+  /// enough to keep up with the original timing
+  uint64_t max_lag_us{0};
+
+  /// @brief Converts the report to json, which can be read by `FromJson` to compare with another run.
+  std::string ToJson() const;
+
+  bool FromJson(const std::string& json);
+
+  /// @brief Converts the report to human readable text.
+  std::string ToString() const;
+};
+
+/// @brief Compares the latency and throughput of two replays of the same capture file, eg: a baseline build and a
+///        tuned build.
+/// @return Human readable text, one line for each metric with the change in percent.
+std::string CompareReports(const ReplayReport& baseline, const ReplayReport& candidate);
+
+/// @brief Finds out the first complete response in the bytes received.
+/// @return -1 if the bytes are not a valid response, 0 if the response is not complete, otherwise the size of it.
+using ResponseCheckFunction = Function<int64_t(std::string_view in)>;
+
+/// @brief Resends the requests in a capture file(see `capture::TrafficCapture`) to a target server at the original or
+///        scaled timing, and measures the latency and throughput.
+/// @note  The requests of "trpc", "http" and "trpc_over_http" can be replayed by default, the requests of other
+///        protocols are skipped unless `SetResponseCheckFunction` is called for the protocol. The requests of
+///        protocols that need a connection preface or state(eg: grpc over http2) can not be replayed frame by frame.
+class Replayer {
+ public:
+  explicit Replayer(const ReplayOptions& options);
+
+  /// @brief Sets how to find out the responses of the requests of a protocol.
+  void SetResponseCheckFunction(const std::string& protocol, ResponseCheckFunction&& func);
+
+  /// @brief Replays all the records of `reader`, blocks until finished.
+  ReplayReport Run(capture::CaptureReader& reader);
+
+ private:
+  ReplayOptions options_;
+  std::unordered_map<std::string, ResponseCheckFunction> check_functions_;
+};
+
+}  // namespace trpc::replay
@@ -0,0 +1,227 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/tools/replay/replayer.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::replay::testing {
+
+// A trpc frame: the fixed header(magic, frame size, ...) followed by the body.
+std::string MakeTrpcFrame(const std::string& body) {
+  std::string frame(16, '\0');
+  uint16_t magic = htons(0x930);
+  uint32_t size = htonl(16 + body.size());
+  memcpy(&frame[0], &magic, sizeof(magic));
+  memcpy(&frame[4], &size, sizeof(size));
+  return frame + body;
+}
+
+// Echoes the trpc frames back.
+class EchoServer {
+ public:
+  EchoServer() {
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    socklen_t len = sizeof(addr);
+    ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    ::listen(listen_fd_, 128);
+
+    acceptor_ = std::thread([this] {
+      while (true) {
+        int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+          break;
+        }
+        fds_.push_back(fd);
+        handlers_.emplace_back([this, fd] { Echo(fd); });
+      }
+    });
+  }
+
+  ~EchoServer() {
+    ::shutdown(listen_fd_, SHUT_RDWR);
+    ::close(listen_fd_);
+    acceptor_.join();
+    for (int fd : fds_) {
+      ::shutdown(fd, SHUT_RDWR);
+    }
+    for (auto& handler : handlers_) {
+      handler.join();
+    }
+    for (int fd : fds_) {
+      ::close(fd);
+    }
+  }
+
+  int Port() const { return port_; }
+
+  uint64_t Received() const { return received_.load(); }
+
+ private:
+  void Echo(int fd) {
+    std::string buffer;
+    char data[4096];
+    while (true) {
+      ssize_t n = ::recv(fd, data, sizeof(data), 0);
+      if (n <= 0) {
+        return;
+      }
+      buffer.append(data, n);
+      while (buffer.size() >= 16) {
+        uint32_t size = 0;
+        memcpy(&size, &buffer[4], sizeof(size));
+        size = ntohl(size);
+        if (buffer.size() < size) {
+          break;
+        }
+        ::send(fd, buffer.data(), size, MSG_NOSIGNAL);
+        buffer.erase(0, size);
+        ++received_;
+      }
+    }
+  }
+
+ private:
+  int listen_fd_{-1};
+  int port_{0};
+  std::thread acceptor_;
+  std::vector<int> fds_;
+  std::vector<std::thread> handlers_;
+  std::atomic<uint64_t> received_{0};
+};
+
+class ReplayerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = "./replayer_test." + std::to_string(::getpid()) + ".bin";
+
+    // 20 requests in 19ms, and some can not be replayed.
+    capture::CaptureWriter writer;
+    ASSERT_TRUE(writer.Open(path_, 64 * 1024));
+    for (int i = 0; i < 20; ++i) {
+      std::string service = i % 2 == 0 ? "even" : "odd";
+      writer.Append(1000000 + i * 1000, "trpc", service, CreateBufferSlow(MakeTrpcFrame(std::string(i * 10, 'x'))));
+    }
+    writer.Append(1005500, "grpc", "even", CreateBufferSlow("grpc frame"));
+    writer.Close();
+    ASSERT_TRUE(reader_.Open(path_));
+  }
+
+  void TearDown() override {
+    reader_.Close();
+    ::unlink(path_.c_str());
+  }
+
+  std::string path_;
+  capture::CaptureReader reader_;
+};
+
+TEST_F(ReplayerTest, OriginalTiming) {
+  EchoServer server;
+  ReplayOptions options;
+  options.port = server.Port();
+  options.connections = 4;
+
+  ReplayReport report = Replayer(options).Run(reader_);
+  ASSERT_EQ(20, report.total);
+  ASSERT_EQ(20, report.succeeded);
+  ASSERT_EQ(0, report.failed);
+  ASSERT_EQ(1, report.skipped);
+  ASSERT_EQ(20, server.Received());
+  ASSERT_EQ(19000, report.original_duration_us);
+  ASSERT_GE(report.duration_us, 19000);
+  ASSERT_GT(report.qps, 0);
+  ASSERT_LE(report.p50_latency_us, report.p99_latency_us);
+  ASSERT_LE(report.p99_latency_us, report.max_latency_us);
+}
+
+TEST_F(ReplayerTest, ScaledTimingAndService) {
+  EchoServer server;
+  ReplayOptions options;
+  options.port = server.Port();
+  options.speed = 0;
+  options.connections = 2;
+  options.service = "odd";
+
+  ReplayReport report = Replayer(options).Run(reader_);
+  ASSERT_EQ(10, report.total);
+  ASSERT_EQ(10, report.succeeded);
+  ASSERT_EQ(11, report.skipped);
+  ASSERT_LT(report.duration_us, 19000);
+}
+
+TEST_F(ReplayerTest, CustomProtocol) {
+  EchoServer server;
+  ReplayOptions options;
+  options.port = server.Port();
+  options.speed = 0;
+  options.timeout_ms = 10;
+
+  // The echo server does not understand the frame, so no response.
+  Replayer replayer(options);
+  replayer.SetResponseCheckFunction("grpc", [](std::string_view in) -> int64_t { return in.empty() ? 0 : -1; });
+  ReplayReport report = replayer.Run(reader_);
+  ASSERT_EQ(21, report.total);
+  ASSERT_EQ(20, report.succeeded);
+  ASSERT_EQ(1, report.failed);
+}
+
+TEST_F(ReplayerTest, ConnectFailed) {
+  ReplayOptions options;
+  options.port = 1;
+  options.speed = 0;
+
+  ReplayReport report = Replayer(options).Run(reader_);
+  ASSERT_EQ(20, report.total);
+  ASSERT_EQ(0, report.succeeded);
+  ASSERT_EQ(20, report.failed);
+}
+
+TEST(ReplayReportTest, JsonAndCompare) {
+  ReplayReport baseline;
+  baseline.total = baseline.succeeded = 100;
+  baseline.qps = 1000;
+  baseline.p99_latency_us = 200;
+
+  ReplayReport report;
+  ASSERT_TRUE(report.FromJson(baseline.ToJson()));
+  ASSERT_EQ(100, report.succeeded);
+  ASSERT_EQ(1000, report.qps);
+  ASSERT_EQ(200, report.p99_latency_us);
+  ASSERT_FALSE(report.FromJson("not json"));
+
+  report.qps = 2000;
+  report.p99_latency_us = 100;
+  std::string diff = CompareReports(baseline, report);
+  ASSERT_NE(std::string::npos, diff.find("+100.0%"));
+  ASSERT_NE(std::string::npos, diff.find("-50.0%"));
+  ASSERT_FALSE(report.ToString().empty());
+}
+
+}  // namespace trpc::replay::testing
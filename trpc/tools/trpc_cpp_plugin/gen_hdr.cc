@@ -63,6 +63,12 @@ static std::string GenHeader(const google::protobuf::FileDescriptor* file, const
   content += R"(#include "trpc/server/rpc_service_impl.h")";
   content += LineFeed(indent);
 
+  // If contains batch method, include the batch handler header for `BatchRpcCall`.
+  if (ContainBatchMethod(file)) {
+    content += R"(#include "trpc/server/batch_rpc_method_handler.h")";
+    content += LineFeed(indent);
+  }
+
   return content;
 }
 
@@ -118,7 +124,11 @@ std::string GenService(const ::google::protobuf::ServiceDescriptor* desc, bool e
 
     bool client_stream = method->client_streaming();
     bool server_stream = method->server_streaming();
-    if (!client_stream && !server_stream) {
+    if (IsBatchMethod(method)) {
+      out += fmt::format("virtual void {0}(std::vector<::trpc::BatchRpcCall<{1}, {2}>>& calls);", method->name(),
+                         GetParamterTypeWithNamespace(method->input_type()->full_name()),
+                         GetParamterTypeWithNamespace(method->output_type()->full_name()));
+    } else if (!client_stream && !server_stream) {
       out += fmt::format(
           "virtual ::trpc::Status {0}(::trpc::ServerContextPtr context, const {1}* request, {2}* response);",
           method->name(), GetParamterTypeWithNamespace(method->input_type()->full_name()),
@@ -220,6 +230,7 @@ public:
                                   HelloReply* response);
   virtual ::trpc::Future<HelloReply> AsyncSayHello(::trpc::ClientContextPtr& context,
                                                    const HelloRequest& request);
+  ::trpc::CallTemplatePtr PrepareSayHello();
 };
 */
 
@@ -258,6 +269,10 @@ std::string GenProxy(const ::google::protobuf::ServiceDescriptor* desc, int inde
       out += LineFeed(indent);
       out += fmt::format("virtual ::trpc::Status {0}(const ::trpc::ClientContextPtr& context, const {1}& request);",
                          method->name(), GetParamterTypeWithNamespace(method->input_type()->full_name()));
+      out += LineFeed(indent);
+      out += "// resolve the invariants of the calls once, use with ::trpc::MakeClientContext(proxy, call_template)";
+      out += LineFeed(indent);
+      out += fmt::format("::trpc::CallTemplatePtr Prepare{0}();", method->name());
     } else if (client_stream && !server_stream) {
       out += fmt::format(
           "virtual ::trpc::stream::StreamWriter<{0}> {1}(const ::trpc::ClientContextPtr& context, {2}* response);",
@@ -307,6 +322,8 @@ std::string GenAsyncProxy(const ::google::protobuf::ServiceDescriptor* desc, int
           output_type, method->name(), input_type);
       out += LineFeed(indent);
       out += "// TODO: one-way";
+      out += LineFeed(indent);
+      out += fmt::format("::trpc::CallTemplatePtr Prepare{0}();", method->name());
     } else if (client_stream && !server_stream) {
       out += fmt::format(
           R"(::trpc::Future<std::pair<::trpc::stream::AsyncWriterPtr<{0}>, ::trpc::Future<{1}>>> {2}(const ::trpc::ClientContextPtr& context);)",  // NOLINT
@@ -66,7 +66,11 @@ std::string GenMockService(const ::google::protobuf::ServiceDescriptor* desc, in
 
     bool client_stream = method->client_streaming();
     bool server_stream = method->server_streaming();
-    if (!client_stream && !server_stream) {
+    if (IsBatchMethod(method)) {
+      out += fmt::format("MOCK_METHOD(void, {0}, ((std::vector<::trpc::BatchRpcCall<{1}, {2}>>&)));", method->name(),
+                         GetParamterTypeWithNamespace(method->input_type()->full_name()),
+                         GetParamterTypeWithNamespace(method->output_type()->full_name()));
+    } else if (!client_stream && !server_stream) {
       out += fmt::format("MOCK_METHOD(::trpc::Status, {0}, (::trpc::ServerContextPtr, const {1}*, {2}*));",
                          method->name(), GetParamterTypeWithNamespace(method->input_type()->full_name()),
                          GetParamterTypeWithNamespace(method->output_type()->full_name()));
@@ -41,6 +41,11 @@ static std::string GenHeader(const google::protobuf::FileDescriptor* file, const
   content += fmt::format(R"(#include "{0}.trpc.pb.h")", pbFileBaseName);
   content += LineFeed(indent);
   content += LineFeed(indent);
+  // If contains batch method, include the batch handler header.
+  if (ContainBatchMethod(file)) {
+    content += R"(#include "trpc/server/batch_rpc_method_handler.h")";
+    content += LineFeed(indent);
+  }
   content += R"(#include "trpc/server/rpc_async_method_handler.h")";
   content += LineFeed(indent);
   content += R"(#include "trpc/server/rpc_method_handler.h")";
@@ -134,7 +139,16 @@ static std::string GenServiceConDestructor(const ::google::protobuf::ServiceDesc
     out +=
         fmt::format("for (const std::string_view& method : {0}_method_names[{1}]) {{", serviceName, std::to_string(i));
     out += LineFeed(indent + 2);
-    if (!client_stream && !server_stream) {
+    if (IsBatchMethod(method)) {
+      const trpc::CppExt cpp_ext = method->options().GetExtension(trpc::cpp_ext);
+      out += fmt::format(
+          "AddRpcServiceMethod(new ::trpc::RpcServiceMethod(method.data(), ::trpc::MethodType::UNARY, new "
+          "::trpc::BatchRpcMethodHandler<{0}, {1}>(std::bind(&{2}::{3}, this, std::placeholders::_1), "
+          "::trpc::RpcBatchOption{{{4}, std::chrono::microseconds({5})}}, method)));",
+          GetParamterTypeWithNamespace(method->input_type()->full_name()),
+          GetParamterTypeWithNamespace(method->output_type()->full_name()), serviceName, method->name(),
+          cpp_ext.batch_max_size(), cpp_ext.batch_max_delay_us());
+    } else if (!client_stream && !server_stream) {
       out += fmt::format(
           "AddRpcServiceMethod(new ::trpc::RpcServiceMethod(method.data(), ::trpc::MethodType::UNARY, new "
           "::trpc::RpcMethodHandler<{0}, {1}>(std::bind(&{2}::{3}, this, std::placeholders::_1, std::placeholders::_2, "
@@ -252,7 +266,16 @@ static std::string GenServiceMethodImp(const ::google::protobuf::ServiceDescript
 
     bool client_stream = method->client_streaming();
     bool server_stream = method->server_streaming();
-    if (!client_stream && !server_stream) {
+    if (IsBatchMethod(method)) {
+      out += "void " + serviceName + "::" + method->name() + "(std::vector<::trpc::BatchRpcCall<" +
+             GetParamterTypeWithNamespace(method->input_type()->full_name()) + ", " +
+             GetParamterTypeWithNamespace(method->output_type()->full_name()) + ">>& calls) {";
+      out += LineFeed(indent + 1) + "for (auto& call : calls) {";
+      out += LineFeed(indent + 2) + R"(call.status = ::trpc::Status(-1, "");)";
+      out += LineFeed(indent + 1) + "}";
+      out += LineFeed(indent);
+      out += "}";
+    } else if (!client_stream && !server_stream) {
       out += "::trpc::Status " + serviceName + "::" + method->name() + "(::trpc::ServerContextPtr context, const " +
              GetParamterTypeWithNamespace(method->input_type()->full_name()) + "* request, " +
              GetParamterTypeWithNamespace(method->output_type()->full_name()) + "* response) {";
@@ -563,6 +586,49 @@ static std::string GenProxyAsyncCall(const ::google::protobuf::ServiceDescriptor
   return out;
 }
 
+/*
+::trpc::CallTemplatePtr GreeterServiceProxy::PrepareSayHello() {
+  return PrepareCall(Greeter_method_names[0][0].data());
+}
+*/
+static std::string GenProxyPrepareCall(const ::google::protobuf::ServiceDescriptor* service, bool is_async,
+                                       bool enable_explicit_link_proto, int indent = 0) {
+  std::string out;
+  out.reserve(8 * 1024);
+
+  const auto& serviceName = service->name();
+  const auto& methodArrayName = serviceName + "_method_names";
+  const std::string prefix = is_async ? "Async" : "";
+
+  for (int i = 0; i < service->method_count(); ++i) {
+    auto method = service->method(i);
+
+    bool client_stream = method->client_streaming();
+    bool server_stream = method->server_streaming();
+    if (client_stream || server_stream) {
+      continue;
+    }
+
+    out += LineFeed(indent);
+    out += LineFeed(indent);
+
+    out += fmt::format("::trpc::CallTemplatePtr {0}{1}ServiceProxy::Prepare{2}() {{", prefix, serviceName,
+                       method->name());
+    out += LineFeed(indent + 1);
+    if (enable_explicit_link_proto) {
+      out += fmt::format(
+          "return PrepareCall({0}[{1}][0].data(), {2}{3}::GetServiceDescriptor() != nullptr ? "
+          "{2}{3}::GetServiceDescriptor()->method({4}) : nullptr);",
+          methodArrayName, i, prefix, serviceName, method->index());
+    } else {
+      out += fmt::format("return PrepareCall({0}[{1}][0].data());", methodArrayName, i);
+    }
+    out += LineFeed(indent);
+    out += "}";
+  }
+  return out;
+}
+
 static std::string GenAsyncProxyAsyncCall(const ::google::protobuf::ServiceDescriptor* service,
                                           bool enable_explicit_link_proto, int indent = 0) {
   std::string out;
@@ -803,9 +869,11 @@ std::string GenTrpcSrcFile(const google::protobuf::FileDescriptor* file, const s
     out += GenProxySyncCall(service, enable_explicit_link_proto);
     out += GenProxyAsyncCall(service, enable_explicit_link_proto);
     out += GenProxyOnewayCall(service, enable_explicit_link_proto);
+    out += GenProxyPrepareCall(service, false, enable_explicit_link_proto);
 
     // AsyncServiceProxy
     out += GenAsyncProxyAsyncCall(service, enable_explicit_link_proto);
+    out += GenProxyPrepareCall(service, true, enable_explicit_link_proto);
   }
 
   out += LineFeed(0);
@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "trpc/client/redis/cmdgen.h"
+#include "trpc/client/redis/reader.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
 
@@ -44,7 +45,7 @@ RedisClientIoHandler::RedisClientIoHandler(Connection* conn, TransInfo* trans_in
     return;
   }
 
-  TRPC_ASSERT(!(redis_conf_.password.empty() && redis_conf_.db == 0) &&
+  TRPC_ASSERT(!(redis_conf_.password.empty() && redis_conf_.db == 0 && !redis_conf_.near_cache.enable) &&
               "forbid redis password is empty and db index is 0 at the same time");
   init_stage_ = RedisClientStage::kInit;
 
@@ -59,6 +60,12 @@ RedisClientIoHandler::RedisClientIoHandler(Connection* conn, TransInfo* trans_in
     select_cmd_ = trpc::redis::cmdgen{}.select(redis_conf_.db);
   }
 
+  if (redis_conf_.near_cache.enable) {
+    tracking_cmd_ = trpc::redis::cmdgen{}.hello(3);
+    tracking_cmd_ += trpc::redis::cmdgen{}.client_tracking(redis_conf_.near_cache.mode == "broadcast",
+                                                           redis_conf_.near_cache.prefixes);
+  }
+
   current_stage_ = init_stage_;
 }
 
@@ -109,6 +116,14 @@ IoHandler::HandshakeStatus RedisClientIoHandler::HandleRedisHandshake(bool is_re
       result = HandleSelectResponse(is_read_event);
       break;
     case RedisClientStage::kRecvSelectSucc:
+    case RedisClientStage::kSendTrackingPart:
+      result = SendTrackingRequest();
+      break;
+    case RedisClientStage::kSendTrackingSucc:
+    case RedisClientStage::kRecvTrackingPart:
+      result = HandleTrackingResponse(is_read_event);
+      break;
+    case RedisClientStage::kRecvTrackingSucc:
       result = IoHandler::HandshakeStatus::kSucc;
       break;
     default:
@@ -167,7 +182,8 @@ IoHandler::HandshakeStatus RedisClientIoHandler::SendRequest(const std::string&
 
 IoHandler::HandshakeStatus RedisClientIoHandler::SendSelectRequest() {
   if (this->current_stage_ == RedisClientStage::kRecvAuthSucc && db_index_ == 0) {
-    return IoHandler::HandshakeStatus::kSucc;
+    this->current_stage_ = RedisClientStage::kRecvSelectSucc;
+    return SendTrackingRequest();
   }
   IoHandler::HandshakeStatus result = IoHandler::HandshakeStatus::kFailed;
 
@@ -215,7 +231,7 @@ IoHandler::HandshakeStatus RedisClientIoHandler::HandleSelectResponse(bool is_re
   }
 
   if (this->current_stage_ == RedisClientStage::kRecvSelectSucc) {
-    result = IoHandler::HandshakeStatus::kSucc;
+    result = tracking_cmd_.empty() ? IoHandler::HandshakeStatus::kSucc : IoHandler::HandshakeStatus::kNeedWrite;
   } else {
     result = IoHandler::HandshakeStatus::kNeedRead;
   }
@@ -263,7 +279,7 @@ IoHandler::HandshakeStatus RedisClientIoHandler::HandleAuthResponse(bool is_read
     return result;
   }
 
-  if (this->current_stage_ == RedisClientStage::kRecvAuthSucc && this->db_index_ == 0) {
+  if (this->current_stage_ == RedisClientStage::kRecvAuthSucc && this->db_index_ == 0 && tracking_cmd_.empty()) {
     result = IoHandler::HandshakeStatus::kSucc;
   } else if (this->current_stage_ == RedisClientStage::kRecvAuthSucc) {
     result = IoHandler::HandshakeStatus::kNeedWrite;
@@ -273,6 +289,91 @@ IoHandler::HandshakeStatus RedisClientIoHandler::HandleAuthResponse(bool is_read
   return result;
 }
 
+IoHandler::HandshakeStatus RedisClientIoHandler::SendTrackingRequest() {
+  if (tracking_cmd_.empty()) {
+    return IoHandler::HandshakeStatus::kSucc;
+  }
+
+  if (this->current_stage_ == RedisClientStage::kRecvSelectSucc) {
+    pos_ = 0;
+    tracking_rsp_.Clear();
+  }
+  IoHandler::HandshakeStatus result = SendRequest(tracking_cmd_);
+  if (result == IoHandler::HandshakeStatus::kFailed) {
+    TRPC_LOG_ERROR("SendTrackingRequest fail. Stage is : " << static_cast<int>(this->current_stage_)
+                                                           << " , fd : " << conn_->GetFd());
+    return result;
+  }
+
+  if (result == IoHandler::HandshakeStatus::kNeedWrite) {
+    this->current_stage_ = RedisClientStage::kSendTrackingPart;
+  } else {
+    this->current_stage_ = RedisClientStage::kSendTrackingSucc;
+  }
+  return result;
+}
+
+IoHandler::HandshakeStatus RedisClientIoHandler::HandleTrackingResponse(bool is_read_event) {
+  if (!is_read_event) {
+    return IoHandler::HandshakeStatus::kNeedRead;
+  }
+
+  // The response of HELLO is a map which may be larger than one read, so read until no more data.
+  NoncontiguousBufferBuilder builder;
+  char recv_buff[128] = {0};
+  int recv_len = 0;
+  while ((recv_len = RecvResponse(recv_buff)) > 0) {
+    builder.Append(recv_buff, recv_len);
+  }
+  if (recv_len < 0) {
+    TRPC_LOG_ERROR("HandleTrackingResponse fail. Stage is : " << static_cast<int>(this->current_stage_)
+                                                              << " , fd : " << conn_->GetFd());
+    return IoHandler::HandshakeStatus::kFailed;
+  }
+  tracking_rsp_.Append(builder.DestructiveGet());
+
+  int ret = UnPackageTrackingResponse();
+  if (ret < 0) {
+    Reset();
+    return IoHandler::HandshakeStatus::kFailed;
+  }
+  if (ret == 0) {
+    this->current_stage_ = RedisClientStage::kRecvTrackingPart;
+    return IoHandler::HandshakeStatus::kNeedRead;
+  }
+
+  tracking_rsp_.Clear();
+  this->current_stage_ = RedisClientStage::kRecvTrackingSucc;
+  return IoHandler::HandshakeStatus::kSucc;
+}
+
+int RedisClientIoHandler::UnPackageTrackingResponse() {
+  // Replies of HELLO and CLIENT TRACKING
+  constexpr std::size_t kReplyCount = 2;
+
+  NoncontiguousBuffer buffer = tracking_rsp_;
+  std::deque<std::any> replies;
+  redis::Reader reader;
+  while (replies.size() < kReplyCount && reader.GetReply(buffer, replies)) {
+  }
+  if (reader.IsProtocolError()) {
+    TRPC_LOG_ERROR("UnPackageTrackingResponse fail, protocol error. fd : " << conn_->GetFd());
+    return -1;
+  }
+  if (replies.size() < kReplyCount) {
+    return 0;
+  }
+
+  for (auto& item : replies) {
+    auto& reply = std::any_cast<redis::Reply&>(item);
+    if (reply.IsError()) {
+      TRPC_LOG_ERROR("UnPackageTrackingResponse fail. fd : " << conn_->GetFd() << ",error_msg:" << reply.GetString());
+      return -1;
+    }
+  }
+  return 1;
+}
+
 int RedisClientIoHandler::UnPackageSelectResponse(char* recv_buff, const int recv_len) {
   if (TRPC_UNLIKELY(recv_len + pos_ > kRedisSuccessReplyLen)) {
     return -1;
@@ -19,6 +19,7 @@
 #include "trpc/common/config/redis_client_conf.h"
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
 #include "trpc/transport/client/trans_info.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
 
 namespace trpc {
 
@@ -36,6 +37,10 @@ enum class RedisClientStage {
   kRecvSelectSucc = 10,  // Select-DB response packet receive successfully
   kRecvSelectPart = 11,  // Select-DB response packet partially receive successfully
   kRecvSelectFail = 12,  // Select-DB response packet failed to receive
+  kSendTrackingSucc = 13,  // Client-tracking(HELLO 3 and CLIENT TRACKING) request packet sent successfully
+  kSendTrackingPart = 14,  // Client-tracking request packet partially sent successfully
+  kRecvTrackingPart = 15,  // Client-tracking response packet partially receive successfully
+  kRecvTrackingSucc = 16,  // Client-tracking response packet receive successfully
 };
 
 /// @brief The implementation for redis client io handler
@@ -80,6 +85,12 @@ class RedisClientIoHandler : public IoHandler {
 
   IoHandler::HandshakeStatus HandleAuthResponse(bool is_read_event);
 
+  IoHandler::HandshakeStatus SendTrackingRequest();
+
+  IoHandler::HandshakeStatus HandleTrackingResponse(bool is_read_event);
+
+  int UnPackageTrackingResponse();
+
   IoHandler::HandshakeStatus SendRequest(const std::string& cmd);
 
   int RecvResponse(char* recv_buff);
@@ -93,6 +104,11 @@ class RedisClientIoHandler : public IoHandler {
 
   std::string select_cmd_;
 
+  // Switches the connection to RESP3 and turns on client tracking, used by near-cache
+  std::string tracking_cmd_;
+
+  NoncontiguousBuffer tracking_rsp_;
+
   RedisClientStage current_stage_;
 
   RedisClientStage init_stage_;
@@ -0,0 +1,78 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/transport/client/fiber/common/fiber_client_connection.h"
+
+#include "trpc/runtime/fiber_runtime.h"
+#include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_shm_connection.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
+#include "trpc/transport/client/common/client_io_handler_factory.h"
+#include "trpc/util/likely.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+RefPtr<FiberConnection> CreateFiberClientConnection(uint64_t conn_id, const NetworkAddress& peer_addr,
+                                                    TransInfo* trans_info) {
+  Reactor* reactor = trpc::fiber::GetReactor(trpc::fiber::GetCurrentSchedulingGroupIndex(), -2);
+  TRPC_ASSERT(reactor != nullptr && "reactor is null");
+
+  RefPtr<FiberConnection> conn;
+  if (TRPC_UNLIKELY(trans_info->use_shm)) {
+    // The shm connection reads/writes the shared memory with its own io-handler.
+    auto socket = Socket::CreateUnixSocket();
+    if (!socket.IsValid()) {
+      TRPC_LOG_ERROR("create unix socket failed on peer addr:" << peer_addr.ToString());
+      return nullptr;
+    }
+    socket.SetBlock(false);
+
+    conn = MakeRefCounted<FiberShmConnection>(reactor, socket);
+  } else {
+    auto socket = Socket::CreateTcpSocket(peer_addr.IsIpv6());
+    if (!socket.IsValid()) {
+      TRPC_LOG_ERROR("create tcp socket failed on peer addr:" << peer_addr.ToString());
+      return nullptr;
+    }
+
+    socket.SetTcpNoDelay();
+    socket.SetCloseWaitDefault();
+    socket.SetBlock(false);
+    socket.SetKeepAlive();
+
+    if (trans_info->set_socket_opt_function) {
+      trans_info->set_socket_opt_function(socket);
+    }
+
+    conn = MakeRefCounted<FiberTcpConnection>(reactor, socket);
+    conn->SetIoHandler(ClientIoHandlerFactory::GetInstance()->Create(trans_info->protocol, conn.Get(), trans_info));
+  }
+
+  conn->SetMaxPacketSize(trans_info->max_packet_size);
+  conn->SetRecvBufferSize(trans_info->recv_buffer_size);
+  conn->SetSendQueueCapacity(trans_info->send_queue_capacity);
+  conn->SetEgressRateLimit(trans_info->conn_egress_rate_limit);
+  conn->SetServiceEgressBucket(trans_info->egress_bucket);
+  conn->SetSendQueueTimeout(trans_info->send_queue_timeout);
+  conn->SetConnId(conn_id);
+  conn->SetClient();
+  conn->SetPeerIp(peer_addr.Ip());
+  conn->SetPeerPort(peer_addr.Port());
+  conn->SetPeerIpType(peer_addr.Type());
+
+  return conn;
+}
+
+}  // namespace trpc
@@ -0,0 +1,32 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+
+#include "trpc/runtime/iomodel/reactor/common/network_address.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
+#include "trpc/transport/client/trans_info.h"
+
+namespace trpc {
+
+/// @brief Create the client connection of the fiber connectors(complex/pool/pipeline) to `peer_addr`, on the reactor
+///        of the current scheduling group. It's a shared memory connection if `trans_info->use_shm` is set, otherwise
+///        a tcp connection with the io-handler of the protocol. The options of the connection itself(packet size,
+///        buffer size, peer address, etc.) are set from `trans_info`, the connection handler is left to the caller.
+/// @return nullptr if failed to create the socket.
+RefPtr<FiberConnection> CreateFiberClientConnection(uint64_t conn_id, const NetworkAddress& peer_addr,
+                                                    TransInfo* trans_info);
+
+}  // namespace trpc
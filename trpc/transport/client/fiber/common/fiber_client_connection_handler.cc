@@ -69,6 +69,12 @@ void FiberClientConnectionHandler::NotifySendMessage() {
   }
 }
 
+void FiberClientConnectionHandler::NotifyMessageFailed(const IoMessage& message, ConnectionErrorCode code) {
+  if (message_failed_func_) {
+    message_failed_func_(message, code);
+  }
+}
+
 uint32_t FiberClientConnectionHandler::GetMergeRequestCount() {
   if (get_merge_request_count_func_) {
     return get_merge_request_count_func_();
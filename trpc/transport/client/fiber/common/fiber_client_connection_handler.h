@@ -46,6 +46,8 @@ class FiberClientConnectionHandler : public ConnectionHandler {
 
   void NotifySendMessage() override;
 
+  void NotifyMessageFailed(const IoMessage& message, ConnectionErrorCode code) override;
+
   uint32_t GetMergeRequestCount() override;
 
   /// @brief Gets or creates a stream handler.
@@ -60,6 +62,8 @@ class FiberClientConnectionHandler : public ConnectionHandler {
 
   void SetPipelineSendNotifyFunc(PipelineSendNotifyFunction&& func) { pipeline_send_notify_func_ = std::move(func); }
 
+  void SetMsgFailedFunc(MessageFailedFunction&& func) { message_failed_func_ = std::move(func); }
+
   void SetCurrentContextExt(uint32_t context_ext) override { context_ext_ = context_ext; }
   uint32_t GetCurrentContextExt() override { return context_ext_; }
 
@@ -76,6 +80,7 @@ class FiberClientConnectionHandler : public ConnectionHandler {
   NotifySendMsgFunction notify_msg_send_func_{nullptr};
   GetMergeRequestCountFunction get_merge_request_count_func_{nullptr};
   PipelineSendNotifyFunction pipeline_send_notify_func_{nullptr};
+  MessageFailedFunction message_failed_func_{nullptr};
 };
 
 namespace stream {
@@ -28,6 +28,7 @@
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_udp_transceiver.h"
 #include "trpc/transport/client/common/client_io_handler_factory.h"
+#include "trpc/transport/client/fiber/common/fiber_client_connection.h"
 #include "trpc/transport/client/fiber/common/fiber_client_connection_handler.h"
 #include "trpc/transport/client/fiber/common/fiber_client_connection_handler_factory.h"
 #include "trpc/transport/client/fiber/conn_complex/fiber_tcp_conn_complex_connector_group.h"
@@ -64,39 +65,12 @@ void FiberTcpConnComplexConnector::Destroy() {
 }
 
 bool FiberTcpConnComplexConnector::CreateFiberTcpConnection(uint64_t conn_id) {
-  auto socket = Socket::CreateTcpSocket(options_.peer_addr->IsIpv6());
-  if (!socket.IsValid()) {
-    TRPC_LOG_ERROR("create tcp socket failed on peer addr:" << options_.peer_addr->ToString());
+  RefPtr<FiberConnection> conn =
+      CreateFiberClientConnection(options_.conn_id, *options_.peer_addr, options_.trans_info);
+  if (conn == nullptr) {
     return false;
   }
 
-  socket.SetTcpNoDelay();
-  socket.SetCloseWaitDefault();
-  socket.SetBlock(false);
-  socket.SetKeepAlive();
-
-  if (options_.trans_info->set_socket_opt_function) {
-    options_.trans_info->set_socket_opt_function(socket);
-  }
-
-  Reactor* reactor = trpc::fiber::GetReactor(trpc::fiber::GetCurrentSchedulingGroupIndex(), -2);
-  TRPC_ASSERT(reactor != nullptr && "reactor is null");
-
-  auto conn = MakeRefCounted<FiberTcpConnection>(reactor, socket);
-  std::unique_ptr<IoHandler> io_handler =
-      ClientIoHandlerFactory::GetInstance()->Create(options_.trans_info->protocol, conn.Get(), options_.trans_info);
-
-  conn->SetMaxPacketSize(options_.trans_info->max_packet_size);
-  conn->SetRecvBufferSize(options_.trans_info->recv_buffer_size);
-  conn->SetSendQueueCapacity(options_.trans_info->send_queue_capacity);
-  conn->SetSendQueueTimeout(options_.trans_info->send_queue_timeout);
-  conn->SetConnId(options_.conn_id);
-  conn->SetClient();
-  conn->SetPeerIp(options_.peer_addr->Ip());
-  conn->SetPeerPort(options_.peer_addr->Port());
-  conn->SetPeerIpType(options_.peer_addr->Type());
-  conn->SetIoHandler(std::move(io_handler));
-
   this->Ref();
   auto conn_handler = FiberClientConnectionHandlerFactory::GetInstance()->Create(options_.trans_info->protocol,
                                                                                  conn.Get(), options_.trans_info);
@@ -149,6 +123,14 @@ void FiberTcpConnComplexConnector::ConnectionCleanFunction(Connection* conn) {
   TRPC_ASSERT(start_fiber && "StartFiberDetached failed when ConnectionCleanFunction");
 }
 
+int FiberTcpConnComplexConnector::GetLoad() const {
+  if (connection_ != nullptr && connection_->GetConnectionHandler() != nullptr) {
+    return connection_->GetConnectionHandler()->GetLoad();
+  }
+
+  return -1;
+}
+
 bool FiberTcpConnComplexConnector::IsConnIdleTimeout() const {
   if (connection_ != nullptr) {
     uint64_t now_ms = trpc::time::GetMilliSeconds();
@@ -172,6 +154,31 @@ void FiberTcpConnComplexConnector::CloseConnection() {
   TRPC_ASSERT(start_fiber && "StartFiberDetached failed when CloseConnection");
 }
 
+bool FiberTcpConnComplexConnector::Acquire() {
+  acquired_calls_.fetch_add(1, std::memory_order_seq_cst);
+  // Pairs with `Drain`: either the call sees the connector draining, or `Drain` sees the call and leaves the
+  // connection to be closed by the last `Release`.
+  if (draining_.load(std::memory_order_seq_cst)) {
+    Release();
+    return false;
+  }
+
+  return true;
+}
+
+void FiberTcpConnComplexConnector::Release() {
+  if (acquired_calls_.fetch_sub(1, std::memory_order_seq_cst) == 1 && draining_.load(std::memory_order_seq_cst)) {
+    CloseConnection();
+  }
+}
+
+void FiberTcpConnComplexConnector::Drain() {
+  draining_.store(true, std::memory_order_seq_cst);
+  if (acquired_calls_.load(std::memory_order_seq_cst) == 0) {
+    CloseConnection();
+  }
+}
+
 void FiberTcpConnComplexConnector::ClearReqMsg() {
   std::vector<uint64_t> ids;
 
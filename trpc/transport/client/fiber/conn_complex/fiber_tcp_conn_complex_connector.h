@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/transport/client/client_transport_message.h"
 #include "trpc/transport/client/fiber/common/sharded_call_map.h"
@@ -63,8 +64,22 @@ class FiberTcpConnComplexConnector final : public RefCounted<FiberTcpConnComplex
 
   bool IsConnIdleTimeout() const;
 
+  /// @brief Get the load(percent) of the requests multiplexed on the connection
+  /// @return -1: unknown
+  int GetLoad() const;
+
   void CloseConnection();
 
+  /// @brief Hold the connector for a call before using it, it fails if the connector is draining
+  bool Acquire();
+
+  /// @brief Release the connector held by `Acquire` once the call is done
+  void Release();
+
+  /// @brief Stop the connector from taking new calls, and close the connection once the calls held are all done
+  /// @note The connector should have been removed from the connector group before
+  void Drain();
+
   uint64_t GetConnId() { return options_.conn_id; }
 
   Connection* GetConnection() { return connection_.Get(); }
@@ -89,7 +104,12 @@ class FiberTcpConnComplexConnector final : public RefCounted<FiberTcpConnComplex
 
   std::atomic<bool> cleanup_{false};
 
-  RefPtr<FiberTcpConnection> connection_;
+  std::atomic<bool> draining_{false};
+
+  // Number of the calls holding the connector.
+  std::atomic<uint32_t> acquired_calls_{0};
+
+  RefPtr<FiberConnection> connection_;
 
   RefPtr<CallMap> call_map_;
 };
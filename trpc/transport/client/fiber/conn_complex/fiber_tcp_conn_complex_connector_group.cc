@@ -13,6 +13,10 @@
 
 #include "trpc/transport/client/fiber/conn_complex/fiber_tcp_conn_complex_connector_group.h"
 
+#include <algorithm>
+#include <limits>
+#include <optional>
+
 #include "trpc/coroutine/fiber_event.h"
 #include "trpc/stream/stream.h"
 #include "trpc/transport/client/fiber/common/fiber_client_connection_handler.h"
@@ -23,8 +27,9 @@ namespace trpc {
 FiberTcpConnComplexConnectorGroup::FiberTcpConnComplexConnectorGroup(const FiberConnectorGroup::Options& options)
     : options_(options) {
   max_conn_num_ = options_.trans_info->max_conn_num;
-  if (max_conn_num_ == 64) {
-    // If max_conn_num is the default value of 64, change it to 1
+  if (max_conn_num_ == 64 && options_.trans_info->conn_scale_load_threshold == 0) {
+    // If max_conn_num is the default value of 64, change it to 1.
+    // When scaling by load, it's the upper limit of the connections, so keep it.
     max_conn_num_ = 1;
   }
 
@@ -85,6 +90,7 @@ int FiberTcpConnComplexConnectorGroup::SendRecv(CTransportReqMsg* req_msg, CTran
 
       e.Wait();
     }
+    connector->Release();
   }
 
   return ret;
@@ -97,7 +103,8 @@ Future<CTransportRspMsg> FiberTcpConnComplexConnectorGroup::AsyncSendRecv(CTrans
     auto fut = promise.GetFuture();
     CTransportRspMsg* rsp_msg = trpc::object_pool::New<CTransportRspMsg>();
     bool flag = connector->SaveCallContext(
-        req_msg, rsp_msg, [promise = std::move(promise), rsp_msg](uint32_t err_code, std::string&& err_msg) mutable {
+        req_msg, rsp_msg,
+        [promise = std::move(promise), rsp_msg, connector](uint32_t err_code, std::string&& err_msg) mutable {
           if (err_code == 0) {
             promise.SetValue(std::move(*rsp_msg));
           } else {
@@ -105,6 +112,7 @@ Future<CTransportRspMsg> FiberTcpConnComplexConnectorGroup::AsyncSendRecv(CTrans
             promise.SetException(CommonException(err_msg.c_str(), err_code));
           }
           trpc::object_pool::Delete(rsp_msg);
+          connector->Release();
         });
     if (flag) {
       connector->SendReqMsg(req_msg);
@@ -120,6 +128,7 @@ int FiberTcpConnComplexConnectorGroup::SendOnly(CTransportReqMsg* req_msg) {
   RefPtr<FiberTcpConnComplexConnector> connector = GetOrCreate();
   if (connector != nullptr) {
     connector->SendReqMsg(req_msg);
+    connector->Release();
     return 0;
   }
 
@@ -130,7 +139,11 @@ void FiberTcpConnComplexConnectorGroup::SendRecvForBackupRequest(CTransportReqMs
                                                                  OnCompletionFunction&& cb) {
   RefPtr<FiberTcpConnComplexConnector> connector = GetOrCreate();
   if (connector != nullptr) {
-    bool flag = connector->SaveCallContext(req_msg, rsp_msg, std::move(cb));
+    bool flag = connector->SaveCallContext(
+        req_msg, rsp_msg, [cb = std::move(cb), connector](uint32_t err_code, std::string&& err_msg) mutable {
+          cb(err_code, std::move(err_msg));
+          connector->Release();
+        });
     if (flag) {
       connector->SendReqMsg(req_msg);
     }
@@ -161,13 +174,135 @@ stream::StreamReaderWriterProviderPtr FiberTcpConnComplexConnectorGroup::CreateS
   stream_options.fiber_mode = true;
   stream_options.server_mode = false;
 
-  return stream_handler->CreateStream(std::move(stream_options));
+  auto stream = stream_handler->CreateStream(std::move(stream_options));
+  // The stream is counted in the load of the connection, so the connection is not closed as idle with it.
+  connector->Release();
+  return stream;
 }
 
 RefPtr<FiberTcpConnComplexConnector> FiberTcpConnComplexConnectorGroup::GetOrCreate() {
-  size_t index = index_.fetch_add(1, std::memory_order_relaxed);
-  size_t uid = index % max_conn_num_;
+  // The connector picked may be drained(closed as idle) by another thread meanwhile, then it's replaced in the
+  // group, so pick again.
+  constexpr int kMaxPickTimes = 3;
+
+  for (int i = 0; i < kMaxPickTimes; ++i) {
+    RefPtr<FiberTcpConnComplexConnector> connector{nullptr};
+    if (options_.trans_info->conn_scale_load_threshold > 0) {
+      connector = GetLeastLoaded();
+    } else {
+      size_t index = index_.fetch_add(1, std::memory_order_relaxed);
+      connector = GetOrCreate(index % max_conn_num_);
+    }
+
+    if (connector == nullptr || connector->Acquire()) {
+      return connector;
+    }
+  }
+
+  return nullptr;
+}
+
+RefPtr<FiberTcpConnComplexConnector> FiberTcpConnComplexConnectorGroup::GetLeastLoaded() {
+  size_t active_conn_num = active_conn_num_.load(std::memory_order_acquire);
+
+  RefPtr<FiberTcpConnComplexConnector> connector{nullptr};
+  RefPtr<FiberTcpConnComplexConnector> last_connector{nullptr};
+  size_t connector_uid = 0;
+  int min_load = std::numeric_limits<int>::max();
+  std::optional<size_t> empty_uid;
+
+  for (size_t uid = 0; uid < active_conn_num; ++uid) {
+    Hazptr hazptr;
+    auto ptr = hazptr.Keep(&(conn_impl_[uid].impl));
+    if (!ptr) {
+      // Stopped.
+      return nullptr;
+    }
+
+    if (ptr->tcp_conn == nullptr || !ptr->tcp_conn->IsHealthy()) {
+      if (!empty_uid) {
+        empty_uid = uid;
+      }
+      continue;
+    }
+
+    // Ties go to the lower slot, so that the higher ones become idle when the load drops.
+    int load = std::max(ptr->tcp_conn->GetLoad(), 0);
+    if (load < min_load) {
+      min_load = load;
+      connector = ptr->tcp_conn;
+      connector_uid = uid;
+    }
+    if (uid == active_conn_num - 1) {
+      last_connector = ptr->tcp_conn;
+    }
+  }
+
+  if (connector == nullptr) {
+    return GetOrCreate(empty_uid.value_or(0));
+  }
+
+  if (min_load >= static_cast<int>(options_.trans_info->conn_scale_load_threshold)) {
+    // All the connections are busy, reopen a closed one or open a new one.
+    RefPtr<FiberTcpConnComplexConnector> new_connector{nullptr};
+    if (empty_uid) {
+      new_connector = GetOrCreate(*empty_uid);
+    } else if (active_conn_num < max_conn_num_ &&
+               active_conn_num_.compare_exchange_strong(active_conn_num, active_conn_num + 1,
+                                                        std::memory_order_acq_rel)) {
+      TRPC_LOG_DEBUG("scale up connections to " << active_conn_num + 1 << ", load:" << min_load
+                                                << ", ip:" << options_.peer_addr.Ip()
+                                                << ", port:" << options_.peer_addr.Port());
+      new_connector = GetOrCreate(active_conn_num);
+    }
+    return new_connector != nullptr ? new_connector : connector;
+  }
+
+  if (last_connector != nullptr && last_connector.Get() != connector.Get() && last_connector->GetLoad() <= 0 &&
+      last_connector->IsConnIdleTimeout()) {
+    CloseIdleConnector(active_conn_num);
+  }
+
+  if (connector->IsConnIdleTimeout()) {
+    // Replaced by a new connection.
+    return GetOrCreate(connector_uid);
+  }
+
+  return connector;
+}
+
+void FiberTcpConnComplexConnectorGroup::CloseIdleConnector(size_t active_conn_num) {
+  if (!active_conn_num_.compare_exchange_strong(active_conn_num, active_conn_num - 1, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  size_t uid = active_conn_num - 1;
+  RefPtr<FiberTcpConnComplexConnector> idle_connector{nullptr};
+  {
+    std::scoped_lock _(conn_impl_[uid].mut);
+
+    {
+      Hazptr hazptr;
+      auto ptr = hazptr.Keep(&(conn_impl_[uid].impl));
+      if (!ptr) {
+        return;
+      }
+      idle_connector = ptr->tcp_conn;
+    }
+
+    conn_impl_[uid].impl.exchange(std::make_unique<Impl>().release(), std::memory_order_relaxed)->Retire();
+  }
+
+  TRPC_LOG_DEBUG("scale down connections to " << uid << ", ip:" << options_.peer_addr.Ip()
+                                              << ", port:" << options_.peer_addr.Port());
+
+  if (idle_connector) {
+    // The calls which picked it before it was removed still go on it.
+    idle_connector->Drain();
+  }
+}
 
+RefPtr<FiberTcpConnComplexConnector> FiberTcpConnComplexConnectorGroup::GetOrCreate(size_t uid) {
   RefPtr<FiberTcpConnComplexConnector> connector{nullptr};
   {
     Hazptr hazptr;
@@ -204,7 +339,6 @@ RefPtr<FiberTcpConnComplexConnector> FiberTcpConnComplexConnectorGroup::GetOrCre
           return connector;
         } else {
           conn_id = connector->GetConnId() + max_conn_num_;
-          connector->SetHealthy(false);
           idle_connector = connector;
         }
       } else {
@@ -233,7 +367,7 @@ RefPtr<FiberTcpConnComplexConnector> FiberTcpConnComplexConnectorGroup::GetOrCre
   if (idle_connector) {
     TRPC_LOG_DEBUG("connection uid:" << idle_connector->GetConnId() << ", ip:" << options_.peer_addr.Ip()
                                      << ", port:" << options_.peer_addr.Port() << ", idle timeout.");
-    idle_connector->CloseConnection();
+    idle_connector->Drain();
   }
 
   return connector;
@@ -31,6 +31,11 @@ namespace trpc {
 /// including the creation/release of the connection connector,
 /// and the distribution of requests to connections, etc.
 /// @note Using this class requires request/response to have unique id
+/// @note If `conn_scale_load_threshold` of trans_info is set, the connections are scaled by their load instead of
+///       round-robin: the request goes to the least loaded connection, a new connection is opened when all the
+///       connections reach the threshold, and the extra connections are closed after idle timeout.
+/// @note A connector closed as idle or replaced is drained first: the calls which picked it still go on it, and the
+///       connection is closed once they are all done.
 class FiberTcpConnComplexConnectorGroup final : public FiberConnectorGroup {
  public:
   explicit FiberTcpConnComplexConnectorGroup(const FiberConnectorGroup::Options& options);
@@ -56,8 +61,14 @@ class FiberTcpConnComplexConnectorGroup final : public FiberConnectorGroup {
 
   bool DelConnector(FiberTcpConnComplexConnector* connector);
 
+  /// @brief Framework use or for testing. Get the number of the connections in use when scaling by load.
+  size_t GetActiveConnNum() const { return active_conn_num_.load(std::memory_order_acquire); }
+
  private:
   RefPtr<FiberTcpConnComplexConnector> GetOrCreate();
+  RefPtr<FiberTcpConnComplexConnector> GetOrCreate(size_t uid);
+  RefPtr<FiberTcpConnComplexConnector> GetLeastLoaded();
+  void CloseIdleConnector(size_t active_conn_num);
   RefPtr<FiberTcpConnComplexConnector> CreateTcpConnComplexConnector(uint64_t conn_id);
 
  private:
@@ -76,6 +87,9 @@ class FiberTcpConnComplexConnectorGroup final : public FiberConnectorGroup {
 
   std::atomic<size_t> index_{0};
 
+  // Number of the connections in use(the slots [0, active_conn_num_)) when scaling by load.
+  std::atomic<size_t> active_conn_num_{1};
+
   std::unique_ptr<ConnectorImpl[]> conn_impl_;
 
   std::vector<RefPtr<FiberTcpConnComplexConnector>> destroy_tcp_conns_;
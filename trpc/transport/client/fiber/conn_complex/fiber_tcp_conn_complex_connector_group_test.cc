@@ -0,0 +1,212 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/transport/client/fiber/conn_complex/fiber_tcp_conn_complex_connector_group.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/testing/client_context_testing.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/transport/client/fiber/common/fiber_client_connection_handler_factory.h"
+#include "trpc/transport/client/fiber/testing/fake_server.h"
+#include "trpc/transport/client/fiber/testing/thread_model_op.h"
+
+namespace trpc::testing {
+
+constexpr uint32_t kMaxConnNum = 3;
+
+// Load of the connections, indexed by the connection id % kMaxConnNum.
+std::array<std::atomic<int>, kMaxConnNum> connection_loads;
+std::atomic<int> created_handlers{0};
+std::atomic<int> stopped_handlers{0};
+
+// The load of the connection is set by the test, instead of the streams multiplexed on it.
+class LoadTestConnectionHandler : public FiberClientConnectionHandler {
+ public:
+  LoadTestConnectionHandler(Connection* conn, TransInfo* trans_info) : FiberClientConnectionHandler(conn, trans_info) {}
+
+  void Init() override { created_handlers.fetch_add(1); }
+
+  void Stop() override { stopped_handlers.fetch_add(1); }
+
+  int GetLoad() override { return connection_loads[GetConnection()->GetConnId() % kMaxConnNum].load(); }
+};
+
+class FiberTcpConnComplexConnectorGroupTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    FiberClientConnectionHandlerFactory::GetInstance()->Register(
+        "load_test", [](Connection* conn, TransInfo* trans_info) {
+          return std::make_unique<LoadTestConnectionHandler>(conn, trans_info);
+        });
+
+    fake_server = std::make_unique<FakeServer>();
+    fake_server->StartTcpServer();
+  }
+
+  static void TearDownTestCase() {
+    fake_server->StopServer();
+    fake_server.reset();
+
+    FiberClientConnectionHandlerFactory::GetInstance()->Clear();
+  }
+
+ protected:
+  void SetUp() override {
+    for (auto& load : connection_loads) {
+      load = 0;
+    }
+    created_handlers = 0;
+    stopped_handlers = 0;
+
+    trans_info_ = MakeTransInfo();
+    trans_info_.protocol = "load_test";
+    trans_info_.max_conn_num = kMaxConnNum;
+    trans_info_.conn_scale_load_threshold = 50;
+
+    FiberConnectorGroup::Options options;
+    options.trans_info = &trans_info_;
+    options.peer_addr = fake_server->GetServerAddr();
+    options.is_ipv6 = false;
+    group_ = std::make_unique<FiberTcpConnComplexConnectorGroup>(options);
+  }
+
+  void TearDown() override {
+    group_->Stop();
+    group_->Destroy();
+  }
+
+  int SendRecv() {
+    uint32_t seq_id = id_gen.fetch_add(1);
+    CTransportReqMsg req_msg;
+    req_msg.context = MakeTestClientContext(seq_id, 1000, fake_server->GetServerAddr());
+
+    TestProtocol out;
+    out.req_id_ = seq_id;
+    out.body_ = "hello";
+    out.ZeroCopyEncode(req_msg.send_data);
+
+    CTransportRspMsg rsp_msg;
+    return group_->SendRecv(&req_msg, &rsp_msg);
+  }
+
+  static bool WaitFor(const std::atomic<int>& value, int expected) {
+    for (int i = 0; i < 100 && value.load() != expected; ++i) {
+      FiberSleepFor(std::chrono::milliseconds(10));
+    }
+    return value.load() == expected;
+  }
+
+ protected:
+  static std::unique_ptr<FakeServer> fake_server;
+  static std::atomic<uint32_t> id_gen;
+
+  TransInfo trans_info_;
+  std::unique_ptr<FiberTcpConnComplexConnectorGroup> group_;
+};
+
+std::unique_ptr<FakeServer> FiberTcpConnComplexConnectorGroupTest::fake_server = nullptr;
+std::atomic<uint32_t> FiberTcpConnComplexConnectorGroupTest::id_gen = 1;
+
+TEST_F(FiberTcpConnComplexConnectorGroupTest, ScaleUpUnderLoad) {
+  ASSERT_EQ(0, SendRecv());
+  ASSERT_EQ(1, created_handlers);
+  ASSERT_EQ(1, group_->GetActiveConnNum());
+
+  // Below the threshold, no more connection.
+  connection_loads[0] = 40;
+  ASSERT_EQ(0, SendRecv());
+  ASSERT_EQ(1, created_handlers);
+
+  // All the connections are busy, open a new one.
+  connection_loads[0] = 80;
+  ASSERT_EQ(0, SendRecv());
+  ASSERT_EQ(2, created_handlers);
+  ASSERT_EQ(2, group_->GetActiveConnNum());
+
+  // The call goes to the least loaded connection.
+  connection_loads[1] = 10;
+  ASSERT_EQ(0, SendRecv());
+  ASSERT_EQ(2, created_handlers);
+
+  connection_loads[1] = 90;
+  ASSERT_EQ(0, SendRecv());
+  ASSERT_EQ(3, created_handlers);
+  ASSERT_EQ(3, group_->GetActiveConnNum());
+
+  // Up to max_conn_num.
+  connection_loads[2] = 100;
+  ASSERT_EQ(0, SendRecv());
+  ASSERT_EQ(3, created_handlers);
+  ASSERT_EQ(3, group_->GetActiveConnNum());
+  ASSERT_EQ(0, stopped_handlers);
+}
+
+TEST_F(FiberTcpConnComplexConnectorGroupTest, CloseIdleConnection) {
+  trans_info_.connection_idle_timeout = 100;
+
+  ASSERT_EQ(0, SendRecv());
+  connection_loads[0] = 80;
+  ASSERT_EQ(0, SendRecv());
+  ASSERT_EQ(2, group_->GetActiveConnNum());
+
+  // The load drops, the calls go to the first connection(ties go to the lower one), the second becomes idle.
+  connection_loads[0] = 0;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(0, SendRecv());
+    FiberSleepFor(std::chrono::milliseconds(20));
+  }
+
+  ASSERT_EQ(1, group_->GetActiveConnNum());
+  ASSERT_TRUE(WaitFor(stopped_handlers, 1));
+  // The first connection is kept as it's in use.
+  ASSERT_EQ(2, created_handlers);
+  ASSERT_EQ(0, SendRecv());
+  ASSERT_EQ(2, created_handlers);
+}
+
+TEST_F(FiberTcpConnComplexConnectorGroupTest, DrainWaitsForCallsAcquired) {
+  NetworkAddress peer_addr = fake_server->GetServerAddr();
+  FiberTcpConnComplexConnector::Options options;
+  options.conn_id = 0;
+  options.trans_info = &trans_info_;
+  options.peer_addr = &peer_addr;
+  options.connector_group = group_.get();
+  auto connector = MakeRefCounted<FiberTcpConnComplexConnector>(options);
+  ASSERT_TRUE(connector->Init());
+
+  // A call picked the connector before it's drained.
+  ASSERT_TRUE(connector->Acquire());
+  connector->Drain();
+  ASSERT_FALSE(connector->Acquire());
+
+  FiberSleepFor(std::chrono::milliseconds(50));
+  ASSERT_EQ(0, stopped_handlers);
+
+  // Closed by the last call done.
+  connector->Release();
+  ASSERT_TRUE(WaitFor(stopped_handlers, 1));
+  connector->Destroy();
+}
+
+}  // namespace trpc::testing
+
+TEST_WITH_FIBER_MAIN
@@ -13,6 +13,7 @@
 
 #include "trpc/transport/client/fiber/conn_complex/fiber_udp_io_complex_connector.h"
 
+#include <chrono>
 #include <limits>
 #include <mutex>
 #include <utility>
@@ -76,6 +77,8 @@ bool FiberUdpIoComplexConnector::CreateFiberUdpTransceiver(uint64_t conn_id) {
   conn->SetRecvBufferSize(options_.trans_info->recv_buffer_size);
   conn->SetSendQueueCapacity(options_.trans_info->send_queue_capacity);
   conn->SetSendQueueTimeout(options_.trans_info->send_queue_timeout);
+  conn->SetBatchOptions(options_.trans_info->udp_batch_size,
+                        std::chrono::microseconds(options_.trans_info->udp_batch_max_delay_us));
   conn->SetConnId(options_.conn_id);
   conn->SetClient();
 
@@ -84,6 +87,10 @@ bool FiberUdpIoComplexConnector::CreateFiberUdpTransceiver(uint64_t conn_id) {
   conn_handler->SetMsgHandleFunc([this](const ConnectionPtr& conn, std::deque<std::any>& data) {
     return this->MessageHandleFunction(conn, data);
   });
+  // The request whose packet is dropped by the transceiver(eg: failed in a batch) fails now rather than timeout.
+  conn_handler->SetMsgFailedFunc([this](const IoMessage& message, ConnectionErrorCode) {
+    this->MessageFailedFunction(message);
+  });
   conn_handler->Init();
 
   conn->SetConnectionHandler(std::move(conn_handler));
@@ -172,6 +179,11 @@ bool FiberUdpIoComplexConnector::MessageHandleFunction(const ConnectionPtr& conn
   return conn_reusable;
 }
 
+void FiberUdpIoComplexConnector::MessageFailedFunction(const IoMessage& message) {
+  DispatchException(message.seq_id, TrpcRetCode::TRPC_CLIENT_NETWORK_ERR, "network send error", std::string(message.ip),
+                    message.port);
+}
+
 void FiberUdpIoComplexConnector::SaveCallContext(CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg,
                                                  OnCompletionFunction&& cb) {
   uint32_t request_id = req_msg->context->GetRequestId();
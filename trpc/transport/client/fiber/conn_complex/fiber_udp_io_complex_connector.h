@@ -58,6 +58,7 @@ class FiberUdpIoComplexConnector final : public RefCounted<FiberUdpIoComplexConn
 
  private:
   bool MessageHandleFunction(const ConnectionPtr& conn, std::deque<std::any>& rsp_list);
+  void MessageFailedFunction(const IoMessage& message);
   bool CreateFiberUdpTransceiver(uint64_t conn_id);
   uint64_t CreateTimer(CTransportReqMsg* req_msg);
   void OnTimeout(uint32_t req_id, std::string&& ip, int port);
@@ -28,6 +28,7 @@
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_udp_transceiver.h"
 #include "trpc/transport/client/common/client_io_handler_factory.h"
+#include "trpc/transport/client/fiber/common/fiber_client_connection.h"
 #include "trpc/transport/client/fiber/common/fiber_client_connection_handler.h"
 #include "trpc/transport/client/fiber/common/fiber_client_connection_handler_factory.h"
 #include "trpc/util/likely.h"
@@ -70,39 +71,12 @@ void FiberTcpConnPoolConnector::Destroy() {
 }
 
 bool FiberTcpConnPoolConnector::CreateFiberTcpConnection(uint64_t conn_id) {
-  auto socket = Socket::CreateTcpSocket(options_.peer_addr->IsIpv6());
-  if (!socket.IsValid()) {
-    TRPC_LOG_ERROR("create tcp socket failed on peer addr:" << options_.peer_addr->ToString());
+  RefPtr<FiberConnection> conn =
+      CreateFiberClientConnection(options_.conn_id, *options_.peer_addr, options_.trans_info);
+  if (conn == nullptr) {
     return false;
   }
 
-  socket.SetTcpNoDelay();
-  socket.SetCloseWaitDefault();
-  socket.SetBlock(false);
-  socket.SetKeepAlive();
-
-  if (options_.trans_info->set_socket_opt_function) {
-    options_.trans_info->set_socket_opt_function(socket);
-  }
-
-  Reactor* reactor = trpc::fiber::GetReactor(trpc::fiber::GetCurrentSchedulingGroupIndex(), -2);
-  TRPC_ASSERT(reactor != nullptr && "reactor is null");
-
-  auto conn = MakeRefCounted<FiberTcpConnection>(reactor, socket);
-  std::unique_ptr<IoHandler> io_handler =
-      ClientIoHandlerFactory::GetInstance()->Create(options_.trans_info->protocol, conn.Get(), options_.trans_info);
-
-  conn->SetMaxPacketSize(options_.trans_info->max_packet_size);
-  conn->SetRecvBufferSize(options_.trans_info->recv_buffer_size);
-  conn->SetSendQueueCapacity(options_.trans_info->send_queue_capacity);
-  conn->SetSendQueueTimeout(options_.trans_info->send_queue_timeout);
-  conn->SetConnId(options_.conn_id);
-  conn->SetClient();
-  conn->SetPeerIp(options_.peer_addr->Ip());
-  conn->SetPeerPort(options_.peer_addr->Port());
-  conn->SetPeerIpType(options_.peer_addr->Type());
-  conn->SetIoHandler(std::move(io_handler));
-
   this->Ref();
   auto conn_handler = FiberClientConnectionHandlerFactory::GetInstance()->Create(options_.trans_info->protocol,
                                                                                  conn.Get(), options_.trans_info);
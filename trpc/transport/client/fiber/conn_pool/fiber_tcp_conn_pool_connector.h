@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/transport/client/client_transport_message.h"
 #include "trpc/transport/client/fiber/common/call_context.h"
@@ -91,7 +92,7 @@ class FiberTcpConnPoolConnector final : public RefCounted<FiberTcpConnPoolConnec
 
   std::atomic<bool> cleanup_{false};
 
-  RefPtr<FiberTcpConnection> connection_;
+  RefPtr<FiberConnection> connection_;
 
   std::mutex mutex_;
 
@@ -13,6 +13,7 @@
 
 #include "trpc/transport/client/fiber/conn_pool/fiber_udp_io_pool_connector.h"
 
+#include <chrono>
 #include <limits>
 #include <mutex>
 #include <utility>
@@ -81,6 +82,9 @@ bool FiberUdpIoPoolConnector::CreateFiberUdpTransceiver(uint64_t conn_id) {
   conn->SetRecvBufferSize(options_.trans_info->recv_buffer_size);
   conn->SetSendQueueCapacity(options_.trans_info->send_queue_capacity);
   conn->SetSendQueueTimeout(options_.trans_info->send_queue_timeout);
+  // The connection is used by one request at a time, the batch never fills up and waiting for it only adds latency,
+  // so `udp_batch_max_delay_us` is ignored here.
+  conn->SetBatchOptions(options_.trans_info->udp_batch_size, std::chrono::microseconds(0));
   conn->SetConnId(options_.conn_id);
   conn->SetClient();
 
@@ -89,6 +93,10 @@ bool FiberUdpIoPoolConnector::CreateFiberUdpTransceiver(uint64_t conn_id) {
   conn_handler->SetMsgHandleFunc([this](const ConnectionPtr& conn, std::deque<std::any>& data) {
     return this->MessageHandleFunction(conn, data);
   });
+  // The request whose packet is dropped by the transceiver(eg: failed in a batch) fails now rather than timeout.
+  conn_handler->SetMsgFailedFunc([this](const IoMessage& message, ConnectionErrorCode) {
+    this->MessageFailedFunction(message);
+  });
   conn_handler->Init();
 
   conn->SetConnectionHandler(std::move(conn_handler));
@@ -162,6 +170,19 @@ bool FiberUdpIoPoolConnector::MessageHandleFunction(const ConnectionPtr& conn, s
   return conn_reusable;
 }
 
+void FiberUdpIoPoolConnector::MessageFailedFunction(const IoMessage& message) {
+  object_pool::LwUniquePtr<CallContext> ctx{nullptr};
+  {
+    std::scoped_lock _(mutex_);
+    if (ctx_ != nullptr && ctx_->req_msg->context->GetRequestId() == message.seq_id) {
+      ctx = std::move(ctx_);
+    }
+  }
+
+  DispatchException(std::move(ctx), TrpcRetCode::TRPC_CLIENT_NETWORK_ERR, "network send error",
+                    std::string(message.ip), message.port);
+}
+
 void FiberUdpIoPoolConnector::SaveCallContext(CTransportReqMsg* req_msg, CTransportRspMsg* rsp_msg,
                                               OnCompletionFunction&& cb) {
   auto ptr = object_pool::MakeLwUnique<CallContext>();
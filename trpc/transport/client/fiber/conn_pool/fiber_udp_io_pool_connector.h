@@ -60,6 +60,7 @@ class FiberUdpIoPoolConnector final : public RefCounted<FiberUdpIoPoolConnector>
 
  private:
   bool MessageHandleFunction(const ConnectionPtr& conn, std::deque<std::any>& rsp_list);
+  void MessageFailedFunction(const IoMessage& message);
   bool CreateFiberUdpTransceiver(uint64_t conn_id);
   uint64_t CreateTimer(uint32_t request_id, CTransportReqMsg* req_msg);
   void OnTimeout(uint32_t req_id, std::string&& ip, int port);
@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/transport/client/client_transport_message.h"
 #include "trpc/transport/client/fiber/common/sharded_call_map.h"
@@ -96,7 +97,7 @@ class FiberTcpPipelineConnector final : public RefCounted<FiberTcpPipelineConnec
 
   std::atomic<bool> cleanup_{false};
 
-  RefPtr<FiberTcpConnection> connection_;
+  RefPtr<FiberConnection> connection_;
 
   RefPtr<CallMap> call_map_;
 
@@ -14,12 +14,14 @@
 #pragma once
 
 #include <any>
+#include <memory>
 #include <string>
 
 #include "trpc/codec/protocol.h"
 #include "trpc/filter/filter.h"
 #include "trpc/filter/filter_point.h"
 #include "trpc/runtime/iomodel/reactor/common/connection.h"
+#include "trpc/runtime/iomodel/reactor/common/egress_shaper.h"
 #include "trpc/runtime/threadmodel/common/msg_task.h"
 #ifdef TRPC_BUILD_INCLUDE_SSL
 #include "trpc/transport/common/ssl/ssl.h"
@@ -59,6 +61,9 @@ struct TransInfo {
   /// Whether to use connection multiplexing
   bool is_complex_conn = true;
 
+  /// Whether to talk to the server on the same host through shared memory instead of tcp(for fiber)
+  bool use_shm = false;
+
   /// Whether to support pipeline
   bool support_pipeline = false;
 
@@ -102,6 +107,22 @@ struct TransInfo {
   /// if memory usage high, reduce it
   uint32_t fiber_pipeline_connector_queue_size = 16 * 1024;
 
+  /// The max number of datagrams sent/received by one sendmmsg/recvmmsg call of fiber udp connection
+  uint32_t udp_batch_size = 1;
+
+  /// The max delay(us) a datagram may wait for the batch of fiber udp connection to fill up
+  uint32_t udp_batch_max_delay_us = 0;
+
+  /// The egress bandwidth limit(bytes per second) of each fiber tcp connection, 0 means not limited
+  uint64_t conn_egress_rate_limit = 0;
+
+  /// The egress token bucket shared by all the fiber tcp connections, nullptr means not limited
+  std::shared_ptr<TokenBucket> egress_bucket;
+
+  /// The load(percent) of the fiber conn-complex connections above which a new connection is opened,
+  /// 0 means the connections are selected by round-robin
+  uint32_t conn_scale_load_threshold = 0;
+
   /// The callback function when connection establish
   ConnectionEstablishFunction conn_establish_function = nullptr;
 
@@ -0,0 +1,417 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/transport/server/common/listener_handoff.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+// Messages of the handoff, one message per packet of the SOCK_SEQPACKET connection:
+// new process: kTakeover                                          kReady
+// old process:           kListener(with fd) ... kListener kEnd
+constexpr std::string_view kTakeover = "takeover";
+constexpr std::string_view kListener = "listener ";
+constexpr std::string_view kEnd = "end";
+constexpr std::string_view kReady = "ready";
+
+constexpr std::size_t kMaxMessageSize = 4096;
+
+// Interval(ms) of checking whether to stop serving.
+constexpr int kServePollIntervalMs = 100;
+
+void SetTimeout(int fd, uint32_t timeout_ms) {
+  struct timeval tv;
+  tv.tv_sec = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+  ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+bool MakeUnixAddress(const std::string& path, struct sockaddr_un* addr) {
+  if (path.empty() || path.size() >= sizeof(addr->sun_path)) {
+    TRPC_FMT_ERROR("invalid hot restart path: {}", path);
+    return false;
+  }
+  memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  memcpy(addr->sun_path, path.data(), path.size());
+  return true;
+}
+
+// Sends a message, with the fd attached if `fd` >= 0.
+bool SendMessage(int sock, std::string_view payload, int fd = -1) {
+  struct iovec iov;
+  iov.iov_base = const_cast<char*>(payload.data());
+  iov.iov_len = payload.size();
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+
+  alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+  if (fd >= 0) {
+    memset(control, 0, sizeof(control));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+  }
+
+  while (true) {
+    ssize_t n = ::sendmsg(sock, &msg, MSG_NOSIGNAL);
+    if (n == static_cast<ssize_t>(payload.size())) {
+      return true;
+    }
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    TRPC_FMT_ERROR("send hot restart message failed: {}", n < 0 ? strerror(errno) : "truncated");
+    return false;
+  }
+}
+
+// Receives a message, `fd` is set to the fd attached or -1.
+bool RecvMessage(int sock, std::string* payload, int* fd) {
+  char buffer[kMaxMessageSize];
+  struct iovec iov;
+  iov.iov_base = buffer;
+  iov.iov_len = sizeof(buffer);
+
+  alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t n = 0;
+  do {
+    n = ::recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+  } while (n < 0 && errno == EINTR);
+
+  *fd = -1;
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); n > 0 && cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+      memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+  }
+
+  if (n <= 0 || (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+    if (*fd >= 0) {
+      ::close(*fd);
+      *fd = -1;
+    }
+    if (n < 0) {
+      TRPC_FMT_ERROR("recv hot restart message failed: {}", strerror(errno));
+    }
+    return false;
+  }
+
+  payload->assign(buffer, n);
+  return true;
+}
+
+// Whether the peer of the unix socket runs as the effective user of this process, the listening sockets are never
+// handed to or taken from processes of other users.
+bool IsPeerSameUser(int sock) {
+  struct ucred cred;
+  socklen_t len = sizeof(cred);
+  if (::getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+    TRPC_FMT_ERROR("get hot restart peer credentials failed: {}", strerror(errno));
+    return false;
+  }
+  if (cred.uid != ::geteuid()) {
+    TRPC_FMT_ERROR("hot restart peer(pid: {}, uid: {}) is not of the user {}, refused.", cred.pid, cred.uid,
+                   ::geteuid());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+ListenerHandoff* ListenerHandoff::GetInstance() {
+  static ListenerHandoff instance;
+  return &instance;
+}
+
+ListenerHandoff::~ListenerHandoff() {
+  StopServing();
+  CancelTakeover();
+}
+
+void ListenerHandoff::AddListener(const std::string& key, int fd) {
+  std::scoped_lock lock(listeners_mutex_);
+  listeners_.emplace(key, fd);
+}
+
+void ListenerHandoff::RemoveListener(int fd) {
+  std::scoped_lock lock(listeners_mutex_);
+  for (auto it = listeners_.begin(); it != listeners_.end(); ++it) {
+    if (it->second == fd) {
+      listeners_.erase(it);
+      return;
+    }
+  }
+}
+
+bool ListenerHandoff::Serve(const std::string& path, Function<void()>&& on_handoff) {
+  TRPC_ASSERT(!serve_thread_.joinable() && "ListenerHandoff is serving already");
+
+  struct sockaddr_un addr;
+  if (!MakeUnixAddress(path, &addr)) {
+    return false;
+  }
+
+  int fd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    TRPC_FMT_ERROR("create hot restart socket failed: {}", strerror(errno));
+    return false;
+  }
+
+  // The path may be still bound by the old process which has handed the listening sockets over, or left by a
+  // process exited abnormally.
+  ::unlink(path.c_str());
+  struct stat st;
+  // Only the owner can connect(which needs the write permission), it's done before listening so that no one else can
+  // connect in between.
+  if (::bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 || ::chmod(path.c_str(), 0600) != 0 ||
+      ::listen(fd, 8) != 0 || ::stat(path.c_str(), &st) != 0) {
+    TRPC_FMT_ERROR("serve hot restart at {} failed: {}", path, strerror(errno));
+    ::close(fd);
+    return false;
+  }
+
+  serve_path_ = path;
+  serve_fd_ = fd;
+  serve_ino_ = st.st_ino;
+  on_handoff_ = std::move(on_handoff);
+  serving_ = true;
+  serve_thread_ = std::thread([this] { ServeLoop(); });
+
+  TRPC_FMT_INFO("serve hot restart at {}", path);
+  return true;
+}
+
+void ListenerHandoff::StopServing() {
+  serving_ = false;
+  if (serve_thread_.joinable()) {
+    serve_thread_.join();
+  }
+}
+
+void ListenerHandoff::ServeLoop() {
+  bool handed_off = false;
+  while (serving_ && !handed_off) {
+    struct pollfd pfd{serve_fd_, POLLIN, 0};
+    if (::poll(&pfd, 1, kServePollIntervalMs) <= 0) {
+      continue;
+    }
+
+    int conn_fd = ::accept4(serve_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (conn_fd < 0) {
+      continue;
+    }
+    handed_off = HandleTakeover(conn_fd);
+    ::close(conn_fd);
+  }
+
+  ::close(serve_fd_);
+  serve_fd_ = -1;
+
+  // The path belongs to the new process once it has taken over.
+  struct stat st;
+  if (!handed_off && ::stat(serve_path_.c_str(), &st) == 0 && st.st_ino == serve_ino_) {
+    ::unlink(serve_path_.c_str());
+  }
+
+  if (handed_off) {
+    TRPC_FMT_INFO("listening sockets are handed over to the new process.");
+    on_handoff_();
+  }
+}
+
+bool ListenerHandoff::HandleTakeover(int conn_fd) {
+  if (!IsPeerSameUser(conn_fd)) {
+    return false;
+  }
+  SetTimeout(conn_fd, 1000);
+
+  std::string payload;
+  int fd = -1;
+  if (!RecvMessage(conn_fd, &payload, &fd) || payload != kTakeover) {
+    TRPC_FMT_ERROR("unexpected hot restart request: {}", payload);
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    return false;
+  }
+
+  {
+    // The sockets can not be closed while being sent.
+    std::scoped_lock lock(listeners_mutex_);
+    for (auto&& [key, listener_fd] : listeners_) {
+      if (!SendMessage(conn_fd, std::string(kListener) + key, listener_fd)) {
+        return false;
+      }
+    }
+    TRPC_FMT_INFO("{} listening sockets are sent to the new process.", listeners_.size());
+  }
+  if (!SendMessage(conn_fd, kEnd)) {
+    return false;
+  }
+
+  // Waits until the new process listens on the sockets, which may take a while since it starts its services then. If
+  // it exits or gives up, this process keeps serving.
+  while (serving_) {
+    struct pollfd pfd{conn_fd, POLLIN, 0};
+    if (::poll(&pfd, 1, kServePollIntervalMs) <= 0) {
+      continue;
+    }
+    if (!RecvMessage(conn_fd, &payload, &fd)) {
+      TRPC_FMT_WARN("the new process gives up the takeover.");
+      return false;
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    return payload == kReady;
+  }
+  return false;
+}
+
+bool ListenerHandoff::Takeover(const std::string& path, uint32_t timeout_ms) {
+  struct sockaddr_un addr;
+  if (!MakeUnixAddress(path, &addr)) {
+    return false;
+  }
+
+  int sock = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (sock < 0) {
+    TRPC_FMT_ERROR("create hot restart socket failed: {}", strerror(errno));
+    return false;
+  }
+  if (::connect(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+    // Cold start.
+    TRPC_FMT_INFO("no process to take over at {}: {}", path, strerror(errno));
+    ::close(sock);
+    return false;
+  }
+  if (!IsPeerSameUser(sock)) {
+    ::close(sock);
+    return false;
+  }
+  SetTimeout(sock, timeout_ms);
+
+  std::scoped_lock lock(inherited_mutex_);
+  TRPC_ASSERT(takeover_fd_ < 0 && "takeover is in progress already");
+  takeover_fd_ = sock;
+
+  if (!SendMessage(sock, kTakeover)) {
+    CloseInherited();
+    return false;
+  }
+
+  while (true) {
+    std::string payload;
+    int fd = -1;
+    if (!RecvMessage(sock, &payload, &fd)) {
+      TRPC_FMT_ERROR("take over the listening sockets at {} failed.", path);
+      CloseInherited();
+      return false;
+    }
+    if (payload == kEnd) {
+      break;
+    }
+    if (fd < 0 || payload.compare(0, kListener.size(), kListener) != 0) {
+      TRPC_FMT_ERROR("unexpected hot restart message: {}", payload);
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      CloseInherited();
+      return false;
+    }
+    inherited_.emplace(payload.substr(kListener.size()), fd);
+  }
+
+  TRPC_FMT_INFO("{} listening sockets are taken over from {}", inherited_.size(), path);
+  return true;
+}
+
+int ListenerHandoff::TakeListener(const std::string& key) {
+  std::scoped_lock lock(inherited_mutex_);
+  auto it = inherited_.find(key);
+  if (it == inherited_.end()) {
+    return -1;
+  }
+  int fd = it->second;
+  inherited_.erase(it);
+  return fd;
+}
+
+bool ListenerHandoff::CompleteTakeover() {
+  std::scoped_lock lock(inherited_mutex_);
+  if (takeover_fd_ < 0) {
+    return false;
+  }
+
+  bool ret = SendMessage(takeover_fd_, kReady);
+  for (auto&& [key, fd] : inherited_) {
+    TRPC_FMT_WARN("listening socket {} inherited is not used, closed.", key);
+  }
+  CloseInherited();
+  return ret;
+}
+
+void ListenerHandoff::CancelTakeover() {
+  std::scoped_lock lock(inherited_mutex_);
+  CloseInherited();
+}
+
+void ListenerHandoff::CloseInherited() {
+  for (auto&& [key, fd] : inherited_) {
+    ::close(fd);
+  }
+  inherited_.clear();
+
+  if (takeover_fd_ >= 0) {
+    ::close(takeover_fd_);
+    takeover_fd_ = -1;
+  }
+}
+
+std::string ListenerHandoff::ListenerKey(std::string_view network, const NetworkAddress& addr) {
+  return std::string(network) + "://" + addr.ToString();
+}
+
+std::string ListenerHandoff::ListenerKey(const UnixAddress& addr) { return std::string("unix://") + addr.Path(); }
+
+}  // namespace trpc
@@ -0,0 +1,115 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "trpc/runtime/iomodel/reactor/common/network_address.h"
+#include "trpc/runtime/iomodel/reactor/common/unix_address.h"
+#include "trpc/util/function.h"
+
+namespace trpc {
+
+/// @brief Hands the listening sockets over from the old process to the new one on hot restart, so that the new
+///        process accepts on the very sockets the old one listens on and no connection is refused or reset.
+///
+/// The old process serves at a unix socket path(see `Serve`). The new process connects to it before its services
+/// listen(see `Takeover`), receives the listening sockets over SCM_RIGHTS, adopts them when its services listen
+/// (see `TakeListener`), and tells the old process to drain once all of them listen(see `CompleteTakeover`).
+/// Then the new process serves at the path for the next restart.
+///
+/// @note The listening sockets are identified by keys made by `ListenerKey`, one key may have several sockets(eg:
+///       one socket per acceptor with SO_REUSEPORT).
+/// @note The path is created with mode 0600, and both sides check that the peer runs as the same effective user
+///       (SO_PEERCRED), so the listening sockets are never handed to or taken from processes of other users.
+class ListenerHandoff {
+ public:
+  /// @brief Instance used by the framework.
+  static ListenerHandoff* GetInstance();
+
+  ListenerHandoff() = default;
+
+  ~ListenerHandoff();
+
+  ListenerHandoff(const ListenerHandoff&) = delete;
+  ListenerHandoff& operator=(const ListenerHandoff&) = delete;
+
+  /// @brief Adds a listening socket of this process, which is handed over to the new process on hot restart.
+  void AddListener(const std::string& key, int fd);
+
+  /// @brief Removes a listening socket of this process, must be called before the socket is closed.
+  void RemoveListener(int fd);
+
+  /// @brief Serves the handoff at `path` in a background thread.
+  /// @param on_handoff Called once a new process has taken over the listening sockets and listens on them, the
+  ///                   process is expected to stop listening and drain the requests in-flight then.
+  /// @return false if failed to listen at the path.
+  bool Serve(const std::string& path, Function<void()>&& on_handoff);
+
+  /// @brief Stops serving the handoff, the path is removed unless it has been taken by a new process.
+  void StopServing();
+
+  /// @brief Connects to the old process serving at `path` and receives its listening sockets.
+  /// @return false if no old process serves at the path or failed to receive the sockets.
+  bool Takeover(const std::string& path, uint32_t timeout_ms);
+
+  /// @brief Takes a listening socket inherited from the old process.
+  /// @return The fd of the socket(owned by the caller then), or -1 if there is none of `key` left.
+  int TakeListener(const std::string& key);
+
+  /// @brief Tells the old process that all the listening sockets taken listen in this process, the sockets inherited
+  ///        but not taken are closed.
+  /// @return false if there is no takeover in progress or failed to notify the old process.
+  bool CompleteTakeover();
+
+  /// @brief Gives up the takeover(eg: this process fails to start), the old process keeps serving.
+  void CancelTakeover();
+
+  /// @brief Key of a tcp/udp listening socket, eg: tcp://127.0.0.1:8080.
+  static std::string ListenerKey(std::string_view network, const NetworkAddress& addr);
+
+  /// @brief Key of a unix domain listening socket, eg: unix:///tmp/trpc.sock.
+  static std::string ListenerKey(const UnixAddress& addr);
+
+ private:
+  void ServeLoop();
+  bool HandleTakeover(int conn_fd);
+  void CloseInherited();
+
+ private:
+  // Listening sockets of this process.
+  std::mutex listeners_mutex_;
+  std::multimap<std::string, int> listeners_;
+
+  // Listening sockets inherited from the old process and the connection to it.
+  std::mutex inherited_mutex_;
+  std::multimap<std::string, int> inherited_;
+  int takeover_fd_{-1};
+
+  std::string serve_path_;
+  int serve_fd_{-1};
+  ino_t serve_ino_{0};
+  std::atomic<bool> serving_{false};
+  std::thread serve_thread_;
+  Function<void()> on_handoff_;
+};
+
+}  // namespace trpc
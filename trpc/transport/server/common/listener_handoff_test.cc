@@ -0,0 +1,162 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/transport/server/common/listener_handoff.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/runtime/iomodel/reactor/common/socket.h"
+#include "trpc/util/net_util.h"
+
+namespace trpc::testing {
+
+namespace {
+
+std::string HandoffPath() { return "/tmp/trpc_listener_handoff_test_" + std::to_string(::getpid()) + ".sock"; }
+
+Socket CreateListeningSocket(const NetworkAddress& addr) {
+  Socket socket = Socket::CreateTcpSocket(false);
+  socket.SetReuseAddr();
+  socket.SetReusePort();
+  EXPECT_TRUE(socket.Bind(addr));
+  EXPECT_TRUE(socket.Listen());
+  return socket;
+}
+
+bool WaitFor(const std::atomic<bool>& flag) {
+  for (int i = 0; i < 500 && !flag; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return flag;
+}
+
+}  // namespace
+
+TEST(ListenerHandoffTest, ColdStart) {
+  ListenerHandoff handoff;
+  ASSERT_FALSE(handoff.Takeover(HandoffPath(), 100));
+  ASSERT_EQ(-1, handoff.TakeListener("tcp://127.0.0.1:80"));
+  ASSERT_FALSE(handoff.CompleteTakeover());
+}
+
+TEST(ListenerHandoffTest, Handoff) {
+  NetworkAddress addr("127.0.0.1", util::GenRandomAvailablePort(), NetworkAddress::IpType::kIpV4);
+  std::string key = ListenerHandoff::ListenerKey("tcp", addr);
+  ASSERT_EQ("tcp://" + addr.ToString(), key);
+
+  // Old process, with 2 acceptors listening on the same port.
+  ListenerHandoff old_process;
+  Socket listener1 = CreateListeningSocket(addr);
+  Socket listener2 = CreateListeningSocket(addr);
+  old_process.AddListener(key, listener1.GetFd());
+  old_process.AddListener(key, listener2.GetFd());
+  std::atomic<bool> handed_off{false};
+  ASSERT_TRUE(old_process.Serve(HandoffPath(), [&handed_off] { handed_off = true; }));
+
+  // New process.
+  ListenerHandoff new_process;
+  ASSERT_TRUE(new_process.Takeover(HandoffPath(), 1000));
+  int fd = new_process.TakeListener(key);
+  ASSERT_GE(fd, 0);
+  ASSERT_NE(listener1.GetFd(), fd);
+  ASSERT_NE(listener2.GetFd(), fd);
+  Socket inherited(fd, AF_INET);
+  ASSERT_EQ(-1, new_process.TakeListener("tcp://127.0.0.1:1"));
+
+  // The old process does not drain until the new one listens.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_FALSE(handed_off);
+  ASSERT_TRUE(new_process.CompleteTakeover());
+  ASSERT_TRUE(WaitFor(handed_off));
+  // The one not taken is closed.
+  ASSERT_EQ(-1, new_process.TakeListener(key));
+
+  // The old process stops listening, and connections are accepted by the socket inherited.
+  old_process.RemoveListener(listener1.GetFd());
+  old_process.RemoveListener(listener2.GetFd());
+  listener1.Close();
+  listener2.Close();
+  Socket client = Socket::CreateTcpSocket(false);
+  ASSERT_EQ(0, client.Connect(addr));
+  NetworkAddress peer;
+  int conn_fd = inherited.Accept(&peer);
+  ASSERT_GE(conn_fd, 0);
+  ::close(conn_fd);
+  client.Close();
+
+  // The new process serves for the next restart.
+  old_process.StopServing();
+  ASSERT_TRUE(new_process.Serve(HandoffPath(), [] {}));
+  ASSERT_EQ(0, ::access(HandoffPath().c_str(), F_OK));
+  new_process.StopServing();
+  ASSERT_NE(0, ::access(HandoffPath().c_str(), F_OK));
+  inherited.Close();
+}
+
+TEST(ListenerHandoffTest, CancelTakeover) {
+  NetworkAddress addr("127.0.0.1", util::GenRandomAvailablePort(), NetworkAddress::IpType::kIpV4);
+  std::string key = ListenerHandoff::ListenerKey("tcp", addr);
+
+  ListenerHandoff old_process;
+  Socket listener = CreateListeningSocket(addr);
+  old_process.AddListener(key, listener.GetFd());
+  std::atomic<bool> handed_off{false};
+  ASSERT_TRUE(old_process.Serve(HandoffPath(), [&handed_off] { handed_off = true; }));
+
+  // The new process fails to start, the old one keeps serving.
+  {
+    ListenerHandoff new_process;
+    ASSERT_TRUE(new_process.Takeover(HandoffPath(), 1000));
+    new_process.CancelTakeover();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_FALSE(handed_off);
+
+  ListenerHandoff new_process;
+  ASSERT_TRUE(new_process.Takeover(HandoffPath(), 1000));
+  int fd = new_process.TakeListener(key);
+  ASSERT_GE(fd, 0);
+  ::close(fd);
+  ASSERT_TRUE(new_process.CompleteTakeover());
+  ASSERT_TRUE(WaitFor(handed_off));
+
+  old_process.StopServing();
+  listener.Close();
+}
+
+TEST(ListenerHandoffTest, ServePathIsPrivate) {
+  ListenerHandoff old_process;
+  ASSERT_TRUE(old_process.Serve(HandoffPath(), [] {}));
+
+  // Only the owner can connect to take over the listening sockets.
+  struct stat st;
+  ASSERT_EQ(0, ::stat(HandoffPath().c_str(), &st));
+  ASSERT_EQ(0600, st.st_mode & 0777);
+
+  // The peer of the same user is accepted.
+  ListenerHandoff new_process;
+  ASSERT_TRUE(new_process.Takeover(HandoffPath(), 1000));
+  new_process.CancelTakeover();
+
+  old_process.StopServing();
+}
+
+}  // namespace trpc::testing
@@ -20,6 +20,7 @@
 #include "trpc/runtime/iomodel/reactor/common/connection.h"
 #include "trpc/runtime/iomodel/reactor/default/tcp_acceptor.h"
 #include "trpc/runtime/iomodel/reactor/default/uds_acceptor.h"
+#include "trpc/transport/server/common/listener_handoff.h"
 #include "trpc/transport/server/common/server_io_handler_factory.h"
 #include "trpc/transport/server/default/server_connection_handler_factory.h"
 #include "trpc/util/latch.h"
@@ -66,7 +67,13 @@ bool BindAdapter::BindUds() {
     return this->options_.transport->AcceptConnection(connection_info);
   };
 
-  acceptor_ = MakeRefCounted<UdsAcceptor>(options_.reactor, addr);
+  // Accepts on the listening socket inherited from the old process on hot restart if any.
+  listener_key_ = ListenerHandoff::ListenerKey(addr);
+  if (int fd = ListenerHandoff::GetInstance()->TakeListener(listener_key_); fd >= 0) {
+    acceptor_ = MakeRefCounted<UdsAcceptor>(options_.reactor, addr, Socket(fd, AF_UNIX));
+  } else {
+    acceptor_ = MakeRefCounted<UdsAcceptor>(options_.reactor, addr);
+  }
   acceptor_->SetAcceptHandleFunction(std::move(func));
   if (bind_info.custom_set_accept_socket_opt_function) {
     acceptor_->SetAcceptSetSocketOptFunction(bind_info.custom_set_accept_socket_opt_function);
@@ -83,7 +90,13 @@ bool BindAdapter::BindTcp() {
   auto func = [this](AcceptConnectionInfo& connection_info) {
     return this->options_.transport->AcceptConnection(connection_info);
   };
-  acceptor_ = MakeRefCounted<TcpAcceptor>(options_.reactor, addr);
+  // Accepts on the listening socket inherited from the old process on hot restart if any.
+  listener_key_ = ListenerHandoff::ListenerKey("tcp", addr);
+  if (int fd = ListenerHandoff::GetInstance()->TakeListener(listener_key_); fd >= 0) {
+    acceptor_ = MakeRefCounted<TcpAcceptor>(options_.reactor, addr, Socket(fd, bind_info.is_ipv6 ? AF_INET6 : AF_INET));
+  } else {
+    acceptor_ = MakeRefCounted<TcpAcceptor>(options_.reactor, addr);
+  }
   acceptor_->SetAcceptHandleFunction(std::move(func));
   if (bind_info.custom_set_accept_socket_opt_function) {
     acceptor_->SetAcceptSetSocketOptFunction(bind_info.custom_set_accept_socket_opt_function);
@@ -97,18 +110,27 @@ bool BindAdapter::BindUdp() {
   NetworkAddress udp_addr(bind_info.ip, bind_info.port,
                           bind_info.is_ipv6 ? NetworkAddress::IpType::kIpV6 : NetworkAddress::IpType::kIpV4);
 
-  Socket sock = Socket::CreateUdpSocket(udp_addr.IsIpv6());
-  TRPC_ASSERT(sock.IsValid());
-  sock.SetReuseAddr();
-  sock.SetReusePort();
-  sock.SetBlock(false);
+  udp_listener_key_ = ListenerHandoff::ListenerKey("udp", udp_addr);
 
-  if (bind_info.custom_set_socket_opt_function) {
-    bind_info.custom_set_socket_opt_function(sock);
-  }
+  Socket sock;
+  if (int fd = ListenerHandoff::GetInstance()->TakeListener(udp_listener_key_); fd >= 0) {
+    // Inherited from the old process on hot restart, bound already.
+    sock = Socket(fd, udp_addr.IsIpv6() ? AF_INET6 : AF_INET);
+    sock.SetBlock(false);
+  } else {
+    sock = Socket::CreateUdpSocket(udp_addr.IsIpv6());
+    TRPC_ASSERT(sock.IsValid());
+    sock.SetReuseAddr();
+    sock.SetReusePort();
+    sock.SetBlock(false);
+
+    if (bind_info.custom_set_socket_opt_function) {
+      bind_info.custom_set_socket_opt_function(sock);
+    }
 
-  if (!sock.Bind(udp_addr)) {
-    return false;
+    if (!sock.Bind(udp_addr)) {
+      return false;
+    }
   }
 
   uint64_t udp_transceiver_id = (0xFFFFFFFF00000000 & (static_cast<uint64_t>(options_.reactor->Id()) << 32));
@@ -142,11 +164,13 @@ bool BindAdapter::Listen() {
         l.count_down();
         return;
       }
+      ListenerHandoff::GetInstance()->AddListener(listener_key_, acceptor_->GetFd());
     }
 
     if (udp_transceiver_) {
       udp_transceiver_->EnableReadWrite();
       udp_transceiver_->StartHandshaking();
+      ListenerHandoff::GetInstance()->AddListener(udp_listener_key_, udp_transceiver_->GetFd());
     }
 
     l.count_down();
@@ -169,6 +193,7 @@ bool BindAdapter::Listen() {
 void BindAdapter::StopListen(bool clean_conn) {
   Reactor::Task task = [this, clean_conn] {
     if (this->acceptor_) {
+      ListenerHandoff::GetInstance()->RemoveListener(acceptor_->GetFd());
       this->acceptor_->DisableListen();
 
       this->acceptor_.Reset();
@@ -215,12 +240,14 @@ void BindAdapter::Stop() {
     }
 
     if (this->acceptor_) {
+      ListenerHandoff::GetInstance()->RemoveListener(acceptor_->GetFd());
       acceptor_->DisableListen();
     }
 
     conn_manager_.Stop();
 
     if (udp_transceiver_) {
+      ListenerHandoff::GetInstance()->RemoveListener(udp_transceiver_->GetFd());
       udp_transceiver_->DisableReadWrite();
     }
 
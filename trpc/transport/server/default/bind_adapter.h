@@ -14,6 +14,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <utility>
 
@@ -94,6 +95,10 @@ class BindAdapter {
 
   RefPtr<UdpTransceiver> udp_transceiver_{nullptr};
 
+  // Keys of the listening sockets handed over on hot restart.
+  std::string listener_key_;
+  std::string udp_listener_key_;
+
   uint64_t connection_idle_timeout_{0};
 
   uint64_t timer_id_{kInvalidTimerId};
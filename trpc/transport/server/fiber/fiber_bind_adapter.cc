@@ -16,6 +16,7 @@
 #include "trpc/coroutine/fiber.h"
 #include "trpc/runtime/common/stats/frame_stats.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
+#include "trpc/transport/server/common/listener_handoff.h"
 #include "trpc/transport/server/common/server_io_handler_factory.h"
 #include "trpc/transport/server/fiber/fiber_server_connection_handler_factory.h"
 #include "trpc/transport/server/fiber/fiber_server_transport_impl.h"
@@ -54,9 +55,14 @@ bool FiberBindAdapter::Bind() {
     return BindUdp();
   }
 
-  TRPC_LOG_ERROR("only support 'tcp', 'udp', 'tcp,udp'");
-  TRPC_ASSERT((bind_info.network == "tcp" || bind_info.network == "udp" || bind_info.network == "tcp,udp") &&
-              "only support 'tcp', 'udp', 'tcp,udp'");
+  if (bind_info.network == "shm") {
+    return BindShm();
+  }
+
+  TRPC_LOG_ERROR("only support 'tcp', 'udp', 'tcp,udp', 'shm'");
+  TRPC_ASSERT((bind_info.network == "tcp" || bind_info.network == "udp" || bind_info.network == "tcp,udp" ||
+               bind_info.network == "shm") &&
+              "only support 'tcp', 'udp', 'tcp,udp', 'shm'");
   return false;
 }
 
@@ -78,12 +84,20 @@ bool FiberBindAdapter::BindTcp() {
   TRPC_ASSERT(accept_num == 1);
 #endif
 
+  listener_key_ = ListenerHandoff::ListenerKey("tcp", addr);
+
   uint32_t count = 0;
   for (auto* reactor : reactors) {
     auto func = [this](AcceptConnectionInfo& connection_info) {
       return this->transport_->AcceptConnection(connection_info);
     };
-    auto acceptor = MakeRefCounted<FiberAcceptor>(reactor, addr);
+    // Accepts on the listening socket inherited from the old process on hot restart if any.
+    RefPtr<FiberAcceptor> acceptor;
+    if (int fd = ListenerHandoff::GetInstance()->TakeListener(listener_key_); fd >= 0) {
+      acceptor = MakeRefCounted<FiberAcceptor>(reactor, addr, Socket(fd, bind_info.is_ipv6 ? AF_INET6 : AF_INET));
+    } else {
+      acceptor = MakeRefCounted<FiberAcceptor>(reactor, addr);
+    }
     acceptor->SetAcceptHandleFunction(std::move(func));
     if (bind_info.custom_set_accept_socket_opt_function) {
       acceptor->SetAcceptSetSocketOptFunction(bind_info.custom_set_accept_socket_opt_function);
@@ -99,6 +113,47 @@ bool FiberBindAdapter::BindTcp() {
   return true;
 }
 
+bool FiberBindAdapter::BindShm() {
+  // Unix socket can not be bound by multiple acceptors, the connections are dispatched to all(assigned) scheduling
+  // groups by the one of the first scheduling group.
+  if (scheduling_group_index_ != transport_->GetSchedulingGroups().front()) {
+    return true;
+  }
+
+  const BindInfo& bind_info = transport_->GetBindInfo();
+  NetworkAddress addr(bind_info.ip, bind_info.port,
+                      bind_info.is_ipv6 ? NetworkAddress::IpType::kIpV6 : NetworkAddress::IpType::kIpV4);
+  if (!PrepareShmRendezvousDir()) {
+    return false;
+  }
+  UnixAddress unix_addr = GetShmRendezvousAddress(addr);
+  TRPC_LOG_DEBUG("make shm acceptor addr:" << unix_addr.Path());
+
+  std::vector<Reactor*> reactors;
+  fiber::GetReactorInSameGroup(scheduling_group_index_, reactors);
+
+  TRPC_ASSERT(!reactors.empty());
+
+  listener_key_ = ListenerHandoff::ListenerKey(unix_addr);
+
+  RefPtr<FiberAcceptor> acceptor;
+  if (int fd = ListenerHandoff::GetInstance()->TakeListener(listener_key_); fd >= 0) {
+    acceptor = MakeRefCounted<FiberAcceptor>(reactors[0], unix_addr, Socket(fd, AF_UNIX));
+  } else {
+    acceptor = MakeRefCounted<FiberAcceptor>(reactors[0], unix_addr);
+  }
+  acceptor->SetAcceptHandleFunction([this](AcceptConnectionInfo& connection_info) {
+    return this->transport_->AcceptConnection(connection_info);
+  });
+  if (bind_info.custom_set_accept_socket_opt_function) {
+    acceptor->SetAcceptSetSocketOptFunction(bind_info.custom_set_accept_socket_opt_function);
+  }
+
+  acceptors_.emplace_back(std::move(acceptor));
+
+  return true;
+}
+
 bool FiberBindAdapter::BindUdp() {
   BindInfo& bind_info = transport_->GetBindInfo();
   NetworkAddress udp_addr(bind_info.ip, bind_info.port,
@@ -109,21 +164,30 @@ bool FiberBindAdapter::BindUdp() {
 
   TRPC_ASSERT(!reactors.empty());
 
+  udp_listener_key_ = ListenerHandoff::ListenerKey("udp", udp_addr);
+
   uint64_t udp_transceiver_id = 0;
   for (auto* reactor : reactors) {
-    Socket socket = Socket::CreateUdpSocket(bind_info.is_ipv6);
-    TRPC_ASSERT(socket.IsValid());
-    socket.SetReuseAddr();
-    socket.SetReusePort();
-    socket.SetBlock(false);
-
-    if (bind_info.custom_set_socket_opt_function) {
-      bind_info.custom_set_socket_opt_function(socket);
-    }
-
-    if (!socket.Bind(udp_addr)) {
-      TRPC_LOG_ERROR("Udp Bind fail,address:" << udp_addr.ToString());
-      return false;
+    Socket socket;
+    if (int fd = ListenerHandoff::GetInstance()->TakeListener(udp_listener_key_); fd >= 0) {
+      // Inherited from the old process on hot restart, bound already.
+      socket = Socket(fd, bind_info.is_ipv6 ? AF_INET6 : AF_INET);
+      socket.SetBlock(false);
+    } else {
+      socket = Socket::CreateUdpSocket(bind_info.is_ipv6);
+      TRPC_ASSERT(socket.IsValid());
+      socket.SetReuseAddr();
+      socket.SetReusePort();
+      socket.SetBlock(false);
+
+      if (bind_info.custom_set_socket_opt_function) {
+        bind_info.custom_set_socket_opt_function(socket);
+      }
+
+      if (!socket.Bind(udp_addr)) {
+        TRPC_LOG_ERROR("Udp Bind fail,address:" << udp_addr.ToString());
+        return false;
+      }
     }
 
     auto udp_transceiver = MakeRefCounted<FiberUdpTransceiver>(reactor, socket);
@@ -161,14 +225,22 @@ bool FiberBindAdapter::Listen() {
       TRPC_LOG_ERROR("FiberAcceptor Listen fail");
       return false;
     }
+    ListenerHandoff::GetInstance()->AddListener(listener_key_, acceptor->GetFd());
     if (connection_idle_timeout_ > 0) {
         idle_conn_cleaner_ = SetFiberTimer(ReadSteadyClock(), std::chrono::seconds(1),
                                            [this, ref = RefPtr(ref_ptr, this)] { RemoveIdleConnection(); });
     }
   }
 
+  // Shm connections are accepted by the first scheduling group only, but they're dispatched to all scheduling groups.
+  if (acceptors_.empty() && transport_->GetBindInfo().network == "shm" && connection_idle_timeout_ > 0) {
+    idle_conn_cleaner_ = SetFiberTimer(ReadSteadyClock(), std::chrono::seconds(1),
+                                       [this, ref = RefPtr(ref_ptr, this)] { RemoveIdleConnection(); });
+  }
+
   for (auto& udp_transceiver : udp_transceivers_) {
     udp_transceiver->EnableReadWrite();
+    ListenerHandoff::GetInstance()->AddListener(udp_listener_key_, udp_transceiver->GetFd());
   }
 
   return true;
@@ -180,11 +252,13 @@ void FiberBindAdapter::Stop() {
   }
 
   for (const auto& acceptor : acceptors_) {
+    ListenerHandoff::GetInstance()->RemoveListener(acceptor->GetFd());
     acceptor->Stop();
     acceptor->Join();
   }
 
   for (const auto& udp_transceiver : udp_transceivers_) {
+    ListenerHandoff::GetInstance()->RemoveListener(udp_transceiver->GetFd());
     udp_transceiver->Stop();
     udp_transceiver->Join();
   }
@@ -195,6 +269,7 @@ void FiberBindAdapter::Destroy() { connection_manager_.Destroy(); }
 
 void FiberBindAdapter::StopListen(bool clean_conn) {
   for (const auto& acceptor : acceptors_) {
+    ListenerHandoff::GetInstance()->RemoveListener(acceptor->GetFd());
     acceptor->Stop();
     acceptor->Join();
 
@@ -234,7 +309,7 @@ int FiberBindAdapter::SendTcpMsg(STransportRspMsg* msg) {
   // If the return packet call of the request is under the same fiber
   // as the processing of the request, directly send the response
   if (context->GetReserved() != nullptr) {
-    auto* fiber_conn = static_cast<FiberTcpConnection*>(context->GetReserved());
+    auto* fiber_conn = static_cast<FiberConnection*>(context->GetReserved());
 
     IoMessage message;
     message.msg = std::move(msg->context);
@@ -304,11 +379,11 @@ uint64_t FiberBindAdapter::GenConnectionId() {
   return (static_cast<uint64_t>(scheduling_group_index_) << 32) | ++conn_id;
 }
 
-void FiberBindAdapter::AddConnection(RefPtr<FiberTcpConnection>&& conn) {
+void FiberBindAdapter::AddConnection(RefPtr<FiberConnection>&& conn) {
   connection_manager_.Add(conn->GetConnId(), std::move(conn));
 }
 
-RefPtr<FiberTcpConnection> FiberBindAdapter::GetConnection(uint64_t conn_id) {
+RefPtr<FiberConnection> FiberBindAdapter::GetConnection(uint64_t conn_id) {
   return connection_manager_.Get(conn_id);
 }
 
@@ -317,7 +392,7 @@ void FiberBindAdapter::CleanConnectionResource(Connection* conn) {
 
   TRPC_LOG_DEBUG("CleanConnection conn_id:" << conn_id);
 
-  RefPtr<FiberTcpConnection> fiber_conn = connection_manager_.Del(conn_id);
+  RefPtr<FiberConnection> fiber_conn = connection_manager_.Del(conn_id);
   if (!fiber_conn) {
     TRPC_LOG_DEBUG("ConnectionID:" << conn_id
                                    << " is not found , Perhaps it's removed by `RemoveIdleConnection()` Or `DoClose`");
@@ -344,7 +419,7 @@ void FiberBindAdapter::RemoveIdleConnection() {
     return;
   }
 
-  std::vector<RefPtr<FiberTcpConnection>> idle_connections;
+  std::vector<RefPtr<FiberConnection>> idle_connections;
   connection_manager_.GetIdles(connection_idle_timeout_, idle_connections);
 
   if (idle_connections.empty()) {
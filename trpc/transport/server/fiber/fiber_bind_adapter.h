@@ -14,13 +14,14 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "trpc/coroutine/fiber_timer.h"
+#include "trpc/runtime/iomodel/reactor/common/shm_channel.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_acceptor.h"
-#include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_udp_transceiver.h"
 #include "trpc/transport/server/fiber/fiber_connection_manager.h"
 #include "trpc/transport/server/server_transport_message.h"
@@ -30,7 +31,7 @@ namespace trpc {
 
 class FiberServerTransportImpl;
 
-/// @brief Bind adapter for fiber tcp/udp
+/// @brief Bind adapter for fiber tcp/udp/shm
 /// @note  Each fiber scheduling has its owned instance
 class FiberBindAdapter : public RefCounted<FiberBindAdapter> {
  public:
@@ -50,7 +51,7 @@ class FiberBindAdapter : public RefCounted<FiberBindAdapter> {
 
   uint64_t GenConnectionId();
 
-  void AddConnection(RefPtr<FiberTcpConnection>&& conn);
+  void AddConnection(RefPtr<FiberConnection>&& conn);
 
   void UpdateConnection(Connection* conn) {}
 
@@ -63,9 +64,10 @@ class FiberBindAdapter : public RefCounted<FiberBindAdapter> {
   FiberServerTransportImpl* GetTransport() { return transport_; }
 
  private:
-  RefPtr<FiberTcpConnection> GetConnection(uint64_t conn_id);
+  RefPtr<FiberConnection> GetConnection(uint64_t conn_id);
   bool BindTcp();
   bool BindUdp();
+  bool BindShm();
   void RemoveIdleConnection();
   int SendTcpMsg(STransportRspMsg* msg);
   int SendUdpMsg(STransportRspMsg* msg);
@@ -83,6 +85,10 @@ class FiberBindAdapter : public RefCounted<FiberBindAdapter> {
 
   std::vector<RefPtr<FiberAcceptor>> acceptors_;
 
+  // Keys of the listening sockets handed over on hot restart.
+  std::string listener_key_;
+  std::string udp_listener_key_;
+
   std::vector<RefPtr<FiberUdpTransceiver>> udp_transceivers_;
 
   FiberConnectionManager connection_manager_;
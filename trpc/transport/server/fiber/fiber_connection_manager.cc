@@ -37,7 +37,7 @@ FiberConnectionManager::~FiberConnectionManager() {
   }
 }
 
-void FiberConnectionManager::Add(uint64_t conn_id, RefPtr<FiberTcpConnection>&& conn) {
+void FiberConnectionManager::Add(uint64_t conn_id, RefPtr<FiberConnection>&& conn) {
   auto&& shard = conn_shards_[GetHashIndex(conn_id, kShards)];
 
   std::scoped_lock _(shard.lock);
@@ -47,7 +47,7 @@ void FiberConnectionManager::Add(uint64_t conn_id, RefPtr<FiberTcpConnection>&&
   TRPC_ASSERT(inserted && "insert FiberConnectionManager with Duplicate conn_id");
 }
 
-RefPtr<FiberTcpConnection> FiberConnectionManager::Del(uint64_t conn_id) {
+RefPtr<FiberConnection> FiberConnectionManager::Del(uint64_t conn_id) {
   auto&& shard = conn_shards_[GetHashIndex(conn_id, kShards)];
 
   std::scoped_lock _(shard.lock);
@@ -61,7 +61,7 @@ RefPtr<FiberTcpConnection> FiberConnectionManager::Del(uint64_t conn_id) {
   return nullptr;
 }
 
-RefPtr<FiberTcpConnection> FiberConnectionManager::Get(uint64_t conn_id) {
+RefPtr<FiberConnection> FiberConnectionManager::Get(uint64_t conn_id) {
   auto&& shard = conn_shards_[GetHashIndex(conn_id, kShards)];
 
   std::scoped_lock _(shard.lock);
@@ -73,7 +73,7 @@ RefPtr<FiberTcpConnection> FiberConnectionManager::Get(uint64_t conn_id) {
   return nullptr;
 }
 
-void FiberConnectionManager::GetIdles(uint32_t idle_timeout, std::vector<RefPtr<FiberTcpConnection>>& idle_conns) {
+void FiberConnectionManager::GetIdles(uint32_t idle_timeout, std::vector<RefPtr<FiberConnection>>& idle_conns) {
   TRPC_ASSERT(conn_shards_ && "conn_shards_ is null");
   uint64_t current_time = trpc::time::GetMilliSeconds();
 
@@ -110,7 +110,7 @@ void FiberConnectionManager::Stop() {
   for (size_t i = 0; i != kShards; ++i) {
     auto&& shard = conn_shards_[i];
 
-    std::unordered_map<uint64_t, RefPtr<FiberTcpConnection>> temp;
+    std::unordered_map<uint64_t, RefPtr<FiberConnection>> temp;
     {
       std::scoped_lock _(shard.lock);
       shard.map.swap(temp);
@@ -131,7 +131,7 @@ void FiberConnectionManager::Destroy() {
   for (size_t i = 0; i != kShards; ++i) {
     auto&& shard = conn_shards_[i];
 
-    std::unordered_map<uint64_t, RefPtr<FiberTcpConnection>> temp;
+    std::unordered_map<uint64_t, RefPtr<FiberConnection>> temp;
     {
       std::scoped_lock _(shard.lock);
       shard.map.swap(temp);
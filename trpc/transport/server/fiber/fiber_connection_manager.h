@@ -18,7 +18,7 @@
 #include <unordered_map>
 #include <vector>
 
-#include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_connection.h"
 #include "trpc/util/align.h"
 #include "trpc/util/ref_ptr.h"
 
@@ -30,13 +30,13 @@ class FiberConnectionManager {
 
   ~FiberConnectionManager();
 
-  void Add(uint64_t conn_id, RefPtr<FiberTcpConnection>&& conn);
+  void Add(uint64_t conn_id, RefPtr<FiberConnection>&& conn);
 
-  RefPtr<FiberTcpConnection> Del(uint64_t conn_id);
+  RefPtr<FiberConnection> Del(uint64_t conn_id);
 
-  RefPtr<FiberTcpConnection> Get(uint64_t conn_id);
+  RefPtr<FiberConnection> Get(uint64_t conn_id);
 
-  void GetIdles(uint32_t idle_timeout, std::vector<RefPtr<FiberTcpConnection>>& idle_conns);
+  void GetIdles(uint32_t idle_timeout, std::vector<RefPtr<FiberConnection>>& idle_conns);
 
   void Stop();
 
@@ -47,7 +47,7 @@ class FiberConnectionManager {
  private:
   struct alignas(hardware_destructive_interference_size) ConnectionShard {
     std::mutex lock;
-    std::unordered_map<uint64_t, RefPtr<FiberTcpConnection>> map;
+    std::unordered_map<uint64_t, RefPtr<FiberConnection>> map;
   };
 
   constexpr static size_t kShards = 128;
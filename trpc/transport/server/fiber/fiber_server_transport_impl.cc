@@ -22,6 +22,7 @@
 #include "trpc/runtime/fiber_runtime.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_acceptor.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_shm_connection.h"
 #include "trpc/runtime/iomodel/reactor/fiber/fiber_tcp_connection.h"
 #include "trpc/transport/server/common/server_io_handler_factory.h"
 #include "trpc/transport/server/fiber/fiber_server_connection_handler_factory.h"
@@ -40,15 +41,40 @@ FiberServerTransportImpl::~FiberServerTransportImpl() { bind_adapters_.clear();
 
 void FiberServerTransportImpl::Bind(const BindInfo& bind_info) {
   bind_info_ = bind_info;
+  if (bind_info_.write_buffer_budget != 0) {
+    write_buffer_budget_ = std::make_shared<WriteBufferBudget>(bind_info_.write_buffer_budget);
+  }
+  if (bind_info_.egress_rate_limit != 0) {
+    egress_bucket_ = std::make_shared<TokenBucket>(bind_info_.egress_rate_limit);
+  }
   size_t scheduling_group_count = fiber::GetSchedulingGroupCount();
   for (size_t i = 0; i < scheduling_group_count; ++i) {
     bind_adapters_.emplace_back(MakeRefCounted<FiberBindAdapter>(this, i));
   }
+
+  for (uint32_t index : bind_info_.scheduling_groups) {
+    if (index < scheduling_group_count) {
+      scheduling_groups_.push_back(index);
+    } else {
+      TRPC_FMT_WARN("scheduling group {} does not exist, only {} scheduling groups, ignored.", index,
+                    scheduling_group_count);
+    }
+  }
+  std::sort(scheduling_groups_.begin(), scheduling_groups_.end());
+  scheduling_groups_.erase(std::unique(scheduling_groups_.begin(), scheduling_groups_.end()),
+                           scheduling_groups_.end());
+  if (scheduling_groups_.empty()) {
+    for (size_t i = 0; i < scheduling_group_count; ++i) {
+      scheduling_groups_.push_back(i);
+    }
+  }
 }
 
 bool FiberServerTransportImpl::Listen() {
   TRPC_ASSERT(!bind_adapters_.empty());
-  for (auto& adapter : bind_adapters_) {
+  // Only the assigned scheduling groups listen, so the connections accepted are handled by them.
+  for (std::size_t index : scheduling_groups_) {
+    auto& adapter = bind_adapters_[index];
     if (!adapter->Bind()) {
       return false;
     }
@@ -106,10 +132,12 @@ bool FiberServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection
     }
   }
 
+  // Shm connections are all accepted by the first scheduling group(see `FiberBindAdapter::BindShm`), spread them.
+  bool is_shm = !connection_info.conn_info.is_net;
 #if defined(SO_REUSEPORT) && !defined(TRPC_DISABLE_REUSEPORT)
-  std::size_t scheduling_group_index = fiber::GetCurrentSchedulingGroupIndex();
+  std::size_t scheduling_group_index = is_shm ? PickSchedulingGroup() : fiber::GetCurrentSchedulingGroupIndex();
 #else
-  std::size_t scheduling_group_index = Random() % fiber::GetSchedulingGroupCount();
+  std::size_t scheduling_group_index = PickSchedulingGroup();
 #endif
 
   if (TRPC_UNLIKELY(bind_info_.dispatch_accept_function)) {
@@ -128,31 +156,48 @@ bool FiberServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection
 
   TRPC_FMT_DEBUG("server accept connection {} and connid {}.", connection_info.conn_info.ToString(), conn_id);
 
-  connection_info.socket.SetTcpNoDelay();
-  connection_info.socket.SetCloseWaitDefault();
-  connection_info.socket.SetBlock(false);
-  connection_info.socket.SetKeepAlive();
+  RefPtr<FiberConnection> conn;
+  if (TRPC_UNLIKELY(is_shm)) {
+    connection_info.socket.SetBlock(false);
+
+    // The shm connection reads/writes the shared memory with its own io-handler.
+    conn = MakeRefCounted<FiberShmConnection>(reactor, connection_info.socket);
+    conn->SetPeerIp(std::string(bind_info_.ip));
+    conn->SetPeerPort(0);
+    conn->SetPeerIpType(bind_info_.is_ipv6 ? NetworkAddress::IpType::kIpV6 : NetworkAddress::IpType::kIpV4);
+    conn->SetLocalIp(std::string(bind_info_.ip));
+    conn->SetLocalPort(bind_info_.port);
+    conn->SetLocalIpType(bind_info_.is_ipv6 ? NetworkAddress::IpType::kIpV6 : NetworkAddress::IpType::kIpV4);
+  } else {
+    connection_info.socket.SetTcpNoDelay();
+    connection_info.socket.SetCloseWaitDefault();
+    connection_info.socket.SetBlock(false);
+    connection_info.socket.SetKeepAlive();
+
+    if (bind_info_.custom_set_socket_opt_function) {
+      bind_info_.custom_set_socket_opt_function(connection_info.socket);
+    }
 
-  if (bind_info_.custom_set_socket_opt_function) {
-    bind_info_.custom_set_socket_opt_function(connection_info.socket);
+    conn = MakeRefCounted<FiberTcpConnection>(reactor, connection_info.socket);
+    std::unique_ptr<IoHandler> io_handler =
+        ServerIoHandlerFactory::GetInstance()->Create(bind_info_.protocol, conn.Get(), bind_info_);
+    conn->SetIoHandler(std::move(io_handler));
+    conn->SetPeerIp(connection_info.conn_info.remote_addr.Ip());
+    conn->SetPeerPort(connection_info.conn_info.remote_addr.Port());
+    conn->SetPeerIpType(connection_info.conn_info.remote_addr.Type());
+    conn->SetLocalIp(connection_info.conn_info.local_addr.Ip());
+    conn->SetLocalPort(connection_info.conn_info.local_addr.Port());
+    conn->SetLocalIpType(connection_info.conn_info.local_addr.Type());
   }
-
-  auto conn = MakeRefCounted<FiberTcpConnection>(reactor, connection_info.socket);
   conn->SetConnId(conn_id);
-  std::unique_ptr<IoHandler> io_handler =
-      ServerIoHandlerFactory::GetInstance()->Create(bind_info_.protocol, conn.Get(), bind_info_);
-  conn->SetIoHandler(std::move(io_handler));
   conn->SetConnType(ConnectionType::kTcpLong);
   conn->SetMaxPacketSize(bind_info_.max_packet_size);
   conn->SetRecvBufferSize(bind_info_.recv_buffer_size);
   conn->SetSendQueueCapacity(bind_info_.send_queue_capacity);
   conn->SetSendQueueTimeout(bind_info_.send_queue_timeout);
-  conn->SetPeerIp(connection_info.conn_info.remote_addr.Ip());
-  conn->SetPeerPort(connection_info.conn_info.remote_addr.Port());
-  conn->SetPeerIpType(connection_info.conn_info.remote_addr.Type());
-  conn->SetLocalIp(connection_info.conn_info.local_addr.Ip());
-  conn->SetLocalPort(connection_info.conn_info.local_addr.Port());
-  conn->SetLocalIpType(connection_info.conn_info.local_addr.Type());
+  conn->SetWriteBufferBudget(write_buffer_budget_);
+  conn->SetEgressRateLimit(bind_info_.conn_egress_rate_limit);
+  conn->SetServiceEgressBucket(egress_bucket_);
 
   auto conn_handler = FiberServerConnectionHandlerFactory::GetInstance()->Create(
       conn.Get(), bind_adapters_[scheduling_group_index].Get(), &bind_info_);
@@ -170,6 +215,10 @@ bool FiberServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection
   return true;
 }
 
+std::size_t FiberServerTransportImpl::PickSchedulingGroup() const {
+  return scheduling_groups_[Random() % scheduling_groups_.size()];
+}
+
 bool FiberServerTransportImpl::IsConnected(uint64_t connection_id) {
   return bind_adapters_[GetIndexOfBindAdapter(connection_id)]->IsConnected(connection_id);
 }
@@ -17,6 +17,8 @@
 #include <string>
 
 #include "trpc/runtime/iomodel/reactor/common/accept_connection_info.h"
+#include "trpc/runtime/iomodel/reactor/common/egress_shaper.h"
+#include "trpc/runtime/iomodel/reactor/common/write_buffer_budget.h"
 #include "trpc/transport/server/fiber/fiber_bind_adapter.h"
 #include "trpc/transport/server/server_transport.h"
 #include "trpc/util/ref_ptr.h"
@@ -48,6 +50,9 @@ class FiberServerTransportImpl final : public ServerTransport {
 
   BindInfo& GetBindInfo() { return bind_info_; }
 
+  /// @brief The scheduling groups(indexes, in ascending order) the connections are dispatched to.
+  const std::vector<std::size_t>& GetSchedulingGroups() const { return scheduling_groups_; }
+
   void DecrAliveConnNum(int size) { alive_conns_.fetch_sub(size, std::memory_order_relaxed); }
 
   bool IsConnected(uint64_t connection_id) override;
@@ -55,10 +60,23 @@ class FiberServerTransportImpl final : public ServerTransport {
   void DoClose(const CloseConnectionInfo& close_connection_info) override;
 
  private:
+  std::size_t PickSchedulingGroup() const;
+
+ private:
+  // Indexed by scheduling group.
   std::vector<RefPtr<FiberBindAdapter>> bind_adapters_;
 
+  // Subset of the scheduling groups which listen and handle the connections, see `BindInfo::scheduling_groups`.
+  std::vector<std::size_t> scheduling_groups_;
+
   BindInfo bind_info_;
 
+  // Shared by the connections, nullptr if not limited.
+  std::shared_ptr<WriteBufferBudget> write_buffer_budget_;
+
+  // Shared by the connections, nullptr if not limited.
+  std::shared_ptr<TokenBucket> egress_bucket_;
+
   std::atomic<int> alive_conns_{0};
 };
 
@@ -489,6 +489,32 @@ TEST(FiberServerTransportImplTest, TcpFail) {
   EXPECT_EQ(listen_fail, false);
 }
 
+TEST(FiberServerTransportImplTest, SchedulingGroups) {
+  BindInfo info;
+  info.socket_type = "net";
+  info.ip = "0.0.0.0";
+  info.is_ipv6 = false;
+  info.port = trpc::util::GenRandomAvailablePort();
+  info.network = "tcp";
+  info.protocol = "raw";
+
+  {
+    // Invalid indices are ignored.
+    FiberServerTransportImpl server_transport;
+    info.scheduling_groups = {1, 99, 1};
+    server_transport.Bind(info);
+    ASSERT_EQ(std::vector<std::size_t>{1}, server_transport.GetSchedulingGroups());
+  }
+
+  {
+    // All scheduling groups are used by default.
+    FiberServerTransportImpl server_transport;
+    info.scheduling_groups.clear();
+    server_transport.Bind(info);
+    ASSERT_EQ(fiber::GetSchedulingGroupCount(), server_transport.GetSchedulingGroups().size());
+  }
+}
+
 TEST(FiberServerTransportImplTest, DoCloseTest) {
   FiberServerTransportImpl server_transport;
 
@@ -56,10 +56,17 @@ struct BindInfo {
   uint32_t recv_buffer_size{8192};
   uint32_t send_queue_capacity{0};
   uint32_t send_queue_timeout{3000};
+  uint64_t write_buffer_budget{0};
+  uint64_t conn_egress_rate_limit{0};
+  uint64_t egress_rate_limit{0};
   uint32_t max_conn_num{10000};
   uint32_t idle_time{60000};
   uint32_t accept_thread_num{1};
 
+  // The scheduling groups(indexes) the connections are dispatched to, empty means all
+  // Use in fiber runtime
+  std::vector<uint32_t> scheduling_groups;
+
   // Whether the upper-layer business processing methods has stream rpc methods
   bool has_stream_rpc = false;
 
@@ -615,6 +615,7 @@ def trpc_proto_library(
     if (use_trpc_plugin):
         trpc_libs = [
             "%s//trpc/client:rpc_service_proxy" % rootpath,
+            "%s//trpc/server:batch_rpc_method_handler" % rootpath,
             "%s//trpc/server:rpc_async_method_handler" % rootpath,
             "%s//trpc/server:rpc_method_handler" % rootpath,
             "%s//trpc/server:rpc_service_impl" % rootpath,
@@ -19,13 +19,16 @@
 
 #include "trpc/tvar/common/sampler.h"
 
-#include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <utility>
+#include <vector>
 
-#include "trpc/tvar/common/atomic_type.h"
-#include "trpc/tvar/common/write_mostly.h"
+#include "json/json.h"
+
+#include "trpc/tvar/common/tvar_group.h"
 #include "trpc/util/chrono/time.h"
 #include "trpc/util/thread/thread_helper.h"
 
@@ -35,6 +38,9 @@ using SamplerPtr = std::shared_ptr<trpc::tvar::Sampler>;
 
 constexpr int kWarnNoSleepThreshold = 2;
 
+// Number of samplers sampled under one lock.
+constexpr std::size_t kSamplerBatchSize = 128;
+
 }  // namespace
 
 namespace trpc::tvar {
@@ -43,40 +49,14 @@ namespace trpc::tvar {
 // Copied and modified from
 // https://github.com/apache/brpc/blob/1.6.0/src/bvar/detail/sampler.cpp
 
-/// @brief To combine two Samplers.
-struct CombineSampler {
-  /// @brief Insert one sampler into a list.
-  void operator()(std::list<SamplerPtr>* s1, SamplerPtr s2) const {
-    s1->emplace_back(std::move(s2));
-  }
-
-  /// @brief Insert one sampler list into another.
-  void operator()(std::list<SamplerPtr>* s1, std::list<SamplerPtr> s2) const {
-    s1->splice(s1->end(), s2);
-  }
-};
-
-/// @brief Intended for WriteMostly.
-struct CollectorTraits {
-  using Type = std::list<SamplerPtr>;
-  using WriteBuffer = AtomicType<Type>;
-  using InputDataType = SamplerPtr;
-  using ResultType = std::list<SamplerPtr>;
-  using SamplerOp = CombineSampler;
-  using SamplerInvOp = VoidOp;
-
-  /// @brief update user data into thread local buffer.
-  template <typename TLS>
-  static void Update(TLS* wb, InputDataType val) {
-    wb->buffer_.template Modify<CombineSampler, InputDataType>(std::move(val));
-  }
-
-  /// @brief Merge thread local data into global buffer.
-  static void Merge(ResultType* wb1, Type wb2) { CombineSampler()(wb1, std::move(wb2)); }
+/// @brief Samplers in a batch are stored contiguously, only accessed by sampler_collector thread.
+struct SamplerBatch {
+  std::size_t size{0};
+  SamplerPtr samplers[kSamplerBatchSize];
 };
 
 /// @brief For sampler_collector thread.
-class SamplerCollector : public WriteMostly<CollectorTraits> {
+class SamplerCollector {
  public:
   SamplerCollector(SamplerCollector const&) = delete;
 
@@ -113,46 +93,105 @@ class SamplerCollector : public WriteMostly<CollectorTraits> {
     thread_ = nullptr;
   }
 
+  /// @brief Samplers are taken into batches at the beginning of next sweep.
+  void Add(SamplerPtr sampler) {
+    std::scoped_lock lock(pending_mutex_);
+    pending_.push_back(std::move(sampler));
+  }
+
+  SamplerSweepStats GetStats() const {
+    SamplerSweepStats stats;
+    stats.sweeps = sweeps_.load(std::memory_order_relaxed);
+    stats.samplers = samplers_.load(std::memory_order_relaxed);
+    stats.last_sweep_us = last_sweep_us_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
   ~SamplerCollector() { Stop(); }
 
  private:
-  SamplerCollector() : WriteMostly<CollectorTraits>(std::list<SamplerPtr>(), std::list<SamplerPtr>()) {
+  SamplerCollector() {
+    auto* group = TrpcVarGroup::FindOrCreate("/trpc/tvar/sampler");
+    sweep_time_handle_ = TrpcVarGroup::LinkToParent("sweep_time_us", group, [this] {
+      return Json::Value(static_cast<Json::UInt64>(last_sweep_us_.load(std::memory_order_relaxed)));
+    });
+    samplers_handle_ = TrpcVarGroup::LinkToParent("samplers", group, [this] {
+      return Json::Value(static_cast<Json::UInt64>(samplers_.load(std::memory_order_relaxed)));
+    });
     Start();
   }
 
+  /// @brief Take the samplers pending into batches.
+  void TakePending() {
+    std::scoped_lock lock(pending_mutex_);
+    for (auto& sampler : pending_) {
+      // Destroyed before taken.
+      if (!sampler->used_.load(std::memory_order_relaxed)) {
+        continue;
+      }
+      if (not_full_.empty()) {
+        batches_.push_back(std::make_unique<SamplerBatch>());
+        not_full_.push_back(batches_.back().get());
+      }
+      auto* batch = not_full_.back();
+      batch->samplers[batch->size++] = std::move(sampler);
+      if (batch->size == kSamplerBatchSize) {
+        not_full_.pop_back();
+      }
+    }
+    pending_.clear();
+  }
+
+  /// @brief Sample all the batches, the samplers destroyed are removed.
+  /// @return Number of samplers sampled.
+  uint64_t Sweep() {
+    uint64_t sampled_num = 0;
+    uint64_t removed_num = 0;
+    std::vector<SamplerPtr> removed;
+    for (auto& batch : batches_) {
+      bool was_full = batch->size == kSamplerBatchSize;
+      for (std::size_t i = 0; i < batch->size;) {
+        auto& sampler = batch->samplers[i];
+        {
+          // Only the lock of the sampler itself is held, `TakeSample` may lock the other samplers.
+          std::scoped_lock lock(sampler->mutex_);
+          if (sampler->used_.load(std::memory_order_relaxed)) {
+            sampler->TakeSample();
+            ++i;
+            continue;
+          }
+        }
+        // Release it out of the lock.
+        removed.push_back(std::move(sampler));
+        sampler = std::move(batch->samplers[--batch->size]);
+      }
+      sampled_num += batch->size;
+
+      if (was_full && batch->size < kSamplerBatchSize) {
+        not_full_.push_back(batch.get());
+      }
+      removed_num += removed.size();
+      removed.clear();
+    }
+    TRPC_FMT_TRACE("sampled_num:{}, removed_num:{}", sampled_num, removed_num);
+    return sampled_num;
+  }
+
   /// @brief Main logic of sampler_collector thread.
   void Run() {
     SetCurrentThreadName("sampler_collector");
 
-    std::list<SamplerPtr> root;
     int consecutive_no_sleep = 0;
     while (!stop_) {
       auto abs_time = trpc::time::GetSteadyMicroSeconds();
-      if (auto s = Reset(); !s.empty()) {
-        root.splice(root.end(), s);
-      }
-      int removed_num = 0;
-      int sampled_num = 0;
-
-      for (auto itr = root.begin(); itr != root.end();) {
-        // We may remove p from the list, save next first.
-        std::unique_lock<std::mutex> lc((*itr)->mutex_);
-        if (!(*itr)->used_) {
-          lc.unlock();
-          itr = root.erase(itr);
-          ++removed_num;
-        } else {
-          (*itr)->TakeSample();
-          lc.unlock();
-          ++sampled_num;
-          ++itr;
-        }
-      }
-      TRPC_FMT_TRACE("sampled_num:{}, removed_num:{}", sampled_num, removed_num);
+      TakePending();
+      samplers_.store(Sweep(), std::memory_order_relaxed);
+      AdvanceSeriesStores();
 
       bool ever_sleep = false;
       auto now = trpc::time::GetSteadyMicroSeconds();
-      calculated_time_us_ += now - abs_time;
+      last_sweep_us_.store(now - abs_time, std::memory_order_relaxed);
+      sweeps_.fetch_add(1, std::memory_order_relaxed);
       abs_time += 1000000;
       while (abs_time > now) {
         std::this_thread::sleep_for(std::chrono::microseconds(abs_time - now));
@@ -173,20 +212,33 @@ class SamplerCollector : public WriteMostly<CollectorTraits> {
  private:
   bool stop_{false};
   std::unique_ptr<std::thread> thread_{nullptr};
-  int64_t calculated_time_us_{0};
+
+  std::mutex pending_mutex_;
+  std::vector<SamplerPtr> pending_;
+
+  // Only accessed by sampler_collector thread.
+  std::vector<std::unique_ptr<SamplerBatch>> batches_;
+  std::vector<SamplerBatch*> not_full_;
+
+  std::atomic<uint64_t> sweeps_{0};
+  std::atomic<uint64_t> samplers_{0};
+  std::atomic<uint64_t> last_sweep_us_{0};
+  std::optional<TrpcVarGroup::Handle> sweep_time_handle_;
+  std::optional<TrpcVarGroup::Handle> samplers_handle_;
 };
 
 Sampler::Sampler() : used_(true) {}
 
-void Sampler::Schedule() {
-  SamplerCollector::GetInstance().Update(this->shared_from_this());
-}
+void Sampler::Schedule() { SamplerCollector::GetInstance().Add(this->shared_from_this()); }
 
 void Sampler::Destroy() {
-  std::unique_lock<std::mutex> lock(mutex_);
-  used_ = false;
+  used_.store(false, std::memory_order_relaxed);
+  // Wait for the sampling in progress.
+  LockSampling();
 }
 
+std::unique_lock<std::mutex> Sampler::LockSampling() const { return std::unique_lock(mutex_); }
+
 void SamplerCollectorThreadStart() {
   SamplerCollector::GetInstance().Start();
 }
@@ -195,6 +247,8 @@ void SamplerCollectorThreadStop() {
   SamplerCollector::GetInstance().Stop();
 }
 
+SamplerSweepStats GetSamplerSweepStats() { return SamplerCollector::GetInstance().GetStats(); }
+
 // End of source codes that are from incubator-brpc.
 
 }  // namespace trpc::tvar
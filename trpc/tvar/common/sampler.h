@@ -20,6 +20,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -52,6 +53,8 @@ struct Sample {
 
 /// @brief Shared ptr wiil be hold by sampler_collector thread after Schedule called.
 ///        And sampler_collector thread will call member function TakeSample periodically.
+/// @note The samplers are stored and swept in batches. Each sampler still has its own lock, as `TakeSample` of one
+///       sampler may read another(eg: the series sampler of `Window` reads its `ReducerSampler`).
 /// @private
 class Sampler : public std::enable_shared_from_this<Sampler> {
  public:
@@ -63,17 +66,20 @@ class Sampler : public std::enable_shared_from_this<Sampler> {
   /// @brief Register shared ptr to sampler_collector thread.
   void Schedule();
 
-  /// @brief Tell sampler_collector to release shared ptr.
+  /// @brief Tell sampler_collector to release shared ptr, TakeSample is not called any more after it returns.
   void Destroy();
 
  protected:
   virtual ~Sampler() = default;
 
+  /// @brief Lock out TakeSample of this sampler, used to protect the data shared with TakeSample.
+  std::unique_lock<std::mutex> LockSampling() const;
+
   friend class SamplerCollector;
 
   // Let holding thread know when to release shared ptr.
-  bool used_;
-  // To protect used_.
+  std::atomic<bool> used_;
+  // Excludes TakeSample from Destroy and the readers of the sampled data.
   mutable std::mutex mutex_;
 };
 
@@ -117,7 +123,7 @@ class ReducerSampler : public Sampler {
 
   ~ReducerSampler() {}
 
-  /// @brief Periodically invoked by sampler_collector thread, if scheduled.
+  /// @brief Periodically invoked by sampler_collector thread with LockSampling held, if scheduled.
   void TakeSample() override {
     // window_size may raise.
     if (static_cast<size_t>(window_size_) + 1 > queue_.Capacity()) {
@@ -156,7 +162,7 @@ class ReducerSampler : public Sampler {
 
     auto&& const_queue = std::as_const(queue_);
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    auto lock = LockSampling();
     if (const_queue.Size() <= 1UL) {
       return false;
     }
@@ -190,7 +196,7 @@ class ReducerSampler : public Sampler {
       return -1;
     }
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    auto lock = LockSampling();
     // window_size is not allowed to reduce.
     if (window_size > window_size_) {
       window_size_ = window_size;
@@ -201,7 +207,7 @@ class ReducerSampler : public Sampler {
 
   /// @brief Get current window size, thread-safe.
   time_t GetWindowSize() const {
-    std::unique_lock<std::mutex> lock(mutex_);
+    auto lock = LockSampling();
     return window_size_;
   }
 
@@ -214,7 +220,7 @@ class ReducerSampler : public Sampler {
 
     auto&& const_queue = std::as_const(queue_);
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    auto lock = LockSampling();
     if (const_queue.Size() <= 1) {
       return;
     }
@@ -251,4 +257,19 @@ void SamplerCollectorThreadStart();
 /// @private
 void SamplerCollectorThreadStop();
 
+/// @brief Statistics of the sampling sweeps of sampler_collector thread.
+/// @private
+struct SamplerSweepStats {
+  // Number of sweeps done.
+  uint64_t sweeps{0};
+  // Number of samplers sampled in the last sweep.
+  uint64_t samplers{0};
+  // Time spent by the last sweep.
+  uint64_t last_sweep_us{0};
+};
+
+/// @brief Get statistics of the sampling sweeps, also exposed as tvar /trpc/tvar/sampler.
+/// @private
+SamplerSweepStats GetSamplerSweepStats();
+
 }  // namespace trpc::tvar
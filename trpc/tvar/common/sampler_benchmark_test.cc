@@ -0,0 +1,92 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+// Measures the time of a sampling sweep, not a part of the default test targets as it creates up to 100k variables.
+// Run it with: bazel test //trpc/tvar/common:sampler_benchmark_test --test_output=all
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/tvar/common/op_util.h"
+#include "trpc/tvar/common/sampler.h"
+
+namespace {
+
+/// @brief Variable sampled by a reducer sampler and a series sampler, like a windowed tvar with series enabled.
+class BenchmarkVariable {
+ public:
+  using ReducerSamplerType = trpc::tvar::ReducerSampler<BenchmarkVariable, int64_t, trpc::tvar::OpAdd<int64_t>,
+                                                        trpc::tvar::OpMinus<int64_t>>;
+  using SeriesSamplerType = trpc::tvar::SeriesSampler<BenchmarkVariable, int64_t, trpc::tvar::OpAdd<int64_t>>;
+
+  BenchmarkVariable()
+      : reducer_sampler_(std::make_shared<ReducerSamplerType>(this)),
+        series_sampler_(std::make_shared<SeriesSamplerType>(this)) {
+    reducer_sampler_->Schedule();
+    series_sampler_->Schedule();
+  }
+
+  ~BenchmarkVariable() {
+    reducer_sampler_->Destroy();
+    series_sampler_->Destroy();
+  }
+
+  int64_t GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+  int64_t Reset() { return value_.exchange(0, std::memory_order_relaxed); }
+
+  void Add(int64_t value) { value_.fetch_add(value, std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_{0};
+  std::shared_ptr<ReducerSamplerType> reducer_sampler_;
+  std::shared_ptr<SeriesSamplerType> series_sampler_;
+};
+
+/// @brief Wait until sampler_collector has done `n` more sweeps.
+trpc::tvar::SamplerSweepStats WaitForSweeps(uint64_t n) {
+  auto sweeps = trpc::tvar::GetSamplerSweepStats().sweeps + n;
+  while (trpc::tvar::GetSamplerSweepStats().sweeps < sweeps) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return trpc::tvar::GetSamplerSweepStats();
+}
+
+}  // namespace
+
+namespace trpc::testing {
+
+/// @brief Time of a sampling sweep for 1k, 10k and 100k variables.
+TEST(SamplerBenchmark, SweepTime) {
+  for (int n : {1000, 10000, 100000}) {
+    std::vector<std::unique_ptr<BenchmarkVariable>> vars;
+    vars.reserve(n);
+    for (int i = 0; i < n; ++i) {
+      vars.push_back(std::make_unique<BenchmarkVariable>());
+      vars.back()->Add(i);
+    }
+    // The first sweep takes the new samplers into batches.
+    auto stats = WaitForSweeps(2);
+    ASSERT_LE(2 * n, stats.samplers);
+    std::cout << n << " variables(" << stats.samplers << " samplers), sweep time: " << stats.last_sweep_us << "us"
+              << std::endl;
+  }
+}
+
+}  // namespace trpc::testing
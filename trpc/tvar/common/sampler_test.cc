@@ -20,6 +20,8 @@
 
 #include "gtest/gtest.h"
 
+#include "trpc/tvar/common/tvar_group.h"
+
 namespace {
 
 /// @brief Simple sampler to record how many times been taken sample.
@@ -40,6 +42,50 @@ class DebugSampler : public trpc::tvar::Sampler {
 
 std::atomic_int DebugSampler::n_destroy_ = 0;
 
+/// @brief Variable sampled by a reducer sampler and a series sampler, like a windowed tvar with series enabled.
+class DebugVariable {
+ public:
+  using ReducerSamplerType =
+      trpc::tvar::ReducerSampler<DebugVariable, int64_t, trpc::tvar::OpAdd<int64_t>, trpc::tvar::OpMinus<int64_t>>;
+  using SeriesSamplerType = trpc::tvar::SeriesSampler<DebugVariable, int64_t, trpc::tvar::OpAdd<int64_t>>;
+
+  DebugVariable()
+      : reducer_sampler_(std::make_shared<ReducerSamplerType>(this)),
+        series_sampler_(std::make_shared<SeriesSamplerType>(this)) {
+    reducer_sampler_->Schedule();
+    series_sampler_->Schedule();
+  }
+
+  ~DebugVariable() {
+    reducer_sampler_->Destroy();
+    series_sampler_->Destroy();
+  }
+
+  int64_t GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+  int64_t Reset() { return value_.exchange(0, std::memory_order_relaxed); }
+
+  void Add(int64_t value) { value_.fetch_add(value, std::memory_order_relaxed); }
+
+  std::shared_ptr<ReducerSamplerType> GetReducerSampler() const { return reducer_sampler_; }
+
+  std::shared_ptr<SeriesSamplerType> GetSeriesSampler() const { return series_sampler_; }
+
+ private:
+  std::atomic<int64_t> value_{0};
+  std::shared_ptr<ReducerSamplerType> reducer_sampler_;
+  std::shared_ptr<SeriesSamplerType> series_sampler_;
+};
+
+/// @brief Wait until sampler_collector has done `n` more sweeps.
+trpc::tvar::SamplerSweepStats WaitForSweeps(uint64_t n) {
+  auto sweeps = trpc::tvar::GetSamplerSweepStats().sweeps + n;
+  while (trpc::tvar::GetSamplerSweepStats().sweeps < sweeps) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return trpc::tvar::GetSamplerSweepStats();
+}
+
 }  // namespace
 
 namespace trpc::testing {
@@ -132,4 +178,38 @@ TEST(SamplerTest, SamplerCollectorThread) {
   trpc::tvar::SamplerCollectorThreadStart();
 }
 
+/// @brief Test the reducer and series samplers are sampled.
+TEST(SamplerTest, ReducerAndSeries) {
+  DebugVariable var;
+  ASSERT_EQ(0, var.GetReducerSampler()->SetWindowSize(10));
+  var.Add(10);
+  WaitForSweeps(2);
+  var.Add(5);
+  WaitForSweeps(2);
+
+  trpc::tvar::Sample<int64_t> sample;
+  ASSERT_TRUE(var.GetReducerSampler()->GetValue(10, &sample));
+  ASSERT_EQ(15, sample.data);
+
+  auto series = var.GetSeriesSampler()->GetSeries();
+  ASSERT_EQ(15, series["now"][0]);
+  ASSERT_EQ(15, series["latest_sec"][0]);
+}
+
+/// @brief Test the statistics of the sampling sweeps are exported, the sweep time for many variables is measured by
+///        sampler_benchmark_test.
+TEST(SamplerTest, SweepStats) {
+  constexpr int N = 100;
+  std::vector<std::unique_ptr<DebugVariable>> vars;
+  vars.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    vars.push_back(std::make_unique<DebugVariable>());
+  }
+  // The first sweep takes the new samplers into batches.
+  auto stats = WaitForSweeps(2);
+  ASSERT_LE(2 * N, stats.samplers);
+  ASSERT_TRUE(trpc::tvar::TrpcVarGroup::TryGet("/trpc/tvar/sampler/sweep_time_us"));
+  ASSERT_TRUE(trpc::tvar::TrpcVarGroup::TryGet("/trpc/tvar/sampler/samplers"));
+}
+
 }  // namespace trpc::testing
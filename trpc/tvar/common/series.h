@@ -22,7 +22,9 @@
 #include <math.h>
 #include <string.h>
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <type_traits>
@@ -246,9 +248,219 @@ void SeriesBase<T, Op>::AppendDay(const T& value) {
 
 // End of source codes that are from incubator-brpc.
 
-/// @brief Helper for SeriesBase.
+/// @brief Series store shared by many variables, it's advanced by sampler_collector thread once per second after all
+///        the variables are sampled.
+/// @private
+class SeriesStoreBase {
+ public:
+  virtual ~SeriesStoreBase() = default;
+
+  /// @brief Move to the next second, the seconds are rolled up into a minute when a minute is full and so on.
+  virtual void Advance() = 0;
+};
+
+namespace detail {
+
+/// @private
+struct SeriesStoreRegistry {
+  std::mutex mutex;
+  std::vector<SeriesStoreBase*> stores;
+};
+
+/// @private
+inline SeriesStoreRegistry& GetSeriesStoreRegistry() {
+  // Never destroyed, the series of the variables destructed at exit still refer to the stores.
+  static auto* registry = new SeriesStoreRegistry();
+  return *registry;
+}
+
+}  // namespace detail
+
+/// @brief Advance all the global series stores, called by sampler_collector thread after each sampling sweep.
+/// @private
+inline void AdvanceSeriesStores() {
+  auto& registry = detail::GetSeriesStoreRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (auto* store : registry.stores) {
+    store->Advance();
+  }
+}
+
+/// @brief Stores the series of many variables of the same type in columns, a column holds one time slot(a second, a
+///        minute, ...) of a chunk of variables. So the per-second sampling writes one column sequentially and the
+///        roll-up walks the columns instead of hopping between per-variable arrays, and no per-variable lock is needed.
+/// @note The rows are only written by sampler_collector thread, readers may see a value of the previous second.
+/// @private
+template <typename T, typename Op>
+class ColumnarSeriesStore : public SeriesStoreBase {
+ public:
+  /// @brief Number of variables in a chunk.
+  static constexpr std::size_t kRowsPerChunk = 64;
+
+  /// @brief Cells of a variable, the cell of time slot `i` is `cells[i * kRowsPerChunk]`.
+  struct Row {
+    std::size_t id;
+    std::atomic<T>* cells;
+  };
+
+  /// @brief The store advanced by sampler_collector thread.
+  static ColumnarSeriesStore* GetInstance() {
+    static ColumnarSeriesStore* instance = [] {
+      auto* store = new ColumnarSeriesStore();
+      auto& registry = detail::GetSeriesStoreRegistry();
+      std::scoped_lock lock(registry.mutex);
+      registry.stores.push_back(store);
+      return store;
+    }();
+    return instance;
+  }
+
+  Row Allocate() {
+    std::scoped_lock lock(mutex_);
+    if (free_rows_.empty()) {
+      std::size_t base = chunks_.size() * kRowsPerChunk;
+      chunks_.push_back(std::make_unique<Chunk>());
+      for (std::size_t i = kRowsPerChunk; i > 0; --i) {
+        free_rows_.push_back(base + i - 1);
+      }
+    }
+    std::size_t id = free_rows_.back();
+    free_rows_.pop_back();
+
+    Row row{id, &chunks_[id / kRowsPerChunk]->cells[0][id % kRowsPerChunk]};
+    for (std::size_t i = 0; i < kColumns; ++i) {
+      row.cells[i * kRowsPerChunk].store(T(), std::memory_order_relaxed);
+    }
+    return row;
+  }
+
+  void Free(const Row& row) {
+    std::scoped_lock lock(mutex_);
+    free_rows_.push_back(row.id);
+  }
+
+  /// @brief Set the value of current second.
+  void Set(const Row& row, const T& value) {
+    row.cells[n_second_.load(std::memory_order_relaxed) * kRowsPerChunk].store(value, std::memory_order_relaxed);
+  }
+
+  void Advance() override {
+    std::scoped_lock lock(mutex_);
+    if (Next(n_second_, 60)) {
+      return;
+    }
+    RollUp(0, 60, kMinuteBegin + n_minute_.load(std::memory_order_relaxed));
+    if (Next(n_minute_, 60)) {
+      return;
+    }
+    RollUp(kMinuteBegin, 60, kHourBegin + n_hour_.load(std::memory_order_relaxed));
+    if (Next(n_hour_, 24)) {
+      return;
+    }
+    RollUp(kHourBegin, 24, kDayBegin + n_day_.load(std::memory_order_relaxed));
+    Next(n_day_, 30);
+  }
+
+  std::unordered_map<std::string, std::vector<T>> GetSeries(const Row& row) const {
+    const int second_begin = n_second_.load(std::memory_order_relaxed);
+    std::unordered_map<std::string, std::vector<T>> ret;
+    ret.reserve(5);
+    ret.emplace("now", std::vector<T>{Get(row, (second_begin + 59) % 60)});
+    ret.emplace("latest_sec", GetLatest(row, 0, 60, second_begin));
+    ret.emplace("latest_min", GetLatest(row, kMinuteBegin, 60, n_minute_.load(std::memory_order_relaxed)));
+    ret.emplace("latest_hour", GetLatest(row, kHourBegin, 24, n_hour_.load(std::memory_order_relaxed)));
+    ret.emplace("latest_day", GetLatest(row, kDayBegin, 30, n_day_.load(std::memory_order_relaxed)));
+    return ret;
+  }
+
+ private:
+  static constexpr std::size_t kMinuteBegin = 60;
+  static constexpr std::size_t kHourBegin = kMinuteBegin + 60;
+  static constexpr std::size_t kDayBegin = kHourBegin + 24;
+  static constexpr std::size_t kColumns = kDayBegin + 30;
+
+  struct Chunk {
+    std::atomic<T> cells[kColumns][kRowsPerChunk];
+  };
+
+  // Return false when the cursor wraps around.
+  static bool Next(std::atomic<uint8_t>& cursor, int size) {
+    int next = cursor.load(std::memory_order_relaxed) + 1;
+    cursor.store(next >= size ? 0 : next, std::memory_order_relaxed);
+    return next < size;
+  }
+
+  static T Get(const Row& row, std::size_t column) {
+    return row.cells[column * kRowsPerChunk].load(std::memory_order_relaxed);
+  }
+
+  static std::vector<T> GetLatest(const Row& row, std::size_t begin, int size, int cursor) {
+    std::vector<T> values;
+    values.reserve(size);
+    for (int i = 0; i < size; ++i) {
+      values.emplace_back(Get(row, begin + (cursor + size - 1 - i) % size));
+    }
+    return values;
+  }
+
+  // Aggregate `count` columns starting at `from` into column `to` for all the rows, chunk by chunk.
+  void RollUp(std::size_t from, int count, std::size_t to) {
+    T acc[kRowsPerChunk];
+    for (auto& chunk : chunks_) {
+      for (std::size_t r = 0; r < kRowsPerChunk; ++r) {
+        acc[r] = chunk->cells[from][r].load(std::memory_order_relaxed);
+      }
+      for (int i = 1; i < count; ++i) {
+        for (std::size_t r = 0; r < kRowsPerChunk; ++r) {
+          op_(&acc[r], chunk->cells[from + i][r].load(std::memory_order_relaxed));
+        }
+      }
+      for (std::size_t r = 0; r < kRowsPerChunk; ++r) {
+        DivideOnAddition<T, Op>::InplaceDivide(acc[r], op_, count);
+        chunk->cells[to][r].store(acc[r], std::memory_order_relaxed);
+      }
+    }
+  }
+
+ private:
+  Op op_;
+  // Protects `chunks_`, `free_rows_` and roll-up.
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  std::vector<std::size_t> free_rows_;
+  std::atomic<uint8_t> n_second_{0};
+  std::atomic<uint8_t> n_minute_{0};
+  std::atomic<uint8_t> n_hour_{0};
+  std::atomic<uint8_t> n_day_{0};
+};
+
+/// @brief Series data of a variable kept in a columnar series store.
+/// @note `Append` sets the value of current second, the store moves to the next second by itself.
+/// @private
+template <typename T, typename Op>
+class ColumnarSeries {
+ public:
+  explicit ColumnarSeries(ColumnarSeriesStore<T, Op>* store = ColumnarSeriesStore<T, Op>::GetInstance())
+      : store_(store), row_(store->Allocate()) {}
+
+  ~ColumnarSeries() { store_->Free(row_); }
+
+  ColumnarSeries(const ColumnarSeries&) = delete;
+  ColumnarSeries& operator=(const ColumnarSeries&) = delete;
+
+  void Append(const T& value) { store_->Set(row_, value); }
+
+  std::unordered_map<std::string, std::vector<T>> GetSeries() const noexcept { return store_->GetSeries(row_); }
+
+ private:
+  ColumnarSeriesStore<T, Op>* store_;
+  typename ColumnarSeriesStore<T, Op>::Row row_;
+};
+
+/// @brief Series of sampled variables, arithmetic values are kept in the shared columnar stores.
 /// @private
 template <typename T, typename Op>
-using Series = SeriesBase<T, Op>;
+using Series = std::conditional_t<std::is_integral_v<T> || std::is_floating_point_v<T>, ColumnarSeries<T, Op>,
+                                  SeriesBase<T, Op>>;
 
 }  // namespace trpc::tvar
@@ -13,6 +13,9 @@
 
 #include "trpc/tvar/common/series.h"
 
+#include <memory>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "trpc/tvar/common/op_util.h"
@@ -91,4 +94,59 @@ TEST(SeriesBase, NotOp) {
   ASSERT_EQ(series_map["latest_day"][0], 59);
 }
 
+/// @brief Store series data of many variables in a columnar store.
+TEST(ColumnarSeries, ManyVariables) {
+  tvar::ColumnarSeriesStore<int, tvar::OpAdd<int>> store;
+  // Spans more than one chunk.
+  constexpr int kVariables = 100;
+  std::vector<std::unique_ptr<tvar::ColumnarSeries<int, tvar::OpAdd<int>>>> series;
+  for (int i = 0; i < kVariables; ++i) {
+    series.push_back(std::make_unique<tvar::ColumnarSeries<int, tvar::OpAdd<int>>>(&store));
+  }
+  int sec_per_day = 24 * 60 * 60;
+  for (int i = 0; i < sec_per_day; ++i) {
+    for (int j = 0; j < kVariables; ++j) {
+      series[j]->Append(i % 60 + j);
+    }
+    store.Advance();
+  }
+  for (int j = 0; j < kVariables; ++j) {
+    auto series_map = series[j]->GetSeries();
+    ASSERT_EQ(series_map.size(), 5);
+    ASSERT_EQ(series_map["now"][0], 59 + j);
+    ASSERT_EQ(series_map["latest_sec"][0], 59 + j);
+    ASSERT_EQ(series_map["latest_sec"][59], j);
+    ASSERT_EQ(series_map["latest_min"][0], 30 + j);
+    ASSERT_EQ(series_map["latest_hour"][0], 30 + j);
+    ASSERT_EQ(series_map["latest_day"][0], 30 + j);
+  }
+}
+
+/// @brief Store series data with operator max in a columnar store.
+TEST(ColumnarSeries, NotOp) {
+  tvar::ColumnarSeriesStore<int, tvar::OpMax<int>> store;
+  tvar::ColumnarSeries<int, tvar::OpMax<int>> series(&store);
+  for (int i = 0; i < 3600; ++i) {
+    series.Append(i % 60);
+    store.Advance();
+  }
+  auto series_map = series.GetSeries();
+  ASSERT_EQ(series_map["latest_sec"][1], 58);
+  ASSERT_EQ(series_map["latest_min"][0], 59);
+  ASSERT_EQ(series_map["latest_hour"][0], 59);
+}
+
+/// @brief Rows freed are reused and cleared.
+TEST(ColumnarSeries, ReuseRow) {
+  tvar::ColumnarSeriesStore<double, tvar::OpAdd<double>> store;
+  {
+    tvar::ColumnarSeries<double, tvar::OpAdd<double>> series(&store);
+    series.Append(1.5);
+    store.Advance();
+    ASSERT_EQ(series.GetSeries()["now"][0], 1.5);
+  }
+  tvar::ColumnarSeries<double, tvar::OpAdd<double>> series(&store);
+  ASSERT_EQ(series.GetSeries()["now"][0], 0.0);
+}
+
 }  // namespace trpc::testing
@@ -198,6 +198,28 @@ std::optional<Json::Value> TrpcVarGroup::TryGet(std::string_view abs_path, bool
   return {};
 }
 
+void TrpcVarGroup::Visit(std::string_view abs_path,
+                         const Function<void(std::string_view, const Json::Value&)>& visitor) {
+  auto real_path = SubstituteEscapedSlashForZero(abs_path);
+  TRPC_ASSERT(!real_path.empty());
+  CHECK_ABSOLUTE_PATH(real_path);
+  if (real_path == "/") {
+    return Root()->VisitLeaves(visitor);
+  }
+  std::string_view left_path;
+  auto parent = Root()->FindLowest(real_path.substr(1), &left_path);
+  if (left_path.empty()) {
+    return parent->VisitLeaves(visitor);
+  }
+  // Only a leave directly under the node found is visited, path inside the value of a leave is not supported.
+  std::shared_lock lk(parent->lock_);
+  if (auto iter = parent->leaves_.find(std::string(left_path)); iter != parent->leaves_.end()) {
+    if (auto value = iter->second("", false)) {
+      visitor(UnescapeZeroToPlainSlash(JoinPath(parent->AbsolutePath(), iter->first)), *value);
+    }
+  }
+}
+
 TrpcVarGroup::TrpcVarGroup(std::string abs_path) : abs_path_(std::move(abs_path)) {
   CHECK_ABSOLUTE_PATH(abs_path);
 }
@@ -278,6 +300,18 @@ std::optional<TrpcVarGroup::Handle> TrpcVarGroup::AddDirect(std::string_view nam
   return handle;
 }
 
+void TrpcVarGroup::VisitLeaves(const Function<void(std::string_view, const Json::Value&)>& visitor) const {
+  std::shared_lock lk(lock_);
+  for (auto&& [k, v] : leaves_) {
+    if (auto value = v("", false)) {
+      visitor(UnescapeZeroToPlainSlash(JoinPath(AbsolutePath(), k)), *value);
+    }
+  }
+  for (auto&& [k, v] : nodes_) {
+    v->VisitLeaves(visitor);
+  }
+}
+
 Json::Value TrpcVarGroup::Dump(bool get_series) const {
   Json::Value jsv;
 
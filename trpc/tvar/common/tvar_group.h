@@ -73,6 +73,11 @@ class TrpcVarGroup {
   /// @return Json value when success, std::nullopt when failed.
   static std::optional<Json::Value> TryGet(std::string_view abs_path, bool get_series = false);
 
+  /// @brief Visit the leaves under abs_path one by one, without building the json tree of all of them.
+  /// @param abs_path Absolute path of a node or a leave.
+  /// @param visitor Called with absolute path and current value of each leave.
+  static void Visit(std::string_view abs_path, const Function<void(std::string_view, const Json::Value&)>& visitor);
+
  private:
   using Getter = Function<std::optional<Json::Value>(std::string_view, bool)>;
 
@@ -101,6 +106,9 @@ class TrpcVarGroup {
   /// @return Json data.
   Json::Value Dump(bool get_series = false) const;
 
+  /// @brief Visit all the leaves of the subtree.
+  void VisitLeaves(const Function<void(std::string_view, const Json::Value&)>& visitor) const;
+
   /// @brief Get root node.
   static TrpcVarGroup* Root();
 
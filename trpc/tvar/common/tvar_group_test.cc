@@ -13,6 +13,7 @@
 
 #include "trpc/tvar/common/tvar_group.h"
 
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -126,6 +127,34 @@ TEST(TvarGroup, SlashInPath) {
   ASSERT_EQ("10", (*TrpcVarGroup::TryGet("/"))["path"]["to"]["var"]["////abc"].asString());
 }
 
+/// @brief Test for visiting leaves one by one.
+TEST(TvarGroup, Visit) {
+  MyClass v1(TrpcVarGroup::FindOrCreate("/visit"), "v1", 1);
+  MyClass v2(TrpcVarGroup::FindOrCreate("/visit/a/b"), "v2", 2);
+  MyClass v3(TrpcVarGroup::FindOrCreate("/visit/a"), R"(\/v3)", 3);
+
+  std::map<std::string, std::string> visited;
+  auto visitor = [&visited](std::string_view path, const Json::Value& value) {
+    visited[std::string(path)] = value.asString();
+  };
+
+  TrpcVarGroup::Visit("/visit", visitor);
+  std::map<std::string, std::string> expected{{"/visit/v1", "1"}, {"/visit/a/b/v2", "2"}, {"/visit/a//v3", "3"}};
+  ASSERT_EQ(expected, visited);
+
+  visited.clear();
+  TrpcVarGroup::Visit("/", visitor);
+  ASSERT_EQ("2", visited["/visit/a/b/v2"]);
+
+  visited.clear();
+  TrpcVarGroup::Visit("/visit/a/b/v2", visitor);
+  ASSERT_EQ((std::map<std::string, std::string>{{"/visit/a/b/v2", "2"}}), visited);
+
+  visited.clear();
+  TrpcVarGroup::Visit("/visit/not_exist", visitor);
+  ASSERT_TRUE(visited.empty());
+}
+
 /// @brief Test for setting abort on path.
 TEST(SamePathNotAbort, SetWhetherToAbortOnSamePath) {
   trpc::tvar::SetWhetherToAbortOnSamePath(false);
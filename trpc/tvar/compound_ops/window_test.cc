@@ -13,6 +13,7 @@
 
 #include "trpc/tvar/compound_ops/window.h"
 
+#include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <memory>
@@ -450,4 +451,28 @@ TEST_F(TestWindow, PerSecondNotAbortOnSamePath) {
   }
 }
 
+/// @brief The series samplers of Window and PerSecond read their reducer samplers while being sampled, which must
+///        not block sampler_collector thread.
+TEST_F(TestWindow, SeriesSamplingDoesNotBlockCollector) {
+  ASSERT_TRUE(trpc::TrpcConfig::GetInstance()->GetGlobalConfig().tvar_config.save_series);
+  Counter<int64_t> counter;
+  Window<Counter<int64_t>> window("series_window", &counter);
+  PerSecond<Counter<int64_t>> per_second("series_per_second", &counter);
+  ASSERT_TRUE(window.IsExposed());
+  ASSERT_TRUE(per_second.IsExposed());
+  counter.Add(10);
+
+  // The new samplers are taken at the beginning of next sweep, sampled in the ones after it.
+  auto sweeps = trpc::tvar::GetSamplerSweepStats().sweeps;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (trpc::tvar::GetSamplerSweepStats().sweeps < sweeps + 3) {
+    ASSERT_LT(std::chrono::steady_clock::now(), deadline) << "sampler_collector thread is blocked";
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  ASSERT_EQ(10, window.GetValue());
+  ASSERT_FALSE(window.GetSeriesValue()["now"].empty());
+  ASSERT_FALSE(per_second.GetSeriesValue()["now"].empty());
+}
+
 }  // namespace trpc::testing
@@ -28,38 +28,38 @@ ContiguousBuffer::ContiguousBuffer(size_t initial_size) : mem_size_(initial_size
 
 ContiguousBuffer::ContiguousBuffer(char* mem_ptr, size_t size) : mem_size_(size), write_pos_(size), mem_ptr_(mem_ptr) {}
 
+ContiguousBuffer::ContiguousBuffer(char* mem_ptr, size_t size, Deleter deleter, void* deleter_arg)
+    : mem_size_(size), write_pos_(size), mem_ptr_(mem_ptr), deleter_(deleter), deleter_arg_(deleter_arg) {}
+
 ContiguousBuffer::ContiguousBuffer(ContiguousBuffer&& other) {
   read_pos_ = std::exchange(other.read_pos_, 0);
   write_pos_ = std::exchange(other.write_pos_, 0);
   mem_size_ = std::exchange(other.mem_size_, 0);
   mem_ptr_ = std::exchange(other.mem_ptr_, nullptr);
+  deleter_ = std::exchange(other.deleter_, nullptr);
+  deleter_arg_ = std::exchange(other.deleter_arg_, nullptr);
 }
 
 ContiguousBuffer& ContiguousBuffer::operator=(ContiguousBuffer&& other) {
   if (this != &other) {
+    FreeMemory();
     read_pos_ = std::exchange(other.read_pos_, 0);
     write_pos_ = std::exchange(other.write_pos_, 0);
     mem_size_ = std::exchange(other.mem_size_, 0);
     mem_ptr_ = std::exchange(other.mem_ptr_, nullptr);
+    deleter_ = std::exchange(other.deleter_, nullptr);
+    deleter_arg_ = std::exchange(other.deleter_arg_, nullptr);
   }
   return *this;
 }
 
-ContiguousBuffer::~ContiguousBuffer() {
-  if (mem_ptr_) {
-    delete[] mem_ptr_;
-    mem_ptr_ = nullptr;
-  }
-}
+ContiguousBuffer::~ContiguousBuffer() { FreeMemory(); }
 
 void ContiguousBuffer::Resize(size_t size) noexcept {
   if (mem_size_ >= size) {
     mem_size_ = size;
   } else {
-    if (mem_ptr_) {
-      delete[] mem_ptr_;
-      mem_ptr_ = nullptr;
-    }
+    FreeMemory();
     mem_ptr_ = new char[size];
     mem_size_ = size;
   }
@@ -73,6 +73,8 @@ void ContiguousBuffer::DestructiveReset() {
   write_pos_ = 0;
   mem_size_ = 0;
   mem_ptr_ = nullptr;
+  deleter_ = nullptr;
+  deleter_arg_ = nullptr;
 }
 
 void ContiguousBuffer::Reset() {
@@ -80,10 +82,20 @@ void ContiguousBuffer::Reset() {
   write_pos_ = 0;
   mem_size_ = 0;
 
+  FreeMemory();
+}
+
+void ContiguousBuffer::FreeMemory() {
   if (mem_ptr_) {
-    delete[] mem_ptr_;
+    if (deleter_) {
+      deleter_(mem_ptr_, deleter_arg_);
+    } else {
+      delete[] mem_ptr_;
+    }
     mem_ptr_ = nullptr;
   }
+  deleter_ = nullptr;
+  deleter_arg_ = nullptr;
 }
 
 }  // namespace trpc
@@ -26,10 +26,16 @@ class ContiguousBuffer : public RefCounted<ContiguousBuffer> {
  public:
   enum class WorkMode { BUFFER_INNER, BUFFER_DELEGATE_READONLY, BUFFER_DELEGATE };
 
+  /// @brief The function used to release the delegated memory instead of `delete[]`
+  using Deleter = void (*)(char* mem_ptr, void* arg);
+
  public:
   explicit ContiguousBuffer(size_t initial_size = 8196);
   /// @note mem_ptr is allocated by new[]
   ContiguousBuffer(char* mem_ptr, size_t size);
+  /// @brief Delegate the memory which is not allocated by new[] (eg: shared memory), it is released by calling
+  ///        `deleter(mem_ptr, deleter_arg)` when the buffer is destroyed.
+  ContiguousBuffer(char* mem_ptr, size_t size, Deleter deleter, void* deleter_arg);
   ContiguousBuffer(ContiguousBuffer&& other);
   ContiguousBuffer& operator=(ContiguousBuffer&& other);
   ContiguousBuffer(const ContiguousBuffer& other) = delete;
@@ -89,12 +95,15 @@ class ContiguousBuffer : public RefCounted<ContiguousBuffer> {
  private:
   char* Begin() { return mem_ptr_; }
   void Reset();
+  void FreeMemory();
 
  private:
   size_t mem_size_{0};
   size_t read_pos_{0};
   size_t write_pos_{0};
   char* mem_ptr_{nullptr};
+  Deleter deleter_{nullptr};
+  void* deleter_arg_{nullptr};
 };
 
 // for compatible
@@ -100,4 +100,29 @@ TEST(ContiguousBuffer, ReadAndWrite) {
 
   ASSERT_TRUE(buf_mem.WritableSize() == 1024);
 }
+
+TEST(ContiguousBuffer, CustomDeleter) {
+  static char mem[64];
+  int released = 0;
+  auto deleter = [](char* ptr, void* arg) {
+    ASSERT_EQ(mem, ptr);
+    ++*static_cast<int*>(arg);
+  };
+
+  {
+    ContiguousBuffer buf(mem, sizeof(mem), deleter, &released);
+    ASSERT_EQ(mem, buf.GetReadPtr());
+    ASSERT_EQ(sizeof(mem), buf.ReadableSize());
+
+    ContiguousBuffer moved(std::move(buf));
+    ASSERT_EQ(0, released);
+  }
+  ASSERT_EQ(1, released);
+
+  // The delegated memory is released by the deleter rather than `delete[]` when resizing.
+  ContiguousBuffer buf(mem, sizeof(mem), deleter, &released);
+  buf.Resize(sizeof(mem) * 2);
+  ASSERT_EQ(2, released);
+  ASSERT_EQ(sizeof(mem) * 2, buf.WritableSize());
+}
 }  // namespace trpc::testing
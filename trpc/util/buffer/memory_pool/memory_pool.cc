@@ -20,6 +20,7 @@ namespace trpc {
 namespace memory_pool {
 
 MemBlock* Allocate() {
+  detail::tls_allocated_bytes += GetMemBlockSize();
 #if defined(TRPC_DISABLED_MEM_POOL)
   return disabled::Allocate();
 #elif defined(TRPC_SHARED_NOTHING_MEM_POOL)
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 #include <string>
 #include <utility>
@@ -62,6 +63,18 @@ const MemStatistics& GetMemStatistics() noexcept;
 /// @brief Print memory allocation/release information for the current thread's memory pool.
 void PrintMemStatistics() noexcept;
 
+namespace detail {
+
+/// @private
+inline thread_local std::uint64_t tls_allocated_bytes = 0;
+
+}  // namespace detail
+
+/// @brief Get the total bytes of the memory blocks allocated by the current thread since it started, it only grows.
+/// @note It is cheap enough to be read at every fiber switch, the per-request resource accounting uses the
+///       difference of two readings as the bytes allocated in between.
+inline std::uint64_t GetTlsAllocatedBytes() noexcept { return detail::tls_allocated_bytes; }
+
 }  // namespace memory_pool
 
 /// @brief Wrap the MemBlock object in a Refer object for ease of use later.
@@ -40,5 +40,15 @@ TEST(MemoryPool, MakeBlockRefTest) {
   ASSERT_TRUE(ref_block.get() == block);
 }
 
+TEST(MemoryPool, GetTlsAllocatedBytesTest) {
+  std::uint64_t before = GetTlsAllocatedBytes();
+  MemBlock* block = Allocate();
+  ASSERT_EQ(GetTlsAllocatedBytes() - before, GetMemBlockSize());
+  Deallocate(block);
+  ASSERT_EQ(GetTlsAllocatedBytes() - before, GetMemBlockSize());
+
+  std::thread([] { ASSERT_EQ(GetTlsAllocatedBytes(), 0); }).join();
+}
+
 }  // namespace testing
 }  // namespace trpc::memory_pool
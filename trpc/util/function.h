@@ -13,6 +13,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 #include <functional>
 #include <new>
@@ -127,6 +128,13 @@ class alignas(max_align_v) Function<R(Args...)> {
   // Test if `Function` is empty.
   constexpr explicit operator bool() const { return !!ops_; }
 
+  // Address of the code invoking the functor stored inside, 0 if empty. Its
+  // symbol names the type of the functor, which helps identifying the functor
+  // in diagnostic tools (e.g., the entry of a fiber).
+  std::uintptr_t GetInvokerAddress() const noexcept {
+    return ops_ ? reinterpret_cast<std::uintptr_t>(ops_->invoker) : 0;
+  }
+
  private:
   // Functors of size no greater than `kMaximumOptimizableSize` is stored
   // inplace inside `Function`.
@@ -123,4 +123,18 @@ TEST(Function, Clear) {
   ASSERT_TRUE(f4);
 }
 
+TEST(Function, GetInvokerAddress) {
+  Function<void()> f;
+  ASSERT_EQ(0, f.GetInvokerAddress());
+
+  auto lambda = [] {};
+  f = lambda;
+  Function<void()> f1 = lambda;
+  Function<void()> f2 = [] {};
+  ASSERT_NE(0, f.GetInvokerAddress());
+  // Same for the same functor type, different for the different ones.
+  ASSERT_EQ(f.GetInvokerAddress(), f1.GetInvokerAddress());
+  ASSERT_NE(f.GetInvokerAddress(), f2.GetInvokerAddress());
+}
+
 }  // namespace trpc::testing
@@ -0,0 +1,92 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include "trpc/util/likely.h"
+#include "trpc/util/object_pool/object_pool.h"
+
+namespace trpc::object_pool {
+
+namespace detail {
+
+/// @brief Raw storage taken from the object pool, shared by all the types with the same size and alignment.
+template <std::size_t Size, std::size_t Align>
+struct alignas(Align) RawStorage {
+  unsigned char data[Size];
+};
+
+}  // namespace detail
+
+template <std::size_t Size, std::size_t Align>
+struct ObjectPoolTraits<detail::RawStorage<Size, Align>> {
+#if defined(TRPC_DISABLED_OBJECTPOOL)
+  static constexpr auto kType = ObjectPoolType::kDisabled;
+#elif defined(TRPC_SHARED_NOTHING_OBJECTPOOL)
+  static constexpr auto kType = ObjectPoolType::kSharedNothing;
+#else
+  static constexpr auto kType = ObjectPoolType::kGlobal;
+#endif
+};
+
+/// @brief A standard allocator which takes single objects from the object pool, so that types which can not specialize
+///        `ObjectPoolTraits` (eg: the control block of `std::shared_ptr`) can be pooled too.
+///        Usage:
+///        std::shared_ptr<A> ptr = std::allocate_shared<A>(trpc::object_pool::PoolAllocator<A>());
+/// @note Arrays are allocated by `std::allocator`.
+template <class T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  PoolAllocator() noexcept = default;
+
+  template <class U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept {}  // NOLINT
+
+  T* allocate(std::size_t n) {
+    if (TRPC_UNLIKELY(n != 1)) {
+      return std::allocator<T>().allocate(n);
+    }
+    auto* ptr = detail::New<detail::RawStorage<sizeof(T), alignof(T)>>();
+    if (TRPC_UNLIKELY(ptr == nullptr)) {
+      throw std::bad_alloc();
+    }
+    return reinterpret_cast<T*>(ptr);
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    if (TRPC_UNLIKELY(n != 1)) {
+      std::allocator<T>().deallocate(ptr, n);
+      return;
+    }
+    detail::Delete(reinterpret_cast<detail::RawStorage<sizeof(T), alignof(T)>*>(ptr));
+  }
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept {
+  return false;
+}
+
+}  // namespace trpc::object_pool
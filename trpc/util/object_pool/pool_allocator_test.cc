@@ -0,0 +1,65 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/util/object_pool/pool_allocator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::object_pool::testing {
+
+struct Foo {
+  explicit Foo(std::string v) : value(std::move(v)) {}
+
+  std::string value;
+};
+
+TEST(PoolAllocatorTest, AllocateShared) {
+  std::shared_ptr<Foo> foo = std::allocate_shared<Foo>(PoolAllocator<Foo>(), "foo");
+  ASSERT_EQ(foo->value, "foo");
+
+  std::weak_ptr<Foo> weak = foo;
+  std::shared_ptr<Foo> other = foo;
+  foo.reset();
+  ASSERT_FALSE(weak.expired());
+  ASSERT_EQ(other->value, "foo");
+  other.reset();
+  ASSERT_TRUE(weak.expired());
+}
+
+#if !defined(TRPC_DISABLED_OBJECTPOOL)
+TEST(PoolAllocatorTest, ReuseSlot) {
+  PoolAllocator<Foo> allocator;
+  Foo* first = allocator.allocate(1);
+  allocator.deallocate(first, 1);
+  Foo* second = allocator.allocate(1);
+  ASSERT_EQ(first, second);
+  allocator.deallocate(second, 1);
+}
+#endif
+
+TEST(PoolAllocatorTest, AllocateArray) {
+  std::vector<int, PoolAllocator<int>> values;
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+  ASSERT_EQ(values.size(), 100);
+  ASSERT_EQ(values[99], 99);
+  ASSERT_TRUE(PoolAllocator<int>() == PoolAllocator<Foo>());
+}
+
+}  // namespace trpc::object_pool::testing
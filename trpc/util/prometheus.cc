@@ -14,6 +14,12 @@
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
 #include "trpc/util/prometheus.h"
 
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 #include "trpc/admin/base_funcs.h"
 #include "trpc/util/log/logging.h"
 
@@ -21,26 +27,53 @@ namespace trpc::prometheus {
 
 std::shared_ptr<::prometheus::Registry> collector = std::make_shared<::prometheus::Registry>();
 
-std::shared_ptr<::prometheus::Registry> GetRegistry() { return collector; }
+namespace {
+
+// Whether the registry has been handed out, only then families may have been registered into it directly.
+std::atomic<bool> registry_exposed{false};
+
+// The families created by the Get*Family, in order of creation, so that they can be collected one by one
+// (`::prometheus::Registry` can not be iterated).
+std::mutex families_lock;
+std::vector<::prometheus::Collectable*> families;
+std::unordered_set<std::string> family_names;
+
+template <typename Builder>
+auto* RegisterFamily(const char* name, Builder&& builder) {
+  std::lock_guard<std::mutex> lock(families_lock);
+  auto* family = &builder.Register(*collector);
+  // The registry returns the existing family when the same one is registered again.
+  if (family_names.insert(name).second) {
+    families.push_back(family);
+  }
+  return family;
+}
+
+}  // namespace
+
+std::shared_ptr<::prometheus::Registry> GetRegistry() {
+  registry_exposed.store(true, std::memory_order_relaxed);
+  return collector;
+}
 
 ::prometheus::Family<::prometheus::Counter>* GetCounterFamily(const char* name, const char* help,
                                                               const std::map<std::string, std::string>& labels) {
-  return &::prometheus::BuildCounter().Name(name).Help(help).Labels(labels).Register(*collector);
+  return RegisterFamily(name, ::prometheus::BuildCounter().Name(name).Help(help).Labels(labels));
 }
 
 ::prometheus::Family<::prometheus::Gauge>* GetGaugeFamily(const char* name, const char* help,
                                                           const std::map<std::string, std::string>& labels) {
-  return &::prometheus::BuildGauge().Name(name).Help(help).Labels(labels).Register(*collector);
+  return RegisterFamily(name, ::prometheus::BuildGauge().Name(name).Help(help).Labels(labels));
 }
 
 ::prometheus::Family<::prometheus::Histogram>* GetHistogramFamily(const char* name, const char* help,
                                                                   const std::map<std::string, std::string>& labels) {
-  return &::prometheus::BuildHistogram().Name(name).Help(help).Labels(labels).Register(*collector);
+  return RegisterFamily(name, ::prometheus::BuildHistogram().Name(name).Help(help).Labels(labels));
 }
 
 ::prometheus::Family<::prometheus::Summary>* GetSummaryFamily(const char* name, const char* help,
                                                               const std::map<std::string, std::string>& labels) {
-  return &::prometheus::BuildSummary().Name(name).Help(help).Labels(labels).Register(*collector);
+  return RegisterFamily(name, ::prometheus::BuildSummary().Name(name).Help(help).Labels(labels));
 }
 
 namespace {
@@ -103,5 +136,37 @@ std::vector<::prometheus::MetricFamily> Collect() {
   return collector->Collect();
 }
 
+void CollectEach(const Function<void(const ::prometheus::MetricFamily&)>& fn) {
+  std::call_once(init_flag, InitProcessMetrics);
+  UpdateProcessMetric();
+
+  std::vector<::prometheus::Collectable*> collectables;
+  {
+    std::lock_guard<std::mutex> lock(families_lock);
+    collectables = families;
+  }
+  for (auto* collectable : collectables) {
+    for (auto&& family : collectable->Collect()) {
+      fn(family);
+    }
+  }
+
+  if (!registry_exposed.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // The families registered into the registry directly can only be collected along with all the others.
+  std::unordered_set<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(families_lock);
+    names = family_names;
+  }
+  for (auto&& family : collector->Collect()) {
+    if (names.find(family.name) == names.end()) {
+      fn(family);
+    }
+  }
+}
+
 }  // namespace trpc::prometheus
 #endif
@@ -25,6 +25,8 @@
 #include "prometheus/registry.h"
 #include "prometheus/summary.h"
 
+#include "trpc/util/function.h"
+
 namespace trpc::prometheus {
 
 /// @brief Gets the globally default used registry.
@@ -34,6 +36,11 @@ std::shared_ptr<::prometheus::Registry> GetRegistry();
 /// @brief Gets monitoring data collected by Prometheus.
 std::vector<::prometheus::MetricFamily> Collect();
 
+/// @brief Same as Collect, but the families created by the Get*Family are collected and passed to `fn` one by one, so
+///        the samples of only one family are held at a time. The families registered into GetRegistry() directly are
+///        collected at last by `Registry::Collect`.
+void CollectEach(const Function<void(const ::prometheus::MetricFamily&)>& fn);
+
 /// @brief Gets a counter type monitoring family.
 ::prometheus::Family<::prometheus::Counter>* GetCounterFamily(const char* name, const char* help,
                                                               const std::map<std::string, std::string>& labels = {});
@@ -12,7 +12,10 @@
 //
 
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -32,6 +35,29 @@ TEST(PrometheusHandlerTest, Collect) {
   ASSERT_NE(0, metrics.size());
 }
 
+TEST(PrometheusHandlerTest, CollectEach) {
+  trpc::prometheus::GetCounterFamily("collect_each_counter", "help", {})->Add({}).Increment();
+  ::prometheus::BuildGauge().Name("collect_each_gauge").Help("help").Register(*trpc::prometheus::GetRegistry());
+
+  std::vector<std::string> names;
+  trpc::prometheus::CollectEach([&names](const ::prometheus::MetricFamily& family) { names.push_back(family.name); });
+  ASSERT_EQ(trpc::prometheus::Collect().size(), names.size());
+  auto counter = std::find(names.begin(), names.end(), "collect_each_counter");
+  auto gauge = std::find(names.begin(), names.end(), "collect_each_gauge");
+  ASSERT_NE(names.end(), counter);
+  ASSERT_NE(names.end(), gauge);
+  // The families registered into the registry directly are collected at last.
+  ASSERT_LT(counter, gauge);
+}
+
+TEST(PrometheusHandlerTest, GetFamilyRegistersIntoRegistry) {
+  trpc::prometheus::GetGaugeFamily("registry_gauge", "help", {})->Add({}).Set(1);
+
+  auto families = trpc::prometheus::GetRegistry()->Collect();
+  ASSERT_TRUE(std::any_of(families.begin(), families.end(),
+                          [](const ::prometheus::MetricFamily& family) { return family.name == "registry_gauge"; }));
+}
+
 TEST(PrometheusHandlerTest, GetRegistry) {
   std::shared_ptr<::prometheus::Registry> registry = trpc::prometheus::GetRegistry();
   ASSERT_NE(nullptr, registry);
@@ -0,0 +1,141 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "trpc/util/queue/bounded_mpmc_queue.h"
+
+namespace trpc {
+
+/// @brief Thread-safe bounded priority queue with a small number of priority levels, supports multi-producer and
+///        multi-consumer. Each level is a lock-free `BoundedMPMCQueue`, and a bitmap of the non-empty levels lets
+///        `Pop` find the highest non-empty level without probing the empty ones.
+/// @note  Level 0 has the highest priority. Elements of the same level are popped in FIFO order. Under concurrency
+///        the ordering across levels is best effort: an element pushed to a higher level while `Pop` is scanning may
+///        be popped after an element of a lower level. Once quiescent, elements are popped strictly by level.
+template <typename T>
+class BoundedMultiLevelPriorityQueue {
+ public:
+  static_assert(std::is_default_constructible_v<T>, "Type must be constructible");
+  static_assert(std::is_move_constructible<T>::value, "Types must be move constructible");
+
+  /// @brief Max number of priority levels
+  constexpr static std::size_t kMaxLevels = 64;
+
+  BoundedMultiLevelPriorityQueue() = default;
+
+  /// @brief Initialize the queue
+  /// @param size_per_level capacity of each level, the value of size is preferably 2 to the nth power
+  /// @param levels number of priority levels, in range [1, kMaxLevels]
+  bool Init(std::size_t size_per_level, std::size_t levels) {
+    if (levels == 0 || levels > kMaxLevels) {
+      return false;
+    }
+
+    levels_num_ = levels;
+    levels_ = std::make_unique<BoundedMPMCQueue<T>[]>(levels);
+    for (std::size_t i = 0; i < levels; ++i) {
+      if (!levels_[i].Init(size_per_level)) {
+        return false;
+      }
+    }
+    non_empty_levels_.store(0, std::memory_order_relaxed);
+
+    return true;
+  }
+
+  /// @brief Push data into queue
+  /// @param [in] data queue element
+  /// @param [in] level priority level of the element, 0 is the highest
+  /// @return true: success, false: the level is full or invalid
+  bool Push(T data, uint32_t level) {
+    if (level >= levels_num_ || !levels_[level].Push(std::move(data))) {
+      return false;
+    }
+
+    // Pairs with the clearing in `Pop`, so that the element is visible to whoever finds the bit cleared.
+    non_empty_levels_.fetch_or(uint64_t{1} << level, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Pop the element of the highest priority from queue
+  /// @param [out] data queue element
+  /// @param [out] level priority level of the element, optional
+  /// @return true: success, false: queue empty
+  bool Pop(T& data, uint32_t* level = nullptr) {
+    uint64_t mask = non_empty_levels_.load(std::memory_order_acquire);
+    while (mask != 0) {
+      uint32_t index = __builtin_ctzll(mask);
+      uint64_t bit = uint64_t{1} << index;
+      if (levels_[index].Pop(data)) {
+        if (level) {
+          *level = index;
+        }
+        return true;
+      }
+
+      // The level looks empty. Clear its bit, and set it back if an element was pushed concurrently, since its
+      // producer may have set the bit before we cleared it.
+      non_empty_levels_.fetch_and(~bit, std::memory_order_acq_rel);
+      if (levels_[index].Size() > 0) {
+        non_empty_levels_.fetch_or(bit, std::memory_order_release);
+        mask = non_empty_levels_.load(std::memory_order_acquire);
+        queue::detail::Pause();
+      } else {
+        mask &= ~bit;
+      }
+    }
+
+    return false;
+  }
+
+  /// @brief Get the number of elements of all levels
+  uint32_t Size() const {
+    uint32_t size = 0;
+    for (std::size_t i = 0; i < levels_num_; ++i) {
+      size += levels_[i].Size();
+    }
+    return size;
+  }
+
+  /// @brief Get the number of elements of the level
+  uint32_t Size(uint32_t level) const { return level < levels_num_ ? levels_[level].Size() : 0; }
+
+  /// @brief Get the number of priority levels
+  uint32_t Levels() const { return static_cast<uint32_t>(levels_num_); }
+
+  /// @brief Get queue capacity of each level
+  uint32_t CapacityPerLevel() const { return levels_num_ > 0 ? levels_[0].Capacity() : 0; }
+
+ private:
+  BoundedMultiLevelPriorityQueue(const BoundedMultiLevelPriorityQueue& rhs) = delete;
+  BoundedMultiLevelPriorityQueue(BoundedMultiLevelPriorityQueue&& rhs) = delete;
+  BoundedMultiLevelPriorityQueue& operator=(const BoundedMultiLevelPriorityQueue& rhs) = delete;
+  BoundedMultiLevelPriorityQueue& operator=(BoundedMultiLevelPriorityQueue&& rhs) = delete;
+
+ private:
+  std::size_t levels_num_{0};
+
+  std::unique_ptr<BoundedMPMCQueue<T>[]> levels_;
+
+  // Bit `i` is set if level `i` may be non-empty.
+  alignas(64) std::atomic<uint64_t> non_empty_levels_{0};
+};
+
+}  // namespace trpc
@@ -0,0 +1,186 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/util/queue/bounded_multi_level_priority_queue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(BoundedMultiLevelPriorityQueueTest, Init) {
+  trpc::BoundedMultiLevelPriorityQueue<int> q;
+  ASSERT_FALSE(q.Init(4, 0));
+  ASSERT_FALSE(q.Init(4, 65));
+  ASSERT_TRUE(q.Init(3, 4));
+  ASSERT_EQ(4, q.Levels());
+  ASSERT_EQ(4, q.CapacityPerLevel());
+  ASSERT_EQ(0, q.Size());
+}
+
+TEST(BoundedMultiLevelPriorityQueueTest, SingleThread) {
+  trpc::BoundedMultiLevelPriorityQueue<int> q;
+  ASSERT_TRUE(q.Init(2, 3));
+
+  ASSERT_TRUE(q.Push(20, 2));
+  ASSERT_TRUE(q.Push(10, 1));
+  ASSERT_TRUE(q.Push(21, 2));
+  ASSERT_FALSE(q.Push(22, 2));
+  ASSERT_FALSE(q.Push(30, 3));
+  ASSERT_TRUE(q.Push(0, 0));
+  ASSERT_EQ(4, q.Size());
+  ASSERT_EQ(2, q.Size(2));
+
+  // By level first, then FIFO in the same level.
+  int data = 0;
+  uint32_t level = 0;
+  ASSERT_TRUE(q.Pop(data, &level));
+  ASSERT_EQ(0, data);
+  ASSERT_EQ(0, level);
+  ASSERT_TRUE(q.Pop(data, &level));
+  ASSERT_EQ(10, data);
+  ASSERT_EQ(1, level);
+
+  // A higher level pushed later is popped first.
+  ASSERT_TRUE(q.Push(11, 1));
+  ASSERT_TRUE(q.Pop(data));
+  ASSERT_EQ(11, data);
+
+  ASSERT_TRUE(q.Pop(data));
+  ASSERT_EQ(20, data);
+  ASSERT_TRUE(q.Pop(data));
+  ASSERT_EQ(21, data);
+  ASSERT_FALSE(q.Pop(data));
+  ASSERT_EQ(0, q.Size());
+}
+
+// Each element is popped exactly once, and the elements of the same producer and level are popped in the order they
+// are pushed(which is what a linearizable FIFO per level guarantees to a single consumer).
+TEST(BoundedMultiLevelPriorityQueueTest, MultiProducerSingleConsumer) {
+  constexpr int kProducers = 4;
+  constexpr int kLevels = 4;
+  constexpr int kCount = 100000;
+
+  trpc::BoundedMultiLevelPriorityQueue<uint64_t> q;
+  ASSERT_TRUE(q.Init(1024, kLevels));
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&q, p] {
+      for (int i = 0; i < kCount; ++i) {
+        uint32_t level = i % kLevels;
+        while (!q.Push((static_cast<uint64_t>(p) << 32) | i, level)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<std::vector<int>> last(kProducers, std::vector<int>(kLevels, -1));
+  int popped = 0;
+  while (popped < kProducers * kCount) {
+    uint64_t data = 0;
+    uint32_t level = 0;
+    if (!q.Pop(data, &level)) {
+      continue;
+    }
+    int p = data >> 32;
+    int i = data & 0xffffffff;
+    ASSERT_EQ(i % kLevels, level);
+    ASSERT_GT(i, last[p][level]);
+    last[p][level] = i;
+    ++popped;
+  }
+
+  for (auto& t : producers) {
+    t.join();
+  }
+  uint64_t data = 0;
+  ASSERT_FALSE(q.Pop(data));
+}
+
+TEST(BoundedMultiLevelPriorityQueueTest, MultiProducerMultiConsumer) {
+  constexpr int kThreads = 4;
+  constexpr int kLevels = 8;
+  constexpr int kCount = 100000;
+
+  trpc::BoundedMultiLevelPriorityQueue<int> q;
+  ASSERT_TRUE(q.Init(4096, kLevels));
+
+  std::vector<std::atomic<int>> seen(kThreads * kCount);
+  std::atomic<int> popped{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&q, t] {
+      for (int i = 0; i < kCount; ++i) {
+        while (!q.Push(t * kCount + i, i % kLevels)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&] {
+      int data = 0;
+      while (popped.load(std::memory_order_relaxed) < kThreads * kCount) {
+        if (q.Pop(data)) {
+          seen[data].fetch_add(1, std::memory_order_relaxed);
+          popped.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (auto& e : seen) {
+    ASSERT_EQ(1, e.load());
+  }
+  ASSERT_EQ(0, q.Size());
+}
+
+// Once the producers are done, the elements are popped strictly by level.
+TEST(BoundedMultiLevelPriorityQueueTest, QuiescentOrder) {
+  constexpr int kLevels = 16;
+  trpc::BoundedMultiLevelPriorityQueue<int> q;
+  ASSERT_TRUE(q.Init(1024, kLevels));
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < 4; ++p) {
+    producers.emplace_back([&q, p] {
+      for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(q.Push(i, (i * 7 + p) % kLevels));
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+
+  uint32_t last_level = 0;
+  uint32_t level = 0;
+  int data = 0;
+  int count = 0;
+  while (q.Pop(data, &level)) {
+    ASSERT_GE(level, last_level);
+    last_level = level;
+    ++count;
+  }
+  ASSERT_EQ(800, count);
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,146 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+// Measures the rank error and the multi-producer multi-consumer throughput of the priority queues, not a part of the
+// default test targets as the result depends on the machine.
+// Run it with: bazel test //trpc/util/queue:priority_queue_benchmark_test --test_output=all
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/queue/bounded_multi_level_priority_queue.h"
+#include "trpc/util/queue/relaxed_priority_queue.h"
+
+namespace trpc::testing {
+
+namespace {
+
+constexpr int kThreads = 4;
+constexpr int kCount = 100000;
+
+// Count of the keys(in range [0, size)) present, supports prefix sum in O(log(size)).
+class FenwickTree {
+ public:
+  explicit FenwickTree(std::size_t size) : tree_(size + 1) {}
+
+  void Add(std::size_t key, int delta) {
+    for (++key; key < tree_.size(); key += key & -key) {
+      tree_[key] += delta;
+    }
+  }
+
+  // Number of the present keys less than `key`.
+  int CountLess(std::size_t key) const {
+    int count = 0;
+    for (; key > 0; key -= key & -key) {
+      count += tree_[key];
+    }
+    return count;
+  }
+
+ private:
+  std::vector<int> tree_;
+};
+
+// Runs `kThreads` producers and `kThreads` consumers, and returns the cost in microseconds.
+template <typename PushFunc, typename PopFunc>
+int64_t RunMultiProducerMultiConsumer(PushFunc&& push, PopFunc&& pop) {
+  std::atomic<int> popped{0};
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&push, t] {
+      for (int i = 0; i < kCount; ++i) {
+        while (!push(i, t * kCount + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&] {
+      int data = 0;
+      while (popped.load(std::memory_order_relaxed) < kThreads * kCount) {
+        if (pop(data)) {
+          popped.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+TEST(PriorityQueueBenchmark, RelaxedPriorityQueueRankError) {
+  constexpr std::size_t kKeys = 100000;
+  std::vector<int> keys(kKeys);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+  for (std::size_t num_queues : {1, 2, 8, 32, 128}) {
+    trpc::RelaxedPriorityQueue<int> q;
+    ASSERT_TRUE(q.Init(kKeys, num_queues));
+    FenwickTree present(kKeys);
+    for (int key : keys) {
+      ASSERT_TRUE(q.Push(key, key));
+      present.Add(key, 1);
+    }
+
+    uint64_t sum = 0;
+    int max = 0;
+    int data = 0;
+    uint64_t key = 0;
+    while (q.Pop(data, &key)) {
+      int rank = present.CountLess(key);
+      present.Add(key, -1);
+      sum += rank;
+      max = std::max(max, rank);
+    }
+    std::cout << "num_queues: " << num_queues << ", mean rank error: " << static_cast<double>(sum) / kKeys
+              << ", max rank error: " << max << std::endl;
+  }
+}
+
+TEST(PriorityQueueBenchmark, RelaxedPriorityQueue) {
+  trpc::RelaxedPriorityQueue<int> q;
+  ASSERT_TRUE(q.Init(kThreads * kCount, 4 * kThreads));
+
+  auto cost = RunMultiProducerMultiConsumer([&q](int key, int data) { return q.Push(key, data); },
+                                            [&q](int& data) { return q.Pop(data); });
+  std::cout << "RelaxedPriorityQueue: " << kThreads << " producers and " << kThreads << " consumers, "
+            << kThreads * kCount << " elements, cost " << cost << "us" << std::endl;
+}
+
+TEST(PriorityQueueBenchmark, BoundedMultiLevelPriorityQueue) {
+  constexpr int kLevels = 8;
+  trpc::BoundedMultiLevelPriorityQueue<int> q;
+  ASSERT_TRUE(q.Init(4096, kLevels));
+
+  auto cost = RunMultiProducerMultiConsumer([&q](int key, int data) { return q.Push(data, key % kLevels); },
+                                            [&q](int& data) { return q.Pop(data); });
+  std::cout << "BoundedMultiLevelPriorityQueue: " << kThreads << " producers and " << kThreads << " consumers, "
+            << kThreads * kCount << " elements, cost " << cost << "us" << std::endl;
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,212 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "trpc/util/algorithm/random.h"
+#include "trpc/util/queue/detail/util.h"
+#include "trpc/util/thread/spinlock.h"
+
+namespace trpc {
+
+/// @brief Thread-safe bounded relaxed priority queue(MultiQueue), supports multi-producer and multi-consumer.
+///        Elements are spread over `num_queues` sequential heaps, each guarded by its own spinlock. `Push` inserts
+///        into a random heap, `Pop` samples two random heaps and removes the top of the one with the smaller key.
+///        Threads never wait for a lock: a heap that is locked by another thread is skipped for another one.
+///        Paper: https://arxiv.org/abs/1411.1209 see details
+/// @note  Elements are popped in the order of their key(the smaller the earlier) approximately. The rank error of a
+///        popped element(the number of elements with smaller keys still in the queue) is O(num_queues) on average, so
+///        `num_queues` tunes the relaxation: 1 gives a strict priority queue, and 2-4 times the number of threads is
+///        usually enough to make the contention negligible.
+template <typename T>
+class RelaxedPriorityQueue {
+ public:
+  static_assert(std::is_move_constructible<T>::value, "Types must be move constructible");
+
+  /// @brief Key of the elements must be less than it
+  constexpr static uint64_t kInvalidKey = std::numeric_limits<uint64_t>::max();
+
+  RelaxedPriorityQueue() = default;
+
+  /// @brief Initialize the queue
+  /// @param capacity max number of elements in the queue
+  /// @param num_queues number of internal heaps, the larger the more relaxed(and the less contended)
+  bool Init(std::size_t capacity, std::size_t num_queues) {
+    if (capacity == 0 || num_queues == 0) {
+      return false;
+    }
+
+    capacity_ = capacity;
+    num_queues_ = num_queues;
+    queues_ = std::make_unique<Heap[]>(num_queues);
+    for (std::size_t i = 0; i < num_queues; ++i) {
+      queues_[i].items.reserve(capacity / num_queues + 1);
+    }
+    size_.store(0, std::memory_order_relaxed);
+
+    return true;
+  }
+
+  /// @brief Push data into queue
+  /// @param [in] key priority of the element, the smaller the higher, it must be less than `kInvalidKey`
+  /// @param [in] data queue element
+  /// @return true: success, false: queue full
+  bool Push(uint64_t key, T data) {
+    if (size_.fetch_add(1, std::memory_order_relaxed) >= capacity_) {
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    while (true) {
+      Heap& heap = queues_[RandomIndex()];
+      if (heap.lock.try_lock()) {
+        heap.items.push_back(Item{key, std::move(data)});
+        std::push_heap(heap.items.begin(), heap.items.end(), ItemGreater{});
+        heap.top_key.store(heap.items.front().key, std::memory_order_relaxed);
+        heap.lock.unlock();
+        return true;
+      }
+      queue::detail::Pause();
+    }
+  }
+
+  /// @brief Pop an element with (approximately) the smallest key from queue
+  /// @param [out] data queue element
+  /// @param [out] key priority of the element, optional
+  /// @return true: success, false: queue empty
+  bool Pop(T& data, uint64_t* key = nullptr) {
+    // Sample two random heaps, and take the one with the smaller top.
+    for (int retry = 0; retry < kMaxSampleRetries; ++retry) {
+      if (size_.load(std::memory_order_relaxed) == 0) {
+        return false;
+      }
+
+      Heap* first = &queues_[RandomIndex()];
+      Heap* second = &queues_[RandomIndex()];
+      if (second->top_key.load(std::memory_order_relaxed) < first->top_key.load(std::memory_order_relaxed)) {
+        std::swap(first, second);
+      }
+      if (first->top_key.load(std::memory_order_relaxed) == kInvalidKey) {
+        continue;
+      }
+      if (!first->lock.try_lock()) {
+        queue::detail::Pause();
+        continue;
+      }
+      bool ok = PopLocked(*first, data, key);
+      first->lock.unlock();
+      if (ok) {
+        return true;
+      }
+    }
+
+    // The sampled heaps keep being empty, the queue is (nearly) empty. Scan all of them to be sure, a heap locked by
+    // another thread is skipped and scanned again in the next round.
+    while (size_.load(std::memory_order_relaxed) != 0) {
+      bool skipped = false;
+      std::size_t start = RandomIndex();
+      for (std::size_t i = 0; i < num_queues_; ++i) {
+        Heap& heap = queues_[(start + i) % num_queues_];
+        if (heap.top_key.load(std::memory_order_relaxed) == kInvalidKey) {
+          continue;
+        }
+        if (!heap.lock.try_lock()) {
+          skipped = true;
+          continue;
+        }
+        bool ok = PopLocked(heap, data, key);
+        heap.lock.unlock();
+        if (ok) {
+          return true;
+        }
+      }
+      if (!skipped) {
+        break;
+      }
+      queue::detail::Pause();
+    }
+
+    return false;
+  }
+
+  /// @brief Get queue size
+  uint32_t Size() const { return static_cast<uint32_t>(size_.load(std::memory_order_relaxed)); }
+
+  /// @brief Get queue capacity
+  uint32_t Capacity() const { return static_cast<uint32_t>(capacity_); }
+
+ private:
+  RelaxedPriorityQueue(const RelaxedPriorityQueue& rhs) = delete;
+  RelaxedPriorityQueue(RelaxedPriorityQueue&& rhs) = delete;
+  RelaxedPriorityQueue& operator=(const RelaxedPriorityQueue& rhs) = delete;
+  RelaxedPriorityQueue& operator=(RelaxedPriorityQueue&& rhs) = delete;
+
+  struct Item {
+    uint64_t key;
+    T data;
+  };
+
+  struct ItemGreater {
+    bool operator()(const Item& a, const Item& b) const { return a.key > b.key; }
+  };
+
+  struct alignas(64) Heap {
+    Spinlock lock;
+    // Key of the top element, `kInvalidKey` if the heap is empty. It's read without the lock.
+    std::atomic<uint64_t> top_key{kInvalidKey};
+    std::vector<Item> items;
+  };
+
+  bool PopLocked(Heap& heap, T& data, uint64_t* key) {
+    if (heap.items.empty()) {
+      return false;
+    }
+
+    std::pop_heap(heap.items.begin(), heap.items.end(), ItemGreater{});
+    Item& item = heap.items.back();
+    if (key) {
+      *key = item.key;
+    }
+    data = std::move(item.data);
+    heap.items.pop_back();
+    heap.top_key.store(heap.items.empty() ? kInvalidKey : heap.items.front().key, std::memory_order_relaxed);
+
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  std::size_t RandomIndex() const { return num_queues_ == 1 ? 0 : Random<std::size_t>() % num_queues_; }
+
+ private:
+  constexpr static int kMaxSampleRetries = 4;
+
+  std::size_t capacity_{0};
+
+  std::size_t num_queues_{0};
+
+  std::unique_ptr<Heap[]> queues_;
+
+  alignas(64) std::atomic<std::size_t> size_{0};
+};
+
+}  // namespace trpc
@@ -0,0 +1,170 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/util/queue/relaxed_priority_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+namespace {
+
+// Count of the keys(in range [0, size)) present, supports prefix sum in O(log(size)).
+class FenwickTree {
+ public:
+  explicit FenwickTree(std::size_t size) : tree_(size + 1) {}
+
+  void Add(std::size_t key, int delta) {
+    for (++key; key < tree_.size(); key += key & -key) {
+      tree_[key] += delta;
+    }
+  }
+
+  // Number of the present keys less than `key`.
+  int CountLess(std::size_t key) const {
+    int count = 0;
+    for (; key > 0; key -= key & -key) {
+      count += tree_[key];
+    }
+    return count;
+  }
+
+ private:
+  std::vector<int> tree_;
+};
+
+// Push the keys [0, count) in random order, pop them all, and return the mean and max rank error of the pops.
+std::pair<double, int> MeasureRankError(std::size_t num_queues, std::size_t count) {
+  trpc::RelaxedPriorityQueue<int> q;
+  EXPECT_TRUE(q.Init(count, num_queues));
+
+  std::vector<int> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+  FenwickTree present(count);
+  for (int key : keys) {
+    EXPECT_TRUE(q.Push(key, key));
+    present.Add(key, 1);
+  }
+
+  uint64_t sum = 0;
+  int max = 0;
+  int data = 0;
+  uint64_t key = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    EXPECT_TRUE(q.Pop(data, &key));
+    EXPECT_EQ(key, data);
+    int rank = present.CountLess(key);
+    present.Add(key, -1);
+    sum += rank;
+    max = std::max(max, rank);
+  }
+  EXPECT_FALSE(q.Pop(data));
+  return {static_cast<double>(sum) / count, max};
+}
+
+}  // namespace
+
+TEST(RelaxedPriorityQueueTest, Init) {
+  trpc::RelaxedPriorityQueue<int> q;
+  ASSERT_FALSE(q.Init(0, 1));
+  ASSERT_FALSE(q.Init(1, 0));
+  ASSERT_TRUE(q.Init(2, 1));
+  ASSERT_EQ(2, q.Capacity());
+  ASSERT_EQ(0, q.Size());
+}
+
+TEST(RelaxedPriorityQueueTest, Full) {
+  trpc::RelaxedPriorityQueue<int> q;
+  ASSERT_TRUE(q.Init(2, 4));
+  ASSERT_TRUE(q.Push(1, 1));
+  ASSERT_TRUE(q.Push(2, 2));
+  ASSERT_FALSE(q.Push(3, 3));
+  ASSERT_EQ(2, q.Size());
+
+  int data = 0;
+  ASSERT_TRUE(q.Pop(data));
+  ASSERT_TRUE(q.Pop(data));
+  ASSERT_FALSE(q.Pop(data));
+  ASSERT_TRUE(q.Push(3, 3));
+}
+
+// A single internal heap makes it a strict priority queue.
+TEST(RelaxedPriorityQueueTest, Strict) {
+  auto [mean, max] = MeasureRankError(1, 10000);
+  ASSERT_EQ(0, mean);
+  ASSERT_EQ(0, max);
+}
+
+// The rank error grows with the number of internal heaps, and stays in O(num_queues) on average.
+TEST(RelaxedPriorityQueueTest, RelaxationBound) {
+  double last_mean = 0;
+  for (std::size_t num_queues : {2, 8, 32}) {
+    auto [mean, max] = MeasureRankError(num_queues, 20000);
+    ASSERT_LE(mean, 2.0 * num_queues);
+    ASSERT_LE(max, 32 * num_queues);
+    ASSERT_GE(mean, last_mean);
+    last_mean = mean;
+  }
+}
+
+TEST(RelaxedPriorityQueueTest, MultiProducerMultiConsumer) {
+  constexpr int kThreads = 4;
+  constexpr int kCount = 100000;
+
+  trpc::RelaxedPriorityQueue<int> q;
+  ASSERT_TRUE(q.Init(kThreads * kCount, 4 * kThreads));
+
+  std::vector<std::atomic<int>> seen(kThreads * kCount);
+  std::atomic<int> popped{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&q, t] {
+      for (int i = 0; i < kCount; ++i) {
+        int data = t * kCount + i;
+        ASSERT_TRUE(q.Push(i, data));
+      }
+    });
+    threads.emplace_back([&] {
+      int data = 0;
+      uint64_t key = 0;
+      while (popped.load(std::memory_order_relaxed) < kThreads * kCount) {
+        if (q.Pop(data, &key)) {
+          ASSERT_EQ(key, data % kCount);
+          seen[data].fetch_add(1, std::memory_order_relaxed);
+          popped.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (auto& e : seen) {
+    ASSERT_EQ(1, e.load());
+  }
+  ASSERT_EQ(0, q.Size());
+}
+
+}  // namespace trpc::testing
@@ -17,6 +17,7 @@
 
 #include <atomic>
 #include <climits>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -301,4 +302,32 @@ std::optional<std::vector<unsigned>> TryParseProcesserList(const std::string& s)
   return result;
 }
 
+std::optional<std::vector<unsigned>> GetProcessorsSharingLastLevelCache(unsigned cpu) {
+  // Each `indexN` describes one cache of the CPU, the one with the highest level is the last level cache.
+  const std::string cache_dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache/";
+  int max_level = -1;
+  std::string shared_cpu_list;
+  for (int i = 0;; ++i) {
+    const std::string index_dir = cache_dir + "index" + std::to_string(i) + "/";
+    std::ifstream level_file(index_dir + "level");
+    if (!level_file) {
+      break;
+    }
+    int level = -1;
+    level_file >> level;
+
+    std::ifstream list_file(index_dir + "shared_cpu_list");
+    std::string list;
+    if (level > max_level && std::getline(list_file, list)) {
+      max_level = level;
+      shared_cpu_list = std::move(list);
+    }
+  }
+
+  if (max_level < 0) {
+    return std::nullopt;
+  }
+  return TryParseProcesserList(std::string(Trim(shared_cpu_list)));
+}
+
 }  // namespace trpc
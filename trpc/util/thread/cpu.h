@@ -99,4 +99,9 @@ bool IsProcessorAccessible(unsigned cpu);
 /// @note Not sure if this is the right place to declare it though..
 std::optional<std::vector<unsigned>> TryParseProcesserList(const std::string& s);
 
+/// @brief Get the CPUs sharing the last level cache(eg: L3) with the specified CPU.
+/// @param cpu The specified CPU number.
+/// @return The list of CPUs(including `cpu` itself), or std::nullopt if the cache topology is not available.
+std::optional<std::vector<unsigned>> GetProcessorsSharingLastLevelCache(unsigned cpu);
+
 }  // namespace trpc
@@ -10,6 +10,9 @@
 
 #include "trpc/util/thread/cpu.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "gtest/gtest.h"
 
 namespace trpc::testing {
@@ -21,6 +24,15 @@ TEST(GetNodeIndexOf, All) {
   ASSERT_EQ(index, trpc::numa::kUnexpectedNodeIndex);
 }
 
+TEST(GetProcessorsSharingLastLevelCache, All) {
+  auto ret = GetProcessorsSharingLastLevelCache(0);
+  if (ret) {
+    ASSERT_NE(std::find(ret->begin(), ret->end(), 0), ret->end());
+  }
+
+  ASSERT_FALSE(GetProcessorsSharingLastLevelCache(std::numeric_limits<int>::max()));
+}
+
 TEST(TryParseProcesserList, All) {
   {
     auto ret = TryParseProcesserList("-200000");